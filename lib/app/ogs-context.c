@@ -213,6 +213,9 @@ static void app_context_prepare(void)
     /* Size of internal metrics pool (amount of ogs_metrics_spec_t) */
     self.metrics.max_specs = 512;
 
+    /* SBI Overload Control Information : 10 seconds (Default) */
+    self.sbi.server.overload_validity = 10;
+
     regenerate_all_timer_duration();
 }
 
@@ -234,6 +237,19 @@ static int app_context_validation(void)
         return OGS_ERROR;
     }
 
+    if (self.sbi.server.overload_threshold < 0 ||
+        self.sbi.server.overload_threshold >= 100) {
+        ogs_error("SBI overload_threshold should be 1..99 [%d]",
+                self.sbi.server.overload_threshold);
+        return OGS_ERROR;
+    }
+
+    if (self.sbi.server.overload_validity <= 0) {
+        ogs_error("SBI overload_validity should be greater than 0 [%d]",
+                self.sbi.server.overload_validity);
+        return OGS_ERROR;
+    }
+
     return OGS_OK;
 }
 
@@ -561,6 +577,21 @@ int ogs_app_context_parse_config(void)
                         } else if (!strcmp(server_key, "key")) {
                             self.sbi.server.key =
                                 ogs_yaml_iter_value(&server_iter);
+                        } else if (!strcmp(server_key, "io_thread")) {
+                            const char *v = ogs_yaml_iter_value(&server_iter);
+                            if (v) self.sbi.server.io_thread = atoi(v);
+                        } else if (!strcmp(server_key, "load_queue")) {
+                            const char *v = ogs_yaml_iter_value(&server_iter);
+                            if (v) self.sbi.server.load_queue = atoi(v);
+                        } else if (!strcmp(server_key, "load_latency")) {
+                            const char *v = ogs_yaml_iter_value(&server_iter);
+                            if (v) self.sbi.server.load_latency = atoi(v);
+                        } else if (!strcmp(server_key, "overload_threshold")) {
+                            const char *v = ogs_yaml_iter_value(&server_iter);
+                            if (v) self.sbi.server.overload_threshold = atoi(v);
+                        } else if (!strcmp(server_key, "overload_validity")) {
+                            const char *v = ogs_yaml_iter_value(&server_iter);
+                            if (v) self.sbi.server.overload_validity = atoi(v);
                         } else
                             ogs_warn("unknown key `%s`", server_key);
                     }
@@ -587,6 +618,15 @@ int ogs_app_context_parse_config(void)
                         } else if (!strcmp(client_key, "key")) {
                             self.sbi.client.key =
                                 ogs_yaml_iter_value(&client_iter);
+                        } else if (!strcmp(client_key, "max_inflight")) {
+                            const char *v = ogs_yaml_iter_value(&client_iter);
+                            if (v) self.sbi.client.max_inflight = atoi(v);
+                        } else if (!strcmp(client_key, "max_connection")) {
+                            const char *v = ogs_yaml_iter_value(&client_iter);
+                            if (v) self.sbi.client.max_connection = atoi(v);
+                        } else if (!strcmp(client_key, "idle_timeout")) {
+                            const char *v = ogs_yaml_iter_value(&client_iter);
+                            if (v) self.sbi.client.idle_timeout = atoi(v);
                         } else
                             ogs_warn("unknown key `%s`", client_key);
                     }
@@ -185,6 +185,17 @@ typedef struct ogs_app_context_s {
             const char *cacert;
             const char *cert;
             const char *key;
+
+            int io_thread;
+
+            int max_inflight;       /* client: per-peer in-flight requests */
+            int max_connection;     /* client: per-peer connections */
+            int idle_timeout;       /* client: idle connection reuse (sec) */
+
+            int load_queue;         /* server: queue depth at 100% load */
+            int load_latency;       /* server: latency (msec) at 100% load */
+            int overload_threshold; /* server: load (%) to send OCI */
+            int overload_validity;  /* server: OCI Period-of-Validity (sec) */
         } server, client;
     } sbi;
 
@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "asn_arena.h"
+
+/*
+ * One allocation of the pkbuf pool holds the arena header and the first
+ * chunk, sized so that it fits the 8K cluster with ogs_malloc() headroom.
+ * Larger messages chain more chunks.
+ */
+#define OGS_ASN_ARENA_SIZE      (8192 - sizeof(ogs_pkbuf_t *))
+#define OGS_ASN_ARENA_ALIGN(x)  (((x) + 7) & ~(size_t)7)
+
+/*
+ * Every block starts with its size, for REALLOC, and a tag made of the
+ * arena address. FREEMEM and REALLOC read the tag in front of a pointer
+ * to tell arena memory from the heap, instead of searching every chunk.
+ */
+#define OGS_ASN_ARENA_MAGIC     ((uintptr_t)0xa5a5a5a5a5a5a5a5ULL)
+#define OGS_ASN_ARENA_TAG(arena) ((uintptr_t)(arena) ^ OGS_ASN_ARENA_MAGIC)
+
+typedef struct ogs_asn_arena_block_s {
+    size_t          size;
+    uintptr_t       tag;
+} ogs_asn_arena_block_t;
+
+typedef struct ogs_asn_arena_chunk_s {
+    struct ogs_asn_arena_chunk_s *next;
+    uint8_t         *data;
+    size_t          size;
+    size_t          used;
+    uint8_t         *last;      /* Most recent allocation */
+} ogs_asn_arena_chunk_t;
+
+struct ogs_asn_arena_s {
+    ogs_lnode_t     lnode;
+
+    void            *root;      /* Decoded structure owning this arena */
+    size_t          root_size;
+    ogs_asn_arena_chunk_t *chunk;   /* Current chunk first */
+    ogs_asn_arena_chunk_t first;
+};
+
+__thread ogs_asn_arena_t *ogs_asn_arena_current;
+static __thread ogs_list_t arena_list;
+
+ogs_asn_arena_t *ogs_asn_arena_create(void *root, size_t root_size)
+{
+    ogs_asn_arena_t *arena = NULL;
+    size_t header = OGS_ASN_ARENA_ALIGN(sizeof(*arena));
+
+    ogs_assert(root);
+    ogs_assert(root_size);
+
+    arena = ogs_malloc(OGS_ASN_ARENA_SIZE);
+    if (!arena) {
+        ogs_error("ogs_malloc() failed");
+        return NULL;
+    }
+    memset(arena, 0, sizeof(*arena));
+
+    arena->root = root;
+    arena->root_size = root_size;
+    arena->first.data = (uint8_t *)arena + header;
+    arena->first.size = OGS_ASN_ARENA_SIZE - header;
+    arena->chunk = &arena->first;
+
+    ogs_list_add(&arena_list, arena);
+
+    return arena;
+}
+
+void ogs_asn_arena_destroy(ogs_asn_arena_t *arena)
+{
+    ogs_asn_arena_chunk_t *chunk = NULL, *next = NULL;
+
+    ogs_assert(arena);
+    ogs_assert(ogs_asn_arena_current != arena);
+
+    ogs_list_remove(&arena_list, arena);
+
+    for (chunk = arena->chunk; chunk != &arena->first; chunk = next) {
+        next = chunk->next;
+        ogs_free(chunk);
+    }
+
+    memset(arena->root, 0, arena->root_size);
+
+    ogs_free(arena);
+}
+
+void ogs_asn_arena_detach(ogs_asn_arena_t *arena)
+{
+    ogs_assert(arena);
+    ogs_assert(ogs_asn_arena_current != arena);
+
+    ogs_list_remove(&arena_list, arena);
+}
+
+void ogs_asn_arena_attach(ogs_asn_arena_t *arena)
+{
+    ogs_assert(arena);
+
+    ogs_list_add(&arena_list, arena);
+}
+
+void ogs_asn_arena_enter(ogs_asn_arena_t *arena)
+{
+    ogs_assert(arena);
+    ogs_assert(ogs_asn_arena_current == NULL);
+
+    ogs_asn_arena_current = arena;
+}
+
+void ogs_asn_arena_leave(void)
+{
+    ogs_assert(ogs_asn_arena_current);
+
+    ogs_asn_arena_current = NULL;
+}
+
+void *ogs_asn_arena_alloc(ogs_asn_arena_t *arena, size_t size)
+{
+    ogs_asn_arena_chunk_t *chunk = NULL;
+    ogs_asn_arena_block_t *block = NULL;
+    size_t need;
+
+    ogs_assert(arena);
+
+    need = OGS_ASN_ARENA_ALIGN(sizeof(*block) + size);
+
+    chunk = arena->chunk;
+    if (chunk->size - chunk->used < need) {
+        size_t header = OGS_ASN_ARENA_ALIGN(sizeof(*chunk));
+        size_t chunk_size = ogs_max(OGS_ASN_ARENA_SIZE, header + need);
+
+        chunk = ogs_malloc(chunk_size);
+        if (!chunk) {
+            ogs_error("ogs_malloc() failed");
+            return NULL;
+        }
+        memset(chunk, 0, sizeof(*chunk));
+        chunk->data = (uint8_t *)chunk + header;
+        chunk->size = chunk_size - header;
+
+        chunk->next = arena->chunk;
+        arena->chunk = chunk;
+    }
+
+    block = (ogs_asn_arena_block_t *)(chunk->data + chunk->used);
+    chunk->used += need;
+    chunk->last = (uint8_t *)block;
+
+    block->size = size;
+    block->tag = OGS_ASN_ARENA_TAG(arena);
+
+    return block + 1;
+}
+
+void *ogs_asn_arena_realloc(ogs_asn_arena_t *arena, void *oldptr, size_t size)
+{
+    ogs_asn_arena_chunk_t *chunk = NULL;
+    ogs_asn_arena_block_t *block = NULL;
+    void *ptr = NULL;
+
+    ogs_assert(arena);
+
+    if (!oldptr)
+        return ogs_asn_arena_alloc(arena, size);
+
+    block = (ogs_asn_arena_block_t *)oldptr - 1;
+    ogs_assert(block->tag == OGS_ASN_ARENA_TAG(arena));
+
+    if (size <= block->size)
+        return oldptr;
+
+    /* Grow the most recent block in place, e.g. SEQUENCE OF arrays */
+    chunk = arena->chunk;
+    if ((uint8_t *)block == chunk->last) {
+        size_t need = OGS_ASN_ARENA_ALIGN(sizeof(*block) + size);
+        if ((size_t)((uint8_t *)block - chunk->data) + need <= chunk->size) {
+            chunk->used = ((uint8_t *)block - chunk->data) + need;
+            block->size = size;
+            return oldptr;
+        }
+    }
+
+    ptr = ogs_asn_arena_alloc(arena, size);
+    if (!ptr)
+        return NULL;
+
+    memcpy(ptr, oldptr, block->size);
+
+    return ptr;
+}
+
+ogs_asn_arena_t *ogs_asn_arena_find(const void *ptr)
+{
+    ogs_asn_arena_t *arena = NULL, *tagged = NULL;
+    ogs_asn_arena_chunk_t *chunk = NULL;
+    const uint8_t *p = ptr;
+    uintptr_t tag;
+
+    ogs_assert(ptr);
+
+    /* Nothing decoded on this thread, so it comes from the heap */
+    if (ogs_list_first(&arena_list) == NULL)
+        return NULL;
+
+    /* The word in front of a heap block belongs to the allocator */
+    memcpy(&tag, p - sizeof(tag), sizeof(tag));
+    tagged = (ogs_asn_arena_t *)(tag ^ OGS_ASN_ARENA_MAGIC);
+
+    ogs_list_for_each(&arena_list, arena) {
+        if (arena != tagged)
+            continue;
+
+        /* Rule out a heap word that happens to look like the tag */
+        for (chunk = arena->chunk; chunk; chunk = chunk->next) {
+            if (p > chunk->data && p < chunk->data + chunk->used)
+                return arena;
+        }
+        break;
+    }
+
+    return NULL;
+}
+
+ogs_asn_arena_t *ogs_asn_arena_find_by_root(const void *root)
+{
+    ogs_asn_arena_t *arena = NULL;
+
+    ogs_list_for_each(&arena_list, arena) {
+        if (arena->root == root)
+            return arena;
+    }
+
+    return NULL;
+}
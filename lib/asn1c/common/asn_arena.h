@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ASN_ARENA_H
+#define ASN_ARENA_H
+
+#include "ogs-core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Per-message bump allocator for the APER decoder.
+ *
+ * While an arena is entered, MALLOC/CALLOC/REALLOC of the asn1c support
+ * code take memory from it and FREEMEM of arena memory is a no-op.
+ * The whole decoded tree is released at once by ogs_asn_arena_destroy(),
+ * which also clears the root structure like ASN_STRUCT_FREE_CONTENTS_ONLY.
+ * Arenas are tracked per thread, so a message must be freed by the
+ * thread that decoded it, unless its arena is detached there and
+ * attached to the thread that frees it.
+ */
+typedef struct ogs_asn_arena_s ogs_asn_arena_t;
+
+extern __thread ogs_asn_arena_t *ogs_asn_arena_current;
+
+ogs_asn_arena_t *ogs_asn_arena_create(void *root, size_t root_size);
+void ogs_asn_arena_destroy(ogs_asn_arena_t *arena);
+
+void ogs_asn_arena_detach(ogs_asn_arena_t *arena);
+void ogs_asn_arena_attach(ogs_asn_arena_t *arena);
+
+void ogs_asn_arena_enter(ogs_asn_arena_t *arena);
+void ogs_asn_arena_leave(void);
+
+void *ogs_asn_arena_alloc(ogs_asn_arena_t *arena, size_t size);
+void *ogs_asn_arena_realloc(
+        ogs_asn_arena_t *arena, void *oldptr, size_t size);
+
+ogs_asn_arena_t *ogs_asn_arena_find(const void *ptr);
+ogs_asn_arena_t *ogs_asn_arena_find_by_root(const void *root);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASN_ARENA_H */
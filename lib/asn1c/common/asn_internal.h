@@ -41,10 +41,16 @@ int get_asn1c_environment_version(void);	/* Run-time version */
 #define	FREEMEM(ptr)		free(ptr)
 #else
 #include "proto/ogs-proto.h"
+#include "asn_arena.h"
 
 static ogs_inline void *ogs_asn_malloc(size_t size, const char *file_line)
 {
-    void *ptr = ogs_malloc(size);
+    void *ptr = NULL;
+
+    if (ogs_asn_arena_current)
+        ptr = ogs_asn_arena_alloc(ogs_asn_arena_current, size);
+    else
+        ptr = ogs_malloc(size);
     if (!ptr) {
         ogs_fatal("asn_malloc() failed in `%s`", file_line);
         ogs_assert_if_reached();
@@ -55,7 +61,14 @@ static ogs_inline void *ogs_asn_malloc(size_t size, const char *file_line)
 static ogs_inline void *ogs_asn_calloc(
         size_t nmemb, size_t size, const char *file_line)
 {
-    void *ptr = ogs_calloc(nmemb, size);
+    void *ptr = NULL;
+
+    if (ogs_asn_arena_current) {
+        ptr = ogs_asn_arena_alloc(ogs_asn_arena_current, nmemb * size);
+        if (ptr)
+            memset(ptr, 0, nmemb * size);
+    } else
+        ptr = ogs_calloc(nmemb, size);
     if (!ptr) {
         ogs_fatal("asn_calloc() failed in `%s`", file_line);
         ogs_assert_if_reached();
@@ -66,7 +79,18 @@ static ogs_inline void *ogs_asn_calloc(
 static ogs_inline void *ogs_asn_realloc(
         void *oldptr, size_t size, const char *file_line)
 {
-    void *ptr = ogs_realloc(oldptr, size);
+    ogs_asn_arena_t *arena = NULL;
+    void *ptr = NULL;
+
+    if (oldptr)
+        arena = ogs_asn_arena_find(oldptr);
+    else
+        arena = ogs_asn_arena_current;
+
+    if (arena)
+        ptr = ogs_asn_arena_realloc(arena, oldptr, size);
+    else
+        ptr = ogs_realloc(oldptr, size);
     if (!ptr) {
         ogs_fatal("asn_realloc() failed in `%s`", file_line);
         ogs_assert_if_reached();
@@ -74,11 +98,19 @@ static ogs_inline void *ogs_asn_realloc(
 
     return ptr;
 }
+static ogs_inline void ogs_asn_freemem(void *ptr)
+{
+    /* Arena memory is released with the whole message */
+    if (ptr && ogs_asn_arena_find(ptr))
+        return;
+
+    ogs_free(ptr);
+}
 
 #define CALLOC(nmemb, size) ogs_asn_calloc(nmemb, size, OGS_FILE_LINE)
 #define MALLOC(size) ogs_asn_malloc(size, OGS_FILE_LINE)
 #define REALLOC(oldptr, size) ogs_asn_realloc(oldptr, size, OGS_FILE_LINE)
-#define FREEMEM(ptr) ogs_free(ptr)
+#define FREEMEM(ptr) ogs_asn_freemem(ptr)
 
 #endif
 
@@ -19,6 +19,46 @@
 
 #include "message.h"
 
+/*
+ * Encode into a small pkbuf and grow it as the encoder emits bytes,
+ * instead of reserving OGS_MAX_SDU_LEN for every PDU.
+ */
+#define OGS_ASN_ENCODE_INITIAL_SIZE 512
+
+static int encode_to_pkbuf_cb(const void *buffer, size_t size, void *key)
+{
+    ogs_pkbuf_t **pkbuf = key;
+    ogs_pkbuf_t *newbuf = NULL;
+    size_t newsize;
+
+    ogs_assert(pkbuf);
+    ogs_assert(*pkbuf);
+
+    if ((size_t)ogs_pkbuf_tailroom(*pkbuf) < size) {
+        newsize = ((*pkbuf)->len + size) * 2;
+        if (newsize > OGS_MAX_SDU_LEN)
+            newsize = OGS_MAX_SDU_LEN;
+        if (newsize < (*pkbuf)->len + size) {
+            ogs_error("ASN-PDU exceeds %d bytes", OGS_MAX_SDU_LEN);
+            return -1;
+        }
+
+        newbuf = ogs_pkbuf_alloc(NULL, newsize);
+        if (!newbuf) {
+            ogs_error("ogs_pkbuf_alloc() failed");
+            return -1;
+        }
+        ogs_pkbuf_put_data(newbuf, (*pkbuf)->data, (*pkbuf)->len);
+
+        ogs_pkbuf_free(*pkbuf);
+        *pkbuf = newbuf;
+    }
+
+    ogs_pkbuf_put_data(*pkbuf, buffer, size);
+
+    return 0;
+}
+
 ogs_pkbuf_t *ogs_asn_encode(const asn_TYPE_descriptor_t *td, void *sptr)
 {
     asn_enc_rval_t enc_ret = {0};
@@ -27,15 +67,13 @@ ogs_pkbuf_t *ogs_asn_encode(const asn_TYPE_descriptor_t *td, void *sptr)
     ogs_assert(td);
     ogs_assert(sptr);
 
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_ASN_ENCODE_INITIAL_SIZE);
     if (!pkbuf) {
         ogs_error("ogs_pkbuf_alloc() failed");
         return NULL;
     }
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN);
 
-    enc_ret = aper_encode_to_buffer(td, NULL,
-                    sptr, pkbuf->data, OGS_MAX_SDU_LEN);
+    enc_ret = aper_encode(td, NULL, sptr, encode_to_pkbuf_cb, &pkbuf);
     ogs_asn_free(td, sptr);
 
     if (enc_ret.encoded < 0) {
@@ -44,15 +82,20 @@ ogs_pkbuf_t *ogs_asn_encode(const asn_TYPE_descriptor_t *td, void *sptr)
         return NULL;
     }
 
-    ogs_pkbuf_trim(pkbuf, ((enc_ret.encoded + 7) >> 3));
+    ogs_assert(pkbuf->len == ((enc_ret.encoded + 7) >> 3));
 
     return pkbuf;
 }
 
+/*
+ * The decoded tree lives in a per-message arena: the decoder does
+ * bump allocations and ogs_asn_free() releases the arena at once.
+ */
 int ogs_asn_decode(const asn_TYPE_descriptor_t *td,
         void *struct_ptr, size_t struct_size, ogs_pkbuf_t *pkbuf)
 {
     asn_dec_rval_t dec_ret = {0};
+    ogs_asn_arena_t *arena = NULL;
 
     ogs_assert(td);
     ogs_assert(struct_ptr);
@@ -61,13 +104,30 @@ int ogs_asn_decode(const asn_TYPE_descriptor_t *td,
     ogs_assert(pkbuf->data);
     ogs_assert(pkbuf->len);
 
+    /* A previous message at this address was never freed */
+    arena = ogs_asn_arena_find_by_root(struct_ptr);
+    if (arena)
+        ogs_asn_arena_destroy(arena);
+
     memset(struct_ptr, 0, struct_size);
+
+    /* Without an arena, fall back to the heap */
+    arena = ogs_asn_arena_create(struct_ptr, struct_size);
+    if (arena)
+        ogs_asn_arena_enter(arena);
+
     dec_ret = aper_decode(NULL, td, (void **)&struct_ptr,
             pkbuf->data, pkbuf->len, 0, 0);
 
+    if (arena)
+        ogs_asn_arena_leave();
+
     if (dec_ret.code != RC_OK) {
         ogs_warn("Failed to decode ASN-PDU [code:%d,consumed:%d]",
                 dec_ret.code, (int)dec_ret.consumed);
+        /* Drop the partial tree, ogs_asn_free() then has nothing to do */
+        if (arena)
+            ogs_asn_arena_destroy(arena);
         return OGS_ERROR;
     }
 
@@ -76,8 +136,36 @@ int ogs_asn_decode(const asn_TYPE_descriptor_t *td,
 
 void ogs_asn_free(const asn_TYPE_descriptor_t *td, void *sptr)
 {
+    ogs_asn_arena_t *arena = NULL;
+
     ogs_assert(td);
     ogs_assert(sptr);
 
+    arena = ogs_asn_arena_find_by_root(sptr);
+    if (arena) {
+        ogs_asn_arena_destroy(arena);
+        return;
+    }
+
     ASN_STRUCT_FREE_CONTENTS_ONLY(*td, sptr);
 }
+
+ogs_asn_arena_t *ogs_asn_detach(void *sptr)
+{
+    ogs_asn_arena_t *arena = NULL;
+
+    ogs_assert(sptr);
+
+    /* NULL if the tree was decoded on the heap */
+    arena = ogs_asn_arena_find_by_root(sptr);
+    if (arena)
+        ogs_asn_arena_detach(arena);
+
+    return arena;
+}
+
+void ogs_asn_attach(ogs_asn_arena_t *arena)
+{
+    if (arena)
+        ogs_asn_arena_attach(arena);
+}
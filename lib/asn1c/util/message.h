@@ -34,6 +34,10 @@ int ogs_asn_decode(const asn_TYPE_descriptor_t *td,
         void *struct_ptr, size_t struct_size, ogs_pkbuf_t *pkbuf);
 void ogs_asn_free(const asn_TYPE_descriptor_t *td, void *sptr);
 
+/* Hand a decoded structure over to another thread */
+ogs_asn_arena_t *ogs_asn_detach(void *sptr);
+void ogs_asn_attach(ogs_asn_arena_t *arena);
+
 #ifdef __cplusplus
 }
 #endif
@@ -53,6 +53,7 @@
 #include "core/ogs-udp.h"
 #include "core/ogs-tcp.h"
 #include "core/ogs-queue.h"
+#include "core/ogs-worker.h"
 #include "core/ogs-poll.h"
 #include "core/ogs-notify.h"
 #include "core/ogs-tlv.h"
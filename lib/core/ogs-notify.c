@@ -48,7 +48,7 @@ void ogs_notify_init(ogs_pollset_t *pollset)
 #endif
 
     pollset->notify.poll = ogs_pollset_add(pollset, OGS_POLLIN,
-            pollset->notify.fd[0], ogs_drain_pollset, NULL);
+            pollset->notify.fd[0], ogs_drain_pollset, pollset);
     ogs_assert(pollset->notify.poll);
 }
 
@@ -90,8 +90,22 @@ int ogs_notify_pollset(ogs_pollset_t *pollset)
     return OGS_OK;
 }
 
+/*
+ * The handler runs from ogs_pollset_poll() of the thread owning the pollset
+ * after ogs_pollset_notify() woke it up, i.e. between two event dispatches.
+ */
+void ogs_notify_set_handler(ogs_pollset_t *pollset,
+        void (*handler)(void *data), void *data)
+{
+    ogs_assert(pollset);
+
+    pollset->notify.handler = handler;
+    pollset->notify.data = data;
+}
+
 static void ogs_drain_pollset(short when, ogs_socket_t fd, void *data)
 {
+    ogs_pollset_t *pollset = data;
     ssize_t r;
 #if defined(HAVE_EVENTFD)
     uint64_t msg;
@@ -109,4 +123,8 @@ static void ogs_drain_pollset(short when, ogs_socket_t fd, void *data)
     if (r < 0) {
         ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno, "drain failed");
     }
+
+    ogs_assert(pollset);
+    if (pollset->notify.handler)
+        pollset->notify.handler(pollset->notify.data);
 }
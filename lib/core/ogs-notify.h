@@ -31,6 +31,8 @@ extern "C" {
 void ogs_notify_init(ogs_pollset_t *pollset);
 void ogs_notify_final(ogs_pollset_t *pollset);
 int ogs_notify_pollset(ogs_pollset_t *pollset);
+void ogs_notify_set_handler(ogs_pollset_t *pollset,
+        void (*handler)(void *data), void *data);
 
 #ifdef __cplusplus
 }
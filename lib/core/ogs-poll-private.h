@@ -47,6 +47,9 @@ typedef struct ogs_pollset_s {
     struct {
         ogs_socket_t fd[2];
         ogs_poll_t *poll;
+
+        void (*handler)(void *data);    /* Run after each wakeup */
+        void *data;
     } notify;
 
     unsigned int capacity;
@@ -0,0 +1,170 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ogs-core.h"
+
+struct ogs_worker_pool_s {
+    ogs_queue_t *queue;
+    ogs_thread_t **thread_array;
+    int num_of_worker;
+
+    ogs_worker_run_f run;
+    ogs_worker_done_f done;
+    ogs_worker_free_f free_job;
+
+    /* Jobs submitted but not yet completed (owner thread only) */
+    ogs_list_t job_list;
+};
+
+static void worker_main(void *data);
+
+ogs_worker_pool_t *ogs_worker_pool_create(
+        int num_of_worker, unsigned int capacity,
+        ogs_worker_run_f run, ogs_worker_done_f done,
+        ogs_worker_free_f free_job)
+{
+    ogs_worker_pool_t *pool = NULL;
+    int i;
+
+    ogs_assert(num_of_worker > 0);
+    ogs_assert(capacity);
+    ogs_assert(run);
+    ogs_assert(done);
+    ogs_assert(free_job);
+
+    pool = ogs_calloc(1, sizeof(*pool));
+    if (!pool) {
+        ogs_error("ogs_calloc() failed");
+        return NULL;
+    }
+
+    pool->run = run;
+    pool->done = done;
+    pool->free_job = free_job;
+    ogs_list_init(&pool->job_list);
+
+    pool->queue = ogs_queue_create(capacity);
+    if (!pool->queue) {
+        ogs_error("ogs_queue_create() failed");
+        ogs_free(pool);
+        return NULL;
+    }
+
+    pool->thread_array = ogs_calloc(num_of_worker, sizeof(ogs_thread_t *));
+    if (!pool->thread_array) {
+        ogs_error("ogs_calloc() failed");
+        ogs_worker_pool_destroy(pool);
+        return NULL;
+    }
+
+    for (i = 0; i < num_of_worker; i++) {
+        pool->thread_array[i] = ogs_thread_create(worker_main, pool);
+        if (!pool->thread_array[i]) {
+            ogs_error("ogs_thread_create() failed");
+            ogs_worker_pool_destroy(pool);
+            return NULL;
+        }
+        pool->num_of_worker++;
+    }
+
+    return pool;
+}
+
+void ogs_worker_pool_destroy(ogs_worker_pool_t *pool)
+{
+    ogs_worker_job_t *job = NULL, *next_job = NULL;
+    int i;
+
+    ogs_assert(pool);
+
+    ogs_queue_term(pool->queue);
+
+    for (i = 0; i < pool->num_of_worker; i++)
+        ogs_thread_destroy(pool->thread_array[i]);
+    if (pool->thread_array)
+        ogs_free(pool->thread_array);
+
+    ogs_queue_destroy(pool->queue);
+
+    /* Jobs still queued or whose completion was never handled */
+    ogs_list_for_each_safe(&pool->job_list, next_job, job) {
+        ogs_list_remove(&pool->job_list, job);
+        pool->free_job(job);
+    }
+
+    ogs_free(pool);
+}
+
+/*
+ * Returns OGS_ERROR if the queue is full. The job is then still owned
+ * by the caller.
+ */
+int ogs_worker_pool_submit(ogs_worker_pool_t *pool, ogs_worker_job_t *job)
+{
+    int rv;
+
+    ogs_assert(pool);
+    ogs_assert(job);
+
+    job->submitted = ogs_get_monotonic_time();
+
+    /* A worker may finish the job before ogs_queue_trypush() returns */
+    ogs_list_add(&pool->job_list, job);
+
+    rv = ogs_queue_trypush(pool->queue, job);
+    if (rv != OGS_OK) {
+        ogs_list_remove(&pool->job_list, job);
+        return OGS_ERROR;
+    }
+
+    return OGS_OK;
+}
+
+void ogs_worker_pool_complete(ogs_worker_pool_t *pool, ogs_worker_job_t *job)
+{
+    ogs_assert(pool);
+    ogs_assert(job);
+
+    ogs_list_remove(&pool->job_list, job);
+}
+
+static void worker_main(void *data)
+{
+    ogs_worker_pool_t *pool = data;
+    int rv;
+
+    ogs_assert(pool);
+
+    for ( ;; ) {
+        ogs_worker_job_t *job = NULL;
+
+        rv = ogs_queue_pop(pool->queue, (void **)&job);
+        if (rv == OGS_DONE)
+            break;
+        if (rv != OGS_OK)
+            continue;
+
+        ogs_assert(job);
+
+        job->started = ogs_get_monotonic_time();
+        pool->run(job);
+        job->finished = ogs_get_monotonic_time();
+
+        /* On error the owner is terminating and destroy frees the job */
+        if (pool->done(job) != OGS_OK)
+            break;
+    }
+}
@@ -0,0 +1,66 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if !defined(OGS_CORE_INSIDE) && !defined(OGS_CORE_COMPILATION)
+#error "This header cannot be included directly."
+#endif
+
+#ifndef OGS_WORKER_H
+#define OGS_WORKER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A bounded queue of jobs served by a fixed number of threads.
+ *
+ * The owner thread submits jobs and completes them. A worker runs a job
+ * and hands it back with the 'done' callback, which usually posts an
+ * event to the owner. Between submit and complete the job belongs to
+ * the pool, and jobs never completed are freed on destroy.
+ */
+typedef struct ogs_worker_job_s {
+    ogs_lnode_t lnode;
+
+    ogs_time_t submitted;
+    ogs_time_t started;
+    ogs_time_t finished;
+} ogs_worker_job_t;
+
+typedef struct ogs_worker_pool_s ogs_worker_pool_t;
+
+/* Called on a worker thread */
+typedef void (*ogs_worker_run_f)(ogs_worker_job_t *job);
+/* Called on a worker thread. OGS_ERROR stops the worker */
+typedef int (*ogs_worker_done_f)(ogs_worker_job_t *job);
+/* Called on the owner thread from ogs_worker_pool_destroy() */
+typedef void (*ogs_worker_free_f)(ogs_worker_job_t *job);
+
+ogs_worker_pool_t *ogs_worker_pool_create(
+        int num_of_worker, unsigned int capacity,
+        ogs_worker_run_f run, ogs_worker_done_f done,
+        ogs_worker_free_f free_job);
+void ogs_worker_pool_destroy(ogs_worker_pool_t *pool);
+
+int ogs_worker_pool_submit(ogs_worker_pool_t *pool, ogs_worker_job_t *job);
+void ogs_worker_pool_complete(ogs_worker_pool_t *pool, ogs_worker_job_t *job);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGS_WORKER_H */
@@ -1045,22 +1045,33 @@ static void mod_sqrt(uint64_t a[NUM_ECC_DIGITS])
     vli_set(a, l_result);
 }
 
-static void ecc_point_decompress(EccPoint *p_point, const uint8_t p_compressed[ECC_BYTES+1])
+static int ecc_point_decompress(EccPoint *p_point, const uint8_t p_compressed[ECC_BYTES+1])
 {
     uint64_t _3[NUM_ECC_DIGITS] = {3}; /* -a = 3 */
+    uint64_t l_rhs[NUM_ECC_DIGITS];
+    uint64_t l_check[NUM_ECC_DIGITS];
     ecc_bytes2native(p_point->x, p_compressed+1);
     
     vli_modSquare_fast(p_point->y, p_point->x); /* y = x^2 */
     vli_modSub(p_point->y, p_point->y, _3, curve_p); /* y = x^2 - 3 */
     vli_modMult_fast(p_point->y, p_point->y, p_point->x); /* y = x^3 - 3x */
     vli_modAdd(p_point->y, p_point->y, curve_b, curve_p); /* y = x^3 - 3x + b */
+    vli_set(l_rhs, p_point->y);
     
     mod_sqrt(p_point->y);
     
+    /* Reject x with no square root, i.e. not on the curve */
+    vli_modSquare_fast(l_check, p_point->y);
+    if(vli_cmp(l_check, l_rhs) != 0)
+    {
+        return 0;
+    }
+    
     if((p_point->y[0] & 0x01) != (p_compressed[0] & 0x01))
     {
         vli_sub(p_point->y, curve_p, p_point->y);
     }
+    return 1;
 }
 
 int ecc_make_key(uint8_t p_publicKey[ECC_BYTES+1], uint8_t p_privateKey[ECC_BYTES])
@@ -1107,7 +1118,10 @@ int ecdh_shared_secret(const uint8_t p_publicKey[ECC_BYTES+1], const uint8_t p_p
         return 0;
     }
     
-    ecc_point_decompress(&l_public, p_publicKey);
+    if(!ecc_point_decompress(&l_public, p_publicKey))
+    {
+        return 0;
+    }
     ecc_bytes2native(l_private, p_privateKey);
     
     EccPoint l_product;
@@ -1250,7 +1264,10 @@ int ecdsa_verify(const uint8_t p_publicKey[ECC_BYTES+1], const uint8_t p_hash[EC
     
     uint64_t l_r[NUM_ECC_DIGITS], l_s[NUM_ECC_DIGITS];
     
-    ecc_point_decompress(&l_public, p_publicKey);
+    if(!ecc_point_decompress(&l_public, p_publicKey))
+    {
+        return 0;
+    }
     ecc_bytes2native(l_r, p_signature);
     ecc_bytes2native(l_s, p_signature + ECC_BYTES);
     
@@ -27,19 +27,32 @@ static void ShiftBits(uint8_t r, uint8_t rijndaelInput[16],
 static uint8_t *bits_shift(uint32_t bit_valid, uint8_t *dst,
                             uint8_t *src, uint32_t numBits);
 
-static int aes_128_encrypt_block(const uint8_t *key,
-    const uint8_t *in, uint8_t *out)
+/*
+ * The key schedule of K is expanded once per call and shared by all
+ * of the block encryptions below.
+ */
+#define MILENAGE_RKLENGTH OGS_AES_RKLENGTH(128)
+
+static void aes_128_setup(uint32_t *rk, const uint8_t *key)
 {
-    const int key_bits = 128;
-    unsigned int rk[OGS_AES_RKLENGTH(128)];
-    int nrounds;
+    ogs_aes_setup_enc(rk, key, 128);
+}
 
-    nrounds = ogs_aes_setup_enc(rk, key, key_bits);
-    ogs_aes_encrypt(rk, nrounds, in, out);
+static int aes_128_encrypt_block(const uint32_t *rk,
+    const uint8_t *in, uint8_t *out)
+{
+    ogs_aes_encrypt(rk, OGS_AES_NROUNDS(128), in, out);
 
     return 0;
 }
 
+static int milenage_f1_rk(const uint8_t *opc, const uint32_t *rk,
+    const uint8_t *_rand, const uint8_t *sqn,
+    const uint8_t *amf, uint8_t *mac_a, uint8_t *mac_s);
+static int milenage_f2345_rk(const uint8_t *opc, const uint32_t *rk,
+    const uint8_t *_rand, uint8_t *res, uint8_t *ck,
+    uint8_t *ik, uint8_t *ak, uint8_t *akstar);
+
 /**
  * milenage_f1 - Milenage f1 and f1* algorithms
  * @opc: OPc = 128-bit value derived from OP and K
@@ -54,6 +67,16 @@ static int aes_128_encrypt_block(const uint8_t *key,
 int milenage_f1(const uint8_t *opc, const uint8_t *k, 
     const uint8_t *_rand, const uint8_t *sqn, 
     const uint8_t *amf, uint8_t *mac_a, uint8_t *mac_s)
+{
+	uint32_t rk[MILENAGE_RKLENGTH];
+
+	aes_128_setup(rk, k);
+	return milenage_f1_rk(opc, rk, _rand, sqn, amf, mac_a, mac_s);
+}
+
+static int milenage_f1_rk(const uint8_t *opc, const uint32_t *rk,
+    const uint8_t *_rand, const uint8_t *sqn,
+    const uint8_t *amf, uint8_t *mac_a, uint8_t *mac_s)
 {
 	uint8_t tmp1[16], tmp2[16], tmp3[16];
 	int i;
@@ -63,7 +86,7 @@ int milenage_f1(const uint8_t *opc, const uint8_t *k,
 
 	for (i = 0; i < 16; i++)
 		tmp1[i] = _rand[i] ^ opc[i];
-	if (aes_128_encrypt_block(k, tmp1, tmp1))
+	if (aes_128_encrypt_block(rk, tmp1, tmp1))
 		return -1;
 
 	/* tmp2 = IN1 = SQN || AMF || SQN || AMF */
@@ -86,7 +109,7 @@ int milenage_f1(const uint8_t *opc, const uint8_t *k,
 	/* XOR with c1 (= ..00, i.e., NOP) */
 
 	/* f1 || f1* = E_K(tmp3) XOR OP_c */
-	if (aes_128_encrypt_block(k, tmp3, tmp1))
+	if (aes_128_encrypt_block(rk, tmp3, tmp1))
 		return -1;
 	for (i = 0; i < 16; i++)
 		tmp1[i] ^= opc[i];
@@ -113,6 +136,16 @@ int milenage_f1(const uint8_t *opc, const uint8_t *k,
 int milenage_f2345(const uint8_t *opc, const uint8_t *k, 
     const uint8_t *_rand, uint8_t *res, uint8_t *ck, 
     uint8_t *ik, uint8_t *ak, uint8_t *akstar)
+{
+	uint32_t rk[MILENAGE_RKLENGTH];
+
+	aes_128_setup(rk, k);
+	return milenage_f2345_rk(opc, rk, _rand, res, ck, ik, ak, akstar);
+}
+
+static int milenage_f2345_rk(const uint8_t *opc, const uint32_t *rk,
+    const uint8_t *_rand, uint8_t *res, uint8_t *ck,
+    uint8_t *ik, uint8_t *ak, uint8_t *akstar)
 {
 	uint8_t tmp1[16], tmp2[16], tmp3[16];
 	int i;
@@ -127,7 +160,7 @@ int milenage_f2345(const uint8_t *opc, const uint8_t *k,
 	/* tmp2 = TEMP = E_K(RAND XOR OP_C) */
 	for (i = 0; i < 16; i++)
 		tmp1[i] = _rand[i] ^ opc[i];
-	if (aes_128_encrypt_block(k, tmp1, tmp2))
+	if (aes_128_encrypt_block(rk, tmp1, tmp2))
 		return -1;
 
 	/* OUT2 = E_K(rot(TEMP XOR OP_C, r2) XOR c2) XOR OP_C */
@@ -145,7 +178,7 @@ int milenage_f2345(const uint8_t *opc, const uint8_t *k,
 #endif
 	tmp1[15] ^= 1; /* XOR c2 (= ..01) */
 	/* f5 || f2 = E_K(tmp1) XOR OP_c */
-	if (aes_128_encrypt_block(k, tmp1, tmp3))
+	if (aes_128_encrypt_block(rk, tmp1, tmp3))
 		return -1;
 	for (i = 0; i < 16; i++)
 		tmp3[i] ^= opc[i];
@@ -164,7 +197,7 @@ int milenage_f2345(const uint8_t *opc, const uint8_t *k,
         ShiftBits(r3, tmp1, tmp2, opc);
 #endif
 		tmp1[15] ^= 2; /* XOR c3 (= ..02) */
-		if (aes_128_encrypt_block(k, tmp1, ck))
+		if (aes_128_encrypt_block(rk, tmp1, ck))
 			return -1;
 		for (i = 0; i < 16; i++)
 			ck[i] ^= opc[i];
@@ -180,7 +213,7 @@ int milenage_f2345(const uint8_t *opc, const uint8_t *k,
         ShiftBits(r4, tmp1, tmp2, opc);
 #endif
 		tmp1[15] ^= 4; /* XOR c4 (= ..04) */
-		if (aes_128_encrypt_block(k, tmp1, ik))
+		if (aes_128_encrypt_block(rk, tmp1, ik))
 			return -1;
 		for (i = 0; i < 16; i++)
 			ik[i] ^= opc[i];
@@ -196,7 +229,7 @@ int milenage_f2345(const uint8_t *opc, const uint8_t *k,
         ShiftBits(r5, tmp1, tmp2, opc);
 #endif
 		tmp1[15] ^= 8; /* XOR c5 (= ..08) */
-		if (aes_128_encrypt_block(k, tmp1, tmp1))
+		if (aes_128_encrypt_block(rk, tmp1, tmp1))
 			return -1;
 		for (i = 0; i < 6; i++)
 			akstar[i] = tmp1[i] ^ opc[i];
@@ -226,13 +259,15 @@ void milenage_generate(const uint8_t *opc, const uint8_t *amf,
 {
 	int i;
 	uint8_t mac_a[8];
+	uint32_t rk[MILENAGE_RKLENGTH];
 
 	if (*res_len < 8) {
 		*res_len = 0;
 		return;
 	}
-	if (milenage_f1(opc, k, _rand, sqn, amf, mac_a, NULL) ||
-	    milenage_f2345(opc, k, _rand, res, ck, ik, ak, NULL)) {
+	aes_128_setup(rk, k);
+	if (milenage_f1_rk(opc, rk, _rand, sqn, amf, mac_a, NULL) ||
+	    milenage_f2345_rk(opc, rk, _rand, res, ck, ik, ak, NULL)) {
 		*res_len = 0;
 		return;
 	}
@@ -245,6 +280,91 @@ void milenage_generate(const uint8_t *opc, const uint8_t *amf,
 	os_memcpy(autn + 8, mac_a, 8);
 }
 
+/**
+ * milenage_generate_batch - Generate AKA vectors for several subscribers
+ * @batch: Array of inputs (OPc, K, AMF, SQN, RAND) and outputs
+ * @num: Number of entries in @batch
+ *
+ * Every vector needs E_K(RAND XOR OPc) first and then four independent
+ * encryptions (f1, f2/f5, f3, f4). Each stage is run over all entries
+ * with ogs_aes_encrypt_blocks() so that the AES pipelines interleave.
+ */
+void milenage_generate_batch(milenage_batch_t *batch, int num)
+{
+    uint32_t rk[MILENAGE_BATCH_MAX][MILENAGE_RKLENGTH];
+    const uint32_t *rkp[4 * MILENAGE_BATCH_MAX];
+    uint8_t in[4 * MILENAGE_BATCH_MAX][16];
+    uint8_t out[4 * MILENAGE_BATCH_MAX][16];
+    uint8_t temp[MILENAGE_BATCH_MAX][16];
+    uint8_t in1[16];
+    milenage_batch_t *v = NULL;
+    int i, j, n;
+
+    ogs_assert(batch);
+
+    while (num > 0) {
+        n = ogs_min(num, MILENAGE_BATCH_MAX);
+
+        /* TEMP = E_K(RAND XOR OP_C) */
+        for (i = 0; i < n; i++) {
+            v = &batch[i];
+            aes_128_setup(rk[i], v->k);
+            for (j = 0; j < 16; j++)
+                in[i][j] = v->rand[j] ^ v->opc[j];
+            rkp[i] = rk[i];
+        }
+        ogs_aes_encrypt_blocks(rkp, OGS_AES_NROUNDS(128),
+                in[0], temp[0], n);
+
+        /* OUT1..OUT4 = E_K(rot(... XOR OP_C, r) XOR c) */
+        for (i = 0; i < n; i++) {
+            v = &batch[i];
+
+            memcpy(in1, v->sqn, 6);
+            memcpy(in1 + 6, v->amf, 2);
+            memcpy(in1 + 8, in1, 8);
+            ShiftBits(64, in[4*i], in1, v->opc);
+            for (j = 0; j < 16; j++)
+                in[4*i][j] ^= temp[i][j];
+
+            ShiftBits(0, in[4*i+1], temp[i], v->opc);
+            in[4*i+1][15] ^= 1;
+            ShiftBits(32, in[4*i+2], temp[i], v->opc);
+            in[4*i+2][15] ^= 2;
+            ShiftBits(64, in[4*i+3], temp[i], v->opc);
+            in[4*i+3][15] ^= 4;
+
+            for (j = 0; j < 4; j++)
+                rkp[4*i+j] = rk[i];
+        }
+        ogs_aes_encrypt_blocks(rkp, OGS_AES_NROUNDS(128),
+                in[0], out[0], 4 * n);
+
+        for (i = 0; i < n; i++) {
+            v = &batch[i];
+
+            for (j = 0; j < 16; j++) {
+                out[4*i][j] ^= v->opc[j];
+                out[4*i+1][j] ^= v->opc[j];
+                v->ck[j] = out[4*i+2][j] ^ v->opc[j];
+                v->ik[j] = out[4*i+3][j] ^ v->opc[j];
+            }
+            memcpy(v->res, out[4*i+1] + 8, 8);      /* f2 */
+            memcpy(v->ak, out[4*i+1], 6);           /* f5 */
+            v->res_len = 8;
+
+            /* AUTN = (SQN ^ AK) || AMF || MAC */
+            for (j = 0; j < 6; j++)
+                v->autn[j] = v->sqn[j] ^ v->ak[j];
+            memcpy(v->autn + 6, v->amf, 2);
+            memcpy(v->autn + 8, out[4*i], 8);       /* f1 */
+        }
+
+        batch += n;
+        num -= n;
+    }
+}
+
 /**
  * milenage_auts - Milenage AUTS validation
  * @opc: OPc = 128-bit operator variant algorithm configuration field (encr.)
@@ -259,13 +379,15 @@ int milenage_auts(const uint8_t *opc, const uint8_t *k,
 {
 	uint8_t amf[2] = { 0x00, 0x00 }; /* TS 33.102 v7.0.0, 6.3.3 */
 	uint8_t ak[6], mac_s[8];
+	uint32_t rk[MILENAGE_RKLENGTH];
 	int i;
 
-	if (milenage_f2345(opc, k, _rand, NULL, NULL, NULL, NULL, ak))
+	aes_128_setup(rk, k);
+	if (milenage_f2345_rk(opc, rk, _rand, NULL, NULL, NULL, NULL, ak))
 		return -1;
 	for (i = 0; i < 6; i++)
 		sqn[i] = auts[i] ^ ak[i];
-	if (milenage_f1(opc, k, _rand, sqn, amf, NULL, mac_s) ||
+	if (milenage_f1_rk(opc, rk, _rand, sqn, amf, NULL, mac_s) ||
 	    os_memcmp_const(mac_s, auts + 6, 8) != 0)
 		return -1;
 	return 0;
@@ -387,8 +509,10 @@ int milenage_check(const uint8_t *opc, const uint8_t *k,
 void milenage_opc(const uint8_t *k, const uint8_t *op,  uint8_t *opc)
 {
     int i;
+    uint32_t rk[MILENAGE_RKLENGTH];
 
-    aes_128_encrypt_block(k,  op, opc);
+    aes_128_setup(rk, k);
+    aes_128_encrypt_block(rk, op, opc);
 
     for (i = 0; i < 16; i++)
     {
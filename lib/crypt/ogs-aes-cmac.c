@@ -58,7 +58,7 @@
     +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
 
 static int _generate_subkey(uint8_t *k1, uint8_t *k2,
-        const uint8_t *key)
+        const uint32_t *rk, int nrounds)
 {
     uint8_t zero[16] = {
         0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
@@ -69,12 +69,9 @@ static int _generate_subkey(uint8_t *k1, uint8_t *k2,
         0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x87
     };
     uint8_t L[16];
-
-    uint32_t rk[OGS_AES_RKLENGTH(OGS_AES_MAX_KEY_BITS)];
-    int i, nrounds;
+    int i;
 
     /* Step 1.  L := AES-128(K, const_Zero) */
-    nrounds = ogs_aes_setup_enc(rk, key, 128);
     ogs_aes_encrypt(rk, nrounds, zero, L);
 
     /* Step 2.  if MSB(L) is equal to 0 */
@@ -161,25 +158,53 @@ static int _generate_subkey(uint8_t *k1, uint8_t *k2,
     +   Step 7.  return T;                                              +
     +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
 
+void ogs_aes_cmac_key_init(ogs_aes_cmac_key_t *cmac_key, const uint8_t *key)
+{
+    ogs_assert(cmac_key);
+    ogs_assert(key);
+
+    /* The key schedule is shared with Generate_Subkey */
+    cmac_key->nrounds = ogs_aes_setup_enc(cmac_key->rk, key, 128);
+
+    /* Step 1.  (K1,K2) := Generate_Subkey(K); */
+    _generate_subkey(cmac_key->k1, cmac_key->k2,
+            cmac_key->rk, cmac_key->nrounds);
+}
+
 int ogs_aes_cmac_calculate(uint8_t *cmac, const uint8_t *key,
         const uint8_t *msg, const uint32_t len)
+{
+    ogs_aes_cmac_key_t cmac_key;
+
+    ogs_assert(key);
+
+    ogs_aes_cmac_key_init(&cmac_key, key);
+
+    return ogs_aes_cmac_calculate_from_key(cmac, &cmac_key, msg, len);
+}
+
+int ogs_aes_cmac_calculate_from_key(uint8_t *cmac,
+        const ogs_aes_cmac_key_t *cmac_key,
+        const uint8_t *msg, const uint32_t len)
 {
     uint8_t x[16] = {
         0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
         0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
     };
     uint8_t y[16], m_last[16];
-    uint8_t k1[16], k2[16];
+    const uint8_t *k1, *k2;
+    const uint32_t *rk;
     int i, j, n, bs, flag;
-    uint32_t rk[OGS_AES_RKLENGTH(OGS_AES_MAX_KEY_BITS)];
     int nrounds;
 
     ogs_assert(cmac);
-    ogs_assert(key);
+    ogs_assert(cmac_key);
     ogs_assert(msg);
 
-    /* Step 1.  (K1,K2) := Generate_Subkey(K); */
-    _generate_subkey(k1, k2, key);
+    rk = cmac_key->rk;
+    nrounds = cmac_key->nrounds;
+    k1 = cmac_key->k1;
+    k2 = cmac_key->k2;
 
     /* Step 2.  n := ceil(len/const_Bsize); */
     n = (len + 15) / OGS_AES_BLOCK_SIZE;
@@ -239,8 +264,6 @@ int ogs_aes_cmac_calculate(uint8_t *cmac, const uint8_t *key,
                 T := AES-128(K,Y);
      */
 
-    nrounds = ogs_aes_setup_enc(rk, key, 128);
-
     for (i = 0; i <= n - 2; i++)
     {
         bs = i * OGS_AES_BLOCK_SIZE;
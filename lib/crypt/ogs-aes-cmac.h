@@ -50,6 +50,22 @@ extern "C" {
 int ogs_aes_cmac_calculate(uint8_t *cmac, const uint8_t *key,
         const uint8_t *msg, const uint32_t len);
 
+/*
+ * AES key schedule and RFC 4493 subkeys K1/K2 of a CMAC key, for callers
+ * that authenticate many messages with the same key.
+ */
+typedef struct ogs_aes_cmac_key_s {
+    uint32_t rk[OGS_AES_RKLENGTH(128)];
+    int nrounds;
+    uint8_t k1[OGS_AES_BLOCK_SIZE];
+    uint8_t k2[OGS_AES_BLOCK_SIZE];
+} ogs_aes_cmac_key_t;
+
+void ogs_aes_cmac_key_init(ogs_aes_cmac_key_t *cmac_key, const uint8_t *key);
+int ogs_aes_cmac_calculate_from_key(uint8_t *cmac,
+        const ogs_aes_cmac_key_t *cmac_key,
+        const uint8_t *msg, const uint32_t len);
+
 /**
  * Verify CMAC value
  *
@@ -27,8 +27,39 @@
 
 #include "ogs-crypt.h"
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+#define USE_AESNI 1
+#if (defined(__clang__) && __clang_major__ >= 7) || \
+    (!defined(__clang__) && __GNUC__ >= 8)
+#define USE_VAES 1
+#endif
+#endif
+
 #define FULL_UNROLL
 
+static void aes_table_encrypt(const uint32_t *rk, int nrounds,
+        const uint8_t plaintext[16], uint8_t ciphertext[16]);
+static void aes_table_decrypt(const uint32_t *rk, int nrounds,
+        const uint8_t ciphertext[16], uint8_t plaintext[16]);
+
+#if USE_AESNI
+static void aesni_encrypt(const uint32_t *rk, int nrounds,
+        const uint8_t plaintext[16], uint8_t ciphertext[16]);
+static void aesni_decrypt(const uint32_t *rk, int nrounds,
+        const uint8_t ciphertext[16], uint8_t plaintext[16]);
+static uint32_t aesni_ctr128_encrypt(const uint32_t *rk, int nrounds,
+        uint8_t *ivec, const uint8_t *in, uint32_t nblocks, uint8_t *out);
+static void aesni_encrypt_blocks(const uint32_t *const *rk, int nrounds,
+        const uint8_t *in, uint8_t *out, int nblocks);
+#endif
+#if USE_VAES
+static uint32_t vaes_ctr128_encrypt(const uint32_t *rk, int nrounds,
+        uint8_t *ivec, const uint8_t *in, uint32_t nblocks, uint8_t *out);
+#endif
+
+static int aes_backend = -1;
+
 static const uint32_t Te0[256] =
 {
   0xc66363a5U, 0xf87c7c84U, 0xee777799U, 0xf67b7b8dU,
@@ -864,8 +895,8 @@ int ogs_aes_setup_dec(uint32_t *rk, const uint8_t *key, int keybits)
   return nrounds;
 }
 
-void ogs_aes_encrypt(const uint32_t *rk, int nrounds, const uint8_t plaintext[16],
-  uint8_t ciphertext[16])
+static void aes_table_encrypt(const uint32_t *rk, int nrounds,
+  const uint8_t plaintext[16], uint8_t ciphertext[16])
 {
   uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
   #ifndef FULL_UNROLL
@@ -1046,8 +1077,8 @@ void ogs_aes_encrypt(const uint32_t *rk, int nrounds, const uint8_t plaintext[16
   PUTU32(ciphertext + 12, s3);
 }
 
-void ogs_aes_decrypt(const uint32_t *rk, int nrounds, const uint8_t ciphertext[16],
-  uint8_t plaintext[16])
+static void aes_table_decrypt(const uint32_t *rk, int nrounds,
+  const uint8_t ciphertext[16], uint8_t plaintext[16])
 {
   uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
   #ifndef FULL_UNROLL
@@ -1229,6 +1260,91 @@ void ogs_aes_decrypt(const uint32_t *rk, int nrounds, const uint8_t ciphertext[1
   PUTU32(plaintext + 12, s3);
 }
 
+static bool aes_backend_supported(ogs_aes_backend_e backend)
+{
+    switch (backend) {
+    case OGS_AES_BACKEND_TABLE:
+        return true;
+#if USE_AESNI
+    case OGS_AES_BACKEND_AESNI:
+        return __builtin_cpu_supports("aes") &&
+            __builtin_cpu_supports("ssse3");
+#endif
+#if USE_VAES
+    case OGS_AES_BACKEND_VAES:
+        return __builtin_cpu_supports("aes") &&
+            __builtin_cpu_supports("vaes") &&
+            __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+ogs_aes_backend_e ogs_aes_backend(void)
+{
+    if (aes_backend < 0) {
+        if (aes_backend_supported(OGS_AES_BACKEND_VAES))
+            aes_backend = OGS_AES_BACKEND_VAES;
+        else if (aes_backend_supported(OGS_AES_BACKEND_AESNI))
+            aes_backend = OGS_AES_BACKEND_AESNI;
+        else
+            aes_backend = OGS_AES_BACKEND_TABLE;
+    }
+
+    return aes_backend;
+}
+
+int ogs_aes_set_backend(ogs_aes_backend_e backend)
+{
+    if (aes_backend_supported(backend) == false)
+        return OGS_ERROR;
+
+    aes_backend = backend;
+
+    return OGS_OK;
+}
+
+void ogs_aes_encrypt(const uint32_t *rk, int nrounds,
+        const uint8_t plaintext[16], uint8_t ciphertext[16])
+{
+#if USE_AESNI
+    if (ogs_aes_backend() != OGS_AES_BACKEND_TABLE) {
+        aesni_encrypt(rk, nrounds, plaintext, ciphertext);
+        return;
+    }
+#endif
+    aes_table_encrypt(rk, nrounds, plaintext, ciphertext);
+}
+
+void ogs_aes_decrypt(const uint32_t *rk, int nrounds,
+        const uint8_t ciphertext[16], uint8_t plaintext[16])
+{
+#if USE_AESNI
+    if (ogs_aes_backend() != OGS_AES_BACKEND_TABLE) {
+        aesni_decrypt(rk, nrounds, ciphertext, plaintext);
+        return;
+    }
+#endif
+    aes_table_decrypt(rk, nrounds, ciphertext, plaintext);
+}
+
+void ogs_aes_encrypt_blocks(const uint32_t *const *rk, int nrounds,
+        const uint8_t *in, uint8_t *out, int nblocks)
+{
+    int i;
+
+#if USE_AESNI
+    if (ogs_aes_backend() != OGS_AES_BACKEND_TABLE) {
+        aesni_encrypt_blocks(rk, nrounds, in, out, nblocks);
+        return;
+    }
+#endif
+    for (i = 0; i < nblocks; i++)
+        aes_table_encrypt(rk[i], nrounds,
+                in + i * OGS_AES_BLOCK_SIZE, out + i * OGS_AES_BLOCK_SIZE);
+}
+
 int ogs_aes_cbc_encrypt(const uint8_t *key, const uint32_t keybits,
         uint8_t *ivec, const uint8_t *in, const uint32_t inlen,
         uint8_t *out, uint32_t *outlen)
@@ -1408,23 +1524,33 @@ int ogs_aes_ctr128_encrypt(const uint8_t *key,
         uint8_t *ivec, const uint8_t *in, const uint32_t inlen,
         uint8_t *out)
 {
-    uint8_t ecount_buf[16];
-    uint32_t len = inlen;
-
     uint32_t rk[OGS_AES_RKLENGTH(OGS_AES_MAX_KEY_BITS)];
     int nrounds;
 
+    ogs_assert(key);
+
+    nrounds = ogs_aes_setup_enc(rk, key, 128);
+
+    return ogs_aes_ctr128_encrypt_rk(rk, nrounds, ivec, in, inlen, out);
+}
+
+int ogs_aes_ctr128_encrypt_rk(const uint32_t *rk, int nrounds,
+        uint8_t *ivec, const uint8_t *in, const uint32_t inlen,
+        uint8_t *out)
+{
+    uint8_t ecount_buf[16];
+    uint32_t len = inlen;
+
     uint32_t n = 0;
     size_t l = 0;
 
-    ogs_assert(key);
+    ogs_assert(rk);
     ogs_assert(ivec);
     ogs_assert(in);
     ogs_assert(len);
     ogs_assert(out);
 
     memset(ecount_buf, 0, 16);
-    nrounds = ogs_aes_setup_enc(rk, key, 128);
 
     while (n && len) 
     {
@@ -1433,6 +1559,24 @@ int ogs_aes_ctr128_encrypt(const uint8_t *key,
         n = (n + 1) % 16;
     }
 
+#if USE_VAES
+    if (len >= 16 && ogs_aes_backend() == OGS_AES_BACKEND_VAES) {
+        l = vaes_ctr128_encrypt(rk, nrounds, ivec, in, len / 16, out) * 16;
+        len -= l;
+        out += l;
+        in += l;
+    }
+#endif
+#if USE_AESNI
+    if (len >= 16 && ogs_aes_backend() != OGS_AES_BACKEND_TABLE) {
+        l = aesni_ctr128_encrypt(rk, nrounds, ivec, in, len / 16, out) * 16;
+        len -= l;
+        out += l;
+        in += l;
+    }
+    l = 0;
+#endif
+
     while (len >= 16) 
     {
         ogs_aes_encrypt(rk, nrounds, ivec, ecount_buf);
@@ -1473,3 +1617,240 @@ int ogs_aes_ctr128_encrypt(const uint8_t *key,
     return OGS_OK;
 }
 
+
+#if USE_AESNI
+
+/*
+ * AES-NI uses the same key schedule as the T-table code, only with each
+ * round key in byte order. ogs_aes_setup_dec() already produces
+ * the equivalent inverse cipher schedule that AESDEC expects.
+ */
+#define AESNI_TARGET __attribute__((target("aes,ssse3")))
+
+#define AESNI_BSWAP32 \
+    _mm_set_epi8(12,13,14,15, 8,9,10,11, 4,5,6,7, 0,1,2,3)
+#define AESNI_BSWAP64 \
+    _mm_set_epi8(8,9,10,11,12,13,14,15, 0,1,2,3,4,5,6,7)
+
+#define AESNI_ROUND_KEY(__rK, __i, __bSWAP) \
+    _mm_shuffle_epi8( \
+        _mm_loadu_si128((const __m128i *)((__rK) + 4 * (__i))), __bSWAP)
+
+AESNI_TARGET
+static void aesni_encrypt(const uint32_t *rk, int nrounds,
+        const uint8_t plaintext[16], uint8_t ciphertext[16])
+{
+    const __m128i bswap = AESNI_BSWAP32;
+    __m128i m;
+    int i;
+
+    m = _mm_loadu_si128((const __m128i *)plaintext);
+    m = _mm_xor_si128(m, AESNI_ROUND_KEY(rk, 0, bswap));
+    for (i = 1; i < nrounds; i++)
+        m = _mm_aesenc_si128(m, AESNI_ROUND_KEY(rk, i, bswap));
+    m = _mm_aesenclast_si128(m, AESNI_ROUND_KEY(rk, nrounds, bswap));
+    _mm_storeu_si128((__m128i *)ciphertext, m);
+}
+
+AESNI_TARGET
+static void aesni_decrypt(const uint32_t *rk, int nrounds,
+        const uint8_t ciphertext[16], uint8_t plaintext[16])
+{
+    const __m128i bswap = AESNI_BSWAP32;
+    __m128i m;
+    int i;
+
+    m = _mm_loadu_si128((const __m128i *)ciphertext);
+    m = _mm_xor_si128(m, AESNI_ROUND_KEY(rk, 0, bswap));
+    for (i = 1; i < nrounds; i++)
+        m = _mm_aesdec_si128(m, AESNI_ROUND_KEY(rk, i, bswap));
+    m = _mm_aesdeclast_si128(m, AESNI_ROUND_KEY(rk, nrounds, bswap));
+    _mm_storeu_si128((__m128i *)plaintext, m);
+}
+
+#define AESNI_PARALLEL_BLOCKS 8
+
+/* Independent blocks, each with its own key, interleaved per round */
+AESNI_TARGET
+static void aesni_encrypt_blocks(const uint32_t *const *rk, int nrounds,
+        const uint8_t *in, uint8_t *out, int nblocks)
+{
+    const __m128i bswap = AESNI_BSWAP32;
+    __m128i m[AESNI_PARALLEL_BLOCKS];
+    int i, j, n;
+
+    while (nblocks > 0) {
+        n = ogs_min(nblocks, AESNI_PARALLEL_BLOCKS);
+
+        for (j = 0; j < n; j++)
+            m[j] = _mm_xor_si128(
+                    _mm_loadu_si128((const __m128i *)(in + 16 * j)),
+                    AESNI_ROUND_KEY(rk[j], 0, bswap));
+        for (i = 1; i < nrounds; i++)
+            for (j = 0; j < n; j++)
+                m[j] = _mm_aesenc_si128(m[j],
+                        AESNI_ROUND_KEY(rk[j], i, bswap));
+        for (j = 0; j < n; j++)
+            _mm_storeu_si128((__m128i *)(out + 16 * j),
+                    _mm_aesenclast_si128(m[j],
+                        AESNI_ROUND_KEY(rk[j], nrounds, bswap)));
+
+        rk += n;
+        in += 16 * n;
+        out += 16 * n;
+        nblocks -= n;
+    }
+}
+
+/* The 128-bit big-endian counter is kept as two host-order halves */
+static void ctr128_load(const uint8_t *ivec, uint64_t *hi, uint64_t *lo)
+{
+    int i;
+
+    *hi = *lo = 0;
+    for (i = 0; i < 8; i++) {
+        *hi = (*hi << 8) | ivec[i];
+        *lo = (*lo << 8) | ivec[i + 8];
+    }
+}
+
+static void ctr128_store(uint8_t *ivec, uint64_t hi, uint64_t lo)
+{
+    int i;
+
+    for (i = 7; i >= 0; i--) {
+        ivec[i] = (uint8_t)hi;
+        ivec[i + 8] = (uint8_t)lo;
+        hi >>= 8;
+        lo >>= 8;
+    }
+}
+
+#define CTR128_NEXT(__hI, __lO) \
+    do { \
+        if (++(__lO) == 0) (__hI)++; \
+    } while (0)
+
+#define AESNI_CTR_BLOCKS 4
+
+/*
+ * Encrypts AESNI_CTR_BLOCKS counter blocks per iteration
+ * so that the AESENC latency of independent blocks overlaps.
+ *
+ * @return the number of blocks processed, always nblocks.
+ */
+AESNI_TARGET
+static uint32_t aesni_ctr128_encrypt(const uint32_t *rk, int nrounds,
+        uint8_t *ivec, const uint8_t *in, uint32_t nblocks, uint8_t *out)
+{
+    const __m128i bswap32 = AESNI_BSWAP32;
+    const __m128i bswap64 = AESNI_BSWAP64;
+    __m128i key[OGS_AES_NROUNDS(OGS_AES_MAX_KEY_BITS) + 1];
+    __m128i m[AESNI_CTR_BLOCKS];
+    uint64_t hi, lo;
+    uint32_t done = 0;
+    int i, j, n;
+
+    for (i = 0; i <= nrounds; i++)
+        key[i] = AESNI_ROUND_KEY(rk, i, bswap32);
+
+    ctr128_load(ivec, &hi, &lo);
+
+    while (done < nblocks) {
+        n = ogs_min(nblocks - done, AESNI_CTR_BLOCKS);
+
+        for (j = 0; j < n; j++) {
+            m[j] = _mm_shuffle_epi8(
+                    _mm_set_epi64x((long long)lo, (long long)hi), bswap64);
+            m[j] = _mm_xor_si128(m[j], key[0]);
+            CTR128_NEXT(hi, lo);
+        }
+        for (i = 1; i < nrounds; i++)
+            for (j = 0; j < n; j++)
+                m[j] = _mm_aesenc_si128(m[j], key[i]);
+        for (j = 0; j < n; j++) {
+            m[j] = _mm_aesenclast_si128(m[j], key[nrounds]);
+            m[j] = _mm_xor_si128(m[j],
+                    _mm_loadu_si128((const __m128i *)in));
+            _mm_storeu_si128((__m128i *)out, m[j]);
+            in += 16;
+            out += 16;
+        }
+
+        done += n;
+    }
+
+    ctr128_store(ivec, hi, lo);
+
+    return done;
+}
+
+#endif /* USE_AESNI */
+
+#if USE_VAES
+
+#define VAES_TARGET __attribute__((target("aes,vaes,avx2")))
+
+#define VAES_CTR_LANES 4        /* 4 x 256-bit = 8 blocks per iteration */
+
+/*
+ * VAES runs two blocks per 256-bit register. Only whole groups of
+ * 2 * VAES_CTR_LANES blocks are handled here, the remainder goes
+ * through aesni_ctr128_encrypt().
+ *
+ * @return the number of blocks processed.
+ */
+VAES_TARGET
+static uint32_t vaes_ctr128_encrypt(const uint32_t *rk, int nrounds,
+        uint8_t *ivec, const uint8_t *in, uint32_t nblocks, uint8_t *out)
+{
+    const __m128i bswap32 = AESNI_BSWAP32;
+    const __m256i bswap64 = _mm256_broadcastsi128_si256(AESNI_BSWAP64);
+    __m256i key[OGS_AES_NROUNDS(OGS_AES_MAX_KEY_BITS) + 1];
+    __m256i m[VAES_CTR_LANES];
+    uint64_t hi, lo, hi2, lo2;
+    uint32_t done = 0;
+    int i, j;
+
+    nblocks -= nblocks % (2 * VAES_CTR_LANES);
+    if (!nblocks)
+        return 0;
+
+    for (i = 0; i <= nrounds; i++)
+        key[i] = _mm256_broadcastsi128_si256(
+                AESNI_ROUND_KEY(rk, i, bswap32));
+
+    ctr128_load(ivec, &hi, &lo);
+
+    while (done < nblocks) {
+        for (j = 0; j < VAES_CTR_LANES; j++) {
+            hi2 = hi; lo2 = lo;
+            CTR128_NEXT(hi2, lo2);
+            m[j] = _mm256_shuffle_epi8(_mm256_set_epi64x(
+                        (long long)lo2, (long long)hi2,
+                        (long long)lo, (long long)hi), bswap64);
+            m[j] = _mm256_xor_si256(m[j], key[0]);
+            hi = hi2; lo = lo2;
+            CTR128_NEXT(hi, lo);
+        }
+        for (i = 1; i < nrounds; i++)
+            for (j = 0; j < VAES_CTR_LANES; j++)
+                m[j] = _mm256_aesenc_epi128(m[j], key[i]);
+        for (j = 0; j < VAES_CTR_LANES; j++) {
+            m[j] = _mm256_aesenclast_epi128(m[j], key[nrounds]);
+            m[j] = _mm256_xor_si256(m[j],
+                    _mm256_loadu_si256((const __m256i *)in));
+            _mm256_storeu_si256((__m256i *)out, m[j]);
+            in += 32;
+            out += 32;
+        }
+
+        done += 2 * VAES_CTR_LANES;
+    }
+
+    ctr128_store(ivec, hi, lo);
+
+    return done;
+}
+
+#endif /* USE_VAES */
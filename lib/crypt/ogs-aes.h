@@ -43,6 +43,16 @@ extern "C" {
 #define OGS_AES_RKLENGTH(keybits)  ((keybits)/8+28)
 #define OGS_AES_NROUNDS(keybits)   ((keybits)/32+6)
 
+typedef enum {
+    OGS_AES_BACKEND_TABLE = 0,      /* Portable T-table */
+    OGS_AES_BACKEND_AESNI,          /* x86 AES-NI */
+    OGS_AES_BACKEND_VAES,           /* AES-NI, VAES for CTR bulk data */
+} ogs_aes_backend_e;
+
+/* Selected from the CPU features on first use */
+ogs_aes_backend_e ogs_aes_backend(void);
+int ogs_aes_set_backend(ogs_aes_backend_e backend);
+
 int ogs_aes_setup_enc(uint32_t *rk, const uint8_t *key, int keybits);
 int ogs_aes_setup_dec(uint32_t *rk, const uint8_t *key, int keybits);
 
@@ -51,6 +61,10 @@ void ogs_aes_encrypt(const uint32_t *rk, int nrounds,
 void ogs_aes_decrypt(const uint32_t *rk, int nrounds,
         const uint8_t ciphertext[16], uint8_t plaintext[16]);
 
+/* Encrypts nblocks independent blocks, block i with key schedule rk[i] */
+void ogs_aes_encrypt_blocks(const uint32_t *const *rk, int nrounds,
+        const uint8_t *in, uint8_t *out, int nblocks);
+
 int ogs_aes_cbc_encrypt(const uint8_t *key,
         const uint32_t keybits, uint8_t *ivec,
         const uint8_t *in, const uint32_t inlen,
@@ -63,6 +77,10 @@ int ogs_aes_cbc_decrypt(const uint8_t *key,
 int ogs_aes_ctr128_encrypt(const uint8_t *key,
         uint8_t *ivec, const uint8_t *in, const uint32_t inlen,
         uint8_t *out);
+/* Same as above with the key schedule from ogs_aes_setup_enc() */
+int ogs_aes_ctr128_encrypt_rk(const uint32_t *rk, int nrounds,
+        uint8_t *ivec, const uint8_t *in, const uint32_t inlen,
+        uint8_t *out);
 
 #ifdef __cplusplus
 }
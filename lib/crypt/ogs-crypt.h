@@ -36,6 +36,7 @@
 #include "crypt/zuc.h"
 #include "crypt/kasumi.h"
 #include "crypt/ecc.h"
+#include "crypt/ogs-ecdh.h"
 
 #include "crypt/ogs-kdf.h"
 #include "crypt/ogs-base64.h"
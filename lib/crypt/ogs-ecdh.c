@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "ogs-crypt.h"
+
+#if OGS_ECDH_WITH_OPENSSL
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/obj_mac.h>
+
+static int ecdh_backend = OGS_ECDH_BACKEND_OPENSSL;
+#else
+static int ecdh_backend = OGS_ECDH_BACKEND_BUILTIN;
+#endif
+
+ogs_ecdh_backend_e ogs_ecdh_backend(void)
+{
+    return ecdh_backend;
+}
+
+int ogs_ecdh_set_backend(ogs_ecdh_backend_e backend)
+{
+    switch (backend) {
+    case OGS_ECDH_BACKEND_BUILTIN:
+        break;
+#if OGS_ECDH_WITH_OPENSSL
+    case OGS_ECDH_BACKEND_OPENSSL:
+        break;
+#endif
+    default:
+        return OGS_ERROR;
+    }
+
+    ecdh_backend = backend;
+
+    return OGS_OK;
+}
+
+#if OGS_ECDH_WITH_OPENSSL
+static int openssl_x25519(uint8_t *shared,
+        const uint8_t *private_key, const uint8_t *public_key)
+{
+    int rv = OGS_ERROR;
+    size_t len = OGS_ECCKEY_LEN;
+
+    EVP_PKEY *pkey = NULL, *peer = NULL;
+    EVP_PKEY_CTX *ctx = NULL;
+
+    pkey = EVP_PKEY_new_raw_private_key(
+            EVP_PKEY_X25519, NULL, private_key, OGS_ECCKEY_LEN);
+    peer = EVP_PKEY_new_raw_public_key(
+            EVP_PKEY_X25519, NULL, public_key, OGS_ECCKEY_LEN);
+    if (!pkey || !peer) {
+        ogs_error("EVP_PKEY_new_raw_*_key() failed");
+        goto cleanup;
+    }
+
+    ctx = EVP_PKEY_CTX_new(pkey, NULL);
+    if (!ctx) {
+        ogs_error("EVP_PKEY_CTX_new() failed");
+        goto cleanup;
+    }
+
+    /* Fails on a small-order public key (all-zero shared secret) */
+    if (EVP_PKEY_derive_init(ctx) != 1 ||
+        EVP_PKEY_derive_set_peer(ctx, peer) != 1 ||
+        EVP_PKEY_derive(ctx, shared, &len) != 1 ||
+        len != OGS_ECCKEY_LEN) {
+        ogs_error("EVP_PKEY_derive() failed");
+        goto cleanup;
+    }
+
+    rv = OGS_OK;
+
+cleanup:
+    EVP_PKEY_CTX_free(ctx);
+    EVP_PKEY_free(peer);
+    EVP_PKEY_free(pkey);
+
+    return rv;
+}
+
+static int openssl_p256(uint8_t *shared,
+        const uint8_t *private_key, const uint8_t *public_key)
+{
+    int rv = OGS_ERROR;
+
+    BN_CTX *ctx = NULL;
+    EC_GROUP *group = NULL;
+    EC_POINT *peer = NULL, *point = NULL;
+    BIGNUM *scalar = NULL, *x = NULL;
+
+    ctx = BN_CTX_new();
+    group = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+    scalar = BN_bin2bn(private_key, OGS_ECCKEY_LEN, NULL);
+    x = BN_new();
+    if (!ctx || !group || !scalar || !x) {
+        ogs_error("OpenSSL allocation failed");
+        goto cleanup;
+    }
+    BN_set_flags(scalar, BN_FLG_CONSTTIME);
+
+    peer = EC_POINT_new(group);
+    point = EC_POINT_new(group);
+    if (!peer || !point) {
+        ogs_error("EC_POINT_new() failed");
+        goto cleanup;
+    }
+
+    /* Decompresses and checks that the point is on the curve */
+    if (EC_POINT_oct2point(group, peer,
+                public_key, OGS_ECCKEY_LEN+1, ctx) != 1) {
+        ogs_error("Invalid public key");
+        goto cleanup;
+    }
+
+    if (EC_POINT_mul(group, point, NULL, peer, scalar, ctx) != 1 ||
+        EC_POINT_get_affine_coordinates(group, point, x, NULL, ctx) != 1 ||
+        BN_bn2binpad(x, shared, OGS_ECCKEY_LEN) != OGS_ECCKEY_LEN) {
+        ogs_error("EC_POINT_mul() failed");
+        goto cleanup;
+    }
+
+    rv = OGS_OK;
+
+cleanup:
+    EC_POINT_clear_free(point);
+    EC_POINT_free(peer);
+    BN_free(x);
+    BN_clear_free(scalar);
+    EC_GROUP_free(group);
+    BN_CTX_free(ctx);
+
+    return rv;
+}
+#endif
+
+/* Constant time, not to leak the shared secret */
+static int shared_is_zero(const uint8_t *buf, int len)
+{
+    uint8_t acc = 0;
+    int i;
+
+    for (i = 0; i < len; i++)
+        acc |= buf[i];
+
+    return acc == 0;
+}
+
+int ogs_ecdh_x25519(uint8_t *shared,
+        const uint8_t *private_key, const uint8_t *public_key)
+{
+    ogs_assert(shared);
+    ogs_assert(private_key);
+    ogs_assert(public_key);
+
+#if OGS_ECDH_WITH_OPENSSL
+    if (ecdh_backend == OGS_ECDH_BACKEND_OPENSSL)
+        return openssl_x25519(shared, private_key, public_key);
+#endif
+
+    curve25519_donna(shared, private_key, public_key);
+
+    /*
+     * RFC7748 6.1 : A small-order public key gives the all-zero shared
+     * secret, which the OpenSSL backend refuses as well
+     */
+    if (shared_is_zero(shared, OGS_ECCKEY_LEN)) {
+        ogs_error("Small-order X25519 public key");
+        return OGS_ERROR;
+    }
+
+    return OGS_OK;
+}
+
+int ogs_ecdh_p256(uint8_t *shared,
+        const uint8_t *private_key, const uint8_t *public_key)
+{
+    ogs_assert(shared);
+    ogs_assert(private_key);
+    ogs_assert(public_key);
+
+#if OGS_ECDH_WITH_OPENSSL
+    if (ecdh_backend == OGS_ECDH_BACKEND_OPENSSL)
+        return openssl_p256(shared, private_key, public_key);
+#endif
+
+    if (ecdh_shared_secret(public_key, private_key, shared) != 1) {
+        ogs_error("ecdh_shared_secret() failed");
+        return OGS_ERROR;
+    }
+
+    return OGS_OK;
+}
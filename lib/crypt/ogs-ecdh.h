@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined(OGS_CRYPT_INSIDE) && !defined(OGS_CRYPT_COMPILATION)
+#error "This header cannot be included directly."
+#endif
+
+#ifndef OGS_ECDH_H
+#define OGS_ECDH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Key agreement for the SUCI protection schemes (TS33.501 C.3).
+ * The shared secret is always OGS_ECCKEY_LEN bytes.
+ *
+ * Profile A : X25519, 32 byte public key
+ * Profile B : secp256r1, 33 byte compressed public key
+ */
+typedef enum {
+    OGS_ECDH_BACKEND_BUILTIN = 0,   /* curve25519-donna, easy-ecc */
+    OGS_ECDH_BACKEND_OPENSSL,       /* libcrypto */
+} ogs_ecdh_backend_e;
+
+/* OPENSSL if built with `-Decdh=openssl`, otherwise BUILTIN */
+ogs_ecdh_backend_e ogs_ecdh_backend(void);
+int ogs_ecdh_set_backend(ogs_ecdh_backend_e backend);
+
+int ogs_ecdh_x25519(uint8_t *shared,
+        const uint8_t *private_key, const uint8_t *public_key);
+int ogs_ecdh_p256(uint8_t *shared,
+        const uint8_t *private_key, const uint8_t *public_key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OGS_ECDH_H */
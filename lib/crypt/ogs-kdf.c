@@ -40,46 +40,67 @@ typedef struct kdf_param_s {
     uint16_t len;
 } kdf_param_t[MAX_NUM_OF_KDF_PARAM];
 
-/* KDF function : TS.33220 cluase B.2.0 */
-static void ogs_kdf_common(uint8_t *key, uint32_t key_size,
-        uint8_t fc, kdf_param_t param, uint8_t *output)
+void ogs_kdf_key_init(ogs_kdf_key_t *kdf_key,
+        const uint8_t *key, uint32_t key_size)
 {
-    int i = 0, pos;
-    uint8_t *s = NULL;
+    ogs_hmac_sha256_ctx ctx;
 
+    ogs_assert(kdf_key);
     ogs_assert(key);
     ogs_assert(key_size);
+
+    ogs_hmac_sha256_init(&ctx, key, key_size);
+
+    memcpy(kdf_key->inner, ctx.ctx_inside.h, sizeof(kdf_key->inner));
+    memcpy(kdf_key->outer, ctx.ctx_outside.h, sizeof(kdf_key->outer));
+}
+
+/* SHA-256 state right after the one-block ipad or opad */
+static void kdf_sha256_resume(ogs_sha256_ctx *ctx, const uint32_t *h)
+{
+    memcpy(ctx->h, h, sizeof(ctx->h));
+    ctx->tot_len = OGS_SHA256_BLOCK_SIZE;
+    ctx->len = 0;
+}
+
+/* KDF function : TS.33220 cluase B.2.0 */
+static void ogs_kdf_derive(const ogs_kdf_key_t *kdf_key,
+        uint8_t fc, kdf_param_t param, uint8_t *output)
+{
+    ogs_sha256_ctx ctx;
+    uint8_t digest[OGS_SHA256_DIGEST_SIZE];
+    int i;
+
+    ogs_assert(kdf_key);
     ogs_assert(fc);
     ogs_assert(param[0].buf);
     ogs_assert(param[0].len);
     ogs_assert(output);
 
-    pos = 1; /* FC Value */
-
-    /* Calculate buffer length */
-    for (i = 0; i < MAX_NUM_OF_KDF_PARAM && param[i].buf && param[i].len; i++) {
-        pos += (param[i].len + 2);
-    }
-
-    s = ogs_calloc(1, pos);
-    ogs_assert(s);
-
-    /* Copy buffer from param */
-    pos = 0;
-    s[pos++] = fc;
+    /* S = FC || P0 || L0 || P1 || L1 || ..., hashed as it is built */
+    kdf_sha256_resume(&ctx, kdf_key->inner);
+    ogs_sha256_update(&ctx, &fc, 1);
     for (i = 0; i < MAX_NUM_OF_KDF_PARAM && param[i].buf && param[i].len; i++) {
         uint16_t len;
 
-        memcpy(&s[pos], param[i].buf, param[i].len);
-        pos += param[i].len;
+        ogs_sha256_update(&ctx, param[i].buf, param[i].len);
         len = htobe16(param[i].len);
-        memcpy(&s[pos], &len, sizeof(len));
-        pos += 2;
+        ogs_sha256_update(&ctx, (uint8_t *)&len, sizeof(len));
     }
+    ogs_sha256_final(&ctx, digest);
+
+    kdf_sha256_resume(&ctx, kdf_key->outer);
+    ogs_sha256_update(&ctx, digest, OGS_SHA256_DIGEST_SIZE);
+    ogs_sha256_final(&ctx, output);
+}
 
-    ogs_hmac_sha256(key, key_size, s, pos, output, OGS_SHA256_DIGEST_SIZE);
+static void ogs_kdf_common(uint8_t *key, uint32_t key_size,
+        uint8_t fc, kdf_param_t param, uint8_t *output)
+{
+    ogs_kdf_key_t kdf_key;
 
-    ogs_free(s);
+    ogs_kdf_key_init(&kdf_key, key, key_size);
+    ogs_kdf_derive(&kdf_key, fc, param, output);
 }
 
 /* TS33.501 Annex A.2 : Kausf derviation function */
@@ -208,6 +229,18 @@ void ogs_kdf_kamf(char *supi, uint8_t *abba, uint8_t abba_len,
 /* TS33.501 Annex A.8 : Algorithm key derivation functions */
 void ogs_kdf_nas_5gs(uint8_t algorithm_type_distinguishers,
     uint8_t algorithm_identity, uint8_t *kamf, uint8_t *knas)
+{
+    ogs_kdf_key_t kdf_key;
+
+    ogs_assert(kamf);
+
+    ogs_kdf_key_init(&kdf_key, kamf, OGS_SHA256_DIGEST_SIZE);
+    ogs_kdf_nas_5gs_from_key(algorithm_type_distinguishers,
+            algorithm_identity, &kdf_key, knas);
+}
+
+void ogs_kdf_nas_5gs_from_key(uint8_t algorithm_type_distinguishers,
+    uint8_t algorithm_identity, const ogs_kdf_key_t *kamf, uint8_t *knas)
 {
     kdf_param_t param;
     uint8_t output[OGS_SHA256_DIGEST_SIZE];
@@ -221,14 +254,25 @@ void ogs_kdf_nas_5gs(uint8_t algorithm_type_distinguishers,
     param[1].buf = &algorithm_identity;
     param[1].len = 1;
 
-    ogs_kdf_common(kamf, OGS_SHA256_DIGEST_SIZE,
-            FC_FOR_5GS_ALGORITHM_KEY_DERIVATION, param, output);
+    ogs_kdf_derive(kamf, FC_FOR_5GS_ALGORITHM_KEY_DERIVATION, param, output);
     memcpy(knas, output+16, 16);
 }
 
 /* TS33.501 Annex A.9 KgNB and Kn3iwf derivation function */
 void ogs_kdf_kgnb_and_kn3iwf(uint8_t *kamf, uint32_t ul_count,
         uint8_t access_type_distinguisher, uint8_t *kgnb)
+{
+    ogs_kdf_key_t kdf_key;
+
+    ogs_assert(kamf);
+
+    ogs_kdf_key_init(&kdf_key, kamf, OGS_SHA256_DIGEST_SIZE);
+    ogs_kdf_kgnb_and_kn3iwf_from_key(&kdf_key,
+            ul_count, access_type_distinguisher, kgnb);
+}
+
+void ogs_kdf_kgnb_and_kn3iwf_from_key(const ogs_kdf_key_t *kamf,
+        uint32_t ul_count, uint8_t access_type_distinguisher, uint8_t *kgnb)
 {
     kdf_param_t param;
 
@@ -242,12 +286,22 @@ void ogs_kdf_kgnb_and_kn3iwf(uint8_t *kamf, uint32_t ul_count,
     param[1].buf = &access_type_distinguisher;
     param[1].len = 1;
 
-    ogs_kdf_common(kamf, OGS_SHA256_DIGEST_SIZE,
-            FC_FOR_KGNB_KN3IWF_DERIVATION, param, kgnb);
+    ogs_kdf_derive(kamf, FC_FOR_KGNB_KN3IWF_DERIVATION, param, kgnb);
 }
 
 /* TS33.501 Annex A.10 NH derivation function */
 void ogs_kdf_nh_gnb(uint8_t *kamf, uint8_t *sync_input, uint8_t *kgnb)
+{
+    ogs_kdf_key_t kdf_key;
+
+    ogs_assert(kamf);
+
+    ogs_kdf_key_init(&kdf_key, kamf, OGS_SHA256_DIGEST_SIZE);
+    ogs_kdf_nh_gnb_from_key(&kdf_key, sync_input, kgnb);
+}
+
+void ogs_kdf_nh_gnb_from_key(
+        const ogs_kdf_key_t *kamf, uint8_t *sync_input, uint8_t *kgnb)
 {
     kdf_param_t param;
 
@@ -258,8 +312,7 @@ void ogs_kdf_nh_gnb(uint8_t *kamf, uint8_t *sync_input, uint8_t *kgnb)
     param[0].buf = sync_input;
     param[0].len = OGS_SHA256_DIGEST_SIZE;
 
-    ogs_kdf_common(kamf, OGS_SHA256_DIGEST_SIZE,
-            FC_FOR_NH_GNB_DERIVATION, param, kgnb);
+    ogs_kdf_derive(kamf, FC_FOR_NH_GNB_DERIVATION, param, kgnb);
 }
 
 /*
@@ -334,6 +387,15 @@ void ogs_auc_kasme(const uint8_t *ck, const uint8_t *ik,
 
 /* TS33.401 Annex A.3 KeNB derivation function */
 void ogs_kdf_kenb(uint8_t *kasme, uint32_t ul_count, uint8_t *kenb)
+{
+    ogs_kdf_key_t kdf_key;
+
+    ogs_kdf_key_init(&kdf_key, kasme, OGS_SHA256_DIGEST_SIZE);
+    ogs_kdf_kenb_from_key(&kdf_key, ul_count, kenb);
+}
+
+void ogs_kdf_kenb_from_key(
+        const ogs_kdf_key_t *kasme, uint32_t ul_count, uint8_t *kenb)
 {
     kdf_param_t param;
 
@@ -342,12 +404,20 @@ void ogs_kdf_kenb(uint8_t *kasme, uint32_t ul_count, uint8_t *kenb)
     param[0].buf = (uint8_t *)&ul_count;
     param[0].len = 4;
 
-    ogs_kdf_common(kasme, OGS_SHA256_DIGEST_SIZE,
-            FC_FOR_KENB_DERIVATION, param, kenb);
+    ogs_kdf_derive(kasme, FC_FOR_KENB_DERIVATION, param, kenb);
 }
 
 /* TS33.401 Annex A.4 NH derivation function */
 void ogs_kdf_nh_enb(uint8_t *kasme, uint8_t *sync_input, uint8_t *kenb)
+{
+    ogs_kdf_key_t kdf_key;
+
+    ogs_kdf_key_init(&kdf_key, kasme, OGS_SHA256_DIGEST_SIZE);
+    ogs_kdf_nh_enb_from_key(&kdf_key, sync_input, kenb);
+}
+
+void ogs_kdf_nh_enb_from_key(
+        const ogs_kdf_key_t *kasme, uint8_t *sync_input, uint8_t *kenb)
 {
     kdf_param_t param;
 
@@ -355,13 +425,22 @@ void ogs_kdf_nh_enb(uint8_t *kasme, uint8_t *sync_input, uint8_t *kenb)
     param[0].buf = sync_input;
     param[0].len = OGS_SHA256_DIGEST_SIZE;
 
-    ogs_kdf_common(kasme, OGS_SHA256_DIGEST_SIZE,
-            FC_FOR_NH_ENB_DERIVATION, param, kenb);
+    ogs_kdf_derive(kasme, FC_FOR_NH_ENB_DERIVATION, param, kenb);
 }
 
 /* TS33.401 Annex A.7 Algorithm key derivation functions */
 void ogs_kdf_nas_eps(uint8_t algorithm_type_distinguishers,
     uint8_t algorithm_identity, uint8_t *kasme, uint8_t *knas)
+{
+    ogs_kdf_key_t kdf_key;
+
+    ogs_kdf_key_init(&kdf_key, kasme, OGS_SHA256_DIGEST_SIZE);
+    ogs_kdf_nas_eps_from_key(algorithm_type_distinguishers,
+            algorithm_identity, &kdf_key, knas);
+}
+
+void ogs_kdf_nas_eps_from_key(uint8_t algorithm_type_distinguishers,
+    uint8_t algorithm_identity, const ogs_kdf_key_t *kasme, uint8_t *knas)
 {
     kdf_param_t param;
     uint8_t output[OGS_SHA256_DIGEST_SIZE];
@@ -372,8 +451,7 @@ void ogs_kdf_nas_eps(uint8_t algorithm_type_distinguishers,
     param[1].buf = &algorithm_identity;
     param[1].len = 1;
 
-    ogs_kdf_common(kasme, OGS_SHA256_DIGEST_SIZE,
-            FC_FOR_EPS_ALGORITHM_KEY_DERIVATION, param, output);
+    ogs_kdf_derive(kasme, FC_FOR_EPS_ALGORITHM_KEY_DERIVATION, param, output);
     memcpy(knas, output+16, 16);
 }
 
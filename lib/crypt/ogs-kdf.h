@@ -28,6 +28,19 @@
 extern "C" {
 #endif
 
+/*
+ * HMAC-SHA-256 state of a parent key (Kamf, KASME) with the inner and
+ * outer pads already hashed. Each *_from_key() derivation then costs two
+ * SHA-256 blocks instead of four.
+ */
+typedef struct ogs_kdf_key_s {
+    uint32_t inner[8];
+    uint32_t outer[8];
+} ogs_kdf_key_t;
+
+void ogs_kdf_key_init(ogs_kdf_key_t *kdf_key,
+        const uint8_t *key, uint32_t key_size);
+
 /* TS33.501 Annex A.2 : Kausf derviation function */
 void ogs_kdf_kausf(
         uint8_t *ck, uint8_t *ik,
@@ -69,13 +82,19 @@ void ogs_kdf_kamf(char *supi, uint8_t *abba, uint8_t abba_len,
 /* TS33.501 Annex A.8 : Algorithm key derivation functions */
 void ogs_kdf_nas_5gs(uint8_t algorithm_type_distinguishers,
     uint8_t algorithm_identity, uint8_t *kamf, uint8_t *knas);
+void ogs_kdf_nas_5gs_from_key(uint8_t algorithm_type_distinguishers,
+    uint8_t algorithm_identity, const ogs_kdf_key_t *kamf, uint8_t *knas);
 
 /* TS33.501 Annex A.9 KgNB and Kn3iwf derivation function */
 void ogs_kdf_kgnb_and_kn3iwf(uint8_t *kamf, uint32_t ul_count,
         uint8_t access_type_distinguisher, uint8_t *kgnb);
+void ogs_kdf_kgnb_and_kn3iwf_from_key(const ogs_kdf_key_t *kamf,
+        uint32_t ul_count, uint8_t access_type_distinguisher, uint8_t *kgnb);
 
 /* TS33.501 Annex A.10 NH derivation function */
 void ogs_kdf_nh_gnb(uint8_t *kamf, uint8_t *sync_input, uint8_t *kgnb);
+void ogs_kdf_nh_gnb_from_key(
+        const ogs_kdf_key_t *kamf, uint8_t *sync_input, uint8_t *kgnb);
 
 /*
  * TS33.501 Annex C.3.4.1 Profile A
@@ -93,13 +112,19 @@ void ogs_auc_kasme(const uint8_t *ck, const uint8_t *ik,
 
 /* TS33.401 Annex A.3 KeNB derivation function */
 void ogs_kdf_kenb(uint8_t *kasme, uint32_t ul_count, uint8_t *kenb);
+void ogs_kdf_kenb_from_key(
+        const ogs_kdf_key_t *kasme, uint32_t ul_count, uint8_t *kenb);
 
 /* TS33.401 Annex A.4 NH derivation function */
 void ogs_kdf_nh_enb(uint8_t *kasme, uint8_t *sync_input, uint8_t *kenb);
+void ogs_kdf_nh_enb_from_key(
+        const ogs_kdf_key_t *kasme, uint8_t *sync_input, uint8_t *kenb);
 
 /* TS33.401 Annex A.7 Algorithm key derivation functions */
 void ogs_kdf_nas_eps(uint8_t algorithm_type_distinguishers,
     uint8_t algorithm_identity, uint8_t *kasme, uint8_t *knas);
+void ogs_kdf_nas_eps_from_key(uint8_t algorithm_type_distinguishers,
+    uint8_t algorithm_identity, const ogs_kdf_key_t *kasme, uint8_t *knas);
 
 /*
  * TS33.401 Annex I Hash Functions
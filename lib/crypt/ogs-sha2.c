@@ -60,6 +60,14 @@
 
 #include "ogs-crypt.h"
 
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    ((defined(__clang__) && __clang_major__ >= 4) || \
+     (!defined(__clang__) && __GNUC__ >= 5))
+#include <immintrin.h>
+#include <cpuid.h>
+#define USE_SHANI 1
+#endif
+
 #define SHFR(x, n)    (x >> n)
 #define ROTR(x, n)   ((x >> n) | (x << ((sizeof(x) << 3) - n)))
 #define ROTL(x, n)   ((x << n) | (x >> ((sizeof(x) << 3) - n)))
@@ -230,6 +238,58 @@ static uint64_t sha512_k[80] =
 
 /* SHA-256 functions */
 
+#if USE_SHANI
+static void shani_sha256_transf(uint32_t *h, const uint8_t *message,
+        uint32_t block_nb);
+#endif
+
+static int sha256_backend = -1;
+
+static bool sha256_backend_supported(ogs_sha256_backend_e backend)
+{
+#if USE_SHANI
+    unsigned int eax, ebx, ecx, edx;
+#endif
+
+    switch (backend) {
+    case OGS_SHA256_BACKEND_PORTABLE:
+        return true;
+#if USE_SHANI
+    case OGS_SHA256_BACKEND_SHANI:
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) ||
+            !(ecx & bit_SSSE3) || !(ecx & bit_SSE4_1))
+            return false;
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+            return false;
+        return (ebx & (1 << 29)) != 0; /* SHA */
+#endif
+    default:
+        return false;
+    }
+}
+
+ogs_sha256_backend_e ogs_sha256_backend(void)
+{
+    if (sha256_backend < 0) {
+        if (sha256_backend_supported(OGS_SHA256_BACKEND_SHANI))
+            sha256_backend = OGS_SHA256_BACKEND_SHANI;
+        else
+            sha256_backend = OGS_SHA256_BACKEND_PORTABLE;
+    }
+
+    return sha256_backend;
+}
+
+int ogs_sha256_set_backend(ogs_sha256_backend_e backend)
+{
+    if (sha256_backend_supported(backend) == false)
+        return OGS_ERROR;
+
+    sha256_backend = backend;
+
+    return OGS_OK;
+}
+
 static void sha256_transf(ogs_sha256_ctx *ctx, const uint8_t *message,
                    uint32_t block_nb)
 {
@@ -243,6 +303,13 @@ static void sha256_transf(ogs_sha256_ctx *ctx, const uint8_t *message,
     int j;
 #endif
 
+#if USE_SHANI
+    if (ogs_sha256_backend() == OGS_SHA256_BACKEND_SHANI) {
+        shani_sha256_transf(ctx->h, message, block_nb);
+        return;
+    }
+#endif
+
     for (i = 0; i < (int) block_nb; i++) {
         sub_block = message + (i << 6);
 
@@ -444,6 +511,116 @@ void ogs_sha256_final(ogs_sha256_ctx *ctx, uint8_t *digest)
 #endif /* !UNROLL_LOOPS */
 }
 
+#if USE_SHANI
+
+#define SHANI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+
+/* Four rounds, the two SHA256RNDS2 halves with message words w */
+#define SHANI_RNDS4(__w, __i) \
+    do { \
+        msg = _mm_add_epi32((__w), \
+                _mm_loadu_si128((const __m128i *)&sha256_k[4 * (__i)])); \
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg); \
+        msg = _mm_shuffle_epi32(msg, 0x0E); \
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg); \
+    } while (0)
+
+/* Complete the message schedule of next from prev and cur */
+#define SHANI_SCHED(__nEXT, __cUR, __pREV) \
+    do { \
+        tmp = _mm_alignr_epi8((__cUR), (__pREV), 4); \
+        __nEXT = _mm_add_epi32(__nEXT, tmp); \
+        __nEXT = _mm_sha256msg2_epu32(__nEXT, (__cUR)); \
+    } while (0)
+
+SHANI_TARGET
+static void shani_sha256_transf(uint32_t *h, const uint8_t *message,
+        uint32_t block_nb)
+{
+    const __m128i mask = _mm_set_epi64x(
+            0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, abef, cdgh;
+    __m128i msg, tmp, msg0, msg1, msg2, msg3;
+    uint32_t i;
+
+    /* h[0..7] to the ABEF/CDGH layout of SHA256RNDS2 */
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&h[0]), 0xB1);
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&h[4]), 0x1B);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (i = 0; i < block_nb; i++, message += OGS_SHA256_BLOCK_SIZE) {
+        abef = state0;
+        cdgh = state1;
+
+        msg0 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(message + 0)), mask);
+        msg1 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(message + 16)), mask);
+        msg2 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(message + 32)), mask);
+        msg3 = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(message + 48)), mask);
+
+        SHANI_RNDS4(msg0, 0);
+        SHANI_RNDS4(msg1, 1);
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+        SHANI_RNDS4(msg2, 2);
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+        SHANI_RNDS4(msg3, 3);
+        SHANI_SCHED(msg0, msg3, msg2);
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+        SHANI_RNDS4(msg0, 4);
+        SHANI_SCHED(msg1, msg0, msg3);
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+        SHANI_RNDS4(msg1, 5);
+        SHANI_SCHED(msg2, msg1, msg0);
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+        SHANI_RNDS4(msg2, 6);
+        SHANI_SCHED(msg3, msg2, msg1);
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+        SHANI_RNDS4(msg3, 7);
+        SHANI_SCHED(msg0, msg3, msg2);
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+        SHANI_RNDS4(msg0, 8);
+        SHANI_SCHED(msg1, msg0, msg3);
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+        SHANI_RNDS4(msg1, 9);
+        SHANI_SCHED(msg2, msg1, msg0);
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+        SHANI_RNDS4(msg2, 10);
+        SHANI_SCHED(msg3, msg2, msg1);
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+        SHANI_RNDS4(msg3, 11);
+        SHANI_SCHED(msg0, msg3, msg2);
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+        SHANI_RNDS4(msg0, 12);
+        SHANI_SCHED(msg1, msg0, msg3);
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+        SHANI_RNDS4(msg1, 13);
+        SHANI_SCHED(msg2, msg1, msg0);
+        SHANI_RNDS4(msg2, 14);
+        SHANI_SCHED(msg3, msg2, msg1);
+        SHANI_RNDS4(msg3, 15);
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    /* Back to h[0..7] */
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128((__m128i *)&h[0], state0);
+    _mm_storeu_si128((__m128i *)&h[4], state1);
+}
+
+#endif /* USE_SHANI */
+
 /* SHA-512 functions */
 
 static void sha512_transf(ogs_sha512_ctx *ctx, const uint8_t *message,
@@ -46,6 +46,15 @@ extern "C" {
 #define OGS_SHA384_BLOCK_SIZE  OGS_SHA512_BLOCK_SIZE
 #define OGS_SHA224_BLOCK_SIZE  OGS_SHA256_BLOCK_SIZE
 
+typedef enum {
+    OGS_SHA256_BACKEND_PORTABLE = 0,    /* Portable C */
+    OGS_SHA256_BACKEND_SHANI,           /* x86 SHA extensions */
+} ogs_sha256_backend_e;
+
+/* Selected from the CPU features on first use, also used for SHA-224 */
+ogs_sha256_backend_e ogs_sha256_backend(void);
+int ogs_sha256_set_backend(ogs_sha256_backend_e backend);
+
 typedef struct {
     uint32_t tot_len;
     uint32_t len;
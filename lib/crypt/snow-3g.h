@@ -15,6 +15,22 @@ typedef uint8_t u8;
 typedef uint32_t u32;
 typedef uint64_t u64;
 
+typedef enum {
+    SNOW_3G_BACKEND_PORTABLE = 0,   /* Shift-and-add GF(2^64) multiply */
+    SNOW_3G_BACKEND_PCLMUL,         /* x86 carry-less multiply for f9 */
+} snow_3g_backend_e;
+
+/* Selected from the CPU features on first use */
+snow_3g_backend_e snow_3g_backend(void);
+int snow_3g_set_backend(snow_3g_backend_e backend);
+
+/* Cipher state, kept on the caller's stack so that f8/f9 are reentrant */
+typedef struct snow_3g_ctx_s {
+    u32 s[16];          /* LFSR, s[(t + i) & 15] is s_i */
+    u32 r1, r2, r3;     /* FSM */
+    u32 t;
+} snow_3g_ctx_t;
+
 /* Initialization.
 * Input k[4]: Four 32-bit words making up 128-bit key.
 * Input IV[4]: Four 32-bit words making 128-bit initialization variable.
@@ -22,7 +38,7 @@ typedef uint64_t u64;
 * See Section 4.1.
 */
 
-void snow_3g_initialize(u32 k[4], u32 IV[4]);
+void snow_3g_initialize(snow_3g_ctx_t *ctx, u32 k[4], u32 IV[4]);
 
 /* Generation of Keystream.
 * input n: number of 32-bit words of keystream.
@@ -32,7 +48,7 @@ void snow_3g_initialize(u32 k[4], u32 IV[4]);
 * See section 4.2.
 */
 
-void snow_3g_generate_key_stream(u32 n, u32 *z);
+void snow_3g_generate_key_stream(snow_3g_ctx_t *ctx, u32 n, u32 *z);
 
 /* f8.
 * Input key: 128 bit Confidentiality Key.
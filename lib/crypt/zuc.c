@@ -3,51 +3,13 @@
  *--------------------------------------------*/
 #include "zuc.h"
 
-u32 AddM(u32 a, u32 b);
-void LFSRWithInitialisationMode(u32 u);
-void LFSRWithWorkMode(void);
-void BitReorganization(void);
-u32 L1(u32 X);
-u32 L2(u32 X);
-u32 F(void);
-void ZUC(u8* k, u8* iv, u32* ks, u32 len);
-u32 GET_WORD(u32 * DATA, u32 i);
-u8 GET_BIT(u8 * DATA, u32 i);
-
-/*--------------------------------------------
- * ZUC keystream generator algorithm
- *------------------------------------------*/
-
-/* the state registers of LFSR */ 
-static u32 LFSR_S0;
-static u32 LFSR_S1;
-static u32 LFSR_S2;
-static u32 LFSR_S3;
-static u32 LFSR_S4;
-static u32 LFSR_S5;
-static u32 LFSR_S6;
-static u32 LFSR_S7;
-static u32 LFSR_S8;
-static u32 LFSR_S9;
-static u32 LFSR_S10;
-static u32 LFSR_S11;
-static u32 LFSR_S12;
-static u32 LFSR_S13;
-static u32 LFSR_S14;
-static u32 LFSR_S15;
-
-/* the registers of F */
-static u32 F_R1;
-static u32 F_R2;
-
-/* the outputs of BitReorganization */
-static u32 BRC_X0;
-static u32 BRC_X1;
-static u32 BRC_X2;
-static u32 BRC_X3;
-
-/* the s-boxes */ 
-static u8 S0[256] = {
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define USE_PCLMUL 1
+#endif
+
+/* the s-boxes */
+static const u8 S0[256] = {
 0x3e,0x72,0x5b,0x47,0xca,0xe0,0x00,0x33,0x04,0xd1,0x54,0x98,0x09,0xb9,0x6d,0xcb,
 0x7b,0x1b,0xf9,0x32,0xaf,0x9d,0x6a,0xa5,0xb8,0x2d,0xfc,0x1d,0x08,0x53,0x03,0x90,
 0x4d,0x4e,0x84,0x99,0xe4,0xce,0xd9,0x91,0xdd,0xb6,0x85,0x48,0x8b,0x29,0x6e,0xac,
@@ -64,9 +26,9 @@ static u8 S0[256] = {
 0xf6,0xfa,0x36,0xd2,0x50,0x68,0x9e,0x62,0x71,0x15,0x3d,0xd6,0x40,0xc4,0xe2,0x0f,
 0x8e,0x83,0x77,0x6b,0x25,0x05,0x3f,0x0c,0x30,0xea,0x70,0xb7,0xa1,0xe8,0xa9,0x65,
 0x8d,0x27,0x1a,0xdb,0x81,0xb3,0xa0,0xf4,0x45,0x7a,0x19,0xdf,0xee,0x78,0x34,0x60
-}; 
+};
 
-static u8 S1[256] =  {
+static const u8 S1[256] =  {
 0x55,0xc2,0x63,0x71,0x3b,0xc8,0x47,0x86,0x9f,0x3c,0xda,0x5b,0x29,0xaa,0xfd,0x77,
 0x8c,0xc5,0x94,0x0c,0xa6,0x1a,0x13,0x00,0xe3,0xa8,0x16,0x72,0x40,0xf9,0xf8,0x42,
 0x44,0x26,0x68,0x96,0x81,0xd9,0x45,0x3e,0x10,0x76,0xc6,0xa7,0x8b,0x39,0x43,0xe1,
@@ -84,198 +46,133 @@ static u8 S1[256] =  {
 0x88,0xb1,0x98,0x7c,0xf3,0x3d,0x60,0x6c,0x7b,0xca,0xd3,0x1f,0x32,0x65,0x04,0x28,
 0x64,0xbe,0x85,0x9b,0x2f,0x59,0x8a,0xd7,0xb0,0x25,0xac,0xaf,0x12,0x03,0xe2,0xf2
 };
- 
+
 /* the constants D */
-static u32 EK_d[16] = {
+static const u32 EK_d[16] = {
 0x44D7, 0x26BC, 0x626B, 0x135E, 0x5789, 0x35E2, 0x7135, 0x09AF,
 0x4D78, 0x2F13, 0x6BC4, 0x1AF1, 0x5E26, 0x3C4D, 0x789A, 0x47AC
 };
 
+/*---------------------------------------------
+ * ZUC keystream generator algorithm
+ *--------------------------------------------*/
+
+#define LFSR(__cTX, __i) ((__cTX)->s[((__cTX)->t + (__i)) & 15])
+
 /* c = a + b mod (2^31 - 1) */
-u32 AddM(u32 a, u32 b)
+static ogs_inline u32 AddM(u32 a, u32 b)
 {
-	u32 c = a + b;
-	return (c & 0x7FFFFFFF) + (c >> 31);
+    u32 c = a + b;
+    return (c & 0x7FFFFFFF) + (c >> 31);
 }
 
-/* LFSR with initialization mode */
 #define MulByPow2(x, k) ((((x) << k) | ((x) >> (31 - k))) & 0x7FFFFFFF)
-void LFSRWithInitialisationMode(u32 u)
-{
-	u32 f, v;
-	f = LFSR_S0;
-	
-	v = MulByPow2(LFSR_S0, 8);
-	f = AddM(f, v);
-	v = MulByPow2(LFSR_S4, 20);
-	f = AddM(f, v);
-	v = MulByPow2(LFSR_S10, 21);
-	f = AddM(f, v);
-	v = MulByPow2(LFSR_S13, 17);
-	f = AddM(f, v);
-	v = MulByPow2(LFSR_S15, 15);
-	f = AddM(f, v);
-	
-	f = AddM(f, u);
-	
-	/* update the state */
-	LFSR_S0 = LFSR_S1;
-	LFSR_S1 = LFSR_S2;
-	LFSR_S2 = LFSR_S3;
-	LFSR_S3 = LFSR_S4;
-	LFSR_S4 = LFSR_S5;
-	LFSR_S5 = LFSR_S6;
-	LFSR_S6 = LFSR_S7;
-	LFSR_S7 = LFSR_S8;
-	LFSR_S8 = LFSR_S9;
-	LFSR_S9 = LFSR_S10;
-	LFSR_S10 = LFSR_S11;
-	LFSR_S11 = LFSR_S12;
-	LFSR_S12 = LFSR_S13;
-	LFSR_S13 = LFSR_S14;
-	LFSR_S14 = LFSR_S15;
-	LFSR_S15 = f;
-}
 
-/* LFSR with work mode */
-void LFSRWithWorkMode(void)
+/* LFSR with initialization mode (u) or work mode (zero) */
+static ogs_inline void LFSRClock(zuc_ctx_t *ctx, u32 u)
 {
-	u32 f, v;
-	f = LFSR_S0;
-	
-	v = MulByPow2(LFSR_S0, 8);
-	f = AddM(f, v);
-	v = MulByPow2(LFSR_S4, 20);
-	f = AddM(f, v);
-	v = MulByPow2(LFSR_S10, 21);
-	f = AddM(f, v);
-	v = MulByPow2(LFSR_S13, 17);
-	f = AddM(f, v);
-	v = MulByPow2(LFSR_S15, 15);
-	f = AddM(f, v);
-	
-	/* update the state */
-	LFSR_S0 = LFSR_S1;
-	LFSR_S1 = LFSR_S2;
-	LFSR_S2 = LFSR_S3;
-	LFSR_S3 = LFSR_S4;
-	LFSR_S4 = LFSR_S5;
-	LFSR_S5 = LFSR_S6;
-	LFSR_S6 = LFSR_S7;
-	LFSR_S7 = LFSR_S8;
-	LFSR_S8 = LFSR_S9;
-	LFSR_S9 = LFSR_S10;
-	LFSR_S10 = LFSR_S11;
-	LFSR_S11 = LFSR_S12;
-	LFSR_S12 = LFSR_S13;
-	LFSR_S13 = LFSR_S14;
-	LFSR_S14 = LFSR_S15;
-	LFSR_S15 = f;
-}
+    u32 s0 = LFSR(ctx, 0);
+    u32 f;
 
-/* BitReorganization */
-void BitReorganization(void)
-{
-	BRC_X0 = ((LFSR_S15 & 0x7FFF8000) << 1) | (LFSR_S14 & 0xFFFF);
-	BRC_X1 = ((LFSR_S11 & 0xFFFF) << 16) | (LFSR_S9 >> 15);
-	BRC_X2 = ((LFSR_S7 & 0xFFFF) << 16) | (LFSR_S5 >> 15);
-	BRC_X3 = ((LFSR_S2 & 0xFFFF) << 16) | (LFSR_S0 >> 15);
+    f = AddM(s0, MulByPow2(s0, 8));
+    f = AddM(f, MulByPow2(LFSR(ctx, 4), 20));
+    f = AddM(f, MulByPow2(LFSR(ctx, 10), 21));
+    f = AddM(f, MulByPow2(LFSR(ctx, 13), 17));
+    f = AddM(f, MulByPow2(LFSR(ctx, 15), 15));
+    f = AddM(f, u);
+
+    /* s0 is no longer needed, its slot becomes s15 */
+    LFSR(ctx, 0) = f;
+    ctx->t++;
 }
 
 #define ROT(a, k) (((a) << k) | ((a) >> (32 - k)))
 
 /* L1 */
-u32 L1(u32 X)
+static ogs_inline u32 L1(u32 X)
 {
-	return (X ^ ROT(X, 2) ^ ROT(X, 10) ^ ROT(X, 18) ^ ROT(X, 24));
+    return (X ^ ROT(X, 2) ^ ROT(X, 10) ^ ROT(X, 18) ^ ROT(X, 24));
 }
 
 /* L2 */
-u32 L2(u32 X)
+static ogs_inline u32 L2(u32 X)
 {
-	return (X ^ ROT(X, 8) ^ ROT(X, 14) ^ ROT(X, 22) ^ ROT(X, 30));
+    return (X ^ ROT(X, 8) ^ ROT(X, 14) ^ ROT(X, 22) ^ ROT(X, 30));
 }
 
 #define MAKEU32(a, b, c, d) (((u32)(a) << 24) | ((u32)(b) << 16) | ((u32)(c) << 8) | ((u32)(d)))
-/* F */
-u32 F(void)
+
+/* BitReorganization and F, returns W. X3 is needed for the keystream. */
+static ogs_inline u32 F(zuc_ctx_t *ctx, u32 *X3)
 {
-	u32 W, W1, W2, u, v;
-	
-	W  = (BRC_X0 ^ F_R1) + F_R2;
-	W1 = F_R1 + BRC_X1;
-	W2 = F_R2 ^ BRC_X2;
-	
-	u = L1((W1 << 16) | (W2 >> 16));
-	v = L2((W2 << 16) | (W1 >> 16));
-	
-	F_R1 = MAKEU32(S0[u >> 24], S1[(u >> 16) & 0xFF],
-	S0[(u >> 8) & 0xFF], S1[u & 0xFF]);
-	F_R2 = MAKEU32(S0[v >> 24], S1[(v >> 16) & 0xFF],
-	S0[(v >> 8) & 0xFF], S1[v & 0xFF]);
-	
-	return W;
+    u32 X0, X1, X2, W, W1, W2, u, v;
+
+    X0 = ((LFSR(ctx, 15) & 0x7FFF8000) << 1) | (LFSR(ctx, 14) & 0xFFFF);
+    X1 = ((LFSR(ctx, 11) & 0xFFFF) << 16) | (LFSR(ctx, 9) >> 15);
+    X2 = ((LFSR(ctx, 7) & 0xFFFF) << 16) | (LFSR(ctx, 5) >> 15);
+    if (X3)
+        *X3 = ((LFSR(ctx, 2) & 0xFFFF) << 16) | (LFSR(ctx, 0) >> 15);
+
+    W  = (X0 ^ ctx->r1) + ctx->r2;
+    W1 = ctx->r1 + X1;
+    W2 = ctx->r2 ^ X2;
+
+    u = L1((W1 << 16) | (W2 >> 16));
+    v = L2((W2 << 16) | (W1 >> 16));
+
+    ctx->r1 = MAKEU32(S0[u >> 24], S1[(u >> 16) & 0xFF],
+            S0[(u >> 8) & 0xFF], S1[u & 0xFF]);
+    ctx->r2 = MAKEU32(S0[v >> 24], S1[(v >> 16) & 0xFF],
+            S0[(v >> 8) & 0xFF], S1[v & 0xFF]);
+
+    return W;
 }
 
 #define MAKEU31(a, b, c) (((u32)(a) << 23) | ((u32)(b) << 8) | (u32)(c))
 /* initialize */
-void zuc_initialize(u8* k, u8* iv)
+void zuc_initialize(zuc_ctx_t *ctx, u8* k, u8* iv)
 {
-	u32 w, nCount;
-
-	/* expand key */
-	LFSR_S0 = MAKEU31(k[0], EK_d[0], iv[0]);
-	LFSR_S1 = MAKEU31(k[1], EK_d[1], iv[1]);
-	LFSR_S2 = MAKEU31(k[2], EK_d[2], iv[2]);
-	LFSR_S3 = MAKEU31(k[3], EK_d[3], iv[3]);
-	LFSR_S4 = MAKEU31(k[4], EK_d[4], iv[4]);
-	LFSR_S5 = MAKEU31(k[5], EK_d[5], iv[5]);
-	LFSR_S6 = MAKEU31(k[6], EK_d[6], iv[6]);
-	LFSR_S7 = MAKEU31(k[7], EK_d[7], iv[7]);
-	LFSR_S8 = MAKEU31(k[8], EK_d[8], iv[8]);
-	LFSR_S9 = MAKEU31(k[9], EK_d[9], iv[9]);
-	LFSR_S10 = MAKEU31(k[10], EK_d[10], iv[10]);
-	LFSR_S11 = MAKEU31(k[11], EK_d[11], iv[11]);
-	LFSR_S12 = MAKEU31(k[12], EK_d[12], iv[12]);
-	LFSR_S13 = MAKEU31(k[13], EK_d[13], iv[13]);
-	LFSR_S14 = MAKEU31(k[14], EK_d[14], iv[14]);
-	LFSR_S15 = MAKEU31(k[15], EK_d[15], iv[15]);
-
-	/* set F_R1 and F_R2 to zero */
-	F_R1 = 0;
-	F_R2 = 0;
-	nCount = 32;
-	while (nCount > 0)
-	{
-		BitReorganization();
-		w = F();
-		LFSRWithInitialisationMode(w >> 1);
-		nCount --;
-	}
+    int i;
+
+    ogs_assert(ctx);
+
+    /* expand key */
+    for (i = 0; i < 16; i++)
+        ctx->s[i] = MAKEU31(k[i], EK_d[i], iv[i]);
+    ctx->t = 0;
+
+    /* set F_R1 and F_R2 to zero */
+    ctx->r1 = 0;
+    ctx->r2 = 0;
+
+    for (i = 0; i < 32; i++)
+        LFSRClock(ctx, F(ctx, NULL) >> 1);
+
+    /* discard the output of F */
+    F(ctx, NULL);
+    LFSRClock(ctx, 0);
 }
 
-void zuc_generate_key_stream(u32* pKeystream, u32 KeystreamLen)
+/* One keystream word */
+static ogs_inline u32 zuc_next(zuc_ctx_t *ctx)
 {
-	int i;
-	BitReorganization();
-	F(); 			/* discard the output of F */
-	LFSRWithWorkMode();
-	
-	for (i = 0; i < KeystreamLen; i ++)
-	{
-		BitReorganization();
-		pKeystream[i] = F() ^ BRC_X3;
-		LFSRWithWorkMode();
-	}
+    u32 X3, z;
+
+    z = F(ctx, &X3) ^ X3;
+    LFSRClock(ctx, 0);
+
+    return z;
 }
 
-/* The ZUC algorithm, see ref. [3]*/
-void ZUC(u8* k, u8* iv, u32* ks, u32 len)
+void zuc_generate_key_stream(zuc_ctx_t *ctx,
+        u32* pKeystream, u32 KeystreamLen)
 {
-	/* The initialization of ZUC, see page 17 of ref. [3]*/
-	zuc_initialize(k, iv);
-	/*  The procedure of generating keystream of ZUC, see page 18 of ref. [3]*/
-	zuc_generate_key_stream(ks, len);
+    u32 i;
+
+    ogs_assert(ctx);
+
+    for (i = 0; i < KeystreamLen; i++)
+        pKeystream[i] = zuc_next(ctx);
 }
 /* end of ZUC.c */
 
@@ -286,54 +183,50 @@ void ZUC(u8* k, u8* iv, u32* ks, u32 len)
 /*
  * EEA3: LTE Encryption Algorithm 3
  * EEA3.c
+ *
+ * The keystream is XORed as it is generated instead of being buffered.
 */
-void zuc_eea3(u8* CK, u32 COUNT, u32 BEARER, u32 DIRECTION, 
-				   u32 LENGTH, u8* M, u8* C)
+void zuc_eea3(u8* CK, u32 COUNT, u32 BEARER, u32 DIRECTION,
+                   u32 LENGTH, u8* M, u8* C)
 {
-	u32 *z, L, L8, i;
-	u8 	IV[16];
-	u32 lastbits = (8-(LENGTH%8))%8;
-    
-	L 	= (LENGTH+31)/32;
-	z 	= (u32 *) ogs_malloc(L*sizeof(u32));
-    ogs_assert(z);
-    
-	L8 	= (LENGTH+7)/8;
-	
-	IV[0]	= (COUNT>>24) & 0xFF;
-	IV[1]	= (COUNT>>16) & 0xFF;
-	IV[2]	= (COUNT>>8)  & 0xFF;
-	IV[3]	=  COUNT      & 0xFF;
-	
-	IV[4]	= ((BEARER << 3) | ((DIRECTION&1)<<2)) & 0xFC;
-	IV[5]	= 0;
-	IV[6]	= 0;
-	IV[7]	= 0;
-	
-	IV[8]	= IV[0];
-	IV[9]	= IV[1];
-	IV[10]	= IV[2];
-	IV[11]	= IV[3];
-	
-	IV[12]	= IV[4];
-	IV[13]	= IV[5];
-	IV[14]	= IV[6];
-	IV[15]	= IV[7];
-	
-	ZUC(CK, IV, z, L);
-	
-	for (i=0; i<L8; i++)
-    {
-		C[i] = M[i] ^ ((z[i/4] >> (3-i%4)*8) & 0xff);
+    zuc_ctx_t ctx;
+    u32 i, z, L8;
+    u8 IV[16];
+    u32 lastbits = (8-(LENGTH%8))%8;
+
+    L8 = (LENGTH+7)/8;
+
+    IV[0] = (COUNT>>24) & 0xFF;
+    IV[1] = (COUNT>>16) & 0xFF;
+    IV[2] = (COUNT>>8)  & 0xFF;
+    IV[3] =  COUNT      & 0xFF;
+
+    IV[4] = ((BEARER << 3) | ((DIRECTION&1)<<2)) & 0xFC;
+    IV[5] = 0;
+    IV[6] = 0;
+    IV[7] = 0;
+
+    memcpy(IV + 8, IV, 8);
+
+    zuc_initialize(&ctx, CK, IV);
+
+    for (i = 0; i + 4 <= L8; i += 4) {
+        z = zuc_next(&ctx);
+        C[i+0] = M[i+0] ^ (u8)(z >> 24);
+        C[i+1] = M[i+1] ^ (u8)(z >> 16);
+        C[i+2] = M[i+2] ^ (u8)(z >> 8);
+        C[i+3] = M[i+3] ^ (u8)z;
+    }
+    if (i < L8) {
+        z = zuc_next(&ctx);
+        for (; i < L8; i++, z <<= 8)
+            C[i] = M[i] ^ (u8)(z >> 24);
     }
 
-	/* zero last bits of data in case its length is not  word-aligned (32 bits)
-	   this is an addition to the C reference code, which did not handle it */
-	if (lastbits)
-        i--;
-		C[i] &= 0x100 - (1<<lastbits);
-	
-	ogs_free(z);
+    /* zero last bits of data in case its length is not byte-aligned
+       this is an addition to the C reference code, which did not handle it */
+    if (lastbits)
+        C[L8-1] &= 0x100 - (1<<lastbits);
 }
 /* end of EEA3.c */
 
@@ -341,65 +234,156 @@ void zuc_eea3(u8* CK, u32 COUNT, u32 BEARER, u32 DIRECTION,
  * EIA3
  *---------------------------------------------------*/
 
+static int zuc_backend_value = -1;
+
+static bool zuc_backend_supported(zuc_backend_e backend)
+{
+    switch (backend) {
+    case ZUC_BACKEND_PORTABLE:
+        return true;
+#if USE_PCLMUL
+    case ZUC_BACKEND_PCLMUL:
+        return __builtin_cpu_supports("pclmul") &&
+            __builtin_cpu_supports("sse2");
+#endif
+    default:
+        return false;
+    }
+}
+
+zuc_backend_e zuc_backend(void)
+{
+    if (zuc_backend_value < 0) {
+        if (zuc_backend_supported(ZUC_BACKEND_PCLMUL))
+            zuc_backend_value = ZUC_BACKEND_PCLMUL;
+        else
+            zuc_backend_value = ZUC_BACKEND_PORTABLE;
+    }
+
+    return zuc_backend_value;
+}
+
+int zuc_set_backend(zuc_backend_e backend)
+{
+    if (zuc_backend_supported(backend) == false)
+        return OGS_ERROR;
+
+    zuc_backend_value = backend;
+
+    return OGS_OK;
+}
+
 /*
- * EIA3: LTE Integrity computation algorithm
- * EIA3.c
-*/
-u32 GET_WORD(u32 * DATA, u32 i)
+ * XOR of the 32-bit keystream words starting at each bit of M that is set.
+ * window holds the keystream words z[i] and z[i+1] for the message word
+ * m = M[i], most significant bit first.
+ */
+static u32 eia3_word(u32 m, uint64_t window)
+{
+    u32 T = 0;
+    int j;
+
+    for (j = 0; j < 32; j++)
+        T ^= (u32)(window >> (32 - j)) & (0 - ((m >> (31 - j)) & 1));
+
+    return T;
+}
+
+#if USE_PCLMUL
+#define PCLMUL_TARGET __attribute__((target("pclmul,sse2")))
+
+static ogs_inline u32 bitrev32(u32 x)
 {
-	u32 WORD, ti;
-	ti	= i % 32;
-	if (ti == 0)
-		WORD = DATA[i/32];
-	else
-		WORD = (DATA[i/32]<<ti) | (DATA[i/32+1]>>(32-ti));
-	return WORD;
+    x = ((x >> 1) & 0x55555555) | ((x & 0x55555555) << 1);
+    x = ((x >> 2) & 0x33333333) | ((x & 0x33333333) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F) | ((x & 0x0F0F0F0F) << 4);
+    return __builtin_bswap32(x);
 }
 
-u8 GET_BIT(u8 * DATA, u32 i)
+/* Same as eia3_word(), as bits 32..63 of bitrev(m) * window */
+PCLMUL_TARGET
+static u32 eia3_word_pclmul(u32 m, uint64_t window)
 {
-	return (DATA[i/8] & (1<<(7-(i%8)))) ? 1 : 0;
+    __m128i t;
+
+    t = _mm_clmulepi64_si128(_mm_cvtsi64_si128(bitrev32(m)),
+            _mm_cvtsi64_si128(window), 0x00);
+
+    return (u32)((uint64_t)_mm_cvtsi128_si64(t) >> 32);
 }
+#endif
 
+/*
+ * EIA3: LTE Integrity computation algorithm
+ * EIA3.c
+ *
+ * The reference code called GET_BIT/GET_WORD for every message bit.
+ * Here each 32-bit message word is combined with a 64-bit keystream
+ * window, and the keystream is generated as it is consumed.
+*/
 void zuc_eia3(u8* IK, u32 COUNT, u32 BEARER, u32 DIRECTION,
-				   u32 LENGTH, u8* M, u32* MAC)
+                   u32 LENGTH, u8* M, u32* MAC)
 {
-	u32	*z, N, L, T, i;
-	u8 IV[16];
-
-	IV[0]	= (COUNT>>24) & 0xFF;
-	IV[1]	= (COUNT>>16) & 0xFF;
-	IV[2]	= (COUNT>>8) & 0xFF;
-	IV[3]	= COUNT & 0xFF;
-	
-	IV[4]	= (BEARER << 3) & 0xF8;
-	IV[5]	= IV[6] = IV[7] = 0;
-	
-	IV[8]	= ((COUNT>>24) & 0xFF) ^ ((DIRECTION&1)<<7);
-	IV[9]	= (COUNT>>16) & 0xFF;
-	IV[10]	= (COUNT>>8) & 0xFF;
-	IV[11]	= COUNT & 0xFF;
-	
-	IV[12]	= IV[4];
-	IV[13]	= IV[5];
-	IV[14]	= IV[6] ^ ((DIRECTION&1)<<7);
-	IV[15]	= IV[7];
-	
-	N	= LENGTH + 64;
-	L	= (N + 31) / 32;
-	z	= (u32 *) ogs_malloc(L*sizeof(u32));
-    ogs_assert(z);
-	ZUC(IK, IV, z, L);
-	
-	T = 0;
-	for (i=0; i<LENGTH; i++) {
-		if (GET_BIT(M,i)) {
-			T ^= GET_WORD(z,i);
-		}
-	}
-	T ^= GET_WORD(z,LENGTH);
-	
-	*MAC = T ^ z[L-1];
-	ogs_free(z);
+    zuc_ctx_t ctx;
+    u32 T, m, i, j, nbits, nwords;
+    uint64_t window;
+    u8 IV[16];
+    u32 (*word)(u32, uint64_t) = eia3_word;
+
+#if USE_PCLMUL
+    if (zuc_backend() == ZUC_BACKEND_PCLMUL)
+        word = eia3_word_pclmul;
+#endif
+
+    IV[0] = (COUNT>>24) & 0xFF;
+    IV[1] = (COUNT>>16) & 0xFF;
+    IV[2] = (COUNT>>8) & 0xFF;
+    IV[3] = COUNT & 0xFF;
+
+    IV[4] = (BEARER << 3) & 0xF8;
+    IV[5] = IV[6] = IV[7] = 0;
+
+    IV[8] = ((COUNT>>24) & 0xFF) ^ ((DIRECTION&1)<<7);
+    IV[9] = (COUNT>>16) & 0xFF;
+    IV[10] = (COUNT>>8) & 0xFF;
+    IV[11] = COUNT & 0xFF;
+
+    IV[12] = IV[4];
+    IV[13] = IV[5];
+    IV[14] = IV[6] ^ ((DIRECTION&1)<<7);
+    IV[15] = IV[7];
+
+    zuc_initialize(&ctx, IK, IV);
+
+    /* window holds keystream words z[i] and z[i+1] */
+    window = (uint64_t)zuc_next(&ctx) << 32;
+    window |= zuc_next(&ctx);
+
+    T = 0;
+    nwords = (LENGTH + 31) / 32;
+    for (i = 0; i < nwords; i++) {
+        nbits = ogs_min(LENGTH - 32 * i, 32);
+
+        m = 0;
+        for (j = 0; j < (nbits + 7) / 8; j++)
+            m |= (u32)M[4*i+j] << (24 - 8*j);
+        m &= ~(u32)0 << (32 - nbits);
+
+        T ^= word(m, window);
+
+        if (nbits < 32)
+            break;
+
+        window = (window << 32) | zuc_next(&ctx);
+    }
+
+    /* GET_WORD(z, LENGTH) */
+    T ^= (u32)(window >> (32 - (LENGTH % 32)));
+
+    /* z[L-1] follows the window */
+    if (LENGTH % 32)
+        window = (window << 32) | zuc_next(&ctx);
+
+    *MAC = T ^ (u32)window;
 }
 /* end of EIA3.c */
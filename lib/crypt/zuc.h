@@ -21,6 +21,22 @@ extern "C" {
 typedef uint8_t u8;
 typedef uint32_t u32;
 
+typedef enum {
+    ZUC_BACKEND_PORTABLE = 0,       /* One keystream word per message bit */
+    ZUC_BACKEND_PCLMUL,             /* x86 carry-less multiply for EIA3 */
+} zuc_backend_e;
+
+/* Selected from the CPU features on first use */
+zuc_backend_e zuc_backend(void);
+int zuc_set_backend(zuc_backend_e backend);
+
+/* Cipher state, kept on the caller's stack so that EEA3/EIA3 are reentrant */
+typedef struct zuc_ctx_s {
+    u32 s[16];          /* LFSR, s[(t + i) & 15] is s_i */
+    u32 r1, r2;         /* F */
+    u32 t;
+} zuc_ctx_t;
+
 /*
  * ZUC keystream generator
  * k: secret key (input, 16 bytes)
@@ -28,8 +44,9 @@ typedef uint32_t u32;
  * Keystream: produced keystream (output, variable length)
  * KeystreamLen: length in bits requested for the keystream (input)
 */
-void zuc_initialize(u8* k, u8* iv);
-void zuc_generate_key_stream(u32* pKeystream, u32 KeystreamLen);
+void zuc_initialize(zuc_ctx_t *ctx, u8* k, u8* iv);
+void zuc_generate_key_stream(zuc_ctx_t *ctx,
+        u32* pKeystream, u32 KeystreamLen);
 
 /*
  * CK: ciphering key
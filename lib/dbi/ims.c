@@ -23,6 +23,8 @@ int ogs_dbi_msisdn_data(
         char *imsi_or_msisdn_bcd, ogs_msisdn_data_t *msisdn_data)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *subscriber = NULL;
     mongoc_cursor_t *cursor = NULL;
     bson_t *query = NULL;
     bson_error_t error;
@@ -47,11 +49,11 @@ int ogs_dbi_msisdn_data(
                 "{", "imsi", BCON_UTF8(imsi_or_msisdn_bcd), "}",
                 "{", "msisdn", BCON_UTF8(imsi_or_msisdn_bcd), "}",
             "]");
+    subscriber = ogs_dbi_subscriber_pop(&client);
 #if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 5
-    cursor = mongoc_collection_find_with_opts(
-            ogs_mongoc()->collection.subscriber, query, NULL, NULL);
+    cursor = mongoc_collection_find_with_opts(subscriber, query, NULL, NULL);
 #else
-    cursor = mongoc_collection_find(ogs_mongoc()->collection.subscriber,
+    cursor = mongoc_collection_find(subscriber,
             MONGOC_QUERY_NONE, 0, 0, 0, query, NULL, NULL);
 #endif
 
@@ -113,6 +115,7 @@ int ogs_dbi_msisdn_data(
 out:
     if (query) bson_destroy(query);
     if (cursor) mongoc_cursor_destroy(cursor);
+    if (subscriber) ogs_dbi_subscriber_push(client, subscriber);
 
     return rv;
 }
@@ -120,6 +123,8 @@ out:
 int ogs_dbi_ims_data(char *supi, ogs_ims_data_t *ims_data)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *subscriber = NULL;
     mongoc_cursor_t *cursor = NULL;
     bson_t *query = NULL;
     bson_error_t error;
@@ -148,11 +153,11 @@ int ogs_dbi_ims_data(char *supi, ogs_ims_data_t *ims_data)
     ogs_assert(supi_id);
 
     query = BCON_NEW(supi_type, BCON_UTF8(supi_id));
+    subscriber = ogs_dbi_subscriber_pop(&client);
 #if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 5
-    cursor = mongoc_collection_find_with_opts(
-            ogs_mongoc()->collection.subscriber, query, NULL, NULL);
+    cursor = mongoc_collection_find_with_opts(subscriber, query, NULL, NULL);
 #else
-    cursor = mongoc_collection_find(ogs_mongoc()->collection.subscriber,
+    cursor = mongoc_collection_find(subscriber,
             MONGOC_QUERY_NONE, 0, 0, 0, query, NULL, NULL);
 #endif
 
@@ -206,6 +211,7 @@ int ogs_dbi_ims_data(char *supi, ogs_ims_data_t *ims_data)
 out:
     if (query) bson_destroy(query);
     if (cursor) mongoc_cursor_destroy(cursor);
+    if (subscriber) ogs_dbi_subscriber_push(client, subscriber);
 
     ogs_free(supi_type);
     ogs_free(supi_id);
@@ -117,6 +117,13 @@ int ogs_mongoc_init(const char *db_uri)
     self.database = mongoc_client_get_database(self.client, self.name);
     ogs_assert(self.database);
 
+    self.pool = mongoc_client_pool_new(uri);
+    ogs_assert(self.pool);
+
+#if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 4
+    mongoc_client_pool_set_error_api(self.pool, 2);
+#endif
+
     if (!ogs_mongoc_mongoc_client_get_server_status(
                 self.client, NULL, &reply, &error)) {
         ogs_warn("Failed to connect to server [%s]", self.masked_db_uri);
@@ -134,6 +141,10 @@ int ogs_mongoc_init(const char *db_uri)
 
 void ogs_mongoc_final(void)
 {
+    if (self.pool) {
+        mongoc_client_pool_destroy(self.pool);
+        self.pool = NULL;
+    }
     if (self.database) {
         mongoc_database_destroy(self.database);
         self.database = NULL;
@@ -191,6 +202,40 @@ void ogs_dbi_final(void)
     ogs_mongoc_final();
 }
 
+/*
+ * Queries borrow a client from the pool instead of sharing self.client,
+ * so ogs_dbi_*() may be called from several threads at once.
+ * self.client is left to the change stream.
+ */
+mongoc_collection_t *ogs_dbi_subscriber_pop(mongoc_client_t **client)
+{
+    mongoc_collection_t *subscriber = NULL;
+
+    ogs_assert(client);
+    ogs_assert(self.pool);
+    ogs_assert(self.name);
+
+    *client = mongoc_client_pool_pop(self.pool);
+    ogs_assert(*client);
+
+    subscriber = mongoc_client_get_collection(
+            *client, self.name, "subscribers");
+    ogs_assert(subscriber);
+
+    return subscriber;
+}
+
+void ogs_dbi_subscriber_push(
+        mongoc_client_t *client, mongoc_collection_t *subscriber)
+{
+    ogs_assert(client);
+    ogs_assert(subscriber);
+    ogs_assert(self.pool);
+
+    mongoc_collection_destroy(subscriber);
+    mongoc_client_pool_push(self.pool, client);
+}
+
 int ogs_dbi_collection_watch_init(void)
 {
 #if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 9
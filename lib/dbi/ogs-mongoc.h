@@ -37,6 +37,9 @@ typedef struct ogs_mongoc_s {
     void *client;
     void *database;
 
+    /* Clients for queries, one per thread at a time */
+    void *pool;
+
 #if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 9
     mongoc_change_stream_t *stream;
 #endif
@@ -55,6 +58,10 @@ ogs_mongoc_t *ogs_mongoc(void);
 int ogs_dbi_init(const char *db_uri);
 void ogs_dbi_final(void);
 
+mongoc_collection_t *ogs_dbi_subscriber_pop(mongoc_client_t **client);
+void ogs_dbi_subscriber_push(
+        mongoc_client_t *client, mongoc_collection_t *subscriber);
+
 int ogs_dbi_collection_watch_init(void);
 int ogs_dbi_poll_change_stream(void);
 
@@ -23,6 +23,8 @@ int ogs_dbi_session_data(char *supi, ogs_s_nssai_t *s_nssai, char *dnn,
         ogs_session_data_t *session_data)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *subscriber = NULL;
     mongoc_cursor_t *cursor = NULL;
     bson_t *query = NULL;
     bson_t *opts = NULL;
@@ -57,11 +59,11 @@ int ogs_dbi_session_data(char *supi, ogs_s_nssai_t *s_nssai, char *dnn,
     ogs_assert(supi_id);
 
     query = BCON_NEW(supi_type, BCON_UTF8(supi_id));
+    subscriber = ogs_dbi_subscriber_pop(&client);
 #if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 5
-    cursor = mongoc_collection_find_with_opts(
-            ogs_mongoc()->collection.subscriber, query, NULL, NULL);
+    cursor = mongoc_collection_find_with_opts(subscriber, query, NULL, NULL);
 #else
-    cursor = mongoc_collection_find(ogs_mongoc()->collection.subscriber,
+    cursor = mongoc_collection_find(subscriber,
             MONGOC_QUERY_NONE, 0, 0, 0, query, NULL, NULL);
 #endif
 
@@ -494,6 +496,7 @@ out:
     if (query) bson_destroy(query);
     if (opts) bson_destroy(opts);
     if (cursor) mongoc_cursor_destroy(cursor);
+    if (subscriber) ogs_dbi_subscriber_push(client, subscriber);
 
     ogs_free(supi_type);
     ogs_free(supi_id);
@@ -19,18 +19,58 @@
 
 #include "ogs-dbi.h"
 
+static void auth_info_parse(bson_iter_t *iter, ogs_dbi_auth_info_t *auth_info)
+{
+    bson_iter_t inner_iter;
+    char buf[OGS_KEY_LEN];
+    char *utf8 = NULL;
+    uint32_t length = 0;
+
+    ogs_assert(iter);
+    ogs_assert(auth_info);
+
+    memset(auth_info, 0, sizeof(ogs_dbi_auth_info_t));
+    bson_iter_recurse(iter, &inner_iter);
+    while (bson_iter_next(&inner_iter)) {
+        const char *key = bson_iter_key(&inner_iter);
+
+        if (!strcmp(key, "k") && BSON_ITER_HOLDS_UTF8(&inner_iter)) {
+            utf8 = (char *)bson_iter_utf8(&inner_iter, &length);
+            ogs_ascii_to_hex(utf8, length, buf, sizeof(buf));
+            memcpy(auth_info->k, buf, OGS_KEY_LEN);
+        } else if (!strcmp(key, "opc") && BSON_ITER_HOLDS_UTF8(&inner_iter)) {
+            utf8 = (char *)bson_iter_utf8(&inner_iter, &length);
+            auth_info->use_opc = 1;
+            ogs_ascii_to_hex(utf8, length, buf, sizeof(buf));
+            memcpy(auth_info->opc, buf, OGS_KEY_LEN);
+        } else if (!strcmp(key, "op") && BSON_ITER_HOLDS_UTF8(&inner_iter)) {
+            utf8 = (char *)bson_iter_utf8(&inner_iter, &length);
+            ogs_ascii_to_hex(utf8, length, buf, sizeof(buf));
+            memcpy(auth_info->op, buf, OGS_KEY_LEN);
+        } else if (!strcmp(key, "amf") && BSON_ITER_HOLDS_UTF8(&inner_iter)) {
+            utf8 = (char *)bson_iter_utf8(&inner_iter, &length);
+            ogs_ascii_to_hex(utf8, length, buf, sizeof(buf));
+            memcpy(auth_info->amf, buf, OGS_AMF_LEN);
+        } else if (!strcmp(key, "rand") && BSON_ITER_HOLDS_UTF8(&inner_iter)) {
+            utf8 = (char *)bson_iter_utf8(&inner_iter, &length);
+            ogs_ascii_to_hex(utf8, length, buf, sizeof(buf));
+            memcpy(auth_info->rand, buf, OGS_RAND_LEN);
+        } else if (!strcmp(key, "sqn") && BSON_ITER_HOLDS_INT64(&inner_iter)) {
+            auth_info->sqn = bson_iter_int64(&inner_iter);
+        }
+    }
+}
+
 int ogs_dbi_auth_info(char *supi, ogs_dbi_auth_info_t *auth_info)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *subscriber = NULL;
     mongoc_cursor_t *cursor = NULL;
     bson_t *query = NULL;
     bson_error_t error;
     const bson_t *document;
     bson_iter_t iter;
-    bson_iter_t inner_iter;
-    char buf[OGS_KEY_LEN];
-    char *utf8 = NULL;
-    uint32_t length = 0;
 
     char *supi_type = NULL;
     char *supi_id = NULL;
@@ -44,11 +84,11 @@ int ogs_dbi_auth_info(char *supi, ogs_dbi_auth_info_t *auth_info)
     ogs_assert(supi_id);
 
     query = BCON_NEW(supi_type, BCON_UTF8(supi_id));
+    subscriber = ogs_dbi_subscriber_pop(&client);
 #if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 5
-    cursor = mongoc_collection_find_with_opts(
-            ogs_mongoc()->collection.subscriber, query, NULL, NULL);
+    cursor = mongoc_collection_find_with_opts(subscriber, query, NULL, NULL);
 #else
-    cursor = mongoc_collection_find(ogs_mongoc()->collection.subscriber,
+    cursor = mongoc_collection_find(subscriber,
             MONGOC_QUERY_NONE, 0, 0, 0, query, NULL, NULL);
 #endif
 
@@ -73,40 +113,12 @@ int ogs_dbi_auth_info(char *supi, ogs_dbi_auth_info_t *auth_info)
         goto out;
     }
 
-    memset(auth_info, 0, sizeof(ogs_dbi_auth_info_t));
-    bson_iter_recurse(&iter, &inner_iter);
-    while (bson_iter_next(&inner_iter)) {
-        const char *key = bson_iter_key(&inner_iter);
-
-        if (!strcmp(key, "k") && BSON_ITER_HOLDS_UTF8(&inner_iter)) {
-            utf8 = (char *)bson_iter_utf8(&inner_iter, &length);
-            ogs_ascii_to_hex(utf8, length, buf, sizeof(buf));
-            memcpy(auth_info->k, buf, OGS_KEY_LEN);
-        } else if (!strcmp(key, "opc") && BSON_ITER_HOLDS_UTF8(&inner_iter)) {
-            utf8 = (char *)bson_iter_utf8(&inner_iter, &length);
-            auth_info->use_opc = 1;
-            ogs_ascii_to_hex(utf8, length, buf, sizeof(buf));
-            memcpy(auth_info->opc, buf, OGS_KEY_LEN);
-        } else if (!strcmp(key, "op") && BSON_ITER_HOLDS_UTF8(&inner_iter)) {
-            utf8 = (char *)bson_iter_utf8(&inner_iter, &length);
-            ogs_ascii_to_hex(utf8, length, buf, sizeof(buf));
-            memcpy(auth_info->op, buf, OGS_KEY_LEN);
-        } else if (!strcmp(key, "amf") && BSON_ITER_HOLDS_UTF8(&inner_iter)) {
-            utf8 = (char *)bson_iter_utf8(&inner_iter, &length);
-            ogs_ascii_to_hex(utf8, length, buf, sizeof(buf));
-            memcpy(auth_info->amf, buf, OGS_AMF_LEN);
-        } else if (!strcmp(key, "rand") && BSON_ITER_HOLDS_UTF8(&inner_iter)) {
-            utf8 = (char *)bson_iter_utf8(&inner_iter, &length);
-            ogs_ascii_to_hex(utf8, length, buf, sizeof(buf));
-            memcpy(auth_info->rand, buf, OGS_RAND_LEN);
-        } else if (!strcmp(key, "sqn") && BSON_ITER_HOLDS_INT64(&inner_iter)) {
-            auth_info->sqn = bson_iter_int64(&inner_iter);
-        }
-    }
+    auth_info_parse(&iter, auth_info);
 
 out:
     if (query) bson_destroy(query);
     if (cursor) mongoc_cursor_destroy(cursor);
+    if (subscriber) ogs_dbi_subscriber_push(client, subscriber);
 
     ogs_free(supi_type);
     ogs_free(supi_id);
@@ -117,6 +129,8 @@ out:
 int ogs_dbi_update_sqn(char *supi, uint64_t sqn)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *subscriber = NULL;
     bson_t *query = NULL;
     bson_t *update = NULL;
     bson_error_t error;
@@ -137,12 +151,14 @@ int ogs_dbi_update_sqn(char *supi, uint64_t sqn)
                 "security.sqn", BCON_INT64(sqn),
             "}");
 
-    if (!mongoc_collection_update(ogs_mongoc()->collection.subscriber,
+    subscriber = ogs_dbi_subscriber_pop(&client);
+    if (!mongoc_collection_update(subscriber,
             MONGOC_UPDATE_NONE, query, update, NULL, &error)) {
         ogs_error("mongoc_collection_update() failure: %s", error.message);
 
         rv = OGS_ERROR;
     }
+    ogs_dbi_subscriber_push(client, subscriber);
 
     if (query) bson_destroy(query);
     if (update) bson_destroy(update);
@@ -156,6 +172,8 @@ int ogs_dbi_update_sqn(char *supi, uint64_t sqn)
 int ogs_dbi_update_imeisv(char *supi, char *imeisv)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *subscriber = NULL;
     bson_t *query = NULL;
     bson_t *update = NULL;
     bson_error_t error;
@@ -178,12 +196,14 @@ int ogs_dbi_update_imeisv(char *supi, char *imeisv)
             "{",
                 "imeisv", BCON_UTF8(imeisv),
             "}");
-    if (!mongoc_collection_update(ogs_mongoc()->collection.subscriber,
+    subscriber = ogs_dbi_subscriber_pop(&client);
+    if (!mongoc_collection_update(subscriber,
             MONGOC_UPDATE_UPSERT, query, update, NULL, &error)) {
         ogs_error("mongoc_collection_update() failure: %s", error.message);
 
         rv = OGS_ERROR;
     }
+    ogs_dbi_subscriber_push(client, subscriber);
 
     if (query) bson_destroy(query);
     if (update) bson_destroy(update);
@@ -198,6 +218,8 @@ int ogs_dbi_update_mme(char *supi, char *mme_host, char *mme_realm,
     bool purge_flag)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *subscriber = NULL;
     bson_t *query = NULL;
     bson_t *update = NULL;
     bson_error_t error;
@@ -223,12 +245,14 @@ int ogs_dbi_update_mme(char *supi, char *mme_host, char *mme_realm,
                 "mme_timestamp", BCON_INT64(ogs_time_now()),
                 "purge_flag", BCON_BOOL(purge_flag),
             "}");
-    if (!mongoc_collection_update(ogs_mongoc()->collection.subscriber,
+    subscriber = ogs_dbi_subscriber_pop(&client);
+    if (!mongoc_collection_update(subscriber,
             MONGOC_UPDATE_UPSERT, query, update, NULL, &error)) {
         ogs_error("mongoc_collection_update() failure: %s", error.message);
 
         rv = OGS_ERROR;
     }
+    ogs_dbi_subscriber_push(client, subscriber);
 
     if (query) bson_destroy(query);
     if (update) bson_destroy(update);
@@ -240,52 +264,105 @@ int ogs_dbi_update_mme(char *supi, char *mme_host, char *mme_realm,
 }
 
 int ogs_dbi_increment_sqn(char *supi)
+{
+    ogs_dbi_auth_info_t auth_info;
+
+    return ogs_dbi_reserve_sqn(supi, 1, &auth_info);
+}
+
+/*
+ * Advance the stored SQN by 'count' steps of 32 in one findAndModify and
+ * return the subscriber's security data as it was before the update.
+ * The mask is applied in a second update only when the counter wraps.
+ * Both updates commute with those of other callers.
+ */
+int ogs_dbi_reserve_sqn(char *supi, int count, ogs_dbi_auth_info_t *auth_info)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *subscriber = NULL;
     bson_t *query = NULL;
     bson_t *update = NULL;
+    bson_t *fields = NULL;
+    bson_t reply;
     bson_error_t error;
+    bson_iter_t iter, security_iter;
     uint64_t max_sqn = OGS_MAX_SQN;
+    uint64_t step = 0;
 
     char *supi_type = NULL;
     char *supi_id = NULL;
 
     ogs_assert(supi);
+    ogs_assert(count > 0);
+    ogs_assert(auth_info);
 
     supi_type = ogs_id_get_type(supi);
     ogs_assert(supi_type);
     supi_id = ogs_id_get_value(supi);
     ogs_assert(supi_id);
 
+    step = 32 * (uint64_t)count;
+
     query = BCON_NEW(supi_type, BCON_UTF8(supi_id));
     update = BCON_NEW("$inc",
             "{",
-                "security.sqn", BCON_INT64(32),
+                "security.sqn", BCON_INT64(step),
             "}");
-    if (!mongoc_collection_update(ogs_mongoc()->collection.subscriber,
-            MONGOC_UPDATE_NONE, query, update, NULL, &error)) {
-        ogs_error("mongoc_collection_update() failure: %s", error.message);
+    fields = BCON_NEW("security", BCON_INT32(1));
+
+    subscriber = ogs_dbi_subscriber_pop(&client);
+
+    if (!mongoc_collection_find_and_modify(subscriber, query, NULL,
+            update, fields, false, false, false, &reply, &error)) {
+        ogs_error("mongoc_collection_find_and_modify() failure: %s",
+                error.message);
+        bson_destroy(&reply);
 
         rv = OGS_ERROR;
         goto out;
     }
-    bson_destroy(update);
 
-    update = BCON_NEW("$bit",
-            "{",
-                "security.sqn", 
-                "{", "and", BCON_INT64(max_sqn), "}",
-            "}");
-    if (!mongoc_collection_update(ogs_mongoc()->collection.subscriber,
-            MONGOC_UPDATE_NONE, query, update, NULL, &error)) {
-        ogs_error("mongoc_collection_update() failure: %s", error.message);
+    /* 'value' is null when no subscriber matched */
+    if (!bson_iter_init(&iter, &reply) ||
+        !bson_iter_find_descendant(
+            &iter, "value.security", &security_iter) ||
+        !BSON_ITER_HOLDS_DOCUMENT(&security_iter)) {
+        ogs_info("[%s] Cannot find IMSI in DB", supi);
+        bson_destroy(&reply);
 
         rv = OGS_ERROR;
+        goto out;
+    }
+
+    auth_info_parse(&security_iter, auth_info);
+    bson_destroy(&reply);
+
+    /* A concurrent caller may have seen the counter before it was masked */
+    auth_info->sqn &= max_sqn;
+
+    if (auth_info->sqn + step > max_sqn) {
+        bson_destroy(update);
+        update = BCON_NEW("$bit",
+                "{",
+                    "security.sqn",
+                    "{", "and", BCON_INT64(max_sqn), "}",
+                "}");
+        if (!mongoc_collection_update(subscriber,
+                MONGOC_UPDATE_NONE, query, update, NULL, &error)) {
+            ogs_error("mongoc_collection_update() failure: %s",
+                    error.message);
+
+            rv = OGS_ERROR;
+        }
     }
 
 out:
+    ogs_dbi_subscriber_push(client, subscriber);
+
     if (query) bson_destroy(query);
     if (update) bson_destroy(update);
+    if (fields) bson_destroy(fields);
 
     ogs_free(supi_type);
     ogs_free(supi_id);
@@ -297,6 +374,8 @@ int ogs_dbi_subscription_data(char *supi,
         ogs_subscription_data_t *subscription_data)
 {
     int rv = OGS_OK;
+    mongoc_client_t *client = NULL;
+    mongoc_collection_t *subscriber = NULL;
     mongoc_cursor_t *cursor = NULL;
     bson_t *query = NULL;
     bson_error_t error;
@@ -326,11 +405,11 @@ int ogs_dbi_subscription_data(char *supi,
     ogs_assert(supi_id);
 
     query = BCON_NEW(supi_type, BCON_UTF8(supi_id));
+    subscriber = ogs_dbi_subscriber_pop(&client);
 #if MONGOC_MAJOR_VERSION >= 1 && MONGOC_MINOR_VERSION >= 5
-    cursor = mongoc_collection_find_with_opts(
-            ogs_mongoc()->collection.subscriber, query, NULL, NULL);
+    cursor = mongoc_collection_find_with_opts(subscriber, query, NULL, NULL);
 #else
-    cursor = mongoc_collection_find(ogs_mongoc()->collection.subscriber,
+    cursor = mongoc_collection_find(subscriber,
             MONGOC_QUERY_NONE, 0, 0, 0, query, NULL, NULL);
 #endif
 
@@ -784,6 +863,7 @@ int ogs_dbi_subscription_data(char *supi,
 out:
     if (query) bson_destroy(query);
     if (cursor) mongoc_cursor_destroy(cursor);
+    if (subscriber) ogs_dbi_subscriber_push(client, subscriber);
 
     ogs_free(supi_type);
     ogs_free(supi_id);
@@ -41,6 +41,12 @@ typedef struct ogs_dbi_auth_info_s {
 int ogs_dbi_auth_info(char *supi, ogs_dbi_auth_info_t *auth_info);
 int ogs_dbi_update_sqn(char *supi, uint64_t sqn);
 int ogs_dbi_increment_sqn(char *supi);
+/*
+ * Read auth_info and advance the stored SQN past count vectors,
+ * which may then use auth_info->sqn + 32 * i (i < count).
+ * The caller serialises access for the same SUPI.
+ */
+int ogs_dbi_reserve_sqn(char *supi, int count, ogs_dbi_auth_info_t *auth_info);
 int ogs_dbi_update_imeisv(char *supi, char *imeisv);
 int ogs_dbi_update_mme(char *supi, char *mme_host, char *mme_realm,
     bool purge_flag);
@@ -35,46 +35,87 @@
 #include "ogs-nas-5gs.h"
 
 int ogs_nas_5gs_encode_registration_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_registration_request(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_registration_accept(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_registration_accept(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_registration_complete(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_registration_complete(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_registration_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_registration_reject(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_deregistration_request_from_ue(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_deregistration_request_from_ue(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_deregistration_request_to_ue(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_deregistration_request_to_ue(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_service_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_service_request(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_service_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_service_reject(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_service_accept(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_service_accept(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_configuration_update_command(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_configuration_update_command(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_authentication_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_authentication_request(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_authentication_response(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_authentication_response(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_authentication_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_authentication_reject(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_authentication_failure(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_authentication_failure(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_authentication_result(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_authentication_result(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_identity_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_identity_request(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_identity_response(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_identity_response(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_security_mode_command(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_security_mode_command(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_security_mode_complete(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_security_mode_complete(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_security_mode_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_security_mode_reject(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_5gmm_status(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_5gmm_status(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_notification(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_notification(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_notification_response(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_notification_response(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_ul_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_ul_nas_transport(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_dl_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_dl_nas_transport(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_establishment_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_establishment_request(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_establishment_accept(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_establishment_accept(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_establishment_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_establishment_reject(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_authentication_command(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_authentication_command(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_authentication_complete(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_authentication_complete(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_authentication_result(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_authentication_result(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_modification_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_modification_request(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_modification_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_modification_reject(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_modification_command(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_modification_command(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_modification_complete(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_modification_complete(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_modification_command_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_modification_command_reject(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_release_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_release_request(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_release_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_release_reject(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_release_command(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_release_command(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_pdu_session_release_complete(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_pdu_session_release_complete(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_5gsm_status(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message);
+int ogs_nas_5gs_length_5gsm_status(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gs_encode_registration_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_registration_request_t *registration_request = &message->gmm.registration_request;
@@ -474,6 +515,207 @@ int ogs_nas_5gs_encode_registration_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_mess
     return encoded;
 }
 
+int ogs_nas_5gs_length_registration_request(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_registration_request_t *registration_request = &message->gmm.registration_request;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_5gs_registration_type(&registration_request->registration_type);
+    length += ogs_nas_5gs_length_5gs_mobile_identity(&registration_request->mobile_identity);
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_NON_CURRENT_NATIVE_NAS_KEY_SET_IDENTIFIER_PRESENT) {
+        length += ogs_nas_5gs_length_key_set_identifier(&registration_request->non_current_native_nas_key_set_identifier);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_5GMM_CAPABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gmm_capability(&registration_request->gmm_capability);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_UE_SECURITY_CAPABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ue_security_capability(&registration_request->ue_security_capability);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_REQUESTED_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_nssai(&registration_request->requested_nssai);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_LAST_VISITED_REGISTERED_TAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_tracking_area_identity(&registration_request->last_visited_registered_tai);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_S1_UE_NETWORK_CAPABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_s1_ue_network_capability(&registration_request->s1_ue_network_capability);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_UPLINK_DATA_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_uplink_data_status(&registration_request->uplink_data_status);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_PDU_SESSION_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_session_status(&registration_request->pdu_session_status);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_MICO_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_mico_indication(&registration_request->mico_indication);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_UE_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ue_status(&registration_request->ue_status);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_ADDITIONAL_GUTI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_mobile_identity(&registration_request->additional_guti);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_ALLOWED_PDU_SESSION_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_allowed_pdu_session_status(&registration_request->allowed_pdu_session_status);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_UE_USAGE_SETTING_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ue_usage_setting(&registration_request->ue_usage_setting);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_REQUESTED_DRX_PARAMETERS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_drx_parameters(&registration_request->requested_drx_parameters);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_EPS_NAS_MESSAGE_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eps_nas_message_container(&registration_request->eps_nas_message_container);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_LADN_INDICATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ladn_indication(&registration_request->ladn_indication);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_PAYLOAD_CONTAINER_TYPE_PRESENT) {
+        length += ogs_nas_5gs_length_payload_container_type(&registration_request->payload_container_type);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_PAYLOAD_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_payload_container(&registration_request->payload_container);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_NETWORK_SLICING_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_network_slicing_indication(&registration_request->network_slicing_indication);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_5GS_UPDATE_TYPE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_update_type(&registration_request->update_type);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_MOBILE_STATION_CLASSMARK_2_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_mobile_station_classmark_2(&registration_request->mobile_station_classmark_2);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_SUPPORTED_CODECS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_supported_codec_list(&registration_request->supported_codecs);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_NAS_MESSAGE_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_message_container(&registration_request->nas_message_container);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_EPS_BEARER_CONTEXT_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eps_bearer_context_status(&registration_request->eps_bearer_context_status);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_REQUESTED_EXTENDED_DRX_PARAMETERS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_drx_parameters(&registration_request->requested_extended_drx_parameters);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_T3324_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_3(&registration_request->t3324_value);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_UE_RADIO_CAPABILITY_ID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ue_radio_capability_id(&registration_request->ue_radio_capability_id);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_REQUESTED_MAPPED_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_mapped_nssai(&registration_request->requested_mapped_nssai);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_ADDITIONAL_INFORMATION_REQUESTED_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_additional_information_requested(&registration_request->additional_information_requested);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_REQUESTED_WUS_ASSISTANCE_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_wus_assistance_information(&registration_request->requested_wus_assistance_information);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_N5GC_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_n5gc_indication(&registration_request->n5gc_indication);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_REQUESTED_NB_N1_MODE_DRX_PARAMETERS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_nb_n1_mode_drx_parameters(&registration_request->requested_nb_n1_mode_drx_parameters);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_UE_REQUEST_TYPE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ue_request_type(&registration_request->ue_request_type);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_PAGING_RESTRICTION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_paging_restriction(&registration_request->paging_restriction);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_SERVICE_LEVEL_AA_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_service_level_aa_container(&registration_request->service_level_aa_container);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_NID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_nid(&registration_request->nid);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_MS_DETERMINED_PLMN_WITH_DISASTER_CONDITION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_plmn_identity(&registration_request->ms_determined_plmn_with_disaster_condition);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_REQUESTED_PEIPS_ASSISTANCE_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_peips_assistance_information(&registration_request->requested_peips_assistance_information);
+    }
+
+    if (registration_request->presencemask & OGS_NAS_5GS_REGISTRATION_REQUEST_REQUESTED_T3512_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_3(&registration_request->requested_t3512_value);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_registration_accept(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_registration_accept_t *registration_accept = &message->gmm.registration_accept;
@@ -979,137 +1221,405 @@ int ogs_nas_5gs_encode_registration_accept(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_messa
     return encoded;
 }
 
-int ogs_nas_5gs_encode_registration_complete(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
+int ogs_nas_5gs_length_registration_accept(ogs_nas_5gs_message_t *message)
 {
-    ogs_nas_5gs_registration_complete_t *registration_complete = &message->gmm.registration_complete;
-    int encoded = 0;
-    int size = 0;
-
-    ogs_trace("[NAS] Encode REGISTRATION_COMPLETE");
+    ogs_nas_5gs_registration_accept_t *registration_accept = &message->gmm.registration_accept;
+    int length = 0;
 
-    if (registration_complete->presencemask & OGS_NAS_5GS_REGISTRATION_COMPLETE_SOR_TRANSPARENT_CONTAINER_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_COMPLETE_SOR_TRANSPARENT_CONTAINER_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
+    length += ogs_nas_5gs_length_5gs_registration_result(&registration_accept->registration_result);
 
-        size = ogs_nas_5gs_encode_sor_transparent_container(pkbuf, &registration_complete->sor_transparent_container);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_5G_GUTI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_mobile_identity(&registration_accept->guti);
     }
 
-    return encoded;
-}
-
-int ogs_nas_5gs_encode_registration_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
-{
-    ogs_nas_5gs_registration_reject_t *registration_reject = &message->gmm.registration_reject;
-    int encoded = 0;
-    int size = 0;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_EQUIVALENT_PLMNS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_plmn_list(&registration_accept->equivalent_plmns);
+    }
 
-    ogs_trace("[NAS] Encode REGISTRATION_REJECT");
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_TAI_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_tracking_area_identity_list(&registration_accept->tai_list);
+    }
 
-    size = ogs_nas_5gs_encode_5gmm_cause(pkbuf, &registration_reject->gmm_cause);
-    ogs_assert(size >= 0);
-    encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_ALLOWED_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_nssai(&registration_accept->allowed_nssai);
+    }
 
-    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_T3346_VALUE_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_T3346_VALUE_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_REJECTED_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_rejected_nssai(&registration_accept->rejected_nssai);
+    }
 
-        size = ogs_nas_5gs_encode_gprs_timer_2(pkbuf, &registration_reject->t3346_value);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_CONFIGURED_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_nssai(&registration_accept->configured_nssai);
     }
 
-    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_T3502_VALUE_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_T3502_VALUE_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_5GS_NETWORK_FEATURE_SUPPORT_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_network_feature_support(&registration_accept->network_feature_support);
+    }
 
-        size = ogs_nas_5gs_encode_gprs_timer_2(pkbuf, &registration_reject->t3502_value);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_PDU_SESSION_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_session_status(&registration_accept->pdu_session_status);
     }
 
-    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_EAP_MESSAGE_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_EAP_MESSAGE_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_PDU_SESSION_REACTIVATION_RESULT_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_session_reactivation_result(&registration_accept->pdu_session_reactivation_result);
+    }
 
-        size = ogs_nas_5gs_encode_eap_message(pkbuf, &registration_reject->eap_message);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_PDU_SESSION_REACTIVATION_RESULT_ERROR_CAUSE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_session_reactivation_result_error_cause(&registration_accept->pdu_session_reactivation_result_error_cause);
     }
 
-    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_REJECTED_NSSAI_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_REJECTED_NSSAI_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_LADN_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ladn_information(&registration_accept->ladn_information);
+    }
 
-        size = ogs_nas_5gs_encode_rejected_nssai(pkbuf, &registration_reject->rejected_nssai);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_MICO_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_mico_indication(&registration_accept->mico_indication);
     }
 
-    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_CAG_INFORMATION_LIST_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_CAG_INFORMATION_LIST_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NETWORK_SLICING_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_network_slicing_indication(&registration_accept->network_slicing_indication);
+    }
 
-        size = ogs_nas_5gs_encode_cag_information_list(pkbuf, &registration_reject->cag_information_list);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_SERVICE_AREA_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_service_area_list(&registration_accept->service_area_list);
     }
 
-    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_EXTENDED_REJECTED_NSSAI_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_EXTENDED_REJECTED_NSSAI_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_T3512_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_3(&registration_accept->t3512_value);
+    }
 
-        size = ogs_nas_5gs_encode_extended_rejected_nssai(pkbuf, &registration_reject->extended_rejected_nssai);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NON_3GPP_DE_REGISTRATION_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_2(&registration_accept->non_3gpp_de_registration_timer_value);
     }
 
-    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_DISASTER_RETURN_WAIT_RANGE_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_DISASTER_RETURN_WAIT_RANGE_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_T3502_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_2(&registration_accept->t3502_value);
+    }
 
-        size = ogs_nas_5gs_encode_registration_wait_range(pkbuf, &registration_reject->disaster_return_wait_range);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_EMERGENCY_NUMBER_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_emergency_number_list(&registration_accept->emergency_number_list);
     }
 
-    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_EXTENDED_CAG_INFORMATION_LIST_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_EXTENDED_CAG_INFORMATION_LIST_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_EXTENDED_EMERGENCY_NUMBER_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_emergency_number_list(&registration_accept->extended_emergency_number_list);
+    }
 
-        size = ogs_nas_5gs_encode_extended_cag_information_list(pkbuf, &registration_reject->extended_cag_information_list);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_SOR_TRANSPARENT_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_sor_transparent_container(&registration_accept->sor_transparent_container);
     }
 
-    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_LOWER_BOUND_TIMER_VALUE_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_LOWER_BOUND_TIMER_VALUE_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_EAP_MESSAGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eap_message(&registration_accept->eap_message);
+    }
 
-        size = ogs_nas_5gs_encode_gprs_timer_3(pkbuf, &registration_reject->lower_bound_timer_value);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NSSAI_INCLUSION_MODE_PRESENT) {
+        length += ogs_nas_5gs_length_nssai_inclusion_mode(&registration_accept->nssai_inclusion_mode);
     }
 
-    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_OPERATOR_DEFINED_ACCESS_CATEGORY_DEFINITIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_operator_defined_access_category_definitions(&registration_accept->operator_defined_access_category_definitions);
+    }
 
-        size = ogs_nas_5gs_encode_5gs_tracking_area_identity_list(pkbuf, &registration_reject->forbidden_tai_for_the_list_of_forbidden_tracking_areas_for_roaming);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NEGOTIATED_DRX_PARAMETERS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_drx_parameters(&registration_accept->negotiated_drx_parameters);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NON_3GPP_NW_POLICIES_PRESENT) {
+        length += ogs_nas_5gs_length_non_3gpp_nw_provided_policies(&registration_accept->non_3gpp_nw_policies);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_EPS_BEARER_CONTEXT_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eps_bearer_context_status(&registration_accept->eps_bearer_context_status);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NEGOTIATED_EXTENDED_DRX_PARAMETERS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_drx_parameters(&registration_accept->negotiated_extended_drx_parameters);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_T3447_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_3(&registration_accept->t3447_value);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_T3448_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_2(&registration_accept->t3448_value);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_T3324_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_3(&registration_accept->t3324_value);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_UE_RADIO_CAPABILITY_ID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ue_radio_capability_id(&registration_accept->ue_radio_capability_id);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_UE_RADIO_CAPABILITY_ID_DELETION_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_ue_radio_capability_id_deletion_indication(&registration_accept->ue_radio_capability_id_deletion_indication);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_PENDING_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_nssai(&registration_accept->pending_nssai);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_CIPHERING_KEY_DATA_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ciphering_key_data(&registration_accept->ciphering_key_data);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_CAG_INFORMATION_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_cag_information_list(&registration_accept->cag_information_list);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_TRUNCATED_5G_S_TMSI_CONFIGURATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_truncated_5g_s_tmsi_configuration(&registration_accept->truncated_s_tmsi_configuration);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NEGOTIATED_WUS_ASSISTANCE_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_wus_assistance_information(&registration_accept->negotiated_wus_assistance_information);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NEGOTIATED_NB_N1_MODE_DRX_PARAMETERS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_nb_n1_mode_drx_parameters(&registration_accept->negotiated_nb_n1_mode_drx_parameters);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_EXTENDED_REJECTED_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_rejected_nssai(&registration_accept->extended_rejected_nssai);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_SERVICE_LEVEL_AA_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_service_level_aa_container(&registration_accept->service_level_aa_container);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NEGOTIATED_PEIPS_ASSISTANCE_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_peips_assistance_information(&registration_accept->negotiated_peips_assistance_information);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_5GS_ADDITIONAL_REQUEST_RESULT_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_additional_request_result(&registration_accept->additional_request_result);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NSSRG_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_nssrg_information(&registration_accept->nssrg_information);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_DISASTER_ROAMING_WAIT_RANGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_registration_wait_range(&registration_accept->disaster_roaming_wait_range);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_DISASTER_RETURN_WAIT_RANGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_registration_wait_range(&registration_accept->disaster_return_wait_range);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_LIST_OF_PLMNS_TO_BE_USED_IN_DISASTER_CONDITION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_list_of_plmns_to_be_used_in_disaster_condition(&registration_accept->list_of_plmns_to_be_used_in_disaster_condition);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_tracking_area_identity_list(&registration_accept->forbidden_tai_for_the_list_of_forbidden_tracking_areas_for_roaming);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_tracking_area_identity_list(&registration_accept->forbidden_tai_for_the_list_of_forbidden_tracking_areas_forregional_provision_of_service);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_EXTENDED_CAG_INFORMATION_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_cag_information_list(&registration_accept->extended_cag_information_list);
+    }
+
+    if (registration_accept->presencemask & OGS_NAS_5GS_REGISTRATION_ACCEPT_NSAG_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_nsag_information(&registration_accept->nsag_information);
+    }
+
+    return length;
+}
+
+int ogs_nas_5gs_encode_registration_complete(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_registration_complete_t *registration_complete = &message->gmm.registration_complete;
+    int encoded = 0;
+    int size = 0;
+
+    ogs_trace("[NAS] Encode REGISTRATION_COMPLETE");
+
+    if (registration_complete->presencemask & OGS_NAS_5GS_REGISTRATION_COMPLETE_SOR_TRANSPARENT_CONTAINER_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_COMPLETE_SOR_TRANSPARENT_CONTAINER_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_sor_transparent_container(pkbuf, &registration_complete->sor_transparent_container);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    return encoded;
+}
+
+int ogs_nas_5gs_length_registration_complete(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_registration_complete_t *registration_complete = &message->gmm.registration_complete;
+    int length = 0;
+
+    if (registration_complete->presencemask & OGS_NAS_5GS_REGISTRATION_COMPLETE_SOR_TRANSPARENT_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_sor_transparent_container(&registration_complete->sor_transparent_container);
+    }
+
+    return length;
+}
+
+int ogs_nas_5gs_encode_registration_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_registration_reject_t *registration_reject = &message->gmm.registration_reject;
+    int encoded = 0;
+    int size = 0;
+
+    ogs_trace("[NAS] Encode REGISTRATION_REJECT");
+
+    size = ogs_nas_5gs_encode_5gmm_cause(pkbuf, &registration_reject->gmm_cause);
+    ogs_assert(size >= 0);
+    encoded += size;
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_T3346_VALUE_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_T3346_VALUE_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_gprs_timer_2(pkbuf, &registration_reject->t3346_value);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_T3502_VALUE_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_T3502_VALUE_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_gprs_timer_2(pkbuf, &registration_reject->t3502_value);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_EAP_MESSAGE_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_EAP_MESSAGE_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_eap_message(pkbuf, &registration_reject->eap_message);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_REJECTED_NSSAI_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_REJECTED_NSSAI_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_rejected_nssai(pkbuf, &registration_reject->rejected_nssai);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_CAG_INFORMATION_LIST_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_CAG_INFORMATION_LIST_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_cag_information_list(pkbuf, &registration_reject->cag_information_list);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_EXTENDED_REJECTED_NSSAI_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_EXTENDED_REJECTED_NSSAI_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_extended_rejected_nssai(pkbuf, &registration_reject->extended_rejected_nssai);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_DISASTER_RETURN_WAIT_RANGE_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_DISASTER_RETURN_WAIT_RANGE_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_registration_wait_range(pkbuf, &registration_reject->disaster_return_wait_range);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_EXTENDED_CAG_INFORMATION_LIST_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_EXTENDED_CAG_INFORMATION_LIST_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_extended_cag_information_list(pkbuf, &registration_reject->extended_cag_information_list);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_LOWER_BOUND_TIMER_VALUE_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_LOWER_BOUND_TIMER_VALUE_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_gprs_timer_3(pkbuf, &registration_reject->lower_bound_timer_value);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_REGISTRATION_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_5gs_tracking_area_identity_list(pkbuf, &registration_reject->forbidden_tai_for_the_list_of_forbidden_tracking_areas_for_roaming);
+        ogs_assert(size >= 0);
+        encoded += size;
     }
 
     if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_PRESENT) {
@@ -1125,6 +1635,71 @@ int ogs_nas_5gs_encode_registration_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_messa
     return encoded;
 }
 
+int ogs_nas_5gs_length_registration_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_registration_reject_t *registration_reject = &message->gmm.registration_reject;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_5gmm_cause(&registration_reject->gmm_cause);
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_T3346_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_2(&registration_reject->t3346_value);
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_T3502_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_2(&registration_reject->t3502_value);
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_EAP_MESSAGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eap_message(&registration_reject->eap_message);
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_REJECTED_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_rejected_nssai(&registration_reject->rejected_nssai);
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_CAG_INFORMATION_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_cag_information_list(&registration_reject->cag_information_list);
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_EXTENDED_REJECTED_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_rejected_nssai(&registration_reject->extended_rejected_nssai);
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_DISASTER_RETURN_WAIT_RANGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_registration_wait_range(&registration_reject->disaster_return_wait_range);
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_EXTENDED_CAG_INFORMATION_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_cag_information_list(&registration_reject->extended_cag_information_list);
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_LOWER_BOUND_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_3(&registration_reject->lower_bound_timer_value);
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_tracking_area_identity_list(&registration_reject->forbidden_tai_for_the_list_of_forbidden_tracking_areas_for_roaming);
+    }
+
+    if (registration_reject->presencemask & OGS_NAS_5GS_REGISTRATION_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_tracking_area_identity_list(&registration_reject->forbidden_tai_for_the_list_of_forbidden_tracking_areas_forregional_provision_of_service);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_deregistration_request_from_ue(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_deregistration_request_from_ue_t *deregistration_request_from_ue = &message->gmm.deregistration_request_from_ue;
@@ -1144,6 +1719,17 @@ int ogs_nas_5gs_encode_deregistration_request_from_ue(ogs_pkbuf_t *pkbuf, ogs_na
     return encoded;
 }
 
+int ogs_nas_5gs_length_deregistration_request_from_ue(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_deregistration_request_from_ue_t *deregistration_request_from_ue = &message->gmm.deregistration_request_from_ue;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_de_registration_type(&deregistration_request_from_ue->de_registration_type);
+    length += ogs_nas_5gs_length_5gs_mobile_identity(&deregistration_request_from_ue->mobile_identity);
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_deregistration_request_to_ue(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_deregistration_request_to_ue_t *deregistration_request_to_ue = &message->gmm.deregistration_request_to_ue;
@@ -1259,6 +1845,66 @@ int ogs_nas_5gs_encode_deregistration_request_to_ue(ogs_pkbuf_t *pkbuf, ogs_nas_
     return encoded;
 }
 
+int ogs_nas_5gs_length_deregistration_request_to_ue(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_deregistration_request_to_ue_t *deregistration_request_to_ue = &message->gmm.deregistration_request_to_ue;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_de_registration_type(&deregistration_request_to_ue->de_registration_type);
+
+    if (deregistration_request_to_ue->presencemask & OGS_NAS_5GS_DEREGISTRATION_REQUEST_TO_UE_5GMM_CAUSE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gmm_cause(&deregistration_request_to_ue->gmm_cause);
+    }
+
+    if (deregistration_request_to_ue->presencemask & OGS_NAS_5GS_DEREGISTRATION_REQUEST_TO_UE_T3346_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_2(&deregistration_request_to_ue->t3346_value);
+    }
+
+    if (deregistration_request_to_ue->presencemask & OGS_NAS_5GS_DEREGISTRATION_REQUEST_TO_UE_REJECTED_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_rejected_nssai(&deregistration_request_to_ue->rejected_nssai);
+    }
+
+    if (deregistration_request_to_ue->presencemask & OGS_NAS_5GS_DEREGISTRATION_REQUEST_TO_UE_CAG_INFORMATION_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_cag_information_list(&deregistration_request_to_ue->cag_information_list);
+    }
+
+    if (deregistration_request_to_ue->presencemask & OGS_NAS_5GS_DEREGISTRATION_REQUEST_TO_UE_EXTENDED_REJECTED_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_rejected_nssai(&deregistration_request_to_ue->extended_rejected_nssai);
+    }
+
+    if (deregistration_request_to_ue->presencemask & OGS_NAS_5GS_DEREGISTRATION_REQUEST_TO_UE_DISASTER_RETURN_WAIT_RANGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_registration_wait_range(&deregistration_request_to_ue->disaster_return_wait_range);
+    }
+
+    if (deregistration_request_to_ue->presencemask & OGS_NAS_5GS_DEREGISTRATION_REQUEST_TO_UE_EXTENDED_CAG_INFORMATION_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_cag_information_list(&deregistration_request_to_ue->extended_cag_information_list);
+    }
+
+    if (deregistration_request_to_ue->presencemask & OGS_NAS_5GS_DEREGISTRATION_REQUEST_TO_UE_LOWER_BOUND_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_3(&deregistration_request_to_ue->lower_bound_timer_value);
+    }
+
+    if (deregistration_request_to_ue->presencemask & OGS_NAS_5GS_DEREGISTRATION_REQUEST_TO_UE_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_tracking_area_identity_list(&deregistration_request_to_ue->forbidden_tai_for_the_list_of_forbidden_tracking_areas_for_roaming);
+    }
+
+    if (deregistration_request_to_ue->presencemask & OGS_NAS_5GS_DEREGISTRATION_REQUEST_TO_UE_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_tracking_area_identity_list(&deregistration_request_to_ue->forbidden_tai_for_the_list_of_forbidden_tracking_areas_forregional_provision_of_service);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_service_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_service_request_t *service_request = &message->gmm.service_request;
@@ -1338,6 +1984,47 @@ int ogs_nas_5gs_encode_service_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t
     return encoded;
 }
 
+int ogs_nas_5gs_length_service_request(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_service_request_t *service_request = &message->gmm.service_request;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_key_set_identifier(&service_request->ngksi);
+    length += ogs_nas_5gs_length_5gs_mobile_identity(&service_request->s_tmsi);
+
+    if (service_request->presencemask & OGS_NAS_5GS_SERVICE_REQUEST_UPLINK_DATA_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_uplink_data_status(&service_request->uplink_data_status);
+    }
+
+    if (service_request->presencemask & OGS_NAS_5GS_SERVICE_REQUEST_PDU_SESSION_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_session_status(&service_request->pdu_session_status);
+    }
+
+    if (service_request->presencemask & OGS_NAS_5GS_SERVICE_REQUEST_ALLOWED_PDU_SESSION_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_allowed_pdu_session_status(&service_request->allowed_pdu_session_status);
+    }
+
+    if (service_request->presencemask & OGS_NAS_5GS_SERVICE_REQUEST_NAS_MESSAGE_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_message_container(&service_request->nas_message_container);
+    }
+
+    if (service_request->presencemask & OGS_NAS_5GS_SERVICE_REQUEST_UE_REQUEST_TYPE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ue_request_type(&service_request->ue_request_type);
+    }
+
+    if (service_request->presencemask & OGS_NAS_5GS_SERVICE_REQUEST_PAGING_RESTRICTION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_paging_restriction(&service_request->paging_restriction);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_service_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_service_reject_t *service_reject = &message->gmm.service_reject;
@@ -1453,6 +2140,66 @@ int ogs_nas_5gs_encode_service_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t
     return encoded;
 }
 
+int ogs_nas_5gs_length_service_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_service_reject_t *service_reject = &message->gmm.service_reject;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_5gmm_cause(&service_reject->gmm_cause);
+
+    if (service_reject->presencemask & OGS_NAS_5GS_SERVICE_REJECT_PDU_SESSION_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_session_status(&service_reject->pdu_session_status);
+    }
+
+    if (service_reject->presencemask & OGS_NAS_5GS_SERVICE_REJECT_T3346_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_2(&service_reject->t3346_value);
+    }
+
+    if (service_reject->presencemask & OGS_NAS_5GS_SERVICE_REJECT_EAP_MESSAGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eap_message(&service_reject->eap_message);
+    }
+
+    if (service_reject->presencemask & OGS_NAS_5GS_SERVICE_REJECT_T3448_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_2(&service_reject->t3448_value);
+    }
+
+    if (service_reject->presencemask & OGS_NAS_5GS_SERVICE_REJECT_CAG_INFORMATION_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_cag_information_list(&service_reject->cag_information_list);
+    }
+
+    if (service_reject->presencemask & OGS_NAS_5GS_SERVICE_REJECT_DISASTER_RETURN_WAIT_RANGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_registration_wait_range(&service_reject->disaster_return_wait_range);
+    }
+
+    if (service_reject->presencemask & OGS_NAS_5GS_SERVICE_REJECT_EXTENDED_CAG_INFORMATION_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_cag_information_list(&service_reject->extended_cag_information_list);
+    }
+
+    if (service_reject->presencemask & OGS_NAS_5GS_SERVICE_REJECT_LOWER_BOUND_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_3(&service_reject->lower_bound_timer_value);
+    }
+
+    if (service_reject->presencemask & OGS_NAS_5GS_SERVICE_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_tracking_area_identity_list(&service_reject->forbidden_tai_for_the_list_of_forbidden_tracking_areas_for_roaming);
+    }
+
+    if (service_reject->presencemask & OGS_NAS_5GS_SERVICE_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_tracking_area_identity_list(&service_reject->forbidden_tai_for_the_list_of_forbidden_tracking_areas_forregional_provision_of_service);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_service_accept(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_service_accept_t *service_accept = &message->gmm.service_accept;
@@ -1544,6 +2291,54 @@ int ogs_nas_5gs_encode_service_accept(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t
     return encoded;
 }
 
+int ogs_nas_5gs_length_service_accept(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_service_accept_t *service_accept = &message->gmm.service_accept;
+    int length = 0;
+
+    if (service_accept->presencemask & OGS_NAS_5GS_SERVICE_ACCEPT_PDU_SESSION_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_session_status(&service_accept->pdu_session_status);
+    }
+
+    if (service_accept->presencemask & OGS_NAS_5GS_SERVICE_ACCEPT_PDU_SESSION_REACTIVATION_RESULT_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_session_reactivation_result(&service_accept->pdu_session_reactivation_result);
+    }
+
+    if (service_accept->presencemask & OGS_NAS_5GS_SERVICE_ACCEPT_PDU_SESSION_REACTIVATION_RESULT_ERROR_CAUSE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_session_reactivation_result_error_cause(&service_accept->pdu_session_reactivation_result_error_cause);
+    }
+
+    if (service_accept->presencemask & OGS_NAS_5GS_SERVICE_ACCEPT_EAP_MESSAGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eap_message(&service_accept->eap_message);
+    }
+
+    if (service_accept->presencemask & OGS_NAS_5GS_SERVICE_ACCEPT_T3448_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_2(&service_accept->t3448_value);
+    }
+
+    if (service_accept->presencemask & OGS_NAS_5GS_SERVICE_ACCEPT_5GS_ADDITIONAL_REQUEST_RESULT_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_additional_request_result(&service_accept->additional_request_result);
+    }
+
+    if (service_accept->presencemask & OGS_NAS_5GS_SERVICE_ACCEPT_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_tracking_area_identity_list(&service_accept->forbidden_tai_for_the_list_of_forbidden_tracking_areas_for_roaming);
+    }
+
+    if (service_accept->presencemask & OGS_NAS_5GS_SERVICE_ACCEPT_FORBIDDEN_TAI_FOR_THE_LIST_OF_5GS_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_tracking_area_identity_list(&service_accept->forbidden_tai_for_the_list_of_forbidden_tracking_areas_forregional_provision_of_service);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_configuration_update_command(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_configuration_update_command_t *configuration_update_command = &message->gmm.configuration_update_command;
@@ -1791,94 +2586,265 @@ int ogs_nas_5gs_encode_configuration_update_command(ogs_pkbuf_t *pkbuf, ogs_nas_
     }
 
     if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_SERVICE_LEVEL_AA_CONTAINER_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_SERVICE_LEVEL_AA_CONTAINER_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
-
-        size = ogs_nas_5gs_encode_service_level_aa_container(pkbuf, &configuration_update_command->service_level_aa_container);
-        ogs_assert(size >= 0);
-        encoded += size;
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_SERVICE_LEVEL_AA_CONTAINER_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_service_level_aa_container(pkbuf, &configuration_update_command->service_level_aa_container);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_NSSRG_INFORMATION_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_NSSRG_INFORMATION_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_nssrg_information(pkbuf, &configuration_update_command->nssrg_information);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_DISASTER_ROAMING_WAIT_RANGE_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_DISASTER_ROAMING_WAIT_RANGE_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_registration_wait_range(pkbuf, &configuration_update_command->disaster_roaming_wait_range);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_DISASTER_RETURN_WAIT_RANGE_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_DISASTER_RETURN_WAIT_RANGE_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_registration_wait_range(pkbuf, &configuration_update_command->disaster_return_wait_range);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_LIST_OF_PLMNS_TO_BE_USED_IN_DISASTER_CONDITION_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_LIST_OF_PLMNS_TO_BE_USED_IN_DISASTER_CONDITION_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_list_of_plmns_to_be_used_in_disaster_condition(pkbuf, &configuration_update_command->list_of_plmns_to_be_used_in_disaster_condition);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_EXTENDED_CAG_INFORMATION_LIST_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_EXTENDED_CAG_INFORMATION_LIST_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_extended_cag_information_list(pkbuf, &configuration_update_command->extended_cag_information_list);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_UPDATED_PEIPS_ASSISTANCE_INFORMATION_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_UPDATED_PEIPS_ASSISTANCE_INFORMATION_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_peips_assistance_information(pkbuf, &configuration_update_command->updated_peips_assistance_information);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_NSAG_INFORMATION_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_NSAG_INFORMATION_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_nsag_information(pkbuf, &configuration_update_command->nsag_information);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_PRIORITY_INDICATOR_PRESENT) {
+        configuration_update_command->priority_indicator.type = (OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_PRIORITY_INDICATOR_TYPE >> 4);
+
+        size = ogs_nas_5gs_encode_priority_indicator(pkbuf, &configuration_update_command->priority_indicator);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    return encoded;
+}
+
+int ogs_nas_5gs_length_configuration_update_command(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_configuration_update_command_t *configuration_update_command = &message->gmm.configuration_update_command;
+    int length = 0;
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_CONFIGURATION_UPDATE_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_configuration_update_indication(&configuration_update_command->configuration_update_indication);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_5G_GUTI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_mobile_identity(&configuration_update_command->guti);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_TAI_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_tracking_area_identity_list(&configuration_update_command->tai_list);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_ALLOWED_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_nssai(&configuration_update_command->allowed_nssai);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_SERVICE_AREA_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_service_area_list(&configuration_update_command->service_area_list);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_FULL_NAME_FOR_NETWORK_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_network_name(&configuration_update_command->full_name_for_network);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_SHORT_NAME_FOR_NETWORK_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_network_name(&configuration_update_command->short_name_for_network);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_LOCAL_TIME_ZONE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_time_zone(&configuration_update_command->local_time_zone);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_UNIVERSAL_TIME_AND_LOCAL_TIME_ZONE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_time_zone_and_time(&configuration_update_command->universal_time_and_local_time_zone);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_NETWORK_DAYLIGHT_SAVING_TIME_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_daylight_saving_time(&configuration_update_command->network_daylight_saving_time);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_LADN_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ladn_information(&configuration_update_command->ladn_information);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_MICO_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_mico_indication(&configuration_update_command->mico_indication);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_NETWORK_SLICING_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_network_slicing_indication(&configuration_update_command->network_slicing_indication);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_CONFIGURED_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_nssai(&configuration_update_command->configured_nssai);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_REJECTED_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_rejected_nssai(&configuration_update_command->rejected_nssai);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_OPERATOR_DEFINED_ACCESS_CATEGORY_DEFINITIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_operator_defined_access_category_definitions(&configuration_update_command->operator_defined_access_category_definitions);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_SMS_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_sms_indication(&configuration_update_command->sms_indication);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_T3447_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_3(&configuration_update_command->t3447_value);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_CAG_INFORMATION_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_cag_information_list(&configuration_update_command->cag_information_list);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_UE_RADIO_CAPABILITY_ID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ue_radio_capability_id(&configuration_update_command->ue_radio_capability_id);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_UE_RADIO_CAPABILITY_ID_DELETION_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_ue_radio_capability_id_deletion_indication(&configuration_update_command->ue_radio_capability_id_deletion_indication);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_5GS_REGISTRATION_RESULT_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_registration_result(&configuration_update_command->registration_result);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_TRUNCATED_5G_S_TMSI_CONFIGURATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_truncated_5g_s_tmsi_configuration(&configuration_update_command->truncated_s_tmsi_configuration);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_ADDITIONAL_CONFIGURATION_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_additional_configuration_indication(&configuration_update_command->additional_configuration_indication);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_EXTENDED_REJECTED_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_rejected_nssai(&configuration_update_command->extended_rejected_nssai);
+    }
+
+    if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_SERVICE_LEVEL_AA_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_service_level_aa_container(&configuration_update_command->service_level_aa_container);
     }
 
     if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_NSSRG_INFORMATION_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_NSSRG_INFORMATION_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
-
-        size = ogs_nas_5gs_encode_nssrg_information(pkbuf, &configuration_update_command->nssrg_information);
-        ogs_assert(size >= 0);
-        encoded += size;
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_nssrg_information(&configuration_update_command->nssrg_information);
     }
 
     if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_DISASTER_ROAMING_WAIT_RANGE_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_DISASTER_ROAMING_WAIT_RANGE_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
-
-        size = ogs_nas_5gs_encode_registration_wait_range(pkbuf, &configuration_update_command->disaster_roaming_wait_range);
-        ogs_assert(size >= 0);
-        encoded += size;
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_registration_wait_range(&configuration_update_command->disaster_roaming_wait_range);
     }
 
     if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_DISASTER_RETURN_WAIT_RANGE_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_DISASTER_RETURN_WAIT_RANGE_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
-
-        size = ogs_nas_5gs_encode_registration_wait_range(pkbuf, &configuration_update_command->disaster_return_wait_range);
-        ogs_assert(size >= 0);
-        encoded += size;
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_registration_wait_range(&configuration_update_command->disaster_return_wait_range);
     }
 
     if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_LIST_OF_PLMNS_TO_BE_USED_IN_DISASTER_CONDITION_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_LIST_OF_PLMNS_TO_BE_USED_IN_DISASTER_CONDITION_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
-
-        size = ogs_nas_5gs_encode_list_of_plmns_to_be_used_in_disaster_condition(pkbuf, &configuration_update_command->list_of_plmns_to_be_used_in_disaster_condition);
-        ogs_assert(size >= 0);
-        encoded += size;
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_list_of_plmns_to_be_used_in_disaster_condition(&configuration_update_command->list_of_plmns_to_be_used_in_disaster_condition);
     }
 
     if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_EXTENDED_CAG_INFORMATION_LIST_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_EXTENDED_CAG_INFORMATION_LIST_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
-
-        size = ogs_nas_5gs_encode_extended_cag_information_list(pkbuf, &configuration_update_command->extended_cag_information_list);
-        ogs_assert(size >= 0);
-        encoded += size;
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_cag_information_list(&configuration_update_command->extended_cag_information_list);
     }
 
     if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_UPDATED_PEIPS_ASSISTANCE_INFORMATION_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_UPDATED_PEIPS_ASSISTANCE_INFORMATION_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
-
-        size = ogs_nas_5gs_encode_peips_assistance_information(pkbuf, &configuration_update_command->updated_peips_assistance_information);
-        ogs_assert(size >= 0);
-        encoded += size;
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_peips_assistance_information(&configuration_update_command->updated_peips_assistance_information);
     }
 
     if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_NSAG_INFORMATION_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_NSAG_INFORMATION_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
-
-        size = ogs_nas_5gs_encode_nsag_information(pkbuf, &configuration_update_command->nsag_information);
-        ogs_assert(size >= 0);
-        encoded += size;
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_nsag_information(&configuration_update_command->nsag_information);
     }
 
     if (configuration_update_command->presencemask & OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_PRIORITY_INDICATOR_PRESENT) {
-        configuration_update_command->priority_indicator.type = (OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND_PRIORITY_INDICATOR_TYPE >> 4);
-
-        size = ogs_nas_5gs_encode_priority_indicator(pkbuf, &configuration_update_command->priority_indicator);
-        ogs_assert(size >= 0);
-        encoded += size;
+        length += ogs_nas_5gs_length_priority_indicator(&configuration_update_command->priority_indicator);
     }
 
-    return encoded;
+    return length;
 }
 
 int ogs_nas_5gs_encode_authentication_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
@@ -1930,6 +2896,32 @@ int ogs_nas_5gs_encode_authentication_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_me
     return encoded;
 }
 
+int ogs_nas_5gs_length_authentication_request(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_authentication_request_t *authentication_request = &message->gmm.authentication_request;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_key_set_identifier(&authentication_request->ngksi);
+    length += ogs_nas_5gs_length_abba(&authentication_request->abba);
+
+    if (authentication_request->presencemask & OGS_NAS_5GS_AUTHENTICATION_REQUEST_AUTHENTICATION_PARAMETER_RAND_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_authentication_parameter_rand(&authentication_request->authentication_parameter_rand);
+    }
+
+    if (authentication_request->presencemask & OGS_NAS_5GS_AUTHENTICATION_REQUEST_AUTHENTICATION_PARAMETER_AUTN_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_authentication_parameter_autn(&authentication_request->authentication_parameter_autn);
+    }
+
+    if (authentication_request->presencemask & OGS_NAS_5GS_AUTHENTICATION_REQUEST_EAP_MESSAGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eap_message(&authentication_request->eap_message);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_authentication_response(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_authentication_response_t *authentication_response = &message->gmm.authentication_response;
@@ -1961,6 +2953,24 @@ int ogs_nas_5gs_encode_authentication_response(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_m
     return encoded;
 }
 
+int ogs_nas_5gs_length_authentication_response(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_authentication_response_t *authentication_response = &message->gmm.authentication_response;
+    int length = 0;
+
+    if (authentication_response->presencemask & OGS_NAS_5GS_AUTHENTICATION_RESPONSE_AUTHENTICATION_RESPONSE_PARAMETER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_authentication_response_parameter(&authentication_response->authentication_response_parameter);
+    }
+
+    if (authentication_response->presencemask & OGS_NAS_5GS_AUTHENTICATION_RESPONSE_EAP_MESSAGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eap_message(&authentication_response->eap_message);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_authentication_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_authentication_reject_t *authentication_reject = &message->gmm.authentication_reject;
@@ -1982,6 +2992,19 @@ int ogs_nas_5gs_encode_authentication_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_mes
     return encoded;
 }
 
+int ogs_nas_5gs_length_authentication_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_authentication_reject_t *authentication_reject = &message->gmm.authentication_reject;
+    int length = 0;
+
+    if (authentication_reject->presencemask & OGS_NAS_5GS_AUTHENTICATION_REJECT_EAP_MESSAGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eap_message(&authentication_reject->eap_message);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_authentication_failure(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_authentication_failure_t *authentication_failure = &message->gmm.authentication_failure;
@@ -2007,6 +3030,21 @@ int ogs_nas_5gs_encode_authentication_failure(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_me
     return encoded;
 }
 
+int ogs_nas_5gs_length_authentication_failure(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_authentication_failure_t *authentication_failure = &message->gmm.authentication_failure;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_5gmm_cause(&authentication_failure->gmm_cause);
+
+    if (authentication_failure->presencemask & OGS_NAS_5GS_AUTHENTICATION_FAILURE_AUTHENTICATION_FAILURE_PARAMETER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_authentication_failure_parameter(&authentication_failure->authentication_failure_parameter);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_authentication_result(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_authentication_result_t *authentication_result = &message->gmm.authentication_result;
@@ -2036,6 +3074,22 @@ int ogs_nas_5gs_encode_authentication_result(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_mes
     return encoded;
 }
 
+int ogs_nas_5gs_length_authentication_result(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_authentication_result_t *authentication_result = &message->gmm.authentication_result;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_key_set_identifier(&authentication_result->ngksi);
+    length += ogs_nas_5gs_length_eap_message(&authentication_result->eap_message);
+
+    if (authentication_result->presencemask & OGS_NAS_5GS_AUTHENTICATION_RESULT_ABBA_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_abba(&authentication_result->abba);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_identity_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_identity_request_t *identity_request = &message->gmm.identity_request;
@@ -2051,6 +3105,16 @@ int ogs_nas_5gs_encode_identity_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_
     return encoded;
 }
 
+int ogs_nas_5gs_length_identity_request(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_identity_request_t *identity_request = &message->gmm.identity_request;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_5gs_identity_type(&identity_request->identity_type);
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_identity_response(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_identity_response_t *identity_response = &message->gmm.identity_response;
@@ -2066,6 +3130,16 @@ int ogs_nas_5gs_encode_identity_response(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message
     return encoded;
 }
 
+int ogs_nas_5gs_length_identity_response(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_identity_response_t *identity_response = &message->gmm.identity_response;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_5gs_mobile_identity(&identity_response->mobile_identity);
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_security_mode_command(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_security_mode_command_t *security_mode_command = &message->gmm.security_mode_command;
@@ -2147,6 +3221,47 @@ int ogs_nas_5gs_encode_security_mode_command(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_mes
     return encoded;
 }
 
+int ogs_nas_5gs_length_security_mode_command(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_security_mode_command_t *security_mode_command = &message->gmm.security_mode_command;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_security_algorithms(&security_mode_command->selected_nas_security_algorithms);
+    length += ogs_nas_5gs_length_key_set_identifier(&security_mode_command->ngksi);
+    length += ogs_nas_5gs_length_ue_security_capability(&security_mode_command->replayed_ue_security_capabilities);
+
+    if (security_mode_command->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMMAND_IMEISV_REQUEST_PRESENT) {
+        length += ogs_nas_5gs_length_imeisv_request(&security_mode_command->imeisv_request);
+    }
+
+    if (security_mode_command->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMMAND_SELECTED_EPS_NAS_SECURITY_ALGORITHMS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eps_nas_security_algorithms(&security_mode_command->selected_eps_nas_security_algorithms);
+    }
+
+    if (security_mode_command->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMMAND_ADDITIONAL_5G_SECURITY_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_additional_5g_security_information(&security_mode_command->additional_security_information);
+    }
+
+    if (security_mode_command->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMMAND_EAP_MESSAGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eap_message(&security_mode_command->eap_message);
+    }
+
+    if (security_mode_command->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMMAND_ABBA_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_abba(&security_mode_command->abba);
+    }
+
+    if (security_mode_command->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMMAND_REPLAYED_S1_UE_SECURITY_CAPABILITIES_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_s1_ue_security_capability(&security_mode_command->replayed_s1_ue_security_capabilities);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_security_mode_complete(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_security_mode_complete_t *security_mode_complete = &message->gmm.security_mode_complete;
@@ -2188,6 +3303,29 @@ int ogs_nas_5gs_encode_security_mode_complete(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_me
     return encoded;
 }
 
+int ogs_nas_5gs_length_security_mode_complete(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_security_mode_complete_t *security_mode_complete = &message->gmm.security_mode_complete;
+    int length = 0;
+
+    if (security_mode_complete->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMPLETE_IMEISV_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_mobile_identity(&security_mode_complete->imeisv);
+    }
+
+    if (security_mode_complete->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMPLETE_NAS_MESSAGE_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_message_container(&security_mode_complete->nas_message_container);
+    }
+
+    if (security_mode_complete->presencemask & OGS_NAS_5GS_SECURITY_MODE_COMPLETE_NON_IMEISV_PEI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gs_mobile_identity(&security_mode_complete->non_imeisv_pei);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_security_mode_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_security_mode_reject_t *security_mode_reject = &message->gmm.security_mode_reject;
@@ -2203,6 +3341,16 @@ int ogs_nas_5gs_encode_security_mode_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_mess
     return encoded;
 }
 
+int ogs_nas_5gs_length_security_mode_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_security_mode_reject_t *security_mode_reject = &message->gmm.security_mode_reject;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_5gmm_cause(&security_mode_reject->gmm_cause);
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_5gmm_status(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_5gmm_status_t *gmm_status = &message->gmm.gmm_status;
@@ -2218,6 +3366,16 @@ int ogs_nas_5gs_encode_5gmm_status(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *me
     return encoded;
 }
 
+int ogs_nas_5gs_length_5gmm_status(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_5gmm_status_t *gmm_status = &message->gmm.gmm_status;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_5gmm_cause(&gmm_status->gmm_cause);
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_notification(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_notification_t *notification = &message->gmm.notification;
@@ -2233,6 +3391,16 @@ int ogs_nas_5gs_encode_notification(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *m
     return encoded;
 }
 
+int ogs_nas_5gs_length_notification(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_notification_t *notification = &message->gmm.notification;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_access_type(&notification->access_type);
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_notification_response(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_notification_response_t *notification_response = &message->gmm.notification_response;
@@ -2254,6 +3422,19 @@ int ogs_nas_5gs_encode_notification_response(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_mes
     return encoded;
 }
 
+int ogs_nas_5gs_length_notification_response(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_notification_response_t *notification_response = &message->gmm.notification_response;
+    int length = 0;
+
+    if (notification_response->presencemask & OGS_NAS_5GS_NOTIFICATION_RESPONSE_PDU_SESSION_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_session_status(&notification_response->pdu_session_status);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_ul_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_ul_nas_transport_t *ul_nas_transport = &message->gmm.ul_nas_transport;
@@ -2347,6 +3528,54 @@ int ogs_nas_5gs_encode_ul_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_
     return encoded;
 }
 
+int ogs_nas_5gs_length_ul_nas_transport(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_ul_nas_transport_t *ul_nas_transport = &message->gmm.ul_nas_transport;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_payload_container_type(&ul_nas_transport->payload_container_type);
+    length += ogs_nas_5gs_length_payload_container(&ul_nas_transport->payload_container);
+
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_PDU_SESSION_ID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_session_identity_2(&ul_nas_transport->pdu_session_id);
+    }
+
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_OLD_PDU_SESSION_ID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_session_identity_2(&ul_nas_transport->old_pdu_session_id);
+    }
+
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_REQUEST_TYPE_PRESENT) {
+        length += ogs_nas_5gs_length_request_type(&ul_nas_transport->request_type);
+    }
+
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_S_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_s_nssai(&ul_nas_transport->s_nssai);
+    }
+
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_DNN_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_dnn(&ul_nas_transport->dnn);
+    }
+
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_ADDITIONAL_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_additional_information(&ul_nas_transport->additional_information);
+    }
+
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_MA_PDU_SESSION_INFORMATION_PRESENT) {
+        length += ogs_nas_5gs_length_ma_pdu_session_information(&ul_nas_transport->ma_pdu_session_information);
+    }
+
+    if (ul_nas_transport->presencemask & OGS_NAS_5GS_UL_NAS_TRANSPORT_RELEASE_ASSISTANCE_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_release_assistance_indication(&ul_nas_transport->release_assistance_indication);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_dl_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_dl_nas_transport_t *dl_nas_transport = &message->gmm.dl_nas_transport;
@@ -2394,26 +3623,62 @@ int ogs_nas_5gs_encode_dl_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_
     }
 
     if (dl_nas_transport->presencemask & OGS_NAS_5GS_DL_NAS_TRANSPORT_BACK_OFF_TIMER_VALUE_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_DL_NAS_TRANSPORT_BACK_OFF_TIMER_VALUE_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
-
-        size = ogs_nas_5gs_encode_gprs_timer_3(pkbuf, &dl_nas_transport->back_off_timer_value);
-        ogs_assert(size >= 0);
-        encoded += size;
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_DL_NAS_TRANSPORT_BACK_OFF_TIMER_VALUE_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_gprs_timer_3(pkbuf, &dl_nas_transport->back_off_timer_value);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (dl_nas_transport->presencemask & OGS_NAS_5GS_DL_NAS_TRANSPORT_LOWER_BOUND_TIMER_VALUE_PRESENT) {
+        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_DL_NAS_TRANSPORT_LOWER_BOUND_TIMER_VALUE_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_5gs_encode_gprs_timer_3(pkbuf, &dl_nas_transport->lower_bound_timer_value);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    return encoded;
+}
+
+int ogs_nas_5gs_length_dl_nas_transport(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_dl_nas_transport_t *dl_nas_transport = &message->gmm.dl_nas_transport;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_payload_container_type(&dl_nas_transport->payload_container_type);
+    length += ogs_nas_5gs_length_payload_container(&dl_nas_transport->payload_container);
+
+    if (dl_nas_transport->presencemask & OGS_NAS_5GS_DL_NAS_TRANSPORT_PDU_SESSION_ID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_session_identity_2(&dl_nas_transport->pdu_session_id);
+    }
+
+    if (dl_nas_transport->presencemask & OGS_NAS_5GS_DL_NAS_TRANSPORT_ADDITIONAL_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_additional_information(&dl_nas_transport->additional_information);
+    }
+
+    if (dl_nas_transport->presencemask & OGS_NAS_5GS_DL_NAS_TRANSPORT_5GMM_CAUSE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gmm_cause(&dl_nas_transport->gmm_cause);
+    }
+
+    if (dl_nas_transport->presencemask & OGS_NAS_5GS_DL_NAS_TRANSPORT_BACK_OFF_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_3(&dl_nas_transport->back_off_timer_value);
     }
 
     if (dl_nas_transport->presencemask & OGS_NAS_5GS_DL_NAS_TRANSPORT_LOWER_BOUND_TIMER_VALUE_PRESENT) {
-        size = ogs_nas_5gs_encode_optional_type(pkbuf, OGS_NAS_5GS_DL_NAS_TRANSPORT_LOWER_BOUND_TIMER_VALUE_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
-
-        size = ogs_nas_5gs_encode_gprs_timer_3(pkbuf, &dl_nas_transport->lower_bound_timer_value);
-        ogs_assert(size >= 0);
-        encoded += size;
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_3(&dl_nas_transport->lower_bound_timer_value);
     }
 
-    return encoded;
+    return length;
 }
 
 int ogs_nas_5gs_encode_pdu_session_establishment_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
@@ -2595,6 +3860,98 @@ int ogs_nas_5gs_encode_pdu_session_establishment_request(ogs_pkbuf_t *pkbuf, ogs
     return encoded;
 }
 
+int ogs_nas_5gs_length_pdu_session_establishment_request(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_establishment_request_t *pdu_session_establishment_request = &message->gsm.pdu_session_establishment_request;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_integrity_protection_maximum_data_rate(&pdu_session_establishment_request->integrity_protection_maximum_data_rate);
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_PDU_SESSION_TYPE_PRESENT) {
+        length += ogs_nas_5gs_length_pdu_session_type(&pdu_session_establishment_request->pdu_session_type);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_SSC_MODE_PRESENT) {
+        length += ogs_nas_5gs_length_ssc_mode(&pdu_session_establishment_request->ssc_mode);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_5GSM_CAPABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gsm_capability(&pdu_session_establishment_request->gsm_capability);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_MAXIMUM_NUMBER_OF_SUPPORTED_PACKET_FILTERS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_maximum_number_of_supported_packet_filters(&pdu_session_establishment_request->maximum_number_of_supported_packet_filters);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_ALWAYS_ON_PDU_SESSION_REQUESTED_PRESENT) {
+        length += ogs_nas_5gs_length_always_on_pdu_session_requested(&pdu_session_establishment_request->always_on_pdu_session_requested);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_SM_PDU_DN_REQUEST_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_sm_pdu_dn_request_container(&pdu_session_establishment_request->sm_pdu_dn_request_container);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_establishment_request->extended_protocol_configuration_options);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_IP_HEADER_COMPRESSION_CONFIGURATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ip_header_compression_configuration(&pdu_session_establishment_request->ip_header_compression_configuration);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_DS_TT_ETHERNET_PORT_MAC_ADDRESS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ds_tt_ethernet_port_mac_address(&pdu_session_establishment_request->ds_tt_ethernet_port_mac_address);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_UE_DS_TT_RESIDENCE_TIME_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ue_ds_tt_residence_time(&pdu_session_establishment_request->ue_ds_tt_residence_time);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_PORT_MANAGEMENT_INFORMATION_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_port_management_information_container(&pdu_session_establishment_request->port_management_information_container);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_ETHERNET_HEADER_COMPRESSION_CONFIGURATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ethernet_header_compression_configuration(&pdu_session_establishment_request->ethernet_header_compression_configuration);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_SUGGESTED_INTERFACE_IDENTIFIER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_address(&pdu_session_establishment_request->suggested_interface_identifier);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_SERVICE_LEVEL_AA_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_service_level_aa_container(&pdu_session_establishment_request->service_level_aa_container);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_REQUESTED_MBS_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_requested_mbs_container(&pdu_session_establishment_request->requested_mbs_container);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_PDU_SESSION_PAIR_ID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_session_pair_id(&pdu_session_establishment_request->pdu_session_pair_id);
+    }
+
+    if (pdu_session_establishment_request->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST_RSN_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_rsn(&pdu_session_establishment_request->rsn);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_pdu_session_establishment_accept(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_pdu_session_establishment_accept_t *pdu_session_establishment_accept = &message->gsm.pdu_session_establishment_accept;
@@ -2794,6 +4151,106 @@ int ogs_nas_5gs_encode_pdu_session_establishment_accept(ogs_pkbuf_t *pkbuf, ogs_
     return encoded;
 }
 
+int ogs_nas_5gs_length_pdu_session_establishment_accept(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_establishment_accept_t *pdu_session_establishment_accept = &message->gsm.pdu_session_establishment_accept;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_pdu_session_type(&pdu_session_establishment_accept->selected_pdu_session_type);
+    length += ogs_nas_5gs_length_qos_rules(&pdu_session_establishment_accept->authorized_qos_rules);
+    length += ogs_nas_5gs_length_session_ambr(&pdu_session_establishment_accept->session_ambr);
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_5GSM_CAUSE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gsm_cause(&pdu_session_establishment_accept->gsm_cause);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_PDU_ADDRESS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_pdu_address(&pdu_session_establishment_accept->pdu_address);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_RQ_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer(&pdu_session_establishment_accept->rq_timer_value);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_S_NSSAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_s_nssai(&pdu_session_establishment_accept->s_nssai);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_ALWAYS_ON_PDU_SESSION_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_always_on_pdu_session_indication(&pdu_session_establishment_accept->always_on_pdu_session_indication);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_MAPPED_EPS_BEARER_CONTEXTS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_mapped_eps_bearer_contexts(&pdu_session_establishment_accept->mapped_eps_bearer_contexts);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_EAP_MESSAGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eap_message(&pdu_session_establishment_accept->eap_message);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_AUTHORIZED_QOS_FLOW_DESCRIPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_qos_flow_descriptions(&pdu_session_establishment_accept->authorized_qos_flow_descriptions);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_establishment_accept->extended_protocol_configuration_options);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_DNN_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_dnn(&pdu_session_establishment_accept->dnn);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_5GSM_NETWORK_FEATURE_SUPPORT_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gsm_network_feature_support(&pdu_session_establishment_accept->gsm_network_feature_support);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_SERVING_PLMN_RATE_CONTROL_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_serving_plmn_rate_control(&pdu_session_establishment_accept->serving_plmn_rate_control);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_ATSSS_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_atsss_container(&pdu_session_establishment_accept->atsss_container);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_CONTROL_PLANE_ONLY_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_control_plane_only_indication(&pdu_session_establishment_accept->control_plane_only_indication);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_IP_HEADER_COMPRESSION_CONFIGURATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ip_header_compression_configuration(&pdu_session_establishment_accept->ip_header_compression_configuration);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_ETHERNET_HEADER_COMPRESSION_CONFIGURATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ethernet_header_compression_configuration(&pdu_session_establishment_accept->ethernet_header_compression_configuration);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_SERVICE_LEVEL_AA_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_service_level_aa_container(&pdu_session_establishment_accept->service_level_aa_container);
+    }
+
+    if (pdu_session_establishment_accept->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT_RECEIVED_MBS_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_received_mbs_container(&pdu_session_establishment_accept->received_mbs_container);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_pdu_session_establishment_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_pdu_session_establishment_reject_t *pdu_session_establishment_reject = &message->gsm.pdu_session_establishment_reject;
@@ -2877,6 +4334,50 @@ int ogs_nas_5gs_encode_pdu_session_establishment_reject(ogs_pkbuf_t *pkbuf, ogs_
     return encoded;
 }
 
+int ogs_nas_5gs_length_pdu_session_establishment_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_establishment_reject_t *pdu_session_establishment_reject = &message->gsm.pdu_session_establishment_reject;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_5gsm_cause(&pdu_session_establishment_reject->gsm_cause);
+
+    if (pdu_session_establishment_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT_BACK_OFF_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_3(&pdu_session_establishment_reject->back_off_timer_value);
+    }
+
+    if (pdu_session_establishment_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT_ALLOWED_SSC_MODE_PRESENT) {
+        length += ogs_nas_5gs_length_allowed_ssc_mode(&pdu_session_establishment_reject->allowed_ssc_mode);
+    }
+
+    if (pdu_session_establishment_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT_EAP_MESSAGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eap_message(&pdu_session_establishment_reject->eap_message);
+    }
+
+    if (pdu_session_establishment_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT_5GSM_CONGESTION_RE_ATTEMPT_INDICATOR_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gsm_congestion_re_attempt_indicator(&pdu_session_establishment_reject->gsm_congestion_re_attempt_indicator);
+    }
+
+    if (pdu_session_establishment_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_establishment_reject->extended_protocol_configuration_options);
+    }
+
+    if (pdu_session_establishment_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT_RE_ATTEMPT_INDICATOR_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_re_attempt_indicator(&pdu_session_establishment_reject->re_attempt_indicator);
+    }
+
+    if (pdu_session_establishment_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT_SERVICE_LEVEL_AA_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_service_level_aa_container(&pdu_session_establishment_reject->service_level_aa_container);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_pdu_session_authentication_command(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_pdu_session_authentication_command_t *pdu_session_authentication_command = &message->gsm.pdu_session_authentication_command;
@@ -2902,6 +4403,21 @@ int ogs_nas_5gs_encode_pdu_session_authentication_command(ogs_pkbuf_t *pkbuf, og
     return encoded;
 }
 
+int ogs_nas_5gs_length_pdu_session_authentication_command(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_authentication_command_t *pdu_session_authentication_command = &message->gsm.pdu_session_authentication_command;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_eap_message(&pdu_session_authentication_command->eap_message);
+
+    if (pdu_session_authentication_command->presencemask & OGS_NAS_5GS_PDU_SESSION_AUTHENTICATION_COMMAND_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_authentication_command->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_pdu_session_authentication_complete(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_pdu_session_authentication_complete_t *pdu_session_authentication_complete = &message->gsm.pdu_session_authentication_complete;
@@ -2927,6 +4443,21 @@ int ogs_nas_5gs_encode_pdu_session_authentication_complete(ogs_pkbuf_t *pkbuf, o
     return encoded;
 }
 
+int ogs_nas_5gs_length_pdu_session_authentication_complete(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_authentication_complete_t *pdu_session_authentication_complete = &message->gsm.pdu_session_authentication_complete;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_eap_message(&pdu_session_authentication_complete->eap_message);
+
+    if (pdu_session_authentication_complete->presencemask & OGS_NAS_5GS_PDU_SESSION_AUTHENTICATION_COMPLETE_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_authentication_complete->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_pdu_session_authentication_result(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_pdu_session_authentication_result_t *pdu_session_authentication_result = &message->gsm.pdu_session_authentication_result;
@@ -2958,6 +4489,24 @@ int ogs_nas_5gs_encode_pdu_session_authentication_result(ogs_pkbuf_t *pkbuf, ogs
     return encoded;
 }
 
+int ogs_nas_5gs_length_pdu_session_authentication_result(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_authentication_result_t *pdu_session_authentication_result = &message->gsm.pdu_session_authentication_result;
+    int length = 0;
+
+    if (pdu_session_authentication_result->presencemask & OGS_NAS_5GS_PDU_SESSION_AUTHENTICATION_RESULT_EAP_MESSAGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eap_message(&pdu_session_authentication_result->eap_message);
+    }
+
+    if (pdu_session_authentication_result->presencemask & OGS_NAS_5GS_PDU_SESSION_AUTHENTICATION_RESULT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_authentication_result->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_pdu_session_modification_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_pdu_session_modification_request_t *pdu_session_modification_request = &message->gsm.pdu_session_modification_request;
@@ -3107,6 +4656,83 @@ int ogs_nas_5gs_encode_pdu_session_modification_request(ogs_pkbuf_t *pkbuf, ogs_
     return encoded;
 }
 
+int ogs_nas_5gs_length_pdu_session_modification_request(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_modification_request_t *pdu_session_modification_request = &message->gsm.pdu_session_modification_request;
+    int length = 0;
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_5GSM_CAPABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gsm_capability(&pdu_session_modification_request->gsm_capability);
+    }
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_5GSM_CAUSE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gsm_cause(&pdu_session_modification_request->gsm_cause);
+    }
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_MAXIMUM_NUMBER_OF_SUPPORTED_PACKET_FILTERS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_maximum_number_of_supported_packet_filters(&pdu_session_modification_request->maximum_number_of_supported_packet_filters);
+    }
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_ALWAYS_ON_PDU_SESSION_REQUESTED_PRESENT) {
+        length += ogs_nas_5gs_length_always_on_pdu_session_requested(&pdu_session_modification_request->always_on_pdu_session_requested);
+    }
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_INTEGRITY_PROTECTION_MAXIMUM_DATA_RATE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_integrity_protection_maximum_data_rate(&pdu_session_modification_request->integrity_protection_maximum_data_rate);
+    }
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_REQUESTED_QOS_RULES_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_qos_rules(&pdu_session_modification_request->requested_qos_rules);
+    }
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_REQUESTED_QOS_FLOW_DESCRIPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_qos_flow_descriptions(&pdu_session_modification_request->requested_qos_flow_descriptions);
+    }
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_MAPPED_EPS_BEARER_CONTEXTS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_mapped_eps_bearer_contexts(&pdu_session_modification_request->mapped_eps_bearer_contexts);
+    }
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_modification_request->extended_protocol_configuration_options);
+    }
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_PORT_MANAGEMENT_INFORMATION_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_port_management_information_container(&pdu_session_modification_request->port_management_information_container);
+    }
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_IP_HEADER_COMPRESSION_CONFIGURATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_header_compression_configuration(&pdu_session_modification_request->ip_header_compression_configuration);
+    }
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_ETHERNET_HEADER_COMPRESSION_CONFIGURATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ethernet_header_compression_configuration(&pdu_session_modification_request->ethernet_header_compression_configuration);
+    }
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_REQUESTED_MBS_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_requested_mbs_container(&pdu_session_modification_request->requested_mbs_container);
+    }
+
+    if (pdu_session_modification_request->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST_SERVICE_LEVEL_AA_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_service_level_aa_container(&pdu_session_modification_request->service_level_aa_container);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_pdu_session_modification_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_pdu_session_modification_reject_t *pdu_session_modification_reject = &message->gsm.pdu_session_modification_reject;
@@ -3154,12 +4780,42 @@ int ogs_nas_5gs_encode_pdu_session_modification_reject(ogs_pkbuf_t *pkbuf, ogs_n
         ogs_assert(size >= 0);
         encoded += size;
 
-        size = ogs_nas_5gs_encode_re_attempt_indicator(pkbuf, &pdu_session_modification_reject->re_attempt_indicator);
-        ogs_assert(size >= 0);
-        encoded += size;
+        size = ogs_nas_5gs_encode_re_attempt_indicator(pkbuf, &pdu_session_modification_reject->re_attempt_indicator);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    return encoded;
+}
+
+int ogs_nas_5gs_length_pdu_session_modification_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_modification_reject_t *pdu_session_modification_reject = &message->gsm.pdu_session_modification_reject;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_5gsm_cause(&pdu_session_modification_reject->gsm_cause);
+
+    if (pdu_session_modification_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REJECT_BACK_OFF_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_3(&pdu_session_modification_reject->back_off_timer_value);
+    }
+
+    if (pdu_session_modification_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REJECT_5GSM_CONGESTION_RE_ATTEMPT_INDICATOR_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gsm_congestion_re_attempt_indicator(&pdu_session_modification_reject->gsm_congestion_re_attempt_indicator);
+    }
+
+    if (pdu_session_modification_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_modification_reject->extended_protocol_configuration_options);
+    }
+
+    if (pdu_session_modification_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REJECT_RE_ATTEMPT_INDICATOR_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_re_attempt_indicator(&pdu_session_modification_reject->re_attempt_indicator);
     }
 
-    return encoded;
+    return length;
 }
 
 int ogs_nas_5gs_encode_pdu_session_modification_command(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
@@ -3321,6 +4977,88 @@ int ogs_nas_5gs_encode_pdu_session_modification_command(ogs_pkbuf_t *pkbuf, ogs_
     return encoded;
 }
 
+int ogs_nas_5gs_length_pdu_session_modification_command(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_modification_command_t *pdu_session_modification_command = &message->gsm.pdu_session_modification_command;
+    int length = 0;
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_5GSM_CAUSE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gsm_cause(&pdu_session_modification_command->gsm_cause);
+    }
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_SESSION_AMBR_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_session_ambr(&pdu_session_modification_command->session_ambr);
+    }
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_RQ_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer(&pdu_session_modification_command->rq_timer_value);
+    }
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_ALWAYS_ON_PDU_SESSION_INDICATION_PRESENT) {
+        length += ogs_nas_5gs_length_always_on_pdu_session_indication(&pdu_session_modification_command->always_on_pdu_session_indication);
+    }
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_AUTHORIZED_QOS_RULES_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_qos_rules(&pdu_session_modification_command->authorized_qos_rules);
+    }
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_MAPPED_EPS_BEARER_CONTEXTS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_mapped_eps_bearer_contexts(&pdu_session_modification_command->mapped_eps_bearer_contexts);
+    }
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_AUTHORIZED_QOS_FLOW_DESCRIPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_qos_flow_descriptions(&pdu_session_modification_command->authorized_qos_flow_descriptions);
+    }
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_modification_command->extended_protocol_configuration_options);
+    }
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_ATSSS_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_atsss_container(&pdu_session_modification_command->atsss_container);
+    }
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_IP_HEADER_COMPRESSION_CONFIGURATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ip_header_compression_configuration(&pdu_session_modification_command->ip_header_compression_configuration);
+    }
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_PORT_MANAGEMENT_INFORMATION_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_port_management_information_container(&pdu_session_modification_command->port_management_information_container);
+    }
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_SERVING_PLMN_RATE_CONTROL_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_serving_plmn_rate_control(&pdu_session_modification_command->serving_plmn_rate_control);
+    }
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_ETHERNET_HEADER_COMPRESSION_CONFIGURATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_ethernet_header_compression_configuration(&pdu_session_modification_command->ethernet_header_compression_configuration);
+    }
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_RECEIVED_MBS_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_received_mbs_container(&pdu_session_modification_command->received_mbs_container);
+    }
+
+    if (pdu_session_modification_command->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_SERVICE_LEVEL_AA_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_service_level_aa_container(&pdu_session_modification_command->service_level_aa_container);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_pdu_session_modification_complete(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_pdu_session_modification_complete_t *pdu_session_modification_complete = &message->gsm.pdu_session_modification_complete;
@@ -3352,6 +5090,24 @@ int ogs_nas_5gs_encode_pdu_session_modification_complete(ogs_pkbuf_t *pkbuf, ogs
     return encoded;
 }
 
+int ogs_nas_5gs_length_pdu_session_modification_complete(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_modification_complete_t *pdu_session_modification_complete = &message->gsm.pdu_session_modification_complete;
+    int length = 0;
+
+    if (pdu_session_modification_complete->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMPLETE_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_modification_complete->extended_protocol_configuration_options);
+    }
+
+    if (pdu_session_modification_complete->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMPLETE_PORT_MANAGEMENT_INFORMATION_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_port_management_information_container(&pdu_session_modification_complete->port_management_information_container);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_pdu_session_modification_command_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_pdu_session_modification_command_reject_t *pdu_session_modification_command_reject = &message->gsm.pdu_session_modification_command_reject;
@@ -3377,6 +5133,21 @@ int ogs_nas_5gs_encode_pdu_session_modification_command_reject(ogs_pkbuf_t *pkbu
     return encoded;
 }
 
+int ogs_nas_5gs_length_pdu_session_modification_command_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_modification_command_reject_t *pdu_session_modification_command_reject = &message->gsm.pdu_session_modification_command_reject;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_5gsm_cause(&pdu_session_modification_command_reject->gsm_cause);
+
+    if (pdu_session_modification_command_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_modification_command_reject->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_pdu_session_release_request(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_pdu_session_release_request_t *pdu_session_release_request = &message->gsm.pdu_session_release_request;
@@ -3408,6 +5179,24 @@ int ogs_nas_5gs_encode_pdu_session_release_request(ogs_pkbuf_t *pkbuf, ogs_nas_5
     return encoded;
 }
 
+int ogs_nas_5gs_length_pdu_session_release_request(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_release_request_t *pdu_session_release_request = &message->gsm.pdu_session_release_request;
+    int length = 0;
+
+    if (pdu_session_release_request->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_REQUEST_5GSM_CAUSE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gsm_cause(&pdu_session_release_request->gsm_cause);
+    }
+
+    if (pdu_session_release_request->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_release_request->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_pdu_session_release_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_pdu_session_release_reject_t *pdu_session_release_reject = &message->gsm.pdu_session_release_reject;
@@ -3433,6 +5222,21 @@ int ogs_nas_5gs_encode_pdu_session_release_reject(ogs_pkbuf_t *pkbuf, ogs_nas_5g
     return encoded;
 }
 
+int ogs_nas_5gs_length_pdu_session_release_reject(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_release_reject_t *pdu_session_release_reject = &message->gsm.pdu_session_release_reject;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_5gsm_cause(&pdu_session_release_reject->gsm_cause);
+
+    if (pdu_session_release_reject->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_release_reject->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_pdu_session_release_command(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_pdu_session_release_command_t *pdu_session_release_command = &message->gsm.pdu_session_release_command;
@@ -3506,6 +5310,45 @@ int ogs_nas_5gs_encode_pdu_session_release_command(ogs_pkbuf_t *pkbuf, ogs_nas_5
     return encoded;
 }
 
+int ogs_nas_5gs_length_pdu_session_release_command(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_release_command_t *pdu_session_release_command = &message->gsm.pdu_session_release_command;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_5gsm_cause(&pdu_session_release_command->gsm_cause);
+
+    if (pdu_session_release_command->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMMAND_BACK_OFF_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_gprs_timer_3(&pdu_session_release_command->back_off_timer_value);
+    }
+
+    if (pdu_session_release_command->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMMAND_EAP_MESSAGE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_eap_message(&pdu_session_release_command->eap_message);
+    }
+
+    if (pdu_session_release_command->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMMAND_5GSM_CONGESTION_RE_ATTEMPT_INDICATOR_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gsm_congestion_re_attempt_indicator(&pdu_session_release_command->gsm_congestion_re_attempt_indicator);
+    }
+
+    if (pdu_session_release_command->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMMAND_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_release_command->extended_protocol_configuration_options);
+    }
+
+    if (pdu_session_release_command->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMMAND_ACCESS_TYPE_PRESENT) {
+        length += ogs_nas_5gs_length_access_type(&pdu_session_release_command->access_type);
+    }
+
+    if (pdu_session_release_command->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMMAND_SERVICE_LEVEL_AA_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_service_level_aa_container(&pdu_session_release_command->service_level_aa_container);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_pdu_session_release_complete(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_pdu_session_release_complete_t *pdu_session_release_complete = &message->gsm.pdu_session_release_complete;
@@ -3537,6 +5380,24 @@ int ogs_nas_5gs_encode_pdu_session_release_complete(ogs_pkbuf_t *pkbuf, ogs_nas_
     return encoded;
 }
 
+int ogs_nas_5gs_length_pdu_session_release_complete(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_pdu_session_release_complete_t *pdu_session_release_complete = &message->gsm.pdu_session_release_complete;
+    int length = 0;
+
+    if (pdu_session_release_complete->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMPLETE_5GSM_CAUSE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_5gsm_cause(&pdu_session_release_complete->gsm_cause);
+    }
+
+    if (pdu_session_release_complete->presencemask & OGS_NAS_5GS_PDU_SESSION_RELEASE_COMPLETE_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_5gs_length_extended_protocol_configuration_options(&pdu_session_release_complete->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_5gs_encode_5gsm_status(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *message)
 {
     ogs_nas_5gs_5gsm_status_t *gsm_status = &message->gsm.gsm_status;
@@ -3552,23 +5413,199 @@ int ogs_nas_5gs_encode_5gsm_status(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_message_t *me
     return encoded;
 }
 
+int ogs_nas_5gs_length_5gsm_status(ogs_nas_5gs_message_t *message)
+{
+    ogs_nas_5gs_5gsm_status_t *gsm_status = &message->gsm.gsm_status;
+    int length = 0;
+
+    length += ogs_nas_5gs_length_5gsm_cause(&gsm_status->gsm_cause);
+
+    return length;
+}
+
+int ogs_nas_5gmm_length(ogs_nas_5gs_message_t *message)
+{
+    int length = sizeof(ogs_nas_5gmm_header_t);
+
+    ogs_assert(message);
+
+    switch(message->gmm.h.message_type) {
+    case OGS_NAS_5GS_REGISTRATION_REQUEST:
+        length += ogs_nas_5gs_length_registration_request(message);
+        break;
+    case OGS_NAS_5GS_REGISTRATION_ACCEPT:
+        length += ogs_nas_5gs_length_registration_accept(message);
+        break;
+    case OGS_NAS_5GS_REGISTRATION_COMPLETE:
+        length += ogs_nas_5gs_length_registration_complete(message);
+        break;
+    case OGS_NAS_5GS_REGISTRATION_REJECT:
+        length += ogs_nas_5gs_length_registration_reject(message);
+        break;
+    case OGS_NAS_5GS_DEREGISTRATION_REQUEST_FROM_UE:
+        length += ogs_nas_5gs_length_deregistration_request_from_ue(message);
+        break;
+    case OGS_NAS_5GS_DEREGISTRATION_ACCEPT_FROM_UE:
+        break;
+    case OGS_NAS_5GS_DEREGISTRATION_REQUEST_TO_UE:
+        length += ogs_nas_5gs_length_deregistration_request_to_ue(message);
+        break;
+    case OGS_NAS_5GS_DEREGISTRATION_ACCEPT_TO_UE:
+        break;
+    case OGS_NAS_5GS_SERVICE_REQUEST:
+        length += ogs_nas_5gs_length_service_request(message);
+        break;
+    case OGS_NAS_5GS_SERVICE_REJECT:
+        length += ogs_nas_5gs_length_service_reject(message);
+        break;
+    case OGS_NAS_5GS_SERVICE_ACCEPT:
+        length += ogs_nas_5gs_length_service_accept(message);
+        break;
+    case OGS_NAS_5GS_CONFIGURATION_UPDATE_COMMAND:
+        length += ogs_nas_5gs_length_configuration_update_command(message);
+        break;
+    case OGS_NAS_5GS_CONFIGURATION_UPDATE_COMPLETE:
+        break;
+    case OGS_NAS_5GS_AUTHENTICATION_REQUEST:
+        length += ogs_nas_5gs_length_authentication_request(message);
+        break;
+    case OGS_NAS_5GS_AUTHENTICATION_RESPONSE:
+        length += ogs_nas_5gs_length_authentication_response(message);
+        break;
+    case OGS_NAS_5GS_AUTHENTICATION_REJECT:
+        length += ogs_nas_5gs_length_authentication_reject(message);
+        break;
+    case OGS_NAS_5GS_AUTHENTICATION_FAILURE:
+        length += ogs_nas_5gs_length_authentication_failure(message);
+        break;
+    case OGS_NAS_5GS_AUTHENTICATION_RESULT:
+        length += ogs_nas_5gs_length_authentication_result(message);
+        break;
+    case OGS_NAS_5GS_IDENTITY_REQUEST:
+        length += ogs_nas_5gs_length_identity_request(message);
+        break;
+    case OGS_NAS_5GS_IDENTITY_RESPONSE:
+        length += ogs_nas_5gs_length_identity_response(message);
+        break;
+    case OGS_NAS_5GS_SECURITY_MODE_COMMAND:
+        length += ogs_nas_5gs_length_security_mode_command(message);
+        break;
+    case OGS_NAS_5GS_SECURITY_MODE_COMPLETE:
+        length += ogs_nas_5gs_length_security_mode_complete(message);
+        break;
+    case OGS_NAS_5GS_SECURITY_MODE_REJECT:
+        length += ogs_nas_5gs_length_security_mode_reject(message);
+        break;
+    case OGS_NAS_5GS_5GMM_STATUS:
+        length += ogs_nas_5gs_length_5gmm_status(message);
+        break;
+    case OGS_NAS_5GS_NOTIFICATION:
+        length += ogs_nas_5gs_length_notification(message);
+        break;
+    case OGS_NAS_5GS_NOTIFICATION_RESPONSE:
+        length += ogs_nas_5gs_length_notification_response(message);
+        break;
+    case OGS_NAS_5GS_UL_NAS_TRANSPORT:
+        length += ogs_nas_5gs_length_ul_nas_transport(message);
+        break;
+    case OGS_NAS_5GS_DL_NAS_TRANSPORT:
+        length += ogs_nas_5gs_length_dl_nas_transport(message);
+        break;
+    default:
+        return -1;
+    }
+
+    return length;
+}
+
+int ogs_nas_5gsm_length(ogs_nas_5gs_message_t *message)
+{
+    int length = sizeof(ogs_nas_5gsm_header_t);
+
+    ogs_assert(message);
+
+    switch(message->gsm.h.message_type) {
+    case OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REQUEST:
+        length += ogs_nas_5gs_length_pdu_session_establishment_request(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_ACCEPT:
+        length += ogs_nas_5gs_length_pdu_session_establishment_accept(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_ESTABLISHMENT_REJECT:
+        length += ogs_nas_5gs_length_pdu_session_establishment_reject(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_AUTHENTICATION_COMMAND:
+        length += ogs_nas_5gs_length_pdu_session_authentication_command(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_AUTHENTICATION_COMPLETE:
+        length += ogs_nas_5gs_length_pdu_session_authentication_complete(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_AUTHENTICATION_RESULT:
+        length += ogs_nas_5gs_length_pdu_session_authentication_result(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REQUEST:
+        length += ogs_nas_5gs_length_pdu_session_modification_request(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_MODIFICATION_REJECT:
+        length += ogs_nas_5gs_length_pdu_session_modification_reject(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND:
+        length += ogs_nas_5gs_length_pdu_session_modification_command(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMPLETE:
+        length += ogs_nas_5gs_length_pdu_session_modification_complete(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_MODIFICATION_COMMAND_REJECT:
+        length += ogs_nas_5gs_length_pdu_session_modification_command_reject(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_RELEASE_REQUEST:
+        length += ogs_nas_5gs_length_pdu_session_release_request(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_RELEASE_REJECT:
+        length += ogs_nas_5gs_length_pdu_session_release_reject(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_RELEASE_COMMAND:
+        length += ogs_nas_5gs_length_pdu_session_release_command(message);
+        break;
+    case OGS_NAS_5GS_PDU_SESSION_RELEASE_COMPLETE:
+        length += ogs_nas_5gs_length_pdu_session_release_complete(message);
+        break;
+    case OGS_NAS_5GS_5GSM_STATUS:
+        length += ogs_nas_5gs_length_5gsm_status(message);
+        break;
+    default:
+        return -1;
+    }
+
+    return length;
+}
+
 ogs_pkbuf_t *ogs_nas_5gmm_encode(ogs_nas_5gs_message_t *message)
 {
     ogs_pkbuf_t *pkbuf = NULL;
     int size = 0;
     int encoded = 0;
+    int length = 0;
 
     ogs_assert(message);
 
+    length = ogs_nas_5gmm_length(message);
+    if (length < 0) {
+        ogs_error("Unknown message type (0x%x) or not implemented", 
+                message->gmm.h.message_type);
+        return NULL;
+    }
+
     /* The Packet Buffer(ogs_pkbuf_t) for NAS message MUST make a HEADROOM. 
-     * When calculating AES_CMAC, we need to use the headroom of the packet. */
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+     * When calculating AES_CMAC, we need to use the headroom of the packet.
+     * The length is known up front; OGS_NAS_SLACK only guards it. */
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+length+OGS_NAS_SLACK);
     if (!pkbuf) {
         ogs_error("ogs_pkbuf_alloc() failed");
         return NULL;
     }
     ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN-OGS_NAS_HEADROOM);
+    ogs_pkbuf_put(pkbuf, length+OGS_NAS_SLACK);
 
     size = sizeof(ogs_nas_5gmm_header_t);
     ogs_assert(ogs_pkbuf_pull(pkbuf, size));
@@ -3715,6 +5752,8 @@ ogs_pkbuf_t *ogs_nas_5gmm_encode(ogs_nas_5gs_message_t *message)
         return NULL;
     }
 
+    if (encoded != length)
+        ogs_error("NAS length %d, but %d octets encoded", length, encoded);
     ogs_assert(ogs_pkbuf_push(pkbuf, encoded));
 
     pkbuf->len = encoded;
@@ -3727,18 +5766,27 @@ ogs_pkbuf_t *ogs_nas_5gsm_encode(ogs_nas_5gs_message_t *message)
     ogs_pkbuf_t *pkbuf = NULL;
     int size = 0;
     int encoded = 0;
+    int length = 0;
 
     ogs_assert(message);
 
+    length = ogs_nas_5gsm_length(message);
+    if (length < 0) {
+        ogs_error("Unknown message type (0x%x) or not implemented", 
+                message->gsm.h.message_type);
+        return NULL;
+    }
+
     /* The Packet Buffer(ogs_pkbuf_t) for NAS message MUST make a HEADROOM. 
-     * When calculating AES_CMAC, we need to use the headroom of the packet. */
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+     * When calculating AES_CMAC, we need to use the headroom of the packet.
+     * The length is known up front; OGS_NAS_SLACK only guards it. */
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+length+OGS_NAS_SLACK);
     if (!pkbuf) {
         ogs_error("ogs_pkbuf_alloc() failed");
         return NULL;
     }
     ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN-OGS_NAS_HEADROOM);
+    ogs_pkbuf_put(pkbuf, length+OGS_NAS_SLACK);
 
     size = sizeof(ogs_nas_5gsm_header_t);
     ogs_assert(ogs_pkbuf_pull(pkbuf, size));
@@ -3833,6 +5881,8 @@ ogs_pkbuf_t *ogs_nas_5gsm_encode(ogs_nas_5gs_message_t *message)
         return NULL;
     }
 
+    if (encoded != length)
+        ogs_error("NAS length %d, but %d octets encoded", length, encoded);
     ogs_assert(ogs_pkbuf_push(pkbuf, encoded));
     pkbuf->len = encoded;
 
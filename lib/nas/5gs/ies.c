@@ -82,6 +82,13 @@ int ogs_nas_5gs_encode_additional_information(ogs_pkbuf_t *pkbuf, ogs_nas_additi
     return size;
 }
 
+int ogs_nas_5gs_length_additional_information(ogs_nas_additional_information_t *additional_information)
+{
+    int size = additional_information->length + sizeof(additional_information->length);
+
+    return size;
+}
+
 /* 9.11.2.10 Service-level-AA container
  * O TLV-E 6-n */
 int ogs_nas_5gs_decode_service_level_aa_container(ogs_nas_service_level_aa_container_t *service_level_aa_container, ogs_pkbuf_t *pkbuf)
@@ -128,6 +135,11 @@ int ogs_nas_5gs_encode_service_level_aa_container(ogs_pkbuf_t *pkbuf, ogs_nas_se
     return service_level_aa_container->length + sizeof(service_level_aa_container->length);
 }
 
+int ogs_nas_5gs_length_service_level_aa_container(ogs_nas_service_level_aa_container_t *service_level_aa_container)
+{
+    return service_level_aa_container->length + sizeof(service_level_aa_container->length);
+}
+
 /* 9.11.2.1A Access type
  * M V 1/2 */
 int ogs_nas_5gs_decode_access_type(ogs_nas_access_type_t *access_type, ogs_pkbuf_t *pkbuf)
@@ -162,6 +174,11 @@ int ogs_nas_5gs_encode_access_type(ogs_pkbuf_t *pkbuf, ogs_nas_access_type_t *ac
     return size;
 }
 
+int ogs_nas_5gs_length_access_type(ogs_nas_access_type_t *access_type)
+{
+    return sizeof(ogs_nas_access_type_t);
+}
+
 /* 9.11.2.1B DNN
  * O TLV 3-102 */
 int ogs_nas_5gs_decode_dnn(ogs_nas_dnn_t *dnn, ogs_pkbuf_t *pkbuf)
@@ -214,6 +231,15 @@ int ogs_nas_5gs_encode_dnn(ogs_pkbuf_t *pkbuf, ogs_nas_dnn_t *dnn)
     return size;
 }
 
+int ogs_nas_5gs_length_dnn(ogs_nas_dnn_t *dnn)
+{
+    int size = dnn->length + sizeof(dnn->length);
+
+    size++; /* ogs_fqdn_build() adds the first label length */
+
+    return size;
+}
+
 /* 9.11.2.2 EAP message
  * O TLV-E 7-1503 */
 int ogs_nas_5gs_decode_eap_message(ogs_nas_eap_message_t *eap_message, ogs_pkbuf_t *pkbuf)
@@ -260,6 +286,11 @@ int ogs_nas_5gs_encode_eap_message(ogs_pkbuf_t *pkbuf, ogs_nas_eap_message_t *ea
     return eap_message->length + sizeof(eap_message->length);
 }
 
+int ogs_nas_5gs_length_eap_message(ogs_nas_eap_message_t *eap_message)
+{
+    return eap_message->length + sizeof(eap_message->length);
+}
+
 /* 9.11.2.3 GPRS timer
  * O TV 2 */
 int ogs_nas_5gs_decode_gprs_timer(ogs_nas_gprs_timer_t *gprs_timer, ogs_pkbuf_t *pkbuf)
@@ -294,6 +325,11 @@ int ogs_nas_5gs_encode_gprs_timer(ogs_pkbuf_t *pkbuf, ogs_nas_gprs_timer_t *gprs
     return size;
 }
 
+int ogs_nas_5gs_length_gprs_timer(ogs_nas_gprs_timer_t *gprs_timer)
+{
+    return sizeof(ogs_nas_gprs_timer_t);
+}
+
 /* 9.11.2.4 GPRS timer 2
  * O TLV 3 */
 int ogs_nas_5gs_decode_gprs_timer_2(ogs_nas_gprs_timer_2_t *gprs_timer_2, ogs_pkbuf_t *pkbuf)
@@ -333,6 +369,13 @@ int ogs_nas_5gs_encode_gprs_timer_2(ogs_pkbuf_t *pkbuf, ogs_nas_gprs_timer_2_t *
     return size;
 }
 
+int ogs_nas_5gs_length_gprs_timer_2(ogs_nas_gprs_timer_2_t *gprs_timer_2)
+{
+    int size = gprs_timer_2->length + sizeof(gprs_timer_2->length);
+
+    return size;
+}
+
 /* 9.11.2.5 GPRS timer 3
  * O TLV 3 */
 int ogs_nas_5gs_decode_gprs_timer_3(ogs_nas_gprs_timer_3_t *gprs_timer_3, ogs_pkbuf_t *pkbuf)
@@ -372,6 +415,13 @@ int ogs_nas_5gs_encode_gprs_timer_3(ogs_pkbuf_t *pkbuf, ogs_nas_gprs_timer_3_t *
     return size;
 }
 
+int ogs_nas_5gs_length_gprs_timer_3(ogs_nas_gprs_timer_3_t *gprs_timer_3)
+{
+    int size = gprs_timer_3->length + sizeof(gprs_timer_3->length);
+
+    return size;
+}
+
 /* 9.11.2.8 S-NSSAI
  * O TLV 3-10 */
 int ogs_nas_5gs_decode_s_nssai(ogs_nas_s_nssai_t *s_nssai, ogs_pkbuf_t *pkbuf)
@@ -411,6 +461,13 @@ int ogs_nas_5gs_encode_s_nssai(ogs_pkbuf_t *pkbuf, ogs_nas_s_nssai_t *s_nssai)
     return size;
 }
 
+int ogs_nas_5gs_length_s_nssai(ogs_nas_s_nssai_t *s_nssai)
+{
+    int size = s_nssai->length + sizeof(s_nssai->length);
+
+    return size;
+}
+
 /* 9.11.3.1 5GMM capability
  * O TLV 3-15 */
 int ogs_nas_5gs_decode_5gmm_capability(ogs_nas_5gmm_capability_t *gmm_capability, ogs_pkbuf_t *pkbuf)
@@ -450,6 +507,13 @@ int ogs_nas_5gs_encode_5gmm_capability(ogs_pkbuf_t *pkbuf, ogs_nas_5gmm_capabili
     return size;
 }
 
+int ogs_nas_5gs_length_5gmm_capability(ogs_nas_5gmm_capability_t *gmm_capability)
+{
+    int size = gmm_capability->length + sizeof(gmm_capability->length);
+
+    return size;
+}
+
 /* 9.11.3.10 ABBA
  * M LV 3-n */
 int ogs_nas_5gs_decode_abba(ogs_nas_abba_t *abba, ogs_pkbuf_t *pkbuf)
@@ -489,6 +553,13 @@ int ogs_nas_5gs_encode_abba(ogs_pkbuf_t *pkbuf, ogs_nas_abba_t *abba)
     return size;
 }
 
+int ogs_nas_5gs_length_abba(ogs_nas_abba_t *abba)
+{
+    int size = abba->length + sizeof(abba->length);
+
+    return size;
+}
+
 /* 9.11.3.12 Additional 5G security information
  * O TLV 3 */
 int ogs_nas_5gs_decode_additional_5g_security_information(ogs_nas_additional_5g_security_information_t *additional_security_information, ogs_pkbuf_t *pkbuf)
@@ -528,6 +599,13 @@ int ogs_nas_5gs_encode_additional_5g_security_information(ogs_pkbuf_t *pkbuf, og
     return size;
 }
 
+int ogs_nas_5gs_length_additional_5g_security_information(ogs_nas_additional_5g_security_information_t *additional_security_information)
+{
+    int size = additional_security_information->length + sizeof(additional_security_information->length);
+
+    return size;
+}
+
 /* 9.11.3.12A Additional information requested
  * O TLV 3 */
 int ogs_nas_5gs_decode_additional_information_requested(ogs_nas_additional_information_requested_t *additional_information_requested, ogs_pkbuf_t *pkbuf)
@@ -567,6 +645,13 @@ int ogs_nas_5gs_encode_additional_information_requested(ogs_pkbuf_t *pkbuf, ogs_
     return size;
 }
 
+int ogs_nas_5gs_length_additional_information_requested(ogs_nas_additional_information_requested_t *additional_information_requested)
+{
+    int size = additional_information_requested->length + sizeof(additional_information_requested->length);
+
+    return size;
+}
+
 /* 9.11.3.13 Allowed PDU session status
  * O TLV 4-34 */
 int ogs_nas_5gs_decode_allowed_pdu_session_status(ogs_nas_allowed_pdu_session_status_t *allowed_pdu_session_status, ogs_pkbuf_t *pkbuf)
@@ -610,6 +695,13 @@ int ogs_nas_5gs_encode_allowed_pdu_session_status(ogs_pkbuf_t *pkbuf, ogs_nas_al
     return size;
 }
 
+int ogs_nas_5gs_length_allowed_pdu_session_status(ogs_nas_allowed_pdu_session_status_t *allowed_pdu_session_status)
+{
+    int size = allowed_pdu_session_status->length + sizeof(allowed_pdu_session_status->length);
+
+    return size;
+}
+
 /* 9.11.3.14 Authentication failure parameter
  * O TLV 16 */
 int ogs_nas_5gs_decode_authentication_failure_parameter(ogs_nas_authentication_failure_parameter_t *authentication_failure_parameter, ogs_pkbuf_t *pkbuf)
@@ -649,6 +741,13 @@ int ogs_nas_5gs_encode_authentication_failure_parameter(ogs_pkbuf_t *pkbuf, ogs_
     return size;
 }
 
+int ogs_nas_5gs_length_authentication_failure_parameter(ogs_nas_authentication_failure_parameter_t *authentication_failure_parameter)
+{
+    int size = authentication_failure_parameter->length + sizeof(authentication_failure_parameter->length);
+
+    return size;
+}
+
 /* 9.11.3.15 Authentication parameter AUTN
  * O TLV 18 */
 int ogs_nas_5gs_decode_authentication_parameter_autn(ogs_nas_authentication_parameter_autn_t *authentication_parameter_autn, ogs_pkbuf_t *pkbuf)
@@ -688,6 +787,13 @@ int ogs_nas_5gs_encode_authentication_parameter_autn(ogs_pkbuf_t *pkbuf, ogs_nas
     return size;
 }
 
+int ogs_nas_5gs_length_authentication_parameter_autn(ogs_nas_authentication_parameter_autn_t *authentication_parameter_autn)
+{
+    int size = authentication_parameter_autn->length + sizeof(authentication_parameter_autn->length);
+
+    return size;
+}
+
 /* 9.11.3.16 Authentication parameter RAND
  * O TV 17 */
 int ogs_nas_5gs_decode_authentication_parameter_rand(ogs_nas_authentication_parameter_rand_t *authentication_parameter_rand, ogs_pkbuf_t *pkbuf)
@@ -722,6 +828,11 @@ int ogs_nas_5gs_encode_authentication_parameter_rand(ogs_pkbuf_t *pkbuf, ogs_nas
     return size;
 }
 
+int ogs_nas_5gs_length_authentication_parameter_rand(ogs_nas_authentication_parameter_rand_t *authentication_parameter_rand)
+{
+    return sizeof(ogs_nas_authentication_parameter_rand_t);
+}
+
 /* 9.11.3.17 Authentication response parameter
  * O TLV 18 */
 int ogs_nas_5gs_decode_authentication_response_parameter(ogs_nas_authentication_response_parameter_t *authentication_response_parameter, ogs_pkbuf_t *pkbuf)
@@ -761,6 +872,13 @@ int ogs_nas_5gs_encode_authentication_response_parameter(ogs_pkbuf_t *pkbuf, ogs
     return size;
 }
 
+int ogs_nas_5gs_length_authentication_response_parameter(ogs_nas_authentication_response_parameter_t *authentication_response_parameter)
+{
+    int size = authentication_response_parameter->length + sizeof(authentication_response_parameter->length);
+
+    return size;
+}
+
 /* 9.11.3.18 Configuration update indication
  * O TV 1 */
 int ogs_nas_5gs_decode_configuration_update_indication(ogs_nas_configuration_update_indication_t *configuration_update_indication, ogs_pkbuf_t *pkbuf)
@@ -793,6 +911,11 @@ int ogs_nas_5gs_encode_configuration_update_indication(ogs_pkbuf_t *pkbuf, ogs_n
     return size;
 }
 
+int ogs_nas_5gs_length_configuration_update_indication(ogs_nas_configuration_update_indication_t *configuration_update_indication)
+{
+    return sizeof(ogs_nas_configuration_update_indication_t);
+}
+
 /* 9.11.3.18A CAG information list
  * O TLV-E 3-n */
 int ogs_nas_5gs_decode_cag_information_list(ogs_nas_cag_information_list_t *cag_information_list, ogs_pkbuf_t *pkbuf)
@@ -839,6 +962,11 @@ int ogs_nas_5gs_encode_cag_information_list(ogs_pkbuf_t *pkbuf, ogs_nas_cag_info
     return cag_information_list->length + sizeof(cag_information_list->length);
 }
 
+int ogs_nas_5gs_length_cag_information_list(ogs_nas_cag_information_list_t *cag_information_list)
+{
+    return cag_information_list->length + sizeof(cag_information_list->length);
+}
+
 /* 9.11.3.18C Ciphering key data
  * O TLV-E 34-n */
 int ogs_nas_5gs_decode_ciphering_key_data(ogs_nas_ciphering_key_data_t *ciphering_key_data, ogs_pkbuf_t *pkbuf)
@@ -885,6 +1013,11 @@ int ogs_nas_5gs_encode_ciphering_key_data(ogs_pkbuf_t *pkbuf, ogs_nas_ciphering_
     return ciphering_key_data->length + sizeof(ciphering_key_data->length);
 }
 
+int ogs_nas_5gs_length_ciphering_key_data(ogs_nas_ciphering_key_data_t *ciphering_key_data)
+{
+    return ciphering_key_data->length + sizeof(ciphering_key_data->length);
+}
+
 /* 9.11.3.19 Daylight saving time
  * O TLV 3 */
 int ogs_nas_5gs_decode_daylight_saving_time(ogs_nas_daylight_saving_time_t *daylight_saving_time, ogs_pkbuf_t *pkbuf)
@@ -924,6 +1057,13 @@ int ogs_nas_5gs_encode_daylight_saving_time(ogs_pkbuf_t *pkbuf, ogs_nas_daylight
     return size;
 }
 
+int ogs_nas_5gs_length_daylight_saving_time(ogs_nas_daylight_saving_time_t *daylight_saving_time)
+{
+    int size = daylight_saving_time->length + sizeof(daylight_saving_time->length);
+
+    return size;
+}
+
 /* 9.11.3.2 5GMM cause
  * M V 1 */
 int ogs_nas_5gs_decode_5gmm_cause(ogs_nas_5gmm_cause_t *gmm_cause, ogs_pkbuf_t *pkbuf)
@@ -958,6 +1098,11 @@ int ogs_nas_5gs_encode_5gmm_cause(ogs_pkbuf_t *pkbuf, ogs_nas_5gmm_cause_t *gmm_
     return size;
 }
 
+int ogs_nas_5gs_length_5gmm_cause(ogs_nas_5gmm_cause_t *gmm_cause)
+{
+    return sizeof(ogs_nas_5gmm_cause_t);
+}
+
 /* 9.11.3.20 De-registration type
  * M V 1/2 */
 int ogs_nas_5gs_decode_de_registration_type(ogs_nas_de_registration_type_t *de_registration_type, ogs_pkbuf_t *pkbuf)
@@ -992,6 +1137,11 @@ int ogs_nas_5gs_encode_de_registration_type(ogs_pkbuf_t *pkbuf, ogs_nas_de_regis
     return size;
 }
 
+int ogs_nas_5gs_length_de_registration_type(ogs_nas_de_registration_type_t *de_registration_type)
+{
+    return sizeof(ogs_nas_de_registration_type_t);
+}
+
 /* 9.11.3.23 Emergency number list
  * O TLV 5-50 */
 int ogs_nas_5gs_decode_emergency_number_list(ogs_nas_emergency_number_list_t *emergency_number_list, ogs_pkbuf_t *pkbuf)
@@ -1031,6 +1181,13 @@ int ogs_nas_5gs_encode_emergency_number_list(ogs_pkbuf_t *pkbuf, ogs_nas_emergen
     return size;
 }
 
+int ogs_nas_5gs_length_emergency_number_list(ogs_nas_emergency_number_list_t *emergency_number_list)
+{
+    int size = emergency_number_list->length + sizeof(emergency_number_list->length);
+
+    return size;
+}
+
 /* 9.11.3.23A EPS bearer context status
  * O TLV 4 */
 int ogs_nas_5gs_decode_eps_bearer_context_status(ogs_nas_eps_bearer_context_status_t *eps_bearer_context_status, ogs_pkbuf_t *pkbuf)
@@ -1070,6 +1227,13 @@ int ogs_nas_5gs_encode_eps_bearer_context_status(ogs_pkbuf_t *pkbuf, ogs_nas_eps
     return size;
 }
 
+int ogs_nas_5gs_length_eps_bearer_context_status(ogs_nas_eps_bearer_context_status_t *eps_bearer_context_status)
+{
+    int size = eps_bearer_context_status->length + sizeof(eps_bearer_context_status->length);
+
+    return size;
+}
+
 /* 9.11.3.24 EPS NAS message container
  * O TLV-E 4-n */
 int ogs_nas_5gs_decode_eps_nas_message_container(ogs_nas_eps_nas_message_container_t *eps_nas_message_container, ogs_pkbuf_t *pkbuf)
@@ -1116,6 +1280,11 @@ int ogs_nas_5gs_encode_eps_nas_message_container(ogs_pkbuf_t *pkbuf, ogs_nas_eps
     return eps_nas_message_container->length + sizeof(eps_nas_message_container->length);
 }
 
+int ogs_nas_5gs_length_eps_nas_message_container(ogs_nas_eps_nas_message_container_t *eps_nas_message_container)
+{
+    return eps_nas_message_container->length + sizeof(eps_nas_message_container->length);
+}
+
 /* 9.11.3.25 EPS NAS security algorithms
  * O TV 2 */
 int ogs_nas_5gs_decode_eps_nas_security_algorithms(ogs_nas_eps_nas_security_algorithms_t *eps_nas_security_algorithms, ogs_pkbuf_t *pkbuf)
@@ -1150,6 +1319,11 @@ int ogs_nas_5gs_encode_eps_nas_security_algorithms(ogs_pkbuf_t *pkbuf, ogs_nas_e
     return size;
 }
 
+int ogs_nas_5gs_length_eps_nas_security_algorithms(ogs_nas_eps_nas_security_algorithms_t *eps_nas_security_algorithms)
+{
+    return sizeof(ogs_nas_eps_nas_security_algorithms_t);
+}
+
 /* 9.11.3.26 Extended emergency number list
  * O TLV-E 7-65538 */
 int ogs_nas_5gs_decode_extended_emergency_number_list(ogs_nas_extended_emergency_number_list_t *extended_emergency_number_list, ogs_pkbuf_t *pkbuf)
@@ -1196,6 +1370,11 @@ int ogs_nas_5gs_encode_extended_emergency_number_list(ogs_pkbuf_t *pkbuf, ogs_na
     return extended_emergency_number_list->length + sizeof(extended_emergency_number_list->length);
 }
 
+int ogs_nas_5gs_length_extended_emergency_number_list(ogs_nas_extended_emergency_number_list_t *extended_emergency_number_list)
+{
+    return extended_emergency_number_list->length + sizeof(extended_emergency_number_list->length);
+}
+
 /* 9.11.3.26A Extended DRX parameters
  * O TLV 3-4 */
 int ogs_nas_5gs_decode_extended_drx_parameters(ogs_nas_extended_drx_parameters_t *extended_drx_parameters, ogs_pkbuf_t *pkbuf)
@@ -1235,6 +1414,13 @@ int ogs_nas_5gs_encode_extended_drx_parameters(ogs_pkbuf_t *pkbuf, ogs_nas_exten
     return size;
 }
 
+int ogs_nas_5gs_length_extended_drx_parameters(ogs_nas_extended_drx_parameters_t *extended_drx_parameters)
+{
+    int size = extended_drx_parameters->length + sizeof(extended_drx_parameters->length);
+
+    return size;
+}
+
 /* 9.11.3.28 IMEISV request
  * O TV 1 */
 int ogs_nas_5gs_decode_imeisv_request(ogs_nas_imeisv_request_t *imeisv_request, ogs_pkbuf_t *pkbuf)
@@ -1267,6 +1453,11 @@ int ogs_nas_5gs_encode_imeisv_request(ogs_pkbuf_t *pkbuf, ogs_nas_imeisv_request
     return size;
 }
 
+int ogs_nas_5gs_length_imeisv_request(ogs_nas_imeisv_request_t *imeisv_request)
+{
+    return sizeof(ogs_nas_imeisv_request_t);
+}
+
 /* 9.11.3.29 LADN indication
  * O TLV-E 3-811 */
 int ogs_nas_5gs_decode_ladn_indication(ogs_nas_ladn_indication_t *ladn_indication, ogs_pkbuf_t *pkbuf)
@@ -1313,6 +1504,11 @@ int ogs_nas_5gs_encode_ladn_indication(ogs_pkbuf_t *pkbuf, ogs_nas_ladn_indicati
     return ladn_indication->length + sizeof(ladn_indication->length);
 }
 
+int ogs_nas_5gs_length_ladn_indication(ogs_nas_ladn_indication_t *ladn_indication)
+{
+    return ladn_indication->length + sizeof(ladn_indication->length);
+}
+
 /* 9.11.3.2A 5GS DRX parameters
  * O TLV 3 */
 int ogs_nas_5gs_decode_5gs_drx_parameters(ogs_nas_5gs_drx_parameters_t *drx_parameters, ogs_pkbuf_t *pkbuf)
@@ -1352,6 +1548,13 @@ int ogs_nas_5gs_encode_5gs_drx_parameters(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_drx_pa
     return size;
 }
 
+int ogs_nas_5gs_length_5gs_drx_parameters(ogs_nas_5gs_drx_parameters_t *drx_parameters)
+{
+    int size = drx_parameters->length + sizeof(drx_parameters->length);
+
+    return size;
+}
+
 /* 9.11.3.3 5GS identity type
  * M V 1/2 */
 int ogs_nas_5gs_decode_5gs_identity_type(ogs_nas_5gs_identity_type_t *identity_type, ogs_pkbuf_t *pkbuf)
@@ -1386,6 +1589,11 @@ int ogs_nas_5gs_encode_5gs_identity_type(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_identit
     return size;
 }
 
+int ogs_nas_5gs_length_5gs_identity_type(ogs_nas_5gs_identity_type_t *identity_type)
+{
+    return sizeof(ogs_nas_5gs_identity_type_t);
+}
+
 /* 9.11.3.30 LADN information
  * O TLV-E 12-1715 */
 int ogs_nas_5gs_decode_ladn_information(ogs_nas_ladn_information_t *ladn_information, ogs_pkbuf_t *pkbuf)
@@ -1432,6 +1640,11 @@ int ogs_nas_5gs_encode_ladn_information(ogs_pkbuf_t *pkbuf, ogs_nas_ladn_informa
     return ladn_information->length + sizeof(ladn_information->length);
 }
 
+int ogs_nas_5gs_length_ladn_information(ogs_nas_ladn_information_t *ladn_information)
+{
+    return ladn_information->length + sizeof(ladn_information->length);
+}
+
 /* 9.11.3.31 MICO indication
  * O TV 1 */
 int ogs_nas_5gs_decode_mico_indication(ogs_nas_mico_indication_t *mico_indication, ogs_pkbuf_t *pkbuf)
@@ -1464,6 +1677,11 @@ int ogs_nas_5gs_encode_mico_indication(ogs_pkbuf_t *pkbuf, ogs_nas_mico_indicati
     return size;
 }
 
+int ogs_nas_5gs_length_mico_indication(ogs_nas_mico_indication_t *mico_indication)
+{
+    return sizeof(ogs_nas_mico_indication_t);
+}
+
 /* 9.11.3.31A MA PDU session information
  * O TV 1 */
 int ogs_nas_5gs_decode_ma_pdu_session_information(ogs_nas_ma_pdu_session_information_t *ma_pdu_session_information, ogs_pkbuf_t *pkbuf)
@@ -1496,6 +1714,11 @@ int ogs_nas_5gs_encode_ma_pdu_session_information(ogs_pkbuf_t *pkbuf, ogs_nas_ma
     return size;
 }
 
+int ogs_nas_5gs_length_ma_pdu_session_information(ogs_nas_ma_pdu_session_information_t *ma_pdu_session_information)
+{
+    return sizeof(ogs_nas_ma_pdu_session_information_t);
+}
+
 /* 9.11.3.31B Mapped NSSAI
  * O TLV 3-42 */
 int ogs_nas_5gs_decode_mapped_nssai(ogs_nas_mapped_nssai_t *mapped_nssai, ogs_pkbuf_t *pkbuf)
@@ -1535,6 +1758,13 @@ int ogs_nas_5gs_encode_mapped_nssai(ogs_pkbuf_t *pkbuf, ogs_nas_mapped_nssai_t *
     return size;
 }
 
+int ogs_nas_5gs_length_mapped_nssai(ogs_nas_mapped_nssai_t *mapped_nssai)
+{
+    int size = mapped_nssai->length + sizeof(mapped_nssai->length);
+
+    return size;
+}
+
 /* 9.11.3.31C Mobile station classmark 2
  * O TLV 5 */
 int ogs_nas_5gs_decode_mobile_station_classmark_2(ogs_nas_mobile_station_classmark_2_t *mobile_station_classmark_2, ogs_pkbuf_t *pkbuf)
@@ -1574,6 +1804,13 @@ int ogs_nas_5gs_encode_mobile_station_classmark_2(ogs_pkbuf_t *pkbuf, ogs_nas_mo
     return size;
 }
 
+int ogs_nas_5gs_length_mobile_station_classmark_2(ogs_nas_mobile_station_classmark_2_t *mobile_station_classmark_2)
+{
+    int size = mobile_station_classmark_2->length + sizeof(mobile_station_classmark_2->length);
+
+    return size;
+}
+
 /* 9.11.3.32 key set identifier
  * O TV 1 */
 int ogs_nas_5gs_decode_key_set_identifier(ogs_nas_key_set_identifier_t *key_set_identifier, ogs_pkbuf_t *pkbuf)
@@ -1606,6 +1843,11 @@ int ogs_nas_5gs_encode_key_set_identifier(ogs_pkbuf_t *pkbuf, ogs_nas_key_set_id
     return size;
 }
 
+int ogs_nas_5gs_length_key_set_identifier(ogs_nas_key_set_identifier_t *key_set_identifier)
+{
+    return sizeof(ogs_nas_key_set_identifier_t);
+}
+
 /* 9.11.3.33 message container
  * O TLV-E 4-n */
 int ogs_nas_5gs_decode_message_container(ogs_nas_message_container_t *message_container, ogs_pkbuf_t *pkbuf)
@@ -1652,6 +1894,11 @@ int ogs_nas_5gs_encode_message_container(ogs_pkbuf_t *pkbuf, ogs_nas_message_con
     return message_container->length + sizeof(message_container->length);
 }
 
+int ogs_nas_5gs_length_message_container(ogs_nas_message_container_t *message_container)
+{
+    return message_container->length + sizeof(message_container->length);
+}
+
 /* 9.11.3.34 security algorithms
  * M V 1 */
 int ogs_nas_5gs_decode_security_algorithms(ogs_nas_security_algorithms_t *security_algorithms, ogs_pkbuf_t *pkbuf)
@@ -1686,6 +1933,11 @@ int ogs_nas_5gs_encode_security_algorithms(ogs_pkbuf_t *pkbuf, ogs_nas_security_
     return size;
 }
 
+int ogs_nas_5gs_length_security_algorithms(ogs_nas_security_algorithms_t *security_algorithms)
+{
+    return sizeof(ogs_nas_security_algorithms_t);
+}
+
 /* 9.11.3.35 Network name
  * O TLV 3-n */
 int ogs_nas_5gs_decode_network_name(ogs_nas_network_name_t *network_name, ogs_pkbuf_t *pkbuf)
@@ -1725,6 +1977,13 @@ int ogs_nas_5gs_encode_network_name(ogs_pkbuf_t *pkbuf, ogs_nas_network_name_t *
     return size;
 }
 
+int ogs_nas_5gs_length_network_name(ogs_nas_network_name_t *network_name)
+{
+    int size = network_name->length + sizeof(network_name->length);
+
+    return size;
+}
+
 /* 9.11.3.36 Network slicing indication
  * O TV 1 */
 int ogs_nas_5gs_decode_network_slicing_indication(ogs_nas_network_slicing_indication_t *network_slicing_indication, ogs_pkbuf_t *pkbuf)
@@ -1757,6 +2016,11 @@ int ogs_nas_5gs_encode_network_slicing_indication(ogs_pkbuf_t *pkbuf, ogs_nas_ne
     return size;
 }
 
+int ogs_nas_5gs_length_network_slicing_indication(ogs_nas_network_slicing_indication_t *network_slicing_indication)
+{
+    return sizeof(ogs_nas_network_slicing_indication_t);
+}
+
 /* 9.11.3.36A Non-3GPP NW provided policies
  * O TV 1 */
 int ogs_nas_5gs_decode_non_3gpp_nw_provided_policies(ogs_nas_non_3gpp_nw_provided_policies_t *non_3gpp_nw_provided_policies, ogs_pkbuf_t *pkbuf)
@@ -1789,6 +2053,11 @@ int ogs_nas_5gs_encode_non_3gpp_nw_provided_policies(ogs_pkbuf_t *pkbuf, ogs_nas
     return size;
 }
 
+int ogs_nas_5gs_length_non_3gpp_nw_provided_policies(ogs_nas_non_3gpp_nw_provided_policies_t *non_3gpp_nw_provided_policies)
+{
+    return sizeof(ogs_nas_non_3gpp_nw_provided_policies_t);
+}
+
 /* 9.11.3.37 NSSAI
  * O TLV 4-74 */
 int ogs_nas_5gs_decode_nssai(ogs_nas_nssai_t *nssai, ogs_pkbuf_t *pkbuf)
@@ -1828,6 +2097,13 @@ int ogs_nas_5gs_encode_nssai(ogs_pkbuf_t *pkbuf, ogs_nas_nssai_t *nssai)
     return size;
 }
 
+int ogs_nas_5gs_length_nssai(ogs_nas_nssai_t *nssai)
+{
+    int size = nssai->length + sizeof(nssai->length);
+
+    return size;
+}
+
 /* 9.11.3.37A NSSAI inclusion mode
  * O TV 1 */
 int ogs_nas_5gs_decode_nssai_inclusion_mode(ogs_nas_nssai_inclusion_mode_t *nssai_inclusion_mode, ogs_pkbuf_t *pkbuf)
@@ -1860,6 +2136,11 @@ int ogs_nas_5gs_encode_nssai_inclusion_mode(ogs_pkbuf_t *pkbuf, ogs_nas_nssai_in
     return size;
 }
 
+int ogs_nas_5gs_length_nssai_inclusion_mode(ogs_nas_nssai_inclusion_mode_t *nssai_inclusion_mode)
+{
+    return sizeof(ogs_nas_nssai_inclusion_mode_t);
+}
+
 /* 9.11.3.38 Operator-defined access category definitions
  * O TLV-E 3-8323 */
 int ogs_nas_5gs_decode_operator_defined_access_category_definitions(ogs_nas_operator_defined_access_category_definitions_t *operator_defined_access_category_definitions, ogs_pkbuf_t *pkbuf)
@@ -1906,6 +2187,11 @@ int ogs_nas_5gs_encode_operator_defined_access_category_definitions(ogs_pkbuf_t
     return operator_defined_access_category_definitions->length + sizeof(operator_defined_access_category_definitions->length);
 }
 
+int ogs_nas_5gs_length_operator_defined_access_category_definitions(ogs_nas_operator_defined_access_category_definitions_t *operator_defined_access_category_definitions)
+{
+    return operator_defined_access_category_definitions->length + sizeof(operator_defined_access_category_definitions->length);
+}
+
 /* 9.11.3.39 Payload container
  * O TLV-E 4-65538 */
 int ogs_nas_5gs_decode_payload_container(ogs_nas_payload_container_t *payload_container, ogs_pkbuf_t *pkbuf)
@@ -1952,6 +2238,11 @@ int ogs_nas_5gs_encode_payload_container(ogs_pkbuf_t *pkbuf, ogs_nas_payload_con
     return payload_container->length + sizeof(payload_container->length);
 }
 
+int ogs_nas_5gs_length_payload_container(ogs_nas_payload_container_t *payload_container)
+{
+    return payload_container->length + sizeof(payload_container->length);
+}
+
 /* 9.11.3.4 5GS mobile identity
  * M LV-E 6-n */
 int ogs_nas_5gs_decode_5gs_mobile_identity(ogs_nas_5gs_mobile_identity_t *mobile_identity, ogs_pkbuf_t *pkbuf)
@@ -1998,6 +2289,11 @@ int ogs_nas_5gs_encode_5gs_mobile_identity(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_mobil
     return mobile_identity->length + sizeof(mobile_identity->length);
 }
 
+int ogs_nas_5gs_length_5gs_mobile_identity(ogs_nas_5gs_mobile_identity_t *mobile_identity)
+{
+    return mobile_identity->length + sizeof(mobile_identity->length);
+}
+
 /* 9.11.3.40 Payload container type
  * O TV 1 */
 int ogs_nas_5gs_decode_payload_container_type(ogs_nas_payload_container_type_t *payload_container_type, ogs_pkbuf_t *pkbuf)
@@ -2030,6 +2326,11 @@ int ogs_nas_5gs_encode_payload_container_type(ogs_pkbuf_t *pkbuf, ogs_nas_payloa
     return size;
 }
 
+int ogs_nas_5gs_length_payload_container_type(ogs_nas_payload_container_type_t *payload_container_type)
+{
+    return sizeof(ogs_nas_payload_container_type_t);
+}
+
 /* 9.11.3.41 PDU session identity 2
  * C TV 2 */
 int ogs_nas_5gs_decode_pdu_session_identity_2(ogs_nas_pdu_session_identity_2_t *pdu_session_identity_2, ogs_pkbuf_t *pkbuf)
@@ -2064,6 +2365,11 @@ int ogs_nas_5gs_encode_pdu_session_identity_2(ogs_pkbuf_t *pkbuf, ogs_nas_pdu_se
     return size;
 }
 
+int ogs_nas_5gs_length_pdu_session_identity_2(ogs_nas_pdu_session_identity_2_t *pdu_session_identity_2)
+{
+    return sizeof(ogs_nas_pdu_session_identity_2_t);
+}
+
 /* 9.11.3.42 PDU session reactivation result
  * O TLV 4-34 */
 int ogs_nas_5gs_decode_pdu_session_reactivation_result(ogs_nas_pdu_session_reactivation_result_t *pdu_session_reactivation_result, ogs_pkbuf_t *pkbuf)
@@ -2107,6 +2413,13 @@ int ogs_nas_5gs_encode_pdu_session_reactivation_result(ogs_pkbuf_t *pkbuf, ogs_n
     return size;
 }
 
+int ogs_nas_5gs_length_pdu_session_reactivation_result(ogs_nas_pdu_session_reactivation_result_t *pdu_session_reactivation_result)
+{
+    int size = pdu_session_reactivation_result->length + sizeof(pdu_session_reactivation_result->length);
+
+    return size;
+}
+
 /* 9.11.3.43 PDU session reactivation result error cause
  * O TLV-E 5-515 */
 int ogs_nas_5gs_decode_pdu_session_reactivation_result_error_cause(ogs_nas_pdu_session_reactivation_result_error_cause_t *pdu_session_reactivation_result_error_cause, ogs_pkbuf_t *pkbuf)
@@ -2153,6 +2466,11 @@ int ogs_nas_5gs_encode_pdu_session_reactivation_result_error_cause(ogs_pkbuf_t *
     return pdu_session_reactivation_result_error_cause->length + sizeof(pdu_session_reactivation_result_error_cause->length);
 }
 
+int ogs_nas_5gs_length_pdu_session_reactivation_result_error_cause(ogs_nas_pdu_session_reactivation_result_error_cause_t *pdu_session_reactivation_result_error_cause)
+{
+    return pdu_session_reactivation_result_error_cause->length + sizeof(pdu_session_reactivation_result_error_cause->length);
+}
+
 /* 9.11.3.44 PDU session status
  * O TLV 4-34 */
 int ogs_nas_5gs_decode_pdu_session_status(ogs_nas_pdu_session_status_t *pdu_session_status, ogs_pkbuf_t *pkbuf)
@@ -2196,6 +2514,13 @@ int ogs_nas_5gs_encode_pdu_session_status(ogs_pkbuf_t *pkbuf, ogs_nas_pdu_sessio
     return size;
 }
 
+int ogs_nas_5gs_length_pdu_session_status(ogs_nas_pdu_session_status_t *pdu_session_status)
+{
+    int size = pdu_session_status->length + sizeof(pdu_session_status->length);
+
+    return size;
+}
+
 /* 9.11.3.45 PLMN list
  * O TLV 5-47 */
 int ogs_nas_5gs_decode_plmn_list(ogs_nas_plmn_list_t *plmn_list, ogs_pkbuf_t *pkbuf)
@@ -2235,12 +2560,19 @@ int ogs_nas_5gs_encode_plmn_list(ogs_pkbuf_t *pkbuf, ogs_nas_plmn_list_t *plmn_l
     return size;
 }
 
-/* 9.11.3.46 Rejected NSSAI
- * O TLV 4-42 */
-int ogs_nas_5gs_decode_rejected_nssai(ogs_nas_rejected_nssai_t *rejected_nssai, ogs_pkbuf_t *pkbuf)
+int ogs_nas_5gs_length_plmn_list(ogs_nas_plmn_list_t *plmn_list)
 {
-    int size = 0;
-    ogs_nas_rejected_nssai_t *source = (ogs_nas_rejected_nssai_t *)pkbuf->data;
+    int size = plmn_list->length + sizeof(plmn_list->length);
+
+    return size;
+}
+
+/* 9.11.3.46 Rejected NSSAI
+ * O TLV 4-42 */
+int ogs_nas_5gs_decode_rejected_nssai(ogs_nas_rejected_nssai_t *rejected_nssai, ogs_pkbuf_t *pkbuf)
+{
+    int size = 0;
+    ogs_nas_rejected_nssai_t *source = (ogs_nas_rejected_nssai_t *)pkbuf->data;
 
     rejected_nssai->length = source->length;
     size = rejected_nssai->length + sizeof(rejected_nssai->length);
@@ -2274,6 +2606,13 @@ int ogs_nas_5gs_encode_rejected_nssai(ogs_pkbuf_t *pkbuf, ogs_nas_rejected_nssai
     return size;
 }
 
+int ogs_nas_5gs_length_rejected_nssai(ogs_nas_rejected_nssai_t *rejected_nssai)
+{
+    int size = rejected_nssai->length + sizeof(rejected_nssai->length);
+
+    return size;
+}
+
 /* 9.11.3.46A Release assistance indication
  * O TV 1 */
 int ogs_nas_5gs_decode_release_assistance_indication(ogs_nas_release_assistance_indication_t *release_assistance_indication, ogs_pkbuf_t *pkbuf)
@@ -2306,6 +2645,11 @@ int ogs_nas_5gs_encode_release_assistance_indication(ogs_pkbuf_t *pkbuf, ogs_nas
     return size;
 }
 
+int ogs_nas_5gs_length_release_assistance_indication(ogs_nas_release_assistance_indication_t *release_assistance_indication)
+{
+    return sizeof(ogs_nas_release_assistance_indication_t);
+}
+
 /* 9.11.3.47 Request type
  * O TV 1 */
 int ogs_nas_5gs_decode_request_type(ogs_nas_request_type_t *request_type, ogs_pkbuf_t *pkbuf)
@@ -2338,6 +2682,11 @@ int ogs_nas_5gs_encode_request_type(ogs_pkbuf_t *pkbuf, ogs_nas_request_type_t *
     return size;
 }
 
+int ogs_nas_5gs_length_request_type(ogs_nas_request_type_t *request_type)
+{
+    return sizeof(ogs_nas_request_type_t);
+}
+
 /* 9.11.3.48 S1 UE network capability
  * O TLV 4-15 */
 int ogs_nas_5gs_decode_s1_ue_network_capability(ogs_nas_s1_ue_network_capability_t *s1_ue_network_capability, ogs_pkbuf_t *pkbuf)
@@ -2377,6 +2726,13 @@ int ogs_nas_5gs_encode_s1_ue_network_capability(ogs_pkbuf_t *pkbuf, ogs_nas_s1_u
     return size;
 }
 
+int ogs_nas_5gs_length_s1_ue_network_capability(ogs_nas_s1_ue_network_capability_t *s1_ue_network_capability)
+{
+    int size = s1_ue_network_capability->length + sizeof(s1_ue_network_capability->length);
+
+    return size;
+}
+
 /* 9.11.3.48A S1 UE security capability
  * O TLV 4-7 */
 int ogs_nas_5gs_decode_s1_ue_security_capability(ogs_nas_s1_ue_security_capability_t *s1_ue_security_capability, ogs_pkbuf_t *pkbuf)
@@ -2416,6 +2772,13 @@ int ogs_nas_5gs_encode_s1_ue_security_capability(ogs_pkbuf_t *pkbuf, ogs_nas_s1_
     return size;
 }
 
+int ogs_nas_5gs_length_s1_ue_security_capability(ogs_nas_s1_ue_security_capability_t *s1_ue_security_capability)
+{
+    int size = s1_ue_security_capability->length + sizeof(s1_ue_security_capability->length);
+
+    return size;
+}
+
 /* 9.11.3.49 Service area list
  * O TLV 6-114 */
 int ogs_nas_5gs_decode_service_area_list(ogs_nas_service_area_list_t *service_area_list, ogs_pkbuf_t *pkbuf)
@@ -2455,6 +2818,13 @@ int ogs_nas_5gs_encode_service_area_list(ogs_pkbuf_t *pkbuf, ogs_nas_service_are
     return size;
 }
 
+int ogs_nas_5gs_length_service_area_list(ogs_nas_service_area_list_t *service_area_list)
+{
+    int size = service_area_list->length + sizeof(service_area_list->length);
+
+    return size;
+}
+
 /* 9.11.3.5 5GS network feature support
  * O TLV 3-5 */
 int ogs_nas_5gs_decode_5gs_network_feature_support(ogs_nas_5gs_network_feature_support_t *network_feature_support, ogs_pkbuf_t *pkbuf)
@@ -2494,6 +2864,13 @@ int ogs_nas_5gs_encode_5gs_network_feature_support(ogs_pkbuf_t *pkbuf, ogs_nas_5
     return size;
 }
 
+int ogs_nas_5gs_length_5gs_network_feature_support(ogs_nas_5gs_network_feature_support_t *network_feature_support)
+{
+    int size = network_feature_support->length + sizeof(network_feature_support->length);
+
+    return size;
+}
+
 /* 9.11.3.50A SMS indication
  * O TV 1 */
 int ogs_nas_5gs_decode_sms_indication(ogs_nas_sms_indication_t *sms_indication, ogs_pkbuf_t *pkbuf)
@@ -2526,6 +2903,11 @@ int ogs_nas_5gs_encode_sms_indication(ogs_pkbuf_t *pkbuf, ogs_nas_sms_indication
     return size;
 }
 
+int ogs_nas_5gs_length_sms_indication(ogs_nas_sms_indication_t *sms_indication)
+{
+    return sizeof(ogs_nas_sms_indication_t);
+}
+
 /* 9.11.3.51 SOR transparent container
  * O TLV-E 20-n */
 int ogs_nas_5gs_decode_sor_transparent_container(ogs_nas_sor_transparent_container_t *sor_transparent_container, ogs_pkbuf_t *pkbuf)
@@ -2572,6 +2954,11 @@ int ogs_nas_5gs_encode_sor_transparent_container(ogs_pkbuf_t *pkbuf, ogs_nas_sor
     return sor_transparent_container->length + sizeof(sor_transparent_container->length);
 }
 
+int ogs_nas_5gs_length_sor_transparent_container(ogs_nas_sor_transparent_container_t *sor_transparent_container)
+{
+    return sor_transparent_container->length + sizeof(sor_transparent_container->length);
+}
+
 /* 9.11.3.51A Supported codec list
  * O TLV 5-n */
 int ogs_nas_5gs_decode_supported_codec_list(ogs_nas_supported_codec_list_t *supported_codec_list, ogs_pkbuf_t *pkbuf)
@@ -2611,6 +2998,13 @@ int ogs_nas_5gs_encode_supported_codec_list(ogs_pkbuf_t *pkbuf, ogs_nas_supporte
     return size;
 }
 
+int ogs_nas_5gs_length_supported_codec_list(ogs_nas_supported_codec_list_t *supported_codec_list)
+{
+    int size = supported_codec_list->length + sizeof(supported_codec_list->length);
+
+    return size;
+}
+
 /* 9.11.3.52 Time zone
  * O TV 2 */
 int ogs_nas_5gs_decode_time_zone(ogs_nas_time_zone_t *time_zone, ogs_pkbuf_t *pkbuf)
@@ -2645,6 +3039,11 @@ int ogs_nas_5gs_encode_time_zone(ogs_pkbuf_t *pkbuf, ogs_nas_time_zone_t *time_z
     return size;
 }
 
+int ogs_nas_5gs_length_time_zone(ogs_nas_time_zone_t *time_zone)
+{
+    return sizeof(ogs_nas_time_zone_t);
+}
+
 /* 9.11.3.53 Time zone and time
  * O TV 8 */
 int ogs_nas_5gs_decode_time_zone_and_time(ogs_nas_time_zone_and_time_t *time_zone_and_time, ogs_pkbuf_t *pkbuf)
@@ -2679,6 +3078,11 @@ int ogs_nas_5gs_encode_time_zone_and_time(ogs_pkbuf_t *pkbuf, ogs_nas_time_zone_
     return size;
 }
 
+int ogs_nas_5gs_length_time_zone_and_time(ogs_nas_time_zone_and_time_t *time_zone_and_time)
+{
+    return sizeof(ogs_nas_time_zone_and_time_t);
+}
+
 /* 9.11.3.54 UE security capability
  * O TLV 4-10 */
 int ogs_nas_5gs_decode_ue_security_capability(ogs_nas_ue_security_capability_t *ue_security_capability, ogs_pkbuf_t *pkbuf)
@@ -2718,6 +3122,13 @@ int ogs_nas_5gs_encode_ue_security_capability(ogs_pkbuf_t *pkbuf, ogs_nas_ue_sec
     return size;
 }
 
+int ogs_nas_5gs_length_ue_security_capability(ogs_nas_ue_security_capability_t *ue_security_capability)
+{
+    int size = ue_security_capability->length + sizeof(ue_security_capability->length);
+
+    return size;
+}
+
 /* 9.11.3.55 UE usage setting
  * O TLV 3 */
 int ogs_nas_5gs_decode_ue_usage_setting(ogs_nas_ue_usage_setting_t *ue_usage_setting, ogs_pkbuf_t *pkbuf)
@@ -2757,6 +3168,13 @@ int ogs_nas_5gs_encode_ue_usage_setting(ogs_pkbuf_t *pkbuf, ogs_nas_ue_usage_set
     return size;
 }
 
+int ogs_nas_5gs_length_ue_usage_setting(ogs_nas_ue_usage_setting_t *ue_usage_setting)
+{
+    int size = ue_usage_setting->length + sizeof(ue_usage_setting->length);
+
+    return size;
+}
+
 /* 9.11.3.56 UE status
  * O TLV 3 */
 int ogs_nas_5gs_decode_ue_status(ogs_nas_ue_status_t *ue_status, ogs_pkbuf_t *pkbuf)
@@ -2796,6 +3214,13 @@ int ogs_nas_5gs_encode_ue_status(ogs_pkbuf_t *pkbuf, ogs_nas_ue_status_t *ue_sta
     return size;
 }
 
+int ogs_nas_5gs_length_ue_status(ogs_nas_ue_status_t *ue_status)
+{
+    int size = ue_status->length + sizeof(ue_status->length);
+
+    return size;
+}
+
 /* 9.11.3.57 Uplink data status
  * O TLV 4-34 */
 int ogs_nas_5gs_decode_uplink_data_status(ogs_nas_uplink_data_status_t *uplink_data_status, ogs_pkbuf_t *pkbuf)
@@ -2839,6 +3264,13 @@ int ogs_nas_5gs_encode_uplink_data_status(ogs_pkbuf_t *pkbuf, ogs_nas_uplink_dat
     return size;
 }
 
+int ogs_nas_5gs_length_uplink_data_status(ogs_nas_uplink_data_status_t *uplink_data_status)
+{
+    int size = uplink_data_status->length + sizeof(uplink_data_status->length);
+
+    return size;
+}
+
 /* 9.11.3.6 5GS registration result
  * M LV 2 */
 int ogs_nas_5gs_decode_5gs_registration_result(ogs_nas_5gs_registration_result_t *registration_result, ogs_pkbuf_t *pkbuf)
@@ -2878,6 +3310,13 @@ int ogs_nas_5gs_encode_5gs_registration_result(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_r
     return size;
 }
 
+int ogs_nas_5gs_length_5gs_registration_result(ogs_nas_5gs_registration_result_t *registration_result)
+{
+    int size = registration_result->length + sizeof(registration_result->length);
+
+    return size;
+}
+
 /* 9.11.3.68 UE radio capability ID
  * O TLV 3-n */
 int ogs_nas_5gs_decode_ue_radio_capability_id(ogs_nas_ue_radio_capability_id_t *ue_radio_capability_id, ogs_pkbuf_t *pkbuf)
@@ -2917,6 +3356,13 @@ int ogs_nas_5gs_encode_ue_radio_capability_id(ogs_pkbuf_t *pkbuf, ogs_nas_ue_rad
     return size;
 }
 
+int ogs_nas_5gs_length_ue_radio_capability_id(ogs_nas_ue_radio_capability_id_t *ue_radio_capability_id)
+{
+    int size = ue_radio_capability_id->length + sizeof(ue_radio_capability_id->length);
+
+    return size;
+}
+
 /* 9.11.3.69 UE radio capability ID deletion indication
  * O TV 1 */
 int ogs_nas_5gs_decode_ue_radio_capability_id_deletion_indication(ogs_nas_ue_radio_capability_id_deletion_indication_t *ue_radio_capability_id_deletion_indication, ogs_pkbuf_t *pkbuf)
@@ -2949,6 +3395,11 @@ int ogs_nas_5gs_encode_ue_radio_capability_id_deletion_indication(ogs_pkbuf_t *p
     return size;
 }
 
+int ogs_nas_5gs_length_ue_radio_capability_id_deletion_indication(ogs_nas_ue_radio_capability_id_deletion_indication_t *ue_radio_capability_id_deletion_indication)
+{
+    return sizeof(ogs_nas_ue_radio_capability_id_deletion_indication_t);
+}
+
 /* 9.11.3.7 5GS registration type
  * M V 1/2 */
 int ogs_nas_5gs_decode_5gs_registration_type(ogs_nas_5gs_registration_type_t *registration_type, ogs_pkbuf_t *pkbuf)
@@ -2983,6 +3434,11 @@ int ogs_nas_5gs_encode_5gs_registration_type(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_reg
     return size;
 }
 
+int ogs_nas_5gs_length_5gs_registration_type(ogs_nas_5gs_registration_type_t *registration_type)
+{
+    return sizeof(ogs_nas_5gs_registration_type_t);
+}
+
 /* 9.11.3.70 Truncated 5G-S-TMSI configuration
  * O TLV 3 */
 int ogs_nas_5gs_decode_truncated_5g_s_tmsi_configuration(ogs_nas_truncated_5g_s_tmsi_configuration_t *truncated_s_tmsi_configuration, ogs_pkbuf_t *pkbuf)
@@ -3022,6 +3478,13 @@ int ogs_nas_5gs_encode_truncated_5g_s_tmsi_configuration(ogs_pkbuf_t *pkbuf, ogs
     return size;
 }
 
+int ogs_nas_5gs_length_truncated_5g_s_tmsi_configuration(ogs_nas_truncated_5g_s_tmsi_configuration_t *truncated_s_tmsi_configuration)
+{
+    int size = truncated_s_tmsi_configuration->length + sizeof(truncated_s_tmsi_configuration->length);
+
+    return size;
+}
+
 /* 9.11.3.71 WUS assistance information
  * O TLV 3-n */
 int ogs_nas_5gs_decode_wus_assistance_information(ogs_nas_wus_assistance_information_t *wus_assistance_information, ogs_pkbuf_t *pkbuf)
@@ -3061,6 +3524,13 @@ int ogs_nas_5gs_encode_wus_assistance_information(ogs_pkbuf_t *pkbuf, ogs_nas_wu
     return size;
 }
 
+int ogs_nas_5gs_length_wus_assistance_information(ogs_nas_wus_assistance_information_t *wus_assistance_information)
+{
+    int size = wus_assistance_information->length + sizeof(wus_assistance_information->length);
+
+    return size;
+}
+
 /* 9.11.3.72 N5GC indication
  * O TV 1 */
 int ogs_nas_5gs_decode_n5gc_indication(ogs_nas_n5gc_indication_t *n5gc_indication, ogs_pkbuf_t *pkbuf)
@@ -3093,6 +3563,11 @@ int ogs_nas_5gs_encode_n5gc_indication(ogs_pkbuf_t *pkbuf, ogs_nas_n5gc_indicati
     return size;
 }
 
+int ogs_nas_5gs_length_n5gc_indication(ogs_nas_n5gc_indication_t *n5gc_indication)
+{
+    return sizeof(ogs_nas_n5gc_indication_t);
+}
+
 /* 9.11.3.73 NB-N1 mode DRX parameters
  * O TLV 3 */
 int ogs_nas_5gs_decode_nb_n1_mode_drx_parameters(ogs_nas_nb_n1_mode_drx_parameters_t *nb_n1_mode_drx_parameters, ogs_pkbuf_t *pkbuf)
@@ -3132,6 +3607,13 @@ int ogs_nas_5gs_encode_nb_n1_mode_drx_parameters(ogs_pkbuf_t *pkbuf, ogs_nas_nb_
     return size;
 }
 
+int ogs_nas_5gs_length_nb_n1_mode_drx_parameters(ogs_nas_nb_n1_mode_drx_parameters_t *nb_n1_mode_drx_parameters)
+{
+    int size = nb_n1_mode_drx_parameters->length + sizeof(nb_n1_mode_drx_parameters->length);
+
+    return size;
+}
+
 /* 9.11.3.74 Additional configuration indication
  * O TV 1 */
 int ogs_nas_5gs_decode_additional_configuration_indication(ogs_nas_additional_configuration_indication_t *additional_configuration_indication, ogs_pkbuf_t *pkbuf)
@@ -3164,6 +3646,11 @@ int ogs_nas_5gs_encode_additional_configuration_indication(ogs_pkbuf_t *pkbuf, o
     return size;
 }
 
+int ogs_nas_5gs_length_additional_configuration_indication(ogs_nas_additional_configuration_indication_t *additional_configuration_indication)
+{
+    return sizeof(ogs_nas_additional_configuration_indication_t);
+}
+
 /* 9.11.3.75 Extended rejected NSSAI
  * O TLV 5-90 */
 int ogs_nas_5gs_decode_extended_rejected_nssai(ogs_nas_extended_rejected_nssai_t *extended_rejected_nssai, ogs_pkbuf_t *pkbuf)
@@ -3203,6 +3690,13 @@ int ogs_nas_5gs_encode_extended_rejected_nssai(ogs_pkbuf_t *pkbuf, ogs_nas_exten
     return size;
 }
 
+int ogs_nas_5gs_length_extended_rejected_nssai(ogs_nas_extended_rejected_nssai_t *extended_rejected_nssai)
+{
+    int size = extended_rejected_nssai->length + sizeof(extended_rejected_nssai->length);
+
+    return size;
+}
+
 /* 9.11.3.76 UE request type
  * O TLV 3 */
 int ogs_nas_5gs_decode_ue_request_type(ogs_nas_ue_request_type_t *ue_request_type, ogs_pkbuf_t *pkbuf)
@@ -3242,6 +3736,13 @@ int ogs_nas_5gs_encode_ue_request_type(ogs_pkbuf_t *pkbuf, ogs_nas_ue_request_ty
     return size;
 }
 
+int ogs_nas_5gs_length_ue_request_type(ogs_nas_ue_request_type_t *ue_request_type)
+{
+    int size = ue_request_type->length + sizeof(ue_request_type->length);
+
+    return size;
+}
+
 /* 9.11.3.77 Paging restriction
  * O TLV 3-35 */
 int ogs_nas_5gs_decode_paging_restriction(ogs_nas_paging_restriction_t *paging_restriction, ogs_pkbuf_t *pkbuf)
@@ -3281,6 +3782,13 @@ int ogs_nas_5gs_encode_paging_restriction(ogs_pkbuf_t *pkbuf, ogs_nas_paging_res
     return size;
 }
 
+int ogs_nas_5gs_length_paging_restriction(ogs_nas_paging_restriction_t *paging_restriction)
+{
+    int size = paging_restriction->length + sizeof(paging_restriction->length);
+
+    return size;
+}
+
 /* 9.11.3.79 NID
  * O TLV 8 */
 int ogs_nas_5gs_decode_nid(ogs_nas_nid_t *nid, ogs_pkbuf_t *pkbuf)
@@ -3320,6 +3828,13 @@ int ogs_nas_5gs_encode_nid(ogs_pkbuf_t *pkbuf, ogs_nas_nid_t *nid)
     return size;
 }
 
+int ogs_nas_5gs_length_nid(ogs_nas_nid_t *nid)
+{
+    int size = nid->length + sizeof(nid->length);
+
+    return size;
+}
+
 /* 9.11.3.8 5GS tracking area identity
  * O TV 7 */
 int ogs_nas_5gs_decode_5gs_tracking_area_identity(ogs_nas_5gs_tracking_area_identity_t *tracking_area_identity, ogs_pkbuf_t *pkbuf)
@@ -3358,6 +3873,11 @@ int ogs_nas_5gs_encode_5gs_tracking_area_identity(ogs_pkbuf_t *pkbuf, ogs_nas_5g
     return size;
 }
 
+int ogs_nas_5gs_length_5gs_tracking_area_identity(ogs_nas_5gs_tracking_area_identity_t *tracking_area_identity)
+{
+    return sizeof(ogs_nas_5gs_tracking_area_identity_t);
+}
+
 /* 9.11.3.80 PEIPS assistance information
  * O TLV 3-n */
 int ogs_nas_5gs_decode_peips_assistance_information(ogs_nas_peips_assistance_information_t *peips_assistance_information, ogs_pkbuf_t *pkbuf)
@@ -3397,6 +3917,13 @@ int ogs_nas_5gs_encode_peips_assistance_information(ogs_pkbuf_t *pkbuf, ogs_nas_
     return size;
 }
 
+int ogs_nas_5gs_length_peips_assistance_information(ogs_nas_peips_assistance_information_t *peips_assistance_information)
+{
+    int size = peips_assistance_information->length + sizeof(peips_assistance_information->length);
+
+    return size;
+}
+
 /* 9.11.3.81 5GS additional request result
  * O TLV 3 */
 int ogs_nas_5gs_decode_5gs_additional_request_result(ogs_nas_5gs_additional_request_result_t *additional_request_result, ogs_pkbuf_t *pkbuf)
@@ -3436,6 +3963,13 @@ int ogs_nas_5gs_encode_5gs_additional_request_result(ogs_pkbuf_t *pkbuf, ogs_nas
     return size;
 }
 
+int ogs_nas_5gs_length_5gs_additional_request_result(ogs_nas_5gs_additional_request_result_t *additional_request_result)
+{
+    int size = additional_request_result->length + sizeof(additional_request_result->length);
+
+    return size;
+}
+
 /* 9.11.3.82 NSSRG information
  * O TLV-E 7-4099 */
 int ogs_nas_5gs_decode_nssrg_information(ogs_nas_nssrg_information_t *nssrg_information, ogs_pkbuf_t *pkbuf)
@@ -3482,6 +4016,11 @@ int ogs_nas_5gs_encode_nssrg_information(ogs_pkbuf_t *pkbuf, ogs_nas_nssrg_infor
     return nssrg_information->length + sizeof(nssrg_information->length);
 }
 
+int ogs_nas_5gs_length_nssrg_information(ogs_nas_nssrg_information_t *nssrg_information)
+{
+    return nssrg_information->length + sizeof(nssrg_information->length);
+}
+
 /* 9.11.3.83 List of PLMNs to be used in disaster condition
  * O TLV 2-n */
 int ogs_nas_5gs_decode_list_of_plmns_to_be_used_in_disaster_condition(ogs_nas_list_of_plmns_to_be_used_in_disaster_condition_t *list_of_plmns_to_be_used_in_disaster_condition, ogs_pkbuf_t *pkbuf)
@@ -3521,6 +4060,13 @@ int ogs_nas_5gs_encode_list_of_plmns_to_be_used_in_disaster_condition(ogs_pkbuf_
     return size;
 }
 
+int ogs_nas_5gs_length_list_of_plmns_to_be_used_in_disaster_condition(ogs_nas_list_of_plmns_to_be_used_in_disaster_condition_t *list_of_plmns_to_be_used_in_disaster_condition)
+{
+    int size = list_of_plmns_to_be_used_in_disaster_condition->length + sizeof(list_of_plmns_to_be_used_in_disaster_condition->length);
+
+    return size;
+}
+
 /* 9.11.3.84 Registration wait range
  * O TLV 4 */
 int ogs_nas_5gs_decode_registration_wait_range(ogs_nas_registration_wait_range_t *registration_wait_range, ogs_pkbuf_t *pkbuf)
@@ -3560,6 +4106,13 @@ int ogs_nas_5gs_encode_registration_wait_range(ogs_pkbuf_t *pkbuf, ogs_nas_regis
     return size;
 }
 
+int ogs_nas_5gs_length_registration_wait_range(ogs_nas_registration_wait_range_t *registration_wait_range)
+{
+    int size = registration_wait_range->length + sizeof(registration_wait_range->length);
+
+    return size;
+}
+
 /* 9.11.3.85 PLMN identity
  * O TLV 5 */
 int ogs_nas_5gs_decode_plmn_identity(ogs_nas_plmn_identity_t *plmn_identity, ogs_pkbuf_t *pkbuf)
@@ -3599,6 +4152,13 @@ int ogs_nas_5gs_encode_plmn_identity(ogs_pkbuf_t *pkbuf, ogs_nas_plmn_identity_t
     return size;
 }
 
+int ogs_nas_5gs_length_plmn_identity(ogs_nas_plmn_identity_t *plmn_identity)
+{
+    int size = plmn_identity->length + sizeof(plmn_identity->length);
+
+    return size;
+}
+
 /* 9.11.3.86 Extended CAG information list
  * O TLV-E 3-n */
 int ogs_nas_5gs_decode_extended_cag_information_list(ogs_nas_extended_cag_information_list_t *extended_cag_information_list, ogs_pkbuf_t *pkbuf)
@@ -3645,6 +4205,11 @@ int ogs_nas_5gs_encode_extended_cag_information_list(ogs_pkbuf_t *pkbuf, ogs_nas
     return extended_cag_information_list->length + sizeof(extended_cag_information_list->length);
 }
 
+int ogs_nas_5gs_length_extended_cag_information_list(ogs_nas_extended_cag_information_list_t *extended_cag_information_list)
+{
+    return extended_cag_information_list->length + sizeof(extended_cag_information_list->length);
+}
+
 /* 9.11.3.87 NSAG information
  * O TLV-E 9-3143 */
 int ogs_nas_5gs_decode_nsag_information(ogs_nas_nsag_information_t *nsag_information, ogs_pkbuf_t *pkbuf)
@@ -3691,6 +4256,11 @@ int ogs_nas_5gs_encode_nsag_information(ogs_pkbuf_t *pkbuf, ogs_nas_nsag_informa
     return nsag_information->length + sizeof(nsag_information->length);
 }
 
+int ogs_nas_5gs_length_nsag_information(ogs_nas_nsag_information_t *nsag_information)
+{
+    return nsag_information->length + sizeof(nsag_information->length);
+}
+
 /* 9.11.3.9 5GS tracking area identity list
  * O TLV 9-114 */
 int ogs_nas_5gs_decode_5gs_tracking_area_identity_list(ogs_nas_5gs_tracking_area_identity_list_t *tracking_area_identity_list, ogs_pkbuf_t *pkbuf)
@@ -3730,6 +4300,13 @@ int ogs_nas_5gs_encode_5gs_tracking_area_identity_list(ogs_pkbuf_t *pkbuf, ogs_n
     return size;
 }
 
+int ogs_nas_5gs_length_5gs_tracking_area_identity_list(ogs_nas_5gs_tracking_area_identity_list_t *tracking_area_identity_list)
+{
+    int size = tracking_area_identity_list->length + sizeof(tracking_area_identity_list->length);
+
+    return size;
+}
+
 /* 9.11.3.91 Priority indicator
  * O TV 1 */
 int ogs_nas_5gs_decode_priority_indicator(ogs_nas_priority_indicator_t *priority_indicator, ogs_pkbuf_t *pkbuf)
@@ -3762,6 +4339,11 @@ int ogs_nas_5gs_encode_priority_indicator(ogs_pkbuf_t *pkbuf, ogs_nas_priority_i
     return size;
 }
 
+int ogs_nas_5gs_length_priority_indicator(ogs_nas_priority_indicator_t *priority_indicator)
+{
+    return sizeof(ogs_nas_priority_indicator_t);
+}
+
 /* 9.11.3.9A 5GS update type
  * O TLV 3 */
 int ogs_nas_5gs_decode_5gs_update_type(ogs_nas_5gs_update_type_t *update_type, ogs_pkbuf_t *pkbuf)
@@ -3801,6 +4383,13 @@ int ogs_nas_5gs_encode_5gs_update_type(ogs_pkbuf_t *pkbuf, ogs_nas_5gs_update_ty
     return size;
 }
 
+int ogs_nas_5gs_length_5gs_update_type(ogs_nas_5gs_update_type_t *update_type)
+{
+    int size = update_type->length + sizeof(update_type->length);
+
+    return size;
+}
+
 /* 9.11.4.1 5GSM capability
  * O TLV 3-15 */
 int ogs_nas_5gs_decode_5gsm_capability(ogs_nas_5gsm_capability_t *gsm_capability, ogs_pkbuf_t *pkbuf)
@@ -3840,6 +4429,13 @@ int ogs_nas_5gs_encode_5gsm_capability(ogs_pkbuf_t *pkbuf, ogs_nas_5gsm_capabili
     return size;
 }
 
+int ogs_nas_5gs_length_5gsm_capability(ogs_nas_5gsm_capability_t *gsm_capability)
+{
+    int size = gsm_capability->length + sizeof(gsm_capability->length);
+
+    return size;
+}
+
 /* 9.11.4.10 PDU address
  * O TLV 11 */
 int ogs_nas_5gs_decode_pdu_address(ogs_nas_pdu_address_t *pdu_address, ogs_pkbuf_t *pkbuf)
@@ -3879,6 +4475,13 @@ int ogs_nas_5gs_encode_pdu_address(ogs_pkbuf_t *pkbuf, ogs_nas_pdu_address_t *pd
     return size;
 }
 
+int ogs_nas_5gs_length_pdu_address(ogs_nas_pdu_address_t *pdu_address)
+{
+    int size = pdu_address->length + sizeof(pdu_address->length);
+
+    return size;
+}
+
 /* 9.11.4.11 PDU session type
  * O TV 1 */
 int ogs_nas_5gs_decode_pdu_session_type(ogs_nas_pdu_session_type_t *pdu_session_type, ogs_pkbuf_t *pkbuf)
@@ -3911,6 +4514,11 @@ int ogs_nas_5gs_encode_pdu_session_type(ogs_pkbuf_t *pkbuf, ogs_nas_pdu_session_
     return size;
 }
 
+int ogs_nas_5gs_length_pdu_session_type(ogs_nas_pdu_session_type_t *pdu_session_type)
+{
+    return sizeof(ogs_nas_pdu_session_type_t);
+}
+
 /* 9.11.4.12 QoS flow descriptions
  * O TLV-E 6-65538 */
 int ogs_nas_5gs_decode_qos_flow_descriptions(ogs_nas_qos_flow_descriptions_t *qos_flow_descriptions, ogs_pkbuf_t *pkbuf)
@@ -3957,6 +4565,11 @@ int ogs_nas_5gs_encode_qos_flow_descriptions(ogs_pkbuf_t *pkbuf, ogs_nas_qos_flo
     return qos_flow_descriptions->length + sizeof(qos_flow_descriptions->length);
 }
 
+int ogs_nas_5gs_length_qos_flow_descriptions(ogs_nas_qos_flow_descriptions_t *qos_flow_descriptions)
+{
+    return qos_flow_descriptions->length + sizeof(qos_flow_descriptions->length);
+}
+
 /* 9.11.4.13 QoS rules
  * M LV-E 6-65538 */
 int ogs_nas_5gs_decode_qos_rules(ogs_nas_qos_rules_t *qos_rules, ogs_pkbuf_t *pkbuf)
@@ -4003,6 +4616,11 @@ int ogs_nas_5gs_encode_qos_rules(ogs_pkbuf_t *pkbuf, ogs_nas_qos_rules_t *qos_ru
     return qos_rules->length + sizeof(qos_rules->length);
 }
 
+int ogs_nas_5gs_length_qos_rules(ogs_nas_qos_rules_t *qos_rules)
+{
+    return qos_rules->length + sizeof(qos_rules->length);
+}
+
 /* 9.11.4.14 Session-AMBR
  * M LV 7 */
 int ogs_nas_5gs_decode_session_ambr(ogs_nas_session_ambr_t *session_ambr, ogs_pkbuf_t *pkbuf)
@@ -4048,6 +4666,13 @@ int ogs_nas_5gs_encode_session_ambr(ogs_pkbuf_t *pkbuf, ogs_nas_session_ambr_t *
     return size;
 }
 
+int ogs_nas_5gs_length_session_ambr(ogs_nas_session_ambr_t *session_ambr)
+{
+    int size = session_ambr->length + sizeof(session_ambr->length);
+
+    return size;
+}
+
 /* 9.11.4.15 SM PDU DN request container
  * O TLV 3-255 */
 int ogs_nas_5gs_decode_sm_pdu_dn_request_container(ogs_nas_sm_pdu_dn_request_container_t *sm_pdu_dn_request_container, ogs_pkbuf_t *pkbuf)
@@ -4087,6 +4712,13 @@ int ogs_nas_5gs_encode_sm_pdu_dn_request_container(ogs_pkbuf_t *pkbuf, ogs_nas_s
     return size;
 }
 
+int ogs_nas_5gs_length_sm_pdu_dn_request_container(ogs_nas_sm_pdu_dn_request_container_t *sm_pdu_dn_request_container)
+{
+    int size = sm_pdu_dn_request_container->length + sizeof(sm_pdu_dn_request_container->length);
+
+    return size;
+}
+
 /* 9.11.4.16 SSC mode
  * O TV 1 */
 int ogs_nas_5gs_decode_ssc_mode(ogs_nas_ssc_mode_t *ssc_mode, ogs_pkbuf_t *pkbuf)
@@ -4119,6 +4751,11 @@ int ogs_nas_5gs_encode_ssc_mode(ogs_pkbuf_t *pkbuf, ogs_nas_ssc_mode_t *ssc_mode
     return size;
 }
 
+int ogs_nas_5gs_length_ssc_mode(ogs_nas_ssc_mode_t *ssc_mode)
+{
+    return sizeof(ogs_nas_ssc_mode_t);
+}
+
 /* 9.11.4.17 Re-attempt indicator
  * O TLV 3 */
 int ogs_nas_5gs_decode_re_attempt_indicator(ogs_nas_re_attempt_indicator_t *re_attempt_indicator, ogs_pkbuf_t *pkbuf)
@@ -4158,6 +4795,13 @@ int ogs_nas_5gs_encode_re_attempt_indicator(ogs_pkbuf_t *pkbuf, ogs_nas_re_attem
     return size;
 }
 
+int ogs_nas_5gs_length_re_attempt_indicator(ogs_nas_re_attempt_indicator_t *re_attempt_indicator)
+{
+    int size = re_attempt_indicator->length + sizeof(re_attempt_indicator->length);
+
+    return size;
+}
+
 /* 9.11.4.18 5GSM network feature support
  * O TLV 3-15 */
 int ogs_nas_5gs_decode_5gsm_network_feature_support(ogs_nas_5gsm_network_feature_support_t *gsm_network_feature_support, ogs_pkbuf_t *pkbuf)
@@ -4197,6 +4841,13 @@ int ogs_nas_5gs_encode_5gsm_network_feature_support(ogs_pkbuf_t *pkbuf, ogs_nas_
     return size;
 }
 
+int ogs_nas_5gs_length_5gsm_network_feature_support(ogs_nas_5gsm_network_feature_support_t *gsm_network_feature_support)
+{
+    int size = gsm_network_feature_support->length + sizeof(gsm_network_feature_support->length);
+
+    return size;
+}
+
 /* 9.11.4.2 5GSM cause
  * O TV 2 */
 int ogs_nas_5gs_decode_5gsm_cause(ogs_nas_5gsm_cause_t *gsm_cause, ogs_pkbuf_t *pkbuf)
@@ -4231,6 +4882,11 @@ int ogs_nas_5gs_encode_5gsm_cause(ogs_pkbuf_t *pkbuf, ogs_nas_5gsm_cause_t *gsm_
     return size;
 }
 
+int ogs_nas_5gs_length_5gsm_cause(ogs_nas_5gsm_cause_t *gsm_cause)
+{
+    return sizeof(ogs_nas_5gsm_cause_t);
+}
+
 /* 9.11.4.20 Serving PLMN rate control
  * O TLV 4 */
 int ogs_nas_5gs_decode_serving_plmn_rate_control(ogs_nas_serving_plmn_rate_control_t *serving_plmn_rate_control, ogs_pkbuf_t *pkbuf)
@@ -4270,6 +4926,13 @@ int ogs_nas_5gs_encode_serving_plmn_rate_control(ogs_pkbuf_t *pkbuf, ogs_nas_ser
     return size;
 }
 
+int ogs_nas_5gs_length_serving_plmn_rate_control(ogs_nas_serving_plmn_rate_control_t *serving_plmn_rate_control)
+{
+    int size = serving_plmn_rate_control->length + sizeof(serving_plmn_rate_control->length);
+
+    return size;
+}
+
 /* 9.11.4.21 5GSM congestion re-attempt indicator
  * O TLV 3 */
 int ogs_nas_5gs_decode_5gsm_congestion_re_attempt_indicator(ogs_nas_5gsm_congestion_re_attempt_indicator_t *gsm_congestion_re_attempt_indicator, ogs_pkbuf_t *pkbuf)
@@ -4309,6 +4972,13 @@ int ogs_nas_5gs_encode_5gsm_congestion_re_attempt_indicator(ogs_pkbuf_t *pkbuf,
     return size;
 }
 
+int ogs_nas_5gs_length_5gsm_congestion_re_attempt_indicator(ogs_nas_5gsm_congestion_re_attempt_indicator_t *gsm_congestion_re_attempt_indicator)
+{
+    int size = gsm_congestion_re_attempt_indicator->length + sizeof(gsm_congestion_re_attempt_indicator->length);
+
+    return size;
+}
+
 /* 9.11.4.22 ATSSS container
  * O TLV-E 3-65538 */
 int ogs_nas_5gs_decode_atsss_container(ogs_nas_atsss_container_t *atsss_container, ogs_pkbuf_t *pkbuf)
@@ -4355,6 +5025,11 @@ int ogs_nas_5gs_encode_atsss_container(ogs_pkbuf_t *pkbuf, ogs_nas_atsss_contain
     return atsss_container->length + sizeof(atsss_container->length);
 }
 
+int ogs_nas_5gs_length_atsss_container(ogs_nas_atsss_container_t *atsss_container)
+{
+    return atsss_container->length + sizeof(atsss_container->length);
+}
+
 /* 9.11.4.23 Control plane only indication
  * O TV 1 */
 int ogs_nas_5gs_decode_control_plane_only_indication(ogs_nas_control_plane_only_indication_t *control_plane_only_indication, ogs_pkbuf_t *pkbuf)
@@ -4387,6 +5062,11 @@ int ogs_nas_5gs_encode_control_plane_only_indication(ogs_pkbuf_t *pkbuf, ogs_nas
     return size;
 }
 
+int ogs_nas_5gs_length_control_plane_only_indication(ogs_nas_control_plane_only_indication_t *control_plane_only_indication)
+{
+    return sizeof(ogs_nas_control_plane_only_indication_t);
+}
+
 /* 9.11.4.24 IP header compression configuration
  * O TLV 5-257 */
 int ogs_nas_5gs_decode_ip_header_compression_configuration(ogs_nas_ip_header_compression_configuration_t *ip_header_compression_configuration, ogs_pkbuf_t *pkbuf)
@@ -4426,6 +5106,13 @@ int ogs_nas_5gs_encode_ip_header_compression_configuration(ogs_pkbuf_t *pkbuf, o
     return size;
 }
 
+int ogs_nas_5gs_length_ip_header_compression_configuration(ogs_nas_ip_header_compression_configuration_t *ip_header_compression_configuration)
+{
+    int size = ip_header_compression_configuration->length + sizeof(ip_header_compression_configuration->length);
+
+    return size;
+}
+
 /* 9.11.4.24 Header compression configuration
  * O TLV 5-257 */
 int ogs_nas_5gs_decode_header_compression_configuration(ogs_nas_header_compression_configuration_t *header_compression_configuration, ogs_pkbuf_t *pkbuf)
@@ -4469,6 +5156,13 @@ int ogs_nas_5gs_encode_header_compression_configuration(ogs_pkbuf_t *pkbuf, ogs_
     return size;
 }
 
+int ogs_nas_5gs_length_header_compression_configuration(ogs_nas_header_compression_configuration_t *header_compression_configuration)
+{
+    int size = header_compression_configuration->length + sizeof(header_compression_configuration->length);
+
+    return size;
+}
+
 /* 9.11.4.25 DS-TT Ethernet port MAC address
  * O TLV 8 */
 int ogs_nas_5gs_decode_ds_tt_ethernet_port_mac_address(ogs_nas_ds_tt_ethernet_port_mac_address_t *ds_tt_ethernet_port_mac_address, ogs_pkbuf_t *pkbuf)
@@ -4508,6 +5202,13 @@ int ogs_nas_5gs_encode_ds_tt_ethernet_port_mac_address(ogs_pkbuf_t *pkbuf, ogs_n
     return size;
 }
 
+int ogs_nas_5gs_length_ds_tt_ethernet_port_mac_address(ogs_nas_ds_tt_ethernet_port_mac_address_t *ds_tt_ethernet_port_mac_address)
+{
+    int size = ds_tt_ethernet_port_mac_address->length + sizeof(ds_tt_ethernet_port_mac_address->length);
+
+    return size;
+}
+
 /* 9.11.4.26 UE-DS-TT residence time
  * O TLV 10 */
 int ogs_nas_5gs_decode_ue_ds_tt_residence_time(ogs_nas_ue_ds_tt_residence_time_t *ue_ds_tt_residence_time, ogs_pkbuf_t *pkbuf)
@@ -4547,6 +5248,13 @@ int ogs_nas_5gs_encode_ue_ds_tt_residence_time(ogs_pkbuf_t *pkbuf, ogs_nas_ue_ds
     return size;
 }
 
+int ogs_nas_5gs_length_ue_ds_tt_residence_time(ogs_nas_ue_ds_tt_residence_time_t *ue_ds_tt_residence_time)
+{
+    int size = ue_ds_tt_residence_time->length + sizeof(ue_ds_tt_residence_time->length);
+
+    return size;
+}
+
 /* 9.11.4.27 Port management information container
  * O TLV-E 8-65538 */
 int ogs_nas_5gs_decode_port_management_information_container(ogs_nas_port_management_information_container_t *port_management_information_container, ogs_pkbuf_t *pkbuf)
@@ -4593,6 +5301,11 @@ int ogs_nas_5gs_encode_port_management_information_container(ogs_pkbuf_t *pkbuf,
     return port_management_information_container->length + sizeof(port_management_information_container->length);
 }
 
+int ogs_nas_5gs_length_port_management_information_container(ogs_nas_port_management_information_container_t *port_management_information_container)
+{
+    return port_management_information_container->length + sizeof(port_management_information_container->length);
+}
+
 /* 9.11.4.28 Ethernet header compression configuration
  * O TLV 3 */
 int ogs_nas_5gs_decode_ethernet_header_compression_configuration(ogs_nas_ethernet_header_compression_configuration_t *ethernet_header_compression_configuration, ogs_pkbuf_t *pkbuf)
@@ -4632,6 +5345,13 @@ int ogs_nas_5gs_encode_ethernet_header_compression_configuration(ogs_pkbuf_t *pk
     return size;
 }
 
+int ogs_nas_5gs_length_ethernet_header_compression_configuration(ogs_nas_ethernet_header_compression_configuration_t *ethernet_header_compression_configuration)
+{
+    int size = ethernet_header_compression_configuration->length + sizeof(ethernet_header_compression_configuration->length);
+
+    return size;
+}
+
 /* 9.11.4.3 Always-on PDU session indication
  * O TV 1 */
 int ogs_nas_5gs_decode_always_on_pdu_session_indication(ogs_nas_always_on_pdu_session_indication_t *always_on_pdu_session_indication, ogs_pkbuf_t *pkbuf)
@@ -4664,6 +5384,11 @@ int ogs_nas_5gs_encode_always_on_pdu_session_indication(ogs_pkbuf_t *pkbuf, ogs_
     return size;
 }
 
+int ogs_nas_5gs_length_always_on_pdu_session_indication(ogs_nas_always_on_pdu_session_indication_t *always_on_pdu_session_indication)
+{
+    return sizeof(ogs_nas_always_on_pdu_session_indication_t);
+}
+
 /* 9.11.4.30 Requested MBS container
  * O TLV-E 8-65538 */
 int ogs_nas_5gs_decode_requested_mbs_container(ogs_nas_requested_mbs_container_t *requested_mbs_container, ogs_pkbuf_t *pkbuf)
@@ -4710,6 +5435,11 @@ int ogs_nas_5gs_encode_requested_mbs_container(ogs_pkbuf_t *pkbuf, ogs_nas_reque
     return requested_mbs_container->length + sizeof(requested_mbs_container->length);
 }
 
+int ogs_nas_5gs_length_requested_mbs_container(ogs_nas_requested_mbs_container_t *requested_mbs_container)
+{
+    return requested_mbs_container->length + sizeof(requested_mbs_container->length);
+}
+
 /* 9.11.4.31 Received MBS container
  * O TLV-E 9-65538 */
 int ogs_nas_5gs_decode_received_mbs_container(ogs_nas_received_mbs_container_t *received_mbs_container, ogs_pkbuf_t *pkbuf)
@@ -4756,6 +5486,11 @@ int ogs_nas_5gs_encode_received_mbs_container(ogs_pkbuf_t *pkbuf, ogs_nas_receiv
     return received_mbs_container->length + sizeof(received_mbs_container->length);
 }
 
+int ogs_nas_5gs_length_received_mbs_container(ogs_nas_received_mbs_container_t *received_mbs_container)
+{
+    return received_mbs_container->length + sizeof(received_mbs_container->length);
+}
+
 /* 9.11.4.32 PDU session pair ID
  * O TLV 3 */
 int ogs_nas_5gs_decode_pdu_session_pair_id(ogs_nas_pdu_session_pair_id_t *pdu_session_pair_id, ogs_pkbuf_t *pkbuf)
@@ -4795,6 +5530,13 @@ int ogs_nas_5gs_encode_pdu_session_pair_id(ogs_pkbuf_t *pkbuf, ogs_nas_pdu_sessi
     return size;
 }
 
+int ogs_nas_5gs_length_pdu_session_pair_id(ogs_nas_pdu_session_pair_id_t *pdu_session_pair_id)
+{
+    int size = pdu_session_pair_id->length + sizeof(pdu_session_pair_id->length);
+
+    return size;
+}
+
 /* 9.11.4.33 RSN
  * O TLV 3 */
 int ogs_nas_5gs_decode_rsn(ogs_nas_rsn_t *rsn, ogs_pkbuf_t *pkbuf)
@@ -4834,6 +5576,13 @@ int ogs_nas_5gs_encode_rsn(ogs_pkbuf_t *pkbuf, ogs_nas_rsn_t *rsn)
     return size;
 }
 
+int ogs_nas_5gs_length_rsn(ogs_nas_rsn_t *rsn)
+{
+    int size = rsn->length + sizeof(rsn->length);
+
+    return size;
+}
+
 /* 9.11.4.4 Always-on PDU session requested
  * O TV 1 */
 int ogs_nas_5gs_decode_always_on_pdu_session_requested(ogs_nas_always_on_pdu_session_requested_t *always_on_pdu_session_requested, ogs_pkbuf_t *pkbuf)
@@ -4866,6 +5615,11 @@ int ogs_nas_5gs_encode_always_on_pdu_session_requested(ogs_pkbuf_t *pkbuf, ogs_n
     return size;
 }
 
+int ogs_nas_5gs_length_always_on_pdu_session_requested(ogs_nas_always_on_pdu_session_requested_t *always_on_pdu_session_requested)
+{
+    return sizeof(ogs_nas_always_on_pdu_session_requested_t);
+}
+
 /* 9.11.4.5 Allowed SSC mode
  * O TV 1 */
 int ogs_nas_5gs_decode_allowed_ssc_mode(ogs_nas_allowed_ssc_mode_t *allowed_ssc_mode, ogs_pkbuf_t *pkbuf)
@@ -4898,6 +5652,11 @@ int ogs_nas_5gs_encode_allowed_ssc_mode(ogs_pkbuf_t *pkbuf, ogs_nas_allowed_ssc_
     return size;
 }
 
+int ogs_nas_5gs_length_allowed_ssc_mode(ogs_nas_allowed_ssc_mode_t *allowed_ssc_mode)
+{
+    return sizeof(ogs_nas_allowed_ssc_mode_t);
+}
+
 /* 9.11.4.6 Extended protocol configuration options
  * O TLV-E 4-65538 */
 int ogs_nas_5gs_decode_extended_protocol_configuration_options(ogs_nas_extended_protocol_configuration_options_t *extended_protocol_configuration_options, ogs_pkbuf_t *pkbuf)
@@ -4944,6 +5703,11 @@ int ogs_nas_5gs_encode_extended_protocol_configuration_options(ogs_pkbuf_t *pkbu
     return extended_protocol_configuration_options->length + sizeof(extended_protocol_configuration_options->length);
 }
 
+int ogs_nas_5gs_length_extended_protocol_configuration_options(ogs_nas_extended_protocol_configuration_options_t *extended_protocol_configuration_options)
+{
+    return extended_protocol_configuration_options->length + sizeof(extended_protocol_configuration_options->length);
+}
+
 /* 9.11.4.7 Integrity protection maximum data rate
  * M V 2 */
 int ogs_nas_5gs_decode_integrity_protection_maximum_data_rate(ogs_nas_integrity_protection_maximum_data_rate_t *integrity_protection_maximum_data_rate, ogs_pkbuf_t *pkbuf)
@@ -4978,6 +5742,11 @@ int ogs_nas_5gs_encode_integrity_protection_maximum_data_rate(ogs_pkbuf_t *pkbuf
     return size;
 }
 
+int ogs_nas_5gs_length_integrity_protection_maximum_data_rate(ogs_nas_integrity_protection_maximum_data_rate_t *integrity_protection_maximum_data_rate)
+{
+    return sizeof(ogs_nas_integrity_protection_maximum_data_rate_t);
+}
+
 /* 9.11.4.8 Mapped EPS bearer contexts
  * O TLV-E 7-65538 */
 int ogs_nas_5gs_decode_mapped_eps_bearer_contexts(ogs_nas_mapped_eps_bearer_contexts_t *mapped_eps_bearer_contexts, ogs_pkbuf_t *pkbuf)
@@ -5024,6 +5793,11 @@ int ogs_nas_5gs_encode_mapped_eps_bearer_contexts(ogs_pkbuf_t *pkbuf, ogs_nas_ma
     return mapped_eps_bearer_contexts->length + sizeof(mapped_eps_bearer_contexts->length);
 }
 
+int ogs_nas_5gs_length_mapped_eps_bearer_contexts(ogs_nas_mapped_eps_bearer_contexts_t *mapped_eps_bearer_contexts)
+{
+    return mapped_eps_bearer_contexts->length + sizeof(mapped_eps_bearer_contexts->length);
+}
+
 /* 9.11.4.9 Maximum number of supported packet filters
  * O TV 3 */
 int ogs_nas_5gs_decode_maximum_number_of_supported_packet_filters(ogs_nas_maximum_number_of_supported_packet_filters_t *maximum_number_of_supported_packet_filters, ogs_pkbuf_t *pkbuf)
@@ -5058,3 +5832,8 @@ int ogs_nas_5gs_encode_maximum_number_of_supported_packet_filters(ogs_pkbuf_t *p
     return size;
 }
 
+int ogs_nas_5gs_length_maximum_number_of_supported_packet_filters(ogs_nas_maximum_number_of_supported_packet_filters_t *maximum_number_of_supported_packet_filters)
+{
+    return sizeof(ogs_nas_maximum_number_of_supported_packet_filters_t);
+}
+
@@ -305,6 +305,136 @@ int ogs_nas_5gs_encode_integrity_protection_maximum_data_rate(ogs_pkbuf_t *pkbuf
 int ogs_nas_5gs_encode_mapped_eps_bearer_contexts(ogs_pkbuf_t *pkbuf, ogs_nas_mapped_eps_bearer_contexts_t *mapped_eps_bearer_contexts);
 int ogs_nas_5gs_encode_maximum_number_of_supported_packet_filters(ogs_pkbuf_t *pkbuf, ogs_nas_maximum_number_of_supported_packet_filters_t *maximum_number_of_supported_packet_filters);
 
+int ogs_nas_5gs_length_additional_information(ogs_nas_additional_information_t *additional_information);
+int ogs_nas_5gs_length_service_level_aa_container(ogs_nas_service_level_aa_container_t *service_level_aa_container);
+int ogs_nas_5gs_length_access_type(ogs_nas_access_type_t *access_type);
+int ogs_nas_5gs_length_dnn(ogs_nas_dnn_t *dnn);
+int ogs_nas_5gs_length_eap_message(ogs_nas_eap_message_t *eap_message);
+int ogs_nas_5gs_length_gprs_timer(ogs_nas_gprs_timer_t *gprs_timer);
+int ogs_nas_5gs_length_gprs_timer_2(ogs_nas_gprs_timer_2_t *gprs_timer_2);
+int ogs_nas_5gs_length_gprs_timer_3(ogs_nas_gprs_timer_3_t *gprs_timer_3);
+int ogs_nas_5gs_length_s_nssai(ogs_nas_s_nssai_t *s_nssai);
+int ogs_nas_5gs_length_5gmm_capability(ogs_nas_5gmm_capability_t *gmm_capability);
+int ogs_nas_5gs_length_abba(ogs_nas_abba_t *abba);
+int ogs_nas_5gs_length_additional_5g_security_information(ogs_nas_additional_5g_security_information_t *additional_security_information);
+int ogs_nas_5gs_length_additional_information_requested(ogs_nas_additional_information_requested_t *additional_information_requested);
+int ogs_nas_5gs_length_allowed_pdu_session_status(ogs_nas_allowed_pdu_session_status_t *allowed_pdu_session_status);
+int ogs_nas_5gs_length_authentication_failure_parameter(ogs_nas_authentication_failure_parameter_t *authentication_failure_parameter);
+int ogs_nas_5gs_length_authentication_parameter_autn(ogs_nas_authentication_parameter_autn_t *authentication_parameter_autn);
+int ogs_nas_5gs_length_authentication_parameter_rand(ogs_nas_authentication_parameter_rand_t *authentication_parameter_rand);
+int ogs_nas_5gs_length_authentication_response_parameter(ogs_nas_authentication_response_parameter_t *authentication_response_parameter);
+int ogs_nas_5gs_length_configuration_update_indication(ogs_nas_configuration_update_indication_t *configuration_update_indication);
+int ogs_nas_5gs_length_cag_information_list(ogs_nas_cag_information_list_t *cag_information_list);
+int ogs_nas_5gs_length_ciphering_key_data(ogs_nas_ciphering_key_data_t *ciphering_key_data);
+int ogs_nas_5gs_length_daylight_saving_time(ogs_nas_daylight_saving_time_t *daylight_saving_time);
+int ogs_nas_5gs_length_5gmm_cause(ogs_nas_5gmm_cause_t *gmm_cause);
+int ogs_nas_5gs_length_de_registration_type(ogs_nas_de_registration_type_t *de_registration_type);
+int ogs_nas_5gs_length_emergency_number_list(ogs_nas_emergency_number_list_t *emergency_number_list);
+int ogs_nas_5gs_length_eps_bearer_context_status(ogs_nas_eps_bearer_context_status_t *eps_bearer_context_status);
+int ogs_nas_5gs_length_eps_nas_message_container(ogs_nas_eps_nas_message_container_t *eps_nas_message_container);
+int ogs_nas_5gs_length_eps_nas_security_algorithms(ogs_nas_eps_nas_security_algorithms_t *eps_nas_security_algorithms);
+int ogs_nas_5gs_length_extended_emergency_number_list(ogs_nas_extended_emergency_number_list_t *extended_emergency_number_list);
+int ogs_nas_5gs_length_extended_drx_parameters(ogs_nas_extended_drx_parameters_t *extended_drx_parameters);
+int ogs_nas_5gs_length_imeisv_request(ogs_nas_imeisv_request_t *imeisv_request);
+int ogs_nas_5gs_length_ladn_indication(ogs_nas_ladn_indication_t *ladn_indication);
+int ogs_nas_5gs_length_5gs_drx_parameters(ogs_nas_5gs_drx_parameters_t *drx_parameters);
+int ogs_nas_5gs_length_5gs_identity_type(ogs_nas_5gs_identity_type_t *identity_type);
+int ogs_nas_5gs_length_ladn_information(ogs_nas_ladn_information_t *ladn_information);
+int ogs_nas_5gs_length_mico_indication(ogs_nas_mico_indication_t *mico_indication);
+int ogs_nas_5gs_length_ma_pdu_session_information(ogs_nas_ma_pdu_session_information_t *ma_pdu_session_information);
+int ogs_nas_5gs_length_mapped_nssai(ogs_nas_mapped_nssai_t *mapped_nssai);
+int ogs_nas_5gs_length_mobile_station_classmark_2(ogs_nas_mobile_station_classmark_2_t *mobile_station_classmark_2);
+int ogs_nas_5gs_length_key_set_identifier(ogs_nas_key_set_identifier_t *key_set_identifier);
+int ogs_nas_5gs_length_message_container(ogs_nas_message_container_t *message_container);
+int ogs_nas_5gs_length_security_algorithms(ogs_nas_security_algorithms_t *security_algorithms);
+int ogs_nas_5gs_length_network_name(ogs_nas_network_name_t *network_name);
+int ogs_nas_5gs_length_network_slicing_indication(ogs_nas_network_slicing_indication_t *network_slicing_indication);
+int ogs_nas_5gs_length_non_3gpp_nw_provided_policies(ogs_nas_non_3gpp_nw_provided_policies_t *non_3gpp_nw_provided_policies);
+int ogs_nas_5gs_length_nssai(ogs_nas_nssai_t *nssai);
+int ogs_nas_5gs_length_nssai_inclusion_mode(ogs_nas_nssai_inclusion_mode_t *nssai_inclusion_mode);
+int ogs_nas_5gs_length_operator_defined_access_category_definitions(ogs_nas_operator_defined_access_category_definitions_t *operator_defined_access_category_definitions);
+int ogs_nas_5gs_length_payload_container(ogs_nas_payload_container_t *payload_container);
+int ogs_nas_5gs_length_5gs_mobile_identity(ogs_nas_5gs_mobile_identity_t *mobile_identity);
+int ogs_nas_5gs_length_payload_container_type(ogs_nas_payload_container_type_t *payload_container_type);
+int ogs_nas_5gs_length_pdu_session_identity_2(ogs_nas_pdu_session_identity_2_t *pdu_session_identity_2);
+int ogs_nas_5gs_length_pdu_session_reactivation_result(ogs_nas_pdu_session_reactivation_result_t *pdu_session_reactivation_result);
+int ogs_nas_5gs_length_pdu_session_reactivation_result_error_cause(ogs_nas_pdu_session_reactivation_result_error_cause_t *pdu_session_reactivation_result_error_cause);
+int ogs_nas_5gs_length_pdu_session_status(ogs_nas_pdu_session_status_t *pdu_session_status);
+int ogs_nas_5gs_length_plmn_list(ogs_nas_plmn_list_t *plmn_list);
+int ogs_nas_5gs_length_rejected_nssai(ogs_nas_rejected_nssai_t *rejected_nssai);
+int ogs_nas_5gs_length_release_assistance_indication(ogs_nas_release_assistance_indication_t *release_assistance_indication);
+int ogs_nas_5gs_length_request_type(ogs_nas_request_type_t *request_type);
+int ogs_nas_5gs_length_s1_ue_network_capability(ogs_nas_s1_ue_network_capability_t *s1_ue_network_capability);
+int ogs_nas_5gs_length_s1_ue_security_capability(ogs_nas_s1_ue_security_capability_t *s1_ue_security_capability);
+int ogs_nas_5gs_length_service_area_list(ogs_nas_service_area_list_t *service_area_list);
+int ogs_nas_5gs_length_5gs_network_feature_support(ogs_nas_5gs_network_feature_support_t *network_feature_support);
+int ogs_nas_5gs_length_sms_indication(ogs_nas_sms_indication_t *sms_indication);
+int ogs_nas_5gs_length_sor_transparent_container(ogs_nas_sor_transparent_container_t *sor_transparent_container);
+int ogs_nas_5gs_length_supported_codec_list(ogs_nas_supported_codec_list_t *supported_codec_list);
+int ogs_nas_5gs_length_time_zone(ogs_nas_time_zone_t *time_zone);
+int ogs_nas_5gs_length_time_zone_and_time(ogs_nas_time_zone_and_time_t *time_zone_and_time);
+int ogs_nas_5gs_length_ue_security_capability(ogs_nas_ue_security_capability_t *ue_security_capability);
+int ogs_nas_5gs_length_ue_usage_setting(ogs_nas_ue_usage_setting_t *ue_usage_setting);
+int ogs_nas_5gs_length_ue_status(ogs_nas_ue_status_t *ue_status);
+int ogs_nas_5gs_length_uplink_data_status(ogs_nas_uplink_data_status_t *uplink_data_status);
+int ogs_nas_5gs_length_5gs_registration_result(ogs_nas_5gs_registration_result_t *registration_result);
+int ogs_nas_5gs_length_ue_radio_capability_id(ogs_nas_ue_radio_capability_id_t *ue_radio_capability_id);
+int ogs_nas_5gs_length_ue_radio_capability_id_deletion_indication(ogs_nas_ue_radio_capability_id_deletion_indication_t *ue_radio_capability_id_deletion_indication);
+int ogs_nas_5gs_length_5gs_registration_type(ogs_nas_5gs_registration_type_t *registration_type);
+int ogs_nas_5gs_length_truncated_5g_s_tmsi_configuration(ogs_nas_truncated_5g_s_tmsi_configuration_t *truncated_s_tmsi_configuration);
+int ogs_nas_5gs_length_wus_assistance_information(ogs_nas_wus_assistance_information_t *wus_assistance_information);
+int ogs_nas_5gs_length_n5gc_indication(ogs_nas_n5gc_indication_t *n5gc_indication);
+int ogs_nas_5gs_length_nb_n1_mode_drx_parameters(ogs_nas_nb_n1_mode_drx_parameters_t *nb_n1_mode_drx_parameters);
+int ogs_nas_5gs_length_additional_configuration_indication(ogs_nas_additional_configuration_indication_t *additional_configuration_indication);
+int ogs_nas_5gs_length_extended_rejected_nssai(ogs_nas_extended_rejected_nssai_t *extended_rejected_nssai);
+int ogs_nas_5gs_length_ue_request_type(ogs_nas_ue_request_type_t *ue_request_type);
+int ogs_nas_5gs_length_paging_restriction(ogs_nas_paging_restriction_t *paging_restriction);
+int ogs_nas_5gs_length_nid(ogs_nas_nid_t *nid);
+int ogs_nas_5gs_length_5gs_tracking_area_identity(ogs_nas_5gs_tracking_area_identity_t *tracking_area_identity);
+int ogs_nas_5gs_length_peips_assistance_information(ogs_nas_peips_assistance_information_t *peips_assistance_information);
+int ogs_nas_5gs_length_5gs_additional_request_result(ogs_nas_5gs_additional_request_result_t *additional_request_result);
+int ogs_nas_5gs_length_nssrg_information(ogs_nas_nssrg_information_t *nssrg_information);
+int ogs_nas_5gs_length_list_of_plmns_to_be_used_in_disaster_condition(ogs_nas_list_of_plmns_to_be_used_in_disaster_condition_t *list_of_plmns_to_be_used_in_disaster_condition);
+int ogs_nas_5gs_length_registration_wait_range(ogs_nas_registration_wait_range_t *registration_wait_range);
+int ogs_nas_5gs_length_plmn_identity(ogs_nas_plmn_identity_t *plmn_identity);
+int ogs_nas_5gs_length_extended_cag_information_list(ogs_nas_extended_cag_information_list_t *extended_cag_information_list);
+int ogs_nas_5gs_length_nsag_information(ogs_nas_nsag_information_t *nsag_information);
+int ogs_nas_5gs_length_5gs_tracking_area_identity_list(ogs_nas_5gs_tracking_area_identity_list_t *tracking_area_identity_list);
+int ogs_nas_5gs_length_priority_indicator(ogs_nas_priority_indicator_t *priority_indicator);
+int ogs_nas_5gs_length_5gs_update_type(ogs_nas_5gs_update_type_t *update_type);
+int ogs_nas_5gs_length_5gsm_capability(ogs_nas_5gsm_capability_t *gsm_capability);
+int ogs_nas_5gs_length_pdu_address(ogs_nas_pdu_address_t *pdu_address);
+int ogs_nas_5gs_length_pdu_session_type(ogs_nas_pdu_session_type_t *pdu_session_type);
+int ogs_nas_5gs_length_qos_flow_descriptions(ogs_nas_qos_flow_descriptions_t *qos_flow_descriptions);
+int ogs_nas_5gs_length_qos_rules(ogs_nas_qos_rules_t *qos_rules);
+int ogs_nas_5gs_length_session_ambr(ogs_nas_session_ambr_t *session_ambr);
+int ogs_nas_5gs_length_sm_pdu_dn_request_container(ogs_nas_sm_pdu_dn_request_container_t *sm_pdu_dn_request_container);
+int ogs_nas_5gs_length_ssc_mode(ogs_nas_ssc_mode_t *ssc_mode);
+int ogs_nas_5gs_length_re_attempt_indicator(ogs_nas_re_attempt_indicator_t *re_attempt_indicator);
+int ogs_nas_5gs_length_5gsm_network_feature_support(ogs_nas_5gsm_network_feature_support_t *gsm_network_feature_support);
+int ogs_nas_5gs_length_5gsm_cause(ogs_nas_5gsm_cause_t *gsm_cause);
+int ogs_nas_5gs_length_serving_plmn_rate_control(ogs_nas_serving_plmn_rate_control_t *serving_plmn_rate_control);
+int ogs_nas_5gs_length_5gsm_congestion_re_attempt_indicator(ogs_nas_5gsm_congestion_re_attempt_indicator_t *gsm_congestion_re_attempt_indicator);
+int ogs_nas_5gs_length_atsss_container(ogs_nas_atsss_container_t *atsss_container);
+int ogs_nas_5gs_length_control_plane_only_indication(ogs_nas_control_plane_only_indication_t *control_plane_only_indication);
+int ogs_nas_5gs_length_ip_header_compression_configuration(ogs_nas_ip_header_compression_configuration_t *ip_header_compression_configuration);
+int ogs_nas_5gs_length_header_compression_configuration(ogs_nas_header_compression_configuration_t *header_compression_configuration);
+int ogs_nas_5gs_length_ds_tt_ethernet_port_mac_address(ogs_nas_ds_tt_ethernet_port_mac_address_t *ds_tt_ethernet_port_mac_address);
+int ogs_nas_5gs_length_ue_ds_tt_residence_time(ogs_nas_ue_ds_tt_residence_time_t *ue_ds_tt_residence_time);
+int ogs_nas_5gs_length_port_management_information_container(ogs_nas_port_management_information_container_t *port_management_information_container);
+int ogs_nas_5gs_length_ethernet_header_compression_configuration(ogs_nas_ethernet_header_compression_configuration_t *ethernet_header_compression_configuration);
+int ogs_nas_5gs_length_always_on_pdu_session_indication(ogs_nas_always_on_pdu_session_indication_t *always_on_pdu_session_indication);
+int ogs_nas_5gs_length_requested_mbs_container(ogs_nas_requested_mbs_container_t *requested_mbs_container);
+int ogs_nas_5gs_length_received_mbs_container(ogs_nas_received_mbs_container_t *received_mbs_container);
+int ogs_nas_5gs_length_pdu_session_pair_id(ogs_nas_pdu_session_pair_id_t *pdu_session_pair_id);
+int ogs_nas_5gs_length_rsn(ogs_nas_rsn_t *rsn);
+int ogs_nas_5gs_length_always_on_pdu_session_requested(ogs_nas_always_on_pdu_session_requested_t *always_on_pdu_session_requested);
+int ogs_nas_5gs_length_allowed_ssc_mode(ogs_nas_allowed_ssc_mode_t *allowed_ssc_mode);
+int ogs_nas_5gs_length_extended_protocol_configuration_options(ogs_nas_extended_protocol_configuration_options_t *extended_protocol_configuration_options);
+int ogs_nas_5gs_length_integrity_protection_maximum_data_rate(ogs_nas_integrity_protection_maximum_data_rate_t *integrity_protection_maximum_data_rate);
+int ogs_nas_5gs_length_mapped_eps_bearer_contexts(ogs_nas_mapped_eps_bearer_contexts_t *mapped_eps_bearer_contexts);
+int ogs_nas_5gs_length_maximum_number_of_supported_packet_filters(ogs_nas_maximum_number_of_supported_packet_filters_t *maximum_number_of_supported_packet_filters);
+
 #ifdef __cplusplus
 }
 #endif
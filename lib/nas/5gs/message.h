@@ -1553,6 +1553,8 @@ typedef struct ogs_nas_5gs_message_s {
 
 ogs_pkbuf_t *ogs_nas_5gmm_encode(ogs_nas_5gs_message_t *message);
 ogs_pkbuf_t *ogs_nas_5gsm_encode(ogs_nas_5gs_message_t *message);
+int ogs_nas_5gmm_length(ogs_nas_5gs_message_t *message);
+int ogs_nas_5gsm_length(ogs_nas_5gs_message_t *message);
 int ogs_nas_5gmm_decode(ogs_nas_5gs_message_t *message, ogs_pkbuf_t *pkbuf);
 int ogs_nas_5gsm_decode(ogs_nas_5gs_message_t *message, ogs_pkbuf_t *pkbuf);
 ogs_pkbuf_t *ogs_nas_5gs_plain_encode(ogs_nas_5gs_message_t *message);
@@ -40,6 +40,8 @@ type_list["DNN"]["decode"] = \
 type_list["DNN"]["encode"] = \
 "    target.length = ogs_fqdn_build(target.value, dnn->value, dnn->length);\n" \
 "    size = target.length + sizeof(target.length);\n\n"
+type_list["DNN"]["size"] = \
+"    size++; /* ogs_fqdn_build() adds the first label length */\n\n"
 
 type_list["Session-AMBR"]["decode"] = \
 "    session_ambr->downlink.value = be16toh(source->downlink.value);\n" \
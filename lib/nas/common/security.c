@@ -19,8 +19,30 @@
 
 #include "ogs-nas-common.h"
 
-void ogs_nas_mac_calculate(uint8_t algorithm_identity,
-        uint8_t *knas_int, uint32_t count, uint8_t bearer, 
+void ogs_nas_security_key_init(ogs_nas_security_key_t *key,
+        uint8_t int_algorithm, uint8_t *knas_int,
+        uint8_t enc_algorithm, uint8_t *knas_enc)
+{
+    ogs_assert(key);
+    ogs_assert(knas_int);
+    ogs_assert(knas_enc);
+
+    memset(key, 0, sizeof(*key));
+
+    key->int_algorithm = int_algorithm;
+    memcpy(key->knas_int, knas_int, sizeof(key->knas_int));
+    if (int_algorithm == OGS_NAS_SECURITY_ALGORITHMS_128_EIA2)
+        ogs_aes_cmac_key_init(&key->int_cmac, key->knas_int);
+
+    key->enc_algorithm = enc_algorithm;
+    memcpy(key->knas_enc, knas_enc, sizeof(key->knas_enc));
+    if (enc_algorithm == OGS_NAS_SECURITY_ALGORITHMS_128_EEA2)
+        key->enc_nrounds = ogs_aes_setup_enc(key->enc_rk, key->knas_enc, 128);
+}
+
+static void nas_mac_calculate(uint8_t algorithm_identity,
+        uint8_t *knas_int, const ogs_aes_cmac_key_t *cmac_key,
+        uint32_t count, uint8_t bearer,
         uint8_t direction, ogs_pkbuf_t *pkbuf, uint8_t *mac)
 {
     uint8_t *ivec = NULL;;
@@ -50,7 +72,11 @@ void ogs_nas_mac_calculate(uint8_t algorithm_identity,
         memcpy(ivec + 0, &count, sizeof(count));
         ivec[4] = (bearer << 3) | (direction << 2);
 
-        ogs_aes_cmac_calculate(cmac, knas_int, pkbuf->data, pkbuf->len);
+        if (cmac_key)
+            ogs_aes_cmac_calculate_from_key(
+                    cmac, cmac_key, pkbuf->data, pkbuf->len);
+        else
+            ogs_aes_cmac_calculate(cmac, knas_int, pkbuf->data, pkbuf->len);
         memcpy(mac, cmac, 4);
 
         ogs_pkbuf_pull(pkbuf, 8);
@@ -71,8 +97,9 @@ void ogs_nas_mac_calculate(uint8_t algorithm_identity,
     }
 }
 
-void ogs_nas_encrypt(uint8_t algorithm_identity,
-        uint8_t *knas_enc, uint32_t count, uint8_t bearer, 
+static void nas_encrypt(uint8_t algorithm_identity,
+        uint8_t *knas_enc, const uint32_t *rk, int nrounds,
+        uint32_t count, uint8_t bearer,
         uint8_t direction, ogs_pkbuf_t *pkbuf)
 {
     uint8_t ivec[16];
@@ -95,8 +122,12 @@ void ogs_nas_encrypt(uint8_t algorithm_identity,
         memset(ivec, 0, 16);
         memcpy(ivec + 0, &count, sizeof(count));
         ivec[4] = (bearer << 3) | (direction << 2);
-        ogs_aes_ctr128_encrypt(knas_enc, ivec, 
-                pkbuf->data, pkbuf->len, pkbuf->data);
+        if (rk)
+            ogs_aes_ctr128_encrypt_rk(rk, nrounds, ivec,
+                    pkbuf->data, pkbuf->len, pkbuf->data);
+        else
+            ogs_aes_ctr128_encrypt(knas_enc, ivec,
+                    pkbuf->data, pkbuf->len, pkbuf->data);
         break;
     case OGS_NAS_SECURITY_ALGORITHMS_128_EEA3:
         zuc_eea3(knas_enc, count, bearer, direction, 
@@ -110,3 +141,40 @@ void ogs_nas_encrypt(uint8_t algorithm_identity,
         break;
     }
 }
+
+void ogs_nas_mac_calculate(uint8_t algorithm_identity,
+        uint8_t *knas_int, uint32_t count, uint8_t bearer, 
+        uint8_t direction, ogs_pkbuf_t *pkbuf, uint8_t *mac)
+{
+    nas_mac_calculate(algorithm_identity, knas_int, NULL,
+            count, bearer, direction, pkbuf, mac);
+}
+
+void ogs_nas_encrypt(uint8_t algorithm_identity,
+        uint8_t *knas_enc, uint32_t count, uint8_t bearer, 
+        uint8_t direction, ogs_pkbuf_t *pkbuf)
+{
+    nas_encrypt(algorithm_identity, knas_enc, NULL, 0,
+            count, bearer, direction, pkbuf);
+}
+
+void ogs_nas_mac_calculate_from_key(const ogs_nas_security_key_t *key,
+        uint32_t count, uint8_t bearer,
+        uint8_t direction, ogs_pkbuf_t *pkbuf, uint8_t *mac)
+{
+    ogs_assert(key);
+
+    nas_mac_calculate(key->int_algorithm, (uint8_t *)key->knas_int,
+            &key->int_cmac, count, bearer, direction, pkbuf, mac);
+}
+
+void ogs_nas_encrypt_from_key(const ogs_nas_security_key_t *key,
+        uint32_t count, uint8_t bearer,
+        uint8_t direction, ogs_pkbuf_t *pkbuf)
+{
+    ogs_assert(key);
+
+    nas_encrypt(key->enc_algorithm, (uint8_t *)key->knas_enc,
+            key->enc_rk, key->enc_nrounds,
+            count, bearer, direction, pkbuf);
+}
@@ -39,6 +39,36 @@ void ogs_nas_encrypt(uint8_t algorithm_identity,
     uint8_t *knas_enc, uint32_t count, uint8_t bearer, 
     uint8_t direction, ogs_pkbuf_t *pkbuf);
 
+/*
+ * Per-UE NAS key state, set up once when KNASint/KNASenc are derived so
+ * that 128-EIA2/128-EEA2 do not expand the AES key schedule (and CMAC
+ * subkeys) on every NAS message. SNOW 3G and ZUC mix COUNT into their
+ * initialisation, so only the raw key is kept for them.
+ */
+typedef struct ogs_nas_security_key_s {
+    uint8_t int_algorithm;
+    uint8_t enc_algorithm;
+
+    uint8_t knas_int[OGS_SHA256_DIGEST_SIZE/2];
+    uint8_t knas_enc[OGS_SHA256_DIGEST_SIZE/2];
+
+    ogs_aes_cmac_key_t int_cmac;                    /* 128-EIA2 */
+    uint32_t enc_rk[OGS_AES_RKLENGTH(128)];         /* 128-EEA2 */
+    int enc_nrounds;
+} ogs_nas_security_key_t;
+
+void ogs_nas_security_key_init(ogs_nas_security_key_t *key,
+    uint8_t int_algorithm, uint8_t *knas_int,
+    uint8_t enc_algorithm, uint8_t *knas_enc);
+
+void ogs_nas_mac_calculate_from_key(const ogs_nas_security_key_t *key,
+    uint32_t count, uint8_t bearer,
+    uint8_t direction, ogs_pkbuf_t *pkbuf, uint8_t *mac);
+
+void ogs_nas_encrypt_from_key(const ogs_nas_security_key_t *key,
+    uint32_t count, uint8_t bearer,
+    uint8_t direction, ogs_pkbuf_t *pkbuf);
+
 #ifdef __cplusplus
 }
 #endif
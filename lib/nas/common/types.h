@@ -34,6 +34,10 @@ extern "C" {
  * When calculating AES_CMAC, we need to use the headroom of the packet. */
 #define OGS_NAS_HEADROOM 16
 
+/* Spare octets behind the length computed for a NAS message.
+ * A short length pass then costs an error log, not an abort. */
+#define OGS_NAS_SLACK 64
+
 #define OGS_NAS_SECURITY_HEADER_PLAIN_NAS_MESSAGE 0
 #define OGS_NAS_SECURITY_HEADER_INTEGRITY_PROTECTED 1
 #define OGS_NAS_SECURITY_HEADER_INTEGRITY_PROTECTED_AND_CIPHERED 2
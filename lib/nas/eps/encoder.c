@@ -35,54 +35,103 @@
 #include "ogs-nas-eps.h"
 
 int ogs_nas_eps_encode_attach_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_attach_request(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_attach_accept(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_attach_accept(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_attach_complete(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_attach_complete(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_attach_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_attach_reject(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_detach_request_from_ue(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_detach_request_from_ue(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_detach_request_to_ue(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_detach_request_to_ue(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_tracking_area_update_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_tracking_area_update_request(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_tracking_area_update_accept(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_tracking_area_update_accept(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_tracking_area_update_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_tracking_area_update_reject(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_extended_service_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_extended_service_request(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_service_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_service_request(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_service_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_service_reject(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_guti_reallocation_command(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_guti_reallocation_command(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_authentication_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_authentication_request(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_authentication_response(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_authentication_response(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_identity_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_identity_request(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_identity_response(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_identity_response(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_authentication_failure(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_authentication_failure(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_security_mode_command(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_security_mode_command(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_security_mode_complete(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_security_mode_complete(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_security_mode_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_security_mode_reject(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_emm_status(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_emm_status(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_emm_information(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_emm_information(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_downlink_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_downlink_nas_transport(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_uplink_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_uplink_nas_transport(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_cs_service_notification(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_cs_service_notification(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_uplink_generic_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_uplink_generic_nas_transport(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_downlink_generic_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_downlink_generic_nas_transport(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_activate_default_eps_bearer_context_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_activate_default_eps_bearer_context_request(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_activate_default_eps_bearer_context_accept(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_activate_default_eps_bearer_context_accept(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_activate_default_eps_bearer_context_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_activate_default_eps_bearer_context_reject(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_activate_dedicated_eps_bearer_context_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_activate_dedicated_eps_bearer_context_request(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_activate_dedicated_eps_bearer_context_accept(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_activate_dedicated_eps_bearer_context_accept(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_activate_dedicated_eps_bearer_context_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_activate_dedicated_eps_bearer_context_reject(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_modify_eps_bearer_context_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_modify_eps_bearer_context_request(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_modify_eps_bearer_context_accept(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_modify_eps_bearer_context_accept(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_modify_eps_bearer_context_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_modify_eps_bearer_context_reject(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_deactivate_eps_bearer_context_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_deactivate_eps_bearer_context_request(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_deactivate_eps_bearer_context_accept(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_deactivate_eps_bearer_context_accept(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_pdn_connectivity_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_pdn_connectivity_request(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_pdn_connectivity_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_pdn_connectivity_reject(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_pdn_disconnect_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_pdn_disconnect_request(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_pdn_disconnect_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_pdn_disconnect_reject(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_bearer_resource_allocation_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_bearer_resource_allocation_request(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_bearer_resource_allocation_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_bearer_resource_allocation_reject(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_bearer_resource_modification_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_bearer_resource_modification_request(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_bearer_resource_modification_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_bearer_resource_modification_reject(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_esm_information_response(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_esm_information_response(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_esm_status(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);
+int ogs_nas_eps_length_esm_status(ogs_nas_eps_message_t *message);
 int ogs_nas_eps_encode_attach_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_attach_request_t *attach_request = &message->emm.attach_request;
@@ -370,6 +419,149 @@ int ogs_nas_eps_encode_attach_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t
     return encoded;
 }
 
+int ogs_nas_eps_length_attach_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_attach_request_t *attach_request = &message->emm.attach_request;
+    int length = 0;
+
+    length += ogs_nas_eps_length_eps_attach_type(&attach_request->eps_attach_type);
+    length += ogs_nas_eps_length_eps_mobile_identity(&attach_request->eps_mobile_identity);
+    length += ogs_nas_eps_length_ue_network_capability(&attach_request->ue_network_capability);
+    length += ogs_nas_eps_length_esm_message_container(&attach_request->esm_message_container);
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_OLD_P_TMSI_SIGNATURE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_p_tmsi_signature(&attach_request->old_p_tmsi_signature);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_ADDITIONAL_GUTI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_eps_mobile_identity(&attach_request->additional_guti);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_LAST_VISITED_REGISTERED_TAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity(&attach_request->last_visited_registered_tai);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_DRX_PARAMETER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_drx_parameter(&attach_request->drx_parameter);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_MS_NETWORK_CAPABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ms_network_capability(&attach_request->ms_network_capability);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_OLD_LOCATION_AREA_IDENTIFICATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_location_area_identification(&attach_request->old_location_area_identification);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_TMSI_STATUS_PRESENT) {
+        length += ogs_nas_eps_length_tmsi_status(&attach_request->tmsi_status);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_MOBILE_STATION_CLASSMARK_2_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_mobile_station_classmark_2(&attach_request->mobile_station_classmark_2);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_MOBILE_STATION_CLASSMARK_3_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_mobile_station_classmark_3(&attach_request->mobile_station_classmark_3);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_SUPPORTED_CODECS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_supported_codec_list(&attach_request->supported_codecs);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_ADDITIONAL_UPDATE_TYPE_PRESENT) {
+        length += ogs_nas_eps_length_additional_update_type(&attach_request->additional_update_type);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_VOICE_DOMAIN_PREFERENCE_AND_UE_USAGE_SETTING_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_voice_domain_preference_and_ue_usage_setting(&attach_request->voice_domain_preference_and_ue_usage_setting);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_DEVICE_PROPERTIES_PRESENT) {
+        length += ogs_nas_eps_length_device_properties(&attach_request->device_properties);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_OLD_GUTI_TYPE_PRESENT) {
+        length += ogs_nas_eps_length_guti_type(&attach_request->old_guti_type);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_MS_NETWORK_FEATURE_SUPPORT_PRESENT) {
+        length += ogs_nas_eps_length_ms_network_feature_support(&attach_request->ms_network_feature_support);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_TMSI_BASED_NRI_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_network_resource_identifier_container(&attach_request->tmsi_based_nri_container);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_T3324_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_2(&attach_request->t3324_value);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_T3412_EXTENDED_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_3(&attach_request->t3412_extended_value);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_EXTENDED_DRX_PARAMETERS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_drx_parameters(&attach_request->extended_drx_parameters);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_UE_ADDITIONAL_SECURITY_CAPABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_additional_security_capability(&attach_request->ue_additional_security_capability);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_UE_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_status(&attach_request->ue_status);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_ADDITIONAL_INFORMATION_REQUESTED_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_additional_information_requested(&attach_request->additional_information_requested);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_N1_UE_NETWORK_CAPABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_n1_ue_network_capability(&attach_request->n1_ue_network_capability);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_UE_RADIO_CAPABILITY_ID_AVAILABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_radio_capability_id_availability(&attach_request->ue_radio_capability_id_availability);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_REQUESTED_WUS_ASSISTANCE_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_wus_assistance_information(&attach_request->requested_wus_assistance_information);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_DRX_PARAMETER_IN_NB_S1_MODE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nb_s1_drx_parameter(&attach_request->drx_parameter_in_nb_s1_mode);
+    }
+
+    if (attach_request->presencemask & OGS_NAS_EPS_ATTACH_REQUEST_REQUESTED_IMSI_OFFSET_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_imsi_offset(&attach_request->requested_imsi_offset);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_attach_accept(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_attach_accept_t *attach_accept = &message->emm.attach_accept;
@@ -667,6 +859,154 @@ int ogs_nas_eps_encode_attach_accept(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *
     return encoded;
 }
 
+int ogs_nas_eps_length_attach_accept(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_attach_accept_t *attach_accept = &message->emm.attach_accept;
+    int length = 0;
+
+    length += ogs_nas_eps_length_eps_attach_result(&attach_accept->eps_attach_result);
+    length += ogs_nas_eps_length_gprs_timer(&attach_accept->t3412_value);
+    length += ogs_nas_eps_length_tracking_area_identity_list(&attach_accept->tai_list);
+    length += ogs_nas_eps_length_esm_message_container(&attach_accept->esm_message_container);
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_GUTI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_eps_mobile_identity(&attach_accept->guti);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_LOCATION_AREA_IDENTIFICATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_location_area_identification(&attach_accept->location_area_identification);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_MS_IDENTITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_mobile_identity(&attach_accept->ms_identity);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_EMM_CAUSE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_emm_cause(&attach_accept->emm_cause);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_T3402_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer(&attach_accept->t3402_value);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_T3423_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer(&attach_accept->t3423_value);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_EQUIVALENT_PLMNS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_plmn_list(&attach_accept->equivalent_plmns);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_EMERGENCY_NUMBER_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_emergency_number_list(&attach_accept->emergency_number_list);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_EPS_NETWORK_FEATURE_SUPPORT_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_eps_network_feature_support(&attach_accept->eps_network_feature_support);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_ADDITIONAL_UPDATE_RESULT_PRESENT) {
+        length += ogs_nas_eps_length_additional_update_result(&attach_accept->additional_update_result);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_T3412_EXTENDED_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_3(&attach_accept->t3412_extended_value);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_T3324_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_2(&attach_accept->t3324_value);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_EXTENDED_DRX_PARAMETERS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_drx_parameters(&attach_accept->extended_drx_parameters);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_DCN_ID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_dcn_id(&attach_accept->dcn_id);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_SMS_SERVICES_STATUS_PRESENT) {
+        length += ogs_nas_eps_length_sms_services_status(&attach_accept->sms_services_status);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_NON__NW_PROVIDED_POLICIES_PRESENT) {
+        length += ogs_nas_eps_length_non__nw_provided_policies(&attach_accept->non__nw_provided_policies);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_T3448_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_2(&attach_accept->t3448_value);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_NETWORK_POLICY_PRESENT) {
+        length += ogs_nas_eps_length_network_policy(&attach_accept->network_policy);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_T3447_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_3(&attach_accept->t3447_value);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_EXTENDED_EMERGENCY_NUMBER_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_emergency_number_list(&attach_accept->extended_emergency_number_list);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_CIPHERING_KEY_DATA_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ciphering_key_data(&attach_accept->ciphering_key_data);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_UE_RADIO_CAPABILITY_ID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_radio_capability_id(&attach_accept->ue_radio_capability_id);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_UE_RADIO_CAPABILITY_ID_DELETION_INDICATION_PRESENT) {
+        length += ogs_nas_eps_length_ue_radio_capability_id_deletion_indication(&attach_accept->ue_radio_capability_id_deletion_indication);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_NEGOTIATED_WUS_ASSISTANCE_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_wus_assistance_information(&attach_accept->negotiated_wus_assistance_information);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_NEGOTIATED_DRX_PARAMETER_IN_NB_S1_MODE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nb_s1_drx_parameter(&attach_accept->negotiated_drx_parameter_in_nb_s1_mode);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_NEGOTIATED_IMSI_OFFSET_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_imsi_offset(&attach_accept->negotiated_imsi_offset);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity_list(&attach_accept->forbidden_tai_for_the_list_of_forbidden_tracking_areas_for_roaming);
+    }
+
+    if (attach_accept->presencemask & OGS_NAS_EPS_ATTACH_ACCEPT_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity_list(&attach_accept->forbidden_tai_for_the_list_of_forbidden_tracking_areas_forregional_provision_of_service);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_attach_complete(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_attach_complete_t *attach_complete = &message->emm.attach_complete;
@@ -682,6 +1022,16 @@ int ogs_nas_eps_encode_attach_complete(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t
     return encoded;
 }
 
+int ogs_nas_eps_length_attach_complete(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_attach_complete_t *attach_complete = &message->emm.attach_complete;
+    int length = 0;
+
+    length += ogs_nas_eps_length_esm_message_container(&attach_complete->esm_message_container);
+
+    return length;
+}
+
 int ogs_nas_eps_encode_attach_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_attach_reject_t *attach_reject = &message->emm.attach_reject;
@@ -765,6 +1115,50 @@ int ogs_nas_eps_encode_attach_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *
     return encoded;
 }
 
+int ogs_nas_eps_length_attach_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_attach_reject_t *attach_reject = &message->emm.attach_reject;
+    int length = 0;
+
+    length += ogs_nas_eps_length_emm_cause(&attach_reject->emm_cause);
+
+    if (attach_reject->presencemask & OGS_NAS_EPS_ATTACH_REJECT_ESM_MESSAGE_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_esm_message_container(&attach_reject->esm_message_container);
+    }
+
+    if (attach_reject->presencemask & OGS_NAS_EPS_ATTACH_REJECT_T3346_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_2(&attach_reject->t3346_value);
+    }
+
+    if (attach_reject->presencemask & OGS_NAS_EPS_ATTACH_REJECT_T3402_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_2(&attach_reject->t3402_value);
+    }
+
+    if (attach_reject->presencemask & OGS_NAS_EPS_ATTACH_REJECT_EXTENDED_EMM_CAUSE_PRESENT) {
+        length += ogs_nas_eps_length_extended_emm_cause(&attach_reject->extended_emm_cause);
+    }
+
+    if (attach_reject->presencemask & OGS_NAS_EPS_ATTACH_REJECT_LOWER_BOUND_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_3(&attach_reject->lower_bound_timer_value);
+    }
+
+    if (attach_reject->presencemask & OGS_NAS_EPS_ATTACH_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity_list(&attach_reject->forbidden_tai_for_the_list_of_forbidden_tracking_areas_for_roaming);
+    }
+
+    if (attach_reject->presencemask & OGS_NAS_EPS_ATTACH_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity_list(&attach_reject->forbidden_tai_for_the_list_of_forbidden_tracking_areas_forregional_provision_of_service);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_detach_request_from_ue(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_detach_request_from_ue_t *detach_request_from_ue = &message->emm.detach_request_from_ue;
@@ -784,6 +1178,17 @@ int ogs_nas_eps_encode_detach_request_from_ue(ogs_pkbuf_t *pkbuf, ogs_nas_eps_me
     return encoded;
 }
 
+int ogs_nas_eps_length_detach_request_from_ue(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_detach_request_from_ue_t *detach_request_from_ue = &message->emm.detach_request_from_ue;
+    int length = 0;
+
+    length += ogs_nas_eps_length_detach_type(&detach_request_from_ue->detach_type);
+    length += ogs_nas_eps_length_eps_mobile_identity(&detach_request_from_ue->eps_mobile_identity);
+
+    return length;
+}
+
 int ogs_nas_eps_encode_detach_request_to_ue(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_detach_request_to_ue_t *detach_request_to_ue = &message->emm.detach_request_to_ue;
@@ -839,6 +1244,36 @@ int ogs_nas_eps_encode_detach_request_to_ue(ogs_pkbuf_t *pkbuf, ogs_nas_eps_mess
     return encoded;
 }
 
+int ogs_nas_eps_length_detach_request_to_ue(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_detach_request_to_ue_t *detach_request_to_ue = &message->emm.detach_request_to_ue;
+    int length = 0;
+
+    length += ogs_nas_eps_length_detach_type(&detach_request_to_ue->detach_type);
+
+    if (detach_request_to_ue->presencemask & OGS_NAS_EPS_DETACH_REQUEST_EMM_CAUSE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_emm_cause(&detach_request_to_ue->emm_cause);
+    }
+
+    if (detach_request_to_ue->presencemask & OGS_NAS_EPS_DETACH_REQUEST_LOWER_BOUND_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_3(&detach_request_to_ue->lower_bound_timer_value);
+    }
+
+    if (detach_request_to_ue->presencemask & OGS_NAS_EPS_DETACH_REQUEST_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity_list(&detach_request_to_ue->forbidden_tai_for_the_list_of_forbidden_tracking_areas_for_roaming);
+    }
+
+    if (detach_request_to_ue->presencemask & OGS_NAS_EPS_DETACH_REQUEST_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity_list(&detach_request_to_ue->forbidden_tai_for_the_list_of_forbidden_tracking_areas_forregional_provision_of_service);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_tracking_area_update_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_tracking_area_update_request_t *tracking_area_update_request = &message->emm.tracking_area_update_request;
@@ -1192,29 +1627,207 @@ int ogs_nas_eps_encode_tracking_area_update_request(ogs_pkbuf_t *pkbuf, ogs_nas_
     return encoded;
 }
 
-int ogs_nas_eps_encode_tracking_area_update_accept(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
+int ogs_nas_eps_length_tracking_area_update_request(ogs_nas_eps_message_t *message)
 {
-    ogs_nas_eps_tracking_area_update_accept_t *tracking_area_update_accept = &message->emm.tracking_area_update_accept;
-    int encoded = 0;
-    int size = 0;
+    ogs_nas_eps_tracking_area_update_request_t *tracking_area_update_request = &message->emm.tracking_area_update_request;
+    int length = 0;
 
-    ogs_trace("[NAS] Encode TRACKING_AREA_UPDATE_ACCEPT");
+    length += ogs_nas_eps_length_eps_update_type(&tracking_area_update_request->eps_update_type);
+    length += ogs_nas_eps_length_eps_mobile_identity(&tracking_area_update_request->old_guti);
 
-    size = ogs_nas_eps_encode_eps_update_result(pkbuf, &tracking_area_update_accept->eps_update_result);
-    ogs_assert(size >= 0);
-    encoded += size;
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_NON_CURRENT_NATIVE_NAS_KEY_SET_IDENTIFIER_PRESENT) {
+        length += ogs_nas_eps_length_key_set_identifier(&tracking_area_update_request->non_current_native_nas_key_set_identifier);
+    }
 
-    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3412_VALUE_PRESENT) {
-        size = ogs_nas_eps_encode_optional_type(pkbuf, OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3412_VALUE_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_GPRS_CIPHERING_KEY_SEQUENCE_NUMBER_PRESENT) {
+        length += ogs_nas_eps_length_ciphering_key_sequence_number(&tracking_area_update_request->gprs_ciphering_key_sequence_number);
+    }
 
-        size = ogs_nas_eps_encode_gprs_timer(pkbuf, &tracking_area_update_accept->t3412_value);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_OLD_P_TMSI_SIGNATURE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_p_tmsi_signature(&tracking_area_update_request->old_p_tmsi_signature);
     }
 
-    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_GUTI_PRESENT) {
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_ADDITIONAL_GUTI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_eps_mobile_identity(&tracking_area_update_request->additional_guti);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_NONCEUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nonce(&tracking_area_update_request->nonceue);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_UE_NETWORK_CAPABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_network_capability(&tracking_area_update_request->ue_network_capability);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_LAST_VISITED_REGISTERED_TAI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity(&tracking_area_update_request->last_visited_registered_tai);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_DRX_PARAMETER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_drx_parameter(&tracking_area_update_request->drx_parameter);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_UE_RADIO_CAPABILITY_INFORMATION_UPDATE_NEEDED_PRESENT) {
+        length += ogs_nas_eps_length_ue_radio_capability_information_update_needed(&tracking_area_update_request->ue_radio_capability_information_update_needed);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_EPS_BEARER_CONTEXT_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_eps_bearer_context_status(&tracking_area_update_request->eps_bearer_context_status);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_MS_NETWORK_CAPABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ms_network_capability(&tracking_area_update_request->ms_network_capability);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_OLD_LOCATION_AREA_IDENTIFICATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_location_area_identification(&tracking_area_update_request->old_location_area_identification);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_TMSI_STATUS_PRESENT) {
+        length += ogs_nas_eps_length_tmsi_status(&tracking_area_update_request->tmsi_status);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_MOBILE_STATION_CLASSMARK_2_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_mobile_station_classmark_2(&tracking_area_update_request->mobile_station_classmark_2);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_MOBILE_STATION_CLASSMARK_3_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_mobile_station_classmark_3(&tracking_area_update_request->mobile_station_classmark_3);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_SUPPORTED_CODECS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_supported_codec_list(&tracking_area_update_request->supported_codecs);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_ADDITIONAL_UPDATE_TYPE_PRESENT) {
+        length += ogs_nas_eps_length_additional_update_type(&tracking_area_update_request->additional_update_type);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_VOICE_DOMAIN_PREFERENCE_AND_UE_USAGE_SETTING_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_voice_domain_preference_and_ue_usage_setting(&tracking_area_update_request->voice_domain_preference_and_ue_usage_setting);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_OLD_GUTI_TYPE_PRESENT) {
+        length += ogs_nas_eps_length_guti_type(&tracking_area_update_request->old_guti_type);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_DEVICE_PROPERTIES_PRESENT) {
+        length += ogs_nas_eps_length_device_properties(&tracking_area_update_request->device_properties);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_MS_NETWORK_FEATURE_SUPPORT_PRESENT) {
+        length += ogs_nas_eps_length_ms_network_feature_support(&tracking_area_update_request->ms_network_feature_support);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_TMSI_BASED_NRI_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_network_resource_identifier_container(&tracking_area_update_request->tmsi_based_nri_container);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_T3324_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_2(&tracking_area_update_request->t3324_value);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_T3412_EXTENDED_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_3(&tracking_area_update_request->t3412_extended_value);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_EXTENDED_DRX_PARAMETERS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_drx_parameters(&tracking_area_update_request->extended_drx_parameters);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_UE_ADDITIONAL_SECURITY_CAPABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_additional_security_capability(&tracking_area_update_request->ue_additional_security_capability);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_UE_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_status(&tracking_area_update_request->ue_status);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_ADDITIONAL_INFORMATION_REQUESTED_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_additional_information_requested(&tracking_area_update_request->additional_information_requested);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_N1_UE_NETWORK_CAPABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_n1_ue_network_capability(&tracking_area_update_request->n1_ue_network_capability);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_UE_RADIO_CAPABILITY_ID_AVAILABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_radio_capability_id_availability(&tracking_area_update_request->ue_radio_capability_id_availability);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_REQUESTED_WUS_ASSISTANCE_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_wus_assistance_information(&tracking_area_update_request->requested_wus_assistance_information);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_DRX_PARAMETER_IN_NB_S1_MODE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nb_s1_drx_parameter(&tracking_area_update_request->drx_parameter_in_nb_s1_mode);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_REQUESTED_IMSI_OFFSET_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_imsi_offset(&tracking_area_update_request->requested_imsi_offset);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_UE_REQUEST_TYPE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_request_type(&tracking_area_update_request->ue_request_type);
+    }
+
+    if (tracking_area_update_request->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST_PAGING_RESTRICTION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_paging_restriction(&tracking_area_update_request->paging_restriction);
+    }
+
+    return length;
+}
+
+int ogs_nas_eps_encode_tracking_area_update_accept(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_tracking_area_update_accept_t *tracking_area_update_accept = &message->emm.tracking_area_update_accept;
+    int encoded = 0;
+    int size = 0;
+
+    ogs_trace("[NAS] Encode TRACKING_AREA_UPDATE_ACCEPT");
+
+    size = ogs_nas_eps_encode_eps_update_result(pkbuf, &tracking_area_update_accept->eps_update_result);
+    ogs_assert(size >= 0);
+    encoded += size;
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3412_VALUE_PRESENT) {
+        size = ogs_nas_eps_encode_optional_type(pkbuf, OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3412_VALUE_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_eps_encode_gprs_timer(pkbuf, &tracking_area_update_accept->t3412_value);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_GUTI_PRESENT) {
         size = ogs_nas_eps_encode_optional_type(pkbuf, OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_GUTI_TYPE);
         ogs_assert(size >= 0);
         encoded += size;
@@ -1527,6 +2140,176 @@ int ogs_nas_eps_encode_tracking_area_update_accept(ogs_pkbuf_t *pkbuf, ogs_nas_e
     return encoded;
 }
 
+int ogs_nas_eps_length_tracking_area_update_accept(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_tracking_area_update_accept_t *tracking_area_update_accept = &message->emm.tracking_area_update_accept;
+    int length = 0;
+
+    length += ogs_nas_eps_length_eps_update_result(&tracking_area_update_accept->eps_update_result);
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3412_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer(&tracking_area_update_accept->t3412_value);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_GUTI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_eps_mobile_identity(&tracking_area_update_accept->guti);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_TAI_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity_list(&tracking_area_update_accept->tai_list);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EPS_BEARER_CONTEXT_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_eps_bearer_context_status(&tracking_area_update_accept->eps_bearer_context_status);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_LOCATION_AREA_IDENTIFICATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_location_area_identification(&tracking_area_update_accept->location_area_identification);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_MS_IDENTITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_mobile_identity(&tracking_area_update_accept->ms_identity);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EMM_CAUSE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_emm_cause(&tracking_area_update_accept->emm_cause);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3402_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer(&tracking_area_update_accept->t3402_value);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3423_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer(&tracking_area_update_accept->t3423_value);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EQUIVALENT_PLMNS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_plmn_list(&tracking_area_update_accept->equivalent_plmns);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EMERGENCY_NUMBER_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_emergency_number_list(&tracking_area_update_accept->emergency_number_list);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EPS_NETWORK_FEATURE_SUPPORT_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_eps_network_feature_support(&tracking_area_update_accept->eps_network_feature_support);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_ADDITIONAL_UPDATE_RESULT_PRESENT) {
+        length += ogs_nas_eps_length_additional_update_result(&tracking_area_update_accept->additional_update_result);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3412_EXTENDED_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_3(&tracking_area_update_accept->t3412_extended_value);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3324_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_2(&tracking_area_update_accept->t3324_value);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EXTENDED_DRX_PARAMETERS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_drx_parameters(&tracking_area_update_accept->extended_drx_parameters);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_HEADER_COMPRESSION_CONFIGURATION_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_header_compression_configuration_status(&tracking_area_update_accept->header_compression_configuration_status);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_DCN_ID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_dcn_id(&tracking_area_update_accept->dcn_id);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_SMS_SERVICES_STATUS_PRESENT) {
+        length += ogs_nas_eps_length_sms_services_status(&tracking_area_update_accept->sms_services_status);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_NON__NW_POLICIES_PRESENT) {
+        length += ogs_nas_eps_length_non__nw_provided_policies(&tracking_area_update_accept->non__nw_policies);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3448_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_2(&tracking_area_update_accept->t3448_value);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_NETWORK_POLICY_PRESENT) {
+        length += ogs_nas_eps_length_network_policy(&tracking_area_update_accept->network_policy);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_T3447_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_3(&tracking_area_update_accept->t3447_value);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EXTENDED_EMERGENCY_NUMBER_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_emergency_number_list(&tracking_area_update_accept->extended_emergency_number_list);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_CIPHERING_KEY_DATA_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ciphering_key_data(&tracking_area_update_accept->ciphering_key_data);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_UE_RADIO_CAPABILITY_ID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_radio_capability_id(&tracking_area_update_accept->ue_radio_capability_id);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_UE_RADIO_CAPABILITY_ID_DELETION_INDICATION_PRESENT) {
+        length += ogs_nas_eps_length_ue_radio_capability_id_deletion_indication(&tracking_area_update_accept->ue_radio_capability_id_deletion_indication);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_NEGOTIATED_WUS_ASSISTANCE_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_wus_assistance_information(&tracking_area_update_accept->negotiated_wus_assistance_information);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_NEGOTIATED_DRX_PARAMETER_IN_NB_S1_MODE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nb_s1_drx_parameter(&tracking_area_update_accept->negotiated_drx_parameter_in_nb_s1_mode);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_NEGOTIATED_IMSI_OFFSET_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_imsi_offset(&tracking_area_update_accept->negotiated_imsi_offset);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_EPS_ADDITIONAL_REQUEST_RESULT_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_eps_additional_request_result(&tracking_area_update_accept->eps_additional_request_result);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity_list(&tracking_area_update_accept->forbidden_tai_for_the_list_of_forbidden_tracking_areas_for_roaming);
+    }
+
+    if (tracking_area_update_accept->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity_list(&tracking_area_update_accept->forbidden_tai_for_the_list_of_forbidden_tracking_areas_forregional_provision_of_service);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_tracking_area_update_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_tracking_area_update_reject_t *tracking_area_update_reject = &message->emm.tracking_area_update_reject;
@@ -1590,6 +2373,40 @@ int ogs_nas_eps_encode_tracking_area_update_reject(ogs_pkbuf_t *pkbuf, ogs_nas_e
     return encoded;
 }
 
+int ogs_nas_eps_length_tracking_area_update_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_tracking_area_update_reject_t *tracking_area_update_reject = &message->emm.tracking_area_update_reject;
+    int length = 0;
+
+    length += ogs_nas_eps_length_emm_cause(&tracking_area_update_reject->emm_cause);
+
+    if (tracking_area_update_reject->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REJECT_T3346_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_2(&tracking_area_update_reject->t3346_value);
+    }
+
+    if (tracking_area_update_reject->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REJECT_EXTENDED_EMM_CAUSE_PRESENT) {
+        length += ogs_nas_eps_length_extended_emm_cause(&tracking_area_update_reject->extended_emm_cause);
+    }
+
+    if (tracking_area_update_reject->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REJECT_LOWER_BOUND_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_3(&tracking_area_update_reject->lower_bound_timer_value);
+    }
+
+    if (tracking_area_update_reject->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity_list(&tracking_area_update_reject->forbidden_tai_for_the_list_of_forbidden_tracking_areas_for_roaming);
+    }
+
+    if (tracking_area_update_reject->presencemask & OGS_NAS_EPS_TRACKING_AREA_UPDATE_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity_list(&tracking_area_update_reject->forbidden_tai_for_the_list_of_forbidden_tracking_areas_forregional_provision_of_service);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_extended_service_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_extended_service_request_t *extended_service_request = &message->emm.extended_service_request;
@@ -1655,6 +2472,40 @@ int ogs_nas_eps_encode_extended_service_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_
     return encoded;
 }
 
+int ogs_nas_eps_length_extended_service_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_extended_service_request_t *extended_service_request = &message->emm.extended_service_request;
+    int length = 0;
+
+    length += ogs_nas_eps_length_service_type(&extended_service_request->service_type);
+    length += ogs_nas_eps_length_mobile_identity(&extended_service_request->m_tmsi);
+
+    if (extended_service_request->presencemask & OGS_NAS_EPS_EXTENDED_SERVICE_REQUEST_CSFB_RESPONSE_PRESENT) {
+        length += ogs_nas_eps_length_csfb_response(&extended_service_request->csfb_response);
+    }
+
+    if (extended_service_request->presencemask & OGS_NAS_EPS_EXTENDED_SERVICE_REQUEST_EPS_BEARER_CONTEXT_STATUS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_eps_bearer_context_status(&extended_service_request->eps_bearer_context_status);
+    }
+
+    if (extended_service_request->presencemask & OGS_NAS_EPS_EXTENDED_SERVICE_REQUEST_DEVICE_PROPERTIES_PRESENT) {
+        length += ogs_nas_eps_length_device_properties(&extended_service_request->device_properties);
+    }
+
+    if (extended_service_request->presencemask & OGS_NAS_EPS_EXTENDED_SERVICE_REQUEST_UE_REQUEST_TYPE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_request_type(&extended_service_request->ue_request_type);
+    }
+
+    if (extended_service_request->presencemask & OGS_NAS_EPS_EXTENDED_SERVICE_REQUEST_PAGING_RESTRICTION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_paging_restriction(&extended_service_request->paging_restriction);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_service_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_service_request_t *service_request = &message->emm.service_request;
@@ -1674,6 +2525,17 @@ int ogs_nas_eps_encode_service_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t
     return encoded;
 }
 
+int ogs_nas_eps_length_service_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_service_request_t *service_request = &message->emm.service_request;
+    int length = 0;
+
+    length += ogs_nas_eps_length_ksi_and_sequence_number(&service_request->ksi_and_sequence_number);
+    length += ogs_nas_eps_length_short_mac(&service_request->message_authentication_code);
+
+    return length;
+}
+
 int ogs_nas_eps_encode_service_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_service_reject_t *service_reject = &message->emm.service_reject;
@@ -1736,17 +2598,57 @@ int ogs_nas_eps_encode_service_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t
         encoded += size;
     }
 
-    if (service_reject->presencemask & OGS_NAS_EPS_SERVICE_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_PRESENT) {
-        size = ogs_nas_eps_encode_optional_type(pkbuf, OGS_NAS_EPS_SERVICE_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (service_reject->presencemask & OGS_NAS_EPS_SERVICE_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_PRESENT) {
+        size = ogs_nas_eps_encode_optional_type(pkbuf, OGS_NAS_EPS_SERVICE_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_eps_encode_tracking_area_identity_list(pkbuf, &service_reject->forbidden_tai_for_the_list_of_forbidden_tracking_areas_forregional_provision_of_service);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    return encoded;
+}
+
+int ogs_nas_eps_length_service_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_service_reject_t *service_reject = &message->emm.service_reject;
+    int length = 0;
+
+    length += ogs_nas_eps_length_emm_cause(&service_reject->emm_cause);
+
+    if (service_reject->presencemask & OGS_NAS_EPS_SERVICE_REJECT_T3442_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer(&service_reject->t3442_value);
+    }
+
+    if (service_reject->presencemask & OGS_NAS_EPS_SERVICE_REJECT_T3346_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_2(&service_reject->t3346_value);
+    }
+
+    if (service_reject->presencemask & OGS_NAS_EPS_SERVICE_REJECT_T3448_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_2(&service_reject->t3448_value);
+    }
+
+    if (service_reject->presencemask & OGS_NAS_EPS_SERVICE_REJECT_LOWER_BOUND_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_3(&service_reject->lower_bound_timer_value);
+    }
+
+    if (service_reject->presencemask & OGS_NAS_EPS_SERVICE_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FOR_ROAMING_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity_list(&service_reject->forbidden_tai_for_the_list_of_forbidden_tracking_areas_for_roaming);
+    }
 
-        size = ogs_nas_eps_encode_tracking_area_identity_list(pkbuf, &service_reject->forbidden_tai_for_the_list_of_forbidden_tracking_areas_forregional_provision_of_service);
-        ogs_assert(size >= 0);
-        encoded += size;
+    if (service_reject->presencemask & OGS_NAS_EPS_SERVICE_REJECT_FORBIDDEN_TAI_FOR_THE_LIST_OF_FORBIDDEN_TRACKING_AREAS_FORREGIONAL_PROVISION_OF_SERVICE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity_list(&service_reject->forbidden_tai_for_the_list_of_forbidden_tracking_areas_forregional_provision_of_service);
     }
 
-    return encoded;
+    return length;
 }
 
 int ogs_nas_eps_encode_guti_reallocation_command(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
@@ -1802,6 +2704,35 @@ int ogs_nas_eps_encode_guti_reallocation_command(ogs_pkbuf_t *pkbuf, ogs_nas_eps
     return encoded;
 }
 
+int ogs_nas_eps_length_guti_reallocation_command(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_guti_reallocation_command_t *guti_reallocation_command = &message->emm.guti_reallocation_command;
+    int length = 0;
+
+    length += ogs_nas_eps_length_eps_mobile_identity(&guti_reallocation_command->guti);
+
+    if (guti_reallocation_command->presencemask & OGS_NAS_EPS_GUTI_REALLOCATION_COMMAND_TAI_LIST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_tracking_area_identity_list(&guti_reallocation_command->tai_list);
+    }
+
+    if (guti_reallocation_command->presencemask & OGS_NAS_EPS_GUTI_REALLOCATION_COMMAND_DCN_ID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_dcn_id(&guti_reallocation_command->dcn_id);
+    }
+
+    if (guti_reallocation_command->presencemask & OGS_NAS_EPS_GUTI_REALLOCATION_COMMAND_UE_RADIO_CAPABILITY_ID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_radio_capability_id(&guti_reallocation_command->ue_radio_capability_id);
+    }
+
+    if (guti_reallocation_command->presencemask & OGS_NAS_EPS_GUTI_REALLOCATION_COMMAND_UE_RADIO_CAPABILITY_ID_DELETION_INDICATION_PRESENT) {
+        length += ogs_nas_eps_length_ue_radio_capability_id_deletion_indication(&guti_reallocation_command->ue_radio_capability_id_deletion_indication);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_authentication_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_authentication_request_t *authentication_request = &message->emm.authentication_request;
@@ -1825,6 +2756,18 @@ int ogs_nas_eps_encode_authentication_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_me
     return encoded;
 }
 
+int ogs_nas_eps_length_authentication_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_authentication_request_t *authentication_request = &message->emm.authentication_request;
+    int length = 0;
+
+    length += ogs_nas_eps_length_key_set_identifier(&authentication_request->nas_key_set_identifierasme);
+    length += ogs_nas_eps_length_authentication_parameter_rand(&authentication_request->authentication_parameter_rand);
+    length += ogs_nas_eps_length_authentication_parameter_autn(&authentication_request->authentication_parameter_autn);
+
+    return length;
+}
+
 int ogs_nas_eps_encode_authentication_response(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_authentication_response_t *authentication_response = &message->emm.authentication_response;
@@ -1840,6 +2783,16 @@ int ogs_nas_eps_encode_authentication_response(ogs_pkbuf_t *pkbuf, ogs_nas_eps_m
     return encoded;
 }
 
+int ogs_nas_eps_length_authentication_response(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_authentication_response_t *authentication_response = &message->emm.authentication_response;
+    int length = 0;
+
+    length += ogs_nas_eps_length_authentication_response_parameter(&authentication_response->authentication_response_parameter);
+
+    return length;
+}
+
 int ogs_nas_eps_encode_identity_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_identity_request_t *identity_request = &message->emm.identity_request;
@@ -1855,6 +2808,16 @@ int ogs_nas_eps_encode_identity_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_
     return encoded;
 }
 
+int ogs_nas_eps_length_identity_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_identity_request_t *identity_request = &message->emm.identity_request;
+    int length = 0;
+
+    length += ogs_nas_eps_length_identity_type_2(&identity_request->identity_type);
+
+    return length;
+}
+
 int ogs_nas_eps_encode_identity_response(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_identity_response_t *identity_response = &message->emm.identity_response;
@@ -1870,6 +2833,16 @@ int ogs_nas_eps_encode_identity_response(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message
     return encoded;
 }
 
+int ogs_nas_eps_length_identity_response(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_identity_response_t *identity_response = &message->emm.identity_response;
+    int length = 0;
+
+    length += ogs_nas_eps_length_mobile_identity(&identity_response->mobile_identity);
+
+    return length;
+}
+
 int ogs_nas_eps_encode_authentication_failure(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_authentication_failure_t *authentication_failure = &message->emm.authentication_failure;
@@ -1895,6 +2868,21 @@ int ogs_nas_eps_encode_authentication_failure(ogs_pkbuf_t *pkbuf, ogs_nas_eps_me
     return encoded;
 }
 
+int ogs_nas_eps_length_authentication_failure(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_authentication_failure_t *authentication_failure = &message->emm.authentication_failure;
+    int length = 0;
+
+    length += ogs_nas_eps_length_emm_cause(&authentication_failure->emm_cause);
+
+    if (authentication_failure->presencemask & OGS_NAS_EPS_AUTHENTICATION_FAILURE_AUTHENTICATION_FAILURE_PARAMETER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_authentication_failure_parameter(&authentication_failure->authentication_failure_parameter);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_security_mode_command(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_security_mode_command_t *security_mode_command = &message->emm.security_mode_command;
@@ -1976,6 +2964,47 @@ int ogs_nas_eps_encode_security_mode_command(ogs_pkbuf_t *pkbuf, ogs_nas_eps_mes
     return encoded;
 }
 
+int ogs_nas_eps_length_security_mode_command(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_security_mode_command_t *security_mode_command = &message->emm.security_mode_command;
+    int length = 0;
+
+    length += ogs_nas_eps_length_security_algorithms(&security_mode_command->selected_nas_security_algorithms);
+    length += ogs_nas_eps_length_key_set_identifier(&security_mode_command->nas_key_set_identifier);
+    length += ogs_nas_eps_length_ue_security_capability(&security_mode_command->replayed_ue_security_capabilities);
+
+    if (security_mode_command->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMMAND_IMEISV_REQUEST_PRESENT) {
+        length += ogs_nas_eps_length_imeisv_request(&security_mode_command->imeisv_request);
+    }
+
+    if (security_mode_command->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMMAND_REPLAYED_NONCEUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nonce(&security_mode_command->replayed_nonceue);
+    }
+
+    if (security_mode_command->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMMAND_NONCEMME_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nonce(&security_mode_command->noncemme);
+    }
+
+    if (security_mode_command->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMMAND_HASHMME_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_hashmme(&security_mode_command->hashmme);
+    }
+
+    if (security_mode_command->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMMAND_REPLAYED_UE_ADDITIONAL_SECURITY_CAPABILITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_additional_security_capability(&security_mode_command->replayed_ue_additional_security_capability);
+    }
+
+    if (security_mode_command->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMMAND_UE_RADIO_CAPABILITY_ID_REQUEST_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_radio_capability_id_request(&security_mode_command->ue_radio_capability_id_request);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_security_mode_complete(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_security_mode_complete_t *security_mode_complete = &message->emm.security_mode_complete;
@@ -2017,6 +3046,29 @@ int ogs_nas_eps_encode_security_mode_complete(ogs_pkbuf_t *pkbuf, ogs_nas_eps_me
     return encoded;
 }
 
+int ogs_nas_eps_length_security_mode_complete(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_security_mode_complete_t *security_mode_complete = &message->emm.security_mode_complete;
+    int length = 0;
+
+    if (security_mode_complete->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMPLETE_IMEISV_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_mobile_identity(&security_mode_complete->imeisv);
+    }
+
+    if (security_mode_complete->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMPLETE_REPLAYED_NAS_MESSAGE_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_replayed_nas_message_container(&security_mode_complete->replayed_nas_message_container);
+    }
+
+    if (security_mode_complete->presencemask & OGS_NAS_EPS_SECURITY_MODE_COMPLETE_UE_RADIO_CAPABILITY_ID_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ue_radio_capability_id(&security_mode_complete->ue_radio_capability_id);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_security_mode_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_security_mode_reject_t *security_mode_reject = &message->emm.security_mode_reject;
@@ -2032,6 +3084,16 @@ int ogs_nas_eps_encode_security_mode_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_mess
     return encoded;
 }
 
+int ogs_nas_eps_length_security_mode_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_security_mode_reject_t *security_mode_reject = &message->emm.security_mode_reject;
+    int length = 0;
+
+    length += ogs_nas_eps_length_emm_cause(&security_mode_reject->emm_cause);
+
+    return length;
+}
+
 int ogs_nas_eps_encode_emm_status(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_emm_status_t *emm_status = &message->emm.emm_status;
@@ -2047,6 +3109,16 @@ int ogs_nas_eps_encode_emm_status(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *mes
     return encoded;
 }
 
+int ogs_nas_eps_length_emm_status(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_emm_status_t *emm_status = &message->emm.emm_status;
+    int length = 0;
+
+    length += ogs_nas_eps_length_emm_cause(&emm_status->emm_cause);
+
+    return length;
+}
+
 int ogs_nas_eps_encode_emm_information(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_emm_information_t *emm_information = &message->emm.emm_information;
@@ -2108,6 +3180,39 @@ int ogs_nas_eps_encode_emm_information(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t
     return encoded;
 }
 
+int ogs_nas_eps_length_emm_information(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_emm_information_t *emm_information = &message->emm.emm_information;
+    int length = 0;
+
+    if (emm_information->presencemask & OGS_NAS_EPS_EMM_INFORMATION_FULL_NAME_FOR_NETWORK_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_network_name(&emm_information->full_name_for_network);
+    }
+
+    if (emm_information->presencemask & OGS_NAS_EPS_EMM_INFORMATION_SHORT_NAME_FOR_NETWORK_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_network_name(&emm_information->short_name_for_network);
+    }
+
+    if (emm_information->presencemask & OGS_NAS_EPS_EMM_INFORMATION_LOCAL_TIME_ZONE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_time_zone(&emm_information->local_time_zone);
+    }
+
+    if (emm_information->presencemask & OGS_NAS_EPS_EMM_INFORMATION_UNIVERSAL_TIME_AND_LOCAL_TIME_ZONE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_time_zone_and_time(&emm_information->universal_time_and_local_time_zone);
+    }
+
+    if (emm_information->presencemask & OGS_NAS_EPS_EMM_INFORMATION_NETWORK_DAYLIGHT_SAVING_TIME_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_daylight_saving_time(&emm_information->network_daylight_saving_time);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_downlink_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_downlink_nas_transport_t *downlink_nas_transport = &message->emm.downlink_nas_transport;
@@ -2123,6 +3228,16 @@ int ogs_nas_eps_encode_downlink_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_eps_me
     return encoded;
 }
 
+int ogs_nas_eps_length_downlink_nas_transport(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_downlink_nas_transport_t *downlink_nas_transport = &message->emm.downlink_nas_transport;
+    int length = 0;
+
+    length += ogs_nas_eps_length_eps_message_container(&downlink_nas_transport->nas_message_container);
+
+    return length;
+}
+
 int ogs_nas_eps_encode_uplink_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_uplink_nas_transport_t *uplink_nas_transport = &message->emm.uplink_nas_transport;
@@ -2138,6 +3253,16 @@ int ogs_nas_eps_encode_uplink_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_eps_mess
     return encoded;
 }
 
+int ogs_nas_eps_length_uplink_nas_transport(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_uplink_nas_transport_t *uplink_nas_transport = &message->emm.uplink_nas_transport;
+    int length = 0;
+
+    length += ogs_nas_eps_length_eps_message_container(&uplink_nas_transport->nas_message_container);
+
+    return length;
+}
+
 int ogs_nas_eps_encode_cs_service_notification(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_cs_service_notification_t *cs_service_notification = &message->emm.cs_service_notification;
@@ -2193,6 +3318,36 @@ int ogs_nas_eps_encode_cs_service_notification(ogs_pkbuf_t *pkbuf, ogs_nas_eps_m
     return encoded;
 }
 
+int ogs_nas_eps_length_cs_service_notification(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_cs_service_notification_t *cs_service_notification = &message->emm.cs_service_notification;
+    int length = 0;
+
+    length += ogs_nas_eps_length_paging_identity(&cs_service_notification->paging_identity);
+
+    if (cs_service_notification->presencemask & OGS_NAS_EPS_CS_SERVICE_NOTIFICATION_CLI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_cli(&cs_service_notification->cli);
+    }
+
+    if (cs_service_notification->presencemask & OGS_NAS_EPS_CS_SERVICE_NOTIFICATION_SS_CODE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_ss_code(&cs_service_notification->ss_code);
+    }
+
+    if (cs_service_notification->presencemask & OGS_NAS_EPS_CS_SERVICE_NOTIFICATION_LCS_INDICATOR_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_lcs_indicator(&cs_service_notification->lcs_indicator);
+    }
+
+    if (cs_service_notification->presencemask & OGS_NAS_EPS_CS_SERVICE_NOTIFICATION_LCS_CLIENT_IDENTITY_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_lcs_client_identity(&cs_service_notification->lcs_client_identity);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_uplink_generic_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_uplink_generic_nas_transport_t *uplink_generic_nas_transport = &message->emm.uplink_generic_nas_transport;
@@ -2222,6 +3377,22 @@ int ogs_nas_eps_encode_uplink_generic_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_
     return encoded;
 }
 
+int ogs_nas_eps_length_uplink_generic_nas_transport(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_uplink_generic_nas_transport_t *uplink_generic_nas_transport = &message->emm.uplink_generic_nas_transport;
+    int length = 0;
+
+    length += ogs_nas_eps_length_generic_message_container_type(&uplink_generic_nas_transport->generic_message_container_type);
+    length += ogs_nas_eps_length_generic_message_container(&uplink_generic_nas_transport->generic_message_container);
+
+    if (uplink_generic_nas_transport->presencemask & OGS_NAS_EPS_UPLINK_GENERIC_NAS_TRANSPORT_ADDITIONAL_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_additional_information(&uplink_generic_nas_transport->additional_information);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_downlink_generic_nas_transport(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_downlink_generic_nas_transport_t *downlink_generic_nas_transport = &message->emm.downlink_generic_nas_transport;
@@ -2251,6 +3422,22 @@ int ogs_nas_eps_encode_downlink_generic_nas_transport(ogs_pkbuf_t *pkbuf, ogs_na
     return encoded;
 }
 
+int ogs_nas_eps_length_downlink_generic_nas_transport(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_downlink_generic_nas_transport_t *downlink_generic_nas_transport = &message->emm.downlink_generic_nas_transport;
+    int length = 0;
+
+    length += ogs_nas_eps_length_generic_message_container_type(&downlink_generic_nas_transport->generic_message_container_type);
+    length += ogs_nas_eps_length_generic_message_container(&downlink_generic_nas_transport->generic_message_container);
+
+    if (downlink_generic_nas_transport->presencemask & OGS_NAS_EPS_DOWNLINK_GENERIC_NAS_TRANSPORT_ADDITIONAL_INFORMATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_additional_information(&downlink_generic_nas_transport->additional_information);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_activate_default_eps_bearer_context_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_activate_default_eps_bearer_context_request_t *activate_default_eps_bearer_context_request = &message->esm.activate_default_eps_bearer_context_request;
@@ -2426,6 +3613,94 @@ int ogs_nas_eps_encode_activate_default_eps_bearer_context_request(ogs_pkbuf_t *
     return encoded;
 }
 
+int ogs_nas_eps_length_activate_default_eps_bearer_context_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_activate_default_eps_bearer_context_request_t *activate_default_eps_bearer_context_request = &message->esm.activate_default_eps_bearer_context_request;
+    int length = 0;
+
+    length += ogs_nas_eps_length_eps_quality_of_service(&activate_default_eps_bearer_context_request->eps_qos);
+    length += ogs_nas_eps_length_access_point_name(&activate_default_eps_bearer_context_request->access_point_name);
+    length += ogs_nas_eps_length_pdn_address(&activate_default_eps_bearer_context_request->pdn_address);
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_TRANSACTION_IDENTIFIER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_transaction_identifier(&activate_default_eps_bearer_context_request->transaction_identifier);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_NEGOTIATED_QOS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_quality_of_service(&activate_default_eps_bearer_context_request->negotiated_qos);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_NEGOTIATED_LLC_SAPI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_llc_service_access_point_identifier(&activate_default_eps_bearer_context_request->negotiated_llc_sapi);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_RADIO_PRIORITY_PRESENT) {
+        length += ogs_nas_eps_length_radio_priority(&activate_default_eps_bearer_context_request->radio_priority);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_PACKET_FLOW_IDENTIFIER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_packet_flow_identifier(&activate_default_eps_bearer_context_request->packet_flow_identifier);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_APN_AMBR_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_apn_aggregate_maximum_bit_rate(&activate_default_eps_bearer_context_request->apn_ambr);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_ESM_CAUSE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_esm_cause(&activate_default_eps_bearer_context_request->esm_cause);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&activate_default_eps_bearer_context_request->protocol_configuration_options);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_CONNECTIVITY_TYPE_PRESENT) {
+        length += ogs_nas_eps_length_connectivity_type(&activate_default_eps_bearer_context_request->connectivity_type);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_WLAN_OFFLOAD_INDICATION_PRESENT) {
+        length += ogs_nas_eps_length_wlan_offload_acceptability(&activate_default_eps_bearer_context_request->wlan_offload_indication);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_NBIFOM_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nbifom_container(&activate_default_eps_bearer_context_request->nbifom_container);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_HEADER_COMPRESSION_CONFIGURATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_header_compression_configuration(&activate_default_eps_bearer_context_request->header_compression_configuration);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_CONTROL_PLANE_ONLY_INDICATION_PRESENT) {
+        length += ogs_nas_eps_length_control_plane_only_indication(&activate_default_eps_bearer_context_request->control_plane_only_indication);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&activate_default_eps_bearer_context_request->extended_protocol_configuration_options);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_SERVING_PLMN_RATE_CONTROL_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_serving_plmn_rate_control(&activate_default_eps_bearer_context_request->serving_plmn_rate_control);
+    }
+
+    if (activate_default_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_APN_AMBR_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_apn_aggregate_maximum_bit_rate(&activate_default_eps_bearer_context_request->extended_apn_ambr);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_activate_default_eps_bearer_context_accept(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_activate_default_eps_bearer_context_accept_t *activate_default_eps_bearer_context_accept = &message->esm.activate_default_eps_bearer_context_accept;
@@ -2457,6 +3732,24 @@ int ogs_nas_eps_encode_activate_default_eps_bearer_context_accept(ogs_pkbuf_t *p
     return encoded;
 }
 
+int ogs_nas_eps_length_activate_default_eps_bearer_context_accept(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_activate_default_eps_bearer_context_accept_t *activate_default_eps_bearer_context_accept = &message->esm.activate_default_eps_bearer_context_accept;
+    int length = 0;
+
+    if (activate_default_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_ACCEPT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&activate_default_eps_bearer_context_accept->protocol_configuration_options);
+    }
+
+    if (activate_default_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_ACCEPT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&activate_default_eps_bearer_context_accept->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_activate_default_eps_bearer_context_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_activate_default_eps_bearer_context_reject_t *activate_default_eps_bearer_context_reject = &message->esm.activate_default_eps_bearer_context_reject;
@@ -2489,7 +3782,27 @@ int ogs_nas_eps_encode_activate_default_eps_bearer_context_reject(ogs_pkbuf_t *p
         encoded += size;
     }
 
-    return encoded;
+    return encoded;
+}
+
+int ogs_nas_eps_length_activate_default_eps_bearer_context_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_activate_default_eps_bearer_context_reject_t *activate_default_eps_bearer_context_reject = &message->esm.activate_default_eps_bearer_context_reject;
+    int length = 0;
+
+    length += ogs_nas_eps_length_esm_cause(&activate_default_eps_bearer_context_reject->esm_cause);
+
+    if (activate_default_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REJECT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&activate_default_eps_bearer_context_reject->protocol_configuration_options);
+    }
+
+    if (activate_default_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&activate_default_eps_bearer_context_reject->extended_protocol_configuration_options);
+    }
+
+    return length;
 }
 
 int ogs_nas_eps_encode_activate_dedicated_eps_bearer_context_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
@@ -2611,6 +3924,66 @@ int ogs_nas_eps_encode_activate_dedicated_eps_bearer_context_request(ogs_pkbuf_t
     return encoded;
 }
 
+int ogs_nas_eps_length_activate_dedicated_eps_bearer_context_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_activate_dedicated_eps_bearer_context_request_t *activate_dedicated_eps_bearer_context_request = &message->esm.activate_dedicated_eps_bearer_context_request;
+    int length = 0;
+
+    length += ogs_nas_eps_length_linked_eps_bearer_identity(&activate_dedicated_eps_bearer_context_request->linked_eps_bearer_identity);
+    length += ogs_nas_eps_length_eps_quality_of_service(&activate_dedicated_eps_bearer_context_request->eps_qos);
+    length += ogs_nas_eps_length_traffic_flow_template(&activate_dedicated_eps_bearer_context_request->tft);
+
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_TRANSACTION_IDENTIFIER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_transaction_identifier(&activate_dedicated_eps_bearer_context_request->transaction_identifier);
+    }
+
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_NEGOTIATED_QOS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_quality_of_service(&activate_dedicated_eps_bearer_context_request->negotiated_qos);
+    }
+
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_NEGOTIATED_LLC_SAPI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_llc_service_access_point_identifier(&activate_dedicated_eps_bearer_context_request->negotiated_llc_sapi);
+    }
+
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_RADIO_PRIORITY_PRESENT) {
+        length += ogs_nas_eps_length_radio_priority(&activate_dedicated_eps_bearer_context_request->radio_priority);
+    }
+
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_PACKET_FLOW_IDENTIFIER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_packet_flow_identifier(&activate_dedicated_eps_bearer_context_request->packet_flow_identifier);
+    }
+
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&activate_dedicated_eps_bearer_context_request->protocol_configuration_options);
+    }
+
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_WLAN_OFFLOAD_INDICATION_PRESENT) {
+        length += ogs_nas_eps_length_wlan_offload_acceptability(&activate_dedicated_eps_bearer_context_request->wlan_offload_indication);
+    }
+
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_NBIFOM_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nbifom_container(&activate_dedicated_eps_bearer_context_request->nbifom_container);
+    }
+
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&activate_dedicated_eps_bearer_context_request->extended_protocol_configuration_options);
+    }
+
+    if (activate_dedicated_eps_bearer_context_request->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_EPS_QOS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_quality_of_service(&activate_dedicated_eps_bearer_context_request->extended_eps_qos);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_activate_dedicated_eps_bearer_context_accept(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_activate_dedicated_eps_bearer_context_accept_t *activate_dedicated_eps_bearer_context_accept = &message->esm.activate_dedicated_eps_bearer_context_accept;
@@ -2652,6 +4025,29 @@ int ogs_nas_eps_encode_activate_dedicated_eps_bearer_context_accept(ogs_pkbuf_t
     return encoded;
 }
 
+int ogs_nas_eps_length_activate_dedicated_eps_bearer_context_accept(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_activate_dedicated_eps_bearer_context_accept_t *activate_dedicated_eps_bearer_context_accept = &message->esm.activate_dedicated_eps_bearer_context_accept;
+    int length = 0;
+
+    if (activate_dedicated_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_ACCEPT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&activate_dedicated_eps_bearer_context_accept->protocol_configuration_options);
+    }
+
+    if (activate_dedicated_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_ACCEPT_NBIFOM_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nbifom_container(&activate_dedicated_eps_bearer_context_accept->nbifom_container);
+    }
+
+    if (activate_dedicated_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_ACCEPT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&activate_dedicated_eps_bearer_context_accept->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_activate_dedicated_eps_bearer_context_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_activate_dedicated_eps_bearer_context_reject_t *activate_dedicated_eps_bearer_context_reject = &message->esm.activate_dedicated_eps_bearer_context_reject;
@@ -2697,6 +4093,31 @@ int ogs_nas_eps_encode_activate_dedicated_eps_bearer_context_reject(ogs_pkbuf_t
     return encoded;
 }
 
+int ogs_nas_eps_length_activate_dedicated_eps_bearer_context_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_activate_dedicated_eps_bearer_context_reject_t *activate_dedicated_eps_bearer_context_reject = &message->esm.activate_dedicated_eps_bearer_context_reject;
+    int length = 0;
+
+    length += ogs_nas_eps_length_esm_cause(&activate_dedicated_eps_bearer_context_reject->esm_cause);
+
+    if (activate_dedicated_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REJECT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&activate_dedicated_eps_bearer_context_reject->protocol_configuration_options);
+    }
+
+    if (activate_dedicated_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REJECT_NBIFOM_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nbifom_container(&activate_dedicated_eps_bearer_context_reject->nbifom_container);
+    }
+
+    if (activate_dedicated_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&activate_dedicated_eps_bearer_context_reject->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_modify_eps_bearer_context_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_modify_eps_bearer_context_request_t *modify_eps_bearer_context_request = &message->esm.modify_eps_bearer_context_request;
@@ -2844,6 +4265,82 @@ int ogs_nas_eps_encode_modify_eps_bearer_context_request(ogs_pkbuf_t *pkbuf, ogs
     return encoded;
 }
 
+int ogs_nas_eps_length_modify_eps_bearer_context_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_modify_eps_bearer_context_request_t *modify_eps_bearer_context_request = &message->esm.modify_eps_bearer_context_request;
+    int length = 0;
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_NEW_EPS_QOS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_eps_quality_of_service(&modify_eps_bearer_context_request->new_eps_qos);
+    }
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_TFT_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_traffic_flow_template(&modify_eps_bearer_context_request->tft);
+    }
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_NEW_QOS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_quality_of_service(&modify_eps_bearer_context_request->new_qos);
+    }
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_NEGOTIATED_LLC_SAPI_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_llc_service_access_point_identifier(&modify_eps_bearer_context_request->negotiated_llc_sapi);
+    }
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_RADIO_PRIORITY_PRESENT) {
+        length += ogs_nas_eps_length_radio_priority(&modify_eps_bearer_context_request->radio_priority);
+    }
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_PACKET_FLOW_IDENTIFIER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_packet_flow_identifier(&modify_eps_bearer_context_request->packet_flow_identifier);
+    }
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_APN_AMBR_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_apn_aggregate_maximum_bit_rate(&modify_eps_bearer_context_request->apn_ambr);
+    }
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&modify_eps_bearer_context_request->protocol_configuration_options);
+    }
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_WLAN_OFFLOAD_INDICATION_PRESENT) {
+        length += ogs_nas_eps_length_wlan_offload_acceptability(&modify_eps_bearer_context_request->wlan_offload_indication);
+    }
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_NBIFOM_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nbifom_container(&modify_eps_bearer_context_request->nbifom_container);
+    }
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_HEADER_COMPRESSION_CONFIGURATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_header_compression_configuration(&modify_eps_bearer_context_request->header_compression_configuration);
+    }
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&modify_eps_bearer_context_request->extended_protocol_configuration_options);
+    }
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_APN_AMBR_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_apn_aggregate_maximum_bit_rate(&modify_eps_bearer_context_request->extended_apn_ambr);
+    }
+
+    if (modify_eps_bearer_context_request->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_EPS_QOS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_quality_of_service(&modify_eps_bearer_context_request->extended_eps_qos);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_modify_eps_bearer_context_accept(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_modify_eps_bearer_context_accept_t *modify_eps_bearer_context_accept = &message->esm.modify_eps_bearer_context_accept;
@@ -2885,6 +4382,29 @@ int ogs_nas_eps_encode_modify_eps_bearer_context_accept(ogs_pkbuf_t *pkbuf, ogs_
     return encoded;
 }
 
+int ogs_nas_eps_length_modify_eps_bearer_context_accept(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_modify_eps_bearer_context_accept_t *modify_eps_bearer_context_accept = &message->esm.modify_eps_bearer_context_accept;
+    int length = 0;
+
+    if (modify_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_ACCEPT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&modify_eps_bearer_context_accept->protocol_configuration_options);
+    }
+
+    if (modify_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_ACCEPT_NBIFOM_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nbifom_container(&modify_eps_bearer_context_accept->nbifom_container);
+    }
+
+    if (modify_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_ACCEPT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&modify_eps_bearer_context_accept->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_modify_eps_bearer_context_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_modify_eps_bearer_context_reject_t *modify_eps_bearer_context_reject = &message->esm.modify_eps_bearer_context_reject;
@@ -2930,6 +4450,31 @@ int ogs_nas_eps_encode_modify_eps_bearer_context_reject(ogs_pkbuf_t *pkbuf, ogs_
     return encoded;
 }
 
+int ogs_nas_eps_length_modify_eps_bearer_context_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_modify_eps_bearer_context_reject_t *modify_eps_bearer_context_reject = &message->esm.modify_eps_bearer_context_reject;
+    int length = 0;
+
+    length += ogs_nas_eps_length_esm_cause(&modify_eps_bearer_context_reject->esm_cause);
+
+    if (modify_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REJECT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&modify_eps_bearer_context_reject->protocol_configuration_options);
+    }
+
+    if (modify_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REJECT_NBIFOM_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nbifom_container(&modify_eps_bearer_context_reject->nbifom_container);
+    }
+
+    if (modify_eps_bearer_context_reject->presencemask & OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&modify_eps_bearer_context_reject->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_deactivate_eps_bearer_context_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_deactivate_eps_bearer_context_request_t *deactivate_eps_bearer_context_request = &message->esm.deactivate_eps_bearer_context_request;
@@ -2993,6 +4538,40 @@ int ogs_nas_eps_encode_deactivate_eps_bearer_context_request(ogs_pkbuf_t *pkbuf,
     return encoded;
 }
 
+int ogs_nas_eps_length_deactivate_eps_bearer_context_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_deactivate_eps_bearer_context_request_t *deactivate_eps_bearer_context_request = &message->esm.deactivate_eps_bearer_context_request;
+    int length = 0;
+
+    length += ogs_nas_eps_length_esm_cause(&deactivate_eps_bearer_context_request->esm_cause);
+
+    if (deactivate_eps_bearer_context_request->presencemask & OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&deactivate_eps_bearer_context_request->protocol_configuration_options);
+    }
+
+    if (deactivate_eps_bearer_context_request->presencemask & OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_REQUEST_T3396_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_3(&deactivate_eps_bearer_context_request->t3396_value);
+    }
+
+    if (deactivate_eps_bearer_context_request->presencemask & OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_REQUEST_WLAN_OFFLOAD_INDICATION_PRESENT) {
+        length += ogs_nas_eps_length_wlan_offload_acceptability(&deactivate_eps_bearer_context_request->wlan_offload_indication);
+    }
+
+    if (deactivate_eps_bearer_context_request->presencemask & OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_REQUEST_NBIFOM_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nbifom_container(&deactivate_eps_bearer_context_request->nbifom_container);
+    }
+
+    if (deactivate_eps_bearer_context_request->presencemask & OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&deactivate_eps_bearer_context_request->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_deactivate_eps_bearer_context_accept(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_deactivate_eps_bearer_context_accept_t *deactivate_eps_bearer_context_accept = &message->esm.deactivate_eps_bearer_context_accept;
@@ -3024,6 +4603,24 @@ int ogs_nas_eps_encode_deactivate_eps_bearer_context_accept(ogs_pkbuf_t *pkbuf,
     return encoded;
 }
 
+int ogs_nas_eps_length_deactivate_eps_bearer_context_accept(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_deactivate_eps_bearer_context_accept_t *deactivate_eps_bearer_context_accept = &message->esm.deactivate_eps_bearer_context_accept;
+    int length = 0;
+
+    if (deactivate_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_ACCEPT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&deactivate_eps_bearer_context_accept->protocol_configuration_options);
+    }
+
+    if (deactivate_eps_bearer_context_accept->presencemask & OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_ACCEPT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&deactivate_eps_bearer_context_accept->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_pdn_connectivity_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_pdn_connectivity_request_t *pdn_connectivity_request = &message->esm.pdn_connectivity_request;
@@ -3105,6 +4702,49 @@ int ogs_nas_eps_encode_pdn_connectivity_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_
     return encoded;
 }
 
+int ogs_nas_eps_length_pdn_connectivity_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_pdn_connectivity_request_t *pdn_connectivity_request = &message->esm.pdn_connectivity_request;
+    int length = 0;
+
+    length += ogs_nas_eps_length_request_type(&pdn_connectivity_request->request_type);
+
+    if (pdn_connectivity_request->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST_ESM_INFORMATION_TRANSFER_FLAG_PRESENT) {
+        length += ogs_nas_eps_length_esm_information_transfer_flag(&pdn_connectivity_request->esm_information_transfer_flag);
+    }
+
+    if (pdn_connectivity_request->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST_ACCESS_POINT_NAME_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_access_point_name(&pdn_connectivity_request->access_point_name);
+    }
+
+    if (pdn_connectivity_request->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&pdn_connectivity_request->protocol_configuration_options);
+    }
+
+    if (pdn_connectivity_request->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST_DEVICE_PROPERTIES_PRESENT) {
+        length += ogs_nas_eps_length_device_properties(&pdn_connectivity_request->device_properties);
+    }
+
+    if (pdn_connectivity_request->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST_NBIFOM_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nbifom_container(&pdn_connectivity_request->nbifom_container);
+    }
+
+    if (pdn_connectivity_request->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST_HEADER_COMPRESSION_CONFIGURATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_header_compression_configuration(&pdn_connectivity_request->header_compression_configuration);
+    }
+
+    if (pdn_connectivity_request->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&pdn_connectivity_request->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_pdn_connectivity_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_pdn_connectivity_reject_t *pdn_connectivity_reject = &message->esm.pdn_connectivity_reject;
@@ -3170,6 +4810,41 @@ int ogs_nas_eps_encode_pdn_connectivity_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_m
     return encoded;
 }
 
+int ogs_nas_eps_length_pdn_connectivity_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_pdn_connectivity_reject_t *pdn_connectivity_reject = &message->esm.pdn_connectivity_reject;
+    int length = 0;
+
+    length += ogs_nas_eps_length_esm_cause(&pdn_connectivity_reject->esm_cause);
+
+    if (pdn_connectivity_reject->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REJECT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&pdn_connectivity_reject->protocol_configuration_options);
+    }
+
+    if (pdn_connectivity_reject->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REJECT_BACK_OFF_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_3(&pdn_connectivity_reject->back_off_timer_value);
+    }
+
+    if (pdn_connectivity_reject->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REJECT_RE_ATTEMPT_INDICATOR_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_re_attempt_indicator(&pdn_connectivity_reject->re_attempt_indicator);
+    }
+
+    if (pdn_connectivity_reject->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REJECT_NBIFOM_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nbifom_container(&pdn_connectivity_reject->nbifom_container);
+    }
+
+    if (pdn_connectivity_reject->presencemask & OGS_NAS_EPS_PDN_CONNECTIVITY_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&pdn_connectivity_reject->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_pdn_disconnect_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_pdn_disconnect_request_t *pdn_disconnect_request = &message->esm.pdn_disconnect_request;
@@ -3205,6 +4880,26 @@ int ogs_nas_eps_encode_pdn_disconnect_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_me
     return encoded;
 }
 
+int ogs_nas_eps_length_pdn_disconnect_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_pdn_disconnect_request_t *pdn_disconnect_request = &message->esm.pdn_disconnect_request;
+    int length = 0;
+
+    length += ogs_nas_eps_length_linked_eps_bearer_identity(&pdn_disconnect_request->linked_eps_bearer_identity);
+
+    if (pdn_disconnect_request->presencemask & OGS_NAS_EPS_PDN_DISCONNECT_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&pdn_disconnect_request->protocol_configuration_options);
+    }
+
+    if (pdn_disconnect_request->presencemask & OGS_NAS_EPS_PDN_DISCONNECT_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&pdn_disconnect_request->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_pdn_disconnect_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_pdn_disconnect_reject_t *pdn_disconnect_reject = &message->esm.pdn_disconnect_reject;
@@ -3228,16 +4923,36 @@ int ogs_nas_eps_encode_pdn_disconnect_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_mes
     }
 
     if (pdn_disconnect_reject->presencemask & OGS_NAS_EPS_PDN_DISCONNECT_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
-        size = ogs_nas_eps_encode_optional_type(pkbuf, OGS_NAS_EPS_PDN_DISCONNECT_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_TYPE);
-        ogs_assert(size >= 0);
-        encoded += size;
-
-        size = ogs_nas_eps_encode_extended_protocol_configuration_options(pkbuf, &pdn_disconnect_reject->extended_protocol_configuration_options);
-        ogs_assert(size >= 0);
-        encoded += size;
+        size = ogs_nas_eps_encode_optional_type(pkbuf, OGS_NAS_EPS_PDN_DISCONNECT_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_TYPE);
+        ogs_assert(size >= 0);
+        encoded += size;
+
+        size = ogs_nas_eps_encode_extended_protocol_configuration_options(pkbuf, &pdn_disconnect_reject->extended_protocol_configuration_options);
+        ogs_assert(size >= 0);
+        encoded += size;
+    }
+
+    return encoded;
+}
+
+int ogs_nas_eps_length_pdn_disconnect_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_pdn_disconnect_reject_t *pdn_disconnect_reject = &message->esm.pdn_disconnect_reject;
+    int length = 0;
+
+    length += ogs_nas_eps_length_esm_cause(&pdn_disconnect_reject->esm_cause);
+
+    if (pdn_disconnect_reject->presencemask & OGS_NAS_EPS_PDN_DISCONNECT_REJECT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&pdn_disconnect_reject->protocol_configuration_options);
+    }
+
+    if (pdn_disconnect_reject->presencemask & OGS_NAS_EPS_PDN_DISCONNECT_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&pdn_disconnect_reject->extended_protocol_configuration_options);
     }
 
-    return encoded;
+    return length;
 }
 
 int ogs_nas_eps_encode_bearer_resource_allocation_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
@@ -3311,6 +5026,42 @@ int ogs_nas_eps_encode_bearer_resource_allocation_request(ogs_pkbuf_t *pkbuf, og
     return encoded;
 }
 
+int ogs_nas_eps_length_bearer_resource_allocation_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_bearer_resource_allocation_request_t *bearer_resource_allocation_request = &message->esm.bearer_resource_allocation_request;
+    int length = 0;
+
+    length += ogs_nas_eps_length_linked_eps_bearer_identity(&bearer_resource_allocation_request->linked_eps_bearer_identity);
+    length += ogs_nas_eps_length_traffic_flow_aggregate_description(&bearer_resource_allocation_request->traffic_flow_aggregate);
+    length += ogs_nas_eps_length_eps_quality_of_service(&bearer_resource_allocation_request->required_traffic_flow_qos);
+
+    if (bearer_resource_allocation_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&bearer_resource_allocation_request->protocol_configuration_options);
+    }
+
+    if (bearer_resource_allocation_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REQUEST_DEVICE_PROPERTIES_PRESENT) {
+        length += ogs_nas_eps_length_device_properties(&bearer_resource_allocation_request->device_properties);
+    }
+
+    if (bearer_resource_allocation_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REQUEST_NBIFOM_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nbifom_container(&bearer_resource_allocation_request->nbifom_container);
+    }
+
+    if (bearer_resource_allocation_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&bearer_resource_allocation_request->extended_protocol_configuration_options);
+    }
+
+    if (bearer_resource_allocation_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REQUEST_EXTENDED_EPS_QOS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_quality_of_service(&bearer_resource_allocation_request->extended_eps_qos);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_bearer_resource_allocation_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_bearer_resource_allocation_reject_t *bearer_resource_allocation_reject = &message->esm.bearer_resource_allocation_reject;
@@ -3376,6 +5127,41 @@ int ogs_nas_eps_encode_bearer_resource_allocation_reject(ogs_pkbuf_t *pkbuf, ogs
     return encoded;
 }
 
+int ogs_nas_eps_length_bearer_resource_allocation_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_bearer_resource_allocation_reject_t *bearer_resource_allocation_reject = &message->esm.bearer_resource_allocation_reject;
+    int length = 0;
+
+    length += ogs_nas_eps_length_esm_cause(&bearer_resource_allocation_reject->esm_cause);
+
+    if (bearer_resource_allocation_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REJECT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&bearer_resource_allocation_reject->protocol_configuration_options);
+    }
+
+    if (bearer_resource_allocation_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REJECT_BACK_OFF_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_3(&bearer_resource_allocation_reject->back_off_timer_value);
+    }
+
+    if (bearer_resource_allocation_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REJECT_RE_ATTEMPT_INDICATOR_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_re_attempt_indicator(&bearer_resource_allocation_reject->re_attempt_indicator);
+    }
+
+    if (bearer_resource_allocation_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REJECT_NBIFOM_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nbifom_container(&bearer_resource_allocation_reject->nbifom_container);
+    }
+
+    if (bearer_resource_allocation_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&bearer_resource_allocation_reject->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_bearer_resource_modification_request(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_bearer_resource_modification_request_t *bearer_resource_modification_request = &message->esm.bearer_resource_modification_request;
@@ -3473,6 +5259,56 @@ int ogs_nas_eps_encode_bearer_resource_modification_request(ogs_pkbuf_t *pkbuf,
     return encoded;
 }
 
+int ogs_nas_eps_length_bearer_resource_modification_request(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_bearer_resource_modification_request_t *bearer_resource_modification_request = &message->esm.bearer_resource_modification_request;
+    int length = 0;
+
+    length += ogs_nas_eps_length_linked_eps_bearer_identity(&bearer_resource_modification_request->eps_bearer_identity_for_packet_filter);
+    length += ogs_nas_eps_length_traffic_flow_aggregate_description(&bearer_resource_modification_request->traffic_flow_aggregate);
+
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_REQUIRED_TRAFFIC_FLOW_QOS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_eps_quality_of_service(&bearer_resource_modification_request->required_traffic_flow_qos);
+    }
+
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_ESM_CAUSE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_esm_cause(&bearer_resource_modification_request->esm_cause);
+    }
+
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&bearer_resource_modification_request->protocol_configuration_options);
+    }
+
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_DEVICE_PROPERTIES_PRESENT) {
+        length += ogs_nas_eps_length_device_properties(&bearer_resource_modification_request->device_properties);
+    }
+
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_NBIFOM_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nbifom_container(&bearer_resource_modification_request->nbifom_container);
+    }
+
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_HEADER_COMPRESSION_CONFIGURATION_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_header_compression_configuration(&bearer_resource_modification_request->header_compression_configuration);
+    }
+
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&bearer_resource_modification_request->extended_protocol_configuration_options);
+    }
+
+    if (bearer_resource_modification_request->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST_EXTENDED_EPS_QOS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_quality_of_service(&bearer_resource_modification_request->extended_eps_qos);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_bearer_resource_modification_reject(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_bearer_resource_modification_reject_t *bearer_resource_modification_reject = &message->esm.bearer_resource_modification_reject;
@@ -3538,6 +5374,41 @@ int ogs_nas_eps_encode_bearer_resource_modification_reject(ogs_pkbuf_t *pkbuf, o
     return encoded;
 }
 
+int ogs_nas_eps_length_bearer_resource_modification_reject(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_bearer_resource_modification_reject_t *bearer_resource_modification_reject = &message->esm.bearer_resource_modification_reject;
+    int length = 0;
+
+    length += ogs_nas_eps_length_esm_cause(&bearer_resource_modification_reject->esm_cause);
+
+    if (bearer_resource_modification_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REJECT_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&bearer_resource_modification_reject->protocol_configuration_options);
+    }
+
+    if (bearer_resource_modification_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REJECT_BACK_OFF_TIMER_VALUE_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_gprs_timer_3(&bearer_resource_modification_reject->back_off_timer_value);
+    }
+
+    if (bearer_resource_modification_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REJECT_RE_ATTEMPT_INDICATOR_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_re_attempt_indicator(&bearer_resource_modification_reject->re_attempt_indicator);
+    }
+
+    if (bearer_resource_modification_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REJECT_NBIFOM_CONTAINER_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_nbifom_container(&bearer_resource_modification_reject->nbifom_container);
+    }
+
+    if (bearer_resource_modification_reject->presencemask & OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REJECT_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&bearer_resource_modification_reject->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_esm_information_response(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_esm_information_response_t *esm_information_response = &message->esm.esm_information_response;
@@ -3579,6 +5450,29 @@ int ogs_nas_eps_encode_esm_information_response(ogs_pkbuf_t *pkbuf, ogs_nas_eps_
     return encoded;
 }
 
+int ogs_nas_eps_length_esm_information_response(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_esm_information_response_t *esm_information_response = &message->esm.esm_information_response;
+    int length = 0;
+
+    if (esm_information_response->presencemask & OGS_NAS_EPS_ESM_INFORMATION_RESPONSE_ACCESS_POINT_NAME_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_access_point_name(&esm_information_response->access_point_name);
+    }
+
+    if (esm_information_response->presencemask & OGS_NAS_EPS_ESM_INFORMATION_RESPONSE_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_protocol_configuration_options(&esm_information_response->protocol_configuration_options);
+    }
+
+    if (esm_information_response->presencemask & OGS_NAS_EPS_ESM_INFORMATION_RESPONSE_EXTENDED_PROTOCOL_CONFIGURATION_OPTIONS_PRESENT) {
+        length += sizeof(uint8_t);
+        length += ogs_nas_eps_length_extended_protocol_configuration_options(&esm_information_response->extended_protocol_configuration_options);
+    }
+
+    return length;
+}
+
 int ogs_nas_eps_encode_esm_status(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message)
 {
     ogs_nas_eps_esm_status_t *esm_status = &message->esm.esm_status;
@@ -3594,23 +5488,225 @@ int ogs_nas_eps_encode_esm_status(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *mes
     return encoded;
 }
 
+int ogs_nas_eps_length_esm_status(ogs_nas_eps_message_t *message)
+{
+    ogs_nas_eps_esm_status_t *esm_status = &message->esm.esm_status;
+    int length = 0;
+
+    length += ogs_nas_eps_length_esm_cause(&esm_status->esm_cause);
+
+    return length;
+}
+
+int ogs_nas_emm_length(ogs_nas_eps_message_t *message)
+{
+    int length = sizeof(ogs_nas_emm_header_t);
+
+    ogs_assert(message);
+
+    if (message->emm.h.security_header_type >=
+            OGS_NAS_SECURITY_HEADER_FOR_SERVICE_REQUEST_MESSAGE)
+        return length - 1 + ogs_nas_eps_length_service_request(message);
+
+    switch (message->emm.h.message_type) {
+    case OGS_NAS_EPS_ATTACH_REQUEST:
+        length += ogs_nas_eps_length_attach_request(message);
+        break;
+    case OGS_NAS_EPS_ATTACH_ACCEPT:
+        length += ogs_nas_eps_length_attach_accept(message);
+        break;
+    case OGS_NAS_EPS_ATTACH_COMPLETE:
+        length += ogs_nas_eps_length_attach_complete(message);
+        break;
+    case OGS_NAS_EPS_ATTACH_REJECT:
+        length += ogs_nas_eps_length_attach_reject(message);
+        break;
+    case OGS_NAS_EPS_DETACH_REQUEST:
+        length += ogs_nas_eps_length_detach_request_to_ue(message);
+        break;
+    case OGS_NAS_EPS_DETACH_ACCEPT:
+        break;
+    case OGS_NAS_EPS_TRACKING_AREA_UPDATE_REQUEST:
+        length += ogs_nas_eps_length_tracking_area_update_request(message);
+        break;
+    case OGS_NAS_EPS_TRACKING_AREA_UPDATE_ACCEPT:
+        length += ogs_nas_eps_length_tracking_area_update_accept(message);
+        break;
+    case OGS_NAS_EPS_TRACKING_AREA_UPDATE_COMPLETE:
+        break;
+    case OGS_NAS_EPS_TRACKING_AREA_UPDATE_REJECT:
+        length += ogs_nas_eps_length_tracking_area_update_reject(message);
+        break;
+    case OGS_NAS_EPS_EXTENDED_SERVICE_REQUEST:
+        length += ogs_nas_eps_length_extended_service_request(message);
+        break;
+    case OGS_NAS_EPS_SERVICE_REJECT:
+        length += ogs_nas_eps_length_service_reject(message);
+        break;
+    case OGS_NAS_EPS_GUTI_REALLOCATION_COMMAND:
+        length += ogs_nas_eps_length_guti_reallocation_command(message);
+        break;
+    case OGS_NAS_EPS_GUTI_REALLOCATION_COMPLETE:
+        break;
+    case OGS_NAS_EPS_AUTHENTICATION_REQUEST:
+        length += ogs_nas_eps_length_authentication_request(message);
+        break;
+    case OGS_NAS_EPS_AUTHENTICATION_RESPONSE:
+        length += ogs_nas_eps_length_authentication_response(message);
+        break;
+    case OGS_NAS_EPS_AUTHENTICATION_REJECT:
+        break;
+    case OGS_NAS_EPS_IDENTITY_REQUEST:
+        length += ogs_nas_eps_length_identity_request(message);
+        break;
+    case OGS_NAS_EPS_IDENTITY_RESPONSE:
+        length += ogs_nas_eps_length_identity_response(message);
+        break;
+    case OGS_NAS_EPS_AUTHENTICATION_FAILURE:
+        length += ogs_nas_eps_length_authentication_failure(message);
+        break;
+    case OGS_NAS_EPS_SECURITY_MODE_COMMAND:
+        length += ogs_nas_eps_length_security_mode_command(message);
+        break;
+    case OGS_NAS_EPS_SECURITY_MODE_COMPLETE:
+        length += ogs_nas_eps_length_security_mode_complete(message);
+        break;
+    case OGS_NAS_EPS_SECURITY_MODE_REJECT:
+        length += ogs_nas_eps_length_security_mode_reject(message);
+        break;
+    case OGS_NAS_EPS_EMM_STATUS:
+        length += ogs_nas_eps_length_emm_status(message);
+        break;
+    case OGS_NAS_EPS_EMM_INFORMATION:
+        length += ogs_nas_eps_length_emm_information(message);
+        break;
+    case OGS_NAS_EPS_DOWNLINK_NAS_TRANSPORT:
+        length += ogs_nas_eps_length_downlink_nas_transport(message);
+        break;
+    case OGS_NAS_EPS_UPLINK_NAS_TRANSPORT:
+        length += ogs_nas_eps_length_uplink_nas_transport(message);
+        break;
+    case OGS_NAS_EPS_CS_SERVICE_NOTIFICATION:
+        length += ogs_nas_eps_length_cs_service_notification(message);
+        break;
+    case OGS_NAS_EPS_UPLINK_GENERIC_NAS_TRANSPORT:
+        length += ogs_nas_eps_length_uplink_generic_nas_transport(message);
+        break;
+    case OGS_NAS_EPS_DOWNLINK_GENERIC_NAS_TRANSPORT:
+        length += ogs_nas_eps_length_downlink_generic_nas_transport(message);
+        break;
+    default:
+        return -1;
+    }
+
+    return length;
+}
+
+int ogs_nas_esm_length(ogs_nas_eps_message_t *message)
+{
+    int length = sizeof(ogs_nas_esm_header_t);
+
+    ogs_assert(message);
+
+    switch (message->esm.h.message_type) {
+    case OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REQUEST:
+        length += ogs_nas_eps_length_activate_default_eps_bearer_context_request(message);
+        break;
+    case OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_ACCEPT:
+        length += ogs_nas_eps_length_activate_default_eps_bearer_context_accept(message);
+        break;
+    case OGS_NAS_EPS_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REJECT:
+        length += ogs_nas_eps_length_activate_default_eps_bearer_context_reject(message);
+        break;
+    case OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REQUEST:
+        length += ogs_nas_eps_length_activate_dedicated_eps_bearer_context_request(message);
+        break;
+    case OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_ACCEPT:
+        length += ogs_nas_eps_length_activate_dedicated_eps_bearer_context_accept(message);
+        break;
+    case OGS_NAS_EPS_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REJECT:
+        length += ogs_nas_eps_length_activate_dedicated_eps_bearer_context_reject(message);
+        break;
+    case OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REQUEST:
+        length += ogs_nas_eps_length_modify_eps_bearer_context_request(message);
+        break;
+    case OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_ACCEPT:
+        length += ogs_nas_eps_length_modify_eps_bearer_context_accept(message);
+        break;
+    case OGS_NAS_EPS_MODIFY_EPS_BEARER_CONTEXT_REJECT:
+        length += ogs_nas_eps_length_modify_eps_bearer_context_reject(message);
+        break;
+    case OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_REQUEST:
+        length += ogs_nas_eps_length_deactivate_eps_bearer_context_request(message);
+        break;
+    case OGS_NAS_EPS_DEACTIVATE_EPS_BEARER_CONTEXT_ACCEPT:
+        length += ogs_nas_eps_length_deactivate_eps_bearer_context_accept(message);
+        break;
+    case OGS_NAS_EPS_PDN_CONNECTIVITY_REQUEST:
+        length += ogs_nas_eps_length_pdn_connectivity_request(message);
+        break;
+    case OGS_NAS_EPS_PDN_CONNECTIVITY_REJECT:
+        length += ogs_nas_eps_length_pdn_connectivity_reject(message);
+        break;
+    case OGS_NAS_EPS_PDN_DISCONNECT_REQUEST:
+        length += ogs_nas_eps_length_pdn_disconnect_request(message);
+        break;
+    case OGS_NAS_EPS_PDN_DISCONNECT_REJECT:
+        length += ogs_nas_eps_length_pdn_disconnect_reject(message);
+        break;
+    case OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REQUEST:
+        length += ogs_nas_eps_length_bearer_resource_allocation_request(message);
+        break;
+    case OGS_NAS_EPS_BEARER_RESOURCE_ALLOCATION_REJECT:
+        length += ogs_nas_eps_length_bearer_resource_allocation_reject(message);
+        break;
+    case OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REQUEST:
+        length += ogs_nas_eps_length_bearer_resource_modification_request(message);
+        break;
+    case OGS_NAS_EPS_BEARER_RESOURCE_MODIFICATION_REJECT:
+        length += ogs_nas_eps_length_bearer_resource_modification_reject(message);
+        break;
+    case OGS_NAS_EPS_ESM_INFORMATION_REQUEST:
+        break;
+    case OGS_NAS_EPS_ESM_INFORMATION_RESPONSE:
+        length += ogs_nas_eps_length_esm_information_response(message);
+        break;
+    case OGS_NAS_EPS_ESM_STATUS:
+        length += ogs_nas_eps_length_esm_status(message);
+        break;
+    default:
+        return -1;
+    }
+
+    return length;
+}
+
 ogs_pkbuf_t *ogs_nas_emm_encode(ogs_nas_eps_message_t *message)
 {
     ogs_pkbuf_t *pkbuf = NULL;
     int size = 0;
     int encoded = 0;
+    int length = 0;
 
     ogs_assert(message);
 
+    length = ogs_nas_emm_length(message);
+    if (length < 0) {
+        ogs_error("Unknown message type (0x%x) or not implemented", 
+                message->emm.h.message_type);
+        return NULL;
+    }
+
     /* The Packet Buffer(ogs_pkbuf_t) for NAS message MUST make a HEADROOM. 
-     * When calculating AES_CMAC, we need to use the headroom of the packet. */
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+     * When calculating AES_CMAC, we need to use the headroom of the packet.
+     * The length is known up front; OGS_NAS_SLACK only guards it. */
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+length+OGS_NAS_SLACK);
     if (!pkbuf) {
         ogs_error("ogs_pkbuf_alloc() failed");
         return NULL;
     }
     ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN-OGS_NAS_HEADROOM);
+    ogs_pkbuf_put(pkbuf, length+OGS_NAS_SLACK);
 
     size = sizeof(ogs_nas_emm_header_t);
     ogs_assert(ogs_pkbuf_pull(pkbuf, size));
@@ -3776,6 +5872,8 @@ ogs_pkbuf_t *ogs_nas_emm_encode(ogs_nas_eps_message_t *message)
     }
 
 out:
+    if (encoded != length)
+        ogs_error("NAS length %d, but %d octets encoded", length, encoded);
     ogs_assert(ogs_pkbuf_push(pkbuf, encoded));
 
     pkbuf->len = encoded;
@@ -3788,18 +5886,27 @@ ogs_pkbuf_t *ogs_nas_esm_encode(ogs_nas_eps_message_t *message)
     ogs_pkbuf_t *pkbuf = NULL;
     int size = 0;
     int encoded = 0;
+    int length = 0;
 
     ogs_assert(message);
 
+    length = ogs_nas_esm_length(message);
+    if (length < 0) {
+        ogs_error("Unknown message type (0x%x) or not implemented", 
+                message->esm.h.message_type);
+        return NULL;
+    }
+
     /* The Packet Buffer(ogs_pkbuf_t) for NAS message MUST make a HEADROOM. 
-     * When calculating AES_CMAC, we need to use the headroom of the packet. */
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+     * When calculating AES_CMAC, we need to use the headroom of the packet.
+     * The length is known up front; OGS_NAS_SLACK only guards it. */
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+length+OGS_NAS_SLACK);
     if (!pkbuf) {
         ogs_error("ogs_pkbuf_alloc() failed");
         return NULL;
     }
     ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN-OGS_NAS_HEADROOM);
+    ogs_pkbuf_put(pkbuf, length+OGS_NAS_SLACK);
 
     size = sizeof(ogs_nas_esm_header_t);
     ogs_assert(ogs_pkbuf_pull(pkbuf, size));
@@ -3921,6 +6028,8 @@ ogs_pkbuf_t *ogs_nas_esm_encode(ogs_nas_eps_message_t *message)
         return NULL;
     }
 
+    if (encoded != length)
+        ogs_error("NAS length %d, but %d octets encoded", length, encoded);
     ogs_assert(ogs_pkbuf_push(pkbuf, encoded));
     pkbuf->len = encoded;
 
@@ -82,6 +82,13 @@ int ogs_nas_eps_encode_additional_information(ogs_pkbuf_t *pkbuf, ogs_nas_additi
     return size;
 }
 
+int ogs_nas_eps_length_additional_information(ogs_nas_additional_information_t *additional_information)
+{
+    int size = additional_information->length + sizeof(additional_information->length);
+
+    return size;
+}
+
 /* 9.9.2.0A Device properties
  * O TV 1 */
 int ogs_nas_eps_decode_device_properties(ogs_nas_device_properties_t *device_properties, ogs_pkbuf_t *pkbuf)
@@ -114,6 +121,11 @@ int ogs_nas_eps_encode_device_properties(ogs_pkbuf_t *pkbuf, ogs_nas_device_prop
     return size;
 }
 
+int ogs_nas_eps_length_device_properties(ogs_nas_device_properties_t *device_properties)
+{
+    return sizeof(ogs_nas_device_properties_t);
+}
+
 /* 9.9.2.1 EPS bearer context status
  * O TLV 4 */
 int ogs_nas_eps_decode_eps_bearer_context_status(ogs_nas_eps_bearer_context_status_t *eps_bearer_context_status, ogs_pkbuf_t *pkbuf)
@@ -153,6 +165,13 @@ int ogs_nas_eps_encode_eps_bearer_context_status(ogs_pkbuf_t *pkbuf, ogs_nas_eps
     return size;
 }
 
+int ogs_nas_eps_length_eps_bearer_context_status(ogs_nas_eps_bearer_context_status_t *eps_bearer_context_status)
+{
+    int size = eps_bearer_context_status->length + sizeof(eps_bearer_context_status->length);
+
+    return size;
+}
+
 /* 9.9.2.10 Supported Codec List
  * O TLV 5-n */
 int ogs_nas_eps_decode_supported_codec_list(ogs_nas_supported_codec_list_t *supported_codec_list, ogs_pkbuf_t *pkbuf)
@@ -192,6 +211,13 @@ int ogs_nas_eps_encode_supported_codec_list(ogs_pkbuf_t *pkbuf, ogs_nas_supporte
     return size;
 }
 
+int ogs_nas_eps_length_supported_codec_list(ogs_nas_supported_codec_list_t *supported_codec_list)
+{
+    int size = supported_codec_list->length + sizeof(supported_codec_list->length);
+
+    return size;
+}
+
 /* 9.9.2.2 Location area identification
  * O TV 6 */
 int ogs_nas_eps_decode_location_area_identification(ogs_nas_location_area_identification_t *location_area_identification, ogs_pkbuf_t *pkbuf)
@@ -230,6 +256,11 @@ int ogs_nas_eps_encode_location_area_identification(ogs_pkbuf_t *pkbuf, ogs_nas_
     return size;
 }
 
+int ogs_nas_eps_length_location_area_identification(ogs_nas_location_area_identification_t *location_area_identification)
+{
+    return sizeof(ogs_nas_location_area_identification_t);
+}
+
 /* 9.9.2.3 Mobile identity
  * O TLV 7-10 */
 int ogs_nas_eps_decode_mobile_identity(ogs_nas_mobile_identity_t *mobile_identity, ogs_pkbuf_t *pkbuf)
@@ -278,6 +309,13 @@ int ogs_nas_eps_encode_mobile_identity(ogs_pkbuf_t *pkbuf, ogs_nas_mobile_identi
     return size;
 }
 
+int ogs_nas_eps_length_mobile_identity(ogs_nas_mobile_identity_t *mobile_identity)
+{
+    int size = mobile_identity->length + sizeof(mobile_identity->length);
+
+    return size;
+}
+
 /* 9.9.2.4 Mobile station classmark 2
  * O TLV 5 */
 int ogs_nas_eps_decode_mobile_station_classmark_2(ogs_nas_mobile_station_classmark_2_t *mobile_station_classmark_2, ogs_pkbuf_t *pkbuf)
@@ -317,6 +355,13 @@ int ogs_nas_eps_encode_mobile_station_classmark_2(ogs_pkbuf_t *pkbuf, ogs_nas_mo
     return size;
 }
 
+int ogs_nas_eps_length_mobile_station_classmark_2(ogs_nas_mobile_station_classmark_2_t *mobile_station_classmark_2)
+{
+    int size = mobile_station_classmark_2->length + sizeof(mobile_station_classmark_2->length);
+
+    return size;
+}
+
 /* 9.9.2.5 Mobile station classmark 3
  * O TLV 2-34 */
 int ogs_nas_eps_decode_mobile_station_classmark_3(ogs_nas_mobile_station_classmark_3_t *mobile_station_classmark_3, ogs_pkbuf_t *pkbuf)
@@ -356,6 +401,13 @@ int ogs_nas_eps_encode_mobile_station_classmark_3(ogs_pkbuf_t *pkbuf, ogs_nas_mo
     return size;
 }
 
+int ogs_nas_eps_length_mobile_station_classmark_3(ogs_nas_mobile_station_classmark_3_t *mobile_station_classmark_3)
+{
+    int size = mobile_station_classmark_3->length + sizeof(mobile_station_classmark_3->length);
+
+    return size;
+}
+
 /* 9.9.2.8 PLMN list
  * O TLV 5-47 */
 int ogs_nas_eps_decode_plmn_list(ogs_nas_plmn_list_t *plmn_list, ogs_pkbuf_t *pkbuf)
@@ -395,6 +447,13 @@ int ogs_nas_eps_encode_plmn_list(ogs_pkbuf_t *pkbuf, ogs_nas_plmn_list_t *plmn_l
     return size;
 }
 
+int ogs_nas_eps_length_plmn_list(ogs_nas_plmn_list_t *plmn_list)
+{
+    int size = plmn_list->length + sizeof(plmn_list->length);
+
+    return size;
+}
+
 /* 9.9.3.0A Additional update result
  * O TV 1 */
 int ogs_nas_eps_decode_additional_update_result(ogs_nas_additional_update_result_t *additional_update_result, ogs_pkbuf_t *pkbuf)
@@ -427,6 +486,11 @@ int ogs_nas_eps_encode_additional_update_result(ogs_pkbuf_t *pkbuf, ogs_nas_addi
     return size;
 }
 
+int ogs_nas_eps_length_additional_update_result(ogs_nas_additional_update_result_t *additional_update_result)
+{
+    return sizeof(ogs_nas_additional_update_result_t);
+}
+
 /* 9.9.3.0B Additional update type
  * O TV 1 */
 int ogs_nas_eps_decode_additional_update_type(ogs_nas_additional_update_type_t *additional_update_type, ogs_pkbuf_t *pkbuf)
@@ -459,6 +523,11 @@ int ogs_nas_eps_encode_additional_update_type(ogs_pkbuf_t *pkbuf, ogs_nas_additi
     return size;
 }
 
+int ogs_nas_eps_length_additional_update_type(ogs_nas_additional_update_type_t *additional_update_type)
+{
+    return sizeof(ogs_nas_additional_update_type_t);
+}
+
 /* 9.9.3.1 Authentication failure parameter
  * O TLV 16 */
 int ogs_nas_eps_decode_authentication_failure_parameter(ogs_nas_authentication_failure_parameter_t *authentication_failure_parameter, ogs_pkbuf_t *pkbuf)
@@ -498,6 +567,13 @@ int ogs_nas_eps_encode_authentication_failure_parameter(ogs_pkbuf_t *pkbuf, ogs_
     return size;
 }
 
+int ogs_nas_eps_length_authentication_failure_parameter(ogs_nas_authentication_failure_parameter_t *authentication_failure_parameter)
+{
+    int size = authentication_failure_parameter->length + sizeof(authentication_failure_parameter->length);
+
+    return size;
+}
+
 /* 9.9.3.10 EPS attach result
  * M V 1/2 */
 int ogs_nas_eps_decode_eps_attach_result(ogs_nas_eps_attach_result_t *eps_attach_result, ogs_pkbuf_t *pkbuf)
@@ -532,6 +608,11 @@ int ogs_nas_eps_encode_eps_attach_result(ogs_pkbuf_t *pkbuf, ogs_nas_eps_attach_
     return size;
 }
 
+int ogs_nas_eps_length_eps_attach_result(ogs_nas_eps_attach_result_t *eps_attach_result)
+{
+    return sizeof(ogs_nas_eps_attach_result_t);
+}
+
 /* 9.9.3.11 EPS attach type
  * M V 1/2 */
 int ogs_nas_eps_decode_eps_attach_type(ogs_nas_eps_attach_type_t *eps_attach_type, ogs_pkbuf_t *pkbuf)
@@ -566,6 +647,11 @@ int ogs_nas_eps_encode_eps_attach_type(ogs_pkbuf_t *pkbuf, ogs_nas_eps_attach_ty
     return size;
 }
 
+int ogs_nas_eps_length_eps_attach_type(ogs_nas_eps_attach_type_t *eps_attach_type)
+{
+    return sizeof(ogs_nas_eps_attach_type_t);
+}
+
 /* 9.9.3.12 EPS mobile identity
  * M LV 5-12 */
 int ogs_nas_eps_decode_eps_mobile_identity(ogs_nas_eps_mobile_identity_t *eps_mobile_identity, ogs_pkbuf_t *pkbuf)
@@ -616,6 +702,13 @@ int ogs_nas_eps_encode_eps_mobile_identity(ogs_pkbuf_t *pkbuf, ogs_nas_eps_mobil
     return size;
 }
 
+int ogs_nas_eps_length_eps_mobile_identity(ogs_nas_eps_mobile_identity_t *eps_mobile_identity)
+{
+    int size = eps_mobile_identity->length + sizeof(eps_mobile_identity->length);
+
+    return size;
+}
+
 /* 9.9.3.12A EPS network feature support
  * O TLV 3-4 */
 int ogs_nas_eps_decode_eps_network_feature_support(ogs_nas_eps_network_feature_support_t *eps_network_feature_support, ogs_pkbuf_t *pkbuf)
@@ -655,6 +748,13 @@ int ogs_nas_eps_encode_eps_network_feature_support(ogs_pkbuf_t *pkbuf, ogs_nas_e
     return size;
 }
 
+int ogs_nas_eps_length_eps_network_feature_support(ogs_nas_eps_network_feature_support_t *eps_network_feature_support)
+{
+    int size = eps_network_feature_support->length + sizeof(eps_network_feature_support->length);
+
+    return size;
+}
+
 /* 9.9.3.13 EPS update result
  * M V 1/2 */
 int ogs_nas_eps_decode_eps_update_result(ogs_nas_eps_update_result_t *eps_update_result, ogs_pkbuf_t *pkbuf)
@@ -689,6 +789,11 @@ int ogs_nas_eps_encode_eps_update_result(ogs_pkbuf_t *pkbuf, ogs_nas_eps_update_
     return size;
 }
 
+int ogs_nas_eps_length_eps_update_result(ogs_nas_eps_update_result_t *eps_update_result)
+{
+    return sizeof(ogs_nas_eps_update_result_t);
+}
+
 /* 9.9.3.14 EPS update type
  * M V 1/2 */
 int ogs_nas_eps_decode_eps_update_type(ogs_nas_eps_update_type_t *eps_update_type, ogs_pkbuf_t *pkbuf)
@@ -723,6 +828,11 @@ int ogs_nas_eps_encode_eps_update_type(ogs_pkbuf_t *pkbuf, ogs_nas_eps_update_ty
     return size;
 }
 
+int ogs_nas_eps_length_eps_update_type(ogs_nas_eps_update_type_t *eps_update_type)
+{
+    return sizeof(ogs_nas_eps_update_type_t);
+}
+
 /* 9.9.3.15 ESM message container
  * M LV-E 5-n */
 int ogs_nas_eps_decode_esm_message_container(ogs_nas_esm_message_container_t *esm_message_container, ogs_pkbuf_t *pkbuf)
@@ -769,6 +879,11 @@ int ogs_nas_eps_encode_esm_message_container(ogs_pkbuf_t *pkbuf, ogs_nas_esm_mes
     return esm_message_container->length + sizeof(esm_message_container->length);
 }
 
+int ogs_nas_eps_length_esm_message_container(ogs_nas_esm_message_container_t *esm_message_container)
+{
+    return esm_message_container->length + sizeof(esm_message_container->length);
+}
+
 /* 9.9.3.16 GPRS timer
  * M V 1 */
 int ogs_nas_eps_decode_gprs_timer(ogs_nas_gprs_timer_t *gprs_timer, ogs_pkbuf_t *pkbuf)
@@ -803,6 +918,11 @@ int ogs_nas_eps_encode_gprs_timer(ogs_pkbuf_t *pkbuf, ogs_nas_gprs_timer_t *gprs
     return size;
 }
 
+int ogs_nas_eps_length_gprs_timer(ogs_nas_gprs_timer_t *gprs_timer)
+{
+    return sizeof(ogs_nas_gprs_timer_t);
+}
+
 /* 9.9.3.16A GPRS timer 2
  * O TLV 3 */
 int ogs_nas_eps_decode_gprs_timer_2(ogs_nas_gprs_timer_2_t *gprs_timer_2, ogs_pkbuf_t *pkbuf)
@@ -842,6 +962,13 @@ int ogs_nas_eps_encode_gprs_timer_2(ogs_pkbuf_t *pkbuf, ogs_nas_gprs_timer_2_t *
     return size;
 }
 
+int ogs_nas_eps_length_gprs_timer_2(ogs_nas_gprs_timer_2_t *gprs_timer_2)
+{
+    int size = gprs_timer_2->length + sizeof(gprs_timer_2->length);
+
+    return size;
+}
+
 /* 9.9.3.16B GPRS timer 3
  * O TLV 3 */
 int ogs_nas_eps_decode_gprs_timer_3(ogs_nas_gprs_timer_3_t *gprs_timer_3, ogs_pkbuf_t *pkbuf)
@@ -881,6 +1008,13 @@ int ogs_nas_eps_encode_gprs_timer_3(ogs_pkbuf_t *pkbuf, ogs_nas_gprs_timer_3_t *
     return size;
 }
 
+int ogs_nas_eps_length_gprs_timer_3(ogs_nas_gprs_timer_3_t *gprs_timer_3)
+{
+    int size = gprs_timer_3->length + sizeof(gprs_timer_3->length);
+
+    return size;
+}
+
 /* 9.9.3.17 Identity type 2
  * M V 1/2 */
 int ogs_nas_eps_decode_identity_type_2(ogs_nas_identity_type_2_t *identity_type_2, ogs_pkbuf_t *pkbuf)
@@ -915,6 +1049,11 @@ int ogs_nas_eps_encode_identity_type_2(ogs_pkbuf_t *pkbuf, ogs_nas_identity_type
     return size;
 }
 
+int ogs_nas_eps_length_identity_type_2(ogs_nas_identity_type_2_t *identity_type_2)
+{
+    return sizeof(ogs_nas_identity_type_2_t);
+}
+
 /* 9.9.3.18 IMEISV request
  * O TV 1 */
 int ogs_nas_eps_decode_imeisv_request(ogs_nas_imeisv_request_t *imeisv_request, ogs_pkbuf_t *pkbuf)
@@ -947,6 +1086,11 @@ int ogs_nas_eps_encode_imeisv_request(ogs_pkbuf_t *pkbuf, ogs_nas_imeisv_request
     return size;
 }
 
+int ogs_nas_eps_length_imeisv_request(ogs_nas_imeisv_request_t *imeisv_request)
+{
+    return sizeof(ogs_nas_imeisv_request_t);
+}
+
 /* 9.9.3.19 KSI and sequence number
  * M V 1 */
 int ogs_nas_eps_decode_ksi_and_sequence_number(ogs_nas_ksi_and_sequence_number_t *ksi_and_sequence_number, ogs_pkbuf_t *pkbuf)
@@ -981,6 +1125,11 @@ int ogs_nas_eps_encode_ksi_and_sequence_number(ogs_pkbuf_t *pkbuf, ogs_nas_ksi_a
     return size;
 }
 
+int ogs_nas_eps_length_ksi_and_sequence_number(ogs_nas_ksi_and_sequence_number_t *ksi_and_sequence_number)
+{
+    return sizeof(ogs_nas_ksi_and_sequence_number_t);
+}
+
 /* 9.9.3.2 Authentication parameter AUTN
  * M LV 17 */
 int ogs_nas_eps_decode_authentication_parameter_autn(ogs_nas_authentication_parameter_autn_t *authentication_parameter_autn, ogs_pkbuf_t *pkbuf)
@@ -1020,6 +1169,13 @@ int ogs_nas_eps_encode_authentication_parameter_autn(ogs_pkbuf_t *pkbuf, ogs_nas
     return size;
 }
 
+int ogs_nas_eps_length_authentication_parameter_autn(ogs_nas_authentication_parameter_autn_t *authentication_parameter_autn)
+{
+    int size = authentication_parameter_autn->length + sizeof(authentication_parameter_autn->length);
+
+    return size;
+}
+
 /* 9.9.3.20 MS network capability
  * O TLV 4-10 */
 int ogs_nas_eps_decode_ms_network_capability(ogs_nas_ms_network_capability_t *ms_network_capability, ogs_pkbuf_t *pkbuf)
@@ -1059,6 +1215,13 @@ int ogs_nas_eps_encode_ms_network_capability(ogs_pkbuf_t *pkbuf, ogs_nas_ms_netw
     return size;
 }
 
+int ogs_nas_eps_length_ms_network_capability(ogs_nas_ms_network_capability_t *ms_network_capability)
+{
+    int size = ms_network_capability->length + sizeof(ms_network_capability->length);
+
+    return size;
+}
+
 /* 9.9.3.20A MS network feature support
  * O TV 1 */
 int ogs_nas_eps_decode_ms_network_feature_support(ogs_nas_ms_network_feature_support_t *ms_network_feature_support, ogs_pkbuf_t *pkbuf)
@@ -1091,6 +1254,11 @@ int ogs_nas_eps_encode_ms_network_feature_support(ogs_pkbuf_t *pkbuf, ogs_nas_ms
     return size;
 }
 
+int ogs_nas_eps_length_ms_network_feature_support(ogs_nas_ms_network_feature_support_t *ms_network_feature_support)
+{
+    return sizeof(ogs_nas_ms_network_feature_support_t);
+}
+
 /* 9.9.3.21 key set identifier
  * O TV 1 */
 int ogs_nas_eps_decode_key_set_identifier(ogs_nas_key_set_identifier_t *key_set_identifier, ogs_pkbuf_t *pkbuf)
@@ -1123,6 +1291,11 @@ int ogs_nas_eps_encode_key_set_identifier(ogs_pkbuf_t *pkbuf, ogs_nas_key_set_id
     return size;
 }
 
+int ogs_nas_eps_length_key_set_identifier(ogs_nas_key_set_identifier_t *key_set_identifier)
+{
+    return sizeof(ogs_nas_key_set_identifier_t);
+}
+
 /* 9.9.3.22 EPS message container
  * M LV 3-252 */
 int ogs_nas_eps_decode_eps_message_container(ogs_nas_eps_message_container_t *eps_message_container, ogs_pkbuf_t *pkbuf)
@@ -1162,6 +1335,13 @@ int ogs_nas_eps_encode_eps_message_container(ogs_pkbuf_t *pkbuf, ogs_nas_eps_mes
     return size;
 }
 
+int ogs_nas_eps_length_eps_message_container(ogs_nas_eps_message_container_t *eps_message_container)
+{
+    int size = eps_message_container->length + sizeof(eps_message_container->length);
+
+    return size;
+}
+
 /* 9.9.3.23 security algorithms
  * M V 1 */
 int ogs_nas_eps_decode_security_algorithms(ogs_nas_security_algorithms_t *security_algorithms, ogs_pkbuf_t *pkbuf)
@@ -1196,6 +1376,11 @@ int ogs_nas_eps_encode_security_algorithms(ogs_pkbuf_t *pkbuf, ogs_nas_security_
     return size;
 }
 
+int ogs_nas_eps_length_security_algorithms(ogs_nas_security_algorithms_t *security_algorithms)
+{
+    return sizeof(ogs_nas_security_algorithms_t);
+}
+
 /* 9.9.3.24 Network name
  * O TLV 3-n */
 int ogs_nas_eps_decode_network_name(ogs_nas_network_name_t *network_name, ogs_pkbuf_t *pkbuf)
@@ -1235,6 +1420,13 @@ int ogs_nas_eps_encode_network_name(ogs_pkbuf_t *pkbuf, ogs_nas_network_name_t *
     return size;
 }
 
+int ogs_nas_eps_length_network_name(ogs_nas_network_name_t *network_name)
+{
+    int size = network_name->length + sizeof(network_name->length);
+
+    return size;
+}
+
 /* 9.9.3.24A Network resource identifier container
  * O TLV 4 */
 int ogs_nas_eps_decode_network_resource_identifier_container(ogs_nas_network_resource_identifier_container_t *network_resource_identifier_container, ogs_pkbuf_t *pkbuf)
@@ -1274,6 +1466,13 @@ int ogs_nas_eps_encode_network_resource_identifier_container(ogs_pkbuf_t *pkbuf,
     return size;
 }
 
+int ogs_nas_eps_length_network_resource_identifier_container(ogs_nas_network_resource_identifier_container_t *network_resource_identifier_container)
+{
+    int size = network_resource_identifier_container->length + sizeof(network_resource_identifier_container->length);
+
+    return size;
+}
+
 /* 9.9.3.25 Nonce
  * O TV 5 */
 int ogs_nas_eps_decode_nonce(ogs_nas_nonce_t *nonce, ogs_pkbuf_t *pkbuf)
@@ -1312,6 +1511,11 @@ int ogs_nas_eps_encode_nonce(ogs_pkbuf_t *pkbuf, ogs_nas_nonce_t *nonce)
     return size;
 }
 
+int ogs_nas_eps_length_nonce(ogs_nas_nonce_t *nonce)
+{
+    return sizeof(ogs_nas_nonce_t);
+}
+
 /* 9.9.3.25A Paging identity
  * M V 1 */
 int ogs_nas_eps_decode_paging_identity(ogs_nas_paging_identity_t *paging_identity, ogs_pkbuf_t *pkbuf)
@@ -1346,6 +1550,11 @@ int ogs_nas_eps_encode_paging_identity(ogs_pkbuf_t *pkbuf, ogs_nas_paging_identi
     return size;
 }
 
+int ogs_nas_eps_length_paging_identity(ogs_nas_paging_identity_t *paging_identity)
+{
+    return sizeof(ogs_nas_paging_identity_t);
+}
+
 /* 9.9.3.26 P-TMSI signature
  * O TV 4 */
 int ogs_nas_eps_decode_p_tmsi_signature(ogs_nas_p_tmsi_signature_t *p_tmsi_signature, ogs_pkbuf_t *pkbuf)
@@ -1384,6 +1593,11 @@ int ogs_nas_eps_encode_p_tmsi_signature(ogs_pkbuf_t *pkbuf, ogs_nas_p_tmsi_signa
     return size;
 }
 
+int ogs_nas_eps_length_p_tmsi_signature(ogs_nas_p_tmsi_signature_t *p_tmsi_signature)
+{
+    return 3;
+}
+
 /* 9.9.3.26A Extended EMM cause
  * O TV 1 */
 int ogs_nas_eps_decode_extended_emm_cause(ogs_nas_extended_emm_cause_t *extended_emm_cause, ogs_pkbuf_t *pkbuf)
@@ -1416,6 +1630,11 @@ int ogs_nas_eps_encode_extended_emm_cause(ogs_pkbuf_t *pkbuf, ogs_nas_extended_e
     return size;
 }
 
+int ogs_nas_eps_length_extended_emm_cause(ogs_nas_extended_emm_cause_t *extended_emm_cause)
+{
+    return sizeof(ogs_nas_extended_emm_cause_t);
+}
+
 /* 9.9.3.27 Service type
  * M V 1/2 */
 int ogs_nas_eps_decode_service_type(ogs_nas_service_type_t *service_type, ogs_pkbuf_t *pkbuf)
@@ -1450,6 +1669,11 @@ int ogs_nas_eps_encode_service_type(ogs_pkbuf_t *pkbuf, ogs_nas_service_type_t *
     return size;
 }
 
+int ogs_nas_eps_length_service_type(ogs_nas_service_type_t *service_type)
+{
+    return sizeof(ogs_nas_service_type_t);
+}
+
 /* 9.9.3.28 Short MAC
  * M V 2 */
 int ogs_nas_eps_decode_short_mac(ogs_nas_short_mac_t *short_mac, ogs_pkbuf_t *pkbuf)
@@ -1488,6 +1712,11 @@ int ogs_nas_eps_encode_short_mac(ogs_pkbuf_t *pkbuf, ogs_nas_short_mac_t *short_
     return size;
 }
 
+int ogs_nas_eps_length_short_mac(ogs_nas_short_mac_t *short_mac)
+{
+    return sizeof(ogs_nas_short_mac_t);
+}
+
 /* 9.9.3.29 Time zone
  * O TV 2 */
 int ogs_nas_eps_decode_time_zone(ogs_nas_time_zone_t *time_zone, ogs_pkbuf_t *pkbuf)
@@ -1522,6 +1751,11 @@ int ogs_nas_eps_encode_time_zone(ogs_pkbuf_t *pkbuf, ogs_nas_time_zone_t *time_z
     return size;
 }
 
+int ogs_nas_eps_length_time_zone(ogs_nas_time_zone_t *time_zone)
+{
+    return sizeof(ogs_nas_time_zone_t);
+}
+
 /* 9.9.3.3 Authentication parameter RAND
  * M V 16 */
 int ogs_nas_eps_decode_authentication_parameter_rand(ogs_nas_authentication_parameter_rand_t *authentication_parameter_rand, ogs_pkbuf_t *pkbuf)
@@ -1556,6 +1790,11 @@ int ogs_nas_eps_encode_authentication_parameter_rand(ogs_pkbuf_t *pkbuf, ogs_nas
     return size;
 }
 
+int ogs_nas_eps_length_authentication_parameter_rand(ogs_nas_authentication_parameter_rand_t *authentication_parameter_rand)
+{
+    return sizeof(ogs_nas_authentication_parameter_rand_t);
+}
+
 /* 9.9.3.30 Time zone and time
  * O TV 8 */
 int ogs_nas_eps_decode_time_zone_and_time(ogs_nas_time_zone_and_time_t *time_zone_and_time, ogs_pkbuf_t *pkbuf)
@@ -1590,6 +1829,11 @@ int ogs_nas_eps_encode_time_zone_and_time(ogs_pkbuf_t *pkbuf, ogs_nas_time_zone_
     return size;
 }
 
+int ogs_nas_eps_length_time_zone_and_time(ogs_nas_time_zone_and_time_t *time_zone_and_time)
+{
+    return sizeof(ogs_nas_time_zone_and_time_t);
+}
+
 /* 9.9.3.31 TMSI status
  * O TV 1 */
 int ogs_nas_eps_decode_tmsi_status(ogs_nas_tmsi_status_t *tmsi_status, ogs_pkbuf_t *pkbuf)
@@ -1622,6 +1866,11 @@ int ogs_nas_eps_encode_tmsi_status(ogs_pkbuf_t *pkbuf, ogs_nas_tmsi_status_t *tm
     return size;
 }
 
+int ogs_nas_eps_length_tmsi_status(ogs_nas_tmsi_status_t *tmsi_status)
+{
+    return sizeof(ogs_nas_tmsi_status_t);
+}
+
 /* 9.9.3.32 Tracking area identity
  * O TV 6 */
 int ogs_nas_eps_decode_tracking_area_identity(ogs_nas_tracking_area_identity_t *tracking_area_identity, ogs_pkbuf_t *pkbuf)
@@ -1660,6 +1909,11 @@ int ogs_nas_eps_encode_tracking_area_identity(ogs_pkbuf_t *pkbuf, ogs_nas_tracki
     return size;
 }
 
+int ogs_nas_eps_length_tracking_area_identity(ogs_nas_tracking_area_identity_t *tracking_area_identity)
+{
+    return sizeof(ogs_nas_tracking_area_identity_t);
+}
+
 /* 9.9.3.33 Tracking area identity list
  * M LV 7-97 */
 int ogs_nas_eps_decode_tracking_area_identity_list(ogs_nas_tracking_area_identity_list_t *tracking_area_identity_list, ogs_pkbuf_t *pkbuf)
@@ -1699,6 +1953,13 @@ int ogs_nas_eps_encode_tracking_area_identity_list(ogs_pkbuf_t *pkbuf, ogs_nas_t
     return size;
 }
 
+int ogs_nas_eps_length_tracking_area_identity_list(ogs_nas_tracking_area_identity_list_t *tracking_area_identity_list)
+{
+    int size = tracking_area_identity_list->length + sizeof(tracking_area_identity_list->length);
+
+    return size;
+}
+
 /* 9.9.3.34 UE network capability
  * M LV 3-14 */
 int ogs_nas_eps_decode_ue_network_capability(ogs_nas_ue_network_capability_t *ue_network_capability, ogs_pkbuf_t *pkbuf)
@@ -1738,6 +1999,13 @@ int ogs_nas_eps_encode_ue_network_capability(ogs_pkbuf_t *pkbuf, ogs_nas_ue_netw
     return size;
 }
 
+int ogs_nas_eps_length_ue_network_capability(ogs_nas_ue_network_capability_t *ue_network_capability)
+{
+    int size = ue_network_capability->length + sizeof(ue_network_capability->length);
+
+    return size;
+}
+
 /* 9.9.3.35 UE radio capability information update needed
  * O TV 1 */
 int ogs_nas_eps_decode_ue_radio_capability_information_update_needed(ogs_nas_ue_radio_capability_information_update_needed_t *ue_radio_capability_information_update_needed, ogs_pkbuf_t *pkbuf)
@@ -1770,6 +2038,11 @@ int ogs_nas_eps_encode_ue_radio_capability_information_update_needed(ogs_pkbuf_t
     return size;
 }
 
+int ogs_nas_eps_length_ue_radio_capability_information_update_needed(ogs_nas_ue_radio_capability_information_update_needed_t *ue_radio_capability_information_update_needed)
+{
+    return sizeof(ogs_nas_ue_radio_capability_information_update_needed_t);
+}
+
 /* 9.9.3.36 UE security capability
  * M LV 3-6 */
 int ogs_nas_eps_decode_ue_security_capability(ogs_nas_ue_security_capability_t *ue_security_capability, ogs_pkbuf_t *pkbuf)
@@ -1809,6 +2082,13 @@ int ogs_nas_eps_encode_ue_security_capability(ogs_pkbuf_t *pkbuf, ogs_nas_ue_sec
     return size;
 }
 
+int ogs_nas_eps_length_ue_security_capability(ogs_nas_ue_security_capability_t *ue_security_capability)
+{
+    int size = ue_security_capability->length + sizeof(ue_security_capability->length);
+
+    return size;
+}
+
 /* 9.9.3.37 Emergency number list
  * O TLV 5-50 */
 int ogs_nas_eps_decode_emergency_number_list(ogs_nas_emergency_number_list_t *emergency_number_list, ogs_pkbuf_t *pkbuf)
@@ -1848,6 +2128,13 @@ int ogs_nas_eps_encode_emergency_number_list(ogs_pkbuf_t *pkbuf, ogs_nas_emergen
     return size;
 }
 
+int ogs_nas_eps_length_emergency_number_list(ogs_nas_emergency_number_list_t *emergency_number_list)
+{
+    int size = emergency_number_list->length + sizeof(emergency_number_list->length);
+
+    return size;
+}
+
 /* 9.9.3.37A Extended emergency number list
  * O TLV-E 7-65538 */
 int ogs_nas_eps_decode_extended_emergency_number_list(ogs_nas_extended_emergency_number_list_t *extended_emergency_number_list, ogs_pkbuf_t *pkbuf)
@@ -1894,6 +2181,11 @@ int ogs_nas_eps_encode_extended_emergency_number_list(ogs_pkbuf_t *pkbuf, ogs_na
     return extended_emergency_number_list->length + sizeof(extended_emergency_number_list->length);
 }
 
+int ogs_nas_eps_length_extended_emergency_number_list(ogs_nas_extended_emergency_number_list_t *extended_emergency_number_list)
+{
+    return extended_emergency_number_list->length + sizeof(extended_emergency_number_list->length);
+}
+
 /* 9.9.3.38 CLI
  * O TLV 3-14 */
 int ogs_nas_eps_decode_cli(ogs_nas_cli_t *cli, ogs_pkbuf_t *pkbuf)
@@ -1933,6 +2225,13 @@ int ogs_nas_eps_encode_cli(ogs_pkbuf_t *pkbuf, ogs_nas_cli_t *cli)
     return size;
 }
 
+int ogs_nas_eps_length_cli(ogs_nas_cli_t *cli)
+{
+    int size = cli->length + sizeof(cli->length);
+
+    return size;
+}
+
 /* 9.9.3.39 SS Code
  * O TV 2 */
 int ogs_nas_eps_decode_ss_code(ogs_nas_ss_code_t *ss_code, ogs_pkbuf_t *pkbuf)
@@ -1967,6 +2266,11 @@ int ogs_nas_eps_encode_ss_code(ogs_pkbuf_t *pkbuf, ogs_nas_ss_code_t *ss_code)
     return size;
 }
 
+int ogs_nas_eps_length_ss_code(ogs_nas_ss_code_t *ss_code)
+{
+    return sizeof(ogs_nas_ss_code_t);
+}
+
 /* 9.9.3.4 Authentication response parameter
  * M LV 5-17 */
 int ogs_nas_eps_decode_authentication_response_parameter(ogs_nas_authentication_response_parameter_t *authentication_response_parameter, ogs_pkbuf_t *pkbuf)
@@ -2006,6 +2310,13 @@ int ogs_nas_eps_encode_authentication_response_parameter(ogs_pkbuf_t *pkbuf, ogs
     return size;
 }
 
+int ogs_nas_eps_length_authentication_response_parameter(ogs_nas_authentication_response_parameter_t *authentication_response_parameter)
+{
+    int size = authentication_response_parameter->length + sizeof(authentication_response_parameter->length);
+
+    return size;
+}
+
 /* 9.9.3.40 LCS indicator
  * O TV 2 */
 int ogs_nas_eps_decode_lcs_indicator(ogs_nas_lcs_indicator_t *lcs_indicator, ogs_pkbuf_t *pkbuf)
@@ -2040,6 +2351,11 @@ int ogs_nas_eps_encode_lcs_indicator(ogs_pkbuf_t *pkbuf, ogs_nas_lcs_indicator_t
     return size;
 }
 
+int ogs_nas_eps_length_lcs_indicator(ogs_nas_lcs_indicator_t *lcs_indicator)
+{
+    return sizeof(ogs_nas_lcs_indicator_t);
+}
+
 /* 9.9.3.41 LCS client identity
  * O TLV 3-257 */
 int ogs_nas_eps_decode_lcs_client_identity(ogs_nas_lcs_client_identity_t *lcs_client_identity, ogs_pkbuf_t *pkbuf)
@@ -2079,6 +2395,13 @@ int ogs_nas_eps_encode_lcs_client_identity(ogs_pkbuf_t *pkbuf, ogs_nas_lcs_clien
     return size;
 }
 
+int ogs_nas_eps_length_lcs_client_identity(ogs_nas_lcs_client_identity_t *lcs_client_identity)
+{
+    int size = lcs_client_identity->length + sizeof(lcs_client_identity->length);
+
+    return size;
+}
+
 /* 9.9.3.42 Generic message container type
  * M V 1 */
 int ogs_nas_eps_decode_generic_message_container_type(ogs_nas_generic_message_container_type_t *generic_message_container_type, ogs_pkbuf_t *pkbuf)
@@ -2113,6 +2436,11 @@ int ogs_nas_eps_encode_generic_message_container_type(ogs_pkbuf_t *pkbuf, ogs_na
     return size;
 }
 
+int ogs_nas_eps_length_generic_message_container_type(ogs_nas_generic_message_container_type_t *generic_message_container_type)
+{
+    return sizeof(ogs_nas_generic_message_container_type_t);
+}
+
 /* 9.9.3.43 Generic message container
  * M LV-E 3-n */
 int ogs_nas_eps_decode_generic_message_container(ogs_nas_generic_message_container_t *generic_message_container, ogs_pkbuf_t *pkbuf)
@@ -2159,6 +2487,11 @@ int ogs_nas_eps_encode_generic_message_container(ogs_pkbuf_t *pkbuf, ogs_nas_gen
     return generic_message_container->length + sizeof(generic_message_container->length);
 }
 
+int ogs_nas_eps_length_generic_message_container(ogs_nas_generic_message_container_t *generic_message_container)
+{
+    return generic_message_container->length + sizeof(generic_message_container->length);
+}
+
 /* 9.9.3.44 Voice domain preference and UE usage setting
  * O TLV 3 */
 int ogs_nas_eps_decode_voice_domain_preference_and_ue_usage_setting(ogs_nas_voice_domain_preference_and_ue_usage_setting_t *voice_domain_preference_and_ue_usage_setting, ogs_pkbuf_t *pkbuf)
@@ -2198,6 +2531,13 @@ int ogs_nas_eps_encode_voice_domain_preference_and_ue_usage_setting(ogs_pkbuf_t
     return size;
 }
 
+int ogs_nas_eps_length_voice_domain_preference_and_ue_usage_setting(ogs_nas_voice_domain_preference_and_ue_usage_setting_t *voice_domain_preference_and_ue_usage_setting)
+{
+    int size = voice_domain_preference_and_ue_usage_setting->length + sizeof(voice_domain_preference_and_ue_usage_setting->length);
+
+    return size;
+}
+
 /* 9.9.3.45 GUTI type
  * O TV 1 */
 int ogs_nas_eps_decode_guti_type(ogs_nas_guti_type_t *guti_type, ogs_pkbuf_t *pkbuf)
@@ -2230,6 +2570,11 @@ int ogs_nas_eps_encode_guti_type(ogs_pkbuf_t *pkbuf, ogs_nas_guti_type_t *guti_t
     return size;
 }
 
+int ogs_nas_eps_length_guti_type(ogs_nas_guti_type_t *guti_type)
+{
+    return sizeof(ogs_nas_guti_type_t);
+}
+
 /* 9.9.3.46 Extended DRX parameters
  * O TLV 3 */
 int ogs_nas_eps_decode_extended_drx_parameters(ogs_nas_extended_drx_parameters_t *extended_drx_parameters, ogs_pkbuf_t *pkbuf)
@@ -2269,7 +2614,14 @@ int ogs_nas_eps_encode_extended_drx_parameters(ogs_pkbuf_t *pkbuf, ogs_nas_exten
     return size;
 }
 
-/* 9.9.3.48 DCN-ID
+int ogs_nas_eps_length_extended_drx_parameters(ogs_nas_extended_drx_parameters_t *extended_drx_parameters)
+{
+    int size = extended_drx_parameters->length + sizeof(extended_drx_parameters->length);
+
+    return size;
+}
+
+/* 9.9.3.48 DCN-ID
  * O TLV 4 */
 int ogs_nas_eps_decode_dcn_id(ogs_nas_dcn_id_t *dcn_id, ogs_pkbuf_t *pkbuf)
 {
@@ -2308,6 +2660,13 @@ int ogs_nas_eps_encode_dcn_id(ogs_pkbuf_t *pkbuf, ogs_nas_dcn_id_t *dcn_id)
     return size;
 }
 
+int ogs_nas_eps_length_dcn_id(ogs_nas_dcn_id_t *dcn_id)
+{
+    int size = dcn_id->length + sizeof(dcn_id->length);
+
+    return size;
+}
+
 /* 9.9.3.49 Non-3GPP NW provided policies
  * O TV 1 */
 int ogs_nas_eps_decode_non__nw_provided_policies(ogs_nas_non__nw_provided_policies_t *non__nw_provided_policies, ogs_pkbuf_t *pkbuf)
@@ -2340,6 +2699,11 @@ int ogs_nas_eps_encode_non__nw_provided_policies(ogs_pkbuf_t *pkbuf, ogs_nas_non
     return size;
 }
 
+int ogs_nas_eps_length_non__nw_provided_policies(ogs_nas_non__nw_provided_policies_t *non__nw_provided_policies)
+{
+    return sizeof(ogs_nas_non__nw_provided_policies_t);
+}
+
 /* 9.9.3.4B SMS services status
  * O TV 1 */
 int ogs_nas_eps_decode_sms_services_status(ogs_nas_sms_services_status_t *sms_services_status, ogs_pkbuf_t *pkbuf)
@@ -2372,6 +2736,11 @@ int ogs_nas_eps_encode_sms_services_status(ogs_pkbuf_t *pkbuf, ogs_nas_sms_servi
     return size;
 }
 
+int ogs_nas_eps_length_sms_services_status(ogs_nas_sms_services_status_t *sms_services_status)
+{
+    return sizeof(ogs_nas_sms_services_status_t);
+}
+
 /* 9.9.3.4a Ciphering key sequence number
  * O TV 1 */
 int ogs_nas_eps_decode_ciphering_key_sequence_number(ogs_nas_ciphering_key_sequence_number_t *ciphering_key_sequence_number, ogs_pkbuf_t *pkbuf)
@@ -2404,6 +2773,11 @@ int ogs_nas_eps_encode_ciphering_key_sequence_number(ogs_pkbuf_t *pkbuf, ogs_nas
     return size;
 }
 
+int ogs_nas_eps_length_ciphering_key_sequence_number(ogs_nas_ciphering_key_sequence_number_t *ciphering_key_sequence_number)
+{
+    return sizeof(ogs_nas_ciphering_key_sequence_number_t);
+}
+
 /* 9.9.3.5 CSFB response
  * C TV 1 */
 int ogs_nas_eps_decode_csfb_response(ogs_nas_csfb_response_t *csfb_response, ogs_pkbuf_t *pkbuf)
@@ -2436,6 +2810,11 @@ int ogs_nas_eps_encode_csfb_response(ogs_pkbuf_t *pkbuf, ogs_nas_csfb_response_t
     return size;
 }
 
+int ogs_nas_eps_length_csfb_response(ogs_nas_csfb_response_t *csfb_response)
+{
+    return sizeof(ogs_nas_csfb_response_t);
+}
+
 /* 9.9.3.50 HashMME
  * O TLV 10 */
 int ogs_nas_eps_decode_hashmme(ogs_nas_hashmme_t *hashmme, ogs_pkbuf_t *pkbuf)
@@ -2475,6 +2854,13 @@ int ogs_nas_eps_encode_hashmme(ogs_pkbuf_t *pkbuf, ogs_nas_hashmme_t *hashmme)
     return size;
 }
 
+int ogs_nas_eps_length_hashmme(ogs_nas_hashmme_t *hashmme)
+{
+    int size = hashmme->length + sizeof(hashmme->length);
+
+    return size;
+}
+
 /* 9.9.3.51 Replayed NAS message container
  * O TLV-E 3-n */
 int ogs_nas_eps_decode_replayed_nas_message_container(ogs_nas_replayed_nas_message_container_t *replayed_nas_message_container, ogs_pkbuf_t *pkbuf)
@@ -2521,6 +2907,11 @@ int ogs_nas_eps_encode_replayed_nas_message_container(ogs_pkbuf_t *pkbuf, ogs_na
     return replayed_nas_message_container->length + sizeof(replayed_nas_message_container->length);
 }
 
+int ogs_nas_eps_length_replayed_nas_message_container(ogs_nas_replayed_nas_message_container_t *replayed_nas_message_container)
+{
+    return replayed_nas_message_container->length + sizeof(replayed_nas_message_container->length);
+}
+
 /* 9.9.3.52 Network policy
  * O TV 1 */
 int ogs_nas_eps_decode_network_policy(ogs_nas_network_policy_t *network_policy, ogs_pkbuf_t *pkbuf)
@@ -2553,6 +2944,11 @@ int ogs_nas_eps_encode_network_policy(ogs_pkbuf_t *pkbuf, ogs_nas_network_policy
     return size;
 }
 
+int ogs_nas_eps_length_network_policy(ogs_nas_network_policy_t *network_policy)
+{
+    return sizeof(ogs_nas_network_policy_t);
+}
+
 /* 9.9.3.53 UE additional security capability
  * O TLV 6 */
 int ogs_nas_eps_decode_ue_additional_security_capability(ogs_nas_ue_additional_security_capability_t *ue_additional_security_capability, ogs_pkbuf_t *pkbuf)
@@ -2592,6 +2988,13 @@ int ogs_nas_eps_encode_ue_additional_security_capability(ogs_pkbuf_t *pkbuf, ogs
     return size;
 }
 
+int ogs_nas_eps_length_ue_additional_security_capability(ogs_nas_ue_additional_security_capability_t *ue_additional_security_capability)
+{
+    int size = ue_additional_security_capability->length + sizeof(ue_additional_security_capability->length);
+
+    return size;
+}
+
 /* 9.9.3.54 UE status
  * O TLV 3 */
 int ogs_nas_eps_decode_ue_status(ogs_nas_ue_status_t *ue_status, ogs_pkbuf_t *pkbuf)
@@ -2631,6 +3034,13 @@ int ogs_nas_eps_encode_ue_status(ogs_pkbuf_t *pkbuf, ogs_nas_ue_status_t *ue_sta
     return size;
 }
 
+int ogs_nas_eps_length_ue_status(ogs_nas_ue_status_t *ue_status)
+{
+    int size = ue_status->length + sizeof(ue_status->length);
+
+    return size;
+}
+
 /* 9.9.3.55 Additional information requested
  * O TV 2 */
 int ogs_nas_eps_decode_additional_information_requested(ogs_nas_additional_information_requested_t *additional_information_requested, ogs_pkbuf_t *pkbuf)
@@ -2665,6 +3075,11 @@ int ogs_nas_eps_encode_additional_information_requested(ogs_pkbuf_t *pkbuf, ogs_
     return size;
 }
 
+int ogs_nas_eps_length_additional_information_requested(ogs_nas_additional_information_requested_t *additional_information_requested)
+{
+    return sizeof(ogs_nas_additional_information_requested_t);
+}
+
 /* 9.9.3.56 Ciphering key data
  * O TLV-E 35-2291 */
 int ogs_nas_eps_decode_ciphering_key_data(ogs_nas_ciphering_key_data_t *ciphering_key_data, ogs_pkbuf_t *pkbuf)
@@ -2711,6 +3126,11 @@ int ogs_nas_eps_encode_ciphering_key_data(ogs_pkbuf_t *pkbuf, ogs_nas_ciphering_
     return ciphering_key_data->length + sizeof(ciphering_key_data->length);
 }
 
+int ogs_nas_eps_length_ciphering_key_data(ogs_nas_ciphering_key_data_t *ciphering_key_data)
+{
+    return ciphering_key_data->length + sizeof(ciphering_key_data->length);
+}
+
 /* 9.9.3.57 N1 UE network capability
  * O TLV 3-15 */
 int ogs_nas_eps_decode_n1_ue_network_capability(ogs_nas_n1_ue_network_capability_t *n1_ue_network_capability, ogs_pkbuf_t *pkbuf)
@@ -2750,6 +3170,13 @@ int ogs_nas_eps_encode_n1_ue_network_capability(ogs_pkbuf_t *pkbuf, ogs_nas_n1_u
     return size;
 }
 
+int ogs_nas_eps_length_n1_ue_network_capability(ogs_nas_n1_ue_network_capability_t *n1_ue_network_capability)
+{
+    int size = n1_ue_network_capability->length + sizeof(n1_ue_network_capability->length);
+
+    return size;
+}
+
 /* 9.9.3.58 UE radio capability ID availability
  * O TLV 3 */
 int ogs_nas_eps_decode_ue_radio_capability_id_availability(ogs_nas_ue_radio_capability_id_availability_t *ue_radio_capability_id_availability, ogs_pkbuf_t *pkbuf)
@@ -2789,6 +3216,13 @@ int ogs_nas_eps_encode_ue_radio_capability_id_availability(ogs_pkbuf_t *pkbuf, o
     return size;
 }
 
+int ogs_nas_eps_length_ue_radio_capability_id_availability(ogs_nas_ue_radio_capability_id_availability_t *ue_radio_capability_id_availability)
+{
+    int size = ue_radio_capability_id_availability->length + sizeof(ue_radio_capability_id_availability->length);
+
+    return size;
+}
+
 /* 9.9.3.59 UE radio capability ID request
  * O TLV 3 */
 int ogs_nas_eps_decode_ue_radio_capability_id_request(ogs_nas_ue_radio_capability_id_request_t *ue_radio_capability_id_request, ogs_pkbuf_t *pkbuf)
@@ -2828,6 +3262,13 @@ int ogs_nas_eps_encode_ue_radio_capability_id_request(ogs_pkbuf_t *pkbuf, ogs_na
     return size;
 }
 
+int ogs_nas_eps_length_ue_radio_capability_id_request(ogs_nas_ue_radio_capability_id_request_t *ue_radio_capability_id_request)
+{
+    int size = ue_radio_capability_id_request->length + sizeof(ue_radio_capability_id_request->length);
+
+    return size;
+}
+
 /* 9.9.3.6 Daylight saving time
  * O TLV 3 */
 int ogs_nas_eps_decode_daylight_saving_time(ogs_nas_daylight_saving_time_t *daylight_saving_time, ogs_pkbuf_t *pkbuf)
@@ -2867,6 +3308,13 @@ int ogs_nas_eps_encode_daylight_saving_time(ogs_pkbuf_t *pkbuf, ogs_nas_daylight
     return size;
 }
 
+int ogs_nas_eps_length_daylight_saving_time(ogs_nas_daylight_saving_time_t *daylight_saving_time)
+{
+    int size = daylight_saving_time->length + sizeof(daylight_saving_time->length);
+
+    return size;
+}
+
 /* 9.9.3.60 UE radio capability ID
  * O TLV 3-n */
 int ogs_nas_eps_decode_ue_radio_capability_id(ogs_nas_ue_radio_capability_id_t *ue_radio_capability_id, ogs_pkbuf_t *pkbuf)
@@ -2906,6 +3354,13 @@ int ogs_nas_eps_encode_ue_radio_capability_id(ogs_pkbuf_t *pkbuf, ogs_nas_ue_rad
     return size;
 }
 
+int ogs_nas_eps_length_ue_radio_capability_id(ogs_nas_ue_radio_capability_id_t *ue_radio_capability_id)
+{
+    int size = ue_radio_capability_id->length + sizeof(ue_radio_capability_id->length);
+
+    return size;
+}
+
 /* 9.9.3.61 UE radio capability ID deletion indication
  * O TV 1 */
 int ogs_nas_eps_decode_ue_radio_capability_id_deletion_indication(ogs_nas_ue_radio_capability_id_deletion_indication_t *ue_radio_capability_id_deletion_indication, ogs_pkbuf_t *pkbuf)
@@ -2938,6 +3393,11 @@ int ogs_nas_eps_encode_ue_radio_capability_id_deletion_indication(ogs_pkbuf_t *p
     return size;
 }
 
+int ogs_nas_eps_length_ue_radio_capability_id_deletion_indication(ogs_nas_ue_radio_capability_id_deletion_indication_t *ue_radio_capability_id_deletion_indication)
+{
+    return sizeof(ogs_nas_ue_radio_capability_id_deletion_indication_t);
+}
+
 /* 9.9.3.62 WUS assistance information
  * O TLV 3-n */
 int ogs_nas_eps_decode_wus_assistance_information(ogs_nas_wus_assistance_information_t *wus_assistance_information, ogs_pkbuf_t *pkbuf)
@@ -2977,6 +3437,13 @@ int ogs_nas_eps_encode_wus_assistance_information(ogs_pkbuf_t *pkbuf, ogs_nas_wu
     return size;
 }
 
+int ogs_nas_eps_length_wus_assistance_information(ogs_nas_wus_assistance_information_t *wus_assistance_information)
+{
+    int size = wus_assistance_information->length + sizeof(wus_assistance_information->length);
+
+    return size;
+}
+
 /* 9.9.3.63 NB-S1 DRX parameter
  * O TLV 3 */
 int ogs_nas_eps_decode_nb_s1_drx_parameter(ogs_nas_nb_s1_drx_parameter_t *nb_s1_drx_parameter, ogs_pkbuf_t *pkbuf)
@@ -3016,6 +3483,13 @@ int ogs_nas_eps_encode_nb_s1_drx_parameter(ogs_pkbuf_t *pkbuf, ogs_nas_nb_s1_drx
     return size;
 }
 
+int ogs_nas_eps_length_nb_s1_drx_parameter(ogs_nas_nb_s1_drx_parameter_t *nb_s1_drx_parameter)
+{
+    int size = nb_s1_drx_parameter->length + sizeof(nb_s1_drx_parameter->length);
+
+    return size;
+}
+
 /* 9.9.3.64 IMSI offset
  * O TLV 4 */
 int ogs_nas_eps_decode_imsi_offset(ogs_nas_imsi_offset_t *imsi_offset, ogs_pkbuf_t *pkbuf)
@@ -3055,6 +3529,13 @@ int ogs_nas_eps_encode_imsi_offset(ogs_pkbuf_t *pkbuf, ogs_nas_imsi_offset_t *im
     return size;
 }
 
+int ogs_nas_eps_length_imsi_offset(ogs_nas_imsi_offset_t *imsi_offset)
+{
+    int size = imsi_offset->length + sizeof(imsi_offset->length);
+
+    return size;
+}
+
 /* 9.9.3.65 UE request type
  * O TLV 3 */
 int ogs_nas_eps_decode_ue_request_type(ogs_nas_ue_request_type_t *ue_request_type, ogs_pkbuf_t *pkbuf)
@@ -3094,6 +3575,13 @@ int ogs_nas_eps_encode_ue_request_type(ogs_pkbuf_t *pkbuf, ogs_nas_ue_request_ty
     return size;
 }
 
+int ogs_nas_eps_length_ue_request_type(ogs_nas_ue_request_type_t *ue_request_type)
+{
+    int size = ue_request_type->length + sizeof(ue_request_type->length);
+
+    return size;
+}
+
 /* 9.9.3.66 Paging restriction
  * O TLV 3-5 */
 int ogs_nas_eps_decode_paging_restriction(ogs_nas_paging_restriction_t *paging_restriction, ogs_pkbuf_t *pkbuf)
@@ -3133,6 +3621,13 @@ int ogs_nas_eps_encode_paging_restriction(ogs_pkbuf_t *pkbuf, ogs_nas_paging_res
     return size;
 }
 
+int ogs_nas_eps_length_paging_restriction(ogs_nas_paging_restriction_t *paging_restriction)
+{
+    int size = paging_restriction->length + sizeof(paging_restriction->length);
+
+    return size;
+}
+
 /* 9.9.3.67 EPS additional request result
  * O TLV 3 */
 int ogs_nas_eps_decode_eps_additional_request_result(ogs_nas_eps_additional_request_result_t *eps_additional_request_result, ogs_pkbuf_t *pkbuf)
@@ -3172,6 +3667,13 @@ int ogs_nas_eps_encode_eps_additional_request_result(ogs_pkbuf_t *pkbuf, ogs_nas
     return size;
 }
 
+int ogs_nas_eps_length_eps_additional_request_result(ogs_nas_eps_additional_request_result_t *eps_additional_request_result)
+{
+    int size = eps_additional_request_result->length + sizeof(eps_additional_request_result->length);
+
+    return size;
+}
+
 /* 9.9.3.7 Detach type
  * M V 1/2 */
 int ogs_nas_eps_decode_detach_type(ogs_nas_detach_type_t *detach_type, ogs_pkbuf_t *pkbuf)
@@ -3206,6 +3708,11 @@ int ogs_nas_eps_encode_detach_type(ogs_pkbuf_t *pkbuf, ogs_nas_detach_type_t *de
     return size;
 }
 
+int ogs_nas_eps_length_detach_type(ogs_nas_detach_type_t *detach_type)
+{
+    return sizeof(ogs_nas_detach_type_t);
+}
+
 /* 9.9.3.8 DRX parameter
  * O TV 3 */
 int ogs_nas_eps_decode_drx_parameter(ogs_nas_drx_parameter_t *drx_parameter, ogs_pkbuf_t *pkbuf)
@@ -3240,6 +3747,11 @@ int ogs_nas_eps_encode_drx_parameter(ogs_pkbuf_t *pkbuf, ogs_nas_drx_parameter_t
     return size;
 }
 
+int ogs_nas_eps_length_drx_parameter(ogs_nas_drx_parameter_t *drx_parameter)
+{
+    return sizeof(ogs_nas_drx_parameter_t);
+}
+
 /* 9.9.3.9 EMM cause
  * O TV 2 */
 int ogs_nas_eps_decode_emm_cause(ogs_nas_emm_cause_t *emm_cause, ogs_pkbuf_t *pkbuf)
@@ -3274,6 +3786,11 @@ int ogs_nas_eps_encode_emm_cause(ogs_pkbuf_t *pkbuf, ogs_nas_emm_cause_t *emm_ca
     return size;
 }
 
+int ogs_nas_eps_length_emm_cause(ogs_nas_emm_cause_t *emm_cause)
+{
+    return sizeof(ogs_nas_emm_cause_t);
+}
+
 /* 9.9.4.1 Access point name
  * M LV 2-101 */
 int ogs_nas_eps_decode_access_point_name(ogs_nas_access_point_name_t *access_point_name, ogs_pkbuf_t *pkbuf)
@@ -3326,6 +3843,15 @@ int ogs_nas_eps_encode_access_point_name(ogs_pkbuf_t *pkbuf, ogs_nas_access_poin
     return size;
 }
 
+int ogs_nas_eps_length_access_point_name(ogs_nas_access_point_name_t *access_point_name)
+{
+    int size = access_point_name->length + sizeof(access_point_name->length);
+
+    size++; /* ogs_fqdn_build() adds the first label length */
+
+    return size;
+}
+
 /* 9.9.4.11 Protocol configuration options
  * O TLV 3-253 */
 int ogs_nas_eps_decode_protocol_configuration_options(ogs_nas_protocol_configuration_options_t *protocol_configuration_options, ogs_pkbuf_t *pkbuf)
@@ -3365,6 +3891,13 @@ int ogs_nas_eps_encode_protocol_configuration_options(ogs_pkbuf_t *pkbuf, ogs_na
     return size;
 }
 
+int ogs_nas_eps_length_protocol_configuration_options(ogs_nas_protocol_configuration_options_t *protocol_configuration_options)
+{
+    int size = protocol_configuration_options->length + sizeof(protocol_configuration_options->length);
+
+    return size;
+}
+
 /* 9.9.4.12 Quality of service
  * O TLV 14-22 */
 int ogs_nas_eps_decode_quality_of_service(ogs_nas_quality_of_service_t *quality_of_service, ogs_pkbuf_t *pkbuf)
@@ -3404,6 +3937,13 @@ int ogs_nas_eps_encode_quality_of_service(ogs_pkbuf_t *pkbuf, ogs_nas_quality_of
     return size;
 }
 
+int ogs_nas_eps_length_quality_of_service(ogs_nas_quality_of_service_t *quality_of_service)
+{
+    int size = quality_of_service->length + sizeof(quality_of_service->length);
+
+    return size;
+}
+
 /* 9.9.4.13 Radio priority
  * O TV 1 */
 int ogs_nas_eps_decode_radio_priority(ogs_nas_radio_priority_t *radio_priority, ogs_pkbuf_t *pkbuf)
@@ -3436,6 +3976,11 @@ int ogs_nas_eps_encode_radio_priority(ogs_pkbuf_t *pkbuf, ogs_nas_radio_priority
     return size;
 }
 
+int ogs_nas_eps_length_radio_priority(ogs_nas_radio_priority_t *radio_priority)
+{
+    return sizeof(ogs_nas_radio_priority_t);
+}
+
 /* 9.9.4.13A Re-attempt indicator
  * O TLV 3 */
 int ogs_nas_eps_decode_re_attempt_indicator(ogs_nas_re_attempt_indicator_t *re_attempt_indicator, ogs_pkbuf_t *pkbuf)
@@ -3475,6 +4020,13 @@ int ogs_nas_eps_encode_re_attempt_indicator(ogs_pkbuf_t *pkbuf, ogs_nas_re_attem
     return size;
 }
 
+int ogs_nas_eps_length_re_attempt_indicator(ogs_nas_re_attempt_indicator_t *re_attempt_indicator)
+{
+    int size = re_attempt_indicator->length + sizeof(re_attempt_indicator->length);
+
+    return size;
+}
+
 /* 9.9.4.14 Request type
  * M V 1/2 */
 int ogs_nas_eps_decode_request_type(ogs_nas_request_type_t *request_type, ogs_pkbuf_t *pkbuf)
@@ -3509,6 +4061,11 @@ int ogs_nas_eps_encode_request_type(ogs_pkbuf_t *pkbuf, ogs_nas_request_type_t *
     return size;
 }
 
+int ogs_nas_eps_length_request_type(ogs_nas_request_type_t *request_type)
+{
+    return sizeof(ogs_nas_request_type_t);
+}
+
 /* 9.9.4.15 Traffic flow aggregate description
  * M LV 2-256 */
 int ogs_nas_eps_decode_traffic_flow_aggregate_description(ogs_nas_traffic_flow_aggregate_description_t *traffic_flow_aggregate_description, ogs_pkbuf_t *pkbuf)
@@ -3548,6 +4105,13 @@ int ogs_nas_eps_encode_traffic_flow_aggregate_description(ogs_pkbuf_t *pkbuf, og
     return size;
 }
 
+int ogs_nas_eps_length_traffic_flow_aggregate_description(ogs_nas_traffic_flow_aggregate_description_t *traffic_flow_aggregate_description)
+{
+    int size = traffic_flow_aggregate_description->length + sizeof(traffic_flow_aggregate_description->length);
+
+    return size;
+}
+
 /* 9.9.4.16 Traffic flow template
  * M LV 2-256 */
 int ogs_nas_eps_decode_traffic_flow_template(ogs_nas_traffic_flow_template_t *traffic_flow_template, ogs_pkbuf_t *pkbuf)
@@ -3587,6 +4151,13 @@ int ogs_nas_eps_encode_traffic_flow_template(ogs_pkbuf_t *pkbuf, ogs_nas_traffic
     return size;
 }
 
+int ogs_nas_eps_length_traffic_flow_template(ogs_nas_traffic_flow_template_t *traffic_flow_template)
+{
+    int size = traffic_flow_template->length + sizeof(traffic_flow_template->length);
+
+    return size;
+}
+
 /* 9.9.4.17 Transaction identifier
  * O TLV 3-4 */
 int ogs_nas_eps_decode_transaction_identifier(ogs_nas_transaction_identifier_t *transaction_identifier, ogs_pkbuf_t *pkbuf)
@@ -3626,6 +4197,13 @@ int ogs_nas_eps_encode_transaction_identifier(ogs_pkbuf_t *pkbuf, ogs_nas_transa
     return size;
 }
 
+int ogs_nas_eps_length_transaction_identifier(ogs_nas_transaction_identifier_t *transaction_identifier)
+{
+    int size = transaction_identifier->length + sizeof(transaction_identifier->length);
+
+    return size;
+}
+
 /* 9.9.4.18 WLAN offload acceptability
  * O TV 1 */
 int ogs_nas_eps_decode_wlan_offload_acceptability(ogs_nas_wlan_offload_acceptability_t *wlan_offload_acceptability, ogs_pkbuf_t *pkbuf)
@@ -3658,6 +4236,11 @@ int ogs_nas_eps_encode_wlan_offload_acceptability(ogs_pkbuf_t *pkbuf, ogs_nas_wl
     return size;
 }
 
+int ogs_nas_eps_length_wlan_offload_acceptability(ogs_nas_wlan_offload_acceptability_t *wlan_offload_acceptability)
+{
+    return sizeof(ogs_nas_wlan_offload_acceptability_t);
+}
+
 /* 9.9.4.19 NBIFOM container
  * O TLV 3-257 */
 int ogs_nas_eps_decode_nbifom_container(ogs_nas_nbifom_container_t *nbifom_container, ogs_pkbuf_t *pkbuf)
@@ -3697,6 +4280,13 @@ int ogs_nas_eps_encode_nbifom_container(ogs_pkbuf_t *pkbuf, ogs_nas_nbifom_conta
     return size;
 }
 
+int ogs_nas_eps_length_nbifom_container(ogs_nas_nbifom_container_t *nbifom_container)
+{
+    int size = nbifom_container->length + sizeof(nbifom_container->length);
+
+    return size;
+}
+
 /* 9.9.4.2 APN aggregate maximum bit rate
  * O TLV 4-8 */
 int ogs_nas_eps_decode_apn_aggregate_maximum_bit_rate(ogs_nas_apn_aggregate_maximum_bit_rate_t *apn_aggregate_maximum_bit_rate, ogs_pkbuf_t *pkbuf)
@@ -3736,6 +4326,13 @@ int ogs_nas_eps_encode_apn_aggregate_maximum_bit_rate(ogs_pkbuf_t *pkbuf, ogs_na
     return size;
 }
 
+int ogs_nas_eps_length_apn_aggregate_maximum_bit_rate(ogs_nas_apn_aggregate_maximum_bit_rate_t *apn_aggregate_maximum_bit_rate)
+{
+    int size = apn_aggregate_maximum_bit_rate->length + sizeof(apn_aggregate_maximum_bit_rate->length);
+
+    return size;
+}
+
 /* 9.9.4.22 Header compression configuration
  * O TLV 5-257 */
 int ogs_nas_eps_decode_header_compression_configuration(ogs_nas_header_compression_configuration_t *header_compression_configuration, ogs_pkbuf_t *pkbuf)
@@ -3779,6 +4376,13 @@ int ogs_nas_eps_encode_header_compression_configuration(ogs_pkbuf_t *pkbuf, ogs_
     return size;
 }
 
+int ogs_nas_eps_length_header_compression_configuration(ogs_nas_header_compression_configuration_t *header_compression_configuration)
+{
+    int size = header_compression_configuration->length + sizeof(header_compression_configuration->length);
+
+    return size;
+}
+
 /* 9.9.4.23 Control plane only indication
  * O TV 1 */
 int ogs_nas_eps_decode_control_plane_only_indication(ogs_nas_control_plane_only_indication_t *control_plane_only_indication, ogs_pkbuf_t *pkbuf)
@@ -3811,6 +4415,11 @@ int ogs_nas_eps_encode_control_plane_only_indication(ogs_pkbuf_t *pkbuf, ogs_nas
     return size;
 }
 
+int ogs_nas_eps_length_control_plane_only_indication(ogs_nas_control_plane_only_indication_t *control_plane_only_indication)
+{
+    return sizeof(ogs_nas_control_plane_only_indication_t);
+}
+
 /* 9.9.4.26 Extended protocol configuration options
  * O TLV-E 4-65538 */
 int ogs_nas_eps_decode_extended_protocol_configuration_options(ogs_nas_extended_protocol_configuration_options_t *extended_protocol_configuration_options, ogs_pkbuf_t *pkbuf)
@@ -3857,6 +4466,11 @@ int ogs_nas_eps_encode_extended_protocol_configuration_options(ogs_pkbuf_t *pkbu
     return extended_protocol_configuration_options->length + sizeof(extended_protocol_configuration_options->length);
 }
 
+int ogs_nas_eps_length_extended_protocol_configuration_options(ogs_nas_extended_protocol_configuration_options_t *extended_protocol_configuration_options)
+{
+    return extended_protocol_configuration_options->length + sizeof(extended_protocol_configuration_options->length);
+}
+
 /* 9.9.4.27 Header compression configuration status
  * O TLV 4 */
 int ogs_nas_eps_decode_header_compression_configuration_status(ogs_nas_header_compression_configuration_status_t *header_compression_configuration_status, ogs_pkbuf_t *pkbuf)
@@ -3896,6 +4510,13 @@ int ogs_nas_eps_encode_header_compression_configuration_status(ogs_pkbuf_t *pkbu
     return size;
 }
 
+int ogs_nas_eps_length_header_compression_configuration_status(ogs_nas_header_compression_configuration_status_t *header_compression_configuration_status)
+{
+    int size = header_compression_configuration_status->length + sizeof(header_compression_configuration_status->length);
+
+    return size;
+}
+
 /* 9.9.4.28 Serving PLMN rate control
  * O TLV 4 */
 int ogs_nas_eps_decode_serving_plmn_rate_control(ogs_nas_serving_plmn_rate_control_t *serving_plmn_rate_control, ogs_pkbuf_t *pkbuf)
@@ -3935,6 +4556,13 @@ int ogs_nas_eps_encode_serving_plmn_rate_control(ogs_pkbuf_t *pkbuf, ogs_nas_ser
     return size;
 }
 
+int ogs_nas_eps_length_serving_plmn_rate_control(ogs_nas_serving_plmn_rate_control_t *serving_plmn_rate_control)
+{
+    int size = serving_plmn_rate_control->length + sizeof(serving_plmn_rate_control->length);
+
+    return size;
+}
+
 /* 9.9.4.29 Extended APN aggregate maximum bit rate
  * O TLV 8 */
 int ogs_nas_eps_decode_extended_apn_aggregate_maximum_bit_rate(ogs_nas_extended_apn_aggregate_maximum_bit_rate_t *extended_apn_aggregate_maximum_bit_rate, ogs_pkbuf_t *pkbuf)
@@ -3974,6 +4602,13 @@ int ogs_nas_eps_encode_extended_apn_aggregate_maximum_bit_rate(ogs_pkbuf_t *pkbu
     return size;
 }
 
+int ogs_nas_eps_length_extended_apn_aggregate_maximum_bit_rate(ogs_nas_extended_apn_aggregate_maximum_bit_rate_t *extended_apn_aggregate_maximum_bit_rate)
+{
+    int size = extended_apn_aggregate_maximum_bit_rate->length + sizeof(extended_apn_aggregate_maximum_bit_rate->length);
+
+    return size;
+}
+
 /* 9.9.4.2A Connectivity type
  * O TV 1 */
 int ogs_nas_eps_decode_connectivity_type(ogs_nas_connectivity_type_t *connectivity_type, ogs_pkbuf_t *pkbuf)
@@ -4006,6 +4641,11 @@ int ogs_nas_eps_encode_connectivity_type(ogs_pkbuf_t *pkbuf, ogs_nas_connectivit
     return size;
 }
 
+int ogs_nas_eps_length_connectivity_type(ogs_nas_connectivity_type_t *connectivity_type)
+{
+    return sizeof(ogs_nas_connectivity_type_t);
+}
+
 /* 9.9.4.3 EPS quality of service
  * M LV 2-14 */
 int ogs_nas_eps_decode_eps_quality_of_service(ogs_nas_eps_quality_of_service_t *eps_quality_of_service, ogs_pkbuf_t *pkbuf)
@@ -4045,6 +4685,13 @@ int ogs_nas_eps_encode_eps_quality_of_service(ogs_pkbuf_t *pkbuf, ogs_nas_eps_qu
     return size;
 }
 
+int ogs_nas_eps_length_eps_quality_of_service(ogs_nas_eps_quality_of_service_t *eps_quality_of_service)
+{
+    int size = eps_quality_of_service->length + sizeof(eps_quality_of_service->length);
+
+    return size;
+}
+
 /* 9.9.4.30 Extended quality of service
  * O TLV 12 */
 int ogs_nas_eps_decode_extended_quality_of_service(ogs_nas_extended_quality_of_service_t *extended_quality_of_service, ogs_pkbuf_t *pkbuf)
@@ -4084,6 +4731,13 @@ int ogs_nas_eps_encode_extended_quality_of_service(ogs_pkbuf_t *pkbuf, ogs_nas_e
     return size;
 }
 
+int ogs_nas_eps_length_extended_quality_of_service(ogs_nas_extended_quality_of_service_t *extended_quality_of_service)
+{
+    int size = extended_quality_of_service->length + sizeof(extended_quality_of_service->length);
+
+    return size;
+}
+
 /* 9.9.4.4 ESM cause
  * O TV 2 */
 int ogs_nas_eps_decode_esm_cause(ogs_nas_esm_cause_t *esm_cause, ogs_pkbuf_t *pkbuf)
@@ -4118,6 +4772,11 @@ int ogs_nas_eps_encode_esm_cause(ogs_pkbuf_t *pkbuf, ogs_nas_esm_cause_t *esm_ca
     return size;
 }
 
+int ogs_nas_eps_length_esm_cause(ogs_nas_esm_cause_t *esm_cause)
+{
+    return sizeof(ogs_nas_esm_cause_t);
+}
+
 /* 9.9.4.5 ESM information transfer flag
  * O TV 1 */
 int ogs_nas_eps_decode_esm_information_transfer_flag(ogs_nas_esm_information_transfer_flag_t *esm_information_transfer_flag, ogs_pkbuf_t *pkbuf)
@@ -4150,6 +4809,11 @@ int ogs_nas_eps_encode_esm_information_transfer_flag(ogs_pkbuf_t *pkbuf, ogs_nas
     return size;
 }
 
+int ogs_nas_eps_length_esm_information_transfer_flag(ogs_nas_esm_information_transfer_flag_t *esm_information_transfer_flag)
+{
+    return sizeof(ogs_nas_esm_information_transfer_flag_t);
+}
+
 /* 9.9.4.6 Linked EPS bearer identity
  * M V 1/2 */
 int ogs_nas_eps_decode_linked_eps_bearer_identity(ogs_nas_linked_eps_bearer_identity_t *linked_eps_bearer_identity, ogs_pkbuf_t *pkbuf)
@@ -4184,6 +4848,11 @@ int ogs_nas_eps_encode_linked_eps_bearer_identity(ogs_pkbuf_t *pkbuf, ogs_nas_li
     return size;
 }
 
+int ogs_nas_eps_length_linked_eps_bearer_identity(ogs_nas_linked_eps_bearer_identity_t *linked_eps_bearer_identity)
+{
+    return sizeof(ogs_nas_linked_eps_bearer_identity_t);
+}
+
 /* 9.9.4.7 LLC service access point identifier
  * O TV 2 */
 int ogs_nas_eps_decode_llc_service_access_point_identifier(ogs_nas_llc_service_access_point_identifier_t *llc_service_access_point_identifier, ogs_pkbuf_t *pkbuf)
@@ -4218,6 +4887,11 @@ int ogs_nas_eps_encode_llc_service_access_point_identifier(ogs_pkbuf_t *pkbuf, o
     return size;
 }
 
+int ogs_nas_eps_length_llc_service_access_point_identifier(ogs_nas_llc_service_access_point_identifier_t *llc_service_access_point_identifier)
+{
+    return sizeof(ogs_nas_llc_service_access_point_identifier_t);
+}
+
 /* 9.9.4.8 Packet flow Identifier
  * O TLV 3 */
 int ogs_nas_eps_decode_packet_flow_identifier(ogs_nas_packet_flow_identifier_t *packet_flow_identifier, ogs_pkbuf_t *pkbuf)
@@ -4257,6 +4931,13 @@ int ogs_nas_eps_encode_packet_flow_identifier(ogs_pkbuf_t *pkbuf, ogs_nas_packet
     return size;
 }
 
+int ogs_nas_eps_length_packet_flow_identifier(ogs_nas_packet_flow_identifier_t *packet_flow_identifier)
+{
+    int size = packet_flow_identifier->length + sizeof(packet_flow_identifier->length);
+
+    return size;
+}
+
 /* 9.9.4.9 PDN address
  * M LV 6-14 */
 int ogs_nas_eps_decode_pdn_address(ogs_nas_pdn_address_t *pdn_address, ogs_pkbuf_t *pkbuf)
@@ -4296,3 +4977,10 @@ int ogs_nas_eps_encode_pdn_address(ogs_pkbuf_t *pkbuf, ogs_nas_pdn_address_t *pd
     return size;
 }
 
+int ogs_nas_eps_length_pdn_address(ogs_nas_pdn_address_t *pdn_address)
+{
+    int size = pdn_address->length + sizeof(pdn_address->length);
+
+    return size;
+}
+
@@ -275,6 +275,121 @@ int ogs_nas_eps_encode_llc_service_access_point_identifier(ogs_pkbuf_t *pkbuf, o
 int ogs_nas_eps_encode_packet_flow_identifier(ogs_pkbuf_t *pkbuf, ogs_nas_packet_flow_identifier_t *packet_flow_identifier);
 int ogs_nas_eps_encode_pdn_address(ogs_pkbuf_t *pkbuf, ogs_nas_pdn_address_t *pdn_address);
 
+int ogs_nas_eps_length_additional_information(ogs_nas_additional_information_t *additional_information);
+int ogs_nas_eps_length_device_properties(ogs_nas_device_properties_t *device_properties);
+int ogs_nas_eps_length_eps_bearer_context_status(ogs_nas_eps_bearer_context_status_t *eps_bearer_context_status);
+int ogs_nas_eps_length_supported_codec_list(ogs_nas_supported_codec_list_t *supported_codec_list);
+int ogs_nas_eps_length_location_area_identification(ogs_nas_location_area_identification_t *location_area_identification);
+int ogs_nas_eps_length_mobile_identity(ogs_nas_mobile_identity_t *mobile_identity);
+int ogs_nas_eps_length_mobile_station_classmark_2(ogs_nas_mobile_station_classmark_2_t *mobile_station_classmark_2);
+int ogs_nas_eps_length_mobile_station_classmark_3(ogs_nas_mobile_station_classmark_3_t *mobile_station_classmark_3);
+int ogs_nas_eps_length_plmn_list(ogs_nas_plmn_list_t *plmn_list);
+int ogs_nas_eps_length_additional_update_result(ogs_nas_additional_update_result_t *additional_update_result);
+int ogs_nas_eps_length_additional_update_type(ogs_nas_additional_update_type_t *additional_update_type);
+int ogs_nas_eps_length_authentication_failure_parameter(ogs_nas_authentication_failure_parameter_t *authentication_failure_parameter);
+int ogs_nas_eps_length_eps_attach_result(ogs_nas_eps_attach_result_t *eps_attach_result);
+int ogs_nas_eps_length_eps_attach_type(ogs_nas_eps_attach_type_t *eps_attach_type);
+int ogs_nas_eps_length_eps_mobile_identity(ogs_nas_eps_mobile_identity_t *eps_mobile_identity);
+int ogs_nas_eps_length_eps_network_feature_support(ogs_nas_eps_network_feature_support_t *eps_network_feature_support);
+int ogs_nas_eps_length_eps_update_result(ogs_nas_eps_update_result_t *eps_update_result);
+int ogs_nas_eps_length_eps_update_type(ogs_nas_eps_update_type_t *eps_update_type);
+int ogs_nas_eps_length_esm_message_container(ogs_nas_esm_message_container_t *esm_message_container);
+int ogs_nas_eps_length_gprs_timer(ogs_nas_gprs_timer_t *gprs_timer);
+int ogs_nas_eps_length_gprs_timer_2(ogs_nas_gprs_timer_2_t *gprs_timer_2);
+int ogs_nas_eps_length_gprs_timer_3(ogs_nas_gprs_timer_3_t *gprs_timer_3);
+int ogs_nas_eps_length_identity_type_2(ogs_nas_identity_type_2_t *identity_type_2);
+int ogs_nas_eps_length_imeisv_request(ogs_nas_imeisv_request_t *imeisv_request);
+int ogs_nas_eps_length_ksi_and_sequence_number(ogs_nas_ksi_and_sequence_number_t *ksi_and_sequence_number);
+int ogs_nas_eps_length_authentication_parameter_autn(ogs_nas_authentication_parameter_autn_t *authentication_parameter_autn);
+int ogs_nas_eps_length_ms_network_capability(ogs_nas_ms_network_capability_t *ms_network_capability);
+int ogs_nas_eps_length_ms_network_feature_support(ogs_nas_ms_network_feature_support_t *ms_network_feature_support);
+int ogs_nas_eps_length_key_set_identifier(ogs_nas_key_set_identifier_t *key_set_identifier);
+int ogs_nas_eps_length_eps_message_container(ogs_nas_eps_message_container_t *eps_message_container);
+int ogs_nas_eps_length_security_algorithms(ogs_nas_security_algorithms_t *security_algorithms);
+int ogs_nas_eps_length_network_name(ogs_nas_network_name_t *network_name);
+int ogs_nas_eps_length_network_resource_identifier_container(ogs_nas_network_resource_identifier_container_t *network_resource_identifier_container);
+int ogs_nas_eps_length_nonce(ogs_nas_nonce_t *nonce);
+int ogs_nas_eps_length_paging_identity(ogs_nas_paging_identity_t *paging_identity);
+int ogs_nas_eps_length_p_tmsi_signature(ogs_nas_p_tmsi_signature_t *p_tmsi_signature);
+int ogs_nas_eps_length_extended_emm_cause(ogs_nas_extended_emm_cause_t *extended_emm_cause);
+int ogs_nas_eps_length_service_type(ogs_nas_service_type_t *service_type);
+int ogs_nas_eps_length_short_mac(ogs_nas_short_mac_t *short_mac);
+int ogs_nas_eps_length_time_zone(ogs_nas_time_zone_t *time_zone);
+int ogs_nas_eps_length_authentication_parameter_rand(ogs_nas_authentication_parameter_rand_t *authentication_parameter_rand);
+int ogs_nas_eps_length_time_zone_and_time(ogs_nas_time_zone_and_time_t *time_zone_and_time);
+int ogs_nas_eps_length_tmsi_status(ogs_nas_tmsi_status_t *tmsi_status);
+int ogs_nas_eps_length_tracking_area_identity(ogs_nas_tracking_area_identity_t *tracking_area_identity);
+int ogs_nas_eps_length_tracking_area_identity_list(ogs_nas_tracking_area_identity_list_t *tracking_area_identity_list);
+int ogs_nas_eps_length_ue_network_capability(ogs_nas_ue_network_capability_t *ue_network_capability);
+int ogs_nas_eps_length_ue_radio_capability_information_update_needed(ogs_nas_ue_radio_capability_information_update_needed_t *ue_radio_capability_information_update_needed);
+int ogs_nas_eps_length_ue_security_capability(ogs_nas_ue_security_capability_t *ue_security_capability);
+int ogs_nas_eps_length_emergency_number_list(ogs_nas_emergency_number_list_t *emergency_number_list);
+int ogs_nas_eps_length_extended_emergency_number_list(ogs_nas_extended_emergency_number_list_t *extended_emergency_number_list);
+int ogs_nas_eps_length_cli(ogs_nas_cli_t *cli);
+int ogs_nas_eps_length_ss_code(ogs_nas_ss_code_t *ss_code);
+int ogs_nas_eps_length_authentication_response_parameter(ogs_nas_authentication_response_parameter_t *authentication_response_parameter);
+int ogs_nas_eps_length_lcs_indicator(ogs_nas_lcs_indicator_t *lcs_indicator);
+int ogs_nas_eps_length_lcs_client_identity(ogs_nas_lcs_client_identity_t *lcs_client_identity);
+int ogs_nas_eps_length_generic_message_container_type(ogs_nas_generic_message_container_type_t *generic_message_container_type);
+int ogs_nas_eps_length_generic_message_container(ogs_nas_generic_message_container_t *generic_message_container);
+int ogs_nas_eps_length_voice_domain_preference_and_ue_usage_setting(ogs_nas_voice_domain_preference_and_ue_usage_setting_t *voice_domain_preference_and_ue_usage_setting);
+int ogs_nas_eps_length_guti_type(ogs_nas_guti_type_t *guti_type);
+int ogs_nas_eps_length_extended_drx_parameters(ogs_nas_extended_drx_parameters_t *extended_drx_parameters);
+int ogs_nas_eps_length_dcn_id(ogs_nas_dcn_id_t *dcn_id);
+int ogs_nas_eps_length_non__nw_provided_policies(ogs_nas_non__nw_provided_policies_t *non__nw_provided_policies);
+int ogs_nas_eps_length_sms_services_status(ogs_nas_sms_services_status_t *sms_services_status);
+int ogs_nas_eps_length_ciphering_key_sequence_number(ogs_nas_ciphering_key_sequence_number_t *ciphering_key_sequence_number);
+int ogs_nas_eps_length_csfb_response(ogs_nas_csfb_response_t *csfb_response);
+int ogs_nas_eps_length_hashmme(ogs_nas_hashmme_t *hashmme);
+int ogs_nas_eps_length_replayed_nas_message_container(ogs_nas_replayed_nas_message_container_t *replayed_nas_message_container);
+int ogs_nas_eps_length_network_policy(ogs_nas_network_policy_t *network_policy);
+int ogs_nas_eps_length_ue_additional_security_capability(ogs_nas_ue_additional_security_capability_t *ue_additional_security_capability);
+int ogs_nas_eps_length_ue_status(ogs_nas_ue_status_t *ue_status);
+int ogs_nas_eps_length_additional_information_requested(ogs_nas_additional_information_requested_t *additional_information_requested);
+int ogs_nas_eps_length_ciphering_key_data(ogs_nas_ciphering_key_data_t *ciphering_key_data);
+int ogs_nas_eps_length_n1_ue_network_capability(ogs_nas_n1_ue_network_capability_t *n1_ue_network_capability);
+int ogs_nas_eps_length_ue_radio_capability_id_availability(ogs_nas_ue_radio_capability_id_availability_t *ue_radio_capability_id_availability);
+int ogs_nas_eps_length_ue_radio_capability_id_request(ogs_nas_ue_radio_capability_id_request_t *ue_radio_capability_id_request);
+int ogs_nas_eps_length_daylight_saving_time(ogs_nas_daylight_saving_time_t *daylight_saving_time);
+int ogs_nas_eps_length_ue_radio_capability_id(ogs_nas_ue_radio_capability_id_t *ue_radio_capability_id);
+int ogs_nas_eps_length_ue_radio_capability_id_deletion_indication(ogs_nas_ue_radio_capability_id_deletion_indication_t *ue_radio_capability_id_deletion_indication);
+int ogs_nas_eps_length_wus_assistance_information(ogs_nas_wus_assistance_information_t *wus_assistance_information);
+int ogs_nas_eps_length_nb_s1_drx_parameter(ogs_nas_nb_s1_drx_parameter_t *nb_s1_drx_parameter);
+int ogs_nas_eps_length_imsi_offset(ogs_nas_imsi_offset_t *imsi_offset);
+int ogs_nas_eps_length_ue_request_type(ogs_nas_ue_request_type_t *ue_request_type);
+int ogs_nas_eps_length_paging_restriction(ogs_nas_paging_restriction_t *paging_restriction);
+int ogs_nas_eps_length_eps_additional_request_result(ogs_nas_eps_additional_request_result_t *eps_additional_request_result);
+int ogs_nas_eps_length_detach_type(ogs_nas_detach_type_t *detach_type);
+int ogs_nas_eps_length_drx_parameter(ogs_nas_drx_parameter_t *drx_parameter);
+int ogs_nas_eps_length_emm_cause(ogs_nas_emm_cause_t *emm_cause);
+int ogs_nas_eps_length_access_point_name(ogs_nas_access_point_name_t *access_point_name);
+int ogs_nas_eps_length_protocol_configuration_options(ogs_nas_protocol_configuration_options_t *protocol_configuration_options);
+int ogs_nas_eps_length_quality_of_service(ogs_nas_quality_of_service_t *quality_of_service);
+int ogs_nas_eps_length_radio_priority(ogs_nas_radio_priority_t *radio_priority);
+int ogs_nas_eps_length_re_attempt_indicator(ogs_nas_re_attempt_indicator_t *re_attempt_indicator);
+int ogs_nas_eps_length_request_type(ogs_nas_request_type_t *request_type);
+int ogs_nas_eps_length_traffic_flow_aggregate_description(ogs_nas_traffic_flow_aggregate_description_t *traffic_flow_aggregate_description);
+int ogs_nas_eps_length_traffic_flow_template(ogs_nas_traffic_flow_template_t *traffic_flow_template);
+int ogs_nas_eps_length_transaction_identifier(ogs_nas_transaction_identifier_t *transaction_identifier);
+int ogs_nas_eps_length_wlan_offload_acceptability(ogs_nas_wlan_offload_acceptability_t *wlan_offload_acceptability);
+int ogs_nas_eps_length_nbifom_container(ogs_nas_nbifom_container_t *nbifom_container);
+int ogs_nas_eps_length_apn_aggregate_maximum_bit_rate(ogs_nas_apn_aggregate_maximum_bit_rate_t *apn_aggregate_maximum_bit_rate);
+int ogs_nas_eps_length_header_compression_configuration(ogs_nas_header_compression_configuration_t *header_compression_configuration);
+int ogs_nas_eps_length_control_plane_only_indication(ogs_nas_control_plane_only_indication_t *control_plane_only_indication);
+int ogs_nas_eps_length_extended_protocol_configuration_options(ogs_nas_extended_protocol_configuration_options_t *extended_protocol_configuration_options);
+int ogs_nas_eps_length_header_compression_configuration_status(ogs_nas_header_compression_configuration_status_t *header_compression_configuration_status);
+int ogs_nas_eps_length_serving_plmn_rate_control(ogs_nas_serving_plmn_rate_control_t *serving_plmn_rate_control);
+int ogs_nas_eps_length_extended_apn_aggregate_maximum_bit_rate(ogs_nas_extended_apn_aggregate_maximum_bit_rate_t *extended_apn_aggregate_maximum_bit_rate);
+int ogs_nas_eps_length_connectivity_type(ogs_nas_connectivity_type_t *connectivity_type);
+int ogs_nas_eps_length_eps_quality_of_service(ogs_nas_eps_quality_of_service_t *eps_quality_of_service);
+int ogs_nas_eps_length_extended_quality_of_service(ogs_nas_extended_quality_of_service_t *extended_quality_of_service);
+int ogs_nas_eps_length_esm_cause(ogs_nas_esm_cause_t *esm_cause);
+int ogs_nas_eps_length_esm_information_transfer_flag(ogs_nas_esm_information_transfer_flag_t *esm_information_transfer_flag);
+int ogs_nas_eps_length_linked_eps_bearer_identity(ogs_nas_linked_eps_bearer_identity_t *linked_eps_bearer_identity);
+int ogs_nas_eps_length_llc_service_access_point_identifier(ogs_nas_llc_service_access_point_identifier_t *llc_service_access_point_identifier);
+int ogs_nas_eps_length_packet_flow_identifier(ogs_nas_packet_flow_identifier_t *packet_flow_identifier);
+int ogs_nas_eps_length_pdn_address(ogs_nas_pdn_address_t *pdn_address);
+
 #ifdef __cplusplus
 }
 #endif
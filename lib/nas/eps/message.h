@@ -1641,6 +1641,8 @@ typedef struct ogs_nas_eps_message_s {
 
 ogs_pkbuf_t *ogs_nas_emm_encode(ogs_nas_eps_message_t *message);
 ogs_pkbuf_t *ogs_nas_esm_encode(ogs_nas_eps_message_t *message);
+int ogs_nas_emm_length(ogs_nas_eps_message_t *message);
+int ogs_nas_esm_length(ogs_nas_eps_message_t *message);
 int ogs_nas_emm_decode(ogs_nas_eps_message_t *message, ogs_pkbuf_t *pkbuf);
 int ogs_nas_esm_decode(ogs_nas_eps_message_t *message, ogs_pkbuf_t *pkbuf);
 ogs_pkbuf_t *ogs_nas_eps_plain_encode(ogs_nas_eps_message_t *message);
@@ -372,6 +372,10 @@ for (k, v) in sorted_type_list:
     f.write("int ogs_nas_eps_encode_%s(ogs_pkbuf_t *pkbuf, ogs_nas_%s_t *%s);\n" % (v_lower(k), v_lower(k), v_lower(k)))
 f.write("\n")
 
+for (k, v) in sorted_type_list:
+    f.write("int ogs_nas_eps_length_%s(ogs_nas_%s_t *%s);\n" % (v_lower(k), v_lower(k), v_lower(k)))
+f.write("\n")
+
 
 f.write("""#ifdef __cplusplus
 }
@@ -522,6 +526,24 @@ for (k, v) in sorted_type_list:
         f.write("    ogs_log_hexdump(OGS_LOG_TRACE, pkbuf->data - size, size);\n\n");
         f.write("    return size;\n")
         f.write("}\n\n");
+
+    f.write("int ogs_nas_eps_length_%s(ogs_nas_%s_t *%s)\n" % (v_lower(k), v_lower(k), v_lower(k)))
+    f.write("{\n")
+    if (type_list[k]["format"] == "TV" or type_list[k]["format"] == "T") and type_list[k]["length"] == "1":
+        f.write("    return sizeof(ogs_nas_%s_t);\n" % v_lower(k))
+    elif type_list[k]["format"] == "TV" or type_list[k]["format"] == "V":
+        if type_list[k]["length"] == "4":
+            f.write("    return 3;\n")
+        else:
+            f.write("    return sizeof(ogs_nas_%s_t);\n" % v_lower(k))
+    elif type_list[k]["format"] == "LV-E" or type_list[k]["format"] == "TLV-E":
+        f.write("    return %s->length + sizeof(%s->length);\n" % (v_lower(k), v_lower(k)))
+    else:
+        f.write("    int size = %s->length + sizeof(%s->length);\n\n" % (v_lower(k), v_lower(k)))
+        if "size" in type_list[k]:
+            f.write("%s" % type_list[k]["size"])
+        f.write("    return size;\n")
+    f.write("}\n\n")
 f.close()
 
 f = open(outdir + 'message.h', 'w')
@@ -645,6 +667,8 @@ typedef struct ogs_nas_eps_message_s {
 
 ogs_pkbuf_t *ogs_nas_emm_encode(ogs_nas_eps_message_t *message);
 ogs_pkbuf_t *ogs_nas_esm_encode(ogs_nas_eps_message_t *message);
+int ogs_nas_emm_length(ogs_nas_eps_message_t *message);
+int ogs_nas_esm_length(ogs_nas_eps_message_t *message);
 int ogs_nas_emm_decode(ogs_nas_eps_message_t *message, ogs_pkbuf_t *pkbuf);
 int ogs_nas_esm_decode(ogs_nas_eps_message_t *message, ogs_pkbuf_t *pkbuf);
 ogs_pkbuf_t *ogs_nas_eps_plain_encode(ogs_nas_eps_message_t *message);
@@ -861,6 +885,7 @@ for (k, v) in sorted_msg_list:
     if len(msg_list[k]["ies"]) == 0:
         continue
     f.write("int ogs_nas_eps_encode_%s(ogs_pkbuf_t *pkbuf, ogs_nas_eps_message_t *message);\n" % v_lower(k))
+    f.write("int ogs_nas_eps_length_%s(ogs_nas_eps_message_t *message);\n" % v_lower(k))
 
 for (k, v) in sorted_msg_list:
     if "ies" not in msg_list[k]:
@@ -902,24 +927,112 @@ for (k, v) in sorted_msg_list:
 
 """)
 
+    f.write("int ogs_nas_eps_length_%s(ogs_nas_eps_message_t *message)\n{\n" % v_lower(k))
+    if float(msg_list[k]["type"]) < 192:
+        f.write("    ogs_nas_eps_%s_t *%s = &message->emm.%s;\n" % (v_lower(k), v_lower(k), v_lower(k)))
+    else:
+        f.write("    ogs_nas_eps_%s_t *%s = &message->esm.%s;\n" % (v_lower(k), v_lower(k), v_lower(k)))
+    f.write("    int length = 0;\n\n")
+
+    for ie in [ies for ies in msg_list[k]["ies"] if ies["presence"] == "M"]:
+        f.write("    length += ogs_nas_eps_length_%s(&%s->%s);\n" % (v_lower(ie["type"]), v_lower(k), v_lower(ie["value"])))
+    if len([ies for ies in msg_list[k]["ies"] if ies["presence"] == "M"]) != 0:
+        f.write("\n")
+
+    for ie in [ies for ies in msg_list[k]["ies"] if ies["presence"] != "M"]:
+        f.write("    if (%s->presencemask & OGS_NAS_EPS_%s_%s_PRESENT) {\n" % (v_lower(k), v_upper(k), v_upper(ie["value"])))
+        if not (ie["length"] == "1" and (ie["format"] == "TV" or ie["format"] == "T")):
+            f.write("        length += sizeof(uint8_t);\n")
+        f.write("        length += ogs_nas_eps_length_%s(&%s->%s);\n" % (v_lower(ie["type"]), v_lower(k), v_lower(ie["value"])))
+        f.write("    }\n\n")
+
+    f.write("""    return length;
+}
+
+""")
+
+f.write("""int ogs_nas_emm_length(ogs_nas_eps_message_t *message)
+{
+    int length = sizeof(ogs_nas_emm_header_t);
+
+    ogs_assert(message);
+
+    if (message->emm.h.security_header_type >=
+            OGS_NAS_SECURITY_HEADER_FOR_SERVICE_REQUEST_MESSAGE)
+        return length - 1 + ogs_nas_eps_length_service_request(message);
+
+    switch (message->emm.h.message_type) {
+""")
+
+for (k, v) in sorted_msg_list:
+    if "ies" not in msg_list[k]:
+        continue;
+    if float(msg_list[k]["type"]) < 192 and k.find("FROM UE") == -1 and k != "SERVICE REQUEST":
+        f.write("    case OGS_NAS_EPS_%s:\n" % v_upper(k))
+        if len(msg_list[k]["ies"]) != 0:
+            f.write("        length += ogs_nas_eps_length_%s(message);\n" % v_lower(k))
+        f.write("        break;\n")
+
+f.write("""    default:
+        return -1;
+    }
+
+    return length;
+}
+
+int ogs_nas_esm_length(ogs_nas_eps_message_t *message)
+{
+    int length = sizeof(ogs_nas_esm_header_t);
+
+    ogs_assert(message);
+
+    switch (message->esm.h.message_type) {
+""")
+
+for (k, v) in sorted_msg_list:
+    if "ies" not in msg_list[k]:
+        continue;
+    if float(msg_list[k]["type"]) >= 192:
+        f.write("    case OGS_NAS_EPS_%s:\n" % v_upper(k))
+        if len(msg_list[k]["ies"]) != 0:
+            f.write("        length += ogs_nas_eps_length_%s(message);\n" % v_lower(k))
+        f.write("        break;\n")
+
+f.write("""    default:
+        return -1;
+    }
+
+    return length;
+}
+
+""")
 
 f.write("""ogs_pkbuf_t *ogs_nas_emm_encode(ogs_nas_eps_message_t *message)
 {
     ogs_pkbuf_t *pkbuf = NULL;
     int size = 0;
     int encoded = 0;
+    int length = 0;
 
     ogs_assert(message);
 
+    length = ogs_nas_emm_length(message);
+    if (length < 0) {
+        ogs_error("Unknown message type (0x%x) or not implemented", 
+                message->emm.h.message_type);
+        return NULL;
+    }
+
     /* The Packet Buffer(ogs_pkbuf_t) for NAS message MUST make a HEADROOM. 
-     * When calculating AES_CMAC, we need to use the headroom of the packet. */
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+     * When calculating AES_CMAC, we need to use the headroom of the packet.
+     * The length is known up front; OGS_NAS_SLACK only guards it. */
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+length+OGS_NAS_SLACK);
     if (!pkbuf) {
         ogs_error("ogs_pkbuf_alloc() failed");
         return NULL;
     }
     ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN-OGS_NAS_HEADROOM);
+    ogs_pkbuf_put(pkbuf, length+OGS_NAS_SLACK);
 
     size = sizeof(ogs_nas_emm_header_t);
     ogs_assert(ogs_pkbuf_pull(pkbuf, size));
@@ -960,6 +1073,8 @@ f.write("""    default:
     }
 
 out:
+    if (encoded != length)
+        ogs_error("NAS length %d, but %d octets encoded", length, encoded);
     ogs_assert(ogs_pkbuf_push(pkbuf, encoded));
 
     pkbuf->len = encoded;
@@ -974,18 +1089,27 @@ f.write("""ogs_pkbuf_t *ogs_nas_esm_encode(ogs_nas_eps_message_t *message)
     ogs_pkbuf_t *pkbuf = NULL;
     int size = 0;
     int encoded = 0;
+    int length = 0;
 
     ogs_assert(message);
 
+    length = ogs_nas_esm_length(message);
+    if (length < 0) {
+        ogs_error("Unknown message type (0x%x) or not implemented", 
+                message->esm.h.message_type);
+        return NULL;
+    }
+
     /* The Packet Buffer(ogs_pkbuf_t) for NAS message MUST make a HEADROOM. 
-     * When calculating AES_CMAC, we need to use the headroom of the packet. */
-    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+     * When calculating AES_CMAC, we need to use the headroom of the packet.
+     * The length is known up front; OGS_NAS_SLACK only guards it. */
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+length+OGS_NAS_SLACK);
     if (!pkbuf) {
         ogs_error("ogs_pkbuf_alloc() failed");
         return NULL;
     }
     ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
-    ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN-OGS_NAS_HEADROOM);
+    ogs_pkbuf_put(pkbuf, length+OGS_NAS_SLACK);
 
     size = sizeof(ogs_nas_esm_header_t);
     ogs_assert(ogs_pkbuf_pull(pkbuf, size));
@@ -1013,6 +1137,8 @@ f.write("""   default:
         return NULL;
     }
 
+    if (encoded != length)
+        ogs_error("NAS length %d, but %d octets encoded", length, encoded);
     ogs_assert(ogs_pkbuf_push(pkbuf, encoded));
     pkbuf->len = encoded;
 
@@ -82,3 +82,5 @@ type_list["Access point name"]["decode"] = \
 type_list["Access point name"]["encode"] = \
 "    target.length = ogs_fqdn_build(target.apn, access_point_name->apn, access_point_name->length);\n" \
 "    size = target.length + sizeof(target.length);\n\n"
+type_list["Access point name"]["size"] = \
+"    size++; /* ogs_fqdn_build() adds the first label length */\n\n"
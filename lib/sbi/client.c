@@ -29,6 +29,26 @@ typedef struct sockinfo_s {
     ogs_sbi_client_t *client;
 } sockinfo_t;
 
+/*
+ * Easy handles are kept per client after the request completes.
+ * curl_easy_reset() preserves the DNS and TLS session caches, and
+ * the header list is built in place over buffers that only ever grow,
+ * so a busy peer does not allocate per header on every request.
+ */
+#define MAX_NUM_OF_IDLE_HANDLE 64
+
+typedef struct handle_s {
+    ogs_lnode_t lnode;
+
+    CURL *easy;
+
+    int max_header;
+    struct curl_slist *header_list;
+
+    size_t header_buf_size;
+    char *header_buf;
+} handle_t;
+
 typedef struct connection_s {
     ogs_lnode_t lnode;
 
@@ -36,9 +56,8 @@ typedef struct connection_s {
 
     char *method;
 
-    int num_of_header;
-    char **headers;
-    struct curl_slist *header_list;
+    handle_t *handle;
+    bool queued;
 
     char *content;
 
@@ -64,6 +83,8 @@ static OGS_POOL(connection_pool, connection_t);
 
 static size_t write_cb(void *contents, size_t size, size_t nmemb, void *data);
 static size_t header_cb(void *ptr, size_t size, size_t nmemb, void *data);
+static void load_control_handle(ogs_sbi_client_t *client,
+        const char *ptr, size_t size, size_t offset, bool oci);
 static int sock_cb(CURL *e, curl_socket_t s, int what, void *cbp, void *sockp);
 static int multi_timer_cb(CURLM *multi, long timeout_ms, void *cbp);
 static void multi_timer_expired(void *data);
@@ -76,6 +97,11 @@ static void connection_free(connection_t *conn);
 static void connection_remove_all(ogs_sbi_client_t *client);
 static void connection_timer_expired(void *data);
 
+static handle_t *handle_get(ogs_sbi_client_t *client);
+static void handle_put(ogs_sbi_client_t *client, handle_t *handle);
+static void handle_free(handle_t *handle);
+static void handle_remove_all(ogs_sbi_client_t *client);
+
 void ogs_sbi_client_init(int num_of_sockinfo_pool, int num_of_connection_pool)
 {
     curl_global_init(CURL_GLOBAL_DEFAULT);
@@ -136,8 +162,14 @@ ogs_sbi_client_t *ogs_sbi_client_add(
     curl_multi_setopt(multi, CURLMOPT_MAX_CONCURRENT_STREAMS,
                         ogs_app()->pool.stream);
 #endif
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    if (ogs_app()->sbi.client.max_connection)
+        curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS,
+                        (long)ogs_app()->sbi.client.max_connection);
 
     ogs_list_init(&client->connection_list);
+    ogs_list_init(&client->pending_list);
+    ogs_list_init(&client->handle_list);
 
     ogs_list_add(&ogs_sbi_self()->client_list, client);
 
@@ -165,6 +197,7 @@ void ogs_sbi_client_remove(ogs_sbi_client_t *client)
     ogs_list_remove(&ogs_sbi_self()->client_list, client);
 
     connection_remove_all(client);
+    handle_remove_all(client);
 
     ogs_assert(client->t_curl);
     ogs_timer_delete(client->t_curl);
@@ -214,6 +247,10 @@ void ogs_sbi_client_stop(ogs_sbi_client_t *client)
         ogs_assert(conn->client_cb);
         conn->client_cb(OGS_DONE, NULL, conn->data);
     }
+    ogs_list_for_each(&client->pending_list, conn) {
+        ogs_assert(conn->client_cb);
+        conn->client_cb(OGS_DONE, NULL, conn->data);
+    }
 }
 
 void ogs_sbi_client_stop_all(void)
@@ -294,14 +331,98 @@ static char *add_params_to_uri(CURL *easy, char *uri, ogs_hash_t *params)
     return uri;
 }
 
+static int header_list_build(
+        handle_t *handle, ogs_hash_t *headers, bool expect)
+{
+    ogs_hash_index_t *hi;
+    int i, num_of_header;
+    size_t size = 0, len;
+    char *p;
+
+    ogs_assert(handle);
+    ogs_assert(headers);
+
+    num_of_header = ogs_hash_count(headers);
+    for (hi = ogs_hash_first(headers); hi; hi = ogs_hash_next(hi))
+        size += strlen(ogs_hash_this_key(hi)) +
+                strlen(ogs_hash_this_val(hi)) + 3;
+    if (expect)
+        num_of_header++;
+
+    if (!num_of_header) {
+        curl_easy_setopt(handle->easy, CURLOPT_HTTPHEADER, NULL);
+        return OGS_OK;
+    }
+
+    if (num_of_header > handle->max_header) {
+        struct curl_slist *header_list = ogs_realloc(handle->header_list,
+                num_of_header * sizeof(struct curl_slist));
+        if (!header_list) {
+            ogs_error("ogs_realloc() failed [%d]", num_of_header);
+            return OGS_ERROR;
+        }
+        handle->header_list = header_list;
+        handle->max_header = num_of_header;
+    }
+
+    if (size > handle->header_buf_size) {
+        char *header_buf = ogs_realloc(handle->header_buf, size);
+        if (!header_buf) {
+            ogs_error("ogs_realloc() failed [%d]", (int)size);
+            return OGS_ERROR;
+        }
+        handle->header_buf = header_buf;
+        handle->header_buf_size = size;
+    }
+
+    p = handle->header_buf;
+    for (hi = ogs_hash_first(headers), i = 0; hi; hi = ogs_hash_next(hi), i++) {
+        len = ogs_snprintf(p, handle->header_buf + size - p, "%s: %s",
+                (const char *)ogs_hash_this_key(hi),
+                (const char *)ogs_hash_this_val(hi));
+        handle->header_list[i].data = p;
+        handle->header_list[i].next = &handle->header_list[i+1];
+        p += len + 1;
+    }
+
+#if 1 /* Disable HTTP/1.1 100 Continue : Use "Expect:" in libcurl */
+    if (expect) {
+        handle->header_list[i].data = (char *)"Expect:";
+        i++;
+    }
+#endif
+
+    handle->header_list[i-1].next = NULL;
+
+    curl_easy_setopt(handle->easy, CURLOPT_HTTPHEADER, handle->header_list);
+
+    return OGS_OK;
+}
+
+static void connection_start(connection_t *conn)
+{
+    ogs_sbi_client_t *client = NULL;
+    CURLMcode rc;
+
+    ogs_assert(conn);
+    client = conn->client;
+    ogs_assert(client);
+
+    conn->queued = false;
+    ogs_list_add(&client->connection_list, conn);
+    client->num_of_inflight++;
+
+    ogs_assert(client->multi);
+    rc = curl_multi_add_handle(client->multi, conn->easy);
+    mcode_or_die("connection_start: curl_multi_add_handle", rc);
+}
+
 static connection_t *connection_add(
         ogs_sbi_client_t *client, ogs_sbi_client_cb_f client_cb,
         ogs_sbi_request_t *request, void *data)
 {
-    ogs_hash_index_t *hi;
-    int i;
     connection_t *conn = NULL;
-    CURLMcode rc;
+    bool expect = false;
 
     ogs_assert(client);
     ogs_assert(client_cb);
@@ -326,30 +447,6 @@ static connection_t *connection_add(
         return NULL;
     }
 
-    conn->num_of_header = ogs_hash_count(request->http.headers);
-    if (conn->num_of_header) {
-        conn->headers = ogs_calloc(conn->num_of_header, sizeof(char *));
-        if (!conn->headers) {
-            ogs_error("conn->headers is NULL");
-            connection_free(conn);
-            return NULL;
-        }
-        for (hi = ogs_hash_first(request->http.headers), i = 0;
-                hi && i < conn->num_of_header; hi = ogs_hash_next(hi), i++) {
-            const char *key = ogs_hash_this_key(hi);
-            char *val = ogs_hash_this_val(hi);
-
-            conn->headers[i] = ogs_msprintf("%s: %s", key, val);
-            if (!conn->headers[i]) {
-                ogs_error("conn->headers[i=%d] is NULL", i);
-                connection_free(conn);
-                return NULL;
-            }
-            conn->header_list = curl_slist_append(
-                    conn->header_list, conn->headers[i]);
-        }
-    }
-
     conn->timer = ogs_timer_add(
             ogs_app()->timer_mgr, connection_timer_expired, conn);
     if (!conn->timer) {
@@ -363,12 +460,14 @@ static connection_t *connection_add(
     ogs_timer_start(conn->timer,
             ogs_app()->time.message.sbi.connection_deadline);
 
-    conn->easy = curl_easy_init();
-    if (!conn->easy) {
-        ogs_error("conn->easy is NULL");
+    conn->handle = handle_get(client);
+    if (!conn->handle) {
+        ogs_error("handle_get() failed");
         connection_free(conn);
         return NULL;
     }
+    conn->easy = conn->handle->easy;
+    ogs_assert(conn->easy);
 
     if (ogs_hash_count(request->http.params)) {
         char *uri = add_params_to_uri(conn->easy,
@@ -384,6 +483,15 @@ static connection_t *connection_add(
 
     curl_easy_setopt(conn->easy, CURLOPT_BUFFERSIZE, OGS_MAX_SDU_LEN);
 
+    /* Wait for a multiplexed stream rather than opening a new connection */
+    curl_easy_setopt(conn->easy, CURLOPT_PIPEWAIT, 1L);
+    curl_easy_setopt(conn->easy, CURLOPT_TCP_KEEPALIVE, 1L);
+#if LIBCURL_VERSION_NUM >= 0x074100
+    if (ogs_app()->sbi.client.idle_timeout)
+        curl_easy_setopt(conn->easy, CURLOPT_MAXAGE_CONN,
+                (long)ogs_app()->sbi.client.idle_timeout);
+#endif
+
     if (ogs_app()->sbi.client.no_tls == false) {
         ogs_assert(ogs_app()->sbi.client.key);
         ogs_assert(ogs_app()->sbi.client.cert);
@@ -412,7 +520,11 @@ static connection_t *connection_add(
         curl_easy_setopt(conn->easy,
                 CURLOPT_CUSTOMREQUEST, request->h.method);
         if (request->http.content) {
-            conn->content = ogs_memdup(
+            if (request->move_content == true) {
+                conn->content = request->http.content;
+                request->http.content = NULL;
+            } else
+                conn->content = ogs_memdup(
                     request->http.content, request->http.content_length);
             if (!conn->content) {
                 ogs_error("conn->content is NULL");
@@ -423,27 +535,25 @@ static connection_t *connection_add(
                     CURLOPT_POSTFIELDS, conn->content);
             curl_easy_setopt(conn->easy,
                 CURLOPT_POSTFIELDSIZE, request->http.content_length);
-#if 1 /* Disable HTTP/1.1 100 Continue : Use "Expect:" in libcurl */
-            conn->header_list = curl_slist_append(
-                    conn->header_list, "Expect:");
-#else
-            curl_easy_setopt(conn->easy, CURLOPT_EXPECT_100_TIMEOUT_MS, 0L);
-#endif
+            expect = true;
             ogs_debug("SENDING...[%d]", (int)request->http.content_length);
             if (request->http.content_length)
-                ogs_debug("%s", request->http.content);
+                ogs_debug("%s", conn->content);
         }
     }
 
-    curl_easy_setopt(conn->easy, CURLOPT_HTTPHEADER, conn->header_list);
+    if (header_list_build(
+                conn->handle, request->http.headers, expect) != OGS_OK) {
+        ogs_error("header_list_build() failed");
+        connection_free(conn);
+        return NULL;
+    }
 
 #if 1 /* Use HTTP2 */
     curl_easy_setopt(conn->easy,
             CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE);
 #endif
 
-    ogs_list_add(&client->connection_list, conn);
-
     curl_easy_setopt(conn->easy, CURLOPT_URL, request->h.uri);
 
     curl_easy_setopt(conn->easy, CURLOPT_PRIVATE, conn);
@@ -453,9 +563,15 @@ static connection_t *connection_add(
     curl_easy_setopt(conn->easy, CURLOPT_HEADERDATA, conn);
     curl_easy_setopt(conn->easy, CURLOPT_ERRORBUFFER, conn->error);
 
-    ogs_assert(client->multi);
-    rc = curl_multi_add_handle(client->multi, conn->easy);
-    mcode_or_die("connection_add: curl_multi_add_handle", rc);
+    if (ogs_app()->sbi.client.max_inflight &&
+        client->num_of_inflight >= ogs_app()->sbi.client.max_inflight) {
+        /* The deadline timer is already running while queued */
+        conn->queued = true;
+        ogs_list_add(&client->pending_list, conn);
+        return conn;
+    }
+
+    connection_start(conn);
 
     return conn;
 }
@@ -463,23 +579,35 @@ static connection_t *connection_add(
 static void connection_remove(connection_t *conn)
 {
     ogs_sbi_client_t *client = NULL;
+    connection_t *next = NULL;
 
     ogs_assert(conn);
     client = conn->client;
     ogs_assert(client);
 
+    if (conn->queued == true) {
+        ogs_list_remove(&client->pending_list, conn);
+        connection_free(conn);
+        return;
+    }
+
     ogs_list_remove(&client->connection_list, conn);
+    client->num_of_inflight--;
 
     ogs_assert(client->multi);
     curl_multi_remove_handle(client->multi, conn->easy);
 
     connection_free(conn);
+
+    next = ogs_list_first(&client->pending_list);
+    if (next) {
+        ogs_list_remove(&client->pending_list, next);
+        connection_start(next);
+    }
 }
 
 static void connection_free(connection_t *conn)
 {
-    int i;
-
     ogs_assert(conn);
 
     if (conn->content)
@@ -493,20 +621,12 @@ static void connection_free(connection_t *conn)
     if (conn->memory)
         ogs_free(conn->memory);
 
-    if (conn->easy)
-        curl_easy_cleanup(conn->easy);
+    if (conn->handle)
+        handle_put(conn->client, conn->handle);
 
     if (conn->timer)
         ogs_timer_delete(conn->timer);
 
-    if (conn->num_of_header) {
-        for (i = 0; i < conn->num_of_header; i++)
-            if (conn->headers[i])
-                ogs_free(conn->headers[i]);
-        ogs_free(conn->headers);
-    }
-    curl_slist_free_all(conn->header_list);
-
     if (conn->method)
         ogs_free(conn->method);
 
@@ -519,10 +639,82 @@ static void connection_remove_all(ogs_sbi_client_t *client)
 
     ogs_assert(client);
 
+    /* Drop the queue first so that nothing is started while removing */
+    ogs_list_for_each_safe(&client->pending_list, next_conn, conn)
+        connection_remove(conn);
     ogs_list_for_each_safe(&client->connection_list, next_conn, conn)
         connection_remove(conn);
 }
 
+static handle_t *handle_get(ogs_sbi_client_t *client)
+{
+    handle_t *handle = NULL;
+
+    ogs_assert(client);
+
+    handle = ogs_list_first(&client->handle_list);
+    if (handle) {
+        ogs_list_remove(&client->handle_list, handle);
+        curl_easy_reset(handle->easy);
+        return handle;
+    }
+
+    handle = ogs_calloc(1, sizeof(handle_t));
+    if (!handle) {
+        ogs_error("ogs_calloc() failed");
+        return NULL;
+    }
+
+    handle->easy = curl_easy_init();
+    if (!handle->easy) {
+        ogs_error("curl_easy_init() failed");
+        ogs_free(handle);
+        return NULL;
+    }
+
+    return handle;
+}
+
+static void handle_put(ogs_sbi_client_t *client, handle_t *handle)
+{
+    ogs_assert(client);
+    ogs_assert(handle);
+
+    if (ogs_list_count(&client->handle_list) >= MAX_NUM_OF_IDLE_HANDLE) {
+        handle_free(handle);
+        return;
+    }
+
+    ogs_list_add(&client->handle_list, handle);
+}
+
+static void handle_free(handle_t *handle)
+{
+    ogs_assert(handle);
+
+    ogs_assert(handle->easy);
+    curl_easy_cleanup(handle->easy);
+
+    if (handle->header_list)
+        ogs_free(handle->header_list);
+    if (handle->header_buf)
+        ogs_free(handle->header_buf);
+
+    ogs_free(handle);
+}
+
+static void handle_remove_all(ogs_sbi_client_t *client)
+{
+    handle_t *handle = NULL, *next_handle = NULL;
+
+    ogs_assert(client);
+
+    ogs_list_for_each_safe(&client->handle_list, next_handle, handle) {
+        ogs_list_remove(&client->handle_list, handle);
+        handle_free(handle);
+    }
+}
+
 static void connection_timer_expired(void *data)
 {
     connection_t *conn = NULL;
@@ -604,9 +796,9 @@ static void check_multi_info(ogs_sbi_client_t *client)
                         response->status, response->h.method, response->h.uri);
 
                 if (conn->memory) {
-                    response->http.content =
-                        ogs_memdup(conn->memory, conn->size + 1);
-                    ogs_assert(response->http.content);
+                    /* Already NUL-terminated by write_cb() */
+                    response->http.content = conn->memory;
+                    conn->memory = NULL;
                     response->http.content_length = conn->size;
                     ogs_assert(response->http.content_length);
                 }
@@ -645,6 +837,7 @@ bool ogs_sbi_client_send_request(
         ogs_sbi_request_t *request, void *data)
 {
     connection_t *conn = NULL;
+    ogs_sbi_response_t *response = NULL;
 
     ogs_assert(client);
     ogs_assert(request);
@@ -655,6 +848,29 @@ bool ogs_sbi_client_send_request(
     }
     ogs_debug("[%s] %s", request->h.method, request->h.uri);
 
+    if (ogs_sbi_client_throttle(client) == true) {
+        ogs_warn("[%s] %s throttled by overload control [%d%%]",
+                request->h.method, request->h.uri,
+                client->overload.reduction);
+
+        /*
+         * Fail the request locally, as the overloaded NF itself would,
+         * so that the caller's response handler sees a 503.
+         */
+        response = ogs_sbi_response_new();
+        ogs_assert(response);
+        response->status = OGS_SBI_HTTP_STATUS_SERVICE_UNAVAILABLE;
+        response->h.method = ogs_strdup(request->h.method);
+        ogs_assert(response->h.method);
+        response->h.uri = ogs_strdup(request->h.uri);
+        ogs_assert(response->h.uri);
+
+        ogs_assert(client_cb);
+        client_cb(OGS_OK, response, data);
+
+        return true;
+    }
+
     conn = connection_add(client, client_cb, request, data);
     if (!conn) {
         ogs_error("connection_add() failed");
@@ -772,11 +988,114 @@ static size_t header_cb(void *ptr, size_t size, size_t nmemb, void *data)
             ogs_assert(conn->producer_id);
             conn->producer_id[len] = 0;
         }
+    } else if (ogs_strncasecmp(ptr,
+                OGS_SBI_CUSTOM_LCI, strlen(OGS_SBI_CUSTOM_LCI)) == 0) {
+        load_control_handle(conn->client, ptr, size * nmemb,
+                strlen(OGS_SBI_CUSTOM_LCI), false);
+    } else if (ogs_strncasecmp(ptr,
+                OGS_SBI_CUSTOM_OCI, strlen(OGS_SBI_CUSTOM_OCI)) == 0) {
+        load_control_handle(conn->client, ptr, size * nmemb,
+                strlen(OGS_SBI_CUSTOM_OCI), true);
     }
 
     return (nmemb*size);
 }
 
+bool ogs_sbi_client_is_overloaded(ogs_sbi_client_t *client)
+{
+    ogs_assert(client);
+
+    if (client->overload.reduction == 0)
+        return false;
+
+    if (ogs_get_monotonic_time() >= client->overload.expire) {
+        client->overload.reduction = 0;
+        client->overload.credit = 0;
+        return false;
+    }
+
+    return true;
+}
+
+bool ogs_sbi_client_throttle(ogs_sbi_client_t *client)
+{
+    ogs_assert(client);
+
+    if (ogs_sbi_client_is_overloaded(client) == false)
+        return false;
+
+    /* Drop Overload-Reduction-Metric percent, evenly spread */
+    client->overload.credit += client->overload.reduction;
+    if (client->overload.credit >= 100) {
+        client->overload.credit -= 100;
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * ptr : "3gpp-Sbi-Lci: Timestamp: "..."; Load-Metric: 50%; NF-Inst: ...\r\n"
+ *       "3gpp-Sbi-Oci: Timestamp: "..."; Period-of-Validity: 10s;
+ *                      Overload-Reduction-Metric: 20%; NF-Inst: ...\r\n"
+ */
+static void load_control_handle(ogs_sbi_client_t *client,
+        const char *ptr, size_t size, size_t offset, bool oci)
+{
+    ogs_sbi_nf_instance_t *nf_instance = NULL;
+    ogs_sbi_load_control_t load_control;
+    char buf[OGS_SBI_MAX_LOAD_CONTROL_LEN];
+
+    ogs_assert(client);
+    ogs_assert(ptr);
+
+    if (size <= offset || ptr[offset] != ':')
+        return;
+
+    ptr += offset + 1;
+    size -= offset + 1;
+    while (size && (*ptr == ' ' || *ptr == '\t')) {
+        ptr++;
+        size--;
+    }
+    while (size && (ptr[size-1] == '\r' || ptr[size-1] == '\n'))
+        size--;
+
+    if (size >= sizeof(buf)) {
+        ogs_error("Too long %s [%d]", oci ? "OCI" : "LCI", (int)size);
+        return;
+    }
+    memcpy(buf, ptr, size);
+    buf[size] = 0;
+
+    if (ogs_sbi_parse_load_control(&load_control, buf, oci) == false)
+        return;
+
+    if (load_control.nf_inst[0])
+        nf_instance = ogs_sbi_nf_instance_find(load_control.nf_inst);
+
+    if (oci == false) {
+        if (nf_instance)
+            nf_instance->load = load_control.load;
+        return;
+    }
+
+    /* Throttle the overloaded NF rather than the SCP relaying it */
+    if (nf_instance && NF_INSTANCE_CLIENT(nf_instance))
+        client = NF_INSTANCE_CLIENT(nf_instance);
+
+    if (load_control.reduction != client->overload.reduction)
+        ogs_warn("[%s] Overload-Reduction-Metric [%d%%] for %ds",
+                nf_instance ? nf_instance->id : "unknown",
+                load_control.reduction, load_control.validity);
+
+    client->overload.reduction = load_control.reduction;
+    client->overload.expire = ogs_get_monotonic_time() +
+        ogs_time_from_sec(load_control.validity);
+    if (load_control.reduction == 0)
+        client->overload.credit = 0;
+}
+
 static void event_cb(short when, ogs_socket_t fd, void *data)
 {
     sockinfo_t *sockinfo = NULL;
@@ -60,6 +60,16 @@ typedef struct ogs_sbi_client_s {
 
     ogs_timer_t     *t_curl;            /* timer for CURL */
     ogs_list_t      connection_list;    /* CURL connection list */
+    ogs_list_t      pending_list;       /* queued over max_inflight */
+    int             num_of_inflight;    /* number of connection_list */
+
+    ogs_list_t      handle_list;        /* recycled CURL easy handles */
+
+    struct {
+        int         reduction;          /* OCI Overload-Reduction-Metric */
+        ogs_time_t  expire;             /* OCI Period-of-Validity */
+        int         credit;             /* spreads the dropped requests */
+    } overload;
 
     void            *multi;             /* CURL multi handle */
     int             still_running;      /* number of running CURL handle */
@@ -82,6 +92,10 @@ ogs_sbi_client_t *ogs_sbi_client_find(
 void ogs_sbi_client_stop(ogs_sbi_client_t *client);
 void ogs_sbi_client_stop_all(void);
 
+bool ogs_sbi_client_is_overloaded(ogs_sbi_client_t *client);
+bool ogs_sbi_client_throttle(ogs_sbi_client_t *client);
+
+/* A throttled request is answered locally with 503 through client_cb */
 bool ogs_sbi_client_send_request(
         ogs_sbi_client_t *client, ogs_sbi_client_cb_f client_cb,
         ogs_sbi_request_t *request, void *data);
@@ -967,21 +967,41 @@ ogs_sbi_nf_instance_t *ogs_sbi_nf_instance_find_by_discovery_param(
         OpenAPI_nf_type_e requester_nf_type,
         ogs_sbi_discovery_option_t *discovery_option)
 {
-    ogs_sbi_nf_instance_t *nf_instance = NULL;
+    ogs_sbi_nf_instance_t *nf_instance = NULL, *selected = NULL;
+    int load, selected_load = 0;
 
     ogs_assert(target_nf_type);
     ogs_assert(requester_nf_type);
 
+    /* Prefer the least loaded instance, keeping list order on a tie */
     ogs_list_for_each(&ogs_sbi_self()->nf_instance_list, nf_instance) {
         if (ogs_sbi_discovery_param_is_matched(
                     nf_instance, target_nf_type, requester_nf_type,
                     discovery_option) == false)
             continue;
 
-        return nf_instance;
+        load = ogs_sbi_nf_instance_load(nf_instance);
+        if (!selected || load < selected_load) {
+            selected = nf_instance;
+            selected_load = load;
+        }
     }
 
-    return NULL;
+    return selected;
+}
+
+int ogs_sbi_nf_instance_load(ogs_sbi_nf_instance_t *nf_instance)
+{
+    ogs_sbi_client_t *client = NULL;
+
+    ogs_assert(nf_instance);
+
+    /* An instance under overload control ranks after any other */
+    client = NF_INSTANCE_CLIENT(nf_instance);
+    if (client && ogs_sbi_client_is_overloaded(client) == true)
+        return OGS_SBI_MAX_LOAD + client->overload.reduction;
+
+    return nf_instance->load;
 }
 
 ogs_sbi_nf_instance_t *ogs_sbi_nf_instance_find_by_service_type(
@@ -76,6 +76,13 @@ typedef struct ogs_sbi_context_s {
 
     int num_of_service_name;
     const char *service_name[OGS_SBI_MAX_NUM_OF_SERVICE_TYPE];
+
+    struct {
+        ogs_time_t latency;             /* Request processing EWMA */
+        int load;                       /* Last published Load-Metric */
+        ogs_time_t lci_time;            /* Last published LCI */
+        ogs_time_t oci_expire;          /* Validity of the last OCI */
+    } load_control;
 } ogs_sbi_context_t;
 
 typedef struct ogs_sbi_nf_instance_s {
@@ -140,6 +147,7 @@ typedef struct ogs_sbi_nf_instance_s {
 #define OGS_SBI_DEFAULT_PRIORITY 0
 #define OGS_SBI_DEFAULT_CAPACITY 100
 #define OGS_SBI_DEFAULT_LOAD 0
+#define OGS_SBI_MAX_LOAD 100
     int priority;
     int capacity;
     int load;
@@ -375,6 +383,7 @@ ogs_sbi_nf_instance_t *ogs_sbi_nf_instance_find_by_discovery_param(
 ogs_sbi_nf_instance_t *ogs_sbi_nf_instance_find_by_service_type(
         ogs_sbi_service_type_e service_type,
         OpenAPI_nf_type_e requester_nf_type);
+int ogs_sbi_nf_instance_load(ogs_sbi_nf_instance_t *nf_instance);
 bool ogs_sbi_nf_instance_maximum_number_is_reached(void);
 
 ogs_sbi_nf_service_t *ogs_sbi_nf_service_add(
@@ -158,17 +158,20 @@ char *ogs_supi_from_suci(char *suci)
 
                     if (protection_scheme_id ==
                             OGS_PROTECTION_SCHEME_PROFILE_A) {
-                        curve25519_donna(z,
-                            ogs_sbi_self()->hnet[home_network_pki_value].key,
-                            pubkey.data);
+                        if (ogs_ecdh_x25519(z,
+                                ogs_sbi_self()->
+                                    hnet[home_network_pki_value].key,
+                                pubkey.data) != OGS_OK) {
+                            ogs_error("ogs_ecdh_x25519() failed");
+                            goto cleanup;
+                        }
                     } else if (protection_scheme_id ==
                             OGS_PROTECTION_SCHEME_PROFILE_B) {
-                        if (ecdh_shared_secret(
-                                pubkey.data,
+                        if (ogs_ecdh_p256(z,
                                 ogs_sbi_self()->
                                     hnet[home_network_pki_value].key,
-                                z) != 1) {
-                            ogs_error("ecdh_shared_secret() failed");
+                                pubkey.data) != OGS_OK) {
+                            ogs_error("ogs_ecdh_p256() failed");
                             ogs_log_hexdump(OGS_LOG_ERROR,
                                     pubkey.data, OGS_ECCKEY_LEN);
                             ogs_log_hexdump(OGS_LOG_ERROR,
@@ -772,6 +775,168 @@ int ogs_sbi_rfc7231_string(char *date_str, ogs_time_t time)
     return OGS_OK;
 }
 
+static bool load_control_value(const char *value, char unit,
+        int max_digits, int max, int *result)
+{
+    const char *p = value;
+    int v = 0;
+
+    while (*p >= '0' && *p <= '9') {
+        if (p - value == max_digits)
+            return false;
+        v = v * 10 + (*p - '0');
+        p++;
+    }
+
+    if (p == value || *p++ != unit || *p != 0 || v > max)
+        return false;
+
+    *result = v;
+    return true;
+}
+
+#define LOAD_CONTROL_WSP(c) ((c) == ' ' || (c) == '\t')
+
+bool ogs_sbi_parse_load_control(
+        ogs_sbi_load_control_t *load_control, const char *str, bool oci)
+{
+    char buf[OGS_SBI_MAX_LOAD_CONTROL_LEN];
+    char *p = NULL, *name = NULL, *value = NULL, *end = NULL;
+    char sep;
+    bool timestamp = false;
+    ogs_uuid_t uuid;
+
+    ogs_assert(load_control);
+    ogs_assert(str);
+
+    load_control->load = -1;
+    load_control->reduction = -1;
+    load_control->validity = -1;
+    load_control->nf_inst[0] = 0;
+
+    if (strlen(str) >= sizeof(buf)) {
+        ogs_error("Too long [%s]", str);
+        return false;
+    }
+    ogs_cpystrn(buf, str, sizeof(buf));
+
+    /* param *( ";" param ), param = name ":" 1*WSP value */
+    p = buf;
+    while (LOAD_CONTROL_WSP(*p)) p++;
+    while (*p) {
+        name = p;
+        while (*p && *p != ':' && *p != ';' && !LOAD_CONTROL_WSP(*p)) p++;
+        if (p == name || *p != ':') goto invalid;
+        *p++ = 0;
+
+        if (!LOAD_CONTROL_WSP(*p)) goto invalid;
+        while (LOAD_CONTROL_WSP(*p)) p++;
+
+        value = p;
+        if (*p == '"') {
+            p = strchr(p + 1, '"');
+            if (!p) goto invalid;
+            p++;
+        } else {
+            while (*p && *p != ';' && !LOAD_CONTROL_WSP(*p)) p++;
+        }
+        if (p == value) goto invalid;
+
+        end = p;
+        while (LOAD_CONTROL_WSP(*p)) p++;
+        sep = *p;
+        if (sep == ';') {
+            p++;
+            while (LOAD_CONTROL_WSP(*p)) p++;
+            if (!*p) goto invalid;
+        } else if (sep) {
+            goto invalid;
+        }
+        *end = 0;
+
+        if (!strcmp(name, "Timestamp")) {
+            /* HTTP-date, with or without milliseconds */
+            if (timestamp || *value != '"' || end - value < 3) goto invalid;
+            timestamp = true;
+        } else if (!strcmp(name, "Load-Metric")) {
+            if (load_control->load >= 0 ||
+                !load_control_value(value, '%', 3, 100, &load_control->load))
+                goto invalid;
+        } else if (!strcmp(name, "Overload-Reduction-Metric")) {
+            if (load_control->reduction >= 0 ||
+                !load_control_value(value, '%', 3, 100,
+                    &load_control->reduction))
+                goto invalid;
+        } else if (!strcmp(name, "Period-of-Validity")) {
+            if (load_control->validity >= 0 ||
+                !load_control_value(value, 's', 9, INT32_MAX,
+                    &load_control->validity))
+                goto invalid;
+        } else if (!strcmp(name, "NF-Inst")) {
+            if (load_control->nf_inst[0] ||
+                strlen(value) != OGS_UUID_FORMATTED_LENGTH ||
+                ogs_uuid_parse(&uuid, value) != OGS_OK)
+                goto invalid;
+            ogs_cpystrn(load_control->nf_inst, value,
+                    sizeof(load_control->nf_inst));
+        }
+        /* Other scopes (NF-Set, S-NSSAI, DNN, ...) are ignored */
+    }
+
+    if (timestamp == false)
+        goto invalid;
+
+    if (oci == false && load_control->load < 0)
+        goto invalid;
+
+    if (oci == true &&
+        (load_control->reduction < 0 || load_control->validity < 0))
+        goto invalid;
+
+    return true;
+
+invalid:
+    ogs_error("Invalid %s [%s]", oci ? "OCI" : "LCI", str);
+    return false;
+}
+
+bool ogs_sbi_build_load_control(char *str, size_t size,
+        ogs_sbi_load_control_t *load_control, ogs_time_t timestamp, bool oci)
+{
+    char date[OGS_SBI_RFC7231_DATE_LEN];
+    const char *nf_inst = NULL;
+    int n;
+
+    ogs_assert(str);
+    ogs_assert(load_control);
+
+    ogs_assert(ogs_sbi_rfc7231_string(date, timestamp) == OGS_OK);
+    nf_inst = load_control->nf_inst[0] ? "; NF-Inst: " : "";
+
+    if (oci == false) {
+        ogs_assert(load_control->load >= 0 && load_control->load <= 100);
+        n = ogs_snprintf(str, size,
+                "Timestamp: \"%s\"; Load-Metric: %d%%%s%s",
+                date, load_control->load, nf_inst, load_control->nf_inst);
+    } else {
+        ogs_assert(load_control->reduction >= 0 &&
+                load_control->reduction <= 100);
+        ogs_assert(load_control->validity >= 0);
+        n = ogs_snprintf(str, size,
+                "Timestamp: \"%s\"; Period-of-Validity: %ds; "
+                "Overload-Reduction-Metric: %d%%%s%s",
+                date, load_control->validity, load_control->reduction,
+                nf_inst, load_control->nf_inst);
+    }
+
+    if (n < 0 || n >= size) {
+        ogs_error("Too short buffer [%d]", (int)size);
+        return false;
+    }
+
+    return true;
+}
+
 char *ogs_sbi_s_nssai_to_json(ogs_s_nssai_t *s_nssai)
 {
     cJSON *item = NULL;
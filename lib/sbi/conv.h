@@ -63,6 +63,28 @@ bool ogs_sbi_time_from_string(ogs_time_t *time, char *str);
 #define OGS_SBI_RFC7231_DATE_LEN (34)
 int ogs_sbi_rfc7231_string(char *date_str, ogs_time_t time);
 
+/*
+ * 3gpp-Sbi-Lci / 3gpp-Sbi-Oci (TS29.500 5.2.3.2.17 and 5.2.3.2.18)
+ *
+ * Timestamp: "Sun, 04 Aug 2019 08:49:37.845 GMT"; Load-Metric: 50%;
+ *      NF-Inst: 0cb58eca-4e84-41ed-aa10-9f892634b770
+ * Timestamp: "Sun, 04 Aug 2019 08:49:37.845 GMT"; Period-of-Validity: 10s;
+ *      Overload-Reduction-Metric: 20%; NF-Inst: ...
+ */
+#define OGS_SBI_MAX_LOAD_CONTROL_LEN 256
+
+typedef struct ogs_sbi_load_control_s {
+    int load;                   /* LCI Load-Metric, -1 if absent */
+    int reduction;              /* OCI Overload-Reduction-Metric, -1 if absent */
+    int validity;               /* OCI Period-of-Validity(sec), -1 if absent */
+    char nf_inst[OGS_UUID_FORMATTED_LENGTH + 1];    /* Empty if absent */
+} ogs_sbi_load_control_t;
+
+bool ogs_sbi_parse_load_control(
+        ogs_sbi_load_control_t *load_control, const char *str, bool oci);
+bool ogs_sbi_build_load_control(char *str, size_t size,
+        ogs_sbi_load_control_t *load_control, ogs_time_t timestamp, bool oci);
+
 char *ogs_sbi_s_nssai_to_json(ogs_s_nssai_t *s_nssai);
 bool ogs_sbi_s_nssai_from_json(ogs_s_nssai_t *s_nssai, char *str);
 
@@ -25,6 +25,12 @@
 static OGS_POOL(request_pool, ogs_sbi_request_t);
 static OGS_POOL(response_pool, ogs_sbi_response_t);
 
+/*
+ * Requests and responses are allocated by the nghttp2 I/O threads
+ * (sbi.server.io_thread) and released by the NF thread, or vice versa.
+ */
+static ogs_thread_mutex_t pool_mutex;
+
 static char *build_json(ogs_sbi_message_t *message);
 static int parse_json(ogs_sbi_message_t *message,
         char *content_type, char *json);
@@ -41,16 +47,190 @@ static int parse_multipart(
 
 static void http_message_free(ogs_sbi_http_message_t *http);
 
+typedef struct route_desc_s {
+    const char *name;
+    int id;
+} route_desc_t;
+
+/*
+ * Sorted by name for bsearch(), which route_check() asserts at init.
+ * Keep the order when adding an entry.
+ */
+static const route_desc_t service_desc[] = {
+    { OGS_SBI_SERVICE_NAME_N5G_EIR_EIC, OGS_SBI_SERVICE_TYPE_N5G_EIR_EIC },
+    { OGS_SBI_SERVICE_NAME_NAMF_CALLBACK, OGS_SBI_SERVICE_TYPE_NAMF_CALLBACK },
+    { OGS_SBI_SERVICE_NAME_NAMF_COMM, OGS_SBI_SERVICE_TYPE_NAMF_COMM },
+    { OGS_SBI_SERVICE_NAME_NAMF_EVTS, OGS_SBI_SERVICE_TYPE_NAMF_EVTS },
+    { OGS_SBI_SERVICE_NAME_NAMF_LOC, OGS_SBI_SERVICE_TYPE_NAMF_LOC },
+    { OGS_SBI_SERVICE_NAME_NAMF_MT, OGS_SBI_SERVICE_TYPE_NAMF_MT },
+    { OGS_SBI_SERVICE_NAME_NAUSF_AUTH, OGS_SBI_SERVICE_TYPE_NAUSF_AUTH },
+    { OGS_SBI_SERVICE_NAME_NAUSF_SORPROTECTION,
+        OGS_SBI_SERVICE_TYPE_NAUSF_SORPROTECTION },
+    { OGS_SBI_SERVICE_NAME_NAUSF_UPUPROTECTION,
+        OGS_SBI_SERVICE_TYPE_NAUSF_UPUPROTECTION },
+    { OGS_SBI_SERVICE_NAME_NBSF_MANAGEMENT,
+        OGS_SBI_SERVICE_TYPE_NBSF_MANAGEMENT },
+    { OGS_SBI_SERVICE_NAME_NCHF_CONVERGEDCHARGING,
+        OGS_SBI_SERVICE_TYPE_NCHF_CONVERGEDCHARGING },
+    { OGS_SBI_SERVICE_NAME_NCHF_OFFLINEONLYCHARGING,
+        OGS_SBI_SERVICE_TYPE_NCHF_OFFLINEONLYCHARGING },
+    { OGS_SBI_SERVICE_NAME_NCHF_SPENDINGLIMITCONTROL,
+        OGS_SBI_SERVICE_TYPE_NCHF_SPENDINGLIMITCONTROL },
+    { OGS_SBI_SERVICE_NAME_NGMLC_LOC, OGS_SBI_SERVICE_TYPE_NGMLC_LOC },
+    { OGS_SBI_SERVICE_NAME_NHSS_EE, OGS_SBI_SERVICE_TYPE_NHSS_EE },
+    { OGS_SBI_SERVICE_NAME_NHSS_IMS_SDM, OGS_SBI_SERVICE_TYPE_NHSS_IMS_SDM },
+    { OGS_SBI_SERVICE_NAME_NHSS_IMS_UEAU, OGS_SBI_SERVICE_TYPE_NHSS_IMS_UEAU },
+    { OGS_SBI_SERVICE_NAME_NHSS_IMS_UECM, OGS_SBI_SERVICE_TYPE_NHSS_IMS_UECM },
+    { OGS_SBI_SERVICE_NAME_NHSS_SDM, OGS_SBI_SERVICE_TYPE_NHSS_SDM },
+    { OGS_SBI_SERVICE_NAME_NHSS_UEAU, OGS_SBI_SERVICE_TYPE_NHSS_UEAU },
+    { OGS_SBI_SERVICE_NAME_NHSS_UECM, OGS_SBI_SERVICE_TYPE_NHSS_UECM },
+    { OGS_SBI_SERVICE_NAME_NLMF_LOC, OGS_SBI_SERVICE_TYPE_NLMF_LOC },
+    { OGS_SBI_SERVICE_NAME_NNEF_EVENTEXPOSURE,
+        OGS_SBI_SERVICE_TYPE_NNEF_EVENTEXPOSURE },
+    { OGS_SBI_SERVICE_NAME_NNEF_PFDMANAGEMENT,
+        OGS_SBI_SERVICE_TYPE_NNEF_PFDMANAGEMENT },
+    { OGS_SBI_SERVICE_NAME_NNEF_SMCONTEXT,
+        OGS_SBI_SERVICE_TYPE_NNEF_SMCONTEXT },
+    { OGS_SBI_SERVICE_NAME_NNRF_DISC, OGS_SBI_SERVICE_TYPE_NNRF_DISC },
+    { OGS_SBI_SERVICE_NAME_NNRF_NFM, OGS_SBI_SERVICE_TYPE_NNRF_NFM },
+    { OGS_SBI_SERVICE_NAME_NNRF_OAUTH2, OGS_SBI_SERVICE_TYPE_NNRF_OAUTH2 },
+    { OGS_SBI_SERVICE_NAME_NNSSAAF_NSSAA, OGS_SBI_SERVICE_TYPE_NNSSAAF_NSSAA },
+    { OGS_SBI_SERVICE_NAME_NNSSF_NSSAIAVAILABILITY,
+        OGS_SBI_SERVICE_TYPE_NNSSF_NSSAIAVAILABILITY },
+    { OGS_SBI_SERVICE_NAME_NNSSF_NSSELECTION,
+        OGS_SBI_SERVICE_TYPE_NNSSF_NSSELECTION },
+    { OGS_SBI_SERVICE_NAME_NNWDAF_ANALYTICSINFO,
+        OGS_SBI_SERVICE_TYPE_NNWDAF_ANALYTICSINFO },
+    { OGS_SBI_SERVICE_NAME_NNWDAF_EVENTSSUBSCRIPTION,
+        OGS_SBI_SERVICE_TYPE_NNWDAF_EVENTSSUBSCRIPTION },
+    { OGS_SBI_SERVICE_NAME_NPCF_AM_POLICY_CONTROL,
+        OGS_SBI_SERVICE_TYPE_NPCF_AM_POLICY_CONTROL },
+    { OGS_SBI_SERVICE_NAME_NPCF_BDTPOLICYCONTROL,
+        OGS_SBI_SERVICE_TYPE_NPCF_BDTPOLICYCONTROL },
+    { OGS_SBI_SERVICE_NAME_NPCF_EVENTEXPOSURE,
+        OGS_SBI_SERVICE_TYPE_NPCF_EVENTEXPOSURE },
+    { OGS_SBI_SERVICE_NAME_NPCF_POLICYAUTHORIZATION,
+        OGS_SBI_SERVICE_TYPE_NPCF_POLICYAUTHORIZATION },
+    { OGS_SBI_SERVICE_NAME_NPCF_SMPOLICYCONTROL,
+        OGS_SBI_SERVICE_TYPE_NPCF_SMPOLICYCONTROL },
+    { OGS_SBI_SERVICE_NAME_NPCF_UE_POLICY_CONTROL,
+        OGS_SBI_SERVICE_TYPE_NPCF_UE_POLICY_CONTROL },
+    { OGS_SBI_SERVICE_NAME_NSEPP_TELESCOPIC,
+        OGS_SBI_SERVICE_TYPE_NSEPP_TELESCOPIC },
+    { OGS_SBI_SERVICE_NAME_NSMF_CALLBACK, OGS_SBI_SERVICE_TYPE_NSMF_CALLBACK },
+    { OGS_SBI_SERVICE_NAME_NSMF_EVENT_EXPOSURE,
+        OGS_SBI_SERVICE_TYPE_NSMF_EVENT_EXPOSURE },
+    { OGS_SBI_SERVICE_NAME_NSMF_NIDD, OGS_SBI_SERVICE_TYPE_NSMF_NIDD },
+    { OGS_SBI_SERVICE_NAME_NSMF_PDUSESSION,
+        OGS_SBI_SERVICE_TYPE_NSMF_PDUSESSION },
+    { OGS_SBI_SERVICE_NAME_NSMSF_SMS, OGS_SBI_SERVICE_TYPE_NSMSF_SMS },
+    { OGS_SBI_SERVICE_NAME_NSORAF_SOR, OGS_SBI_SERVICE_TYPE_NSORAF_SOR },
+    { OGS_SBI_SERVICE_NAME_NSPAF_SECURED_PACKET,
+        OGS_SBI_SERVICE_TYPE_NSPAF_SECURED_PACKET },
+    { OGS_SBI_SERVICE_NAME_NUCMF_PROVISIONING,
+        OGS_SBI_SERVICE_TYPE_NUCMF_PROVISIONING },
+    { OGS_SBI_SERVICE_NAME_NUCMF_UECAPABILITYMANAGEMENT,
+        OGS_SBI_SERVICE_TYPE_NUCMF_UECAPABILITYMANAGEMENT },
+    { OGS_SBI_SERVICE_NAME_NUDM_EE, OGS_SBI_SERVICE_TYPE_NUDM_EE },
+    { OGS_SBI_SERVICE_NAME_NUDM_MT, OGS_SBI_SERVICE_TYPE_NUDM_MT },
+    { OGS_SBI_SERVICE_NAME_NUDM_NIDDAU, OGS_SBI_SERVICE_TYPE_NUDM_NIDDAU },
+    { OGS_SBI_SERVICE_NAME_NUDM_PP, OGS_SBI_SERVICE_TYPE_NUDM_PP },
+    { OGS_SBI_SERVICE_NAME_NUDM_SDM, OGS_SBI_SERVICE_TYPE_NUDM_SDM },
+    { OGS_SBI_SERVICE_NAME_NUDM_UEAU, OGS_SBI_SERVICE_TYPE_NUDM_UEAU },
+    { OGS_SBI_SERVICE_NAME_NUDM_UECM, OGS_SBI_SERVICE_TYPE_NUDM_UECM },
+    { OGS_SBI_SERVICE_NAME_NUDR_DR, OGS_SBI_SERVICE_TYPE_NUDR_DR },
+    { OGS_SBI_SERVICE_NAME_NUDR_GROUP_ID_MAP,
+        OGS_SBI_SERVICE_TYPE_NUDR_GROUP_ID_MAP },
+    { OGS_SBI_SERVICE_NAME_NUDSF_DR, OGS_SBI_SERVICE_TYPE_NUDSF_DR },
+};
+
+static const route_desc_t resource_desc[] = {
+    { OGS_SBI_RESOURCE_NAME_5G_AKA, OGS_SBI_RESOURCE_5G_AKA },
+    { OGS_SBI_RESOURCE_NAME_5G_AKA_CONFIRMATION,
+        OGS_SBI_RESOURCE_5G_AKA_CONFIRMATION },
+    { OGS_SBI_RESOURCE_NAME_AM_DATA, OGS_SBI_RESOURCE_AM_DATA },
+    { OGS_SBI_RESOURCE_NAME_AM_POLICY_NOTIFY,
+        OGS_SBI_RESOURCE_AM_POLICY_NOTIFY },
+    { OGS_SBI_RESOURCE_NAME_AMF_3GPP_ACCESS, OGS_SBI_RESOURCE_AMF_3GPP_ACCESS },
+    { OGS_SBI_RESOURCE_NAME_APP_SESSIONS, OGS_SBI_RESOURCE_APP_SESSIONS },
+    { OGS_SBI_RESOURCE_NAME_AUTH_EVENTS, OGS_SBI_RESOURCE_AUTH_EVENTS },
+    { OGS_SBI_RESOURCE_NAME_AUTHENTICATION_DATA,
+        OGS_SBI_RESOURCE_AUTHENTICATION_DATA },
+    { OGS_SBI_RESOURCE_NAME_AUTHENTICATION_STATUS,
+        OGS_SBI_RESOURCE_AUTHENTICATION_STATUS },
+    { OGS_SBI_RESOURCE_NAME_AUTHENTICATION_SUBSCRIPTION,
+        OGS_SBI_RESOURCE_AUTHENTICATION_SUBSCRIPTION },
+    { OGS_SBI_RESOURCE_NAME_CONTEXT_DATA, OGS_SBI_RESOURCE_CONTEXT_DATA },
+    { OGS_SBI_RESOURCE_NAME_DELETE, OGS_SBI_RESOURCE_DELETE },
+    { OGS_SBI_RESOURCE_NAME_DEREG_NOTIFY, OGS_SBI_RESOURCE_DEREG_NOTIFY },
+    { OGS_SBI_RESOURCE_NAME_EAP_SESSION, OGS_SBI_RESOURCE_EAP_SESSION },
+    { OGS_SBI_RESOURCE_NAME_GENERATE_AUTH_DATA,
+        OGS_SBI_RESOURCE_GENERATE_AUTH_DATA },
+    { OGS_SBI_RESOURCE_NAME_MODIFY, OGS_SBI_RESOURCE_MODIFY },
+    { OGS_SBI_RESOURCE_NAME_N1_N2_FAILURE_NOTIFY,
+        OGS_SBI_RESOURCE_N1_N2_FAILURE_NOTIFY },
+    { OGS_SBI_RESOURCE_NAME_N1_N2_MESSAGES, OGS_SBI_RESOURCE_N1_N2_MESSAGES },
+    { OGS_SBI_RESOURCE_NAME_NETWORK_SLICE_INFORMATION,
+        OGS_SBI_RESOURCE_NETWORK_SLICE_INFORMATION },
+    { OGS_SBI_RESOURCE_NAME_NF_INSTANCES, OGS_SBI_RESOURCE_NF_INSTANCES },
+    { OGS_SBI_RESOURCE_NAME_NF_STATUS_NOTIFY,
+        OGS_SBI_RESOURCE_NF_STATUS_NOTIFY },
+    { OGS_SBI_RESOURCE_NAME_NOTIFY, OGS_SBI_RESOURCE_NOTIFY },
+    { OGS_SBI_RESOURCE_NAME_PCF_BINDINGS, OGS_SBI_RESOURCE_PCF_BINDINGS },
+    { OGS_SBI_RESOURCE_NAME_POLICIES, OGS_SBI_RESOURCE_POLICIES },
+    { OGS_SBI_RESOURCE_NAME_POLICY_DATA, OGS_SBI_RESOURCE_POLICY_DATA },
+    { OGS_SBI_RESOURCE_NAME_PROVISIONED_DATA,
+        OGS_SBI_RESOURCE_PROVISIONED_DATA },
+    { OGS_SBI_RESOURCE_NAME_REGISTRATIONS, OGS_SBI_RESOURCE_REGISTRATIONS },
+    { OGS_SBI_RESOURCE_NAME_RELEASE, OGS_SBI_RESOURCE_RELEASE },
+    { OGS_SBI_RESOURCE_NAME_SDM_SUBSCRIPTIONS,
+        OGS_SBI_RESOURCE_SDM_SUBSCRIPTIONS },
+    { OGS_SBI_RESOURCE_NAME_SDMSUBSCRIPTION_NOTIFY,
+        OGS_SBI_RESOURCE_SDMSUBSCRIPTION_NOTIFY },
+    { OGS_SBI_RESOURCE_NAME_SECURITY_INFORMATION,
+        OGS_SBI_RESOURCE_SECURITY_INFORMATION },
+    { OGS_SBI_RESOURCE_NAME_SM_CONTEXT_STATUS,
+        OGS_SBI_RESOURCE_SM_CONTEXT_STATUS },
+    { OGS_SBI_RESOURCE_NAME_SM_CONTEXTS, OGS_SBI_RESOURCE_SM_CONTEXTS },
+    { OGS_SBI_RESOURCE_NAME_SM_DATA, OGS_SBI_RESOURCE_SM_DATA },
+    { OGS_SBI_RESOURCE_NAME_SM_POLICIES, OGS_SBI_RESOURCE_SM_POLICIES },
+    { OGS_SBI_RESOURCE_NAME_SM_POLICY_NOTIFY,
+        OGS_SBI_RESOURCE_SM_POLICY_NOTIFY },
+    { OGS_SBI_RESOURCE_NAME_SMF_SELECT_DATA, OGS_SBI_RESOURCE_SMF_SELECT_DATA },
+    { OGS_SBI_RESOURCE_NAME_SMF_SELECTION_SUBSCRIPTION_DATA,
+        OGS_SBI_RESOURCE_SMF_SELECTION_SUBSCRIPTION_DATA },
+    { OGS_SBI_RESOURCE_NAME_SUBSCRIPTION_DATA,
+        OGS_SBI_RESOURCE_SUBSCRIPTION_DATA },
+    { OGS_SBI_RESOURCE_NAME_SUBSCRIPTIONS, OGS_SBI_RESOURCE_SUBSCRIPTIONS },
+    { OGS_SBI_RESOURCE_NAME_TERMINATE, OGS_SBI_RESOURCE_TERMINATE },
+    { OGS_SBI_RESOURCE_NAME_UE_AUTHENTICATIONS,
+        OGS_SBI_RESOURCE_UE_AUTHENTICATIONS },
+    { OGS_SBI_RESOURCE_NAME_UE_CONTEXT_IN_SMF_DATA,
+        OGS_SBI_RESOURCE_UE_CONTEXT_IN_SMF_DATA },
+    { OGS_SBI_RESOURCE_NAME_UE_CONTEXTS, OGS_SBI_RESOURCE_UE_CONTEXTS },
+    { OGS_SBI_RESOURCE_NAME_UES, OGS_SBI_RESOURCE_UES },
+    { OGS_SBI_RESOURCE_NAME_UPDATE, OGS_SBI_RESOURCE_UPDATE },
+};
+
+static void route_check(const route_desc_t *desc, size_t num);
+
 void ogs_sbi_message_init(int num_of_request_pool, int num_of_response_pool)
 {
+    ogs_thread_mutex_init(&pool_mutex);
+
     ogs_pool_init(&request_pool, num_of_request_pool);
     ogs_pool_init(&response_pool, num_of_response_pool);
+
+    route_check(service_desc, OGS_ARRAY_SIZE(service_desc));
+    route_check(resource_desc, OGS_ARRAY_SIZE(resource_desc));
 }
 
 void ogs_sbi_message_final(void)
 {
     ogs_pool_final(&request_pool);
     ogs_pool_final(&response_pool);
+
+    ogs_thread_mutex_destroy(&pool_mutex);
 }
 
 void ogs_sbi_message_free(ogs_sbi_message_t *message)
@@ -195,7 +375,9 @@ ogs_sbi_request_t *ogs_sbi_request_new(void)
 {
     ogs_sbi_request_t *request = NULL;
 
+    ogs_thread_mutex_lock(&pool_mutex);
     ogs_pool_alloc(&request_pool, &request);
+    ogs_thread_mutex_unlock(&pool_mutex);
     if (!request) {
         ogs_error("ogs_pool_alloc() failed");
         return NULL;
@@ -222,7 +404,9 @@ ogs_sbi_response_t *ogs_sbi_response_new(void)
 {
     ogs_sbi_response_t *response = NULL;
 
+    ogs_thread_mutex_lock(&pool_mutex);
     ogs_pool_alloc(&response_pool, &response);
+    ogs_thread_mutex_unlock(&pool_mutex);
     if (!response) {
         ogs_error("ogs_pool_alloc() failed");
         return NULL;
@@ -255,7 +439,9 @@ void ogs_sbi_request_free(ogs_sbi_request_t *request)
     ogs_sbi_header_free(&request->h);
     http_message_free(&request->http);
 
+    ogs_thread_mutex_lock(&pool_mutex);
     ogs_pool_free(&request_pool, request);
+    ogs_thread_mutex_unlock(&pool_mutex);
 }
 
 void ogs_sbi_response_free(ogs_sbi_response_t *response)
@@ -268,7 +454,9 @@ void ogs_sbi_response_free(ogs_sbi_response_t *response)
     ogs_sbi_header_free(&response->h);
     http_message_free(&response->http);
 
+    ogs_thread_mutex_lock(&pool_mutex);
     ogs_pool_free(&response_pool, response);
+    ogs_thread_mutex_unlock(&pool_mutex);
 }
 
 ogs_sbi_request_t *ogs_sbi_build_request(ogs_sbi_message_t *message)
@@ -946,6 +1134,92 @@ int ogs_sbi_parse_header(ogs_sbi_message_t *message, ogs_sbi_header_t *header)
     return OGS_OK;
 }
 
+static void route_check(const route_desc_t *desc, size_t num)
+{
+    size_t i;
+
+    for (i = 1; i < num; i++)
+        ogs_assert(strcmp(desc[i-1].name, desc[i].name) < 0);
+}
+
+static int route_compare(const void *key, const void *desc)
+{
+    return strcmp(key, ((const route_desc_t *)desc)->name);
+}
+
+static int route_find(
+        const route_desc_t *desc, size_t num, const char *name)
+{
+    const route_desc_t *found = NULL;
+
+    if (!name)
+        return 0;
+
+    found = bsearch(name, desc, num, sizeof(*desc), route_compare);
+    if (!found)
+        return 0;
+
+    return found->id;
+}
+
+static ogs_sbi_method_e route_method(const char *method)
+{
+    if (!method)
+        return OGS_SBI_METHOD_NULL;
+
+    switch (method[0]) {
+    case 'D':
+        if (!strcmp(method, OGS_SBI_HTTP_METHOD_DELETE))
+            return OGS_SBI_METHOD_DELETE;
+        break;
+    case 'G':
+        if (!strcmp(method, OGS_SBI_HTTP_METHOD_GET))
+            return OGS_SBI_METHOD_GET;
+        break;
+    case 'O':
+        if (!strcmp(method, OGS_SBI_HTTP_METHOD_OPTIONS))
+            return OGS_SBI_METHOD_OPTIONS;
+        break;
+    case 'P':
+        if (!strcmp(method, OGS_SBI_HTTP_METHOD_POST))
+            return OGS_SBI_METHOD_POST;
+        if (!strcmp(method, OGS_SBI_HTTP_METHOD_PUT))
+            return OGS_SBI_METHOD_PUT;
+        if (!strcmp(method, OGS_SBI_HTTP_METHOD_PATCH))
+            return OGS_SBI_METHOD_PATCH;
+        break;
+    default:
+        break;
+    }
+
+    return OGS_SBI_METHOD_NULL;
+}
+
+void ogs_sbi_route_resolve(ogs_sbi_route_t *route, ogs_sbi_header_t *h)
+{
+    int i;
+
+    ogs_assert(route);
+    ogs_assert(h);
+
+    memset(route, 0, sizeof(*route));
+
+    route->method = route_method(h->method);
+    route->service = route_find(service_desc,
+            OGS_ARRAY_SIZE(service_desc), h->service.name);
+
+    /* "v1", "v2", ... as in OGS_SBI_API_V1 */
+    if (h->api.version && h->api.version[0] == 'v' &&
+        h->api.version[1] >= '1' && h->api.version[1] <= '9' &&
+        h->api.version[2] == 0)
+        route->version = h->api.version[1] - '0';
+
+    for (i = 0; i < OGS_SBI_MAX_NUM_OF_RESOURCE_COMPONENT &&
+                h->resource.component[i]; i++)
+        route->component[i] = route_find(resource_desc,
+                OGS_ARRAY_SIZE(resource_desc), h->resource.component[i]);
+}
+
 void ogs_sbi_header_free(ogs_sbi_header_t *h)
 {
     int i;
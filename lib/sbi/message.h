@@ -282,6 +282,8 @@ extern "C" {
     OGS_SBI_CUSTOM_DISCOVERY_COMMON OGS_SBI_PARAM_REQUESTER_FEATURES
 #define OGS_SBI_CUSTOM_PRODUCER_ID       \
     OGS_SBI_CUSTOM_3GPP_COMMON "Producer-Id"
+#define OGS_SBI_CUSTOM_LCI               \
+    OGS_SBI_CUSTOM_3GPP_COMMON "Lci"
 #define OGS_SBI_CUSTOM_OCI               \
     OGS_SBI_CUSTOM_3GPP_COMMON "Oci"
 #define OGS_SBI_CUSTOM_CLIENT_CREDENTIALS   \
@@ -373,6 +375,72 @@ extern "C" {
 #define OGS_SBI_CALLBACK_N5G_DDNMF_DISCOVERY_MATCH_INFORMATION \
     "N5g-ddnmf_Discovery_MatchInformation"
 
+typedef enum {
+    OGS_SBI_METHOD_NULL = 0,
+
+    OGS_SBI_METHOD_DELETE,
+    OGS_SBI_METHOD_GET,
+    OGS_SBI_METHOD_PATCH,
+    OGS_SBI_METHOD_POST,
+    OGS_SBI_METHOD_PUT,
+    OGS_SBI_METHOD_OPTIONS,
+
+    OGS_SBI_MAX_NUM_OF_METHOD,
+} ogs_sbi_method_e;
+
+typedef enum {
+    OGS_SBI_RESOURCE_NULL = 0,
+
+    OGS_SBI_RESOURCE_NF_INSTANCES,
+    OGS_SBI_RESOURCE_SUBSCRIPTIONS,
+    OGS_SBI_RESOURCE_NF_STATUS_NOTIFY,
+    OGS_SBI_RESOURCE_UE_AUTHENTICATIONS,
+    OGS_SBI_RESOURCE_5G_AKA,
+    OGS_SBI_RESOURCE_5G_AKA_CONFIRMATION,
+    OGS_SBI_RESOURCE_EAP_SESSION,
+    OGS_SBI_RESOURCE_AM_DATA,
+    OGS_SBI_RESOURCE_SM_DATA,
+    OGS_SBI_RESOURCE_SMF_SELECT_DATA,
+    OGS_SBI_RESOURCE_UE_CONTEXT_IN_SMF_DATA,
+    OGS_SBI_RESOURCE_SMF_SELECTION_SUBSCRIPTION_DATA,
+    OGS_SBI_RESOURCE_SDM_SUBSCRIPTIONS,
+    OGS_SBI_RESOURCE_SECURITY_INFORMATION,
+    OGS_SBI_RESOURCE_GENERATE_AUTH_DATA,
+    OGS_SBI_RESOURCE_AUTH_EVENTS,
+    OGS_SBI_RESOURCE_REGISTRATIONS,
+    OGS_SBI_RESOURCE_AMF_3GPP_ACCESS,
+    OGS_SBI_RESOURCE_SUBSCRIPTION_DATA,
+    OGS_SBI_RESOURCE_AUTHENTICATION_DATA,
+    OGS_SBI_RESOURCE_AUTHENTICATION_SUBSCRIPTION,
+    OGS_SBI_RESOURCE_AUTHENTICATION_STATUS,
+    OGS_SBI_RESOURCE_CONTEXT_DATA,
+    OGS_SBI_RESOURCE_PROVISIONED_DATA,
+    OGS_SBI_RESOURCE_POLICY_DATA,
+    OGS_SBI_RESOURCE_UES,
+    OGS_SBI_RESOURCE_SM_CONTEXTS,
+    OGS_SBI_RESOURCE_MODIFY,
+    OGS_SBI_RESOURCE_RELEASE,
+    OGS_SBI_RESOURCE_SM_POLICY_NOTIFY,
+    OGS_SBI_RESOURCE_N1_N2_FAILURE_NOTIFY,
+    OGS_SBI_RESOURCE_UE_CONTEXTS,
+    OGS_SBI_RESOURCE_N1_N2_MESSAGES,
+    OGS_SBI_RESOURCE_SM_CONTEXT_STATUS,
+    OGS_SBI_RESOURCE_AM_POLICY_NOTIFY,
+    OGS_SBI_RESOURCE_DEREG_NOTIFY,
+    OGS_SBI_RESOURCE_SDMSUBSCRIPTION_NOTIFY,
+    OGS_SBI_RESOURCE_POLICIES,
+    OGS_SBI_RESOURCE_SM_POLICIES,
+    OGS_SBI_RESOURCE_DELETE,
+    OGS_SBI_RESOURCE_APP_SESSIONS,
+    OGS_SBI_RESOURCE_NOTIFY,
+    OGS_SBI_RESOURCE_UPDATE,
+    OGS_SBI_RESOURCE_TERMINATE,
+    OGS_SBI_RESOURCE_NETWORK_SLICE_INFORMATION,
+    OGS_SBI_RESOURCE_PCF_BINDINGS,
+
+    OGS_SBI_MAX_NUM_OF_RESOURCE,
+} ogs_sbi_resource_e;
+
 typedef struct ogs_sbi_header_s {
     char *method;
     char *uri;
@@ -392,6 +460,23 @@ typedef struct ogs_sbi_header_s {
 
 } ogs_sbi_header_t;
 
+/*
+ * Integer form of ogs_sbi_header_t, so that state machines can use
+ * switch() instead of SWITCH()/CASE(). Anything not in the route table
+ * resolves to 0 (*_NULL).
+ *
+ * Parsing leaves it zeroed. A state machine that dispatches on it calls
+ * ogs_sbi_route_resolve() after ogs_sbi_parse_request(); only the AMF's
+ * top-level request dispatch does so far. The others keep SWITCH()/CASE()
+ * on the string header and move over one at a time.
+ */
+typedef struct ogs_sbi_route_s {
+    int service;    /* ogs_sbi_service_type_e, including *_CALLBACK */
+    int version;    /* N of "vN" */
+    ogs_sbi_method_e method;
+    ogs_sbi_resource_e component[OGS_SBI_MAX_NUM_OF_RESOURCE_COMPONENT];
+} ogs_sbi_route_t;
+
 typedef struct ogs_sbi_part_s {
     char *content_id;
     char *content_type;
@@ -411,6 +496,7 @@ typedef struct ogs_sbi_discovery_option_s {
 
 typedef struct ogs_sbi_message_s {
     ogs_sbi_header_t h;
+    ogs_sbi_route_t route;
 
     struct {
         char *accept;
@@ -534,6 +620,12 @@ typedef struct ogs_sbi_request_s {
     ogs_sbi_header_t h;
     ogs_sbi_http_message_t http;
 
+    /* ogs_sbi_client_send_request() takes http.content without copying */
+    bool move_content;
+
+    /* Used in server for load control */
+    ogs_time_t received;
+
     /* Used in microhttpd */
     bool suspended;
     struct {
@@ -575,6 +667,7 @@ ogs_pkbuf_t *ogs_sbi_find_part_by_content_id(
         ogs_sbi_message_t *message, char *content_id);
 
 int ogs_sbi_parse_header(ogs_sbi_message_t *message, ogs_sbi_header_t *header);
+void ogs_sbi_route_resolve(ogs_sbi_route_t *route, ogs_sbi_header_t *h);
 void ogs_sbi_header_free(ogs_sbi_header_t *h);
 
 void ogs_sbi_http_hash_free(ogs_hash_t *hash);
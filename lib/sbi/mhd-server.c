@@ -40,6 +40,7 @@ static bool server_send_response(
         ogs_sbi_stream_t *stream, ogs_sbi_response_t *response);
 
 static ogs_sbi_server_t *server_from_stream(ogs_sbi_stream_t *stream);
+static ogs_sbi_request_t *request_from_stream(ogs_sbi_stream_t *stream);
 
 const ogs_sbi_server_actions_t ogs_mhd_server_actions = {
     server_init,
@@ -52,6 +53,7 @@ const ogs_sbi_server_actions_t ogs_mhd_server_actions = {
     server_send_response,
 
     server_from_stream,
+    request_from_stream,
 };
 
 static void run(short when, ogs_socket_t fd, void *data);
@@ -570,6 +572,8 @@ suspend:
     sbi_sess = session_add(server, request, connection);
     ogs_assert(sbi_sess);
 
+    request->received = ogs_get_monotonic_time();
+
     ogs_assert(server->cb);
     if (server->cb(request, sbi_sess) != OGS_OK) {
         ogs_warn("server callback error");
@@ -608,3 +612,17 @@ static ogs_sbi_server_t *server_from_stream(ogs_sbi_stream_t *stream)
 
     return sbi_sess->server;
 }
+
+/* Returns NULL if the session has already been removed */
+static ogs_sbi_request_t *request_from_stream(ogs_sbi_stream_t *stream)
+{
+    ogs_sbi_session_t *sbi_sess = NULL;
+
+    ogs_assert(stream);
+
+    sbi_sess = ogs_pool_cycle(&session_pool, (ogs_sbi_session_t *)stream);
+    if (!sbi_sess)
+        return NULL;
+
+    return sbi_sess->request;
+}
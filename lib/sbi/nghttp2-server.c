@@ -38,6 +38,7 @@ static bool server_send_response(
         ogs_sbi_stream_t *stream, ogs_sbi_response_t *response);
 
 static ogs_sbi_server_t *server_from_stream(ogs_sbi_stream_t *stream);
+static ogs_sbi_request_t *request_from_stream(ogs_sbi_stream_t *stream);
 
 const ogs_sbi_server_actions_t ogs_nghttp2_server_actions = {
     server_init,
@@ -50,6 +51,7 @@ const ogs_sbi_server_actions_t ogs_nghttp2_server_actions = {
     server_send_response,
 
     server_from_stream,
+    request_from_stream,
 };
 
 struct h2_settings {
@@ -57,6 +59,8 @@ struct h2_settings {
     bool enable_push;
 };
 
+typedef struct ogs_sbi_worker_s ogs_sbi_worker_t;
+
 typedef struct ogs_sbi_session_s {
     ogs_lnode_t             lnode;
 
@@ -71,6 +75,7 @@ typedef struct ogs_sbi_session_s {
     ogs_list_t              write_queue;
 
     ogs_sbi_server_t        *server;
+    ogs_sbi_worker_t        *worker;
     ogs_list_t              stream_list;
     int32_t                 last_stream_id;
 
@@ -85,13 +90,61 @@ typedef struct ogs_sbi_stream_s {
     ogs_sbi_request_t       *request;
     bool                    memory_overflow;
 
+    /*
+     * The request has been handed to the NF thread and
+     * the response has not come back to the I/O thread yet.
+     * The stream (and its request) must survive until then.
+     */
+    bool                    dispatched;
+
+    ogs_sbi_server_t        *server;
+    ogs_sbi_worker_t        *worker;
     ogs_sbi_session_t       *session;
 } ogs_sbi_stream_t;
 
+/*
+ * Every HTTP/2 session is owned by a worker. Without `sbi.server.io_thread`,
+ * there is a single worker running on the NF's main pollset.
+ * Otherwise, each worker has its own thread and pollset, and the NF thread
+ * talks to it only through the command queue.
+ */
+typedef struct ogs_sbi_worker_s {
+    ogs_thread_t            *thread;
+
+    ogs_pollset_t           *pollset;
+    ogs_queue_t             *queue;
+
+    ogs_list_t              session_list;
+    ogs_list_t              orphan_list;
+
+    OGS_POOL(session_pool, ogs_sbi_session_t);
+    OGS_POOL(stream_pool, ogs_sbi_stream_t);
+} ogs_sbi_worker_t;
+
+typedef enum {
+    OGS_SBI_WORKER_ACCEPT = 1,
+    OGS_SBI_WORKER_RESPONSE,
+    OGS_SBI_WORKER_STOP,
+} ogs_sbi_worker_command_e;
+
+typedef struct ogs_sbi_worker_command_s {
+    ogs_lnode_t             lnode;
+
+    ogs_sbi_worker_command_e type;
+
+    ogs_sbi_server_t        *server;
+    ogs_sock_t              *sock;
+
+    ogs_sbi_stream_t        *stream;
+    ogs_sbi_response_t      *response;
+    bool                    persistent;
+} ogs_sbi_worker_command_t;
+
 static void session_remove(ogs_sbi_session_t *sbi_sess);
 static void session_remove_all(ogs_sbi_server_t *server);
 
 static void stream_remove(ogs_sbi_stream_t *stream);
+static void stream_free(ogs_sbi_stream_t *stream);
 
 static void accept_handler(short when, ogs_socket_t fd, void *data);
 static void recv_handler(short when, ogs_socket_t fd, void *data);
@@ -101,20 +154,323 @@ static int session_send_preface(ogs_sbi_session_t *sbi_sess);
 static int session_send(ogs_sbi_session_t *sbi_sess);
 static void session_write_to_buffer(
         ogs_sbi_session_t *sbi_sess, ogs_pkbuf_t *pkbuf);
+static void session_accept(ogs_sbi_worker_t *worker,
+        ogs_sbi_server_t *server, ogs_sock_t *sock);
+
+static bool stream_send_response(ogs_sbi_stream_t *stream,
+        ogs_sbi_response_t *response);
+
+static void worker_main(void *data);
+static void worker_stop_all(void);
+static void worker_command_handler(
+        ogs_sbi_worker_t *worker, ogs_sbi_worker_command_t *cmd);
+static void pending_flush(void *data);
+
+static ogs_sbi_worker_t *worker_array;
+static int num_of_worker;
+static int next_worker;
+
+/* The worker running in this thread, NULL in the NF thread */
+static __thread ogs_sbi_worker_t *worker_current;
 
-static OGS_POOL(session_pool, ogs_sbi_session_t);
-static OGS_POOL(stream_pool, ogs_sbi_stream_t);
+/* Responses from the NF thread waiting for the current event to finish */
+static ogs_list_t pending_list;
 
 static void server_init(int num_of_session_pool, int num_of_stream_pool)
 {
-    ogs_pool_init(&session_pool, num_of_session_pool);
-    ogs_pool_init(&stream_pool, num_of_stream_pool);
+    int i;
+    int num_of_io_thread = ogs_app()->sbi.server.io_thread;
+
+    num_of_worker = num_of_io_thread > 0 ? num_of_io_thread : 1;
+
+    worker_array = ogs_calloc(num_of_worker, sizeof(ogs_sbi_worker_t));
+    ogs_assert(worker_array);
+
+    for (i = 0; i < num_of_worker; i++) {
+        ogs_sbi_worker_t *worker = &worker_array[i];
+
+        ogs_list_init(&worker->session_list);
+        ogs_list_init(&worker->orphan_list);
+
+        ogs_pool_init(&worker->session_pool,
+                ogs_max(1, num_of_session_pool / num_of_worker));
+        ogs_pool_init(&worker->stream_pool,
+                ogs_max(1, num_of_stream_pool / num_of_worker));
+
+        if (num_of_io_thread > 0) {
+            worker->pollset = ogs_pollset_create(ogs_app()->pool.socket);
+            ogs_assert(worker->pollset);
+            worker->queue = ogs_queue_create(num_of_stream_pool);
+            ogs_assert(worker->queue);
+
+            worker->thread = ogs_thread_create(worker_main, worker);
+            ogs_assert(worker->thread);
+        } else {
+            worker->pollset = ogs_app()->pollset;
+        }
+    }
+
+    if (num_of_io_thread > 0) {
+        ogs_list_init(&pending_list);
+        ogs_notify_set_handler(ogs_app()->pollset, pending_flush, NULL);
+
+        ogs_info("nghttp2_server() with %d I/O thread(s)", num_of_io_thread);
+    }
 }
 
 static void server_final(void)
 {
-    ogs_pool_final(&stream_pool);
-    ogs_pool_final(&session_pool);
+    int i;
+
+    worker_stop_all();
+
+    if (ogs_app()->sbi.server.io_thread > 0)
+        ogs_notify_set_handler(ogs_app()->pollset, NULL, NULL);
+
+    for (i = 0; i < num_of_worker; i++) {
+        ogs_sbi_worker_t *worker = &worker_array[i];
+        ogs_sbi_stream_t *stream = NULL, *next_stream = NULL;
+
+        /* Requests which were never answered by the NF */
+        ogs_list_for_each_safe(&worker->orphan_list, next_stream, stream)
+            stream_free(stream);
+
+        ogs_pool_final(&worker->stream_pool);
+        ogs_pool_final(&worker->session_pool);
+
+        if (worker->queue)
+            ogs_queue_destroy(worker->queue);
+        if (worker->pollset != ogs_app()->pollset)
+            ogs_pollset_destroy(worker->pollset);
+    }
+
+    ogs_free(worker_array);
+    worker_array = NULL;
+    num_of_worker = 0;
+}
+
+static ogs_sbi_worker_t *worker_self(void)
+{
+    return worker_current;
+}
+
+static bool worker_is_running(void)
+{
+    return num_of_worker > 0 && worker_array[0].thread != NULL;
+}
+
+/*
+ * The NF thread cannot dereference a stream owned by an I/O thread,
+ * so the owner is found from the pool the stream was allocated from.
+ */
+static ogs_sbi_worker_t *worker_from_stream(ogs_sbi_stream_t *stream)
+{
+    int i;
+
+    ogs_assert(stream);
+
+    for (i = 0; i < num_of_worker; i++) {
+        ogs_sbi_worker_t *worker = &worker_array[i];
+        if (stream >= worker->stream_pool.array &&
+            stream < worker->stream_pool.array + worker->stream_pool.size)
+            return worker;
+    }
+
+    return NULL;
+}
+
+static void worker_command_free(ogs_sbi_worker_command_t *cmd)
+{
+    ogs_assert(cmd);
+
+    if (cmd->sock)
+        ogs_sock_destroy(cmd->sock);
+    if (cmd->response && cmd->persistent == false)
+        ogs_sbi_response_free(cmd->response);
+
+    ogs_free(cmd);
+}
+
+static void worker_push(
+        ogs_sbi_worker_t *worker, ogs_sbi_worker_command_t *cmd)
+{
+    int rv;
+
+    ogs_assert(worker);
+    ogs_assert(worker->queue);
+    ogs_assert(cmd);
+
+    rv = ogs_queue_push(worker->queue, cmd);
+    if (rv != OGS_OK) {
+        ogs_error("ogs_queue_push() failed:%d", (int)rv);
+        worker_command_free(cmd);
+        return;
+    }
+
+    ogs_pollset_notify(worker->pollset);
+}
+
+static void worker_main(void *data)
+{
+    ogs_sbi_worker_t *worker = data;
+    int rv;
+
+    ogs_assert(worker);
+    worker_current = worker;
+
+    for ( ;; ) {
+        ogs_pollset_poll(worker->pollset, OGS_INFINITE_TIME);
+
+        for ( ;; ) {
+            ogs_sbi_worker_command_t *cmd = NULL;
+
+            rv = ogs_queue_trypop(worker->queue, (void**)&cmd);
+            ogs_assert(rv != OGS_ERROR);
+
+            if (rv == OGS_DONE)
+                return;
+
+            if (rv == OGS_RETRY)
+                break;
+
+            ogs_assert(cmd);
+            if (cmd->type == OGS_SBI_WORKER_STOP) {
+                ogs_free(cmd);
+                return;
+            }
+
+            worker_command_handler(worker, cmd);
+        }
+    }
+}
+
+static void worker_stop_all(void)
+{
+    int i;
+    ogs_sbi_worker_command_t *cmd = NULL, *next_cmd = NULL;
+
+    if (worker_is_running() == false)
+        return;
+
+    for (i = 0; i < num_of_worker; i++) {
+        cmd = ogs_calloc(1, sizeof(*cmd));
+        ogs_assert(cmd);
+        cmd->type = OGS_SBI_WORKER_STOP;
+
+        worker_push(&worker_array[i], cmd);
+    }
+
+    for (i = 0; i < num_of_worker; i++) {
+        ogs_sbi_worker_t *worker = &worker_array[i];
+
+        ogs_thread_destroy(worker->thread);
+        worker->thread = NULL;
+    }
+
+    /* From now on, every session is handled in the NF thread */
+    ogs_list_for_each_safe(&pending_list, next_cmd, cmd) {
+        ogs_sbi_worker_t *worker = worker_from_stream(cmd->stream);
+
+        ogs_list_remove(&pending_list, cmd);
+        if (worker)
+            worker_command_handler(worker, cmd);
+        else
+            worker_command_free(cmd);
+    }
+}
+
+static void worker_command_handler(
+        ogs_sbi_worker_t *worker, ogs_sbi_worker_command_t *cmd)
+{
+    ogs_sbi_stream_t *stream = NULL;
+
+    ogs_assert(worker);
+    ogs_assert(cmd);
+
+    switch (cmd->type) {
+    case OGS_SBI_WORKER_ACCEPT:
+        ogs_assert(cmd->server);
+        ogs_assert(cmd->sock);
+
+        session_accept(worker, cmd->server, cmd->sock);
+        cmd->sock = NULL;
+        break;
+
+    case OGS_SBI_WORKER_RESPONSE:
+        ogs_assert(cmd->response);
+
+        stream = ogs_pool_cycle(&worker->stream_pool, cmd->stream);
+        if (!stream) {
+            ogs_error("stream has already been removed");
+            break;
+        }
+
+        stream->dispatched = false;
+
+        if (!stream->session) {
+            ogs_warn("STREAM closed before the response [%d]",
+                    stream->stream_id);
+            ogs_list_remove(&worker->orphan_list, stream);
+            stream_free(stream);
+            break;
+        }
+
+        stream_send_response(stream, cmd->response);
+        break;
+
+    default:
+        ogs_error("Unknown command [%d]", cmd->type);
+        break;
+    }
+
+    worker_command_free(cmd);
+}
+
+/*
+ * The NF may still refer to the request (e.g. via ogs_sbi_message_t)
+ * after sending the response, so the response is handed over to the
+ * I/O thread only when the NF thread polls again: ogs_pollset_notify()
+ * wakes it up and pending_flush() runs as the pollset's notify handler.
+ */
+static void pending_add(ogs_sbi_stream_t *stream,
+        ogs_sbi_response_t *response, bool persistent)
+{
+    ogs_sbi_worker_command_t *cmd = NULL;
+
+    ogs_assert(stream);
+    ogs_assert(response);
+
+    cmd = ogs_calloc(1, sizeof(*cmd));
+    ogs_assert(cmd);
+
+    cmd->type = OGS_SBI_WORKER_RESPONSE;
+    cmd->stream = stream;
+    cmd->response = response;
+    cmd->persistent = persistent;
+
+    if (ogs_list_empty(&pending_list) == true)
+        ogs_pollset_notify(ogs_app()->pollset);
+
+    ogs_list_add(&pending_list, cmd);
+}
+
+static void pending_flush(void *data)
+{
+    ogs_sbi_worker_command_t *cmd = NULL, *next_cmd = NULL;
+
+    ogs_list_for_each_safe(&pending_list, next_cmd, cmd) {
+        ogs_sbi_worker_t *worker = worker_from_stream(cmd->stream);
+
+        ogs_list_remove(&pending_list, cmd);
+
+        if (!worker) {
+            ogs_error("Invalid stream [%p]", cmd->stream);
+            worker_command_free(cmd);
+            continue;
+        }
+
+        worker_push(worker, cmd);
+    }
 }
 
 #ifndef OPENSSL_NO_NEXTPROTONEG
@@ -413,6 +769,9 @@ static void server_stop(ogs_sbi_server_t *server)
     if (server->node.sock)
         ogs_sock_destroy(server->node.sock);
 
+    /* I/O threads must not touch the sessions from here on */
+    worker_stop_all();
+
     session_remove_all(server);
 }
 
@@ -540,6 +899,33 @@ static ssize_t response_read_callback(nghttp2_session *session,
 
 static bool server_send_rspmem_persistent(
         ogs_sbi_stream_t *stream, ogs_sbi_response_t *response)
+{
+    ogs_sbi_worker_t *worker = NULL;
+
+    ogs_assert(stream);
+    ogs_assert(response);
+
+    if (worker_is_running() == true && worker_self() == NULL) {
+        pending_add(stream, response, true);
+        return true;
+    }
+
+    worker = worker_from_stream(stream);
+    ogs_assert(worker);
+    /* An I/O thread only answers its own streams */
+    ogs_assert(worker->thread == NULL || worker == worker_self());
+
+    stream = ogs_pool_cycle(&worker->stream_pool, stream);
+    if (!stream) {
+        ogs_error("stream has already been removed");
+        return true;
+    }
+
+    return stream_send_response(stream, response);
+}
+
+static bool stream_send_response(
+        ogs_sbi_stream_t *stream, ogs_sbi_response_t *response)
 {
     ogs_sbi_session_t *sbi_sess = NULL;
     ogs_sock_t *sock = NULL;
@@ -560,12 +946,7 @@ static bool server_send_rspmem_persistent(
         return false;
     }
 
-    stream = ogs_pool_cycle(&stream_pool, stream);
-    if (!stream) {
-        ogs_error("stream has already been removed");
-        return true;
-    }
-
+    ogs_assert(stream);
     sbi_sess = stream->session;
     ogs_assert(sbi_sess);
     ogs_assert(sbi_sess->session);
@@ -654,6 +1035,12 @@ static bool server_send_response(
 
     ogs_assert(response);
 
+    if (worker_is_running() == true && worker_self() == NULL) {
+        ogs_assert(stream);
+        pending_add(stream, response, false);
+        return true;
+    }
+
     rc = server_send_rspmem_persistent(stream, response);
 
     ogs_sbi_response_free(response);
@@ -663,24 +1050,46 @@ static bool server_send_response(
 
 static ogs_sbi_server_t *server_from_stream(ogs_sbi_stream_t *stream)
 {
-    ogs_sbi_session_t *sbi_sess = NULL;
+    ogs_assert(stream);
+    ogs_assert(stream->server);
+
+    return stream->server;
+}
+
+/* Returns NULL if the stream has already been removed */
+static ogs_sbi_request_t *request_from_stream(ogs_sbi_stream_t *stream)
+{
+    ogs_sbi_worker_t *worker = NULL;
 
     ogs_assert(stream);
-    sbi_sess = stream->session;
-    ogs_assert(sbi_sess);
-    ogs_assert(sbi_sess->server);
 
-    return sbi_sess->server;
+    worker = worker_from_stream(stream);
+    ogs_assert(worker);
+
+    if (worker->thread == NULL || worker == worker_self()) {
+        stream = ogs_pool_cycle(&worker->stream_pool, stream);
+        if (!stream)
+            return NULL;
+    }
+
+    /*
+     * Otherwise this is the NF thread answering a request handed over by
+     * an I/O thread, which keeps the stream until the response arrives.
+     */
+    return stream->request;
 }
 
 static ogs_sbi_stream_t *stream_add(
         ogs_sbi_session_t *sbi_sess, int32_t stream_id)
 {
+    ogs_sbi_worker_t *worker = NULL;
     ogs_sbi_stream_t *stream = NULL;
 
     ogs_assert(sbi_sess);
+    worker = sbi_sess->worker;
+    ogs_assert(worker);
 
-    ogs_pool_alloc(&stream_pool, &stream);
+    ogs_pool_alloc(&worker->stream_pool, &stream);
     if (!stream) {
         ogs_error("ogs_pool_alloc() failed");
         return NULL;
@@ -690,13 +1099,15 @@ static ogs_sbi_stream_t *stream_add(
     stream->request = ogs_sbi_request_new();
     if (!stream->request) {
         ogs_error("ogs_sbi_request_new() failed");
-        ogs_pool_free(&stream_pool, stream);
+        ogs_pool_free(&worker->stream_pool, stream);
         return NULL;
     }
 
     stream->stream_id = stream_id;
     sbi_sess->last_stream_id = stream_id;
 
+    stream->server = sbi_sess->server;
+    stream->worker = worker;
     stream->session = sbi_sess;
 
     ogs_list_add(&sbi_sess->stream_list, stream);
@@ -704,6 +1115,20 @@ static ogs_sbi_stream_t *stream_add(
     return stream;
 }
 
+static void stream_free(ogs_sbi_stream_t *stream)
+{
+    ogs_sbi_worker_t *worker = NULL;
+
+    ogs_assert(stream);
+    worker = stream->worker;
+    ogs_assert(worker);
+
+    ogs_assert(stream->request);
+    ogs_sbi_request_free(stream->request);
+
+    ogs_pool_free(&worker->stream_pool, stream);
+}
+
 static void stream_remove(ogs_sbi_stream_t *stream)
 {
     ogs_sbi_session_t *sbi_sess = NULL;
@@ -713,11 +1138,15 @@ static void stream_remove(ogs_sbi_stream_t *stream)
     ogs_assert(sbi_sess);
 
     ogs_list_remove(&sbi_sess->stream_list, stream);
+    stream->session = NULL;
 
-    ogs_assert(stream->request);
-    ogs_sbi_request_free(stream->request);
+    if (stream->dispatched == true) {
+        /* The NF thread still owns the request. Wait for its response. */
+        ogs_list_add(&stream->worker->orphan_list, stream);
+        return;
+    }
 
-    ogs_pool_free(&stream_pool, stream);
+    stream_free(stream);
 }
 
 static void stream_remove_all(ogs_sbi_session_t *sbi_sess)
@@ -730,15 +1159,16 @@ static void stream_remove_all(ogs_sbi_session_t *sbi_sess)
         stream_remove(stream);
 }
 
-static ogs_sbi_session_t *session_add(
+static ogs_sbi_session_t *session_add(ogs_sbi_worker_t *worker,
         ogs_sbi_server_t *server, ogs_sock_t *sock)
 {
     ogs_sbi_session_t *sbi_sess = NULL;
 
+    ogs_assert(worker);
     ogs_assert(server);
     ogs_assert(sock);
 
-    ogs_pool_alloc(&session_pool, &sbi_sess);
+    ogs_pool_alloc(&worker->session_pool, &sbi_sess);
     if (!sbi_sess) {
         ogs_error("ogs_pool_alloc() failed");
         return NULL;
@@ -746,12 +1176,13 @@ static ogs_sbi_session_t *session_add(
     memset(sbi_sess, 0, sizeof(ogs_sbi_session_t));
 
     sbi_sess->server = server;
+    sbi_sess->worker = worker;
     sbi_sess->sock = sock;
 
     sbi_sess->addr = ogs_calloc(1, sizeof(ogs_sockaddr_t));
     if (!sbi_sess->addr) {
         ogs_error("ogs_calloc() failed");
-        ogs_pool_free(&session_pool, sbi_sess);
+        ogs_pool_free(&worker->session_pool, sbi_sess);
         return NULL;
     }
     memcpy(sbi_sess->addr, &sock->remote_addr, sizeof(ogs_sockaddr_t));
@@ -760,27 +1191,27 @@ static ogs_sbi_session_t *session_add(
         sbi_sess->ssl = SSL_new(server->ssl_ctx);
         if (!sbi_sess->ssl) {
             ogs_error("SSL_new() failed");
-            ogs_pool_free(&session_pool, sbi_sess);
+            ogs_pool_free(&worker->session_pool, sbi_sess);
             ogs_free(sbi_sess->addr);
             return NULL;
         }
     }
 
-    ogs_list_add(&server->session_list, sbi_sess);
+    ogs_list_add(&worker->session_list, sbi_sess);
 
     return sbi_sess;
 }
 
 static void session_remove(ogs_sbi_session_t *sbi_sess)
 {
-    ogs_sbi_server_t *server = NULL;
+    ogs_sbi_worker_t *worker = NULL;
     ogs_pkbuf_t *pkbuf = NULL, *next_pkbuf = NULL;
 
     ogs_assert(sbi_sess);
-    server = sbi_sess->server;
-    ogs_assert(server);
+    worker = sbi_sess->worker;
+    ogs_assert(worker);
 
-    ogs_list_remove(&server->session_list, sbi_sess);
+    ogs_list_remove(&worker->session_list, sbi_sess);
 
     if (sbi_sess->ssl)
         SSL_free(sbi_sess->ssl);
@@ -805,23 +1236,28 @@ static void session_remove(ogs_sbi_session_t *sbi_sess)
     ogs_assert(sbi_sess->sock);
     ogs_sock_destroy(sbi_sess->sock);
 
-    ogs_pool_free(&session_pool, sbi_sess);
+    ogs_pool_free(&worker->session_pool, sbi_sess);
 }
 
 static void session_remove_all(ogs_sbi_server_t *server)
 {
     ogs_sbi_session_t *sbi_sess = NULL, *next_sbi_sess = NULL;
+    int i;
 
     ogs_assert(server);
 
-    ogs_list_for_each_safe(&server->session_list, next_sbi_sess, sbi_sess)
-        session_remove(sbi_sess);
+    for (i = 0; i < num_of_worker; i++) {
+        ogs_list_for_each_safe(&worker_array[i].session_list,
+                next_sbi_sess, sbi_sess) {
+            if (sbi_sess->server == server)
+                session_remove(sbi_sess);
+        }
+    }
 }
 
 static void accept_handler(short when, ogs_socket_t fd, void *data)
 {
     ogs_sbi_server_t *server = data;
-    ogs_sbi_session_t *sbi_sess = NULL;
     ogs_sock_t *sock = NULL;
     ogs_sock_t *new = NULL;
 
@@ -847,7 +1283,34 @@ static void accept_handler(short when, ogs_socket_t fd, void *data)
         return;
     }
 
-    sbi_sess = session_add(server, new);
+    if (worker_is_running() == true) {
+        ogs_sbi_worker_command_t *cmd = NULL;
+
+        cmd = ogs_calloc(1, sizeof(*cmd));
+        ogs_assert(cmd);
+
+        cmd->type = OGS_SBI_WORKER_ACCEPT;
+        cmd->server = server;
+        cmd->sock = new;
+
+        /* Connections are spread over I/O threads in round-robin */
+        worker_push(&worker_array[next_worker], cmd);
+        next_worker = (next_worker + 1) % num_of_worker;
+    } else {
+        session_accept(&worker_array[0], server, new);
+    }
+}
+
+static void session_accept(ogs_sbi_worker_t *worker,
+        ogs_sbi_server_t *server, ogs_sock_t *new)
+{
+    ogs_sbi_session_t *sbi_sess = NULL;
+
+    ogs_assert(worker);
+    ogs_assert(server);
+    ogs_assert(new);
+
+    sbi_sess = session_add(worker, server, new);
     ogs_assert(sbi_sess);
 
     if (sbi_sess->ssl) {
@@ -862,7 +1325,7 @@ static void accept_handler(short when, ogs_socket_t fd, void *data)
         }
     }
 
-    sbi_sess->poll.read = ogs_pollset_add(ogs_app()->pollset,
+    sbi_sess->poll.read = ogs_pollset_add(worker->pollset,
         OGS_POLLIN, new->fd, recv_handler, sbi_sess);
     ogs_assert(sbi_sess->poll.read);
 
@@ -1111,8 +1574,17 @@ static int on_frame_recv(nghttp2_session *session,
                 break;
             }
 
+            if (sbi_sess->worker->thread)
+                stream->dispatched = true;
+
+            request->received = ogs_get_monotonic_time();
+
+            /* See ogs_sbi_server_t.cb for the threading contract */
+            ogs_assert(sbi_sess->worker->thread == NULL ||
+                    sbi_sess->worker == worker_self());
             if (server->cb(request, stream) != OGS_OK) {
                 ogs_warn("server callback error");
+                stream->dispatched = false;
                 ogs_assert(true ==
                     ogs_sbi_server_send_error(stream,
                         OGS_SBI_HTTP_STATUS_INTERNAL_SERVER_ERROR, NULL,
@@ -1120,6 +1592,10 @@ static int on_frame_recv(nghttp2_session *session,
 
                 return 0;
             }
+
+            /* Wake up the NF thread waiting for the event */
+            if (sbi_sess->worker->thread)
+                ogs_pollset_notify(ogs_app()->pollset);
             break;
         }
     default:
@@ -1621,7 +2097,8 @@ static void session_write_to_buffer(
     ogs_list_add(&sbi_sess->write_queue, pkbuf);
 
     if (!sbi_sess->poll.write) {
-        sbi_sess->poll.write = ogs_pollset_add(ogs_app()->pollset,
+        ogs_assert(sbi_sess->worker);
+        sbi_sess->poll.write = ogs_pollset_add(sbi_sess->worker->pollset,
             OGS_POLLOUT, fd, session_write_callback, sbi_sess);
         ogs_assert(sbi_sess->poll.write);
     }
@@ -205,12 +205,17 @@ int ogs_sbi_discover_and_send(ogs_sbi_xact_t *xact)
 
     /* Target NF-Instance */
     nf_instance = sbi_object->service_type_array[service_type].nf_instance;
-    if (!nf_instance) {
-        nf_instance = ogs_sbi_nf_instance_find_by_discovery_param(
+    if (!nf_instance ||
+        ogs_sbi_nf_instance_load(nf_instance) > OGS_SBI_MAX_LOAD) {
+        /* Divert from an instance under overload control if possible */
+        ogs_sbi_nf_instance_t *selected =
+            ogs_sbi_nf_instance_find_by_discovery_param(
                         target_nf_type, requester_nf_type, discovery_option);
-        if (nf_instance)
+        if (selected && selected != nf_instance) {
             OGS_SBI_SETUP_NF_INSTANCE(
-                    sbi_object->service_type_array[service_type], nf_instance);
+                    sbi_object->service_type_array[service_type], selected);
+            nf_instance = selected;
+        }
     }
 
     /* Target Client */
@@ -27,6 +27,21 @@ bool ogs_sbi_server_actions_initialized = false;
 
 static OGS_POOL(server_pool, ogs_sbi_server_t);
 
+/*
+ * Load and Overload Control (TS29.500 6.3 and 6.4)
+ *
+ * The load is the larger of the event queue depth and the request
+ * processing latency, each relative to its configured 100% value.
+ */
+#define LCI_HYSTERESIS          10      /* Republish LCI on a 10% change */
+#define LCI_INTERVAL            ogs_time_from_sec(1)
+#define LATENCY_EWMA_WEIGHT     8       /* New sample weighs 1/8 */
+#define MIN_OVERLOAD_REDUCTION  10
+#define MAX_OVERLOAD_REDUCTION  90
+
+static void load_control_add_header(
+        ogs_sbi_stream_t *stream, ogs_sbi_response_t *response);
+
 void ogs_sbi_server_init(int num_of_session_pool, int num_of_stream_pool)
 {
     if (ogs_sbi_server_actions_initialized == false) {
@@ -41,6 +56,9 @@ void ogs_sbi_server_init(int num_of_session_pool, int num_of_stream_pool)
 
     ogs_list_init(&ogs_sbi_self()->server_list);
     ogs_pool_init(&server_pool, ogs_app()->pool.nf);
+
+    memset(&ogs_sbi_self()->load_control, 0,
+            sizeof(ogs_sbi_self()->load_control));
 }
 
 void ogs_sbi_server_final(void)
@@ -141,6 +159,10 @@ bool ogs_sbi_server_send_rspmem_persistent(
 bool ogs_sbi_server_send_response(
         ogs_sbi_stream_t *stream, ogs_sbi_response_t *response)
 {
+    if (ogs_app()->sbi.server.load_queue ||
+        ogs_app()->sbi.server.load_latency)
+        load_control_add_header(stream, response);
+
     return ogs_sbi_server_actions.send_response(stream, response);
 }
 
@@ -210,3 +232,85 @@ ogs_sbi_server_t *ogs_sbi_server_from_stream(ogs_sbi_stream_t *stream)
 {
     return ogs_sbi_server_actions.from_stream(stream);
 }
+
+static int load_control_update(ogs_sbi_stream_t *stream, ogs_time_t now)
+{
+    ogs_sbi_request_t *request = NULL;
+    ogs_time_t *latency = &ogs_sbi_self()->load_control.latency;
+    int load = 0;
+
+    if (stream) {
+        request = ogs_sbi_server_actions.request_from_stream(stream);
+        if (request && request->received)
+            *latency += (now - request->received - *latency) /
+                LATENCY_EWMA_WEIGHT;
+    }
+
+    if (ogs_app()->sbi.server.load_queue && ogs_app()->queue)
+        load = ogs_max(load, (int)(ogs_queue_size(ogs_app()->queue) * 100 /
+                    ogs_app()->sbi.server.load_queue));
+
+    if (ogs_app()->sbi.server.load_latency)
+        load = ogs_max(load, (int)(*latency * 100 /
+                ogs_time_from_msec(ogs_app()->sbi.server.load_latency)));
+
+    return ogs_min(load, 100);
+}
+
+static void load_control_add_header(
+        ogs_sbi_stream_t *stream, ogs_sbi_response_t *response)
+{
+    ogs_sbi_nf_instance_t *nf_instance = NULL;
+    ogs_sbi_load_control_t lc;
+    char value[OGS_SBI_MAX_LOAD_CONTROL_LEN];
+    ogs_time_t now, wallclock;
+    int load, threshold, reduction = -1;
+
+    ogs_assert(response);
+
+    now = ogs_get_monotonic_time();
+    wallclock = ogs_time_now();
+    load = load_control_update(stream, now);
+
+    memset(&lc, 0, sizeof(lc));
+    nf_instance = ogs_sbi_self()->nf_instance;
+    if (nf_instance && nf_instance->id)
+        ogs_cpystrn(lc.nf_inst, nf_instance->id, sizeof(lc.nf_inst));
+
+    if (abs(load - ogs_sbi_self()->load_control.load) >= LCI_HYSTERESIS ||
+        now - ogs_sbi_self()->load_control.lci_time >= LCI_INTERVAL) {
+        lc.load = load;
+        if (ogs_sbi_build_load_control(
+                    value, sizeof(value), &lc, wallclock, false) == true)
+            ogs_sbi_header_set(
+                    response->http.headers, OGS_SBI_CUSTOM_LCI, value);
+
+        ogs_sbi_self()->load_control.load = load;
+        ogs_sbi_self()->load_control.lci_time = now;
+    }
+
+    threshold = ogs_app()->sbi.server.overload_threshold;
+    if (threshold && load >= threshold) {
+        reduction = (load - threshold) * 100 / (100 - threshold);
+        reduction = ogs_max(reduction, MIN_OVERLOAD_REDUCTION);
+        reduction = ogs_min(reduction, MAX_OVERLOAD_REDUCTION);
+
+        ogs_sbi_self()->load_control.oci_expire = now +
+            ogs_time_from_sec(ogs_app()->sbi.server.overload_validity);
+    } else if (ogs_sbi_self()->load_control.oci_expire) {
+        /* Announce the end of overload until the last OCI expires */
+        if (now < ogs_sbi_self()->load_control.oci_expire)
+            reduction = 0;
+        else
+            ogs_sbi_self()->load_control.oci_expire = 0;
+    }
+
+    if (reduction >= 0) {
+        lc.reduction = reduction;
+        lc.validity = ogs_app()->sbi.server.overload_validity;
+        if (ogs_sbi_build_load_control(
+                    value, sizeof(value), &lc, wallclock, true) == true)
+            ogs_sbi_header_set(
+                    response->http.headers, OGS_SBI_CUSTOM_OCI, value);
+    }
+}
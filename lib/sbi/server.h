@@ -39,6 +39,12 @@ typedef struct ogs_sbi_server_s {
 
     SSL_CTX *ssl_ctx;
 
+    /*
+     * Called with each complete request. With sbi.server.io_thread set,
+     * it runs in the I/O thread owning the connection, so it must only
+     * hand the request over to the NF thread as ogs_sbi_server_handler()
+     * does. Responses are sent from the NF thread.
+     */
     int (*cb)(ogs_sbi_request_t *request, void *data);
     ogs_list_t      session_list;
 
@@ -59,6 +65,8 @@ typedef struct ogs_sbi_server_actions_s {
             ogs_sbi_stream_t *stream, ogs_sbi_response_t *response);
 
     ogs_sbi_server_t *(*from_stream)(ogs_sbi_stream_t *stream);
+    /* NULL if the stream has already been removed */
+    ogs_sbi_request_t *(*request_from_stream)(ogs_sbi_stream_t *stream);
 } ogs_sbi_server_actions_t;
 
 void ogs_sbi_server_init(int num_of_session_pool, int num_of_stream_pool);
@@ -156,6 +156,10 @@ typedef enum {
 #define OGS_SBI_SERVICE_NAME_NAMF_CALLBACK "namf-callback"
 #define OGS_SBI_SERVICE_NAME_NSMF_CALLBACK "nsmf-callback"
 
+/* Callback URIs are not NF services, but are routed like one */
+#define OGS_SBI_SERVICE_TYPE_NAMF_CALLBACK (OGS_SBI_MAX_NUM_OF_SERVICE_TYPE+0)
+#define OGS_SBI_SERVICE_TYPE_NSMF_CALLBACK (OGS_SBI_MAX_NUM_OF_SERVICE_TYPE+1)
+
 OpenAPI_nf_type_e ogs_sbi_service_type_to_nf_type(
         ogs_sbi_service_type_e service_type);
 const char *ogs_sbi_service_type_to_name(ogs_sbi_service_type_e service_type);
@@ -234,6 +234,50 @@ int ogs_sctp_sendmsg(ogs_sock_t *sock, const void *msg, size_t len,
             0); /* context */
 }
 
+#if HAVE_SENDMMSG
+int ogs_sctp_sendmsgv(ogs_sock_t *sock, ogs_pkbuf_t **pkbuf, int num)
+{
+    struct mmsghdr msgvec[OGS_SCTP_BATCH_SIZE];
+    struct iovec iov[OGS_SCTP_BATCH_SIZE];
+    union {
+        char buf[CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))];
+        struct cmsghdr align;
+    } control[OGS_SCTP_BATCH_SIZE];
+    struct cmsghdr *cmsg = NULL;
+    struct sctp_sndrcvinfo *sinfo = NULL;
+    int i;
+
+    ogs_assert(sock);
+    ogs_assert(pkbuf);
+    ogs_assert(num > 0 && num <= OGS_SCTP_BATCH_SIZE);
+
+    memset(msgvec, 0, sizeof(struct mmsghdr) * num);
+    memset(control, 0, sizeof(control[0]) * num);
+
+    for (i = 0; i < num; i++) {
+        iov[i].iov_base = pkbuf[i]->data;
+        iov[i].iov_len = pkbuf[i]->len;
+
+        msgvec[i].msg_hdr.msg_iov = &iov[i];
+        msgvec[i].msg_hdr.msg_iovlen = 1;
+        msgvec[i].msg_hdr.msg_control = control[i].buf;
+        msgvec[i].msg_hdr.msg_controllen = sizeof(control[i].buf);
+
+        /* Same ancillary data as sctp_sendmsg() */
+        cmsg = CMSG_FIRSTHDR(&msgvec[i].msg_hdr);
+        cmsg->cmsg_level = IPPROTO_SCTP;
+        cmsg->cmsg_type = SCTP_SNDRCV;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(struct sctp_sndrcvinfo));
+
+        sinfo = (struct sctp_sndrcvinfo *)CMSG_DATA(cmsg);
+        sinfo->sinfo_ppid = htobe32(ogs_sctp_ppid_in_pkbuf(pkbuf[i]));
+        sinfo->sinfo_stream = ogs_sctp_stream_no_in_pkbuf(pkbuf[i]);
+    }
+
+    return sendmmsg(sock->fd, msgvec, num, 0);
+}
+#endif
+
 int ogs_sctp_recvmsg(ogs_sock_t *sock, void *msg, size_t len,
         ogs_sockaddr_t *from, ogs_sctp_info_t *sinfo, int *msg_flags)
 {
@@ -251,8 +295,10 @@ int ogs_sctp_recvmsg(ogs_sock_t *sock, void *msg, size_t len,
     size = sctp_recvmsg(sock->fd, msg, len, &addr.sa, &addrlen,
                 &sndrcvinfo, &flags);
     if (size < 0) {
-        ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
-                "sctp_recvmsg(%d) failed", size);
+        /* Nothing left to read on a non-blocking socket */
+        if (ogs_socket_errno != OGS_EAGAIN)
+            ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                    "sctp_recvmsg(%d) failed", size);
         return size;
     }
 
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-sctp.h"
+
+/*
+ * SCTP I/O threads
+ *
+ * Every SOCK_STREAM association handed to ogs_sctp_worker_add() is pinned
+ * to one thread for its lifetime. The thread runs the NF's receive handler
+ * for the socket, which may call ogs_sctp_worker_decode() so that the
+ * protocol decoder runs there too. The decoded message is handed to the
+ * NF thread, which runs the state machines and sends as before. The NF
+ * thread talks to a worker only through its command queue.
+ */
+typedef struct ogs_sctp_worker_s {
+    ogs_thread_t    *thread;
+
+    ogs_pollset_t   *pollset;
+    ogs_queue_t     *queue;
+
+    int             num_of_conn;    /* NF thread only */
+    ogs_list_t      conn_list;      /* Worker thread only */
+} ogs_sctp_worker_t;
+
+struct ogs_sctp_conn_s {
+    ogs_lnode_t     lnode;
+
+    ogs_sctp_worker_t *worker;
+    ogs_sock_t      *sock;
+    ogs_poll_t      *poll;          /* Worker thread only */
+};
+
+typedef enum {
+    OGS_SCTP_WORKER_ADD = 1,
+    OGS_SCTP_WORKER_REMOVE,
+    OGS_SCTP_WORKER_STOP,
+} ogs_sctp_worker_command_e;
+
+typedef struct ogs_sctp_worker_command_s {
+    ogs_sctp_worker_command_e type;
+    ogs_sctp_conn_t *conn;
+} ogs_sctp_worker_command_t;
+
+static void worker_main(void *data);
+static void worker_push(ogs_sctp_worker_t *worker,
+        ogs_sctp_worker_command_e type, ogs_sctp_conn_t *conn);
+static void conn_close(ogs_sctp_conn_t *conn);
+
+static ogs_sctp_worker_t *worker_array;
+static int num_of_worker;
+
+static ogs_poll_handler_f recv_handler;
+static ogs_sctp_decode_f decode_handler;
+static ogs_sctp_message_free_f message_free_handler;
+
+static __thread ogs_sctp_worker_t *worker_self;
+
+int ogs_sctp_worker_open(int num, ogs_poll_handler_f recv,
+        ogs_sctp_decode_f decode, ogs_sctp_message_free_f message_free)
+{
+    int i;
+
+    ogs_assert(recv);
+    ogs_assert(decode);
+    ogs_assert(message_free);
+    ogs_assert(!worker_array);
+
+    if (num <= 0)
+        return OGS_OK;
+
+#if HAVE_USRSCTP
+    ogs_warn("SCTP I/O threads are not supported with usrsctp");
+    return OGS_OK;
+#endif
+
+    recv_handler = recv;
+    decode_handler = decode;
+    message_free_handler = message_free;
+
+    num_of_worker = num;
+
+    worker_array = ogs_calloc(num_of_worker, sizeof(ogs_sctp_worker_t));
+    ogs_assert(worker_array);
+
+    for (i = 0; i < num_of_worker; i++) {
+        ogs_sctp_worker_t *worker = &worker_array[i];
+
+        ogs_list_init(&worker->conn_list);
+
+        worker->pollset = ogs_pollset_create(ogs_app()->pool.socket);
+        ogs_assert(worker->pollset);
+        worker->queue = ogs_queue_create(ogs_app()->pool.socket);
+        ogs_assert(worker->queue);
+
+        worker->thread = ogs_thread_create(worker_main, worker);
+        if (!worker->thread) {
+            ogs_error("ogs_thread_create() failed");
+            return OGS_ERROR;
+        }
+    }
+
+    return OGS_OK;
+}
+
+void ogs_sctp_worker_close(void)
+{
+    int i;
+
+    if (!worker_array)
+        return;
+
+    for (i = 0; i < num_of_worker; i++) {
+        if (worker_array[i].thread)
+            worker_push(&worker_array[i], OGS_SCTP_WORKER_STOP, NULL);
+    }
+
+    for (i = 0; i < num_of_worker; i++) {
+        ogs_sctp_worker_t *worker = &worker_array[i];
+        ogs_sctp_conn_t *conn = NULL, *next_conn = NULL;
+
+        if (worker->thread)
+            ogs_thread_destroy(worker->thread);
+
+        /* Associations that were never destroyed */
+        ogs_list_for_each_safe(&worker->conn_list, next_conn, conn) {
+            ogs_list_remove(&worker->conn_list, conn);
+            conn_close(conn);
+        }
+
+        ogs_queue_destroy(worker->queue);
+        ogs_pollset_destroy(worker->pollset);
+    }
+
+    ogs_free(worker_array);
+    worker_array = NULL;
+    num_of_worker = 0;
+
+    recv_handler = NULL;
+    decode_handler = NULL;
+    message_free_handler = NULL;
+}
+
+bool ogs_sctp_worker_is_enabled(void)
+{
+    return worker_array != NULL;
+}
+
+bool ogs_sctp_worker_in_thread(void)
+{
+    return worker_self != NULL;
+}
+
+void ogs_sctp_worker_add(ogs_sctp_sock_t *sctp)
+{
+    ogs_sctp_worker_t *worker = NULL;
+    ogs_sctp_conn_t *conn = NULL;
+    int i;
+
+    ogs_assert(sctp);
+    ogs_assert(sctp->sock);
+    ogs_assert(!sctp->conn);
+    ogs_assert(worker_array);
+
+    /* Pin the association to the least loaded thread */
+    worker = &worker_array[0];
+    for (i = 1; i < num_of_worker; i++) {
+        if (worker_array[i].num_of_conn < worker->num_of_conn)
+            worker = &worker_array[i];
+    }
+
+    conn = ogs_calloc(1, sizeof(*conn));
+    ogs_assert(conn);
+
+    conn->worker = worker;
+    conn->sock = sctp->sock;
+
+    worker->num_of_conn++;
+    sctp->conn = conn;
+
+    worker_push(worker, OGS_SCTP_WORKER_ADD, conn);
+}
+
+/* Called by ogs_sctp_flush_and_destroy() once the write side is gone */
+void ogs_sctp_worker_remove(ogs_sctp_conn_t *conn)
+{
+    ogs_assert(conn);
+    ogs_assert(conn->worker);
+
+    conn->worker->num_of_conn--;
+
+    /* The worker closes the socket */
+    worker_push(conn->worker, OGS_SCTP_WORKER_REMOVE, conn);
+}
+
+void *ogs_sctp_worker_decode(ogs_pkbuf_t *pkbuf)
+{
+    ogs_assert(pkbuf);
+
+    if (!worker_self)
+        return NULL;
+
+    ogs_assert(decode_handler);
+    return decode_handler(pkbuf);
+}
+
+void ogs_sctp_worker_message_free(void *message)
+{
+    ogs_assert(message);
+    ogs_assert(message_free_handler);
+
+    message_free_handler(message);
+}
+
+static void worker_main(void *data)
+{
+    ogs_sctp_worker_t *worker = data;
+    int rv;
+
+    ogs_assert(worker);
+    worker_self = worker;
+
+    for ( ;; ) {
+        ogs_pollset_poll(worker->pollset, OGS_INFINITE_TIME);
+
+        for ( ;; ) {
+            ogs_sctp_worker_command_t *cmd = NULL;
+            ogs_sctp_conn_t *conn = NULL;
+
+            rv = ogs_queue_trypop(worker->queue, (void**)&cmd);
+            ogs_assert(rv != OGS_ERROR);
+
+            if (rv == OGS_DONE)
+                return;
+
+            if (rv == OGS_RETRY)
+                break;
+
+            ogs_assert(cmd);
+            conn = cmd->conn;
+
+            switch (cmd->type) {
+            case OGS_SCTP_WORKER_ADD:
+                ogs_assert(conn);
+                conn->poll = ogs_pollset_add(worker->pollset,
+                        OGS_POLLIN, conn->sock->fd, recv_handler,
+                        conn->sock);
+                ogs_assert(conn->poll);
+                ogs_list_add(&worker->conn_list, conn);
+                break;
+            case OGS_SCTP_WORKER_REMOVE:
+                ogs_assert(conn);
+                ogs_list_remove(&worker->conn_list, conn);
+                conn_close(conn);
+                break;
+            case OGS_SCTP_WORKER_STOP:
+                ogs_free(cmd);
+                return;
+            default:
+                ogs_fatal("Unknown command[%d]", cmd->type);
+                ogs_assert_if_reached();
+            }
+
+            ogs_free(cmd);
+        }
+    }
+}
+
+static void worker_push(ogs_sctp_worker_t *worker,
+        ogs_sctp_worker_command_e type, ogs_sctp_conn_t *conn)
+{
+    ogs_sctp_worker_command_t *cmd = NULL;
+    int rv;
+
+    ogs_assert(worker);
+
+    cmd = ogs_calloc(1, sizeof(*cmd));
+    ogs_assert(cmd);
+
+    cmd->type = type;
+    cmd->conn = conn;
+
+    rv = ogs_queue_push(worker->queue, cmd);
+    ogs_assert(rv == OGS_OK);
+
+    ogs_pollset_notify(worker->pollset);
+}
+
+static void conn_close(ogs_sctp_conn_t *conn)
+{
+    ogs_assert(conn);
+
+    if (conn->poll)
+        ogs_pollset_remove(conn->poll);
+    ogs_sctp_destroy(conn->sock);
+
+    ogs_free(conn);
+}
@@ -74,6 +74,14 @@ int ogs_sctp_senddata(ogs_sock_t *sock,
     return OGS_OK;
 }
 
+/*
+ * SOCK_STREAM associations queue their messages. The NF thread calls
+ * ogs_sctp_flush_all() once per loop iteration, so everything queued by
+ * one batch of events leaves in as few system calls as possible.
+ * An association the kernel cannot take more from waits for POLLOUT.
+ */
+static OGS_LIST(pending_list);
+
 void ogs_sctp_write_to_buffer(ogs_sctp_sock_t *sctp, ogs_pkbuf_t *pkbuf)
 {
     ogs_assert(sctp);
@@ -81,34 +89,111 @@ void ogs_sctp_write_to_buffer(ogs_sctp_sock_t *sctp, ogs_pkbuf_t *pkbuf)
 
     ogs_list_add(&sctp->write_queue, pkbuf);
 
-    if (!sctp->poll.write) {
-        ogs_assert(sctp->sock);
-        sctp->poll.write = ogs_pollset_add(ogs_app()->pollset,
-            OGS_POLLOUT, sctp->sock->fd, sctp_write_callback, sctp);
-        ogs_assert(sctp->poll.write);
+    if (!sctp->poll.write && !sctp->pending) {
+        ogs_list_add(&pending_list, sctp);
+        sctp->pending = true;
+    }
+}
+
+static int sctp_flush(ogs_sctp_sock_t *sctp)
+{
+    ogs_pkbuf_t *pkbuf[OGS_SCTP_BATCH_SIZE];
+    ogs_pkbuf_t *next = NULL, *drop = NULL;
+    int i, num, sent;
+
+    ogs_assert(sctp);
+    ogs_assert(sctp->sock);
+
+    while (ogs_list_empty(&sctp->write_queue) == false) {
+        num = 0;
+        ogs_list_for_each(&sctp->write_queue, next) {
+            pkbuf[num++] = next;
+            if (num == OGS_SCTP_BATCH_SIZE)
+                break;
+        }
+
+        sent = ogs_sctp_sendmsgv(sctp->sock, pkbuf, num);
+        if (sent < 0) {
+            if (ogs_socket_errno == OGS_EAGAIN)
+                return OGS_RETRY;
+
+            /*
+             * The association is broken and nothing behind the refused
+             * message gets through either. Drop them all; the read side
+             * reports the failure and the NF removes the peer.
+             */
+            ogs_log_message(OGS_LOG_ERROR, ogs_socket_errno,
+                    "ogs_sctp_sendmsgv(len:%d,ssn:%d) drops %d message(s)",
+                    pkbuf[0]->len, (int)ogs_sctp_stream_no_in_pkbuf(pkbuf[0]),
+                    ogs_list_count(&sctp->write_queue));
+
+            ogs_list_for_each_safe(&sctp->write_queue, next, drop) {
+                ogs_list_remove(&sctp->write_queue, drop);
+                ogs_pkbuf_free(drop);
+            }
+
+            return OGS_ERROR;
+        }
+
+        for (i = 0; i < sent; i++) {
+            ogs_list_remove(&sctp->write_queue, pkbuf[i]);
+            ogs_pkbuf_free(pkbuf[i]);
+        }
+    }
+
+    return OGS_OK;
+}
+
+void ogs_sctp_flush_all(void)
+{
+    ogs_sctp_sock_t *sctp = NULL, *next_sctp = NULL;
+
+    ogs_list_for_each_safe(&pending_list, next_sctp, sctp) {
+        ogs_list_remove(&pending_list, sctp);
+        sctp->pending = false;
+
+        if (sctp_flush(sctp) == OGS_RETRY) {
+            ogs_assert(!sctp->poll.write);
+            sctp->poll.write = ogs_pollset_add(ogs_app()->pollset,
+                OGS_POLLOUT, sctp->sock->fd, sctp_write_callback, sctp);
+            ogs_assert(sctp->poll.write);
+        }
     }
 }
 
 static void sctp_write_callback(short when, ogs_socket_t fd, void *data)
 {
     ogs_sctp_sock_t *sctp = data;
-    ogs_pkbuf_t *pkbuf = NULL;
 
     ogs_assert(sctp);
-    if (ogs_list_empty(&sctp->write_queue) == true) {
+
+    if (sctp_flush(sctp) != OGS_RETRY) {
         ogs_assert(sctp->poll.write);
         ogs_pollset_remove(sctp->poll.write);
         sctp->poll.write = NULL;
-        return;
     }
+}
 
-    pkbuf = ogs_list_first(&sctp->write_queue);
+#if HAVE_USRSCTP || !HAVE_SENDMMSG
+int ogs_sctp_sendmsgv(ogs_sock_t *sock, ogs_pkbuf_t **pkbuf, int num)
+{
+    int i, sent;
+
+    ogs_assert(sock);
     ogs_assert(pkbuf);
-    ogs_list_remove(&sctp->write_queue, pkbuf);
+    ogs_assert(num > 0);
+
+    for (i = 0; i < num; i++) {
+        sent = ogs_sctp_sendmsg(sock, pkbuf[i]->data, pkbuf[i]->len, NULL,
+                ogs_sctp_ppid_in_pkbuf(pkbuf[i]),
+                ogs_sctp_stream_no_in_pkbuf(pkbuf[i]));
+        if (sent < 0)
+            return i ? i : sent;
+    }
 
-    ogs_assert(sctp->sock);
-    ogs_sctp_senddata(sctp->sock, pkbuf, NULL);
+    return num;
 }
+#endif
 
 void ogs_sctp_flush_and_destroy(ogs_sctp_sock_t *sctp)
 {
@@ -119,14 +204,28 @@ void ogs_sctp_flush_and_destroy(ogs_sctp_sock_t *sctp)
     ogs_assert(sctp->addr);
     ogs_free(sctp->addr);
 
+    if (sctp->pending) {
+        ogs_list_remove(&pending_list, sctp);
+        sctp->pending = false;
+    }
+
     if (sctp->type == SOCK_STREAM) {
-        ogs_assert(sctp->poll.read);
-        ogs_pollset_remove(sctp->poll.read);
+        if (sctp->poll.read)
+            ogs_pollset_remove(sctp->poll.read);
 
         if (sctp->poll.write)
             ogs_pollset_remove(sctp->poll.write);
 
-        ogs_sctp_destroy(sctp->sock);
+        /*
+         * The write poll is gone while the socket is still open.
+         * An I/O thread reading the socket closes it itself.
+         */
+        if (sctp->conn) {
+            ogs_sctp_worker_remove(sctp->conn);
+            sctp->conn = NULL;
+        } else if (sctp->sock) {
+            ogs_sctp_destroy(sctp->sock);
+        }
 
         ogs_list_for_each_safe(&sctp->write_queue, next_pkbuf, pkbuf) {
             ogs_list_remove(&sctp->write_queue, pkbuf);
@@ -51,6 +51,9 @@ extern int __ogs_sctp_domain;
 #define ogs_sctp_ppid_in_pkbuf(__pkBUF)         (__pkBUF)->param[0]
 #define ogs_sctp_stream_no_in_pkbuf(__pkBUF)    (__pkBUF)->param[1]
 
+/* Messages per multi-message send, and reads per readiness event */
+#define OGS_SCTP_BATCH_SIZE             64
+
 #if HAVE_USRSCTP
 
 #undef MSG_NOTIFICATION
@@ -80,7 +83,12 @@ ogs_sock_t *ogs_sctp_accept(ogs_sock_t *sock);
 
 #endif
 
+typedef struct ogs_sctp_conn_s ogs_sctp_conn_t;
+
 typedef struct ogs_sctp_sock_s {
+    ogs_lnode_t     lnode;          /* Waiting for ogs_sctp_flush_all() */
+    bool            pending;
+
     int             type;           /* SOCK_STREAM or SOCK_SEQPACKET */
 
     ogs_sock_t      *sock;          /* Socket */
@@ -92,6 +100,8 @@ typedef struct ogs_sctp_sock_s {
     } poll;
 
     ogs_list_t      write_queue;    /* Write Queue for Sending S1AP message */
+
+    ogs_sctp_conn_t *conn;          /* Read side in an SCTP I/O thread */
 } ogs_sctp_sock_t;
 
 typedef struct ogs_sctp_info_s {
@@ -123,6 +133,7 @@ int ogs_sctp_so_linger(ogs_sock_t *sock, int l_linger);
 
 int ogs_sctp_sendmsg(ogs_sock_t *sock, const void *msg, size_t len,
         ogs_sockaddr_t *to, uint32_t ppid, uint16_t stream_no);
+int ogs_sctp_sendmsgv(ogs_sock_t *sock, ogs_pkbuf_t **pkbuf, int num);
 int ogs_sctp_recvmsg(ogs_sock_t *sock, void *msg, size_t len,
         ogs_sockaddr_t *from, ogs_sctp_info_t *sinfo, int *msg_flags);
 int ogs_sctp_recvdata(ogs_sock_t *sock, void *msg, size_t len,
@@ -131,8 +142,26 @@ int ogs_sctp_recvdata(ogs_sock_t *sock, void *msg, size_t len,
 int ogs_sctp_senddata(ogs_sock_t *sock,
         ogs_pkbuf_t *pkbuf, ogs_sockaddr_t *addr);
 void ogs_sctp_write_to_buffer(ogs_sctp_sock_t *sctp, ogs_pkbuf_t *pkbuf);
+void ogs_sctp_flush_all(void);
 void ogs_sctp_flush_and_destroy(ogs_sctp_sock_t *sctp);
 
+/* Returns the decoded message, or NULL to leave it to the NF thread */
+typedef void *(*ogs_sctp_decode_f)(ogs_pkbuf_t *pkbuf);
+typedef void (*ogs_sctp_message_free_f)(void *message);
+
+int ogs_sctp_worker_open(int num_of_worker, ogs_poll_handler_f recv,
+        ogs_sctp_decode_f decode, ogs_sctp_message_free_f message_free);
+void ogs_sctp_worker_close(void);
+
+bool ogs_sctp_worker_is_enabled(void);
+bool ogs_sctp_worker_in_thread(void);
+
+void ogs_sctp_worker_add(ogs_sctp_sock_t *sctp);
+void ogs_sctp_worker_remove(ogs_sctp_conn_t *conn);
+
+void *ogs_sctp_worker_decode(ogs_pkbuf_t *pkbuf);
+void ogs_sctp_worker_message_free(void *message);
+
 #ifdef __cplusplus
 }
 #endif
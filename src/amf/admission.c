@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "ngap-path.h"
+#include "ngap-build.h"
+#include "ngap-worker.h"
+#include "gmm-build.h"
+#include "admission.h"
+
+/*
+ * Admission control
+ *
+ * amf_main() dispatches SBI, timer and NGAP messages of existing UE
+ * contexts as they come. An InitialUEMessage starts a new procedure,
+ * so it is parked in a backlog and at most amf.admission.quantum of
+ * them are dispatched per main loop iteration, after everything else.
+ *
+ * With amf.admission.rate set, a Registration Request of an unknown UE
+ * takes a token from the gNB's bucket, refilled at `rate` per second up
+ * to `burst`. Without a token the UE gets Registration Reject #22 with
+ * T3346. Once the backlog reaches amf.admission.overload, every gNB gets
+ * NGAP Overload Start, and Overload Stop when it has drained to half.
+ */
+
+static ogs_queue_t *backlog = NULL;
+static bool overloaded = false;
+
+void amf_admission_init(void)
+{
+    backlog = ogs_queue_create(ogs_app()->pool.event);
+    ogs_assert(backlog);
+
+    overloaded = false;
+}
+
+void amf_admission_final(void)
+{
+    amf_event_t *e = NULL;
+
+    ogs_assert(backlog);
+
+    while (ogs_queue_trypop(backlog, (void **)&e) == OGS_OK) {
+        ogs_assert(e);
+        if (e->ngap.message)
+            amf_ngap_worker_message_free(e);
+        ogs_free(e->ngap.addr);
+        ogs_pkbuf_free(e->pkbuf);
+        ogs_event_free(e);
+    }
+
+    ogs_queue_destroy(backlog);
+    backlog = NULL;
+}
+
+static bool is_initial_ue_message(amf_event_t *e)
+{
+    ogs_pkbuf_t *pkbuf = NULL;
+
+    ogs_assert(e);
+
+    if (e->h.id != AMF_EVENT_NGAP_MESSAGE)
+        return false;
+
+    if (e->ngap.message) {
+        /* Decoded by an NGAP I/O thread */
+        return e->ngap.message->present ==
+                NGAP_NGAP_PDU_PR_initiatingMessage &&
+            e->ngap.message->choice.initiatingMessage->procedureCode ==
+                NGAP_ProcedureCode_id_InitialUEMessage;
+    }
+
+    /* APER: initiatingMessage choice, then the octet-aligned procedureCode */
+    pkbuf = e->pkbuf;
+    return pkbuf && pkbuf->len >= 2 &&
+        pkbuf->data[0] == 0x00 &&
+        pkbuf->data[1] == NGAP_ProcedureCode_id_InitialUEMessage;
+}
+
+bool amf_admission_defer(amf_event_t *e)
+{
+    int rv;
+
+    ogs_assert(backlog);
+    ogs_assert(e);
+
+    if (is_initial_ue_message(e) == false)
+        return false;
+
+    rv = ogs_queue_trypush(backlog, e);
+    if (rv != OGS_OK) {
+        ogs_warn("Admission backlog is full, dispatch it now");
+        return false;
+    }
+
+    return true;
+}
+
+amf_event_t *amf_admission_pop(void)
+{
+    amf_event_t *e = NULL;
+
+    ogs_assert(backlog);
+
+    if (ogs_queue_trypop(backlog, (void **)&e) != OGS_OK)
+        return NULL;
+
+    return e;
+}
+
+/* Returns the number of InitialUEMessages dispatched to 'sm' */
+int amf_admission_dispatch(ogs_fsm_t *sm)
+{
+    int i;
+
+    ogs_assert(sm);
+
+    for (i = 0; i < amf_self()->admission.quantum; i++) {
+        amf_event_t *e = amf_admission_pop();
+        if (!e)
+            break;
+
+        ogs_fsm_dispatch(sm, e);
+        ogs_event_free(e);
+    }
+
+    return i;
+}
+
+unsigned int amf_admission_backlog(void)
+{
+    ogs_assert(backlog);
+    return ogs_queue_size(backlog);
+}
+
+bool amf_admission_overloaded(void)
+{
+    return overloaded;
+}
+
+void amf_admission_run(void)
+{
+    amf_gnb_t *gnb = NULL;
+    unsigned int size;
+    int overload = amf_self()->admission.overload;
+    int r;
+
+    if (overload == 0)
+        return;
+
+    size = amf_admission_backlog();
+
+    if (overloaded == false && size >= (unsigned int)overload) {
+        ogs_warn("Overload start [backlog:%u]", size);
+        overloaded = true;
+
+        ogs_list_for_each(&amf_self()->gnb_list, gnb) {
+            if (gnb->state.ng_setup_success == false)
+                continue;
+            r = ngap_send_overload_start(gnb,
+                    NGAP_OverloadAction_reject_rrc_cr_signalling);
+            ogs_expect(r == OGS_OK);
+        }
+    } else if (overloaded == true && size <= (unsigned int)overload / 2) {
+        ogs_warn("Overload stop [backlog:%u]", size);
+        overloaded = false;
+
+        ogs_list_for_each(&amf_self()->gnb_list, gnb) {
+            if (gnb->state.ng_setup_success == false)
+                continue;
+            r = ngap_send_overload_stop(gnb);
+            ogs_expect(r == OGS_OK);
+        }
+    }
+}
+
+bool amf_admission_take_token(amf_gnb_t *gnb, ogs_time_t now)
+{
+    int rate = amf_self()->admission.rate;
+    int burst = amf_self()->admission.burst;
+    ogs_time_t add;
+
+    ogs_assert(gnb);
+
+    if (rate == 0)
+        return true;
+
+    add = (now - gnb->admission.refill) * rate / OGS_USEC_PER_SEC;
+    if (add > 0) {
+        if (gnb->admission.tokens + add >= burst) {
+            gnb->admission.tokens = burst;
+            gnb->admission.refill = now;
+        } else {
+            gnb->admission.tokens += add;
+            /* Keep the remainder for the next token */
+            gnb->admission.refill += add * OGS_USEC_PER_SEC / rate;
+        }
+    }
+
+    if (gnb->admission.tokens == 0)
+        return false;
+
+    gnb->admission.tokens--;
+    return true;
+}
+
+bool amf_admission_accept(ran_ue_t *ran_ue)
+{
+    int r;
+    ogs_pkbuf_t *gmmbuf = NULL, *ngapbuf = NULL;
+
+    ogs_assert(ran_ue);
+
+    if (amf_admission_take_token(
+                ran_ue->gnb, ogs_get_monotonic_time()) == true)
+        return true;
+
+    ogs_warn("Registration not admitted [RAN_UE_NGAP_ID:%d,T3346:%d]",
+            ran_ue->ran_ue_ngap_id, (int)amf_self()->admission.t3346);
+
+    gmmbuf = gmm_build_registration_reject(
+            OGS_5GMM_CAUSE_CONGESTION, amf_self()->admission.t3346);
+    if (!gmmbuf) {
+        ogs_error("gmm_build_registration_reject() failed");
+    } else {
+        ngapbuf = ngap_build_downlink_nas_transport(
+                ran_ue, gmmbuf, false, false);
+        if (!ngapbuf) {
+            ogs_error("ngap_build_downlink_nas_transport() failed");
+        } else {
+            r = ngap_send_to_ran_ue(ran_ue, ngapbuf);
+            ogs_expect(r == OGS_OK);
+        }
+    }
+
+    r = ngap_send_ran_ue_context_release_command(ran_ue,
+            NGAP_Cause_PR_misc, NGAP_CauseMisc_control_processing_overload,
+            NGAP_UE_CTX_REL_NG_CONTEXT_REMOVE, 0);
+    ogs_expect(r == OGS_OK);
+    ogs_assert(r != OGS_ERROR);
+
+    return false;
+}
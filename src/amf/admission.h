@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef AMF_ADMISSION_H
+#define AMF_ADMISSION_H
+
+#include "context.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void amf_admission_init(void);
+void amf_admission_final(void);
+
+bool amf_admission_defer(amf_event_t *e);
+amf_event_t *amf_admission_pop(void);
+int amf_admission_dispatch(ogs_fsm_t *sm);
+unsigned int amf_admission_backlog(void);
+void amf_admission_run(void);
+
+bool amf_admission_overloaded(void);
+bool amf_admission_take_token(amf_gnb_t *gnb, ogs_time_t now);
+bool amf_admission_accept(ran_ue_t *ran_ue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMF_ADMISSION_H */
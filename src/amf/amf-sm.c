@@ -26,6 +26,9 @@
 #include "nsmf-handler.h"
 #include "nnssf-handler.h"
 #include "nas-security.h"
+#include "paging.h"
+#include "admission.h"
+#include "ngap-worker.h"
 
 void amf_state_initial(ogs_fsm_t *s, amf_event_t *e)
 {
@@ -48,13 +51,14 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
     int r, rv;
     char buf[OGS_ADDRSTRLEN];
     const char *api_version = NULL;
+    int version = 0;
 
     ogs_sock_t *sock = NULL;
     ogs_sockaddr_t *addr = NULL;
     amf_gnb_t *gnb = NULL;
     uint16_t max_num_of_ostreams = 0;
 
-    ogs_ngap_message_t ngap_message;
+    ogs_ngap_message_t ngap_message, *ngap_message_ptr = NULL;
     ogs_pkbuf_t *pkbuf = NULL;
     int rc;
 
@@ -103,16 +107,17 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
             break;
         }
 
-        SWITCH(sbi_message.h.service.name)
-        CASE(OGS_SBI_SERVICE_NAME_NUDM_SDM)
-            api_version = OGS_SBI_API_V2;
+        ogs_sbi_route_resolve(&sbi_message.route, &sbi_message.h);
+
+        switch (sbi_message.route.service) {
+        case OGS_SBI_SERVICE_TYPE_NUDM_SDM:
+            version = 2;
             break;
-        DEFAULT
-            api_version = OGS_SBI_API_V1;
-        END
+        default:
+            version = 1;
+        }
 
-        ogs_assert(api_version);
-        if (strcmp(sbi_message.h.api.version, api_version) != 0) {
+        if (sbi_message.route.version != version) {
             ogs_error("Not supported version [%s]", sbi_message.h.api.version);
             ogs_assert(true ==
                 ogs_sbi_server_send_error(
@@ -122,26 +127,26 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
             break;
         }
 
-        SWITCH(sbi_message.h.service.name)
-        CASE(OGS_SBI_SERVICE_NAME_NNRF_NFM)
+        switch (sbi_message.route.service) {
+        case OGS_SBI_SERVICE_TYPE_NNRF_NFM:
 
-            SWITCH(sbi_message.h.resource.component[0])
-            CASE(OGS_SBI_RESOURCE_NAME_NF_STATUS_NOTIFY)
-                SWITCH(sbi_message.h.method)
-                CASE(OGS_SBI_HTTP_METHOD_POST)
+            switch (sbi_message.route.component[0]) {
+            case OGS_SBI_RESOURCE_NF_STATUS_NOTIFY:
+                switch (sbi_message.route.method) {
+                case OGS_SBI_METHOD_POST:
                     ogs_nnrf_nfm_handle_nf_status_notify(stream, &sbi_message);
                     break;
 
-                DEFAULT
+                default:
                     ogs_error("Invalid HTTP method [%s]", sbi_message.h.method);
                     ogs_assert(true ==
                         ogs_sbi_server_send_error(stream,
                             OGS_SBI_HTTP_STATUS_FORBIDDEN, &sbi_message,
                             "Invalid HTTP method", sbi_message.h.method));
-                END
+                }
                 break;
 
-            DEFAULT
+            default:
                 ogs_error("Invalid resource name [%s]",
                         sbi_message.h.resource.component[0]);
                 ogs_assert(true ==
@@ -149,16 +154,16 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
                         OGS_SBI_HTTP_STATUS_BAD_REQUEST, &sbi_message,
                         "Invalid resource name",
                         sbi_message.h.resource.component[0]));
-            END
+            }
             break;
 
-        CASE(OGS_SBI_SERVICE_NAME_NAMF_COMM)
-            SWITCH(sbi_message.h.resource.component[0])
-            CASE(OGS_SBI_RESOURCE_NAME_UE_CONTEXTS)
-                SWITCH(sbi_message.h.resource.component[2])
-                CASE(OGS_SBI_RESOURCE_NAME_N1_N2_MESSAGES)
-                    SWITCH(sbi_message.h.method)
-                    CASE(OGS_SBI_HTTP_METHOD_POST)
+        case OGS_SBI_SERVICE_TYPE_NAMF_COMM:
+            switch (sbi_message.route.component[0]) {
+            case OGS_SBI_RESOURCE_UE_CONTEXTS:
+                switch (sbi_message.route.component[2]) {
+                case OGS_SBI_RESOURCE_N1_N2_MESSAGES:
+                    switch (sbi_message.route.method) {
+                    case OGS_SBI_METHOD_POST:
                         rv = amf_namf_comm_handle_n1_n2_message_transfer(
                                 stream, &sbi_message);
                         if (rv != OGS_OK) {
@@ -170,17 +175,17 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
                         }
                         break;
 
-                    DEFAULT
+                    default:
                         ogs_error("Invalid HTTP method [%s]",
                                 sbi_message.h.method);
                         ogs_assert(true ==
                             ogs_sbi_server_send_error(stream,
                                 OGS_SBI_HTTP_STATUS_FORBIDDEN, &sbi_message,
                                 "Invalid HTTP method", sbi_message.h.method));
-                    END
+                    }
                     break;
 
-                DEFAULT
+                default:
                     ogs_error("Invalid resource name [%s]",
                             sbi_message.h.resource.component[2]);
                     ogs_assert(true ==
@@ -188,10 +193,10 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
                             OGS_SBI_HTTP_STATUS_BAD_REQUEST, &sbi_message,
                             "Invalid resource name",
                             sbi_message.h.resource.component[2]));
-                END
+                }
                 break;
 
-            DEFAULT
+            default:
                 ogs_error("Invalid resource name [%s]",
                         sbi_message.h.resource.component[0]);
                 ogs_assert(true ==
@@ -199,30 +204,30 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
                         OGS_SBI_HTTP_STATUS_BAD_REQUEST, &sbi_message,
                         "Invalid resource name",
                         sbi_message.h.resource.component[0]));
-            END
+            }
             break;
 
-        CASE(OGS_SBI_SERVICE_NAME_NAMF_CALLBACK)
-            SWITCH(sbi_message.h.resource.component[1])
-            CASE(OGS_SBI_RESOURCE_NAME_SM_CONTEXT_STATUS)
+        case OGS_SBI_SERVICE_TYPE_NAMF_CALLBACK:
+            switch (sbi_message.route.component[1]) {
+            case OGS_SBI_RESOURCE_SM_CONTEXT_STATUS:
                 amf_namf_callback_handle_sm_context_status(
                         stream, &sbi_message);
                 break;
 
-            CASE(OGS_SBI_RESOURCE_NAME_DEREG_NOTIFY)
+            case OGS_SBI_RESOURCE_DEREG_NOTIFY:
                 amf_namf_callback_handle_dereg_notify(stream, &sbi_message);
                 break;
 
-            CASE(OGS_SBI_RESOURCE_NAME_SDMSUBSCRIPTION_NOTIFY)
+            case OGS_SBI_RESOURCE_SDMSUBSCRIPTION_NOTIFY:
                 amf_namf_callback_handle_sdm_data_change_notify(
                         stream, &sbi_message);
                 break;
 
-            CASE(OGS_SBI_RESOURCE_NAME_AM_POLICY_NOTIFY)
+            case OGS_SBI_RESOURCE_AM_POLICY_NOTIFY:
                 ogs_assert(true == ogs_sbi_send_http_status_no_content(stream));
                 break;
 
-            DEFAULT
+            default:
                 ogs_error("Invalid resource name [%s]",
                         sbi_message.h.resource.component[1]);
                 ogs_assert(true ==
@@ -230,16 +235,16 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
                         OGS_SBI_HTTP_STATUS_BAD_REQUEST, &sbi_message,
                         "Invalid resource name",
                         sbi_message.h.resource.component[1]));
-            END
+            }
             break;
 
-        DEFAULT
+        default:
             ogs_error("Invalid API name [%s]", sbi_message.h.service.name);
             ogs_assert(true ==
                 ogs_sbi_server_send_error(stream,
                     OGS_SBI_HTTP_STATUS_BAD_REQUEST, &sbi_message,
                     "Invalid API name", sbi_message.h.resource.component[0]));
-        END
+        }
 
         /* In lib/sbi/server.c, notify_completed() releases 'request' buffer. */
         ogs_sbi_message_free(&sbi_message);
@@ -764,7 +769,12 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
         max_num_of_ostreams = e->ngap.max_num_of_ostreams;
 
         gnb = amf_gnb_find_by_addr(addr);
-        if (!gnb) {
+        if (!gnb && amf_gnb_sock_type(sock) == SOCK_STREAM) {
+            /* Accepted earlier, the gNB and its socket are already gone */
+            ogs_warn("gNB-N2[%s] already removed", OGS_ADDR(addr, buf));
+            ogs_free(addr);
+            break;
+        } else if (!gnb) {
             gnb = amf_gnb_add(sock, addr);
             ogs_assert(gnb);
         } else {
@@ -812,13 +822,29 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
         gnb = amf_gnb_find_by_addr(addr);
         ogs_free(addr);
 
-        ogs_assert(gnb);
+        if (!gnb) {
+            /* Read by an NGAP I/O thread before the gNB was removed */
+            ogs_warn("gNB-N2 already removed");
+            if (e->ngap.message)
+                amf_ngap_worker_message_free(e);
+            ogs_pkbuf_free(pkbuf);
+            break;
+        }
         ogs_assert(OGS_FSM_STATE(&gnb->sm));
 
-        rc = ogs_ngap_decode(&ngap_message, pkbuf);
+        ngap_message_ptr = e->ngap.message;
+        if (ngap_message_ptr) {
+            /* Decoded by an NGAP I/O thread */
+            ogs_asn_attach(e->ngap.arena);
+            rc = OGS_OK;
+        } else {
+            ngap_message_ptr = &ngap_message;
+            rc = ogs_ngap_decode(ngap_message_ptr, pkbuf);
+        }
+
         if (rc == OGS_OK) {
             e->gnb = gnb;
-            e->ngap.message = &ngap_message;
+            e->ngap.message = ngap_message_ptr;
             ogs_fsm_dispatch(&gnb->sm, e);
         } else {
             ogs_error("Cannot decode NGAP message");
@@ -829,16 +855,17 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
             ogs_assert(r != OGS_ERROR);
         }
 
-        ogs_ngap_free(&ngap_message);
+        ogs_ngap_free(ngap_message_ptr);
+        if (ngap_message_ptr != &ngap_message)
+            ogs_free(ngap_message_ptr);
         ogs_pkbuf_free(pkbuf);
         break;
 
     case AMF_EVENT_NGAP_TIMER:
-        ran_ue = e->ran_ue;
-        ogs_assert(ran_ue);
-
         switch (e->h.timer_id) {
         case AMF_TIMER_NG_DELAYED_SEND:
+            ran_ue = e->ran_ue;
+            ogs_assert(ran_ue);
             gnb = e->gnb;
             ogs_assert(gnb);
             pkbuf = e->pkbuf;
@@ -850,12 +877,17 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
             ogs_timer_delete(e->timer);
             break;
         case AMF_TIMER_NG_HOLDING:
+            ran_ue = e->ran_ue;
+            ogs_assert(ran_ue);
             ogs_warn("Implicit NG release");
             ogs_warn("    RAN_UE_NGAP_ID[%d] AMF_UE_NGAP_ID[%lld]",
                   ran_ue->ran_ue_ngap_id,
                   (long long)ran_ue->amf_ue_ngap_id);
             ngap_handle_ue_context_release_action(ran_ue);
             break;
+        case AMF_TIMER_PAGING:
+            amf_paging_run();
+            break;
         default:
             ogs_error("Unknown timer[%s:%d]",
                     amf_timer_get_name(e->h.timer_id), e->h.timer_id);
@@ -879,6 +911,13 @@ void amf_state_operational(ogs_fsm_t *s, amf_event_t *e)
         if (!amf_ue) {
             amf_ue = amf_ue_find_by_message(&nas_message);
             if (!amf_ue) {
+                if (nas_message.gmm.h.message_type ==
+                        OGS_NAS_5GS_REGISTRATION_REQUEST &&
+                    amf_admission_accept(ran_ue) == false) {
+                    ogs_pkbuf_free(pkbuf);
+                    break;
+                }
+
                 amf_ue = amf_ue_add(ran_ue);
                 if (amf_ue == NULL) {
                     r = ngap_send_ran_ue_context_release_command(
@@ -18,6 +18,10 @@
  */
 
 #include "ngap-path.h"
+#include "paging.h"
+#include "admission.h"
+#include "snapshot.h"
+#include "ngap-worker.h"
 
 static amf_context_t self;
 
@@ -31,6 +35,9 @@ static OGS_POOL(amf_sess_pool, amf_sess_t);
 
 static OGS_POOL(m_tmsi_pool, amf_m_tmsi_t);
 
+static OGS_POOL(amf_tai_index_pool, amf_tai_index_t);
+static OGS_POOL(amf_tai_link_pool, amf_tai_link_t);
+
 static int context_initialized = 0;
 
 static int num_of_ran_ue = 0;
@@ -41,6 +48,8 @@ static void stats_remove_ran_ue(void);
 static void stats_add_amf_session(void);
 static void stats_remove_amf_session(void);
 
+static void gnb_clear_tai_index(amf_gnb_t *gnb);
+
 void amf_context_init(void)
 {
     ogs_assert(context_initialized == 0);
@@ -60,11 +69,23 @@ void amf_context_init(void)
     /* Allocate TWICE the pool to check if maximum number of gNBs is reached */
     ogs_pool_init(&amf_gnb_pool, ogs_app()->max.peer*2);
     ogs_pool_init(&amf_ue_pool, ogs_app()->max.ue);
+    ogs_info("AMF-UE context: %d bytes pooled x %" PRIu64 ", "
+            "%d bytes of subscribed slices per registered UE",
+            (int)sizeof(amf_ue_t), ogs_app()->max.ue,
+            (int)(OGS_MAX_NUM_OF_SLICE * sizeof(ogs_slice_data_t)));
     ogs_pool_init(&ran_ue_pool, ogs_app()->max.ue);
     ogs_pool_init(&amf_sess_pool, ogs_app()->pool.sess);
     ogs_pool_init(&m_tmsi_pool, ogs_app()->max.ue*2);
     ogs_pool_random_id_generate(&m_tmsi_pool);
 
+    ogs_pool_init(&amf_tai_index_pool, ogs_app()->max.peer*2*
+            OGS_MAX_NUM_OF_TAI*OGS_MAX_NUM_OF_BPLMN);
+    ogs_pool_init(&amf_tai_link_pool, ogs_app()->max.peer*2*
+            OGS_MAX_NUM_OF_TAI*OGS_MAX_NUM_OF_BPLMN);
+
+    amf_paging_init();
+    amf_admission_init();
+
     ogs_list_init(&self.gnb_list);
     ogs_list_init(&self.amf_ue_list);
 
@@ -78,6 +99,8 @@ void amf_context_init(void)
     ogs_assert(self.suci_hash);
     self.supi_hash = ogs_hash_make();
     ogs_assert(self.supi_hash);
+    self.tai_index_hash = ogs_hash_make();
+    ogs_assert(self.tai_index_hash);
 
     context_initialized = 1;
 }
@@ -86,6 +109,11 @@ void amf_context_final(void)
 {
     ogs_assert(context_initialized == 1);
 
+    /* Keep the snapshot: UEs removed below are only going away with us */
+    amf_snapshot_close();
+
+    amf_admission_final();
+
     amf_gnb_remove_all();
     amf_ue_remove_all();
 
@@ -100,6 +128,13 @@ void amf_context_final(void)
     ogs_hash_destroy(self.suci_hash);
     ogs_assert(self.supi_hash);
     ogs_hash_destroy(self.supi_hash);
+    ogs_assert(self.tai_index_hash);
+    ogs_hash_destroy(self.tai_index_hash);
+
+    amf_paging_final();
+
+    ogs_pool_final(&amf_tai_link_pool);
+    ogs_pool_final(&amf_tai_index_pool);
 
     ogs_pool_final(&m_tmsi_pool);
     ogs_pool_final(&amf_sess_pool);
@@ -121,6 +156,13 @@ static int amf_context_prepare(void)
 
     self.ngap_port = OGS_NGAP_SCTP_PORT;
 
+    self.paging.interval = ogs_time_from_msec(10);
+
+    self.snapshot.size = 64*1024*1024;
+
+    self.admission.quantum = 64;
+    self.admission.t3346 = 60;
+
     return OGS_OK;
 }
 
@@ -134,6 +176,41 @@ static int amf_context_validation(void)
         return OGS_ERROR;
     }
 
+    if (self.paging.num_of_escalation == 0) {
+        self.paging.escalation[0] = AMF_PAGING_AREA_TAI;
+        self.paging.num_of_escalation = 1;
+    }
+
+    if (self.paging.interval <= 0) {
+        ogs_error("Invalid amf.paging.interval in '%s'", ogs_app()->file);
+        return OGS_ERROR;
+    }
+
+    if (self.admission.quantum <= 0) {
+        ogs_error("Invalid amf.admission.quantum in '%s'", ogs_app()->file);
+        return OGS_ERROR;
+    }
+
+    if (self.admission.rate < 0 || self.admission.overload < 0) {
+        ogs_error("Invalid amf.admission in '%s'", ogs_app()->file);
+        return OGS_ERROR;
+    }
+
+    if (self.admission.burst <= 0)
+        self.admission.burst = self.admission.rate;
+
+    if (ogs_nas_gprs_timer_from_sec(&gprs_timer, self.admission.t3346) !=
+        OGS_OK) {
+        ogs_error("Not support GPRS Timer 2 [%d]",
+                (int)self.admission.t3346);
+        return OGS_ERROR;
+    }
+
+    if (self.snapshot.path && self.snapshot.size == 0) {
+        ogs_error("Invalid amf.snapshot.size in '%s'", ogs_app()->file);
+        return OGS_ERROR;
+    }
+
     if (self.num_of_served_guami == 0) {
         ogs_error("No amf.guami in '%s'", ogs_app()->file);
         return OGS_ERROR;
@@ -975,6 +1052,109 @@ int amf_context_parse_config(void)
                     }
                 } else if (!strcmp(amf_key, "amf_name")) {
                     self.amf_name = ogs_yaml_iter_value(&amf_iter);
+                } else if (!strcmp(amf_key, "ngap_io_thread")) {
+                    const char *v = ogs_yaml_iter_value(&amf_iter);
+                    if (v) self.ngap_io_thread = atoi(v);
+                } else if (!strcmp(amf_key, "paging")) {
+                    ogs_yaml_iter_t paging_iter;
+                    ogs_yaml_iter_recurse(&amf_iter, &paging_iter);
+                    while (ogs_yaml_iter_next(&paging_iter)) {
+                        const char *paging_key =
+                            ogs_yaml_iter_key(&paging_iter);
+                        ogs_assert(paging_key);
+                        if (!strcmp(paging_key, "escalation")) {
+                            ogs_yaml_iter_t escalation_iter;
+                            ogs_yaml_iter_recurse(&paging_iter,
+                                    &escalation_iter);
+                            ogs_assert(ogs_yaml_iter_type(
+                                &escalation_iter) != YAML_MAPPING_NODE);
+
+                            do {
+                                const char *v = NULL;
+                                int area = 0;
+
+                                if (ogs_yaml_iter_type(&escalation_iter) ==
+                                        YAML_SEQUENCE_NODE) {
+                                    if (!ogs_yaml_iter_next(&escalation_iter))
+                                        break;
+                                }
+
+                                v = ogs_yaml_iter_value(&escalation_iter);
+                                if (!v)
+                                    continue;
+
+                                if (!strcmp(v, "last_gnb"))
+                                    area = AMF_PAGING_AREA_LAST_GNB;
+                                else if (!strcmp(v, "tai"))
+                                    area = AMF_PAGING_AREA_TAI;
+                                else if (!strcmp(v, "tai_list"))
+                                    area = AMF_PAGING_AREA_TAI_LIST;
+                                else {
+                                    ogs_warn("unknown paging area `%s`", v);
+                                    continue;
+                                }
+
+                                if (self.paging.num_of_escalation >=
+                                        AMF_MAX_NUM_OF_PAGING_ESCALATION) {
+                                    ogs_warn("Ignore paging area `%s`", v);
+                                    continue;
+                                }
+                                self.paging.escalation[
+                                    self.paging.num_of_escalation++] = area;
+                            } while (ogs_yaml_iter_type(&escalation_iter) ==
+                                    YAML_SEQUENCE_NODE);
+                        } else if (!strcmp(paging_key, "rate")) {
+                            const char *v = ogs_yaml_iter_value(&paging_iter);
+                            if (v) self.paging.rate = atoi(v);
+                        } else if (!strcmp(paging_key, "interval")) {
+                            const char *v = ogs_yaml_iter_value(&paging_iter);
+                            if (v)
+                                self.paging.interval =
+                                    ogs_time_from_msec(atoll(v));
+                        } else
+                            ogs_warn("unknown key `%s`", paging_key);
+                    }
+                } else if (!strcmp(amf_key, "admission")) {
+                    ogs_yaml_iter_t admission_iter;
+                    ogs_yaml_iter_recurse(&amf_iter, &admission_iter);
+                    while (ogs_yaml_iter_next(&admission_iter)) {
+                        const char *admission_key =
+                            ogs_yaml_iter_key(&admission_iter);
+                        const char *v = NULL;
+                        ogs_assert(admission_key);
+                        v = ogs_yaml_iter_value(&admission_iter);
+                        if (!strcmp(admission_key, "quantum")) {
+                            if (v) self.admission.quantum = atoi(v);
+                        } else if (!strcmp(admission_key, "rate")) {
+                            if (v) self.admission.rate = atoi(v);
+                        } else if (!strcmp(admission_key, "burst")) {
+                            if (v) self.admission.burst = atoi(v);
+                        } else if (!strcmp(admission_key, "overload")) {
+                            if (v) self.admission.overload = atoi(v);
+                        } else if (!strcmp(admission_key, "t3346")) {
+                            if (v) self.admission.t3346 = atoll(v);
+                        } else
+                            ogs_warn("unknown key `%s`", admission_key);
+                    }
+                } else if (!strcmp(amf_key, "snapshot")) {
+                    ogs_yaml_iter_t snapshot_iter;
+                    ogs_yaml_iter_recurse(&amf_iter, &snapshot_iter);
+                    while (ogs_yaml_iter_next(&snapshot_iter)) {
+                        const char *snapshot_key =
+                            ogs_yaml_iter_key(&snapshot_iter);
+                        ogs_assert(snapshot_key);
+                        if (!strcmp(snapshot_key, "path")) {
+                            self.snapshot.path =
+                                ogs_yaml_iter_value(&snapshot_iter);
+                        } else if (!strcmp(snapshot_key, "size")) {
+                            const char *v =
+                                ogs_yaml_iter_value(&snapshot_iter);
+                            if (v)
+                                self.snapshot.size =
+                                    (size_t)atoll(v)*1024*1024;
+                        } else
+                            ogs_warn("unknown key `%s`", snapshot_key);
+                    }
                 } else if (!strcmp(amf_key, "sbi")) {
                     /* handle config in sbi library */
                 } else if (!strcmp(amf_key, "service_name")) {
@@ -1155,15 +1335,25 @@ amf_gnb_t *amf_gnb_add(ogs_sock_t *sock, ogs_sockaddr_t *addr)
     gnb->sctp.type = amf_gnb_sock_type(gnb->sctp.sock);
 
     if (gnb->sctp.type == SOCK_STREAM) {
-        gnb->sctp.poll.read = ogs_pollset_add(ogs_app()->pollset,
-            OGS_POLLIN, sock->fd, ngap_recv_upcall, sock);
-        ogs_assert(gnb->sctp.poll.read);
+        if (ogs_sctp_worker_is_enabled()) {
+            ogs_sctp_worker_add(&gnb->sctp);
+        } else {
+            gnb->sctp.poll.read = ogs_pollset_add(ogs_app()->pollset,
+                OGS_POLLIN, sock->fd, ngap_recv_upcall, sock);
+            ogs_assert(gnb->sctp.poll.read);
+        }
     }
 
     gnb->max_num_of_ostreams = 0;
     gnb->ostream_id = 0;
 
     ogs_list_init(&gnb->ran_ue_list);
+    gnb->ran_ue_hash = ogs_hash_make();
+    ogs_assert(gnb->ran_ue_hash);
+    ogs_list_init(&gnb->paging.list);
+
+    gnb->admission.tokens = self.admission.burst;
+    gnb->admission.refill = ogs_get_monotonic_time();
 
     ogs_hash_set(self.gnb_addr_hash,
             gnb->sctp.addr, sizeof(ogs_sockaddr_t), gnb);
@@ -1198,6 +1388,11 @@ void amf_gnb_remove(amf_gnb_t *gnb)
             gnb->sctp.addr, sizeof(ogs_sockaddr_t), NULL);
     ogs_hash_set(self.gnb_id_hash, &gnb->gnb_id, sizeof(gnb->gnb_id), NULL);
 
+    ogs_hash_destroy(gnb->ran_ue_hash);
+
+    gnb_clear_tai_index(gnb);
+    amf_paging_remove_all(gnb);
+
     ogs_sctp_flush_and_destroy(&gnb->sctp);
 
     ogs_pool_free(&amf_gnb_pool, gnb);
@@ -1260,6 +1455,150 @@ amf_gnb_t *amf_gnb_cycle(amf_gnb_t *gnb)
     return ogs_pool_cycle(&amf_gnb_pool, gnb);
 }
 
+static void gnb_clear_tai_index(amf_gnb_t *gnb)
+{
+    int i;
+
+    ogs_assert(gnb);
+
+    for (i = 0; i < gnb->num_of_tai_link; i++) {
+        amf_tai_link_t *link = gnb->tai_link[i];
+        amf_tai_index_t *index = NULL;
+
+        ogs_assert(link);
+        index = link->index;
+        ogs_assert(index);
+
+        ogs_list_remove(&index->link_list, link);
+        ogs_pool_free(&amf_tai_link_pool, link);
+
+        if (ogs_list_first(&index->link_list) == NULL) {
+            ogs_hash_set(self.tai_index_hash,
+                    &index->tai, sizeof(index->tai), NULL);
+            ogs_pool_free(&amf_tai_index_pool, index);
+        }
+    }
+
+    gnb->num_of_tai_link = 0;
+}
+
+static void gnb_add_tai_index(amf_gnb_t *gnb, ogs_5gs_tai_t *tai)
+{
+    amf_tai_index_t *index = NULL;
+    amf_tai_link_t *link = NULL;
+
+    ogs_assert(gnb);
+    ogs_assert(tai);
+
+    index = amf_tai_index_find(tai);
+    if (index) {
+        /* The same TAI may be broadcast more than once */
+        ogs_list_for_each(&index->link_list, link)
+            if (link->gnb == gnb)
+                return;
+    } else {
+        ogs_pool_alloc(&amf_tai_index_pool, &index);
+        if (!index) {
+            ogs_error("Could not allocate tai_index from pool");
+            return;
+        }
+        memset(index, 0, sizeof *index);
+        memcpy(&index->tai, tai, sizeof(index->tai));
+        ogs_list_init(&index->link_list);
+
+        ogs_hash_set(self.tai_index_hash,
+                &index->tai, sizeof(index->tai), index);
+    }
+
+    ogs_pool_alloc(&amf_tai_link_pool, &link);
+    if (!link) {
+        ogs_error("Could not allocate tai_link from pool");
+        if (ogs_list_first(&index->link_list) == NULL) {
+            ogs_hash_set(self.tai_index_hash,
+                    &index->tai, sizeof(index->tai), NULL);
+            ogs_pool_free(&amf_tai_index_pool, index);
+        }
+        return;
+    }
+    memset(link, 0, sizeof *link);
+    link->index = index;
+    link->gnb = gnb;
+
+    ogs_list_add(&index->link_list, link);
+
+    ogs_assert(gnb->num_of_tai_link < (int)OGS_ARRAY_SIZE(gnb->tai_link));
+    gnb->tai_link[gnb->num_of_tai_link++] = link;
+}
+
+/*
+ * Rebuild the TAI index entries of this gNB from its SupportedTAList.
+ * Called whenever NG Setup or RAN Configuration Update rewrites the list.
+ */
+void amf_gnb_update_tai_index(amf_gnb_t *gnb)
+{
+    int i, j;
+    ogs_5gs_tai_t tai;
+
+    ogs_assert(gnb);
+
+    gnb_clear_tai_index(gnb);
+
+    for (i = 0; i < gnb->num_of_supported_ta_list; i++) {
+        for (j = 0; j < gnb->supported_ta_list[i].num_of_bplmn_list; j++) {
+            memset(&tai, 0, sizeof(tai));
+            memcpy(&tai.plmn_id,
+                    &gnb->supported_ta_list[i].bplmn_list[j].plmn_id,
+                    OGS_PLMN_ID_LEN);
+            tai.tac.v = gnb->supported_ta_list[i].tac.v;
+
+            gnb_add_tai_index(gnb, &tai);
+        }
+    }
+}
+
+amf_tai_index_t *amf_tai_index_find(ogs_5gs_tai_t *tai)
+{
+    ogs_assert(tai);
+
+    return (amf_tai_index_t *)ogs_hash_get(
+            self.tai_index_hash, tai, sizeof(*tai));
+}
+
+/*
+ * RAN-UE-NGAP-ID is only unique within a gNB, so each gNB keeps its own
+ * hash. INVALID_UE_NGAP_ID (handover target before the gNB has answered)
+ * is never hashed. If the gNB reuses an ID the newest ran_ue wins,
+ * and an entry is only cleared by the ran_ue it points to.
+ */
+static void ran_ue_hash_set(ran_ue_t *ran_ue)
+{
+    ogs_assert(ran_ue);
+    ogs_assert(ran_ue->gnb);
+
+    if (ran_ue->ran_ue_ngap_id == INVALID_UE_NGAP_ID)
+        return;
+
+    /* Drop a stale entry first: it is keyed on the old ran_ue's memory */
+    ogs_hash_set(ran_ue->gnb->ran_ue_hash, &ran_ue->ran_ue_ngap_id,
+            sizeof(ran_ue->ran_ue_ngap_id), NULL);
+    ogs_hash_set(ran_ue->gnb->ran_ue_hash, &ran_ue->ran_ue_ngap_id,
+            sizeof(ran_ue->ran_ue_ngap_id), ran_ue);
+}
+
+static void ran_ue_hash_clear(ran_ue_t *ran_ue)
+{
+    ogs_assert(ran_ue);
+    ogs_assert(ran_ue->gnb);
+
+    if (ran_ue->ran_ue_ngap_id == INVALID_UE_NGAP_ID)
+        return;
+
+    if (ogs_hash_get(ran_ue->gnb->ran_ue_hash, &ran_ue->ran_ue_ngap_id,
+                sizeof(ran_ue->ran_ue_ngap_id)) == ran_ue)
+        ogs_hash_set(ran_ue->gnb->ran_ue_hash, &ran_ue->ran_ue_ngap_id,
+                sizeof(ran_ue->ran_ue_ngap_id), NULL);
+}
+
 /** ran_ue_context handling function */
 ran_ue_t *ran_ue_add(amf_gnb_t *gnb, uint32_t ran_ue_ngap_id)
 {
@@ -1302,6 +1641,7 @@ ran_ue_t *ran_ue_add(amf_gnb_t *gnb, uint32_t ran_ue_ngap_id)
     ran_ue->gnb = gnb;
 
     ogs_list_add(&gnb->ran_ue_list, ran_ue);
+    ran_ue_hash_set(ran_ue);
 
     stats_add_ran_ue();
 
@@ -1313,6 +1653,7 @@ void ran_ue_remove(ran_ue_t *ran_ue)
     ogs_assert(ran_ue);
     ogs_assert(ran_ue->gnb);
 
+    ran_ue_hash_clear(ran_ue);
     ogs_list_remove(&ran_ue->gnb->ran_ue_list, ran_ue);
 
     ogs_assert(ran_ue->t_ng_holding);
@@ -1330,6 +1671,7 @@ void ran_ue_switch_to_gnb(ran_ue_t *ran_ue, amf_gnb_t *new_gnb)
     ogs_assert(new_gnb);
 
     /* Remove from the old gnb */
+    ran_ue_hash_clear(ran_ue);
     ogs_list_remove(&ran_ue->gnb->ran_ue_list, ran_ue);
 
     /* Add to the new gnb */
@@ -1337,19 +1679,30 @@ void ran_ue_switch_to_gnb(ran_ue_t *ran_ue, amf_gnb_t *new_gnb)
 
     /* Switch to gnb */
     ran_ue->gnb = new_gnb;
+    ran_ue_hash_set(ran_ue);
+
+    if (ran_ue->amf_ue) {
+        ran_ue->amf_ue->last_gnb.presence = true;
+        ran_ue->amf_ue->last_gnb.gnb_id = new_gnb->gnb_id;
+    }
+}
+
+void ran_ue_set_ran_ue_ngap_id(ran_ue_t *ran_ue, uint32_t ran_ue_ngap_id)
+{
+    ogs_assert(ran_ue);
+
+    ran_ue_hash_clear(ran_ue);
+    ran_ue->ran_ue_ngap_id = ran_ue_ngap_id;
+    ran_ue_hash_set(ran_ue);
 }
 
 ran_ue_t *ran_ue_find_by_ran_ue_ngap_id(
         amf_gnb_t *gnb, uint32_t ran_ue_ngap_id)
 {
-    ran_ue_t *ran_ue = NULL;
-
-    ogs_list_for_each(&gnb->ran_ue_list, ran_ue) {
-        if (ran_ue_ngap_id == ran_ue->ran_ue_ngap_id)
-            break;
-    }
+    ogs_assert(gnb);
 
-    return ran_ue;
+    return (ran_ue_t *)ogs_hash_get(gnb->ran_ue_hash,
+            &ran_ue_ngap_id, sizeof(ran_ue_ngap_id));
 }
 
 ran_ue_t *ran_ue_find(uint32_t index)
@@ -1461,9 +1814,11 @@ amf_ue_t *amf_ue_add(ran_ue_t *ran_ue)
     amf_gnb_t *gnb = NULL;
     amf_ue_t *amf_ue = NULL;
 
-    ogs_assert(ran_ue);
-    gnb = ran_ue->gnb;
-    ogs_assert(gnb);
+    /* No RAN UE when restored by amf_snapshot_open() */
+    if (ran_ue) {
+        gnb = ran_ue->gnb;
+        ogs_assert(gnb);
+    }
 
     ogs_pool_alloc(&amf_ue_pool, &amf_ue);
     if (amf_ue == NULL) {
@@ -1572,6 +1927,8 @@ void amf_ue_remove(amf_ue_t *amf_ue)
 
     ogs_assert(amf_ue);
 
+    amf_snapshot_remove(amf_ue);
+
     ogs_list_remove(&self.amf_ue_list, amf_ue);
 
     amf_ue_fsm_fini(amf_ue);
@@ -1617,6 +1974,8 @@ void amf_ue_remove(amf_ue_t *amf_ue)
 
     /* Clear SubscribedInfo */
     amf_clear_subscribed_info(amf_ue);
+    if (amf_ue->slice)
+        ogs_free(amf_ue->slice);
 
     if (amf_ue->policy_association_id)
         ogs_free(amf_ue->policy_association_id);
@@ -1632,7 +1991,7 @@ void amf_ue_remove(amf_ue_t *amf_ue)
     /* Clear Transparent Container */
     OGS_ASN_CLEAR_DATA(&amf_ue->handover.container);
 
-    /* Delete All Timers */
+    /* Delete All Timers, and the Paging messages queued for T3513 */
     CLEAR_AMF_UE_ALL_TIMERS(amf_ue);
     ogs_timer_delete(amf_ue->t3513.timer);
     ogs_timer_delete(amf_ue->t3522.timer);
@@ -1990,6 +2349,10 @@ void amf_ue_associate_ran_ue(amf_ue_t *amf_ue, ran_ue_t *ran_ue)
 
     amf_ue->ran_ue = ran_ue;
     ran_ue->amf_ue = amf_ue;
+
+    ogs_assert(ran_ue->gnb);
+    amf_ue->last_gnb.presence = true;
+    amf_ue->last_gnb.gnb_id = ran_ue->gnb->gnb_id;
 }
 
 void ran_ue_deassociate(ran_ue_t *ran_ue)
@@ -2275,6 +2638,15 @@ bool amf_paging_ongoing(amf_ue_t *amf_ue)
     return false;
 }
 
+/* Stop T3513 and drop the Paging messages still queued for the UE */
+void amf_paging_stop(amf_ue_t *amf_ue)
+{
+    ogs_assert(amf_ue);
+
+    amf_paging_remove_ue(amf_ue);
+    CLEAR_AMF_UE_TIMER(amf_ue->t3513);
+}
+
 bool amf_downlink_signalling_pending(amf_ue_t *amf_ue)
 {
     amf_sess_t *sess = NULL;
@@ -2434,6 +2806,67 @@ amf_m_tmsi_t *amf_m_tmsi_alloc(void)
     return m_tmsi;
 }
 
+/*
+ * Hand out again the M-TMSIs that UEs were given before a restart.
+ *
+ * The pool holds a permutation of the raw values that amf_m_tmsi_alloc()
+ * maps to M-TMSI. The entry holding each wanted value is swapped with the
+ * next free one, which is then allocated. Must be called before any other
+ * M-TMSI is allocated. m_tmsi[i] is NULL if value[i] cannot be restored.
+ */
+int amf_m_tmsi_restore(int num, uint32_t *value, amf_m_tmsi_t **m_tmsi)
+{
+    int i, size, *position = NULL;
+
+    ogs_assert(value);
+    ogs_assert(m_tmsi);
+
+    size = ogs_pool_size(&m_tmsi_pool);
+    ogs_assert(ogs_pool_avail(&m_tmsi_pool) == size);
+
+    position = ogs_calloc(size+1, sizeof(*position));
+    if (!position) {
+        ogs_error("ogs_calloc() failed");
+        return OGS_ERROR;
+    }
+    for (i = 0; i < size; i++) {
+        ogs_assert(m_tmsi_pool.array[i] >= 1 &&
+                m_tmsi_pool.array[i] <= (uint32_t)size);
+        position[m_tmsi_pool.array[i]] = i;
+    }
+
+    for (i = 0; i < num; i++) {
+        uint32_t raw = (value[i] & 0xffff) | ((value[i] >> 8) & 0x003f0000);
+        int head, found;
+
+        m_tmsi[i] = NULL;
+
+        if (raw == 0 || raw > (uint32_t)size || position[raw] < 0 ||
+            ((raw & 0xffff) | ((raw & 0x003f0000) << 8) | 0xc0000000) !=
+                value[i]) {
+            ogs_warn("Cannot restore M-TMSI[0x%x]", value[i]);
+            continue;
+        }
+
+        head = size - ogs_pool_avail(&m_tmsi_pool);
+        found = position[raw];
+        ogs_assert(found >= head);
+
+        position[m_tmsi_pool.array[head]] = found;
+        m_tmsi_pool.array[found] = m_tmsi_pool.array[head];
+        m_tmsi_pool.array[head] = raw;
+        position[raw] = -1;
+
+        ogs_pool_alloc(&m_tmsi_pool, &m_tmsi[i]);
+        ogs_assert(m_tmsi[i] == &m_tmsi_pool.array[head]);
+        *m_tmsi[i] = value[i];
+    }
+
+    ogs_free(position);
+
+    return OGS_OK;
+}
+
 int amf_m_tmsi_free(amf_m_tmsi_t *m_tmsi)
 {
     ogs_assert(m_tmsi);
@@ -2477,6 +2910,34 @@ uint8_t amf_selected_enc_algorithm(amf_ue_t *amf_ue)
     return 0;
 }
 
+ogs_slice_data_t *amf_ue_slice_add(amf_ue_t *amf_ue)
+{
+    ogs_slice_data_t *slice = NULL;
+
+    ogs_assert(amf_ue);
+
+    if (amf_ue->num_of_slice >= OGS_MAX_NUM_OF_SLICE) {
+        ogs_warn("Ignore max slice count overflow [%d>=%d]",
+                amf_ue->num_of_slice, OGS_MAX_NUM_OF_SLICE);
+        return NULL;
+    }
+
+    /* Allocated with the first slice, freed in amf_ue_remove() */
+    if (!amf_ue->slice) {
+        amf_ue->slice = ogs_calloc(
+                OGS_MAX_NUM_OF_SLICE, sizeof(ogs_slice_data_t));
+        if (!amf_ue->slice) {
+            ogs_error("ogs_calloc() failed");
+            return NULL;
+        }
+    }
+
+    slice = &amf_ue->slice[amf_ue->num_of_slice++];
+    memset(slice, 0, sizeof(*slice));
+
+    return slice;
+}
+
 void amf_clear_subscribed_info(amf_ue_t *amf_ue)
 {
     int i, j;
@@ -2485,6 +2946,7 @@ void amf_clear_subscribed_info(amf_ue_t *amf_ue)
 
     ogs_assert(amf_ue->num_of_slice <= OGS_MAX_NUM_OF_SLICE);
     for (i = 0; i < amf_ue->num_of_slice; i++) {
+        ogs_assert(amf_ue->slice);
         ogs_assert(amf_ue->slice[i].num_of_session <= OGS_MAX_NUM_OF_SESS);
         for (j = 0; j < amf_ue->slice[i].num_of_session; j++) {
             ogs_assert(amf_ue->slice[i].session[j].name);
@@ -99,6 +99,37 @@ typedef struct amf_context_s {
     /* NGSetupResponse */
     uint8_t         relative_capacity;
 
+    /* Paging */
+    struct {
+#define AMF_PAGING_AREA_LAST_GNB    1
+#define AMF_PAGING_AREA_TAI         2
+#define AMF_PAGING_AREA_TAI_LIST    3
+#define AMF_MAX_NUM_OF_PAGING_ESCALATION 8
+        /* Paging area per attempt, the last one is repeated */
+        int         num_of_escalation;
+        int         escalation[AMF_MAX_NUM_OF_PAGING_ESCALATION];
+
+        int         rate;       /* Paging per gNB per interval, 0: no limit */
+        ogs_time_t  interval;   /* Scheduler tick */
+    } paging;
+
+    /* Admission control of new UEs, see admission.c */
+    struct {
+        int         quantum;    /* InitialUEMessage per main loop iteration */
+        int         rate;       /* Registration per gNB per second, 0: off */
+        int         burst;      /* Token bucket depth */
+        int         overload;   /* Backlog for Overload Start, 0: never */
+        ogs_time_t  t3346;      /* Back-off in Registration Reject (secs) */
+    } admission;
+
+    /* UE snapshot for warm restart, see snapshot.c */
+    struct {
+        const char  *path;      /* NULL: disabled */
+        size_t      size;       /* File size in bytes */
+    } snapshot;
+
+    int             ngap_io_thread; /* NGAP I/O threads, 0: AMF thread */
+
     /* Generator for unique identification */
     uint64_t        amf_ue_ngap_id; /* amf_ue_ngap_id generator */
 
@@ -110,6 +141,7 @@ typedef struct amf_context_s {
     ogs_hash_t      *guti_ue_hash;          /* hash table (GUTI : AMF_UE) */
     ogs_hash_t      *suci_hash;     /* hash table (SUCI) */
     ogs_hash_t      *supi_hash;     /* hash table (SUPI) */
+    ogs_hash_t      *tai_index_hash; /* hash table (TAI : amf_tai_index_t) */
 
     uint16_t        ngap_port;      /* Default NGAP Port */
 
@@ -124,6 +156,9 @@ typedef struct amf_context_s {
 
 } amf_context_t;
 
+typedef struct amf_tai_index_s amf_tai_index_t;
+typedef struct amf_tai_link_s amf_tai_link_t;
+
 typedef struct amf_gnb_s {
     ogs_lnode_t     lnode;
 
@@ -155,9 +190,40 @@ typedef struct amf_gnb_s {
     ogs_pkbuf_t     *ng_reset_ack; /* Reset message */
 
     ogs_list_t      ran_ue_list;
+    ogs_hash_t      *ran_ue_hash;   /* hash table (RAN-UE-NGAP-ID : RAN_UE) */
+
+    /* Paging scheduler state, see paging.c */
+    struct {
+        ogs_list_t  list;       /* Paging waiting for the next tick */
+        ogs_time_t  window;     /* Start of the current interval */
+        int         count;      /* Paging sent in the current interval */
+        uint64_t    mark;       /* Last ngap_send_paging() that chose it */
+    } paging;
+
+    /* Registration token bucket, see admission.c */
+    struct {
+        int         tokens;
+        ogs_time_t  refill;     /* Time the tokens were counted up to */
+    } admission;
+
+    /* Entries of amf_self()->tai_index_hash pointing at this gNB */
+    int             num_of_tai_link;
+    amf_tai_link_t  *tai_link[OGS_MAX_NUM_OF_TAI*OGS_MAX_NUM_OF_BPLMN];
 
 } amf_gnb_t;
 
+/* All gNBs serving one TAI, used for paging */
+struct amf_tai_index_s {
+    ogs_5gs_tai_t   tai;            /* hash key */
+    ogs_list_t      link_list;      /* list of amf_tai_link_t */
+};
+
+struct amf_tai_link_s {
+    ogs_lnode_t     lnode;
+    amf_tai_index_t *index;
+    amf_gnb_t       *gnb;
+};
+
 struct ran_ue_s {
     ogs_lnode_t     lnode;
     uint32_t        index;
@@ -265,6 +331,10 @@ struct amf_ue_s {
     ogs_5gs_tai_t   nr_tai;
     ogs_nr_cgi_t    nr_cgi;
     ogs_time_t      ue_location_timestamp;
+    struct {
+        bool        presence;
+        uint32_t    gnb_id;
+    } last_gnb;                     /* Last serving gNB, for paging */
     ogs_plmn_id_t   last_visited_plmn_id;
     ogs_nas_ue_usage_setting_t ue_usage_setting;
 
@@ -303,6 +373,11 @@ struct amf_ue_s {
      ((__aMF)->nas.ue.ksi != OGS_NAS_KSI_NO_KEY_IS_AVAILABLE))
     int             security_context_available;
     int             mac_failed;
+    struct {
+        bool        stored;     /* Written by amf_snapshot_store() */
+        uint32_t    m_tmsi;     /* M-TMSI of that record */
+        uint32_t    dl_count;   /* DL NAS COUNT mark of that record */
+    } snapshot;
 
     /* Security Context */
     ogs_nas_ue_security_capability_t ue_security_capability;
@@ -317,10 +392,10 @@ struct amf_ue_s {
 
     uint8_t         hxres_star[OGS_MAX_RES_LEN];
     uint8_t         kamf[OGS_SHA256_DIGEST_SIZE];
+    ogs_kdf_key_t   kamf_key; /* HMAC state of kamf for the KDF */
     OpenAPI_auth_result_e auth_result;
 
-    uint8_t         knas_int[OGS_SHA256_DIGEST_SIZE/2];
-    uint8_t         knas_enc[OGS_SHA256_DIGEST_SIZE/2];
+    ogs_nas_security_key_t nas_key; /* KNASint/KNASenc, expanded */
     uint32_t        dl_count;
     union {
         struct {
@@ -355,7 +430,9 @@ struct amf_ue_s {
     ogs_bitrate_t   ue_ambr;
     int num_of_slice;
     OpenAPI_list_t *rat_restrictions;
-    ogs_slice_data_t slice[OGS_MAX_NUM_OF_SLICE];
+    /* OGS_MAX_NUM_OF_SLICE entries, allocated on the first NSSAI
+     * subscription so that the pooled context stays small */
+    ogs_slice_data_t *slice;
 
     uint64_t        am_policy_control_features; /* SBI Features */
 
@@ -369,7 +446,7 @@ struct amf_ue_s {
 
 #define CLEAR_AMF_UE_ALL_TIMERS(__aMF) \
     do { \
-        CLEAR_AMF_UE_TIMER((__aMF)->t3513); \
+        amf_paging_stop(__aMF); \
         CLEAR_AMF_UE_TIMER((__aMF)->t3522); \
         CLEAR_AMF_UE_TIMER((__aMF)->t3550); \
         CLEAR_AMF_UE_TIMER((__aMF)->t3555); \
@@ -666,9 +743,13 @@ int amf_gnb_set_gnb_id(amf_gnb_t *gnb, uint32_t gnb_id);
 int amf_gnb_sock_type(ogs_sock_t *sock);
 amf_gnb_t *amf_gnb_cycle(amf_gnb_t *gnb);
 
+void amf_gnb_update_tai_index(amf_gnb_t *gnb);
+amf_tai_index_t *amf_tai_index_find(ogs_5gs_tai_t *tai);
+
 ran_ue_t *ran_ue_add(amf_gnb_t *gnb, uint32_t ran_ue_ngap_id);
 void ran_ue_remove(ran_ue_t *ran_ue);
 void ran_ue_switch_to_gnb(ran_ue_t *ran_ue, amf_gnb_t *new_gnb);
+void ran_ue_set_ran_ue_ngap_id(ran_ue_t *ran_ue, uint32_t ran_ue_ngap_id);
 ran_ue_t *ran_ue_find_by_ran_ue_ngap_id(
         amf_gnb_t *gnb, uint32_t ran_ue_ngap_id);
 ran_ue_t *ran_ue_find(uint32_t index);
@@ -803,6 +884,7 @@ bool amf_handover_request_transfer_needed(amf_ue_t *amf_ue);
 #define PAGING_ONGOING(__aMF) \
     (amf_paging_ongoing(__aMF) == true)
 bool amf_paging_ongoing(amf_ue_t *amf_ue);
+void amf_paging_stop(amf_ue_t *amf_ue);
 #define DOWNLINK_SIGNALLING_PENDING(__aMF) \
     (amf_downlink_signalling_pending(__aMF) == true)
 bool amf_downlink_signalling_pending(amf_ue_t *amf_ue);
@@ -812,11 +894,13 @@ ogs_s_nssai_t *amf_find_s_nssai(
         ogs_plmn_id_t *served_plmn_id, ogs_s_nssai_t *s_nssai);
 
 amf_m_tmsi_t *amf_m_tmsi_alloc(void);
+int amf_m_tmsi_restore(int num, uint32_t *value, amf_m_tmsi_t **m_tmsi);
 int amf_m_tmsi_free(amf_m_tmsi_t *tmsi);
 
 uint8_t amf_selected_int_algorithm(amf_ue_t *amf_ue);
 uint8_t amf_selected_enc_algorithm(amf_ue_t *amf_ue);
 
+ogs_slice_data_t *amf_ue_slice_add(amf_ue_t *amf_ue);
 void amf_clear_subscribed_info(amf_ue_t *amf_ue);
 
 bool amf_update_allowed_nssai(amf_ue_t *amf_ue);
@@ -19,6 +19,7 @@
 
 #include "event.h"
 #include "context.h"
+#include "ngap-worker.h"
 
 amf_event_t *amf_event_new(int id)
 {
@@ -100,9 +101,14 @@ void amf_sctp_event_push(int id,
     e->ngap.max_num_of_istreams = max_num_of_istreams;
     e->ngap.max_num_of_ostreams = max_num_of_ostreams;
 
+    if (id == AMF_EVENT_NGAP_MESSAGE && ogs_sctp_worker_in_thread())
+        amf_ngap_worker_decode(e);
+
     rv = ogs_queue_push(ogs_app()->queue, e);
     if (rv != OGS_OK) {
         ogs_error("ogs_queue_push() failed:%d", (int)rv);
+        if (e->ngap.message)
+            amf_ngap_worker_message_free(e);
         ogs_free(e->ngap.addr);
         if (e->pkbuf)
             ogs_pkbuf_free(e->pkbuf);
@@ -112,5 +118,9 @@ void amf_sctp_event_push(int id,
     else {
         ogs_pollset_notify(ogs_app()->pollset);
     }
+#else
+    else if (ogs_sctp_worker_in_thread()) {
+        ogs_pollset_notify(ogs_app()->pollset);
+    }
 #endif
 }
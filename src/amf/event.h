@@ -28,6 +28,7 @@ extern "C" {
 
 typedef struct ogs_nas_5gs_message_s ogs_nas_5gs_message_t;
 typedef struct NGAP_NGAP_PDU ogs_ngap_message_t;
+typedef struct ogs_asn_arena_s ogs_asn_arena_t;
 typedef long NGAP_ProcedureCode_t;
 
 typedef struct amf_gnb_s amf_gnb_t;
@@ -67,6 +68,7 @@ typedef struct amf_event_s {
 
         NGAP_ProcedureCode_t code;
         ogs_ngap_message_t *message;
+        ogs_asn_arena_t *arena;     /* Decoded in an NGAP I/O thread */
     } ngap;
 
     struct {
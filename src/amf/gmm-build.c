@@ -173,11 +173,13 @@ ogs_pkbuf_t *gmm_build_registration_accept(amf_ue_t *amf_ue)
     return pkbuf;
 }
 
-ogs_pkbuf_t *gmm_build_registration_reject(ogs_nas_5gmm_cause_t gmm_cause)
+ogs_pkbuf_t *gmm_build_registration_reject(
+        ogs_nas_5gmm_cause_t gmm_cause, ogs_time_t t3346)
 {
     ogs_nas_5gs_message_t message;
     ogs_nas_5gs_registration_reject_t *registration_reject =
         &message.gmm.registration_reject;
+    ogs_nas_gprs_timer_2_t *t3346_value = &registration_reject->t3346_value;
 
     memset(&message, 0, sizeof(message));
     message.gmm.h.extended_protocol_discriminator =
@@ -186,6 +188,14 @@ ogs_pkbuf_t *gmm_build_registration_reject(ogs_nas_5gmm_cause_t gmm_cause)
 
     registration_reject->gmm_cause = gmm_cause;
 
+    if (t3346) {
+        registration_reject->presencemask |=
+            OGS_NAS_5GS_REGISTRATION_REJECT_T3346_VALUE_PRESENT;
+        t3346_value->length = 1;
+        ogs_assert(OGS_OK ==
+                ogs_nas_gprs_timer_from_sec(&t3346_value->t, t3346));
+    }
+
     return ogs_nas_5gs_plain_encode(&message);
 }
 
@@ -388,6 +398,8 @@ ogs_pkbuf_t *gmm_build_authentication_reject(void)
 
 ogs_pkbuf_t *gmm_build_security_mode_command(amf_ue_t *amf_ue)
 {
+    uint8_t knas_int[OGS_SHA256_DIGEST_SIZE/2];
+    uint8_t knas_enc[OGS_SHA256_DIGEST_SIZE/2];
     ogs_nas_5gs_message_t message;
     ogs_nas_5gs_security_mode_command_t *security_mode_command =
         &message.gmm.security_mode_command;
@@ -470,10 +482,15 @@ ogs_pkbuf_t *gmm_build_security_mode_command(amf_ue_t *amf_ue)
         return NULL;
     }
 
-    ogs_kdf_nas_5gs(OGS_KDF_NAS_INT_ALG, amf_ue->selected_int_algorithm,
-            amf_ue->kamf, amf_ue->knas_int);
-    ogs_kdf_nas_5gs(OGS_KDF_NAS_ENC_ALG, amf_ue->selected_enc_algorithm,
-            amf_ue->kamf, amf_ue->knas_enc);
+    ogs_kdf_nas_5gs_from_key(OGS_KDF_NAS_INT_ALG,
+            amf_ue->selected_int_algorithm,
+            &amf_ue->kamf_key, knas_int);
+    ogs_kdf_nas_5gs_from_key(OGS_KDF_NAS_ENC_ALG,
+            amf_ue->selected_enc_algorithm,
+            &amf_ue->kamf_key, knas_enc);
+    ogs_nas_security_key_init(&amf_ue->nas_key,
+            amf_ue->selected_int_algorithm, knas_int,
+            amf_ue->selected_enc_algorithm, knas_enc);
 
     return nas_5gs_security_encode(amf_ue, &message);
 }
@@ -27,7 +27,8 @@ extern "C" {
 #endif
 
 ogs_pkbuf_t *gmm_build_registration_accept(amf_ue_t *amf_ue);
-ogs_pkbuf_t *gmm_build_registration_reject(ogs_nas_5gmm_cause_t gmm_cause);
+ogs_pkbuf_t *gmm_build_registration_reject(
+        ogs_nas_5gmm_cause_t gmm_cause, ogs_time_t t3346);
 
 ogs_pkbuf_t *gmm_build_service_accept(amf_ue_t *amf_ue);
 ogs_pkbuf_t *gmm_build_service_reject(
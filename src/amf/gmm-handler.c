@@ -236,10 +236,10 @@ ogs_nas_5gmm_cause_t gmm_handle_registration_request(amf_ue_t *amf_ue,
     CLEAR_AMF_UE_ALL_TIMERS(amf_ue);
 
     if (SECURITY_CONTEXT_IS_VALID(amf_ue)) {
-        ogs_kdf_kgnb_and_kn3iwf(
-                amf_ue->kamf, amf_ue->ul_count.i32,
+        ogs_kdf_kgnb_and_kn3iwf_from_key(
+                &amf_ue->kamf_key, amf_ue->ul_count.i32,
                 amf_ue->nas.access_type, amf_ue->kgnb);
-        ogs_kdf_nh_gnb(amf_ue->kamf, amf_ue->kgnb, amf_ue->nh);
+        ogs_kdf_nh_gnb_from_key(&amf_ue->kamf_key, amf_ue->kgnb, amf_ue->nh);
         amf_ue->nhcc = 1;
     }
 
@@ -604,10 +604,10 @@ ogs_nas_5gmm_cause_t gmm_handle_service_request(amf_ue_t *amf_ue,
     CLEAR_AMF_UE_ALL_TIMERS(amf_ue);
 
     if (SECURITY_CONTEXT_IS_VALID(amf_ue)) {
-        ogs_kdf_kgnb_and_kn3iwf(
-                amf_ue->kamf, amf_ue->ul_count.i32,
+        ogs_kdf_kgnb_and_kn3iwf_from_key(
+                &amf_ue->kamf_key, amf_ue->ul_count.i32,
                 amf_ue->nas.access_type, amf_ue->kgnb);
-        ogs_kdf_nh_gnb(amf_ue->kamf, amf_ue->kgnb, amf_ue->nh);
+        ogs_kdf_nh_gnb_from_key(&amf_ue->kamf_key, amf_ue->kgnb, amf_ue->nh);
         amf_ue->nhcc = 1;
     }
 
@@ -1424,8 +1424,8 @@ static ogs_nas_5gmm_cause_t gmm_handle_nas_message_container(
         case OGS_NAS_SECURITY_ALGORITHMS_128_NEA1:
         case OGS_NAS_SECURITY_ALGORITHMS_128_NEA2:
         case OGS_NAS_SECURITY_ALGORITHMS_128_NEA3:
-            ogs_nas_encrypt(amf_ue->selected_enc_algorithm,
-                amf_ue->knas_enc, amf_ue->ul_count.i32,
+            ogs_nas_encrypt_from_key(&amf_ue->nas_key,
+                amf_ue->ul_count.i32,
                 amf_ue->nas.access_type,
                 OGS_NAS_SECURITY_UPLINK_DIRECTION, nasbuf);
         default:
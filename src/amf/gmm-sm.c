@@ -503,7 +503,7 @@ void gmm_state_registered(ogs_fsm_t *s, amf_event_t *e)
                 AMF_UE_CLEAR_N2_TRANSFER(
                         amf_ue, pdu_session_resource_setup_request);
                 AMF_UE_CLEAR_5GSM_MESSAGE(amf_ue);
-                CLEAR_AMF_UE_TIMER(amf_ue->t3513);
+                amf_paging_stop(amf_ue);
 
             } else {
                 amf_ue->t3513.retry_count++;
@@ -595,7 +595,7 @@ void gmm_state_registered(ogs_fsm_t *s, amf_event_t *e)
             AMF_UE_CLEAR_N2_TRANSFER(
                     amf_ue, pdu_session_resource_setup_request);
             AMF_UE_CLEAR_5GSM_MESSAGE(amf_ue);
-            CLEAR_AMF_UE_TIMER(amf_ue->t3513);
+            amf_paging_stop(amf_ue);
 
             ogs_timer_start(amf_ue->implicit_deregistration.timer,
                     ogs_time_from_sec(amf_self()->time.t3512.value + 240));
@@ -1613,10 +1613,11 @@ void gmm_state_security_mode(ogs_fsm_t *s, amf_event_t *e)
                 break;
             }
 
-            ogs_kdf_kgnb_and_kn3iwf(
-                    amf_ue->kamf, amf_ue->ul_count.i32,
+            ogs_kdf_kgnb_and_kn3iwf_from_key(
+                    &amf_ue->kamf_key, amf_ue->ul_count.i32,
                     amf_ue->nas.access_type, amf_ue->kgnb);
-            ogs_kdf_nh_gnb(amf_ue->kamf, amf_ue->kgnb, amf_ue->nh);
+            ogs_kdf_nh_gnb_from_key(
+                    &amf_ue->kamf_key, amf_ue->kgnb, amf_ue->nh);
             amf_ue->nhcc = 1;
 
             r = amf_ue_sbi_discover_and_send(
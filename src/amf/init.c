@@ -20,6 +20,9 @@
 #include "sbi-path.h"
 #include "ngap-path.h"
 #include "metrics.h"
+#include "ngap-worker.h"
+#include "snapshot.h"
+#include "admission.h"
 
 static ogs_thread_t *thread;
 static void amf_main(void *data);
@@ -46,6 +49,9 @@ int amf_initialize(void)
     rv = amf_context_nf_info();
     if (rv != OGS_OK) return rv;
 
+    rv = amf_snapshot_open();
+    if (rv != OGS_OK) return rv;
+
     rv = ogs_log_config_domain(
             ogs_app()->logger.domain, ogs_app()->logger.level);
     if (rv != OGS_OK) return rv;
@@ -55,6 +61,9 @@ int amf_initialize(void)
     rv = amf_sbi_open();
     if (rv != OGS_OK) return rv;
 
+    rv = amf_ngap_worker_open();
+    if (rv != OGS_OK) return rv;
+
     rv = ngap_open();
     if (rv != OGS_OK) return rv;
 
@@ -104,6 +113,9 @@ void amf_terminate(void)
     amf_context_final();
     ogs_sbi_context_final();
 
+    /* After amf_context_final() has handed back every gNB socket */
+    amf_ngap_worker_close();
+
     amf_metrics_final();
 }
 
@@ -115,7 +127,10 @@ static void amf_main(void *data)
     ogs_fsm_init(&amf_sm, amf_state_initial, amf_state_final, 0);
 
     for ( ;; ) {
+        /* Don't sleep while new UEs or what they queued are waiting */
         ogs_pollset_poll(ogs_app()->pollset,
+                (amf_admission_backlog() ||
+                 ogs_queue_size(ogs_app()->queue)) ? 0 :
                 ogs_timer_mgr_next(ogs_app()->timer_mgr));
 
         /*
@@ -144,9 +159,19 @@ static void amf_main(void *data)
                 break;
 
             ogs_assert(e);
+            if (amf_admission_defer(e) == true)
+                continue;
+
             ogs_fsm_dispatch(&amf_sm, e);
             ogs_event_free(e);
         }
+
+        /* New UEs only after the procedures already in flight */
+        amf_admission_dispatch(&amf_sm);
+        amf_admission_run();
+
+        /* Send what this iteration queued on SCTP associations */
+        ogs_sctp_flush_all();
     }
 done:
 
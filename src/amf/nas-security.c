@@ -18,6 +18,7 @@
  */
 
 #include "nas-security.h"
+#include "snapshot.h"
 
 #define NAS_SECURITY_MAC_SIZE 4
 
@@ -82,8 +83,8 @@ ogs_pkbuf_t *nas_5gs_security_encode(
 
     if (ciphered) {
         /* encrypt NAS message */
-        ogs_nas_encrypt(amf_ue->selected_enc_algorithm,
-            amf_ue->knas_enc, amf_ue->dl_count,
+        ogs_nas_encrypt_from_key(&amf_ue->nas_key,
+            amf_ue->dl_count,
             amf_ue->nas.access_type,
             OGS_NAS_SECURITY_DOWNLINK_DIRECTION, new);
     }
@@ -96,8 +97,8 @@ ogs_pkbuf_t *nas_5gs_security_encode(
         uint8_t mac[NAS_SECURITY_MAC_SIZE];
 
         /* calculate NAS MAC(message authentication code) */
-        ogs_nas_mac_calculate(amf_ue->selected_int_algorithm,
-            amf_ue->knas_int, amf_ue->dl_count,
+        ogs_nas_mac_calculate_from_key(&amf_ue->nas_key,
+            amf_ue->dl_count,
             amf_ue->nas.access_type,
             OGS_NAS_SECURITY_DOWNLINK_DIRECTION, new, mac);
         memcpy(&h.message_authentication_code, mac, sizeof(mac));
@@ -105,6 +106,7 @@ ogs_pkbuf_t *nas_5gs_security_encode(
 
     /* increase dl_count */
     amf_ue->dl_count = (amf_ue->dl_count + 1) & 0xffffff; /* Use 24bit */
+    amf_snapshot_update(amf_ue);
 
     /* encode all security header */
     ogs_assert(ogs_pkbuf_push(new, 6));
@@ -159,8 +161,8 @@ int nas_5gs_security_decode(amf_ue_t *amf_ue,
             uint32_t original_mac = h->message_authentication_code;
 
             /* calculate NAS MAC(message authentication code) */
-            ogs_nas_mac_calculate(amf_ue->selected_int_algorithm,
-                amf_ue->knas_int, amf_ue->ul_count.i32,
+            ogs_nas_mac_calculate_from_key(&amf_ue->nas_key,
+                amf_ue->ul_count.i32,
                 amf_ue->nas.access_type,
                 OGS_NAS_SECURITY_UPLINK_DIRECTION, pkbuf, mac);
             h->message_authentication_code = original_mac;
@@ -178,8 +180,8 @@ int nas_5gs_security_decode(amf_ue_t *amf_ue,
 
         if (security_header_type.ciphered) {
             /* decrypt NAS message */
-            ogs_nas_encrypt(amf_ue->selected_enc_algorithm,
-                amf_ue->knas_enc, amf_ue->ul_count.i32,
+            ogs_nas_encrypt_from_key(&amf_ue->nas_key,
+                amf_ue->ul_count.i32,
                 amf_ue->nas.access_type,
                 OGS_NAS_SECURITY_UPLINK_DIRECTION, pkbuf);
         }
@@ -178,6 +178,8 @@ int amf_nausf_auth_handle_authenticate_confirmation(
 
         ogs_kdf_kamf(amf_ue->supi, amf_ue->abba, amf_ue->abba_len,
                 kseaf, amf_ue->kamf);
+        ogs_kdf_key_init(&amf_ue->kamf_key,
+                amf_ue->kamf, OGS_SHA256_DIGEST_SIZE);
 
         return OGS_OK;
 
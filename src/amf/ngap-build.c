@@ -315,8 +315,9 @@ ogs_pkbuf_t *ngap_build_downlink_nas_transport(
     ogs_assert(gmmbuf);
     ran_ue = ran_ue_cycle(ran_ue);
     ogs_assert(ran_ue);
+    /* No AMF-UE yet when a new Registration Request is not admitted */
     amf_ue = amf_ue_cycle(ran_ue->amf_ue);
-    ogs_assert(amf_ue);
+    ogs_assert(amf_ue || (!ue_ambr && !allowed_nssai));
 
     ogs_debug("DownlinkNASTransport");
 
@@ -2734,3 +2735,62 @@ ogs_pkbuf_t *ngap_build_downlink_ran_status_transfer(
 
     return ogs_ngap_encode(&pdu);
 }
+
+ogs_pkbuf_t *ngap_build_overload_start(long overload_action)
+{
+    NGAP_NGAP_PDU_t pdu;
+    NGAP_InitiatingMessage_t *initiatingMessage = NULL;
+    NGAP_OverloadStart_t *OverloadStart = NULL;
+
+    NGAP_OverloadStartIEs_t *ie = NULL;
+    NGAP_OverloadResponse_t *OverloadResponse = NULL;
+
+    ogs_debug("OverloadStart");
+
+    memset(&pdu, 0, sizeof (NGAP_NGAP_PDU_t));
+    pdu.present = NGAP_NGAP_PDU_PR_initiatingMessage;
+    pdu.choice.initiatingMessage = CALLOC(1, sizeof(NGAP_InitiatingMessage_t));
+
+    initiatingMessage = pdu.choice.initiatingMessage;
+    initiatingMessage->procedureCode = NGAP_ProcedureCode_id_OverloadStart;
+    initiatingMessage->criticality = NGAP_Criticality_ignore;
+    initiatingMessage->value.present =
+        NGAP_InitiatingMessage__value_PR_OverloadStart;
+
+    OverloadStart = &initiatingMessage->value.choice.OverloadStart;
+
+    ie = CALLOC(1, sizeof(NGAP_OverloadStartIEs_t));
+    ASN_SEQUENCE_ADD(&OverloadStart->protocolIEs, ie);
+
+    ie->id = NGAP_ProtocolIE_ID_id_AMFOverloadResponse;
+    ie->criticality = NGAP_Criticality_reject;
+    ie->value.present = NGAP_OverloadStartIEs__value_PR_OverloadResponse;
+
+    OverloadResponse = &ie->value.choice.OverloadResponse;
+    OverloadResponse->present = NGAP_OverloadResponse_PR_overloadAction;
+    OverloadResponse->choice.overloadAction = overload_action;
+
+    ogs_debug("    OverloadAction[%ld]", overload_action);
+
+    return ogs_ngap_encode(&pdu);
+}
+
+ogs_pkbuf_t *ngap_build_overload_stop(void)
+{
+    NGAP_NGAP_PDU_t pdu;
+    NGAP_InitiatingMessage_t *initiatingMessage = NULL;
+
+    ogs_debug("OverloadStop");
+
+    memset(&pdu, 0, sizeof (NGAP_NGAP_PDU_t));
+    pdu.present = NGAP_NGAP_PDU_PR_initiatingMessage;
+    pdu.choice.initiatingMessage = CALLOC(1, sizeof(NGAP_InitiatingMessage_t));
+
+    initiatingMessage = pdu.choice.initiatingMessage;
+    initiatingMessage->procedureCode = NGAP_ProcedureCode_id_OverloadStop;
+    initiatingMessage->criticality = NGAP_Criticality_ignore;
+    initiatingMessage->value.present =
+        NGAP_InitiatingMessage__value_PR_OverloadStop;
+
+    return ogs_ngap_encode(&pdu);
+}
@@ -72,6 +72,9 @@ ogs_pkbuf_t *ngap_build_downlink_ran_status_transfer(
     ran_ue_t *target_ue,
     NGAP_RANStatusTransfer_TransparentContainer_t *transfer);
 
+ogs_pkbuf_t *ngap_build_overload_start(long overload_action);
+ogs_pkbuf_t *ngap_build_overload_stop(void);
+
 #ifdef __cplusplus
 }
 #endif
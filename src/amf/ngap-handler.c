@@ -21,6 +21,8 @@
 #include "ngap-path.h"
 #include "sbi-path.h"
 #include "nas-path.h"
+#include "snapshot.h"
+#include "admission.h"
 
 static bool served_tai_is_found(amf_gnb_t *gnb)
 {
@@ -285,6 +287,8 @@ void ngap_handle_ng_setup_request(amf_gnb_t *gnb, ogs_ngap_message_t *message)
         gnb->num_of_supported_ta_list++;
     }
 
+    amf_gnb_update_tai_index(gnb);
+
     if (maximum_number_of_gnbs_is_reached()) {
         ogs_warn("NG-Setup failure:");
         ogs_warn("    Maximum number of gNBs reached");
@@ -340,6 +344,13 @@ void ngap_handle_ng_setup_request(amf_gnb_t *gnb, ogs_ngap_message_t *message)
     r = ngap_send_ng_setup_response(gnb);
     ogs_expect(r == OGS_OK);
     ogs_assert(r != OGS_ERROR);
+
+    /* A gNB coming back during a registration storm */
+    if (amf_admission_overloaded() == true) {
+        r = ngap_send_overload_start(gnb,
+                NGAP_OverloadAction_reject_rrc_cr_signalling);
+        ogs_expect(r == OGS_OK);
+    }
 }
 
 void ngap_handle_initial_ue_message(amf_gnb_t *gnb, ogs_ngap_message_t *message)
@@ -1685,6 +1696,7 @@ void ngap_handle_ue_context_release_action(ran_ue_t *ran_ue)
             return;
         }
         amf_ue_deassociate(amf_ue);
+        amf_snapshot_store(amf_ue);
         break;
     case NGAP_UE_CTX_REL_UE_CONTEXT_REMOVE:
         ogs_debug("    Action: UE context remove");
@@ -2709,7 +2721,7 @@ void ngap_handle_path_switch_request(
         amf_ue->nr_tai.tac.v, (long long)amf_ue->nr_cgi.cell_id);
 
     /* Update RAN-UE-NGAP-ID */
-    ran_ue->ran_ue_ngap_id = *RAN_UE_NGAP_ID;
+    ran_ue_set_ran_ue_ngap_id(ran_ue, *RAN_UE_NGAP_ID);
 
     /* Change ran_ue to the NEW gNB */
     ran_ue_switch_to_gnb(ran_ue, gnb);
@@ -2815,7 +2827,7 @@ void ngap_handle_path_switch_request(
 
     /* Update Security Context (NextHop) */
     amf_ue->nhcc++;
-    ogs_kdf_nh_gnb(amf_ue->kamf, amf_ue->nh, amf_ue->nh);
+    ogs_kdf_nh_gnb_from_key(&amf_ue->kamf_key, amf_ue->nh, amf_ue->nh);
 
     for (i = 0; i < PDUSessionResourceToBeSwitchedDLList->list.count; i++) {
         amf_sess_t *sess = NULL;
@@ -3154,7 +3166,7 @@ void ngap_handle_handover_required(
 
     /* Update Security Context (NextHop) */
     amf_ue->nhcc++;
-    ogs_kdf_nh_gnb(amf_ue->kamf, amf_ue->nh, amf_ue->nh);
+    ogs_kdf_nh_gnb_from_key(&amf_ue->kamf_key, amf_ue->nh, amf_ue->nh);
 
     /* Store Container */
     OGS_ASN_STORE_DATA(&amf_ue->handover.container,
@@ -3347,7 +3359,7 @@ void ngap_handle_handover_request_ack(
         return;
     }
 
-    target_ue->ran_ue_ngap_id = *RAN_UE_NGAP_ID;
+    ran_ue_set_ran_ue_ngap_id(target_ue, *RAN_UE_NGAP_ID);
 
     source_ue = target_ue->source_ue;
     if (!source_ue) {
@@ -4209,6 +4221,8 @@ void ngap_handle_ran_configuration_update(
             gnb->num_of_supported_ta_list++;
         }
 
+        amf_gnb_update_tai_index(gnb);
+
         if (gnb->num_of_supported_ta_list == 0) {
             ogs_warn("RANConfigurationUpdate failure:");
             ogs_warn("    No supported TA exist in request");
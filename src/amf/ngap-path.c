@@ -26,6 +26,7 @@
 #include "nas-security.h"
 #include "nas-path.h"
 #include "sbi-path.h"
+#include "paging.h"
 
 int ngap_open(void)
 {
@@ -410,9 +411,6 @@ int ngap_send_amf_ue_context_release_command(
 
 int ngap_send_paging(amf_ue_t *amf_ue)
 {
-    ogs_pkbuf_t *ngapbuf = NULL;
-    amf_gnb_t *gnb = NULL;
-    int i, j;
     int rv;
 
     ogs_debug("NG-Paging");
@@ -425,42 +423,31 @@ int ngap_send_paging(amf_ue_t *amf_ue)
     ogs_assert(ogs_timer_running(
                 amf_ue->implicit_deregistration.timer) == false);
 
-    ogs_list_for_each(&amf_self()->gnb_list, gnb) {
-        for (i = 0; i < gnb->num_of_supported_ta_list; i++) {
-            for (j = 0; j < gnb->supported_ta_list[i].num_of_bplmn_list; j++) {
-                if (memcmp(&gnb->supported_ta_list[i].bplmn_list[j].plmn_id,
-                            &amf_ue->nr_tai.plmn_id, OGS_PLMN_ID_LEN) == 0 &&
-                    gnb->supported_ta_list[i].tac.v == amf_ue->nr_tai.tac.v) {
-
-                    if (amf_ue->t3513.pkbuf) {
-                        ngapbuf = amf_ue->t3513.pkbuf;
-                    } else {
-                        ngapbuf = ngap_build_paging(amf_ue);
-                        if (!ngapbuf) {
-                            ogs_error("ngap_build_paging() failed");
-                            return OGS_ERROR;
-                        }
-                    }
-
-                    amf_ue->t3513.pkbuf = ogs_pkbuf_copy(ngapbuf);
-                    if (!amf_ue->t3513.pkbuf) {
-                        ogs_error("ogs_pkbuf_copy() failed");
-                        ogs_pkbuf_free(ngapbuf);
-                        return OGS_ERROR;
-                    }
-
-                    amf_metrics_inst_global_inc(AMF_METR_GLOB_CTR_MM_PAGING_5G_REQ);
-
-                    rv = ngap_send_to_gnb(gnb, ngapbuf, NGAP_NON_UE_SIGNALLING);
-                    if (rv != OGS_OK) {
-                        ogs_error("ngap_send_to_gnb() failed");
-                        return rv;
-                    }
-                }
-            }
+    /*
+     * Paging is already in progress, e.g. several N1N2MessageTransfer
+     * for the same idle UE. The stored N2/5GSM messages of every session
+     * are sent once the UE answers, so one Paging is enough.
+     */
+    if (ogs_timer_running(amf_ue->t3513.timer) == true) {
+        ogs_debug("[%s] Paging already in progress", amf_ue->supi);
+        return OGS_OK;
+    }
+
+    /* If t3513 is timeout, the saved pkbuf is used. */
+    if (!amf_ue->t3513.pkbuf) {
+        amf_ue->t3513.pkbuf = ngap_build_paging(amf_ue);
+        if (!amf_ue->t3513.pkbuf) {
+            ogs_error("ngap_build_paging() failed");
+            return OGS_ERROR;
         }
     }
 
+    rv = amf_paging_send(amf_ue, amf_ue->t3513.pkbuf);
+    if (rv != OGS_OK) {
+        ogs_error("amf_paging_send() failed");
+        return rv;
+    }
+
     /* Start T3513 */
     ogs_timer_start(amf_ue->t3513.timer, 
             amf_timer_cfg(AMF_TIMER_T3513)->duration);
@@ -737,3 +724,51 @@ int ngap_send_ng_reset_ack(
 
     return rv;
 }
+
+int ngap_send_overload_start(amf_gnb_t *gnb, long overload_action)
+{
+    int rv;
+    ogs_pkbuf_t *ngap_buffer;
+
+    ogs_debug("Overload start");
+
+    if (!amf_gnb_cycle(gnb)) {
+        ogs_error("gNB has already been removed");
+        return OGS_NOTFOUND;
+    }
+
+    ngap_buffer = ngap_build_overload_start(overload_action);
+    if (!ngap_buffer) {
+        ogs_error("ngap_build_overload_start() failed");
+        return OGS_ERROR;
+    }
+
+    rv = ngap_send_to_gnb(gnb, ngap_buffer, NGAP_NON_UE_SIGNALLING);
+    ogs_expect(rv == OGS_OK);
+
+    return rv;
+}
+
+int ngap_send_overload_stop(amf_gnb_t *gnb)
+{
+    int rv;
+    ogs_pkbuf_t *ngap_buffer;
+
+    ogs_debug("Overload stop");
+
+    if (!amf_gnb_cycle(gnb)) {
+        ogs_error("gNB has already been removed");
+        return OGS_NOTFOUND;
+    }
+
+    ngap_buffer = ngap_build_overload_stop();
+    if (!ngap_buffer) {
+        ogs_error("ngap_build_overload_stop() failed");
+        return OGS_ERROR;
+    }
+
+    rv = ngap_send_to_gnb(gnb, ngap_buffer, NGAP_NON_UE_SIGNALLING);
+    ogs_expect(rv == OGS_OK);
+
+    return rv;
+}
@@ -87,6 +87,9 @@ int ngap_send_ng_reset_ack(
         amf_gnb_t *gnb,
         NGAP_UE_associatedLogicalNG_connectionList_t *partOfNG_Interface);
 
+int ngap_send_overload_start(amf_gnb_t *gnb, long overload_action);
+int ngap_send_overload_stop(amf_gnb_t *gnb);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,7 +28,7 @@ static void lksctp_accept_handler(short when, ogs_socket_t fd, void *data);
 #endif
 
 void ngap_accept_handler(ogs_sock_t *sock);
-void ngap_recv_handler(ogs_sock_t *sock);
+int ngap_recv_handler(ogs_sock_t *sock);
 
 ogs_sock_t *ngap_server(ogs_socknode_t *node)
 {
@@ -67,12 +67,21 @@ ogs_sock_t *ngap_server(ogs_socknode_t *node)
 void ngap_recv_upcall(short when, ogs_socket_t fd, void *data)
 {
     ogs_sock_t *sock = NULL;
+    int i;
 
     ogs_assert(fd != INVALID_SOCKET);
     sock = data;
     ogs_assert(sock);
 
-    ngap_recv_handler(sock);
+    /*
+     * Drain what the association already has queued, so a busy peer
+     * costs one wakeup per batch rather than one per message. Stop
+     * at a notification so that a lost association is handled first.
+     */
+    for (i = 0; i < OGS_SCTP_BATCH_SIZE; i++) {
+        if (ngap_recv_handler(sock) != OGS_OK)
+            break;
+    }
 }
 
 #if HAVE_USRSCTP
@@ -106,6 +115,11 @@ void ngap_accept_handler(ogs_sock_t *sock)
     if (new) {
         ogs_sockaddr_t *addr = NULL;
 
+#if !HAVE_USRSCTP
+        /* Reads are drained and writes batched until EAGAIN */
+        ogs_assert(ogs_nonblocking(new->fd) == OGS_OK);
+#endif
+
         addr = ogs_calloc(1, sizeof(ogs_sockaddr_t));
         ogs_assert(addr);
         memcpy(addr, &new->remote_addr, sizeof(ogs_sockaddr_t));
@@ -120,7 +134,7 @@ void ngap_accept_handler(ogs_sock_t *sock)
     }
 }
 
-void ngap_recv_handler(ogs_sock_t *sock)
+int ngap_recv_handler(ogs_sock_t *sock)
 {
     ogs_pkbuf_t *pkbuf;
     int size;
@@ -136,11 +150,15 @@ void ngap_recv_handler(ogs_sock_t *sock)
     ogs_pkbuf_put(pkbuf, OGS_MAX_SDU_LEN);
     size = ogs_sctp_recvmsg(
             sock, pkbuf->data, pkbuf->len, &from, &sinfo, &flags);
+    if (size < 0 && ogs_socket_errno == OGS_EAGAIN) {
+        ogs_pkbuf_free(pkbuf);
+        return OGS_RETRY;
+    }
     if (size < 0 || size >= OGS_MAX_SDU_LEN) {
         ogs_error("ogs_sctp_recvmsg(%d) failed(%d:%s)",
                 size, errno, strerror(errno));
         ogs_pkbuf_free(pkbuf);
-        return;
+        return OGS_ERROR;
     }
 
     if (flags & MSG_NOTIFICATION) {
@@ -236,7 +254,7 @@ void ngap_recv_handler(ogs_sock_t *sock)
         memcpy(addr, &from, sizeof(ogs_sockaddr_t));
 
         ngap_event_push(AMF_EVENT_NGAP_MESSAGE, sock, addr, pkbuf, 0, 0);
-        return;
+        return OGS_OK;
     } else {
         if (ogs_socket_errno != OGS_EAGAIN) {
             ogs_fatal("ogs_sctp_recvmsg(%d) failed(%d:%s-0x%x)",
@@ -249,4 +267,5 @@ void ngap_recv_handler(ogs_sock_t *sock)
     }
 
     ogs_pkbuf_free(pkbuf);
+    return OGS_DONE;
 }
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ngap-worker.h"
+#include "ngap-path.h"
+
+/*
+ * NGAP I/O threads, see ogs_sctp_worker_open(). A gNB association read
+ * by an I/O thread is decoded there as well, and the decoded message
+ * travels to the AMF thread in the event with its ASN.1 arena detached.
+ */
+static void *ngap_decode(ogs_pkbuf_t *pkbuf)
+{
+    ogs_ngap_message_t *message = NULL;
+
+    ogs_assert(pkbuf);
+
+    message = ogs_calloc(1, sizeof(*message));
+    ogs_assert(message);
+
+    if (ogs_ngap_decode(message, pkbuf) != OGS_OK) {
+        /* The AMF thread decodes it again to send Error Indication */
+        ogs_ngap_free(message);
+        ogs_free(message);
+        return NULL;
+    }
+
+    return message;
+}
+
+static void ngap_message_free(void *message)
+{
+    ogs_assert(message);
+
+    ogs_ngap_free(message);
+    ogs_free(message);
+}
+
+int amf_ngap_worker_open(void)
+{
+    int rv;
+
+    rv = ogs_sctp_worker_open(amf_self()->ngap_io_thread,
+            ngap_recv_upcall, ngap_decode, ngap_message_free);
+    if (rv != OGS_OK) return rv;
+
+    if (ogs_sctp_worker_is_enabled())
+        ogs_info("ngap_server() with %d I/O thread(s)",
+                amf_self()->ngap_io_thread);
+
+    return OGS_OK;
+}
+
+void amf_ngap_worker_close(void)
+{
+    ogs_sctp_worker_close();
+}
+
+void amf_ngap_worker_decode(amf_event_t *e)
+{
+    ogs_assert(e);
+    ogs_assert(e->pkbuf);
+
+    e->ngap.message = ogs_sctp_worker_decode(e->pkbuf);
+    if (e->ngap.message)
+        e->ngap.arena = ogs_asn_detach(e->ngap.message);
+}
+
+void amf_ngap_worker_message_free(amf_event_t *e)
+{
+    ogs_assert(e);
+    ogs_assert(e->ngap.message);
+
+    ogs_asn_attach(e->ngap.arena);
+    ogs_sctp_worker_message_free(e->ngap.message);
+
+    e->ngap.message = NULL;
+    e->ngap.arena = NULL;
+}
@@ -104,9 +104,11 @@ int amf_nudm_sdm_handle_provisioned(
                 if (DefaultSingleNssaiList) {
                     OpenAPI_list_for_each(DefaultSingleNssaiList, node) {
                         OpenAPI_snssai_t *Snssai = node->data;
+                        ogs_slice_data_t *slice = amf_ue_slice_add(amf_ue);
+
+                        if (!slice)
+                            break;
 
-                        ogs_slice_data_t *slice =
-                            &amf_ue->slice[amf_ue->num_of_slice];
                         if (Snssai) {
                             slice->s_nssai.sst = Snssai->sst;
                             slice->s_nssai.sd =
@@ -115,17 +117,17 @@ int amf_nudm_sdm_handle_provisioned(
 
                         /* DEFAULT S-NSSAI */
                         slice->default_indicator = true;
-
-                        amf_ue->num_of_slice++;
                     }
 
                     SingleNssaiList = NSSAI->single_nssais;
                     if (SingleNssaiList) {
                         OpenAPI_list_for_each(SingleNssaiList, node) {
                             OpenAPI_snssai_t *Snssai = node->data;
+                            ogs_slice_data_t *slice = amf_ue_slice_add(amf_ue);
+
+                            if (!slice)
+                                break;
 
-                            ogs_slice_data_t *slice =
-                                &amf_ue->slice[amf_ue->num_of_slice];
                             if (Snssai) {
                                 slice->s_nssai.sst = Snssai->sst;
                                 slice->s_nssai.sd =
@@ -134,8 +136,6 @@ int amf_nudm_sdm_handle_provisioned(
 
                             /* Non default S-NSSAI */
                             slice->default_indicator = false;
-
-                            amf_ue->num_of_slice++;
                         }
                     }
                 }
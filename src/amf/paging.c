@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "ngap-path.h"
+#include "paging.h"
+
+/*
+ * Paging scheduler
+ *
+ * With amf.paging.rate set, each gNB gets at most `rate` Paging messages
+ * per amf.paging.interval. Anything above that waits in the gNB's queue
+ * and is drained by a single timer, so a downlink burst towards many idle
+ * UEs is spread out instead of hitting the gNBs at once. Every queued
+ * entry holds a copy of the encoded PDU and is dropped with its UE's
+ * paging, so nothing goes out once the UE has answered.
+ */
+
+typedef struct amf_paging_s {
+    ogs_lnode_t     lnode;
+    ogs_pkbuf_t     *pkbuf;
+    amf_ue_t        *amf_ue;
+} amf_paging_t;
+
+static OGS_POOL(amf_paging_pool, amf_paging_t);
+
+static ogs_timer_t *t_paging = NULL;
+static int num_of_pending = 0;
+static uint64_t paging_mark = 0;
+
+void amf_paging_init(void)
+{
+    ogs_pool_init(&amf_paging_pool, ogs_app()->max.ue);
+
+    t_paging = ogs_timer_add(
+            ogs_app()->timer_mgr, amf_timer_paging_expire, NULL);
+    ogs_assert(t_paging);
+}
+
+void amf_paging_final(void)
+{
+    ogs_assert(t_paging);
+    ogs_timer_delete(t_paging);
+    t_paging = NULL;
+
+    ogs_pool_final(&amf_paging_pool);
+}
+
+static int paging_send_to_gnb(amf_gnb_t *gnb, ogs_pkbuf_t *pkbuf)
+{
+    int rv;
+
+    ogs_assert(gnb);
+    ogs_assert(pkbuf);
+
+    gnb->paging.count++;
+    amf_metrics_inst_global_inc(AMF_METR_GLOB_CTR_MM_PAGING_5G_REQ);
+
+    rv = ngap_send_to_gnb(gnb, pkbuf, NGAP_NON_UE_SIGNALLING);
+    if (rv != OGS_OK)
+        ogs_error("ngap_send_to_gnb() failed");
+
+    return rv;
+}
+
+static int paging_add(amf_gnb_t *gnb, amf_ue_t *amf_ue, ogs_pkbuf_t *pkbuf)
+{
+    ogs_pkbuf_t *copy = NULL;
+    amf_paging_t *paging = NULL;
+    int rate = amf_self()->paging.rate;
+
+    ogs_assert(gnb);
+    ogs_assert(amf_ue);
+    ogs_assert(pkbuf);
+
+    /* A gNB serving several TAIs of the paging area is paged once */
+    if (gnb->paging.mark == paging_mark)
+        return OGS_OK;
+    gnb->paging.mark = paging_mark;
+
+    copy = ogs_pkbuf_copy(pkbuf);
+    if (!copy) {
+        ogs_error("ogs_pkbuf_copy() failed");
+        return OGS_ERROR;
+    }
+
+    if (rate > 0) {
+        ogs_time_t now = ogs_get_monotonic_time();
+
+        if (now - gnb->paging.window >= amf_self()->paging.interval) {
+            gnb->paging.window = now;
+            gnb->paging.count = 0;
+        }
+
+        if (ogs_list_first(&gnb->paging.list) ||
+            gnb->paging.count >= rate) {
+            ogs_pool_alloc(&amf_paging_pool, &paging);
+            if (paging) {
+                paging->pkbuf = copy;
+                paging->amf_ue = amf_ue;
+                ogs_list_add(&gnb->paging.list, paging);
+                num_of_pending++;
+
+                if (ogs_timer_running(t_paging) == false)
+                    ogs_timer_start(t_paging, amf_self()->paging.interval);
+
+                return OGS_OK;
+            }
+
+            ogs_warn("Paging queue is full, send it now");
+        }
+    }
+
+    return paging_send_to_gnb(gnb, copy);
+}
+
+static int paging_tai(
+        ogs_5gs_tai_t *tai, amf_ue_t *amf_ue, ogs_pkbuf_t *pkbuf)
+{
+    amf_tai_index_t *index = NULL;
+    amf_tai_link_t *link = NULL;
+    int rv = OGS_OK, r;
+
+    ogs_assert(tai);
+
+    index = amf_tai_index_find(tai);
+    if (!index)
+        return OGS_OK;
+
+    ogs_list_for_each(&index->link_list, link) {
+        r = paging_add(link->gnb, amf_ue, pkbuf);
+        if (r != OGS_OK)
+            rv = r;
+    }
+
+    return rv;
+}
+
+static int paging_tai_list(
+        int served_tai_index, amf_ue_t *amf_ue, ogs_pkbuf_t *pkbuf)
+{
+    ogs_5gs_tai0_list_t *list0 = NULL;
+    ogs_5gs_tai1_list_t *list1 = NULL;
+    ogs_5gs_tai2_list_t *list2 = NULL;
+    ogs_5gs_tai_t tai;
+    int rv = OGS_OK, r;
+    int j, k;
+
+    ogs_assert(served_tai_index >= 0 &&
+            served_tai_index < OGS_MAX_NUM_OF_SERVED_TAI);
+
+    list0 = &amf_self()->served_tai[served_tai_index].list0;
+    list1 = &amf_self()->served_tai[served_tai_index].list1;
+    list2 = &amf_self()->served_tai[served_tai_index].list2;
+
+    for (j = 0; j < OGS_MAX_NUM_OF_TAI && list0->tai[j].num; j++) {
+        for (k = 0; k < list0->tai[j].num; k++) {
+            memset(&tai, 0, sizeof(tai));
+            memcpy(&tai.plmn_id, &list0->tai[j].plmn_id, OGS_PLMN_ID_LEN);
+            tai.tac.v = list0->tai[j].tac[k].v;
+
+            r = paging_tai(&tai, amf_ue, pkbuf);
+            if (r != OGS_OK)
+                rv = r;
+        }
+    }
+
+    for (j = 0; j < OGS_MAX_NUM_OF_TAI && list1->tai[j].num; j++) {
+        for (k = 0; k < list1->tai[j].num; k++) {
+            memset(&tai, 0, sizeof(tai));
+            memcpy(&tai.plmn_id, &list1->tai[j].plmn_id, OGS_PLMN_ID_LEN);
+            tai.tac.v = list1->tai[j].tac.v + k;
+
+            r = paging_tai(&tai, amf_ue, pkbuf);
+            if (r != OGS_OK)
+                rv = r;
+        }
+    }
+
+    for (j = 0; j < list2->num; j++) {
+        memcpy(&tai, &list2->tai[j], sizeof(tai));
+
+        r = paging_tai(&tai, amf_ue, pkbuf);
+        if (r != OGS_OK)
+            rv = r;
+    }
+
+    return rv;
+}
+
+/*
+ * Page the UE over the area chosen by amf.paging.escalation for this
+ * T3513 attempt. 'pkbuf' is not consumed.
+ */
+int amf_paging_send(amf_ue_t *amf_ue, ogs_pkbuf_t *pkbuf)
+{
+    int step, area;
+
+    ogs_assert(amf_ue);
+    ogs_assert(pkbuf);
+    ogs_assert(amf_self()->paging.num_of_escalation > 0);
+
+    step = amf_ue->t3513.retry_count;
+    if (step >= amf_self()->paging.num_of_escalation)
+        step = amf_self()->paging.num_of_escalation - 1;
+    area = amf_self()->paging.escalation[step];
+
+    paging_mark++;
+
+    if (area == AMF_PAGING_AREA_LAST_GNB) {
+        amf_gnb_t *gnb = NULL;
+
+        if (amf_ue->last_gnb.presence == true)
+            gnb = amf_gnb_find_by_gnb_id(amf_ue->last_gnb.gnb_id);
+        if (gnb) {
+            ogs_debug("[%s] Paging last gNB[0x%x]",
+                    amf_ue->supi, amf_ue->last_gnb.gnb_id);
+            return paging_add(gnb, amf_ue, pkbuf);
+        }
+
+        area = AMF_PAGING_AREA_TAI;
+    }
+
+    if (area == AMF_PAGING_AREA_TAI_LIST) {
+        int served_tai_index = amf_find_served_tai(&amf_ue->nr_tai);
+        if (served_tai_index >= 0) {
+            ogs_debug("[%s] Paging TAI list[%d]",
+                    amf_ue->supi, served_tai_index);
+            return paging_tai_list(served_tai_index, amf_ue, pkbuf);
+        }
+
+        area = AMF_PAGING_AREA_TAI;
+    }
+
+    ogs_assert(area == AMF_PAGING_AREA_TAI);
+    return paging_tai(&amf_ue->nr_tai, amf_ue, pkbuf);
+}
+
+void amf_paging_run(void)
+{
+    amf_gnb_t *gnb = NULL;
+    amf_paging_t *paging = NULL;
+    ogs_time_t now = ogs_get_monotonic_time();
+    int rate = amf_self()->paging.rate;
+
+    ogs_list_for_each(&amf_self()->gnb_list, gnb) {
+        if (ogs_list_first(&gnb->paging.list) == NULL)
+            continue;
+
+        gnb->paging.window = now;
+        gnb->paging.count = 0;
+
+        while (gnb->paging.count < rate) {
+            paging = ogs_list_first(&gnb->paging.list);
+            if (!paging)
+                break;
+
+            ogs_list_remove(&gnb->paging.list, paging);
+            num_of_pending--;
+
+            paging_send_to_gnb(gnb, paging->pkbuf);
+            ogs_pool_free(&amf_paging_pool, paging);
+        }
+    }
+
+    if (num_of_pending > 0)
+        ogs_timer_start(t_paging, amf_self()->paging.interval);
+}
+
+void amf_paging_remove_all(amf_gnb_t *gnb)
+{
+    amf_paging_t *paging = NULL, *next_paging = NULL;
+
+    ogs_assert(gnb);
+
+    ogs_list_for_each_safe(&gnb->paging.list, next_paging, paging) {
+        ogs_list_remove(&gnb->paging.list, paging);
+        num_of_pending--;
+
+        ogs_pkbuf_free(paging->pkbuf);
+        ogs_pool_free(&amf_paging_pool, paging);
+    }
+}
+
+void amf_paging_remove_ue(amf_ue_t *amf_ue)
+{
+    amf_gnb_t *gnb = NULL;
+    amf_paging_t *paging = NULL, *next_paging = NULL;
+
+    ogs_assert(amf_ue);
+
+    ogs_list_for_each(&amf_self()->gnb_list, gnb) {
+        if (num_of_pending == 0)
+            break;
+
+        ogs_list_for_each_safe(&gnb->paging.list, next_paging, paging) {
+            if (paging->amf_ue != amf_ue)
+                continue;
+
+            ogs_list_remove(&gnb->paging.list, paging);
+            num_of_pending--;
+
+            ogs_pkbuf_free(paging->pkbuf);
+            ogs_pool_free(&amf_paging_pool, paging);
+        }
+    }
+}
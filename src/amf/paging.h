@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef AMF_PAGING_H
+#define AMF_PAGING_H
+
+#include "context.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void amf_paging_init(void);
+void amf_paging_final(void);
+
+int amf_paging_send(amf_ue_t *amf_ue, ogs_pkbuf_t *pkbuf);
+void amf_paging_run(void);
+
+void amf_paging_remove_all(amf_gnb_t *gnb);
+void amf_paging_remove_ue(amf_ue_t *amf_ue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMF_PAGING_H */
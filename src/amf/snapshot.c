@@ -0,0 +1,738 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "snapshot.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+/*
+ * UE snapshot
+ *
+ * With amf.snapshot.path set, the 5G-GUTI, NAS security context and
+ * subscribed slices of a registered UE are appended to a memory-mapped
+ * file each time the UE goes to CM-IDLE. A removal record is appended
+ * when the UE context goes away. Appending is a memcpy into the mapping,
+ * so the data survives a crash or restart of the process.
+ *
+ * At start-up the last record of every UE is replayed. The UEs come back
+ * RM-REGISTERED/CM-IDLE with their old 5G-GUTI, so their next Service
+ * Request or Registration Request is integrity checked against the
+ * restored context instead of going through AUSF and UDM again.
+ * PDU session contexts are not kept.
+ *
+ * A record does not hold the DL NAS COUNT but a mark above it, and the
+ * UE is stored again before its count reaches that mark. A restored UE
+ * starts at the mark, so no DL NAS COUNT is ever used twice with the
+ * same key. The mark stays less than 256 ahead, so the UE still
+ * estimates the COUNT from the sequence number.
+ *
+ * When the file is full it is rewritten from the live UE contexts.
+ */
+
+#define AMF_SNAPSHOT_MAGIC      0x414d4653  /* AMFS */
+#define AMF_SNAPSHOT_VERSION    2
+
+#define AMF_SNAPSHOT_STORE      1
+#define AMF_SNAPSHOT_REMOVE     2
+
+#define AMF_SNAPSHOT_DL_COUNT_MARGIN    128
+
+typedef struct amf_snapshot_header_s {
+    uint32_t        magic;
+    uint32_t        version;
+    uint32_t        ue_size;    /* sizeof(amf_snapshot_ue_t) of the writer */
+    uint32_t        spare;
+    uint64_t        end;        /* Offset past the last complete record */
+} amf_snapshot_header_t;
+
+typedef struct amf_snapshot_record_s {
+    uint32_t        length;     /* With this header, multiple of 8 */
+    uint8_t         type;
+    uint8_t         spare[3];
+} amf_snapshot_record_t;
+
+/* AMF_SNAPSHOT_STORE: followed by SUPI, SUCI and the subscribed slices */
+typedef struct amf_snapshot_ue_s {
+    ogs_nas_5gs_guti_t guti;
+    ogs_5gs_tai_t   nr_tai;
+    ogs_nr_cgi_t    nr_cgi;
+    uint32_t        last_gnb_id;
+    uint8_t         last_gnb_presence;
+
+    uint8_t         amf_tsc, amf_ksi;
+    uint8_t         ue_tsc, ue_ksi;
+    uint8_t         selected_enc_algorithm;
+    uint8_t         selected_int_algorithm;
+    ogs_nas_ue_security_capability_t ue_security_capability;
+    ogs_nas_ue_network_capability_t ue_network_capability;
+    uint8_t         kamf[OGS_SHA256_DIGEST_SIZE];
+    uint32_t        dl_count;   /* Mark: no DL NAS COUNT used at or above */
+    uint32_t        ul_count;
+
+    ogs_bitrate_t   ue_ambr;
+    int             num_of_allowed_nssai;
+    ogs_nas_s_nssai_ie_t allowed_nssai[OGS_MAX_NUM_OF_SLICE];
+
+    uint16_t        supi_len;
+    uint16_t        suci_len;
+    uint8_t         num_of_slice;
+} amf_snapshot_ue_t;
+
+/* Followed by num_of_session DNNs, each as
+ * default indicator (1 byte), length (1 byte) and name */
+typedef struct amf_snapshot_slice_s {
+    ogs_s_nssai_t   s_nssai;
+    uint8_t         default_indicator;
+    uint8_t         num_of_session;
+} __attribute__ ((packed)) amf_snapshot_slice_t;
+
+/* AMF_SNAPSHOT_REMOVE: followed by SUPI */
+typedef struct amf_snapshot_remove_s {
+    uint32_t        m_tmsi;
+    uint16_t        supi_len;
+} amf_snapshot_remove_t;
+
+static struct {
+    int             fd;
+    uint8_t         *base;
+    size_t          size;
+} snapshot = { -1, NULL, 0 };
+
+#define SNAPSHOT_HEADER(__bASE) ((amf_snapshot_header_t *)(__bASE))
+#define SNAPSHOT_ALIGN(__lEN) (((__lEN) + 7) & ~((size_t)7))
+
+static bool ue_is_stored(amf_ue_t *amf_ue)
+{
+    return OGS_FSM_CHECK(&amf_ue->sm, gmm_state_registered) &&
+        SECURITY_CONTEXT_IS_VALID(amf_ue) &&
+        amf_ue->supi && amf_ue->suci &&
+        amf_ue->current.m_tmsi && amf_ue->guami;
+}
+
+static uint32_t ue_dl_count_mark(amf_ue_t *amf_ue)
+{
+    return (amf_ue->dl_count + AMF_SNAPSHOT_DL_COUNT_MARGIN) & 0xffffff;
+}
+
+static size_t ue_record_length(amf_ue_t *amf_ue)
+{
+    int i, j;
+    size_t length;
+
+    length = sizeof(amf_snapshot_record_t) + sizeof(amf_snapshot_ue_t) +
+        strlen(amf_ue->supi) + strlen(amf_ue->suci);
+
+    for (i = 0; i < amf_ue->num_of_slice; i++) {
+        ogs_slice_data_t *slice = &amf_ue->slice[i];
+
+        length += sizeof(amf_snapshot_slice_t);
+        for (j = 0; j < slice->num_of_session; j++)
+            length += 2 + ogs_min(strlen(slice->session[j].name),
+                    OGS_MAX_DNN_LEN);
+    }
+
+    return SNAPSHOT_ALIGN(length);
+}
+
+static void ue_record_write(amf_ue_t *amf_ue, uint8_t *p, size_t length)
+{
+    int i, j;
+    amf_snapshot_record_t *record = (amf_snapshot_record_t *)p;
+    amf_snapshot_ue_t *ue = (amf_snapshot_ue_t *)(record + 1);
+
+    memset(p, 0, length);
+
+    record->length = length;
+    record->type = AMF_SNAPSHOT_STORE;
+
+    memcpy(&ue->guti, &amf_ue->current.guti, sizeof(ue->guti));
+    memcpy(&ue->nr_tai, &amf_ue->nr_tai, sizeof(ue->nr_tai));
+    memcpy(&ue->nr_cgi, &amf_ue->nr_cgi, sizeof(ue->nr_cgi));
+    ue->last_gnb_presence = amf_ue->last_gnb.presence;
+    ue->last_gnb_id = amf_ue->last_gnb.gnb_id;
+
+    ue->amf_tsc = amf_ue->nas.amf.tsc;
+    ue->amf_ksi = amf_ue->nas.amf.ksi;
+    ue->ue_tsc = amf_ue->nas.ue.tsc;
+    ue->ue_ksi = amf_ue->nas.ue.ksi;
+    ue->selected_enc_algorithm = amf_ue->selected_enc_algorithm;
+    ue->selected_int_algorithm = amf_ue->selected_int_algorithm;
+    memcpy(&ue->ue_security_capability, &amf_ue->ue_security_capability,
+            sizeof(ue->ue_security_capability));
+    memcpy(&ue->ue_network_capability, &amf_ue->ue_network_capability,
+            sizeof(ue->ue_network_capability));
+    memcpy(ue->kamf, amf_ue->kamf, sizeof(ue->kamf));
+    ue->dl_count = ue_dl_count_mark(amf_ue);
+    ue->ul_count = amf_ue->ul_count.i32;
+
+    memcpy(&ue->ue_ambr, &amf_ue->ue_ambr, sizeof(ue->ue_ambr));
+    ue->num_of_allowed_nssai = amf_ue->allowed_nssai.num_of_s_nssai;
+    memcpy(ue->allowed_nssai, amf_ue->allowed_nssai.s_nssai,
+            sizeof(ue->allowed_nssai));
+
+    ue->supi_len = strlen(amf_ue->supi);
+    ue->suci_len = strlen(amf_ue->suci);
+    ue->num_of_slice = amf_ue->num_of_slice;
+
+    p = (uint8_t *)(ue + 1);
+    memcpy(p, amf_ue->supi, ue->supi_len);
+    p += ue->supi_len;
+    memcpy(p, amf_ue->suci, ue->suci_len);
+    p += ue->suci_len;
+
+    for (i = 0; i < amf_ue->num_of_slice; i++) {
+        ogs_slice_data_t *slice = &amf_ue->slice[i];
+        amf_snapshot_slice_t *s = (amf_snapshot_slice_t *)p;
+
+        memcpy(&s->s_nssai, &slice->s_nssai, sizeof(s->s_nssai));
+        s->default_indicator = slice->default_indicator;
+        s->num_of_session = slice->num_of_session;
+        p += sizeof(*s);
+
+        for (j = 0; j < slice->num_of_session; j++) {
+            ogs_session_t *session = &slice->session[j];
+            uint8_t len = ogs_min(strlen(session->name), OGS_MAX_DNN_LEN);
+
+            *p++ = session->default_dnn_indicator;
+            *p++ = len;
+            memcpy(p, session->name, len);
+            p += len;
+        }
+    }
+}
+
+static int ue_record_append(uint8_t *base, size_t size, amf_ue_t *amf_ue)
+{
+    amf_snapshot_header_t *header = SNAPSHOT_HEADER(base);
+    size_t length = ue_record_length(amf_ue);
+
+    if (header->end + length > size)
+        return OGS_RETRY;
+
+    ue_record_write(amf_ue, base + header->end, length);
+    header->end += length;
+
+    return OGS_OK;
+}
+
+/* Rewrite the file from the live UE contexts, except 'exclude' */
+static int snapshot_compact(amf_ue_t *exclude)
+{
+    const char *path = amf_self()->snapshot.path;
+    size_t size = amf_self()->snapshot.size;
+    amf_snapshot_header_t *header = NULL;
+    amf_ue_t *amf_ue = NULL;
+    char *tmp = NULL;
+    uint8_t *base = NULL;
+    int fd, rv, count = 0;
+
+    ogs_assert(path);
+
+    tmp = ogs_msprintf("%s.tmp", path);
+    ogs_assert(tmp);
+
+    fd = open(tmp, O_RDWR|O_CREAT|O_TRUNC, 0600);
+    if (fd < 0) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno,
+                "open() failed for '%s'", tmp);
+        ogs_free(tmp);
+        return OGS_ERROR;
+    }
+    if (ftruncate(fd, size) != 0) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno,
+                "ftruncate() failed for '%s'", tmp);
+        goto cleanup;
+    }
+    base = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno,
+                "mmap() failed for '%s'", tmp);
+        base = NULL;
+        goto cleanup;
+    }
+
+    header = SNAPSHOT_HEADER(base);
+    header->magic = AMF_SNAPSHOT_MAGIC;
+    header->version = AMF_SNAPSHOT_VERSION;
+    header->ue_size = sizeof(amf_snapshot_ue_t);
+    header->end = SNAPSHOT_ALIGN(sizeof(*header));
+
+    ogs_list_for_each(&amf_self()->amf_ue_list, amf_ue) {
+        if (amf_ue == exclude || !ue_is_stored(amf_ue))
+            continue;
+
+        rv = ue_record_append(base, size, amf_ue);
+        if (rv != OGS_OK) {
+            ogs_error("amf.snapshot.size is too small for %d UEs",
+                    ogs_list_count(&amf_self()->amf_ue_list));
+            break;
+        }
+        count++;
+    }
+
+    if (rename(tmp, path) != 0) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno,
+                "rename() failed for '%s'", path);
+        goto cleanup;
+    }
+    ogs_free(tmp);
+
+    amf_snapshot_close();
+
+    /* The same walk as above: the first 'count' stored UEs made it */
+    ogs_list_for_each(&amf_self()->amf_ue_list, amf_ue) {
+        amf_ue->snapshot.stored = false;
+        if (amf_ue == exclude || !ue_is_stored(amf_ue) || count == 0)
+            continue;
+
+        amf_ue->snapshot.stored = true;
+        amf_ue->snapshot.m_tmsi = amf_ue->current.guti.m_tmsi;
+        amf_ue->snapshot.dl_count = ue_dl_count_mark(amf_ue);
+        count--;
+    }
+
+    snapshot.fd = fd;
+    snapshot.base = base;
+    snapshot.size = size;
+
+    ogs_debug("[%s] Snapshot rewritten", path);
+
+    return OGS_OK;
+
+cleanup:
+    if (base)
+        munmap(base, size);
+    close(fd);
+    unlink(tmp);
+    ogs_free(tmp);
+
+    return OGS_ERROR;
+}
+
+/* The file is full: rewrite it, or give up if that would not last */
+static void snapshot_rewrite(amf_ue_t *exclude)
+{
+    amf_snapshot_header_t *header = NULL;
+
+    if (snapshot_compact(exclude) == OGS_OK) {
+        header = SNAPSHOT_HEADER(snapshot.base);
+        if (header->end <= snapshot.size / 8 * 7)
+            return;
+    }
+
+    ogs_error("[%s] Snapshot disabled, check amf.snapshot.size",
+            amf_self()->snapshot.path);
+    amf_snapshot_close();
+}
+
+static void *pull(uint8_t **p, uint8_t *end, size_t len)
+{
+    void *data = *p;
+
+    if (len > (size_t)(end - *p))
+        return NULL;
+
+    *p += len;
+    return data;
+}
+
+static ogs_guami_t *guami_find(ogs_nas_5gs_guti_t *guti)
+{
+    ogs_plmn_id_t plmn_id;
+    int i;
+
+    ogs_nas_to_plmn_id(&plmn_id, &guti->nas_plmn_id);
+
+    for (i = 0; i < amf_self()->num_of_served_guami; i++) {
+        ogs_guami_t *guami = &amf_self()->served_guami[i];
+
+        if (memcmp(&guami->plmn_id, &plmn_id, OGS_PLMN_ID_LEN) == 0 &&
+            memcmp(&guami->amf_id, &guti->amf_id, sizeof(ogs_amf_id_t)) == 0)
+            return guami;
+    }
+
+    return NULL;
+}
+
+static int ue_restore_slice(amf_ue_t *amf_ue, amf_snapshot_ue_t *ue,
+        uint8_t *p, uint8_t *end)
+{
+    int i, j;
+
+    if (ue->num_of_slice > OGS_MAX_NUM_OF_SLICE)
+        return OGS_ERROR;
+
+    for (i = 0; i < ue->num_of_slice; i++) {
+        ogs_slice_data_t *slice = NULL;
+        amf_snapshot_slice_t *s = pull(&p, end, sizeof(*s));
+
+        if (!s || s->num_of_session > OGS_MAX_NUM_OF_SESS)
+            return OGS_ERROR;
+
+        slice = amf_ue_slice_add(amf_ue);
+        if (!slice)
+            return OGS_ERROR;
+
+        memcpy(&slice->s_nssai, &s->s_nssai, sizeof(slice->s_nssai));
+        slice->default_indicator = s->default_indicator;
+
+        for (j = 0; j < s->num_of_session; j++) {
+            ogs_session_t *session = &slice->session[j];
+            uint8_t *dnn = pull(&p, end, 2);
+
+            if (!dnn || !pull(&p, end, dnn[1]))
+                return OGS_ERROR;
+
+            session->default_dnn_indicator = dnn[0];
+            session->name = ogs_strndup((char *)dnn + 2, dnn[1]);
+            ogs_assert(session->name);
+            slice->num_of_session++;
+        }
+    }
+
+    return OGS_OK;
+}
+
+static void ue_restore(amf_snapshot_record_t *record,
+        ogs_guami_t *guami, amf_m_tmsi_t *m_tmsi)
+{
+    amf_snapshot_ue_t *ue = (amf_snapshot_ue_t *)(record + 1);
+    uint8_t *p = (uint8_t *)(ue + 1);
+    uint8_t *end = (uint8_t *)record + record->length;
+    uint8_t knas_int[OGS_SHA256_DIGEST_SIZE/2];
+    uint8_t knas_enc[OGS_SHA256_DIGEST_SIZE/2];
+    char *supi = NULL, *suci = NULL;
+    amf_ue_t *amf_ue = NULL;
+    amf_event_t e;
+
+    supi = pull(&p, end, ue->supi_len);
+    suci = pull(&p, end, ue->suci_len);
+    if (!supi || !suci || !ue->suci_len) {
+        ogs_error("Corrupted UE in snapshot");
+        ogs_assert(amf_m_tmsi_free(m_tmsi) == OGS_OK);
+        return;
+    }
+
+    amf_ue = amf_ue_add(NULL);
+    if (!amf_ue) {
+        ogs_assert(amf_m_tmsi_free(m_tmsi) == OGS_OK);
+        return;
+    }
+
+    supi = ogs_strndup(supi, ue->supi_len);
+    ogs_assert(supi);
+    amf_ue_set_supi(amf_ue, supi);
+    ogs_free(supi);
+
+    amf_ue->suci = ogs_strndup(suci, ue->suci_len);
+    ogs_assert(amf_ue->suci);
+    ogs_hash_set(amf_self()->suci_hash,
+            amf_ue->suci, strlen(amf_ue->suci), amf_ue);
+
+    amf_ue->guami = guami;
+    amf_ue->next.m_tmsi = m_tmsi;
+    memcpy(&amf_ue->next.guti, &ue->guti, sizeof(ue->guti));
+    amf_ue_confirm_guti(amf_ue);
+
+    if (ue_restore_slice(amf_ue, ue, p, end) != OGS_OK) {
+        ogs_error("[%s] Corrupted slice in snapshot", amf_ue->supi);
+        amf_ue_remove(amf_ue);
+        return;
+    }
+
+    memcpy(&amf_ue->nr_tai, &ue->nr_tai, sizeof(ue->nr_tai));
+    memcpy(&amf_ue->nr_cgi, &ue->nr_cgi, sizeof(ue->nr_cgi));
+    amf_ue->last_gnb.presence = ue->last_gnb_presence;
+    amf_ue->last_gnb.gnb_id = ue->last_gnb_id;
+
+    amf_ue->nas.amf.tsc = ue->amf_tsc;
+    amf_ue->nas.amf.ksi = ue->amf_ksi;
+    amf_ue->nas.ue.tsc = ue->ue_tsc;
+    amf_ue->nas.ue.ksi = ue->ue_ksi;
+    amf_ue->selected_enc_algorithm = ue->selected_enc_algorithm;
+    amf_ue->selected_int_algorithm = ue->selected_int_algorithm;
+    memcpy(&amf_ue->ue_security_capability, &ue->ue_security_capability,
+            sizeof(ue->ue_security_capability));
+    memcpy(&amf_ue->ue_network_capability, &ue->ue_network_capability,
+            sizeof(ue->ue_network_capability));
+    memcpy(amf_ue->kamf, ue->kamf, sizeof(ue->kamf));
+    ogs_kdf_key_init(&amf_ue->kamf_key,
+            amf_ue->kamf, OGS_SHA256_DIGEST_SIZE);
+    ogs_kdf_nas_5gs_from_key(OGS_KDF_NAS_INT_ALG,
+            amf_ue->selected_int_algorithm,
+            &amf_ue->kamf_key, knas_int);
+    ogs_kdf_nas_5gs_from_key(OGS_KDF_NAS_ENC_ALG,
+            amf_ue->selected_enc_algorithm,
+            &amf_ue->kamf_key, knas_enc);
+    ogs_nas_security_key_init(&amf_ue->nas_key,
+            amf_ue->selected_int_algorithm, knas_int,
+            amf_ue->selected_enc_algorithm, knas_enc);
+    amf_ue->dl_count = ue->dl_count;
+    amf_ue->ul_count.i32 = ue->ul_count;
+    amf_ue->security_context_available = 1;
+
+    memcpy(&amf_ue->ue_ambr, &ue->ue_ambr, sizeof(ue->ue_ambr));
+    amf_ue->allowed_nssai.num_of_s_nssai =
+        ogs_min(ue->num_of_allowed_nssai, OGS_MAX_NUM_OF_SLICE);
+    memcpy(amf_ue->allowed_nssai.s_nssai, ue->allowed_nssai,
+            sizeof(ue->allowed_nssai));
+
+    memset(&e, 0, sizeof(e));
+    e.amf_ue = amf_ue;
+    ogs_fsm_tran(&amf_ue->sm, gmm_state_registered, &e);
+
+    /* Same supervision as a UE released to CM-IDLE */
+    ogs_timer_start(amf_ue->mobile_reachable.timer,
+            ogs_time_from_sec(amf_self()->time.t3512.value + 240));
+}
+
+static void snapshot_load(const char *path, uint8_t *base, size_t size)
+{
+    amf_snapshot_header_t *header = SNAPSHOT_HEADER(base);
+    amf_snapshot_record_t **record = NULL;
+    ogs_guami_t **guami = NULL;
+    amf_m_tmsi_t **m_tmsi = NULL;
+    uint32_t *value = NULL;
+    ogs_hash_t *hash = NULL;
+    ogs_hash_index_t *hi = NULL;
+    uint8_t *p, *end;
+    int i, num = 0, count = 0;
+
+    if (size < sizeof(*header) ||
+        header->magic != AMF_SNAPSHOT_MAGIC ||
+        header->version != AMF_SNAPSHOT_VERSION ||
+        header->ue_size != sizeof(amf_snapshot_ue_t) ||
+        header->end > size) {
+        ogs_warn("[%s] Ignore incompatible snapshot", path);
+        return;
+    }
+
+    hash = ogs_hash_make();
+    ogs_assert(hash);
+
+    /* Keep the last record of each SUPI */
+    p = base + SNAPSHOT_ALIGN(sizeof(*header));
+    end = base + header->end;
+    while (p + sizeof(amf_snapshot_record_t) <= end) {
+        amf_snapshot_record_t *r = (amf_snapshot_record_t *)p;
+        uint8_t *q = (uint8_t *)(r + 1), *rend = p + r->length;
+
+        if (r->length < sizeof(*r) || r->length % 8 ||
+            r->length > (size_t)(end - p)) {
+            ogs_error("[%s] Corrupted record at %d", path, (int)(p - base));
+            break;
+        }
+
+        if (r->type == AMF_SNAPSHOT_STORE) {
+            amf_snapshot_ue_t *ue = pull(&q, rend, sizeof(*ue));
+            char *supi = ue ? pull(&q, rend, ue->supi_len) : NULL;
+
+            if (ue && supi && ue->supi_len)
+                ogs_hash_set(hash, supi, ue->supi_len, r);
+
+        } else if (r->type == AMF_SNAPSHOT_REMOVE) {
+            amf_snapshot_remove_t *rm = pull(&q, rend, sizeof(*rm));
+            char *supi = rm ? pull(&q, rend, rm->supi_len) : NULL;
+
+            if (rm && supi && rm->supi_len) {
+                amf_snapshot_record_t *stored =
+                    ogs_hash_get(hash, supi, rm->supi_len);
+                if (stored && ((amf_snapshot_ue_t *)(stored + 1))->
+                        guti.m_tmsi == rm->m_tmsi)
+                    ogs_hash_set(hash, supi, rm->supi_len, NULL);
+            }
+        }
+
+        p += r->length;
+    }
+
+    num = ogs_hash_count(hash);
+    if (num) {
+        record = ogs_calloc(num, sizeof(*record));
+        ogs_assert(record);
+        guami = ogs_calloc(num, sizeof(*guami));
+        ogs_assert(guami);
+        value = ogs_calloc(num, sizeof(*value));
+        ogs_assert(value);
+        m_tmsi = ogs_calloc(num, sizeof(*m_tmsi));
+        ogs_assert(m_tmsi);
+
+        num = 0;
+        for (hi = ogs_hash_first(hash); hi; hi = ogs_hash_next(hi)) {
+            amf_snapshot_record_t *r = ogs_hash_this_val(hi);
+            amf_snapshot_ue_t *ue = (amf_snapshot_ue_t *)(r + 1);
+
+            guami[num] = guami_find(&ue->guti);
+            if (!guami[num]) {
+                ogs_warn("Ignore UE of unserved GUAMI[AMF_ID:0x%x]",
+                        ogs_amf_id_hexdump(&ue->guti.amf_id));
+                continue;
+            }
+            record[num] = r;
+            value[num] = ue->guti.m_tmsi;
+            num++;
+        }
+
+        if (amf_m_tmsi_restore(num, value, m_tmsi) == OGS_OK) {
+            for (i = 0; i < num; i++) {
+                if (!m_tmsi[i])
+                    continue;
+                ue_restore(record[i], guami[i], m_tmsi[i]);
+                count++;
+            }
+        }
+
+        ogs_free(record);
+        ogs_free(guami);
+        ogs_free(value);
+        ogs_free(m_tmsi);
+    }
+
+    ogs_hash_destroy(hash);
+
+    ogs_info("[%s] %d UEs restored from snapshot", path, count);
+}
+
+int amf_snapshot_open(void)
+{
+    const char *path = amf_self()->snapshot.path;
+    struct stat st;
+    uint8_t *base = NULL;
+    int fd;
+
+    if (!path)
+        return OGS_OK;
+
+    /* Replay what the previous process left */
+    fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (base != MAP_FAILED) {
+                snapshot_load(path, base, st.st_size);
+                munmap(base, st.st_size);
+            } else {
+                ogs_log_message(OGS_LOG_ERROR, ogs_errno,
+                        "mmap() failed for '%s'", path);
+            }
+        }
+        close(fd);
+    } else if (errno != ENOENT) {
+        ogs_log_message(OGS_LOG_ERROR, ogs_errno,
+                "open() failed for '%s'", path);
+        return OGS_ERROR;
+    }
+
+    /* Start over with only the UEs restored above */
+    return snapshot_compact(NULL);
+}
+
+void amf_snapshot_close(void)
+{
+    if (snapshot.base) {
+        munmap(snapshot.base, snapshot.size);
+        snapshot.base = NULL;
+    }
+    if (snapshot.fd >= 0) {
+        close(snapshot.fd);
+        snapshot.fd = -1;
+    }
+}
+
+void amf_snapshot_store(amf_ue_t *amf_ue)
+{
+    int rv;
+
+    ogs_assert(amf_ue);
+
+    if (!snapshot.base || !ue_is_stored(amf_ue))
+        return;
+
+    rv = ue_record_append(snapshot.base, snapshot.size, amf_ue);
+    if (rv == OGS_OK) {
+        amf_ue->snapshot.stored = true;
+        amf_ue->snapshot.m_tmsi = amf_ue->current.guti.m_tmsi;
+        amf_ue->snapshot.dl_count = ue_dl_count_mark(amf_ue);
+    } else {
+        snapshot_rewrite(NULL);
+    }
+}
+
+void amf_snapshot_remove(amf_ue_t *amf_ue)
+{
+    amf_snapshot_header_t *header = NULL;
+    amf_snapshot_record_t *record = NULL;
+    amf_snapshot_remove_t *rm = NULL;
+    size_t length;
+
+    ogs_assert(amf_ue);
+
+    if (!snapshot.base || !amf_ue->snapshot.stored)
+        return;
+
+    amf_ue->snapshot.stored = false;
+
+    ogs_assert(amf_ue->supi);
+
+    length = SNAPSHOT_ALIGN(sizeof(*record) + sizeof(*rm) +
+            strlen(amf_ue->supi));
+
+    header = SNAPSHOT_HEADER(snapshot.base);
+    if (header->end + length > snapshot.size) {
+        snapshot_rewrite(amf_ue);
+        return;
+    }
+
+    record = (amf_snapshot_record_t *)(snapshot.base + header->end);
+    memset(record, 0, length);
+    record->length = length;
+    record->type = AMF_SNAPSHOT_REMOVE;
+
+    rm = (amf_snapshot_remove_t *)(record + 1);
+    rm->m_tmsi = amf_ue->snapshot.m_tmsi;
+    rm->supi_len = strlen(amf_ue->supi);
+    memcpy(rm + 1, amf_ue->supi, rm->supi_len);
+
+    header->end += length;
+}
+
+void amf_snapshot_update(amf_ue_t *amf_ue)
+{
+    uint32_t left;
+
+    ogs_assert(amf_ue);
+
+    if (!snapshot.base || !amf_ue->snapshot.stored)
+        return;
+
+    /* DL NAS COUNT values left below the mark of the stored record */
+    left = (amf_ue->snapshot.dl_count - amf_ue->dl_count) & 0xffffff;
+    if (left > 0 && left <= AMF_SNAPSHOT_DL_COUNT_MARGIN)
+        return;
+
+    /* Move the mark up, or drop a record that can no longer be updated */
+    if (ue_is_stored(amf_ue))
+        amf_snapshot_store(amf_ue);
+    else
+        amf_snapshot_remove(amf_ue);
+}
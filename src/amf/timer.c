@@ -95,6 +95,8 @@ const char *amf_timer_get_name(int timer_id)
         return "AMF_TIMER_T3570";
     case AMF_TIMER_NG_HOLDING:
         return "AMF_TIMER_NG_HOLDING";
+    case AMF_TIMER_PAGING:
+        return "AMF_TIMER_PAGING";
     case AMF_TIMER_MOBILE_REACHABLE:
         return "AMF_TIMER_MOBILE_REACHABLE";
     case AMF_TIMER_IMPLICIT_DEREGISTRATION:
@@ -190,6 +192,23 @@ void amf_timer_ng_holding_timer_expire(void *data)
     }
 }
 
+void amf_timer_paging_expire(void *data)
+{
+    int rv;
+    amf_event_t *e = NULL;
+
+    e = amf_event_new(AMF_EVENT_NGAP_TIMER);
+    ogs_assert(e);
+
+    e->h.timer_id = AMF_TIMER_PAGING;
+
+    rv = ogs_queue_push(ogs_app()->queue, e);
+    if (rv != OGS_OK) {
+        ogs_error("ogs_queue_push() failed:%d", (int)rv);
+        ogs_event_free(e);
+    }
+}
+
 void amf_timer_mobile_reachable_expire(void *data)
 {
     gmm_timer_event_send(AMF_TIMER_MOBILE_REACHABLE, data);
@@ -0,0 +1,508 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "hss-av-pool.h"
+
+/*
+ * Ready E-UTRAN vectors for recently active subscribers.
+ *
+ * A refill thread reserves SQNs in the database and generates vectors
+ * ahead of time, so that an AIR is answered from memory. Vectors are
+ * handed out in SQN order and dropped as soon as a vector with a higher
+ * SQN was produced elsewhere (resync, pool miss), or the subscriber
+ * changes.
+ */
+typedef struct hss_av_pool_entry_s {
+    ogs_lnode_t lnode;          /* LRU order, most recent last */
+
+    char *imsi_bcd;
+
+    uint64_t generation;        /* Changes when the subscriber changes */
+    uint64_t floor;             /* Vectors below this SQN are stale */
+    bool refilling;
+    bool no_pool;               /* Provisioned with a fixed RAND */
+
+    hss_av_t *av;
+    int first, num_of_av;
+    ogs_time_t expires;
+} hss_av_pool_entry_t;
+
+static OGS_POOL(entry_pool, hss_av_pool_entry_t);
+static OGS_LIST(entry_list);
+static ogs_hash_t *entry_hash;
+static ogs_thread_mutex_t mutex;
+static uint64_t next_generation;
+
+static ogs_queue_t *queue;
+static ogs_thread_t *thread;
+
+static void refill_main(void *data);
+
+int hss_av_pool_open(void)
+{
+    if (hss_self()->av_pool.size == 0)
+        return OGS_OK;
+
+    ogs_pool_init(&entry_pool, hss_self()->av_pool.subscriber);
+    entry_hash = ogs_hash_make();
+    ogs_assert(entry_hash);
+    ogs_thread_mutex_init(&mutex);
+
+    queue = ogs_queue_create(hss_self()->av_pool.subscriber);
+    if (!queue) {
+        ogs_error("ogs_queue_create() failed");
+        return OGS_ERROR;
+    }
+
+    thread = ogs_thread_create(refill_main, NULL);
+    if (!thread) {
+        ogs_error("ogs_thread_create() failed");
+        return OGS_ERROR;
+    }
+
+    ogs_info("AV pool with %d vector(s) for %d subscriber(s)",
+            hss_self()->av_pool.size, hss_self()->av_pool.subscriber);
+
+    return OGS_OK;
+}
+
+static void entry_remove(hss_av_pool_entry_t *entry);
+
+void hss_av_pool_close(void)
+{
+    hss_av_pool_entry_t *entry = NULL, *next_entry = NULL;
+    char *imsi_bcd = NULL;
+
+    if (!queue)
+        return;
+
+    ogs_queue_term(queue);
+    if (thread)
+        ogs_thread_destroy(thread);
+    thread = NULL;
+
+    while (ogs_queue_trypop(queue, (void **)&imsi_bcd) == OGS_OK)
+        ogs_free(imsi_bcd);
+    ogs_queue_destroy(queue);
+    queue = NULL;
+
+    ogs_list_for_each_safe(&entry_list, next_entry, entry)
+        entry_remove(entry);
+
+    ogs_hash_destroy(entry_hash);
+    ogs_pool_final(&entry_pool);
+    ogs_thread_mutex_destroy(&mutex);
+}
+
+static hss_av_pool_entry_t *entry_find(char *imsi_bcd)
+{
+    return ogs_hash_get(entry_hash, imsi_bcd, strlen(imsi_bcd));
+}
+
+static hss_av_pool_entry_t *entry_add(char *imsi_bcd)
+{
+    hss_av_pool_entry_t *entry = NULL;
+
+    /* Make room by dropping the least recently active subscriber */
+    ogs_pool_alloc(&entry_pool, &entry);
+    if (!entry) {
+        entry = ogs_list_first(&entry_list);
+        ogs_assert(entry);
+        entry_remove(entry);
+
+        ogs_pool_alloc(&entry_pool, &entry);
+    }
+    ogs_assert(entry);
+    memset(entry, 0, sizeof *entry);
+
+    entry->imsi_bcd = ogs_strdup(imsi_bcd);
+    ogs_assert(entry->imsi_bcd);
+    entry->av = ogs_calloc(hss_self()->av_pool.size, sizeof(hss_av_t));
+    ogs_assert(entry->av);
+    entry->generation = next_generation++;
+
+    ogs_hash_set(entry_hash, entry->imsi_bcd, strlen(entry->imsi_bcd), entry);
+    ogs_list_add(&entry_list, entry);
+
+    return entry;
+}
+
+static void entry_remove(hss_av_pool_entry_t *entry)
+{
+    ogs_assert(entry);
+
+    ogs_list_remove(&entry_list, entry);
+    ogs_hash_set(entry_hash, entry->imsi_bcd, strlen(entry->imsi_bcd), NULL);
+
+    ogs_free(entry->imsi_bcd);
+    ogs_free(entry->av);
+
+    ogs_pool_free(&entry_pool, entry);
+}
+
+static void entry_clear(hss_av_pool_entry_t *entry)
+{
+    ogs_assert(entry);
+
+    entry->first = 0;
+    entry->num_of_av = 0;
+}
+
+static uint64_t entry_first_sqn(hss_av_pool_entry_t *entry)
+{
+    ogs_assert(entry);
+    ogs_assert(entry->num_of_av);
+
+    return ogs_buffer_to_uint64(entry->av[entry->first].sqn, OGS_SQN_LEN);
+}
+
+int hss_av_pool_take(char *imsi_bcd, hss_av_t *av, int num)
+{
+    hss_av_pool_entry_t *entry = NULL;
+    char *refill_imsi_bcd = NULL;
+    int i, size, taken = 0;
+
+    ogs_assert(imsi_bcd);
+    ogs_assert(av);
+    ogs_assert(num > 0);
+
+    if (!queue)
+        return 0;
+
+    size = hss_self()->av_pool.size;
+
+    ogs_thread_mutex_lock(&mutex);
+
+    entry = entry_find(imsi_bcd);
+    if (!entry) {
+        entry = entry_add(imsi_bcd);
+    } else {
+        ogs_list_remove(&entry_list, entry);
+        ogs_list_add(&entry_list, entry);
+
+        if (entry->num_of_av && ogs_get_monotonic_time() >= entry->expires)
+            entry_clear(entry);
+
+        /* All or nothing, so that the answer stays in SQN order */
+        if (entry->num_of_av >= num) {
+            for (i = 0; i < num; i++) {
+                memcpy(&av[i], &entry->av[entry->first], sizeof(hss_av_t));
+                entry->first = (entry->first + 1) % size;
+                entry->num_of_av--;
+            }
+            taken = num;
+        }
+    }
+
+    /* Refill in batches to save database round trips */
+    if (!entry->no_pool && !entry->refilling &&
+        entry->num_of_av <= size / 2) {
+        refill_imsi_bcd = ogs_strdup(imsi_bcd);
+        ogs_assert(refill_imsi_bcd);
+
+        if (ogs_queue_trypush(queue, refill_imsi_bcd) == OGS_OK)
+            entry->refilling = true;
+        else
+            ogs_free(refill_imsi_bcd);
+    }
+
+    ogs_thread_mutex_unlock(&mutex);
+
+    return taken;
+}
+
+void hss_av_pool_advance(char *imsi_bcd, uint64_t sqn)
+{
+    hss_av_pool_entry_t *entry = NULL;
+
+    ogs_assert(imsi_bcd);
+
+    if (!queue)
+        return;
+
+    ogs_thread_mutex_lock(&mutex);
+
+    entry = entry_find(imsi_bcd);
+    if (entry) {
+        if (sqn > entry->floor)
+            entry->floor = sqn;
+        if (entry->num_of_av && entry_first_sqn(entry) < entry->floor)
+            entry_clear(entry);
+    }
+
+    ogs_thread_mutex_unlock(&mutex);
+}
+
+/* A refill that started before is not added */
+static void entry_invalidate(hss_av_pool_entry_t *entry)
+{
+    ogs_assert(entry);
+
+    entry_clear(entry);
+    entry->generation = next_generation++;
+    entry->floor = 0;
+    entry->no_pool = false;
+}
+
+void hss_av_pool_invalidate(char *imsi_bcd)
+{
+    hss_av_pool_entry_t *entry = NULL;
+
+    ogs_assert(imsi_bcd);
+
+    if (!queue)
+        return;
+
+    ogs_thread_mutex_lock(&mutex);
+
+    entry = entry_find(imsi_bcd);
+    if (entry)
+        entry_invalidate(entry);
+
+    ogs_thread_mutex_unlock(&mutex);
+}
+
+void hss_av_pool_invalidate_all(void)
+{
+    hss_av_pool_entry_t *entry = NULL;
+
+    if (!queue)
+        return;
+
+    ogs_thread_mutex_lock(&mutex);
+
+    ogs_list_for_each(&entry_list, entry)
+        entry_invalidate(entry);
+
+    ogs_thread_mutex_unlock(&mutex);
+}
+
+int hss_av_pool_count(char *imsi_bcd)
+{
+    hss_av_pool_entry_t *entry = NULL;
+    int num = 0;
+
+    ogs_assert(imsi_bcd);
+
+    if (!queue)
+        return 0;
+
+    ogs_thread_mutex_lock(&mutex);
+
+    entry = entry_find(imsi_bcd);
+    if (entry && ogs_get_monotonic_time() < entry->expires)
+        num = entry->num_of_av;
+
+    ogs_thread_mutex_unlock(&mutex);
+
+    return num;
+}
+
+/* Tracks the subscriber and returns what hss_av_pool_add() expects */
+uint64_t hss_av_pool_generation(char *imsi_bcd)
+{
+    hss_av_pool_entry_t *entry = NULL;
+    uint64_t generation;
+
+    ogs_assert(imsi_bcd);
+    ogs_assert(queue);
+
+    ogs_thread_mutex_lock(&mutex);
+
+    entry = entry_find(imsi_bcd);
+    if (!entry)
+        entry = entry_add(imsi_bcd);
+    generation = entry->generation;
+
+    ogs_thread_mutex_unlock(&mutex);
+
+    return generation;
+}
+
+/*
+ * Ends a refill started at 'generation'. The vectors are dropped if the
+ * subscriber changed since, or if a higher SQN was used in the meantime.
+ */
+void hss_av_pool_add(char *imsi_bcd, uint64_t generation,
+        bool no_pool, hss_av_t *av, int num)
+{
+    hss_av_pool_entry_t *entry = NULL;
+    int i, size;
+
+    ogs_assert(imsi_bcd);
+    ogs_assert(queue);
+
+    size = hss_self()->av_pool.size;
+
+    ogs_thread_mutex_lock(&mutex);
+
+    entry = entry_find(imsi_bcd);
+    if (entry) {
+        entry->refilling = false;
+
+        if (entry->generation == generation) {
+            entry->no_pool = no_pool;
+
+            if (entry->num_of_av && entry_first_sqn(entry) < entry->floor)
+                entry_clear(entry);
+
+            if (num > 0 && ogs_buffer_to_uint64(
+                        av[0].sqn, OGS_SQN_LEN) >= entry->floor &&
+                entry->num_of_av + num <= size) {
+                for (i = 0; i < num; i++) {
+                    memcpy(&entry->av[
+                            (entry->first + entry->num_of_av) % size],
+                            &av[i], sizeof(hss_av_t));
+                    entry->num_of_av++;
+                }
+                entry->expires = ogs_get_monotonic_time() +
+                    hss_self()->av_pool.lifetime;
+            }
+        }
+    }
+
+    ogs_thread_mutex_unlock(&mutex);
+}
+
+void hss_av_generate(const uint8_t *opc, const uint8_t *k,
+        const uint8_t *amf, uint64_t sqn, const uint8_t *rand,
+        hss_av_t *av, int num)
+{
+    milenage_batch_t vector[MILENAGE_BATCH_MAX];
+    int i, j, n;
+
+    ogs_assert(opc);
+    ogs_assert(k);
+    ogs_assert(amf);
+    ogs_assert(av);
+
+    for (i = 0; i < num; i++) {
+        if (i == 0 && rand)
+            memcpy(av[i].rand, rand, OGS_RAND_LEN);
+        else
+            ogs_random(av[i].rand, OGS_RAND_LEN);
+        ogs_uint64_to_buffer((sqn + 32 * i) & OGS_MAX_SQN,
+                OGS_SQN_LEN, av[i].sqn);
+    }
+
+    for (i = 0; i < num; i += n) {
+        n = ogs_min(num - i, MILENAGE_BATCH_MAX);
+
+        memset(vector, 0, sizeof(vector));
+        for (j = 0; j < n; j++) {
+            vector[j].opc = opc;
+            vector[j].k = k;
+            vector[j].amf = amf;
+            vector[j].sqn = av[i+j].sqn;
+            vector[j].rand = av[i+j].rand;
+        }
+        milenage_generate_batch(vector, n);
+
+        for (j = 0; j < n; j++) {
+            hss_av_t *v = &av[i+j];
+
+            memcpy(v->xres, vector[j].res, vector[j].res_len);
+            v->xres_len = vector[j].res_len;
+            memcpy(v->autn, vector[j].autn, OGS_AUTN_LEN);
+            memcpy(v->ck, vector[j].ck, OGS_KEY_LEN);
+            memcpy(v->ik, vector[j].ik, OGS_KEY_LEN);
+            memcpy(v->ak, vector[j].ak, OGS_AK_LEN);
+        }
+    }
+}
+
+static void refill(char *imsi_bcd)
+{
+    hss_av_pool_entry_t *entry = NULL;
+    hss_av_t *av = NULL;
+    ogs_dbi_auth_info_t auth_info;
+    uint8_t opc[OGS_KEY_LEN];
+    uint8_t zero[OGS_RAND_LEN];
+    uint64_t generation;
+    int rv, size, count;
+    bool no_pool = false;
+
+    ogs_assert(imsi_bcd);
+
+    size = hss_self()->av_pool.size;
+
+    ogs_thread_mutex_lock(&mutex);
+    entry = entry_find(imsi_bcd);
+    if (!entry) {
+        ogs_thread_mutex_unlock(&mutex);
+        return;
+    }
+    generation = entry->generation;
+    count = size - entry->num_of_av;
+    ogs_thread_mutex_unlock(&mutex);
+
+    if (count > 0) {
+        rv = hss_db_reserve_sqn(imsi_bcd, count, &auth_info);
+        if (rv != OGS_OK) {
+            ogs_error("[%s] Cannot reserve SQN", imsi_bcd);
+            count = 0;
+        }
+    }
+
+    if (count > 0) {
+        memset(zero, 0, sizeof(zero));
+        if (memcmp(auth_info.rand, zero, OGS_RAND_LEN) != 0) {
+            /* Each AIR must start with the provisioned RAND */
+            no_pool = true;
+            count = 0;
+        }
+    }
+
+    if (count > 0) {
+        if (auth_info.use_opc)
+            memcpy(opc, auth_info.opc, sizeof(opc));
+        else
+            milenage_opc(auth_info.k, auth_info.op, opc);
+
+        av = ogs_calloc(count, sizeof(hss_av_t));
+        ogs_assert(av);
+        hss_av_generate(opc, auth_info.k, auth_info.amf,
+                auth_info.sqn, NULL, av, count);
+    }
+
+    hss_av_pool_add(imsi_bcd, generation, no_pool, av, count);
+
+    if (av)
+        ogs_free(av);
+}
+
+static void refill_main(void *data)
+{
+    int rv;
+
+    for ( ;; ) {
+        char *imsi_bcd = NULL;
+
+        rv = ogs_queue_pop(queue, (void **)&imsi_bcd);
+        if (rv == OGS_DONE)
+            break;
+        if (rv != OGS_OK)
+            continue;
+
+        ogs_assert(imsi_bcd);
+        refill(imsi_bcd);
+        ogs_free(imsi_bcd);
+    }
+}
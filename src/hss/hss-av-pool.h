@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef HSS_AV_POOL_H
+#define HSS_AV_POOL_H
+
+#include "hss-context.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* E-UTRAN vector without KASME, which depends on the visited PLMN */
+typedef struct hss_av_s {
+    uint8_t rand[OGS_RAND_LEN];
+    uint8_t sqn[OGS_SQN_LEN];
+    uint8_t xres[OGS_MAX_RES_LEN];
+    uint8_t xres_len;
+    uint8_t autn[OGS_AUTN_LEN];
+    uint8_t ck[OGS_KEY_LEN];
+    uint8_t ik[OGS_KEY_LEN];
+    uint8_t ak[OGS_AK_LEN];
+} hss_av_t;
+
+int hss_av_pool_open(void);
+void hss_av_pool_close(void);
+
+int hss_av_pool_take(char *imsi_bcd, hss_av_t *av, int num);
+void hss_av_pool_advance(char *imsi_bcd, uint64_t sqn);
+void hss_av_pool_invalidate(char *imsi_bcd);
+void hss_av_pool_invalidate_all(void);
+int hss_av_pool_count(char *imsi_bcd);
+
+uint64_t hss_av_pool_generation(char *imsi_bcd);
+void hss_av_pool_add(char *imsi_bcd, uint64_t generation,
+        bool no_pool, hss_av_t *av, int num);
+
+void hss_av_generate(const uint8_t *opc, const uint8_t *k,
+        const uint8_t *amf, uint64_t sqn, const uint8_t *rand,
+        hss_av_t *av, int num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSS_AV_POOL_H */
@@ -21,6 +21,7 @@
 #include "hss-context.h"
 #include "hss-event.h"
 #include "hss-s6a-path.h"
+#include "hss-av-pool.h"
 
 
 typedef struct hss_impi_s hss_impi_t;
@@ -110,7 +111,6 @@ void hss_context_init(void)
     self.impu_hash = ogs_hash_make();
     ogs_assert(self.impu_hash);
 
-    ogs_thread_mutex_init(&self.db_lock);
     ogs_thread_mutex_init(&self.cx_lock);
 
     context_initialized = 1;
@@ -134,7 +134,6 @@ void hss_context_final(void)
     ogs_pool_final(&impi_pool);
     ogs_pool_final(&impu_pool);
 
-    ogs_thread_mutex_destroy(&self.db_lock);
     ogs_thread_mutex_destroy(&self.cx_lock);
 
     context_initialized = 0;
@@ -145,6 +144,9 @@ static int hss_context_prepare(void)
     self.diam_config->cnf_port = DIAMETER_PORT;
     self.diam_config->cnf_port_tls = DIAMETER_SECURE_PORT;
 
+    self.av_pool.subscriber = ogs_app()->max.ue;
+    self.av_pool.lifetime = ogs_time_from_sec(300);
+
     return OGS_OK;
 }
 
@@ -158,6 +160,16 @@ static int hss_context_validation(void)
         return OGS_ERROR;
     }
 
+#define HSS_AV_POOL_MAX_SIZE 32
+    if (self.av_pool.size < 0 || self.av_pool.size > HSS_AV_POOL_MAX_SIZE) {
+        ogs_error("Invalid av_pool.size [%d]", self.av_pool.size);
+        return OGS_ERROR;
+    }
+    if (self.av_pool.subscriber <= 0) {
+        ogs_error("Invalid av_pool.subscriber [%d]", self.av_pool.subscriber);
+        return OGS_ERROR;
+    }
+
     return OGS_OK;
 }
 
@@ -329,6 +341,26 @@ int hss_context_parse_config(void)
                 } else if (!strcmp(hss_key, "sms_over_ims")) {
                             self.sms_over_ims = 
                                 ogs_yaml_iter_value(&hss_iter);
+                } else if (!strcmp(hss_key, "av_pool")) {
+                    ogs_yaml_iter_t av_pool_iter;
+                    ogs_yaml_iter_recurse(&hss_iter, &av_pool_iter);
+                    while (ogs_yaml_iter_next(&av_pool_iter)) {
+                        const char *av_pool_key =
+                            ogs_yaml_iter_key(&av_pool_iter);
+                        ogs_assert(av_pool_key);
+                        if (!strcmp(av_pool_key, "size")) {
+                            const char *v = ogs_yaml_iter_value(&av_pool_iter);
+                            if (v) self.av_pool.size = atoi(v);
+                        } else if (!strcmp(av_pool_key, "subscriber")) {
+                            const char *v = ogs_yaml_iter_value(&av_pool_iter);
+                            if (v) self.av_pool.subscriber = atoi(v);
+                        } else if (!strcmp(av_pool_key, "lifetime")) {
+                            const char *v = ogs_yaml_iter_value(&av_pool_iter);
+                            if (v) self.av_pool.lifetime =
+                                ogs_time_from_sec(atoi(v));
+                        } else
+                            ogs_warn("unknown key `%s`", av_pool_key);
+                    }
                 } else
                     ogs_warn("unknown key `%s`", hss_key);
             }
@@ -349,14 +381,12 @@ int hss_db_auth_info(char *imsi_bcd, ogs_dbi_auth_info_t *auth_info)
     ogs_assert(imsi_bcd);
     ogs_assert(auth_info);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
     rv = ogs_dbi_auth_info(supi, auth_info);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
 
     return rv;
 }
@@ -368,14 +398,12 @@ int hss_db_update_sqn(char *imsi_bcd, uint8_t *rand, uint64_t sqn)
 
     ogs_assert(imsi_bcd);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
     rv = ogs_dbi_update_sqn(supi, sqn);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
 
     return rv;
 }
@@ -387,14 +415,12 @@ int hss_db_update_imeisv(char *imsi_bcd, char *imeisv)
 
     ogs_assert(imsi_bcd);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
     rv = ogs_dbi_update_imeisv(supi, imeisv);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
 
     return rv;
 }
@@ -407,14 +433,12 @@ int hss_db_update_mme(char *imsi_bcd, char *mme_host, char *mme_realm,
 
     ogs_assert(imsi_bcd);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
     rv = ogs_dbi_update_mme(supi, mme_host, mme_realm, purge_flag);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
 
     return rv;
 }
@@ -426,14 +450,31 @@ int hss_db_increment_sqn(char *imsi_bcd)
 
     ogs_assert(imsi_bcd);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
     rv = ogs_dbi_increment_sqn(supi);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
+
+    return rv;
+}
+
+int hss_db_reserve_sqn(
+        char *imsi_bcd, int count, ogs_dbi_auth_info_t *auth_info)
+{
+    int rv;
+    char *supi = NULL;
+
+    ogs_assert(imsi_bcd);
+    ogs_assert(auth_info);
+
+    supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
+    ogs_assert(supi);
+
+    rv = ogs_dbi_reserve_sqn(supi, count, auth_info);
+
+    ogs_free(supi);
 
     return rv;
 }
@@ -447,14 +488,12 @@ int hss_db_subscription_data(
     ogs_assert(imsi_bcd);
     ogs_assert(subscription_data);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
     rv = ogs_dbi_subscription_data(supi, subscription_data);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
 
     return rv;
 }
@@ -466,12 +505,8 @@ int hss_db_msisdn_data(char *imsi_or_msisdn_bcd, ogs_msisdn_data_t *msisdn_data)
     ogs_assert(imsi_or_msisdn_bcd);
     ogs_assert(msisdn_data);
 
-    ogs_thread_mutex_lock(&self.db_lock);
-
     rv = ogs_dbi_msisdn_data(imsi_or_msisdn_bcd, msisdn_data);
 
-    ogs_thread_mutex_unlock(&self.db_lock);
-
     return rv;
 }
 
@@ -483,14 +518,12 @@ int hss_db_ims_data(char *imsi_bcd, ogs_ims_data_t *ims_data)
     ogs_assert(imsi_bcd);
     ogs_assert(ims_data);
 
-    ogs_thread_mutex_lock(&self.db_lock);
     supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
     ogs_assert(supi);
 
     rv = ogs_dbi_ims_data(supi, ims_data);
 
     ogs_free(supi);
-    ogs_thread_mutex_unlock(&self.db_lock);
 
     return rv;
 }
@@ -1179,12 +1212,8 @@ int hss_db_poll_change_stream(void)
 {
     int rv;
 
-    ogs_thread_mutex_lock(&self.db_lock);
-
     rv = ogs_dbi_poll_change_stream();
 
-    ogs_thread_mutex_unlock(&self.db_lock);
-
     return rv;
 }
 
@@ -1197,9 +1226,10 @@ int hss_handle_change_event(const bson_t *document)
 
     bool send_clr_flag = false;
     bool send_idr_flag = false;
+    bool security_flag = false;
     uint32_t subdatamask = 0;
 
-    char *imsi_bcd;
+    char *imsi_bcd = NULL;
 
 #if BSON_MAJOR_VERSION >= 1 && BSON_MINOR_VERSION >= 7
     char *as_json = bson_as_relaxed_extended_json(document, NULL);
@@ -1208,10 +1238,8 @@ int hss_handle_change_event(const bson_t *document)
 # else
     ogs_debug("Received change stream document.");
 #endif
-    if (!bson_iter_init_find(&iter, document, "fullDocument")) {
-        ogs_error("No 'imsi' field in this document.");
-        return OGS_ERROR;
-    } else {
+    if (bson_iter_init_find(&iter, document, "fullDocument") &&
+            BSON_ITER_HOLDS_DOCUMENT(&iter)) {
         bson_iter_recurse(&iter, &child1_iter);
         while (bson_iter_next(&child1_iter)) {
             const char *key = bson_iter_key(&child1_iter);
@@ -1226,8 +1254,10 @@ int hss_handle_change_event(const bson_t *document)
     }
 
     if (!imsi_bcd) {
-        ogs_error("No 'imsi' field in this document.");
-        return OGS_ERROR;
+        /* A delete names the document only, drop every pooled vector */
+        ogs_warn("No 'imsi' field in this document, drop all vectors");
+        hss_av_pool_invalidate_all();
+        return OGS_OK;
     }
 
     if (bson_iter_init_find(&iter, document, "updateDescription")) {
@@ -1239,6 +1269,12 @@ int hss_handle_change_event(const bson_t *document)
                 bson_iter_recurse(&child1_iter, &child2_iter);
                 while (bson_iter_next(&child2_iter)) {
                     const char *child2_key = bson_iter_key(&child2_iter);
+                    /* The HSS itself keeps advancing security.sqn */
+                    if (!strncmp(child2_key, "security", strlen("security")) &&
+                            strcmp(child2_key, "security.sqn")) {
+                        security_flag = true;
+                    }
+
                     if (!strcmp(child2_key, 
                             "request_cancel_location") && 
                             BSON_ITER_HOLDS_BOOL(&child2_iter)) {
@@ -1279,8 +1315,12 @@ int hss_handle_change_event(const bson_t *document)
         }
     } else {
         ogs_debug("No 'updateDescription' field in this document");
+        security_flag = true;
     }
 
+    if (security_flag)
+        hss_av_pool_invalidate(imsi_bcd);
+
     if (send_clr_flag) {
         ogs_info("[%s] Cancel Location Requested", imsi_bcd);
         hss_s6a_send_clr(imsi_bcd, NULL, NULL,
@@ -40,7 +40,12 @@ typedef struct _hss_context_t {
     ogs_diam_config_t   *diam_config;   /* HSS Diameter config */
     const char          *sms_over_ims;  /* SMS over IMS */
 
-    ogs_thread_mutex_t  db_lock;
+    struct {
+        int size;                       /* Vectors per subscriber */
+        int subscriber;                 /* Recently active subscribers */
+        ogs_time_t lifetime;            /* Drop unused vectors after */
+    } av_pool;
+
     ogs_thread_mutex_t  cx_lock;
 
     /* S6A Interface */
@@ -62,6 +67,8 @@ int hss_context_parse_config(void);
 int hss_db_auth_info(char *imsi_bcd, ogs_dbi_auth_info_t *auth_info);
 int hss_db_update_sqn(char *imsi_bcd, uint8_t *rand, uint64_t sqn);
 int hss_db_increment_sqn(char *imsi_bcd);
+int hss_db_reserve_sqn(
+        char *imsi_bcd, int count, ogs_dbi_auth_info_t *auth_info);
 int hss_db_update_imeisv(char *imsi_bcd, char *imeisv);
 int hss_db_update_mme(char *imsi_bcd, char *mme_host, char *mme_realm,
     bool purge_flag);
@@ -392,20 +392,15 @@ static int hss_ogs_diam_cx_mar_cb( struct msg **msg, struct avp *avp,
         }
     }
 
-    rv = hss_db_update_sqn(imsi_bcd, auth_info.rand, auth_info.sqn);
+    /* Store SQN and advance it past this vector in a single update */
+    rv = hss_db_update_sqn(imsi_bcd, auth_info.rand,
+            (auth_info.sqn + 32) & OGS_MAX_SQN);
     if (rv != OGS_OK) {
         ogs_error("Cannot update rand and sqn for IMSI:'%s'", imsi_bcd);
         result_code = OGS_DIAM_CX_ERROR_IN_ASSIGNMENT_TYPE;
         goto out;
     }
 
-    rv = hss_db_increment_sqn(imsi_bcd);
-    if (rv != OGS_OK) {
-        ogs_error("Cannot increment sqn for IMSI:'%s'", imsi_bcd);
-        result_code = OGS_DIAM_CX_ERROR_IN_ASSIGNMENT_TYPE;
-        goto out;
-    }
-
     milenage_generate(opc, auth_info.amf, auth_info.k,
         ogs_uint64_to_buffer(auth_info.sqn, OGS_SQN_LEN, sqn), auth_info.rand,
         autn, ik, ck, ak, xres, &xres_len);
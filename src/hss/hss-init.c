@@ -20,6 +20,7 @@
 #include "hss-context.h"
 #include "hss-fd-path.h"
 #include "hss-sm.h"
+#include "hss-av-pool.h"
 
 
 static ogs_thread_t *thread;
@@ -43,6 +44,9 @@ int hss_initialize(void)
     rv = ogs_dbi_init(ogs_app()->db_uri);
     if (rv != OGS_OK) return rv;
 
+    rv = hss_av_pool_open();
+    if (rv != OGS_OK) return rv;
+
     rv = hss_fd_init();
     if (rv != OGS_OK) return OGS_ERROR;
 
@@ -63,6 +67,8 @@ void hss_terminate(void)
 
     hss_fd_final();
 
+    hss_av_pool_close();
+
     ogs_dbi_final();
     hss_context_final();
 
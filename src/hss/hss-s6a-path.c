@@ -22,6 +22,7 @@
 #include "hss-context.h"
 #include "hss-fd-path.h"
 #include "hss-s6a-path.h"
+#include "hss-av-pool.h"
 
 /* handler for fallback cb */
 static struct disp_hdl *hdl_s6a_fb = NULL;
@@ -77,15 +78,16 @@ static int hss_ogs_diam_s6a_air_cb( struct msg **msg, struct avp *avp,
     char imsi_bcd[OGS_MAX_IMSI_BCD_LEN+1];
     uint8_t opc[OGS_KEY_LEN];
     uint8_t sqn[OGS_SQN_LEN];
-    uint8_t autn[OGS_AUTN_LEN];
-    uint8_t ik[OGS_KEY_LEN];
-    uint8_t ck[OGS_KEY_LEN];
-    uint8_t ak[OGS_AK_LEN];
-    uint8_t xres[OGS_MAX_RES_LEN];
     uint8_t kasme[OGS_SHA256_DIGEST_SIZE];
-    size_t xres_len = 8;
+
+    /* TS29.272 7.3.11 : at most 5 E-UTRAN vectors per request */
+#define MAX_NUM_OF_REQUESTED_VECTORS 5
+    hss_av_t av[MAX_NUM_OF_REQUESTED_VECTORS];
+    uint32_t num_of_vectors = 1;
+    int i;
 
     uint8_t mac_s[OGS_MAC_S_LEN];
+    struct avp *avp_resync = NULL;
 
     ogs_dbi_auth_info_t auth_info;
     uint8_t zero[OGS_RAND_LEN];
@@ -111,69 +113,22 @@ static int hss_ogs_diam_s6a_air_cb( struct msg **msg, struct avp *avp,
     ogs_cpystrn(imsi_bcd, (char*)hdr->avp_value->os.data,
         ogs_min(hdr->avp_value->os.len, OGS_MAX_IMSI_BCD_LEN)+1);
 
-    rv = hss_db_auth_info(imsi_bcd, &auth_info);
-    if (rv != OGS_OK) {
-        result_code = OGS_DIAM_S6A_ERROR_USER_UNKNOWN;
-        goto out;
-    }
-
-    memset(zero, 0, sizeof(zero));
-    if (memcmp(auth_info.rand, zero, OGS_RAND_LEN) == 0) {
-        ogs_random(auth_info.rand, OGS_RAND_LEN);
-    }
-
-    if (auth_info.use_opc)
-        memcpy(opc, auth_info.opc, sizeof(opc));
-    else
-        milenage_opc(auth_info.k, auth_info.op, opc);
-
     ret = fd_msg_search_avp(qry, ogs_diam_s6a_req_eutran_auth_info, &avp);
     ogs_assert(ret == 0);
     if (avp) {
         ret = fd_avp_search_avp(
-                avp, ogs_diam_s6a_re_synchronization_info, &avpch);
+                avp, ogs_diam_s6a_number_of_requested_vectors, &avpch);
         ogs_assert(ret == 0);
         if (avpch) {
             ret = fd_msg_avp_hdr(avpch, &hdr);
             ogs_assert(ret == 0);
-            ogs_auc_sqn(opc, auth_info.k,
-                    hdr->avp_value->os.data,
-                    hdr->avp_value->os.data + OGS_RAND_LEN,
-                    sqn, mac_s);
-            if (memcmp(mac_s, hdr->avp_value->os.data +
-                        OGS_RAND_LEN + OGS_SQN_LEN, OGS_MAC_S_LEN) == 0) {
-                ogs_random(auth_info.rand, OGS_RAND_LEN);
-                auth_info.sqn = ogs_buffer_to_uint64(sqn, OGS_SQN_LEN);
-                /* 33.102 C.3.4 Guide : IND + 1 */
-                auth_info.sqn = (auth_info.sqn + 32 + 1) & OGS_MAX_SQN;
-            } else {
-                ogs_error("Re-synch MAC failed for IMSI:`%s`", imsi_bcd);
-                ogs_log_print(OGS_LOG_ERROR, "MAC_S: ");
-                ogs_log_hexdump(OGS_LOG_ERROR, mac_s, OGS_MAC_S_LEN);
-                ogs_log_hexdump(OGS_LOG_ERROR,
-                    (void*)(hdr->avp_value->os.data +
-                        OGS_RAND_LEN + OGS_SQN_LEN),
-                    OGS_MAC_S_LEN);
-                ogs_log_print(OGS_LOG_ERROR, "SQN: ");
-                ogs_log_hexdump(OGS_LOG_ERROR, sqn, OGS_SQN_LEN);
-                result_code = OGS_DIAM_S6A_AUTHENTICATION_DATA_UNAVAILABLE;
-                goto out;
-            }
+            num_of_vectors = ogs_max(1, ogs_min(hdr->avp_value->u32,
+                        MAX_NUM_OF_REQUESTED_VECTORS));
         }
-    }
-
-    rv = hss_db_update_sqn(imsi_bcd, auth_info.rand, auth_info.sqn);
-    if (rv != OGS_OK) {
-        ogs_error("Cannot update rand and sqn for IMSI:'%s'", imsi_bcd);
-        result_code = OGS_DIAM_S6A_AUTHENTICATION_DATA_UNAVAILABLE;
-        goto out;
-    }
 
-    rv = hss_db_increment_sqn(imsi_bcd);
-    if (rv != OGS_OK) {
-        ogs_error("Cannot increment sqn for IMSI:'%s'", imsi_bcd);
-        result_code = OGS_DIAM_S6A_AUTHENTICATION_DATA_UNAVAILABLE;
-        goto out;
+        ret = fd_avp_search_avp(
+                avp, ogs_diam_s6a_re_synchronization_info, &avp_resync);
+        ogs_assert(ret == 0);
     }
 
     ret = fd_msg_search_avp(qry, ogs_diam_visited_plmn_id, &avp);
@@ -182,55 +137,133 @@ static int hss_ogs_diam_s6a_air_cb( struct msg **msg, struct avp *avp,
     ogs_assert(ret == 0);
     memcpy(&visited_plmn_id, hdr->avp_value->os.data, hdr->avp_value->os.len);
 
-    milenage_generate(opc, auth_info.amf, auth_info.k,
-        ogs_uint64_to_buffer(auth_info.sqn, OGS_SQN_LEN, sqn), auth_info.rand,
-        autn, ik, ck, ak, xres, &xres_len);
-    ogs_auc_kasme(ck, ik, hdr->avp_value->os.data, sqn, ak, kasme);
+    /* Answer from the pool when enough vectors are ready */
+    if (!avp_resync &&
+        hss_av_pool_take(imsi_bcd, av, num_of_vectors) == num_of_vectors)
+        goto answer;
+
+    rv = hss_db_auth_info(imsi_bcd, &auth_info);
+    if (rv != OGS_OK) {
+        result_code = OGS_DIAM_S6A_ERROR_USER_UNKNOWN;
+        goto out;
+    }
+
+    if (avp_resync) {
+        if (auth_info.use_opc)
+            memcpy(opc, auth_info.opc, sizeof(opc));
+        else
+            milenage_opc(auth_info.k, auth_info.op, opc);
+
+        ret = fd_msg_avp_hdr(avp_resync, &hdr);
+        ogs_assert(ret == 0);
+        ogs_auc_sqn(opc, auth_info.k,
+                hdr->avp_value->os.data,
+                hdr->avp_value->os.data + OGS_RAND_LEN,
+                sqn, mac_s);
+        if (memcmp(mac_s, hdr->avp_value->os.data +
+                    OGS_RAND_LEN + OGS_SQN_LEN, OGS_MAC_S_LEN) == 0) {
+            ogs_random(auth_info.rand, OGS_RAND_LEN);
+            auth_info.sqn = ogs_buffer_to_uint64(sqn, OGS_SQN_LEN);
+            /* 33.102 C.3.4 Guide : IND + 1 */
+            auth_info.sqn = (auth_info.sqn + 32 + 1) & OGS_MAX_SQN;
+        } else {
+            ogs_error("Re-synch MAC failed for IMSI:`%s`", imsi_bcd);
+            ogs_log_print(OGS_LOG_ERROR, "MAC_S: ");
+            ogs_log_hexdump(OGS_LOG_ERROR, mac_s, OGS_MAC_S_LEN);
+            ogs_log_hexdump(OGS_LOG_ERROR,
+                (void*)(hdr->avp_value->os.data +
+                    OGS_RAND_LEN + OGS_SQN_LEN),
+                OGS_MAC_S_LEN);
+            ogs_log_print(OGS_LOG_ERROR, "SQN: ");
+            ogs_log_hexdump(OGS_LOG_ERROR, sqn, OGS_SQN_LEN);
+            result_code = OGS_DIAM_S6A_AUTHENTICATION_DATA_UNAVAILABLE;
+            goto out;
+        }
+
+        /* Every vector uses its own SQN, so SQN is advanced once per vector */
+        rv = hss_db_update_sqn(imsi_bcd, auth_info.rand,
+                (auth_info.sqn + 32 * num_of_vectors) & OGS_MAX_SQN);
+        if (rv != OGS_OK) {
+            ogs_error("Cannot update rand and sqn for IMSI:'%s'", imsi_bcd);
+            result_code = OGS_DIAM_S6A_AUTHENTICATION_DATA_UNAVAILABLE;
+            goto out;
+        }
+    } else {
+        /* Read SQN again and advance it in one step, racing the pool */
+        rv = hss_db_reserve_sqn(imsi_bcd, num_of_vectors, &auth_info);
+        if (rv != OGS_OK) {
+            ogs_error("Cannot update rand and sqn for IMSI:'%s'", imsi_bcd);
+            result_code = OGS_DIAM_S6A_AUTHENTICATION_DATA_UNAVAILABLE;
+            goto out;
+        }
+
+        if (auth_info.use_opc)
+            memcpy(opc, auth_info.opc, sizeof(opc));
+        else
+            milenage_opc(auth_info.k, auth_info.op, opc);
+    }
+
+    /* The UE would reject pooled vectors below these SQNs */
+    hss_av_pool_advance(imsi_bcd,
+            auth_info.sqn + 32 * (uint64_t)num_of_vectors);
 
+    memset(zero, 0, sizeof(zero));
+    hss_av_generate(opc, auth_info.k, auth_info.amf, auth_info.sqn,
+            memcmp(auth_info.rand, zero, OGS_RAND_LEN) ? auth_info.rand : NULL,
+            av, num_of_vectors);
+
+answer:
     /* Set the Authentication-Info */
     ret = fd_msg_avp_new(ogs_diam_s6a_authentication_info, 0, &avp);
     ogs_assert(ret == 0);
-    ret = fd_msg_avp_new(ogs_diam_s6a_e_utran_vector, 0, &avp_e_utran_vector);
-    ogs_assert(ret == 0);
 
-    ret = fd_msg_avp_new(ogs_diam_s6a_rand, 0, &avp_rand);
-    ogs_assert(ret == 0);
-    val.os.data = auth_info.rand;
-    val.os.len = OGS_KEY_LEN;
-    ret = fd_msg_avp_setvalue(avp_rand, &val);
-    ogs_assert(ret == 0);
-    ret = fd_msg_avp_add(avp_e_utran_vector, MSG_BRW_LAST_CHILD, avp_rand);
-    ogs_assert(ret == 0);
+    for (i = 0; i < num_of_vectors; i++) {
+        ogs_auc_kasme(av[i].ck, av[i].ik,
+                (uint8_t *)&visited_plmn_id, av[i].sqn, av[i].ak, kasme);
 
-    ret = fd_msg_avp_new(ogs_diam_s6a_xres, 0, &avp_xres);
-    ogs_assert(ret == 0);
-    val.os.data = xres;
-    val.os.len = xres_len;
-    ret = fd_msg_avp_setvalue(avp_xres, &val);
-    ogs_assert(ret == 0);
-    ret = fd_msg_avp_add(avp_e_utran_vector, MSG_BRW_LAST_CHILD, avp_xres);
-    ogs_assert(ret == 0);
+        ret = fd_msg_avp_new(
+                ogs_diam_s6a_e_utran_vector, 0, &avp_e_utran_vector);
+        ogs_assert(ret == 0);
 
-    ret = fd_msg_avp_new(ogs_diam_s6a_autn, 0, &avp_autn);
-    ogs_assert(ret == 0);
-    val.os.data = autn;
-    val.os.len = OGS_AUTN_LEN;
-    ret = fd_msg_avp_setvalue(avp_autn, &val);
-    ogs_assert(ret == 0);
-    ret = fd_msg_avp_add(avp_e_utran_vector, MSG_BRW_LAST_CHILD, avp_autn);
-    ogs_assert(ret == 0);
+        ret = fd_msg_avp_new(ogs_diam_s6a_rand, 0, &avp_rand);
+        ogs_assert(ret == 0);
+        val.os.data = av[i].rand;
+        val.os.len = OGS_KEY_LEN;
+        ret = fd_msg_avp_setvalue(avp_rand, &val);
+        ogs_assert(ret == 0);
+        ret = fd_msg_avp_add(avp_e_utran_vector, MSG_BRW_LAST_CHILD, avp_rand);
+        ogs_assert(ret == 0);
 
-    ret = fd_msg_avp_new(ogs_diam_s6a_kasme, 0, &avp_kasme);
-    ogs_assert(ret == 0);
-    val.os.data = kasme;
-    val.os.len = OGS_SHA256_DIGEST_SIZE;
-    ret = fd_msg_avp_setvalue(avp_kasme, &val);
-    ogs_assert(ret == 0);
-    ret = fd_msg_avp_add(avp_e_utran_vector, MSG_BRW_LAST_CHILD, avp_kasme);
-    ogs_assert(ret == 0);
+        ret = fd_msg_avp_new(ogs_diam_s6a_xres, 0, &avp_xres);
+        ogs_assert(ret == 0);
+        val.os.data = av[i].xres;
+        val.os.len = av[i].xres_len;
+        ret = fd_msg_avp_setvalue(avp_xres, &val);
+        ogs_assert(ret == 0);
+        ret = fd_msg_avp_add(avp_e_utran_vector, MSG_BRW_LAST_CHILD, avp_xres);
+        ogs_assert(ret == 0);
 
-    ret = fd_msg_avp_add(avp, MSG_BRW_LAST_CHILD, avp_e_utran_vector);
-    ogs_assert(ret == 0);
+        ret = fd_msg_avp_new(ogs_diam_s6a_autn, 0, &avp_autn);
+        ogs_assert(ret == 0);
+        val.os.data = av[i].autn;
+        val.os.len = OGS_AUTN_LEN;
+        ret = fd_msg_avp_setvalue(avp_autn, &val);
+        ogs_assert(ret == 0);
+        ret = fd_msg_avp_add(avp_e_utran_vector, MSG_BRW_LAST_CHILD, avp_autn);
+        ogs_assert(ret == 0);
+
+        ret = fd_msg_avp_new(ogs_diam_s6a_kasme, 0, &avp_kasme);
+        ogs_assert(ret == 0);
+        val.os.data = kasme;
+        val.os.len = OGS_SHA256_DIGEST_SIZE;
+        ret = fd_msg_avp_setvalue(avp_kasme, &val);
+        ogs_assert(ret == 0);
+        ret = fd_msg_avp_add(avp_e_utran_vector, MSG_BRW_LAST_CHILD, avp_kasme);
+        ogs_assert(ret == 0);
+
+        ret = fd_msg_avp_add(avp, MSG_BRW_LAST_CHILD, avp_e_utran_vector);
+        ogs_assert(ret == 0);
+    }
     ret = fd_msg_avp_add(ans, MSG_BRW_LAST_CHILD, avp);
     ogs_assert(ret == 0);
 
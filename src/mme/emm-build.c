@@ -323,6 +323,8 @@ ogs_pkbuf_t *emm_build_authentication_reject(void)
 
 ogs_pkbuf_t *emm_build_security_mode_command(mme_ue_t *mme_ue)
 {
+    uint8_t knas_int[OGS_SHA256_DIGEST_SIZE/2];
+    uint8_t knas_enc[OGS_SHA256_DIGEST_SIZE/2];
     ogs_nas_eps_message_t message;
     ogs_nas_eps_security_mode_command_t *security_mode_command = 
         &message.emm.security_mode_command;
@@ -442,10 +444,15 @@ ogs_pkbuf_t *emm_build_security_mode_command(mme_ue_t *mme_ue)
         return NULL;
     }
 
-    ogs_kdf_nas_eps(OGS_KDF_NAS_INT_ALG, mme_ue->selected_int_algorithm,
-            mme_ue->kasme, mme_ue->knas_int);
-    ogs_kdf_nas_eps(OGS_KDF_NAS_ENC_ALG, mme_ue->selected_enc_algorithm,
-            mme_ue->kasme, mme_ue->knas_enc);
+    ogs_kdf_nas_eps_from_key(OGS_KDF_NAS_INT_ALG,
+            mme_ue->selected_int_algorithm,
+            &mme_ue->kasme_key, knas_int);
+    ogs_kdf_nas_eps_from_key(OGS_KDF_NAS_ENC_ALG,
+            mme_ue->selected_enc_algorithm,
+            &mme_ue->kasme_key, knas_enc);
+    ogs_nas_security_key_init(&mme_ue->nas_key,
+            mme_ue->selected_int_algorithm, knas_int,
+            mme_ue->selected_enc_algorithm, knas_enc);
 
     return nas_eps_security_encode(mme_ue, &message);
 }
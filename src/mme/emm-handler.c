@@ -113,8 +113,9 @@ int emm_handle_attach_request(mme_ue_t *mme_ue,
     CLEAR_EPS_BEARER_ID(mme_ue);
     CLEAR_SERVICE_INDICATOR(mme_ue);
     if (SECURITY_CONTEXT_IS_VALID(mme_ue)) {
-        ogs_kdf_kenb(mme_ue->kasme, mme_ue->ul_count.i32, mme_ue->kenb);
-        ogs_kdf_nh_enb(mme_ue->kasme, mme_ue->kenb, mme_ue->nh);
+        ogs_kdf_kenb_from_key(
+                &mme_ue->kasme_key, mme_ue->ul_count.i32, mme_ue->kenb);
+        ogs_kdf_nh_enb_from_key(&mme_ue->kasme_key, mme_ue->kenb, mme_ue->nh);
         mme_ue->nhcc = 1;
     }
 
@@ -508,8 +509,9 @@ int emm_handle_service_request(
     CLEAR_MME_UE_ALL_TIMERS(mme_ue);
 
     if (SECURITY_CONTEXT_IS_VALID(mme_ue)) {
-        ogs_kdf_kenb(mme_ue->kasme, mme_ue->ul_count.i32, mme_ue->kenb);
-        ogs_kdf_nh_enb(mme_ue->kasme, mme_ue->kenb, mme_ue->nh);
+        ogs_kdf_kenb_from_key(
+                &mme_ue->kasme_key, mme_ue->ul_count.i32, mme_ue->kenb);
+        ogs_kdf_nh_enb_from_key(&mme_ue->kasme_key, mme_ue->kenb, mme_ue->nh);
         mme_ue->nhcc = 1;
     }
 
@@ -542,9 +542,10 @@ static void common_register_state(ogs_fsm_t *s, mme_event_t *e,
      * UP data or pending downlink signalling, radio bearers will be established
      * as part of the TAU procedure and a KeNB derivation is necessary.
      */
-                    ogs_kdf_kenb(mme_ue->kasme, mme_ue->ul_count.i32,
-                            mme_ue->kenb);
-                    ogs_kdf_nh_enb(mme_ue->kasme, mme_ue->kenb, mme_ue->nh);
+                    ogs_kdf_kenb_from_key(&mme_ue->kasme_key,
+                            mme_ue->ul_count.i32, mme_ue->kenb);
+                    ogs_kdf_nh_enb_from_key(&mme_ue->kasme_key,
+                            mme_ue->kenb, mme_ue->nh);
                     mme_ue->nhcc = 1;
 
                     r = nas_eps_send_tau_accept(mme_ue,
@@ -1081,9 +1082,10 @@ void emm_state_security_mode(ogs_fsm_t *s, mme_event_t *e)
             emm_handle_security_mode_complete(
                     mme_ue, &message->emm.security_mode_complete);
 
-            ogs_kdf_kenb(mme_ue->kasme, mme_ue->ul_count.i32,
-                    mme_ue->kenb);
-            ogs_kdf_nh_enb(mme_ue->kasme, mme_ue->kenb, mme_ue->nh);
+            ogs_kdf_kenb_from_key(&mme_ue->kasme_key,
+                    mme_ue->ul_count.i32, mme_ue->kenb);
+            ogs_kdf_nh_enb_from_key(&mme_ue->kasme_key,
+                    mme_ue->kenb, mme_ue->nh);
             mme_ue->nhcc = 1;
 
             /* Create New GUTI */
@@ -27,6 +27,7 @@
 #include "s1ap-handler.h"
 #include "mme-sm.h"
 #include "mme-gtp-path.h"
+#include "s1ap-worker.h"
 
 #define MAX_CELL_PER_ENB            8
 
@@ -52,6 +53,9 @@ static OGS_POOL(mme_bearer_pool, mme_bearer_t);
 
 static OGS_POOL(m_tmsi_pool, mme_m_tmsi_t);
 
+static OGS_POOL(mme_tai_index_pool, mme_tai_index_t);
+static OGS_POOL(mme_tai_link_pool, mme_tai_link_t);
+
 static int context_initialized = 0;
 
 static int num_of_enb_ue = 0;
@@ -62,6 +66,8 @@ static void stats_remove_enb_ue(void);
 static void stats_add_mme_session(void);
 static void stats_remove_mme_session(void);
 
+static void enb_clear_tai_index(mme_enb_t *enb);
+
 static bool compare_ue_info(mme_sgw_t *node, enb_ue_t *enb_ue);
 static mme_sgw_t *selected_sgw_node(mme_sgw_t *current, enb_ue_t *enb_ue);
 static mme_sgw_t *changed_sgw_node(mme_sgw_t *current, enb_ue_t *enb_ue);
@@ -103,6 +109,10 @@ void mme_context_init(void)
     ogs_pool_init(&mme_enb_pool, ogs_app()->max.peer*2);
 
     ogs_pool_init(&mme_ue_pool, ogs_app()->max.ue);
+    ogs_info("MME-UE context: %d bytes pooled x %" PRIu64 ", "
+            "%d bytes of subscribed APNs per attached UE",
+            (int)sizeof(mme_ue_t), ogs_app()->max.ue,
+            (int)(OGS_MAX_NUM_OF_SESS * sizeof(ogs_session_t)));
     ogs_pool_init(&mme_s11_teid_pool, ogs_app()->max.ue);
     ogs_pool_random_id_generate(&mme_s11_teid_pool);
 
@@ -113,6 +123,11 @@ void mme_context_init(void)
     ogs_pool_init(&m_tmsi_pool, ogs_app()->max.ue*2);
     ogs_pool_random_id_generate(&m_tmsi_pool);
 
+    ogs_pool_init(&mme_tai_index_pool, ogs_app()->max.peer*2*
+            OGS_MAX_NUM_OF_TAI*OGS_MAX_NUM_OF_BPLMN);
+    ogs_pool_init(&mme_tai_link_pool, ogs_app()->max.peer*2*
+            OGS_MAX_NUM_OF_TAI*OGS_MAX_NUM_OF_BPLMN);
+
     self.enb_addr_hash = ogs_hash_make();
     ogs_assert(self.enb_addr_hash);
     self.enb_id_hash = ogs_hash_make();
@@ -121,6 +136,8 @@ void mme_context_init(void)
     ogs_assert(self.imsi_ue_hash);
     self.guti_ue_hash = ogs_hash_make();
     ogs_assert(self.guti_ue_hash);
+    self.tai_index_hash = ogs_hash_make();
+    ogs_assert(self.tai_index_hash);
     self.mme_s11_teid_hash = ogs_hash_make();
     ogs_assert(self.mme_s11_teid_hash);
 
@@ -150,9 +167,14 @@ void mme_context_final(void)
     ogs_hash_destroy(self.imsi_ue_hash);
     ogs_assert(self.guti_ue_hash);
     ogs_hash_destroy(self.guti_ue_hash);
+    ogs_assert(self.tai_index_hash);
+    ogs_hash_destroy(self.tai_index_hash);
     ogs_assert(self.mme_s11_teid_hash);
     ogs_hash_destroy(self.mme_s11_teid_hash);
 
+    ogs_pool_final(&mme_tai_link_pool);
+    ogs_pool_final(&mme_tai_index_pool);
+
     ogs_pool_final(&m_tmsi_pool);
     ogs_pool_final(&mme_bearer_pool);
     ogs_pool_final(&mme_sess_pool);
@@ -448,6 +470,9 @@ int mme_context_parse_config(void)
                 } else if (!strcmp(mme_key, "relative_capacity")) {
                     const char *v = ogs_yaml_iter_value(&mme_iter);
                     if (v) self.relative_capacity = atoi(v);
+                } else if (!strcmp(mme_key, "s1ap_io_thread")) {
+                    const char *v = ogs_yaml_iter_value(&mme_iter);
+                    if (v) self.s1ap_io_thread = atoi(v);
                 } else if (!strcmp(mme_key, "s1ap")) {
                     ogs_yaml_iter_t s1ap_array, s1ap_iter;
                     ogs_yaml_iter_recurse(&mme_iter, &s1ap_array);
@@ -2169,9 +2194,13 @@ mme_enb_t *mme_enb_add(ogs_sock_t *sock, ogs_sockaddr_t *addr)
     enb->sctp.type = mme_enb_sock_type(enb->sctp.sock);
 
     if (enb->sctp.type == SOCK_STREAM) {
-        enb->sctp.poll.read = ogs_pollset_add(ogs_app()->pollset,
-            OGS_POLLIN, sock->fd, s1ap_recv_upcall, sock);
-        ogs_assert(enb->sctp.poll.read);
+        if (ogs_sctp_worker_is_enabled()) {
+            ogs_sctp_worker_add(&enb->sctp);
+        } else {
+            enb->sctp.poll.read = ogs_pollset_add(ogs_app()->pollset,
+                OGS_POLLIN, sock->fd, s1ap_recv_upcall, sock);
+            ogs_assert(enb->sctp.poll.read);
+        }
 
         ogs_list_init(&enb->sctp.write_queue);
     }
@@ -2180,6 +2209,8 @@ mme_enb_t *mme_enb_add(ogs_sock_t *sock, ogs_sockaddr_t *addr)
     enb->ostream_id = 0;
 
     ogs_list_init(&enb->enb_ue_list);
+    enb->enb_ue_hash = ogs_hash_make();
+    ogs_assert(enb->enb_ue_hash);
 
     ogs_hash_set(self.enb_addr_hash,
             enb->sctp.addr, sizeof(ogs_sockaddr_t), enb);
@@ -2214,6 +2245,10 @@ int mme_enb_remove(mme_enb_t *enb)
             enb->sctp.addr, sizeof(ogs_sockaddr_t), NULL);
     ogs_hash_set(self.enb_id_hash, &enb->enb_id, sizeof(enb->enb_id), NULL);
 
+    ogs_hash_destroy(enb->enb_ue_hash);
+
+    enb_clear_tai_index(enb);
+
     /*
      * CHECK:
      *
@@ -2287,6 +2322,139 @@ mme_enb_t *mme_enb_cycle(mme_enb_t *enb)
     return ogs_pool_cycle(&mme_enb_pool, enb);
 }
 
+static void enb_clear_tai_index(mme_enb_t *enb)
+{
+    int i;
+
+    ogs_assert(enb);
+
+    for (i = 0; i < enb->num_of_tai_link; i++) {
+        mme_tai_link_t *link = enb->tai_link[i];
+        mme_tai_index_t *index = NULL;
+
+        ogs_assert(link);
+        index = link->index;
+        ogs_assert(index);
+
+        ogs_list_remove(&index->link_list, link);
+        ogs_pool_free(&mme_tai_link_pool, link);
+
+        if (ogs_list_first(&index->link_list) == NULL) {
+            ogs_hash_set(self.tai_index_hash,
+                    &index->tai, sizeof(index->tai), NULL);
+            ogs_pool_free(&mme_tai_index_pool, index);
+        }
+    }
+
+    enb->num_of_tai_link = 0;
+}
+
+static void enb_add_tai_index(mme_enb_t *enb, ogs_eps_tai_t *tai)
+{
+    mme_tai_index_t *index = NULL;
+    mme_tai_link_t *link = NULL;
+
+    ogs_assert(enb);
+    ogs_assert(tai);
+
+    index = mme_tai_index_find(tai);
+    if (index) {
+        /* The same TAI may be broadcast more than once */
+        ogs_list_for_each(&index->link_list, link)
+            if (link->enb == enb)
+                return;
+    } else {
+        ogs_pool_alloc(&mme_tai_index_pool, &index);
+        if (!index) {
+            ogs_error("Could not allocate tai_index from pool");
+            return;
+        }
+        memset(index, 0, sizeof *index);
+        memcpy(&index->tai, tai, sizeof(index->tai));
+        ogs_list_init(&index->link_list);
+
+        ogs_hash_set(self.tai_index_hash,
+                &index->tai, sizeof(index->tai), index);
+    }
+
+    ogs_pool_alloc(&mme_tai_link_pool, &link);
+    if (!link) {
+        ogs_error("Could not allocate tai_link from pool");
+        if (ogs_list_first(&index->link_list) == NULL) {
+            ogs_hash_set(self.tai_index_hash,
+                    &index->tai, sizeof(index->tai), NULL);
+            ogs_pool_free(&mme_tai_index_pool, index);
+        }
+        return;
+    }
+    memset(link, 0, sizeof *link);
+    link->index = index;
+    link->enb = enb;
+
+    ogs_list_add(&index->link_list, link);
+
+    ogs_assert(enb->num_of_tai_link < (int)OGS_ARRAY_SIZE(enb->tai_link));
+    enb->tai_link[enb->num_of_tai_link++] = link;
+}
+
+/*
+ * Rebuild the TAI index entries of this eNB from its SupportedTAs.
+ * Called whenever S1 Setup rewrites the list.
+ */
+void mme_enb_update_tai_index(mme_enb_t *enb)
+{
+    int i;
+
+    ogs_assert(enb);
+
+    enb_clear_tai_index(enb);
+
+    for (i = 0; i < enb->num_of_supported_ta_list; i++)
+        enb_add_tai_index(enb, &enb->supported_ta_list[i]);
+}
+
+mme_tai_index_t *mme_tai_index_find(ogs_eps_tai_t *tai)
+{
+    ogs_assert(tai);
+
+    return (mme_tai_index_t *)ogs_hash_get(
+            self.tai_index_hash, tai, sizeof(*tai));
+}
+
+/*
+ * ENB-UE-S1AP-ID is only unique within an eNB, so each eNB keeps its own
+ * hash. INVALID_UE_S1AP_ID is never hashed. If the eNB reuses an ID
+ * the newest enb_ue wins, and an entry is only cleared by its owner.
+ */
+static void enb_ue_hash_set(enb_ue_t *enb_ue)
+{
+    ogs_assert(enb_ue);
+    ogs_assert(enb_ue->enb);
+
+    if (enb_ue->enb_ue_s1ap_id == INVALID_UE_S1AP_ID)
+        return;
+
+    /* Drop a stale entry first: it is keyed on the old enb_ue's memory */
+    ogs_hash_set(enb_ue->enb->enb_ue_hash, &enb_ue->enb_ue_s1ap_id,
+            sizeof(enb_ue->enb_ue_s1ap_id), NULL);
+    ogs_hash_set(enb_ue->enb->enb_ue_hash, &enb_ue->enb_ue_s1ap_id,
+            sizeof(enb_ue->enb_ue_s1ap_id), enb_ue);
+}
+
+static void enb_ue_hash_clear(enb_ue_t *enb_ue)
+{
+    ogs_assert(enb_ue);
+    ogs_assert(enb_ue->enb);
+
+    if (enb_ue->enb_ue_s1ap_id == INVALID_UE_S1AP_ID)
+        return;
+
+    if (ogs_hash_get(enb_ue->enb->enb_ue_hash, &enb_ue->enb_ue_s1ap_id,
+                sizeof(enb_ue->enb_ue_s1ap_id)) == enb_ue)
+        ogs_hash_set(enb_ue->enb->enb_ue_hash, &enb_ue->enb_ue_s1ap_id,
+                sizeof(enb_ue->enb_ue_s1ap_id), NULL);
+}
+
 /** enb_ue_context handling function */
 enb_ue_t *enb_ue_add(mme_enb_t *enb, uint32_t enb_ue_s1ap_id)
 {
@@ -2329,6 +2497,7 @@ enb_ue_t *enb_ue_add(mme_enb_t *enb, uint32_t enb_ue_s1ap_id)
     enb_ue->enb = enb;
 
     ogs_list_add(&enb->enb_ue_list, enb_ue);
+    enb_ue_hash_set(enb_ue);
 
     stats_add_enb_ue();
 
@@ -2343,6 +2512,7 @@ void enb_ue_remove(enb_ue_t *enb_ue)
     enb = enb_ue->enb;
     ogs_assert(enb);
 
+    enb_ue_hash_clear(enb_ue);
     ogs_list_remove(&enb->enb_ue_list, enb_ue);
 
     ogs_assert(enb_ue->t_s1_holding);
@@ -2360,6 +2530,7 @@ void enb_ue_switch_to_enb(enb_ue_t *enb_ue, mme_enb_t *new_enb)
     ogs_assert(new_enb);
 
     /* Remove from the old enb */
+    enb_ue_hash_clear(enb_ue);
     ogs_list_remove(&enb_ue->enb->enb_ue_list, enb_ue);
 
     /* Add to the new enb */
@@ -2367,19 +2538,25 @@ void enb_ue_switch_to_enb(enb_ue_t *enb_ue, mme_enb_t *new_enb)
 
     /* Switch to enb */
     enb_ue->enb = new_enb;
+    enb_ue_hash_set(enb_ue);
+}
+
+void enb_ue_set_enb_ue_s1ap_id(enb_ue_t *enb_ue, uint32_t enb_ue_s1ap_id)
+{
+    ogs_assert(enb_ue);
+
+    enb_ue_hash_clear(enb_ue);
+    enb_ue->enb_ue_s1ap_id = enb_ue_s1ap_id;
+    enb_ue_hash_set(enb_ue);
 }
 
 enb_ue_t *enb_ue_find_by_enb_ue_s1ap_id(
         mme_enb_t *enb, uint32_t enb_ue_s1ap_id)
 {
-    enb_ue_t *enb_ue = NULL;
-
-    ogs_list_for_each(&enb->enb_ue_list, enb_ue) {
-        if (enb_ue_s1ap_id == enb_ue->enb_ue_s1ap_id)
-            break;
-    }
+    ogs_assert(enb);
 
-    return enb_ue;
+    return (enb_ue_t *)ogs_hash_get(enb->enb_ue_hash,
+            &enb_ue_s1ap_id, sizeof(enb_ue_s1ap_id));
 }
 
 enb_ue_t *enb_ue_find(uint32_t index)
@@ -2782,6 +2959,8 @@ void mme_ue_remove(mme_ue_t *mme_ue)
 
     mme_sess_remove_all(mme_ue);
     mme_session_remove_all(mme_ue);
+    if (mme_ue->session)
+        ogs_free(mme_ue->session);
 
     mme_ebi_pool_final(mme_ue);
 
@@ -3789,6 +3968,7 @@ void mme_session_remove_all(mme_ue_t *mme_ue)
 
     ogs_assert(mme_ue->num_of_session <= OGS_MAX_NUM_OF_SESS);
     for (i = 0; i < mme_ue->num_of_session; i++) {
+        ogs_assert(mme_ue->session);
         if (mme_ue->session[i].name)
             ogs_free(mme_ue->session[i].name);
     }
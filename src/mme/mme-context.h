@@ -142,6 +142,8 @@ typedef struct mme_context_s {
     /* S1SetupResponse */
     uint8_t         relative_capacity;
 
+    int             s1ap_io_thread; /* S1AP I/O threads, 0: MME thread */
+
     /* Generator for unique identification */
     uint32_t        mme_ue_s1ap_id;         /* mme_ue_s1ap_id generator */
 
@@ -151,6 +153,7 @@ typedef struct mme_context_s {
     ogs_hash_t *enb_id_hash;    /* hash table for ENB-ID */
     ogs_hash_t *imsi_ue_hash;   /* hash table (IMSI : MME_UE) */
     ogs_hash_t *guti_ue_hash;   /* hash table (GUTI : MME_UE) */
+    ogs_hash_t *tai_index_hash; /* hash table (TAI : mme_tai_index_t) */
 
     ogs_hash_t *mme_s11_teid_hash;  /* hash table (MME-S11-TEID : MME_UE) */
 
@@ -218,6 +221,9 @@ typedef struct mme_csmap_s {
     mme_vlr_t       *vlr;
 } mme_csmap_t;
 
+typedef struct mme_tai_index_s mme_tai_index_t;
+typedef struct mme_tai_link_s mme_tai_link_t;
+
 typedef struct mme_enb_s {
     ogs_lnode_t     lnode;
 
@@ -239,9 +245,26 @@ typedef struct mme_enb_s {
     ogs_pkbuf_t     *s1_reset_ack; /* Reset message */
 
     ogs_list_t      enb_ue_list;
+    ogs_hash_t      *enb_ue_hash;   /* hash table (ENB-UE-S1AP-ID : ENB_UE) */
+
+    /* Entries of mme_self()->tai_index_hash pointing at this eNB */
+    int             num_of_tai_link;
+    mme_tai_link_t  *tai_link[OGS_MAX_NUM_OF_TAI*OGS_MAX_NUM_OF_BPLMN];
 
 } mme_enb_t;
 
+/* All eNBs serving one TAI, used for paging */
+struct mme_tai_index_s {
+    ogs_eps_tai_t   tai;            /* hash key */
+    ogs_list_t      link_list;      /* list of mme_tai_link_t */
+};
+
+struct mme_tai_link_s {
+    ogs_lnode_t     lnode;
+    mme_tai_index_t *index;
+    mme_enb_t       *enb;
+};
+
 struct enb_ue_s {
     ogs_lnode_t     lnode;
     uint32_t        index;
@@ -412,10 +435,10 @@ struct mme_ue_s {
     uint8_t         xres[OGS_MAX_RES_LEN];
     uint8_t         xres_len;
     uint8_t         kasme[OGS_SHA256_DIGEST_SIZE];
+    ogs_kdf_key_t   kasme_key; /* HMAC state of kasme for the KDF */
     uint8_t         rand[OGS_RAND_LEN];
     uint8_t         autn[OGS_AUTN_LEN];
-    uint8_t         knas_int[OGS_SHA256_DIGEST_SIZE/2];
-    uint8_t         knas_enc[OGS_SHA256_DIGEST_SIZE/2];
+    ogs_nas_security_key_t nas_key; /* KNASint/KNASenc, expanded */
     uint32_t        dl_count;
     union {
         struct {
@@ -456,7 +479,9 @@ struct mme_ue_s {
     uint32_t        context_identifier; /* default APN */
 
     int num_of_session;
-    ogs_session_t session[OGS_MAX_NUM_OF_SESS];
+    /* OGS_MAX_NUM_OF_SESS entries, allocated on the first APN configuration
+     * from the HSS so that the pooled context stays small */
+    ogs_session_t *session;
 
     /* ESM Info */
     ogs_list_t      sess_list;
@@ -809,9 +834,13 @@ int mme_enb_set_enb_id(mme_enb_t *enb, uint32_t enb_id);
 int mme_enb_sock_type(ogs_sock_t *sock);
 mme_enb_t *mme_enb_cycle(mme_enb_t *enb);
 
+void mme_enb_update_tai_index(mme_enb_t *enb);
+mme_tai_index_t *mme_tai_index_find(ogs_eps_tai_t *tai);
+
 enb_ue_t *enb_ue_add(mme_enb_t *enb, uint32_t enb_ue_s1ap_id);
 void enb_ue_remove(enb_ue_t *enb_ue);
 void enb_ue_switch_to_enb(enb_ue_t *enb_ue, mme_enb_t *new_enb);
+void enb_ue_set_enb_ue_s1ap_id(enb_ue_t *enb_ue, uint32_t enb_ue_s1ap_id);
 enb_ue_t *enb_ue_find_by_enb_ue_s1ap_id(
         mme_enb_t *enb, uint32_t enb_ue_s1ap_id);
 enb_ue_t *enb_ue_find(uint32_t index);
@@ -23,6 +23,7 @@
 #include "mme-context.h"
 
 #include "s1ap-path.h"
+#include "s1ap-worker.h"
 
 void mme_event_term(void)
 {
@@ -123,9 +124,14 @@ void mme_sctp_event_push(mme_event_e id,
     e->max_num_of_istreams = max_num_of_istreams;
     e->max_num_of_ostreams = max_num_of_ostreams;
 
+    if (id == MME_EVENT_S1AP_MESSAGE && ogs_sctp_worker_in_thread())
+        mme_s1ap_worker_decode(e);
+
     rv = ogs_queue_push(ogs_app()->queue, e);
     if (rv != OGS_OK) {
         ogs_error("ogs_queue_push() failed:%d", (int)rv);
+        if (e->s1ap_message)
+            mme_s1ap_worker_message_free(e);
         ogs_free(e->addr);
         if (e->pkbuf)
             ogs_pkbuf_free(e->pkbuf);
@@ -135,5 +141,9 @@ void mme_sctp_event_push(mme_event_e id,
     else {
         ogs_pollset_notify(ogs_app()->pollset);
     }
+#else
+    else if (ogs_sctp_worker_in_thread()) {
+        ogs_pollset_notify(ogs_app()->pollset);
+    }
 #endif
 }
@@ -56,6 +56,7 @@ typedef enum {
 
 typedef long S1AP_ProcedureCode_t;
 typedef struct S1AP_S1AP_PDU ogs_s1ap_message_t;
+typedef struct ogs_asn_arena_s ogs_asn_arena_t;
 typedef struct ogs_nas_eps_message_s ogs_nas_eps_message_t;
 typedef struct ogs_diam_s6a_message_s ogs_diam_s6a_message_t;
 typedef struct mme_vlr_s mme_vlr_t;
@@ -81,6 +82,7 @@ typedef struct mme_event_s {
 
     S1AP_ProcedureCode_t s1ap_code;
     ogs_s1ap_message_t *s1ap_message;
+    ogs_asn_arena_t *s1ap_arena;    /* Decoded in an S1AP I/O thread */
 
     ogs_gtp_node_t *gnode;
 
@@ -30,6 +30,7 @@
 #include "sgsap-path.h"
 #include "mme-gtp-path.h"
 #include "metrics.h"
+#include "s1ap-worker.h"
 
 static ogs_thread_t *thread;
 static void mme_main(void *data);
@@ -72,6 +73,9 @@ int mme_initialize(void)
     rv = sgsap_open();
     if (rv != OGS_OK) return OGS_ERROR;
 
+    rv = mme_s1ap_worker_open();
+    if (rv != OGS_OK) return OGS_ERROR;
+
     rv = s1ap_open();
     if (rv != OGS_OK) return OGS_ERROR;
 
@@ -101,6 +105,9 @@ void mme_terminate(void)
 
     mme_context_final();
 
+    /* After mme_context_final() has handed back every eNB socket */
+    mme_s1ap_worker_close();
+
     ogs_gtp_context_final();
 
     ogs_gtp_xact_final();
@@ -148,6 +155,9 @@ static void mme_main(void *data)
             ogs_fsm_dispatch(&mme_sm, e);
             mme_event_free(e);
         }
+
+        /* Send what this iteration queued on SCTP associations */
+        ogs_sctp_flush_all();
     }
 done:
 
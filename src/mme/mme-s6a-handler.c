@@ -59,6 +59,8 @@ uint8_t mme_s6a_handle_aia(
     mme_ue->xres_len = e_utran_vector->xres_len;
     memcpy(mme_ue->xres, e_utran_vector->xres, mme_ue->xres_len);
     memcpy(mme_ue->kasme, e_utran_vector->kasme, OGS_SHA256_DIGEST_SIZE);
+    ogs_kdf_key_init(&mme_ue->kasme_key,
+            mme_ue->kasme, OGS_SHA256_DIGEST_SIZE);
     memcpy(mme_ue->rand, e_utran_vector->rand, OGS_RAND_LEN);
     memcpy(mme_ue->autn, e_utran_vector->autn, OGS_AUTN_LEN);
 
@@ -321,6 +323,13 @@ static uint8_t mme_ue_session_from_slice_data(mme_ue_t *mme_ue,
     ogs_slice_data_t *slice_data)
 {
     int i;
+
+    if (!mme_ue->session) {
+        mme_ue->session = ogs_calloc(
+                OGS_MAX_NUM_OF_SESS, sizeof(ogs_session_t));
+        ogs_assert(mme_ue->session);
+    }
+
     for (i = 0; i < slice_data->num_of_session; i++) {
         if (i >= OGS_MAX_NUM_OF_SESS) {
             ogs_warn("Ignore max session count overflow [%d>=%d]",
@@ -33,6 +33,7 @@
 #include "mme-fd-path.h"
 #include "mme-s6a-handler.h"
 #include "mme-path.h"
+#include "s1ap-worker.h"
 
 void mme_state_initial(ogs_fsm_t *s, mme_event_t *e)
 {
@@ -60,7 +61,7 @@ void mme_state_operational(ogs_fsm_t *s, mme_event_t *e)
     mme_enb_t *enb = NULL;
     uint16_t max_num_of_ostreams = 0;
 
-    ogs_s1ap_message_t s1ap_message;
+    ogs_s1ap_message_t s1ap_message, *s1ap_message_ptr = NULL;
     ogs_pkbuf_t *pkbuf = NULL;
     int rc, r;
 
@@ -132,7 +133,12 @@ void mme_state_operational(ogs_fsm_t *s, mme_event_t *e)
         max_num_of_ostreams = e->max_num_of_ostreams;
 
         enb = mme_enb_find_by_addr(addr);
-        if (!enb) {
+        if (!enb && mme_enb_sock_type(sock) == SOCK_STREAM) {
+            /* Accepted earlier, the eNB and its socket are already gone */
+            ogs_warn("eNB-S1[%s] already removed", OGS_ADDR(addr, buf));
+            ogs_free(addr);
+            break;
+        } else if (!enb) {
             enb = mme_enb_add(sock, addr);
             ogs_assert(enb);
         } else {
@@ -186,13 +192,29 @@ void mme_state_operational(ogs_fsm_t *s, mme_event_t *e)
         enb = mme_enb_find_by_addr(addr);
         ogs_free(addr);
 
-        ogs_assert(enb);
+        if (!enb) {
+            /* Read by an S1AP I/O thread before the eNB was removed */
+            ogs_warn("eNB-S1 already removed");
+            if (e->s1ap_message)
+                mme_s1ap_worker_message_free(e);
+            ogs_pkbuf_free(pkbuf);
+            break;
+        }
         ogs_assert(OGS_FSM_STATE(&enb->sm));
 
-        rc = ogs_s1ap_decode(&s1ap_message, pkbuf);
+        s1ap_message_ptr = e->s1ap_message;
+        if (s1ap_message_ptr) {
+            /* Decoded by an S1AP I/O thread */
+            ogs_asn_attach(e->s1ap_arena);
+            rc = OGS_OK;
+        } else {
+            s1ap_message_ptr = &s1ap_message;
+            rc = ogs_s1ap_decode(s1ap_message_ptr, pkbuf);
+        }
+
         if (rc == OGS_OK) {
             e->enb = enb;
-            e->s1ap_message = &s1ap_message;
+            e->s1ap_message = s1ap_message_ptr;
             ogs_fsm_dispatch(&enb->sm, e);
         } else {
             ogs_warn("Cannot decode S1AP message");
@@ -203,7 +225,9 @@ void mme_state_operational(ogs_fsm_t *s, mme_event_t *e)
             ogs_assert(r != OGS_ERROR);
         }
 
-        ogs_s1ap_free(&s1ap_message);
+        ogs_s1ap_free(s1ap_message_ptr);
+        if (s1ap_message_ptr != &s1ap_message)
+            ogs_free(s1ap_message_ptr);
         ogs_pkbuf_free(pkbuf);
         break;
 
@@ -157,6 +157,8 @@ void s1ap_handle_s1_setup_request(mme_enb_t *enb, ogs_s1ap_message_t *message)
         }
     }
 
+    mme_enb_update_tai_index(enb);
+
     if (maximum_number_of_enbs_is_reached()) {
         ogs_warn("S1-Setup failure:");
         ogs_warn("    Maximum number of eNBs reached");
@@ -2002,7 +2004,7 @@ void s1ap_handle_path_switch_request(
             mme_ue->e_cgi.cell_id);
 
     /* Update ENB-UE-S1AP-ID */
-    enb_ue->enb_ue_s1ap_id = *ENB_UE_S1AP_ID;
+    enb_ue_set_enb_ue_s1ap_id(enb_ue, *ENB_UE_S1AP_ID);
 
     /* Change enb_ue to the NEW eNB */
     enb_ue_switch_to_enb(enb_ue, enb);
@@ -2054,7 +2056,7 @@ void s1ap_handle_path_switch_request(
 
     /* Update Security Context (NextHop) */
     mme_ue->nhcc++;
-    ogs_kdf_nh_enb(mme_ue->kasme, mme_ue->nh, mme_ue->nh);
+    ogs_kdf_nh_enb_from_key(&mme_ue->kasme_key, mme_ue->nh, mme_ue->nh);
 
     ogs_list_init(&mme_ue->bearer_to_modify_list);
 
@@ -2408,7 +2410,7 @@ void s1ap_handle_handover_required(mme_enb_t *enb, ogs_s1ap_message_t *message)
     source_ue->handover_type = *HandoverType;
 
     mme_ue->nhcc++;
-    ogs_kdf_nh_enb(mme_ue->kasme, mme_ue->nh, mme_ue->nh);
+    ogs_kdf_nh_enb_from_key(&mme_ue->kasme_key, mme_ue->nh, mme_ue->nh);
 
     r = s1ap_send_handover_request(
             source_ue, target_enb, HandoverType, Cause,
@@ -2541,7 +2543,7 @@ void s1ap_handle_handover_request_ack(
     ogs_debug("    Target : ENB_UE_S1AP_ID[%d] MME_UE_S1AP_ID[%d]",
             target_ue->enb_ue_s1ap_id, target_ue->mme_ue_s1ap_id);
 
-    target_ue->enb_ue_s1ap_id = *ENB_UE_S1AP_ID;
+    enb_ue_set_enb_ue_s1ap_id(target_ue, *ENB_UE_S1AP_ID);
 
     for (i = 0; i < E_RABAdmittedList->list.count; i++) {
         S1AP_E_RABAdmittedItemIEs_t *item = NULL;
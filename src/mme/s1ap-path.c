@@ -408,8 +408,8 @@ int s1ap_send_ue_context_release_command(
 int s1ap_send_paging(mme_ue_t *mme_ue, S1AP_CNDomain_t cn_domain)
 {
     ogs_pkbuf_t *s1apbuf = NULL;
-    mme_enb_t *enb = NULL;
-    int i;
+    mme_tai_index_t *index = NULL;
+    mme_tai_link_t *link = NULL;
     int rv;
 
     ogs_debug("S1-Paging");
@@ -422,34 +422,34 @@ int s1ap_send_paging(mme_ue_t *mme_ue, S1AP_CNDomain_t cn_domain)
     ogs_assert(ogs_timer_running(mme_ue->t_implicit_detach.timer) == false);
 
     /* Find enB with matched TAI */
-    ogs_list_for_each(&mme_self()->enb_list, enb) {
-        for (i = 0; i < enb->num_of_supported_ta_list; i++) {
-
-            if (memcmp(&enb->supported_ta_list[i], &mme_ue->tai,
-                        sizeof(ogs_eps_tai_t)) == 0) {
-
-                if (mme_ue->t3413.pkbuf) {
-                    s1apbuf = mme_ue->t3413.pkbuf;
-                } else {
-                    s1apbuf = s1ap_build_paging(mme_ue, cn_domain);
-                    if (!s1apbuf) {
-                        ogs_error("s1ap_build_paging() failed");
-                        return OGS_ERROR;
-                    }
-                }
-
-                mme_ue->t3413.pkbuf = ogs_pkbuf_copy(s1apbuf);
-                if (!mme_ue->t3413.pkbuf) {
-                    ogs_error("ogs_pkbuf_copy() failed");
-                    ogs_pkbuf_free(s1apbuf);
+    index = mme_tai_index_find(&mme_ue->tai);
+    if (index) {
+        ogs_list_for_each(&index->link_list, link) {
+            mme_enb_t *enb = link->enb;
+            ogs_assert(enb);
+
+            if (mme_ue->t3413.pkbuf) {
+                s1apbuf = mme_ue->t3413.pkbuf;
+            } else {
+                s1apbuf = s1ap_build_paging(mme_ue, cn_domain);
+                if (!s1apbuf) {
+                    ogs_error("s1ap_build_paging() failed");
                     return OGS_ERROR;
                 }
+            }
 
-                rv = s1ap_send_to_enb(enb, s1apbuf, S1AP_NON_UE_SIGNALLING);
-                if (rv != OGS_OK) {
-                    ogs_error("s1ap_send_to_enb() failed");
-                    return rv;
-                }
+            /* Reference copy: the PDU is encoded once for all eNBs */
+            mme_ue->t3413.pkbuf = ogs_pkbuf_copy(s1apbuf);
+            if (!mme_ue->t3413.pkbuf) {
+                ogs_error("ogs_pkbuf_copy() failed");
+                ogs_pkbuf_free(s1apbuf);
+                return OGS_ERROR;
+            }
+
+            rv = s1ap_send_to_enb(enb, s1apbuf, S1AP_NON_UE_SIGNALLING);
+            if (rv != OGS_OK) {
+                ogs_error("s1ap_send_to_enb() failed");
+                return rv;
             }
         }
     }
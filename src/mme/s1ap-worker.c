@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "s1ap-worker.h"
+#include "s1ap-path.h"
+
+/*
+ * S1AP I/O threads, see ogs_sctp_worker_open(). An eNB association read
+ * by an I/O thread is decoded there as well, and the decoded message
+ * travels to the MME thread in the event with its ASN.1 arena detached.
+ */
+static void *s1ap_decode(ogs_pkbuf_t *pkbuf)
+{
+    ogs_s1ap_message_t *message = NULL;
+
+    ogs_assert(pkbuf);
+
+    message = ogs_calloc(1, sizeof(*message));
+    ogs_assert(message);
+
+    if (ogs_s1ap_decode(message, pkbuf) != OGS_OK) {
+        /* The MME thread decodes it again to send Error Indication */
+        ogs_s1ap_free(message);
+        ogs_free(message);
+        return NULL;
+    }
+
+    return message;
+}
+
+static void s1ap_message_free(void *message)
+{
+    ogs_assert(message);
+
+    ogs_s1ap_free(message);
+    ogs_free(message);
+}
+
+int mme_s1ap_worker_open(void)
+{
+    int rv;
+
+    rv = ogs_sctp_worker_open(mme_self()->s1ap_io_thread,
+            s1ap_recv_upcall, s1ap_decode, s1ap_message_free);
+    if (rv != OGS_OK) return rv;
+
+    if (ogs_sctp_worker_is_enabled())
+        ogs_info("s1ap_server() with %d I/O thread(s)",
+                mme_self()->s1ap_io_thread);
+
+    return OGS_OK;
+}
+
+void mme_s1ap_worker_close(void)
+{
+    ogs_sctp_worker_close();
+}
+
+void mme_s1ap_worker_decode(mme_event_t *e)
+{
+    ogs_assert(e);
+    ogs_assert(e->pkbuf);
+
+    e->s1ap_message = ogs_sctp_worker_decode(e->pkbuf);
+    if (e->s1ap_message)
+        e->s1ap_arena = ogs_asn_detach(e->s1ap_message);
+}
+
+void mme_s1ap_worker_message_free(mme_event_t *e)
+{
+    ogs_assert(e);
+    ogs_assert(e->s1ap_message);
+
+    ogs_asn_attach(e->s1ap_arena);
+    ogs_sctp_worker_message_free(e->s1ap_message);
+
+    e->s1ap_message = NULL;
+    e->s1ap_arena = NULL;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef S1AP_WORKER_H
+#define S1AP_WORKER_H
+
+#include "mme-context.h"
+#include "mme-event.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int mme_s1ap_worker_open(void);
+void mme_s1ap_worker_close(void);
+
+void mme_s1ap_worker_decode(mme_event_t *e);
+void mme_s1ap_worker_message_free(mme_event_t *e);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* S1AP_WORKER_H */
@@ -96,6 +96,8 @@ int scp_context_parse_config(void)
                 ogs_assert(scp_key);
                 if (!strcmp(scp_key, "sbi")) {
                     /* handle config in sbi library */
+                } else if (!strcmp(scp_key, "metrics")) {
+                    /* handle config in metrics library */
                 } else if (!strcmp(scp_key, "service_name")) {
                     /* handle config in sbi library */
                 } else if (!strcmp(scp_key, "discovery")) {
@@ -267,6 +269,7 @@ scp_assoc_t *scp_assoc_add(ogs_sbi_stream_t *stream)
     memset(assoc, 0, sizeof *assoc);
 
     assoc->stream = stream;
+    assoc->start = ogs_get_monotonic_time();
 
     ogs_list_add(&self.assoc_list, assoc);
 
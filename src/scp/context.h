@@ -24,6 +24,7 @@
 #include "ogs-app.h"
 
 #include "scp-sm.h"
+#include "metrics.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -53,6 +54,10 @@ typedef struct scp_assoc_s {
     OpenAPI_nf_type_e requester_nf_type;
 
     ogs_sbi_nf_instance_t *nf_service_producer;
+
+    ogs_time_t start;
+    scp_route_t route;
+    ogs_sbi_service_type_e route_service_type;
 } scp_assoc_t;
 
 void scp_context_init(void);
@@ -0,0 +1,110 @@
+#include "ogs-app.h"
+#include "context.h"
+
+#include "metrics.h"
+
+typedef struct scp_metrics_spec_def_s {
+    unsigned int type;
+    const char *name;
+    const char *description;
+    int initial_val;
+    unsigned int num_labels;
+    const char **labels;
+    ogs_metrics_histogram_params_t histogram_params;
+} scp_metrics_spec_def_t;
+
+static int scp_metrics_init_spec(ogs_metrics_context_t *ctx,
+        ogs_metrics_spec_t **dst, scp_metrics_spec_def_t *src, unsigned int len)
+{
+    unsigned int i;
+    for (i = 0; i < len; i++) {
+        dst[i] = ogs_metrics_spec_new(ctx, src[i].type,
+                src[i].name, src[i].description,
+                src[i].initial_val, src[i].num_labels, src[i].labels,
+                &src[i].histogram_params);
+    }
+
+    return OGS_OK;
+}
+
+/* BY ROUTE */
+const char *labels_route[] = {
+    "service",
+    "route"
+};
+
+static const char *route_name[_SCP_ROUTE_MAX] = {
+    [SCP_ROUTE_NEXT_SCP] = "next_scp",
+    [SCP_ROUTE_TARGET_APIROOT] = "target_apiroot",
+    [SCP_ROUTE_TARGET_NF_INSTANCE] = "target_nf_instance",
+    [SCP_ROUTE_DISCOVERY_CACHE] = "discovery_cache",
+    [SCP_ROUTE_DISCOVERY] = "discovery",
+};
+
+ogs_metrics_spec_t *scp_metrics_spec_by_route[_SCP_METR_BY_ROUTE_MAX];
+scp_metrics_spec_def_t scp_metrics_spec_def_by_route[_SCP_METR_BY_ROUTE_MAX] = {
+/* Histograms: */
+[SCP_METR_HIST_RELAY_TIME] = {
+    .type = OGS_METRICS_METRIC_TYPE_HISTOGRAM,
+    .name = "scp_relay_time_usec",
+    .description = "Time from request received to response relayed",
+    .num_labels = OGS_ARRAY_SIZE(labels_route),
+    .labels = labels_route,
+    .histogram_params = {
+        .type = OGS_METRICS_HISTOGRAM_BUCKET_TYPE_EXPONENTIAL,
+        .count = 10,
+        .exp.start = 100,
+        .exp.factor = 2,
+    },
+},
+};
+
+/*
+ * Labels are bounded (service type x route), so instances are kept in
+ * a flat table instead of a hash. Index 0 collects unknown services.
+ */
+static ogs_metrics_inst_t *scp_metrics_inst_by_route
+    [_SCP_METR_BY_ROUTE_MAX][OGS_SBI_MAX_NUM_OF_SERVICE_TYPE][_SCP_ROUTE_MAX];
+
+void scp_metrics_inst_by_route_add(
+    ogs_sbi_service_type_e service_type, scp_route_t route,
+    scp_metric_type_by_route_t t, int val)
+{
+    ogs_metrics_inst_t **metrics = NULL;
+
+    ogs_assert(t < _SCP_METR_BY_ROUTE_MAX);
+    ogs_assert(route < _SCP_ROUTE_MAX);
+    if (service_type >= OGS_SBI_MAX_NUM_OF_SERVICE_TYPE)
+        service_type = OGS_SBI_SERVICE_TYPE_NULL;
+
+    metrics = &scp_metrics_inst_by_route[t][service_type][route];
+    if (!*metrics) {
+        *metrics = ogs_metrics_inst_new(scp_metrics_spec_by_route[t],
+                scp_metrics_spec_def_by_route->num_labels,
+                (const char *[]){
+                    service_type ?
+                        ogs_sbi_service_type_to_name(service_type) :
+                        "unknown",
+                    route_name[route] });
+        ogs_assert(*metrics);
+    }
+
+    ogs_metrics_inst_add(*metrics, val);
+}
+
+void scp_metrics_init(void)
+{
+    ogs_metrics_context_t *ctx = ogs_metrics_self();
+    ogs_metrics_context_init();
+
+    scp_metrics_init_spec(ctx, scp_metrics_spec_by_route,
+            scp_metrics_spec_def_by_route, _SCP_METR_BY_ROUTE_MAX);
+}
+
+void scp_metrics_final(void)
+{
+    /* Instances are free'd by ogs_metrics_context_final() */
+    memset(scp_metrics_inst_by_route, 0, sizeof(scp_metrics_inst_by_route));
+
+    ogs_metrics_context_final();
+}
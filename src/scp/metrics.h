@@ -0,0 +1,37 @@
+#ifndef SCP_METRICS_H
+#define SCP_METRICS_H
+
+#include "ogs-metrics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* How the SCP chose the producer for a relayed request */
+typedef enum scp_route_s {
+    SCP_ROUTE_NEXT_SCP = 0,
+    SCP_ROUTE_TARGET_APIROOT,
+    SCP_ROUTE_TARGET_NF_INSTANCE,
+    SCP_ROUTE_DISCOVERY_CACHE,
+    SCP_ROUTE_DISCOVERY,
+    _SCP_ROUTE_MAX,
+} scp_route_t;
+
+/* BY ROUTE */
+typedef enum scp_metric_type_by_route_s {
+    SCP_METR_HIST_RELAY_TIME = 0,
+    _SCP_METR_BY_ROUTE_MAX,
+} scp_metric_type_by_route_t;
+
+void scp_metrics_inst_by_route_add(
+    ogs_sbi_service_type_e service_type, scp_route_t route,
+    scp_metric_type_by_route_t t, int val);
+
+void scp_metrics_init(void);
+void scp_metrics_final(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCP_METRICS_H */
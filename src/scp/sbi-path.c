@@ -19,7 +19,8 @@
 
 #include "sbi-path.h"
 
-static int request_handler(ogs_sbi_request_t *request, void *data);
+#define MAX_SERVICE_NAME_LEN 64
+
 static int response_handler(
         int status, ogs_sbi_response_t *response, void *data);
 static int discover_handler(
@@ -28,6 +29,8 @@ static int discover_handler(
 static void copy_request(
         ogs_sbi_request_t *target, ogs_sbi_request_t *source,
         bool include_discovery);
+static void copy_request_free(ogs_sbi_request_t *target);
+static ogs_sbi_service_type_e service_type_from_uri(const char *uri);
 
 int scp_sbi_open(void)
 {
@@ -80,7 +83,7 @@ int scp_sbi_open(void)
         ogs_sbi_subscription_spec_add(OpenAPI_nf_type_UDR, NULL);
     }
 
-    if (ogs_sbi_server_start_all(request_handler) != OGS_OK)
+    if (ogs_sbi_server_start_all(ogs_sbi_server_handler) != OGS_OK)
         return OGS_ERROR;
 
     return OGS_OK;
@@ -92,12 +95,15 @@ void scp_sbi_close(void)
     ogs_sbi_server_stop_all();
 }
 
-static int request_handler(ogs_sbi_request_t *request, void *data)
+/*
+ * Called from scp_state_operational() for each request received.
+ * Returns OGS_DONE if the request is for the SCP itself.
+ */
+int scp_sbi_request_handler(
+        ogs_sbi_request_t *request, ogs_sbi_stream_t *stream)
 {
-    int rv;
     ogs_hash_index_t *hi;
     ogs_sbi_client_t *client = NULL, *nrf_client = NULL, *next_scp = NULL;
-    ogs_sbi_stream_t *stream = data;
 
     ogs_sbi_request_t scp_request;
     char *apiroot = NULL, *newuri = NULL;
@@ -110,6 +116,7 @@ static int request_handler(ogs_sbi_request_t *request, void *data)
 
     scp_assoc_t *assoc = NULL;
     ogs_sbi_nf_instance_t *nf_instance = NULL;
+    scp_route_t route = SCP_ROUTE_DISCOVERY;
 
     struct {
         char *target_apiroot;
@@ -119,8 +126,6 @@ static int request_handler(ogs_sbi_request_t *request, void *data)
         NULL, NULL, NULL
     };
 
-    scp_event_t *e = NULL;
-
     ogs_assert(request);
     ogs_assert(request->h.uri);
     ogs_assert(stream);
@@ -233,9 +238,10 @@ static int request_handler(ogs_sbi_request_t *request, void *data)
             return OGS_ERROR;
         }
 
-        if (target_nf_type == OpenAPI_nf_type_NRF)
+        if (target_nf_type == OpenAPI_nf_type_NRF) {
             client = NF_INSTANCE_CLIENT(ogs_sbi_self()->nrf_instance);
-        else {
+            route = SCP_ROUTE_TARGET_NF_INSTANCE;
+        } else {
             if (discovery_option && discovery_option->target_nf_instance_id) {
                 nf_instance = ogs_sbi_nf_instance_find(
                         discovery_option->target_nf_instance_id);
@@ -250,6 +256,19 @@ static int request_handler(ogs_sbi_request_t *request, void *data)
                                 ogs_sbi_service_type_to_name(service_type));
                     }
                 }
+                route = SCP_ROUTE_TARGET_NF_INSTANCE;
+            } else if (!next_scp && !headers.target_apiroot) {
+                /*
+                 * Use the result of an earlier NF discovery if it still
+                 * matches, so that the request does not wait for the NRF.
+                 */
+                nf_instance = ogs_sbi_nf_instance_find_by_discovery_param(
+                        target_nf_type, requester_nf_type, discovery_option);
+                if (nf_instance) {
+                    client = ogs_sbi_client_find_by_service_type(
+                                nf_instance, service_type);
+                    route = SCP_ROUTE_DISCOVERY_CACHE;
+                }
             }
         }
 
@@ -267,9 +286,13 @@ static int request_handler(ogs_sbi_request_t *request, void *data)
             return OGS_ERROR;
         }
 
+        assoc->route_service_type = service_type ? service_type :
+                service_type_from_uri(request->h.uri);
+
         if (next_scp) {
             /* Switch to the Next-SCP's client */
             client = next_scp;
+            assoc->route = SCP_ROUTE_NEXT_SCP;
 
             /* Client ApiRoot */
             apiroot = ogs_sbi_client_apiroot(client);
@@ -286,6 +309,8 @@ static int request_handler(ogs_sbi_request_t *request, void *data)
             OpenAPI_uri_scheme_e scheme = OpenAPI_uri_scheme_NULL;
             ogs_sockaddr_t *addr = NULL;
 
+            assoc->route = SCP_ROUTE_TARGET_APIROOT;
+
             /* Find or Add Client Instance */
             rc = ogs_sbi_getaddr_from_uri(
                     &scheme, &addr, headers.target_apiroot);
@@ -313,6 +338,10 @@ static int request_handler(ogs_sbi_request_t *request, void *data)
             ogs_assert(newuri);
 
         } else if (client) {
+            assoc->route = route;
+            if (route == SCP_ROUTE_DISCOVERY_CACHE)
+                assoc->nf_service_producer = nf_instance;
+
             /* Client ApiRoot */
             apiroot = ogs_sbi_client_apiroot(client);
             ogs_assert(apiroot);
@@ -341,16 +370,14 @@ static int request_handler(ogs_sbi_request_t *request, void *data)
                     client, response_handler, &scp_request, assoc) != true) {
             ogs_error("ogs_sbi_client_send_request() failed");
 
-            ogs_sbi_http_hash_free(scp_request.http.headers);
-            ogs_free(scp_request.h.uri);
+            copy_request_free(&scp_request);
             ogs_sbi_discovery_option_free(discovery_option);
             scp_assoc_remove(assoc);
 
             return OGS_ERROR;
         }
 
-        ogs_sbi_http_hash_free(scp_request.http.headers);
-        ogs_free(scp_request.h.uri);
+        copy_request_free(&scp_request);
         ogs_sbi_discovery_option_free(discovery_option);
 
         return OGS_OK;
@@ -466,6 +493,8 @@ static int request_handler(ogs_sbi_request_t *request, void *data)
         ogs_assert(assoc->service_type);
         assoc->requester_nf_type = requester_nf_type;
         ogs_assert(assoc->requester_nf_type);
+        assoc->route = SCP_ROUTE_DISCOVERY;
+        assoc->route_service_type = service_type;
 
         ogs_assert(target_nf_type);
         ogs_assert(discovery_option);
@@ -504,24 +533,7 @@ static int request_handler(ogs_sbi_request_t *request, void *data)
     /***************************************
      * Receive NOTIFICATION message from NRF
      ***************************************/
-    ogs_assert(request);
-    ogs_assert(data);
-
-    e = scp_event_new(OGS_EVENT_SBI_SERVER);
-    ogs_assert(e);
-
-    e->h.sbi.request = request;
-    e->h.sbi.data = data;
-
-    rv = ogs_queue_push(ogs_app()->queue, e);
-    if (rv != OGS_OK) {
-        ogs_error("ogs_queue_push() failed:%d", (int)rv);
-
-        ogs_event_free(e);
-        return OGS_ERROR;
-    }
-
-    return OGS_OK;
+    return OGS_DONE;
 }
 
 static int response_handler(
@@ -534,6 +546,11 @@ static int response_handler(
     stream = assoc->stream;
     ogs_assert(stream);
 
+    scp_metrics_inst_by_route_add(
+            assoc->route_service_type, assoc->route,
+            SCP_METR_HIST_RELAY_TIME,
+            (int)(ogs_get_monotonic_time() - assoc->start));
+
     if (status != OGS_OK) {
 
         ogs_log_message(
@@ -580,7 +597,7 @@ static int discover_handler(
     OpenAPI_nf_type_e requester_nf_type = OpenAPI_nf_type_NULL;
 
     ogs_sbi_request_t scp_request;
-    char *apiroot = NULL;
+    char *apiroot = NULL, *target_apiroot = NULL;
 
     ogs_sbi_nf_instance_t *nf_instance = NULL;
     ogs_sbi_client_t *client = NULL, *next_scp = NULL;
@@ -657,13 +674,13 @@ static int discover_handler(
     /* Check if Next-SCP's client */
     next_scp = NF_INSTANCE_CLIENT(ogs_sbi_self()->scp_instance);
     if (next_scp) {
-        apiroot = ogs_sbi_client_apiroot(client);
-        ogs_assert(apiroot);
-
-        ogs_sbi_header_set(scp_request.http.headers,
-                OGS_SBI_CUSTOM_TARGET_APIROOT, apiroot);
+        /* Headers are borrowed, so 'target_apiroot' lives until sent */
+        target_apiroot = ogs_sbi_client_apiroot(client);
+        ogs_assert(target_apiroot);
 
-        ogs_free(apiroot);
+        ogs_hash_set(scp_request.http.headers,
+                OGS_SBI_CUSTOM_TARGET_APIROOT, OGS_HASH_KEY_STRING,
+                target_apiroot);
 
         /* Switch to the Next-SCP's client */
         client = next_scp;
@@ -689,14 +706,16 @@ static int discover_handler(
         ogs_error("ogs_sbi_client_send_request() failed");
         strerror = ogs_msprintf("ogs_sbi_client_send_request() failed");
 
-        ogs_sbi_http_hash_free(scp_request.http.headers);
-        ogs_free(scp_request.h.uri);
+        copy_request_free(&scp_request);
+        if (target_apiroot)
+            ogs_free(target_apiroot);
 
         goto cleanup;
     }
 
-    ogs_sbi_http_hash_free(scp_request.http.headers);
-    ogs_free(scp_request.h.uri);
+    copy_request_free(&scp_request);
+    if (target_apiroot)
+        ogs_free(target_apiroot);
 
     ogs_sbi_response_free(response);
     ogs_sbi_message_free(&message);
@@ -732,13 +751,24 @@ static void copy_request(
 
     memset(target, 0, sizeof(*target));
 
-    /* HTTP method/params/content */
+    /* HTTP method/params */
     target->h.method = source->h.method;
     target->http.params = source->http.params;
+
+    /*
+     * HTTP content is handed over to the client without copying.
+     * The source request is only needed for its stream from now on.
+     */
     target->http.content = source->http.content;
     target->http.content_length = source->http.content_length;
+    target->move_content = true;
+    source->http.content = NULL;
+    source->http.content_length = 0;
 
     /* HTTP Headers
+     *
+     * Key/value strings are borrowed from the source request,
+     * and are copied only once into the client's header list.
      *
      * To remove the followings,
      *   Scheme - https
@@ -771,7 +801,45 @@ static void copy_request(
         } else if (!strcasecmp(key, OGS_SBI_SCHEME)) {
         } else if (!strcasecmp(key, OGS_SBI_AUTHORITY)) {
         } else {
-            ogs_sbi_header_set(target->http.headers, key, val);
+            ogs_hash_set(target->http.headers, key, OGS_HASH_KEY_STRING, val);
         }
     }
 }
+
+static void copy_request_free(ogs_sbi_request_t *target)
+{
+    ogs_assert(target);
+
+    /* Only the hash table belongs to the copy, not the strings */
+    ogs_assert(target->http.headers);
+    ogs_hash_destroy(target->http.headers);
+
+    /* Still here if the client did not take it */
+    if (target->http.content)
+        ogs_free(target->http.content);
+
+    ogs_assert(target->h.uri);
+    ogs_free(target->h.uri);
+}
+
+static ogs_sbi_service_type_e service_type_from_uri(const char *uri)
+{
+    char name[MAX_SERVICE_NAME_LEN];
+    const char *p = NULL;
+    int len;
+
+    ogs_assert(uri);
+
+    /* "/nudm-ueau/v1/..." */
+    if (*uri == '/')
+        uri++;
+    p = strchr(uri, '/');
+    len = p ? p - uri : strlen(uri);
+    if (len <= 0 || len >= sizeof(name))
+        return OGS_SBI_SERVICE_TYPE_NULL;
+
+    memcpy(name, uri, len);
+    name[len] = 0;
+
+    return ogs_sbi_service_type_from_name(name);
+}
@@ -29,6 +29,9 @@ extern "C" {
 int scp_sbi_open(void);
 void scp_sbi_close(void);
 
+int scp_sbi_request_handler(
+        ogs_sbi_request_t *request, ogs_sbi_stream_t *stream);
+
 #ifdef __cplusplus
 }
 #endif
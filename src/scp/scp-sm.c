@@ -65,6 +65,18 @@ void scp_state_operational(ogs_fsm_t *s, scp_event_t *e)
         stream = e->h.sbi.data;
         ogs_assert(stream);
 
+        /* Relay the request, unless it is for the SCP itself */
+        rv = scp_sbi_request_handler(request, stream);
+        if (rv == OGS_OK)
+            break;
+        if (rv != OGS_DONE) {
+            ogs_assert(true ==
+                ogs_sbi_server_send_error(stream,
+                    OGS_SBI_HTTP_STATUS_INTERNAL_SERVER_ERROR, NULL,
+                    "cannot relay HTTP request", NULL));
+            break;
+        }
+
         rv = ogs_sbi_parse_request(&message, request);
         if (rv != OGS_OK) {
             /* 'sbi_message' buffer is released in ogs_sbi_parse_request() */
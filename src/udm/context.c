@@ -70,11 +70,22 @@ udm_context_t *udm_self(void)
 
 static int udm_context_prepare(void)
 {
+    self.crypto.queue = ogs_app()->max.ue;
+
     return OGS_OK;
 }
 
 static int udm_context_validation(void)
 {
+    if (self.crypto.worker < 0) {
+        ogs_error("Invalid crypto.worker [%d]", self.crypto.worker);
+        return OGS_ERROR;
+    }
+    if (self.crypto.queue <= 0) {
+        ogs_error("Invalid crypto.queue [%d]", self.crypto.queue);
+        return OGS_ERROR;
+    }
+
     return OGS_OK;
 }
 
@@ -109,6 +120,24 @@ int udm_context_parse_config(void)
                 } else if (!strcmp(udm_key, "hnet")) {
                     rv = ogs_sbi_context_parse_hnet_config(&udm_iter);
                     if (rv != OGS_OK) return rv;
+                } else if (!strcmp(udm_key, "crypto")) {
+                    ogs_yaml_iter_t crypto_iter;
+                    ogs_yaml_iter_recurse(&udm_iter, &crypto_iter);
+                    while (ogs_yaml_iter_next(&crypto_iter)) {
+                        const char *crypto_key =
+                            ogs_yaml_iter_key(&crypto_iter);
+                        ogs_assert(crypto_key);
+                        if (!strcmp(crypto_key, "worker")) {
+                            const char *v = ogs_yaml_iter_value(&crypto_iter);
+                            if (v) self.crypto.worker = atoi(v);
+                        } else if (!strcmp(crypto_key, "queue")) {
+                            const char *v = ogs_yaml_iter_value(&crypto_iter);
+                            if (v) self.crypto.queue = atoi(v);
+                        } else
+                            ogs_warn("unknown key `%s`", crypto_key);
+                    }
+                } else if (!strcmp(udm_key, "metrics")) {
+                    /* handle config in metrics library */
                 } else
                     ogs_warn("unknown key `%s`", udm_key);
             }
@@ -122,11 +151,32 @@ int udm_context_parse_config(void)
 }
 
 udm_ue_t *udm_ue_add(char *suci)
+{
+    udm_ue_t *udm_ue = NULL;
+    char *supi = NULL;
+
+    ogs_assert(suci);
+
+    supi = ogs_supi_from_supi_or_suci(suci);
+    if (!supi) {
+        ogs_error("[%s] Cannot de-conceal SUCI", suci);
+        return NULL;
+    }
+
+    udm_ue = udm_ue_add_with_supi(suci, supi);
+    ogs_free(supi);
+
+    return udm_ue;
+}
+
+/* The SUPI has already been de-concealed by the crypto worker */
+udm_ue_t *udm_ue_add_with_supi(char *suci, char *supi)
 {
     udm_event_t e;
     udm_ue_t *udm_ue = NULL;
 
     ogs_assert(suci);
+    ogs_assert(supi);
 
     ogs_pool_alloc(&udm_ue_pool, &udm_ue);
     ogs_assert(udm_ue);
@@ -140,7 +190,7 @@ udm_ue_t *udm_ue_add(char *suci)
     ogs_assert(udm_ue->suci);
     ogs_hash_set(self.suci_hash, udm_ue->suci, strlen(udm_ue->suci), udm_ue);
 
-    udm_ue->supi = ogs_supi_from_supi_or_suci(udm_ue->suci);
+    udm_ue->supi = ogs_strdup(supi);
     ogs_assert(udm_ue->supi);
     ogs_hash_set(self.supi_hash, udm_ue->supi, strlen(udm_ue->supi), udm_ue);
 
@@ -40,6 +40,11 @@ typedef struct udm_context_s {
     ogs_hash_t      *suci_hash;
     ogs_hash_t      *supi_hash;
 
+    struct {
+        int         worker;     /* 0: run on the event loop */
+        int         queue;      /* Maximum number of pending jobs */
+    } crypto;
+
 } udm_context_t;
 
 struct udm_ue_s {
@@ -79,6 +84,7 @@ udm_context_t *udm_self(void);
 int udm_context_parse_config(void);
 
 udm_ue_t *udm_ue_add(char *suci);
+udm_ue_t *udm_ue_add_with_supi(char *suci, char *supi);
 void udm_ue_remove(udm_ue_t *udm_ue);
 void udm_ue_remove_all(void);
 udm_ue_t *udm_ue_find_by_suci(char *suci);
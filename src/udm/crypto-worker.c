@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto-worker.h"
+#include "metrics.h"
+
+/*
+ * SUCI de-concealment (ECIES) and AV generation run on a bounded pool of
+ * worker threads so that the UDM thread keeps serving other SBI traffic.
+ * Results come back to the UDM thread as UDM_EVENT_CRYPTO_DONE.
+ */
+static ogs_worker_pool_t *pool;
+
+static void job_run(ogs_worker_job_t *h);
+static int job_done(ogs_worker_job_t *h);
+static void job_free(ogs_worker_job_t *h);
+
+int udm_crypto_open(void)
+{
+    if (udm_self()->crypto.worker == 0)
+        return OGS_OK;
+
+    pool = ogs_worker_pool_create(
+            udm_self()->crypto.worker, udm_self()->crypto.queue,
+            job_run, job_done, job_free);
+    if (!pool) {
+        ogs_error("ogs_worker_pool_create() failed");
+        return OGS_ERROR;
+    }
+
+    ogs_info("crypto with %d worker(s) [queue:%d]",
+            udm_self()->crypto.worker, udm_self()->crypto.queue);
+
+    return OGS_OK;
+}
+
+void udm_crypto_close(void)
+{
+    if (pool) {
+        ogs_worker_pool_destroy(pool);
+        pool = NULL;
+    }
+}
+
+bool udm_crypto_is_enabled(void)
+{
+    return pool != NULL;
+}
+
+udm_crypto_job_t *udm_crypto_job_new(
+        udm_crypto_type_e type, ogs_sbi_stream_t *stream)
+{
+    udm_crypto_job_t *job = NULL;
+
+    ogs_assert(type < MAX_NUM_OF_UDM_CRYPTO);
+    ogs_assert(stream);
+
+    job = ogs_calloc(1, sizeof(*job));
+    if (!job) {
+        ogs_error("ogs_calloc() failed");
+        return NULL;
+    }
+
+    job->type = type;
+    job->stream = stream;
+
+    return job;
+}
+
+void udm_crypto_job_free(udm_crypto_job_t *job)
+{
+    ogs_assert(job);
+
+    if (job->suci.suci)
+        ogs_free(job->suci.suci);
+    if (job->suci.supi)
+        ogs_free(job->suci.supi);
+    if (job->av.serving_network_name)
+        ogs_free(job->av.serving_network_name);
+
+    ogs_free(job);
+}
+
+bool udm_crypto_submit(udm_crypto_job_t *job)
+{
+    ogs_assert(job);
+    ogs_assert(pool);
+
+    if (ogs_worker_pool_submit(pool, &job->h) != OGS_OK) {
+        ogs_warn("Crypto queue full [%d]", udm_self()->crypto.queue);
+        udm_metrics_inst_global_inc(UDM_METR_GLOB_CTR_CRYPTO_REJECTED);
+        return false;
+    }
+
+    udm_metrics_inst_global_inc(UDM_METR_GLOB_GAUGE_CRYPTO_QUEUE_DEPTH);
+
+    return true;
+}
+
+void udm_crypto_complete(udm_crypto_job_t *job)
+{
+    ogs_assert(job);
+    ogs_assert(pool);
+
+    ogs_worker_pool_complete(pool, &job->h);
+
+    udm_metrics_inst_global_dec(UDM_METR_GLOB_GAUGE_CRYPTO_QUEUE_DEPTH);
+    udm_metrics_inst_by_crypto_add(job->type,
+            UDM_METR_HIST_CRYPTO_WAIT_TIME,
+            job->h.started - job->h.submitted);
+    udm_metrics_inst_by_crypto_add(job->type,
+            UDM_METR_HIST_CRYPTO_EXEC_TIME,
+            job->h.finished - job->h.started);
+}
+
+bool udm_crypto_suci_is_concealed(const char *suci)
+{
+    const char *p = NULL;
+    int i;
+
+    ogs_assert(suci);
+
+    if (strncmp(suci, "suci-", 5) != 0)
+        return false;
+
+    /* suci-<type>-<mcc>-<mnc>-<routing>-<scheme>-<pki>-<output> */
+    p = suci;
+    for (i = 0; i < 5; i++) {
+        p = strchr(p, '-');
+        if (!p)
+            return false;
+        p++;
+    }
+
+    return atoi(p) != OGS_PROTECTION_SCHEME_NULL;
+}
+
+void udm_crypto_av_generate(udm_crypto_av_t *av)
+{
+    uint8_t ik[OGS_KEY_LEN];
+    uint8_t ck[OGS_KEY_LEN];
+    uint8_t ak[OGS_AK_LEN];
+    uint8_t xres[OGS_MAX_RES_LEN];
+    size_t xres_len = 8;
+
+    ogs_assert(av);
+    ogs_assert(av->serving_network_name);
+
+    milenage_generate(av->opc, av->amf, av->k, av->sqn, av->rand,
+            av->autn, ik, ck, ak, xres, &xres_len);
+
+    /* TS33.501 Annex A.2 : Kausf derviation function */
+    ogs_kdf_kausf(ck, ik, av->serving_network_name, av->autn, av->kausf);
+
+    /* TS33.501 Annex A.4 : RES* and XRES* derivation function */
+    ogs_kdf_xres_star(ck, ik, av->serving_network_name, av->rand,
+            xres, xres_len, av->xres_star);
+}
+
+static void job_run(ogs_worker_job_t *h)
+{
+    udm_crypto_job_t *job = (udm_crypto_job_t *)h;
+
+    ogs_assert(job);
+
+    switch (job->type) {
+    case UDM_CRYPTO_SUCI:
+        ogs_assert(job->suci.suci);
+        job->suci.supi = ogs_supi_from_suci(job->suci.suci);
+        break;
+    case UDM_CRYPTO_AV:
+        udm_crypto_av_generate(&job->av);
+        break;
+    default:
+        ogs_fatal("Unknown crypto job [%d]", job->type);
+        ogs_assert_if_reached();
+    }
+}
+
+static int job_done(ogs_worker_job_t *h)
+{
+    int rv;
+    udm_event_t *e = NULL;
+
+    e = udm_event_new(UDM_EVENT_CRYPTO_DONE);
+    ogs_assert(e);
+    e->crypto_job = (udm_crypto_job_t *)h;
+
+    rv = ogs_queue_push(ogs_app()->queue, e);
+    if (rv != OGS_OK) {
+        /* The UDM is terminating. udm_crypto_close() frees the job */
+        ogs_error("ogs_queue_push() failed:%d", (int)rv);
+        ogs_event_free(e);
+        return OGS_ERROR;
+    }
+
+    ogs_pollset_notify(ogs_app()->pollset);
+
+    return OGS_OK;
+}
+
+static void job_free(ogs_worker_job_t *h)
+{
+    udm_crypto_job_free((udm_crypto_job_t *)h);
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef UDM_CRYPTO_WORKER_H
+#define UDM_CRYPTO_WORKER_H
+
+#include "context.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    UDM_CRYPTO_SUCI = 0,
+    UDM_CRYPTO_AV,
+
+    MAX_NUM_OF_UDM_CRYPTO,
+
+} udm_crypto_type_e;
+
+typedef struct udm_crypto_av_s {
+    /* Input */
+    uint8_t k[OGS_KEY_LEN];
+    uint8_t opc[OGS_KEY_LEN];
+    uint8_t amf[OGS_AMF_LEN];
+    uint8_t sqn[OGS_SQN_LEN];
+    uint8_t rand[OGS_RAND_LEN];
+    char *serving_network_name;
+
+    /* Output */
+    uint8_t autn[OGS_AUTN_LEN];
+    uint8_t xres_star[OGS_MAX_RES_LEN];
+    uint8_t kausf[OGS_SHA256_DIGEST_SIZE];
+} udm_crypto_av_t;
+
+/*
+ * A job is owned by the UDM thread except while a worker runs it.
+ * The worker only touches the fields copied into the job,
+ * never the UE context or the stream.
+ */
+typedef struct udm_crypto_job_s {
+    ogs_worker_job_t h;
+
+    udm_crypto_type_e type;
+
+    ogs_sbi_stream_t *stream;
+    ogs_sbi_request_t *request;
+    udm_ue_t *udm_ue;
+
+    struct {
+        char *suci;
+        char *supi;
+    } suci;
+    udm_crypto_av_t av;
+} udm_crypto_job_t;
+
+int udm_crypto_open(void);
+void udm_crypto_close(void);
+bool udm_crypto_is_enabled(void);
+
+udm_crypto_job_t *udm_crypto_job_new(
+        udm_crypto_type_e type, ogs_sbi_stream_t *stream);
+void udm_crypto_job_free(udm_crypto_job_t *job);
+
+bool udm_crypto_submit(udm_crypto_job_t *job);
+void udm_crypto_complete(udm_crypto_job_t *job);
+
+bool udm_crypto_suci_is_concealed(const char *suci);
+void udm_crypto_av_generate(udm_crypto_av_t *av);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDM_CRYPTO_WORKER_H */
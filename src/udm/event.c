@@ -49,6 +49,9 @@ const char *udm_event_get_name(udm_event_t *e)
     case OGS_EVENT_SBI_TIMER:
         return OGS_EVENT_NAME_SBI_TIMER;
 
+    case UDM_EVENT_CRYPTO_DONE:
+        return "UDM_EVENT_CRYPTO_DONE";
+
     default: 
        break;
     }
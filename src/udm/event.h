@@ -27,11 +27,22 @@ extern "C" {
 #endif
 
 typedef struct udm_ue_s udm_ue_t;
+typedef struct udm_crypto_job_s udm_crypto_job_t;
+
+typedef enum {
+    UDM_EVENT_BASE = OGS_MAX_NUM_OF_PROTO_EVENT,
+
+    UDM_EVENT_CRYPTO_DONE,
+
+    MAX_NUM_OF_UDM_EVENT,
+
+} udm_event_e;
 
 typedef struct udm_event_s {
     ogs_event_t h;
 
     udm_ue_t *udm_ue;
+    udm_crypto_job_t *crypto_job;
 } udm_event_t;
 
 OGS_STATIC_ASSERT(OGS_EVENT_SIZE >= sizeof(udm_event_t));
@@ -18,6 +18,8 @@
  */
 
 #include "sbi-path.h"
+#include "crypto-worker.h"
+#include "metrics.h"
 
 static ogs_thread_t *thread;
 static void udm_main(void *data);
@@ -27,12 +29,17 @@ int udm_initialize(void)
 {
     int rv;
 
+    udm_metrics_init();
+
     ogs_sbi_context_init(OpenAPI_nf_type_UDM);
     udm_context_init();
 
     rv = ogs_sbi_context_parse_config("udm", "nrf", "scp");
     if (rv != OGS_OK) return rv;
 
+    rv = ogs_metrics_context_parse_config("udm");
+    if (rv != OGS_OK) return rv;
+
     rv = udm_context_parse_config();
     if (rv != OGS_OK) return rv;
 
@@ -40,6 +47,11 @@ int udm_initialize(void)
             ogs_app()->logger.domain, ogs_app()->logger.level);
     if (rv != OGS_OK) return rv;
 
+    ogs_metrics_context_open(ogs_metrics_self());
+
+    rv = udm_crypto_open();
+    if (rv != OGS_OK) return rv;
+
     rv = udm_sbi_open();
     if (rv != OGS_OK) return rv;
 
@@ -81,10 +93,16 @@ void udm_terminate(void)
     ogs_thread_destroy(thread);
     ogs_timer_delete(t_termination_holding);
 
+    udm_crypto_close();
+
     udm_sbi_close();
 
+    ogs_metrics_context_close(ogs_metrics_self());
+
     udm_context_final();
     ogs_sbi_context_final();
+
+    udm_metrics_final();
 }
 
 static void udm_main(void *data)
@@ -0,0 +1,143 @@
+#include "ogs-app.h"
+#include "context.h"
+
+#include "metrics.h"
+
+typedef struct udm_metrics_spec_def_s {
+    unsigned int type;
+    const char *name;
+    const char *description;
+    int initial_val;
+    unsigned int num_labels;
+    const char **labels;
+    ogs_metrics_histogram_params_t histogram_params;
+} udm_metrics_spec_def_t;
+
+static int udm_metrics_init_inst(ogs_metrics_inst_t **inst,
+        ogs_metrics_spec_t **specs, unsigned int len,
+        unsigned int num_labels, const char **labels)
+{
+    unsigned int i;
+    for (i = 0; i < len; i++)
+        inst[i] = ogs_metrics_inst_new(specs[i], num_labels, labels);
+    return OGS_OK;
+}
+
+static int udm_metrics_init_spec(ogs_metrics_context_t *ctx,
+        ogs_metrics_spec_t **dst, udm_metrics_spec_def_t *src, unsigned int len)
+{
+    unsigned int i;
+    for (i = 0; i < len; i++) {
+        dst[i] = ogs_metrics_spec_new(ctx, src[i].type,
+                src[i].name, src[i].description,
+                src[i].initial_val, src[i].num_labels, src[i].labels,
+                &src[i].histogram_params);
+    }
+
+    return OGS_OK;
+}
+
+/* GLOBAL */
+ogs_metrics_spec_t *udm_metrics_spec_global[_UDM_METR_GLOB_MAX];
+ogs_metrics_inst_t *udm_metrics_inst_global[_UDM_METR_GLOB_MAX];
+udm_metrics_spec_def_t udm_metrics_spec_def_global[_UDM_METR_GLOB_MAX] = {
+/* Global Counters: */
+[UDM_METR_GLOB_CTR_CRYPTO_REJECTED] = {
+    .type = OGS_METRICS_METRIC_TYPE_COUNTER,
+    .name = "udm_crypto_rejected",
+    .description = "Crypto jobs rejected because the queue was full",
+},
+/* Global Gauges: */
+[UDM_METR_GLOB_GAUGE_CRYPTO_QUEUE_DEPTH] = {
+    .type = OGS_METRICS_METRIC_TYPE_GAUGE,
+    .name = "udm_crypto_queue_depth",
+    .description = "Crypto jobs submitted and not yet completed",
+},
+};
+
+/* BY CRYPTO OPERATION */
+const char *labels_crypto[] = {
+    "op"
+};
+
+static const char *crypto_name[MAX_NUM_OF_UDM_CRYPTO] = {
+    [UDM_CRYPTO_SUCI] = "suci",
+    [UDM_CRYPTO_AV] = "av",
+};
+
+ogs_metrics_spec_t *udm_metrics_spec_by_crypto[_UDM_METR_BY_CRYPTO_MAX];
+udm_metrics_spec_def_t udm_metrics_spec_def_by_crypto
+    [_UDM_METR_BY_CRYPTO_MAX] = {
+/* Histograms: */
+[UDM_METR_HIST_CRYPTO_WAIT_TIME] = {
+    .type = OGS_METRICS_METRIC_TYPE_HISTOGRAM,
+    .name = "udm_crypto_wait_time_usec",
+    .description = "Time a crypto job spent queued before a worker ran it",
+    .num_labels = OGS_ARRAY_SIZE(labels_crypto),
+    .labels = labels_crypto,
+    .histogram_params = {
+        .type = OGS_METRICS_HISTOGRAM_BUCKET_TYPE_EXPONENTIAL,
+        .count = 10,
+        .exp.start = 10,
+        .exp.factor = 2,
+    },
+},
+[UDM_METR_HIST_CRYPTO_EXEC_TIME] = {
+    .type = OGS_METRICS_METRIC_TYPE_HISTOGRAM,
+    .name = "udm_crypto_exec_time_usec",
+    .description = "Time a worker spent running a crypto job",
+    .num_labels = OGS_ARRAY_SIZE(labels_crypto),
+    .labels = labels_crypto,
+    .histogram_params = {
+        .type = OGS_METRICS_HISTOGRAM_BUCKET_TYPE_EXPONENTIAL,
+        .count = 10,
+        .exp.start = 10,
+        .exp.factor = 2,
+    },
+},
+};
+
+static ogs_metrics_inst_t *udm_metrics_inst_by_crypto
+    [_UDM_METR_BY_CRYPTO_MAX][MAX_NUM_OF_UDM_CRYPTO];
+
+void udm_metrics_inst_by_crypto_add(
+    udm_crypto_type_e type, udm_metric_type_by_crypto_t t, int val)
+{
+    ogs_metrics_inst_t **metrics = NULL;
+
+    ogs_assert(t < _UDM_METR_BY_CRYPTO_MAX);
+    ogs_assert(type < MAX_NUM_OF_UDM_CRYPTO);
+
+    metrics = &udm_metrics_inst_by_crypto[t][type];
+    if (!*metrics) {
+        *metrics = ogs_metrics_inst_new(udm_metrics_spec_by_crypto[t],
+                udm_metrics_spec_def_by_crypto[t].num_labels,
+                (const char *[]){ crypto_name[type] });
+        ogs_assert(*metrics);
+    }
+
+    ogs_metrics_inst_add(*metrics, val);
+}
+
+void udm_metrics_init(void)
+{
+    ogs_metrics_context_t *ctx = ogs_metrics_self();
+    ogs_metrics_context_init();
+
+    udm_metrics_init_spec(ctx, udm_metrics_spec_global,
+            udm_metrics_spec_def_global, _UDM_METR_GLOB_MAX);
+    udm_metrics_init_spec(ctx, udm_metrics_spec_by_crypto,
+            udm_metrics_spec_def_by_crypto, _UDM_METR_BY_CRYPTO_MAX);
+
+    udm_metrics_init_inst(udm_metrics_inst_global, udm_metrics_spec_global,
+            _UDM_METR_GLOB_MAX, 0, NULL);
+}
+
+void udm_metrics_final(void)
+{
+    /* Instances are free'd by ogs_metrics_context_final() */
+    memset(udm_metrics_inst_global, 0, sizeof(udm_metrics_inst_global));
+    memset(udm_metrics_inst_by_crypto, 0, sizeof(udm_metrics_inst_by_crypto));
+
+    ogs_metrics_context_final();
+}
@@ -0,0 +1,45 @@
+#ifndef UDM_METRICS_H
+#define UDM_METRICS_H
+
+#include "ogs-metrics.h"
+
+#include "crypto-worker.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* GLOBAL */
+typedef enum udm_metric_type_global_s {
+    UDM_METR_GLOB_CTR_CRYPTO_REJECTED = 0,
+    UDM_METR_GLOB_GAUGE_CRYPTO_QUEUE_DEPTH,
+    _UDM_METR_GLOB_MAX,
+} udm_metric_type_global_t;
+extern ogs_metrics_inst_t *udm_metrics_inst_global[_UDM_METR_GLOB_MAX];
+
+static inline void udm_metrics_inst_global_set(
+        udm_metric_type_global_t t, int val)
+{ ogs_metrics_inst_set(udm_metrics_inst_global[t], val); }
+static inline void udm_metrics_inst_global_inc(udm_metric_type_global_t t)
+{ ogs_metrics_inst_inc(udm_metrics_inst_global[t]); }
+static inline void udm_metrics_inst_global_dec(udm_metric_type_global_t t)
+{ ogs_metrics_inst_dec(udm_metrics_inst_global[t]); }
+
+/* BY CRYPTO OPERATION */
+typedef enum udm_metric_type_by_crypto_s {
+    UDM_METR_HIST_CRYPTO_WAIT_TIME = 0,
+    UDM_METR_HIST_CRYPTO_EXEC_TIME,
+    _UDM_METR_BY_CRYPTO_MAX,
+} udm_metric_type_by_crypto_t;
+
+void udm_metrics_inst_by_crypto_add(
+    udm_crypto_type_e type, udm_metric_type_by_crypto_t t, int val);
+
+void udm_metrics_init(void);
+void udm_metrics_final(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDM_METRICS_H */
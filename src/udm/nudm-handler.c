@@ -174,6 +174,58 @@ bool udm_nudm_ueau_handle_get(
     return true;
 }
 
+bool udm_nudm_ueau_send_auth_info_result(
+    udm_ue_t *udm_ue, ogs_sbi_stream_t *stream, udm_crypto_av_t *av)
+{
+    ogs_sbi_message_t sendmsg;
+    ogs_sbi_response_t *response = NULL;
+
+    char rand_string[OGS_KEYSTRLEN(OGS_RAND_LEN)];
+    char autn_string[OGS_KEYSTRLEN(OGS_AUTN_LEN)];
+    char kausf_string[OGS_KEYSTRLEN(OGS_SHA256_DIGEST_SIZE)];
+    char xres_star_string[OGS_KEYSTRLEN(OGS_MAX_RES_LEN)];
+
+    OpenAPI_authentication_info_result_t AuthenticationInfoResult;
+    OpenAPI_authentication_vector_t AuthenticationVector;
+
+    ogs_assert(udm_ue);
+    ogs_assert(stream);
+    ogs_assert(av);
+
+    memset(&AuthenticationInfoResult, 0, sizeof(AuthenticationInfoResult));
+
+    AuthenticationInfoResult.supi = udm_ue->supi;
+    AuthenticationInfoResult.auth_type = udm_ue->auth_type;
+
+    memset(&AuthenticationVector, 0, sizeof(AuthenticationVector));
+    AuthenticationVector.av_type = OpenAPI_av_type_5G_HE_AKA;
+
+    ogs_hex_to_ascii(av->rand, sizeof(av->rand),
+            rand_string, sizeof(rand_string));
+    AuthenticationVector.rand = rand_string;
+    ogs_hex_to_ascii(av->xres_star, sizeof(av->xres_star),
+            xres_star_string, sizeof(xres_star_string));
+    AuthenticationVector.xres_star = xres_star_string;
+    ogs_hex_to_ascii(av->autn, sizeof(av->autn),
+            autn_string, sizeof(autn_string));
+    AuthenticationVector.autn = autn_string;
+    ogs_hex_to_ascii(av->kausf, sizeof(av->kausf),
+            kausf_string, sizeof(kausf_string));
+    AuthenticationVector.kausf = kausf_string;
+
+    AuthenticationInfoResult.authentication_vector = &AuthenticationVector;
+
+    memset(&sendmsg, 0, sizeof(sendmsg));
+
+    ogs_assert(AuthenticationInfoResult.auth_type);
+    sendmsg.AuthenticationInfoResult = &AuthenticationInfoResult;
+
+    response = ogs_sbi_build_response(&sendmsg, OGS_SBI_HTTP_STATUS_OK);
+    ogs_assert(response);
+
+    return ogs_sbi_server_send_response(stream, response);
+}
+
 bool udm_nudm_ueau_handle_result_confirmation_inform(
     udm_ue_t *udm_ue, ogs_sbi_stream_t *stream, ogs_sbi_message_t *message)
 {
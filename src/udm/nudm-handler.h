@@ -21,6 +21,7 @@
 #define UDM_NUDM_HANDLER_H
 
 #include "context.h"
+#include "crypto-worker.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,6 +29,8 @@ extern "C" {
 
 bool udm_nudm_ueau_handle_get(
     udm_ue_t *udm_ue, ogs_sbi_stream_t *stream, ogs_sbi_message_t *recvmsg);
+bool udm_nudm_ueau_send_auth_info_result(
+    udm_ue_t *udm_ue, ogs_sbi_stream_t *stream, udm_crypto_av_t *av);
 bool udm_nudm_ueau_handle_result_confirmation_inform(
     udm_ue_t *udm_ue, ogs_sbi_stream_t *stream, ogs_sbi_message_t *message);
 
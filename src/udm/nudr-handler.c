@@ -18,6 +18,7 @@
  */
 
 #include "nudr-handler.h"
+#include "nudm-handler.h"
 
 bool udm_nudr_dr_handle_subscription_authentication(
     udm_ue_t *udm_ue, ogs_sbi_stream_t *stream, ogs_sbi_message_t *recvmsg)
@@ -29,6 +30,8 @@ bool udm_nudr_dr_handle_subscription_authentication(
     ogs_sbi_header_t header;
     ogs_sbi_response_t *response = NULL;
 
+    udm_crypto_av_t av;
+
 #if 0
 #if 0
     const char *tmp[1] = { "de8ca9df474091fe4e9263c5daa907e9" };
@@ -48,23 +51,7 @@ bool udm_nudr_dr_handle_subscription_authentication(
     static int step = 0;
 #endif
 
-    uint8_t autn[OGS_AUTN_LEN];
-    uint8_t ik[OGS_KEY_LEN];
-    uint8_t ck[OGS_KEY_LEN];
-    uint8_t ak[OGS_AK_LEN];
-    uint8_t xres[OGS_MAX_RES_LEN];
-    size_t xres_len = 8;
-    uint8_t xres_star[OGS_MAX_RES_LEN];
-    uint8_t kausf[OGS_SHA256_DIGEST_SIZE];
-
-    char rand_string[OGS_KEYSTRLEN(OGS_RAND_LEN)];
-    char autn_string[OGS_KEYSTRLEN(OGS_AUTN_LEN)];
-    char kausf_string[OGS_KEYSTRLEN(OGS_SHA256_DIGEST_SIZE)];
-    char xres_star_string[OGS_KEYSTRLEN(OGS_MAX_RES_LEN)];
-
     OpenAPI_authentication_subscription_t *AuthenticationSubscription = NULL;
-    OpenAPI_authentication_info_result_t AuthenticationInfoResult;
-    OpenAPI_authentication_vector_t AuthenticationVector;
 
     ogs_assert(udm_ue);
     ogs_assert(stream);
@@ -194,12 +181,6 @@ bool udm_nudr_dr_handle_subscription_authentication(
                 return false;
             }
 
-            memset(&AuthenticationInfoResult,
-                    0, sizeof(AuthenticationInfoResult));
-
-            AuthenticationInfoResult.supi = udm_ue->supi;
-            AuthenticationInfoResult.auth_type = udm_ue->auth_type;
-
             ogs_random(udm_ue->rand, OGS_RAND_LEN);
 #if 0
             OGS_HEX(tmp[step], strlen(tmp[step]), udm_ue->rand);
@@ -209,50 +190,45 @@ bool udm_nudr_dr_handle_subscription_authentication(
 #endif
 #endif
 
-            milenage_generate(udm_ue->opc, udm_ue->amf, udm_ue->k, udm_ue->sqn,
-                    udm_ue->rand, autn, ik, ck, ak, xres, &xres_len);
-
             ogs_assert(udm_ue->serving_network_name);
 
-            /* TS33.501 Annex A.2 : Kausf derviation function */
-            ogs_kdf_kausf(
-                    ck, ik,
-                    udm_ue->serving_network_name, autn,
-                    kausf);
-
-            /* TS33.501 Annex A.4 : RES* and XRES* derivation function */
-            ogs_kdf_xres_star(
-                    ck, ik,
-                    udm_ue->serving_network_name, udm_ue->rand, xres, xres_len,
-                    xres_star);
-
-            memset(&AuthenticationVector, 0, sizeof(AuthenticationVector));
-            AuthenticationVector.av_type = OpenAPI_av_type_5G_HE_AKA;
-
-            ogs_hex_to_ascii(udm_ue->rand, sizeof(udm_ue->rand),
-                    rand_string, sizeof(rand_string));
-            AuthenticationVector.rand = rand_string;
-            ogs_hex_to_ascii(xres_star, sizeof(xres_star),
-                    xres_star_string, sizeof(xres_star_string));
-            AuthenticationVector.xres_star = xres_star_string;
-            ogs_hex_to_ascii(autn, sizeof(autn),
-                    autn_string, sizeof(autn_string));
-            AuthenticationVector.autn = autn_string;
-            ogs_hex_to_ascii(kausf, sizeof(kausf),
-                    kausf_string, sizeof(kausf_string));
-            AuthenticationVector.kausf = kausf_string;
-
-            AuthenticationInfoResult.authentication_vector =
-                &AuthenticationVector;
-
-            memset(&sendmsg, 0, sizeof(sendmsg));
+            memset(&av, 0, sizeof(av));
+            memcpy(av.k, udm_ue->k, sizeof(av.k));
+            memcpy(av.opc, udm_ue->opc, sizeof(av.opc));
+            memcpy(av.amf, udm_ue->amf, sizeof(av.amf));
+            memcpy(av.sqn, udm_ue->sqn, sizeof(av.sqn));
+            memcpy(av.rand, udm_ue->rand, sizeof(av.rand));
+            av.serving_network_name = udm_ue->serving_network_name;
+
+            if (udm_crypto_is_enabled()) {
+                udm_crypto_job_t *job = NULL;
+
+                job = udm_crypto_job_new(UDM_CRYPTO_AV, stream);
+                ogs_assert(job);
+
+                job->udm_ue = udm_ue;
+                memcpy(&job->av, &av, sizeof(av));
+                job->av.serving_network_name =
+                    ogs_strdup(udm_ue->serving_network_name);
+                ogs_assert(job->av.serving_network_name);
+
+                if (udm_crypto_submit(job) == false) {
+                    udm_crypto_job_free(job);
+                    ogs_assert(true ==
+                        ogs_sbi_server_send_error(stream,
+                            OGS_SBI_HTTP_STATUS_SERVICE_UNAVAILABLE,
+                            recvmsg, "Crypto queue full", udm_ue->suci));
+                    return false;
+                }
+
+                /* The response is sent on UDM_EVENT_CRYPTO_DONE */
+                break;
+            }
 
-            ogs_assert(AuthenticationInfoResult.auth_type);
-            sendmsg.AuthenticationInfoResult = &AuthenticationInfoResult;
+            udm_crypto_av_generate(&av);
 
-            response = ogs_sbi_build_response(&sendmsg, OGS_SBI_HTTP_STATUS_OK);
-            ogs_assert(response);
-            ogs_assert(true == ogs_sbi_server_send_response(stream, response));
+            ogs_assert(true ==
+                udm_nudm_ueau_send_auth_info_result(udm_ue, stream, &av));
 
             break;
 
@@ -19,6 +19,7 @@
 
 #include "sbi-path.h"
 #include "nnrf-handler.h"
+#include "nudm-handler.h"
 
 void udm_state_initial(ogs_fsm_t *s, udm_event_t *e)
 {
@@ -49,6 +50,8 @@ void udm_state_operational(ogs_fsm_t *s, udm_event_t *e)
     ogs_sbi_xact_t *sbi_xact = NULL;
 
     udm_ue_t *udm_ue = NULL;
+    udm_crypto_job_t *crypto_job = NULL;
+    udm_event_t sbi_e;
 
     udm_sm_debug(e);
 
@@ -160,9 +163,40 @@ void udm_state_operational(ogs_fsm_t *s, udm_event_t *e)
             if (!udm_ue) {
                 udm_ue = udm_ue_find_by_suci_or_supi(
                         message.h.resource.component[0]);
+                if (!udm_ue && udm_crypto_is_enabled() &&
+                    udm_crypto_suci_is_concealed(
+                        message.h.resource.component[0])) {
+                    crypto_job = udm_crypto_job_new(UDM_CRYPTO_SUCI, stream);
+                    ogs_assert(crypto_job);
+
+                    crypto_job->request = request;
+                    crypto_job->suci.suci =
+                        ogs_strdup(message.h.resource.component[0]);
+                    ogs_assert(crypto_job->suci.suci);
+
+                    if (udm_crypto_submit(crypto_job) == false) {
+                        udm_crypto_job_free(crypto_job);
+                        ogs_assert(true ==
+                            ogs_sbi_server_send_error(stream,
+                                OGS_SBI_HTTP_STATUS_SERVICE_UNAVAILABLE,
+                                &message, "Crypto queue full",
+                                message.h.resource.component[0]));
+                    }
+
+                    /* The request is handled again on UDM_EVENT_CRYPTO_DONE */
+                    break;
+                }
                 if (!udm_ue) {
                     udm_ue = udm_ue_add(message.h.resource.component[0]);
-                    ogs_assert(udm_ue);
+                    if (!udm_ue) {
+                        /* Same answer as UDM_EVENT_CRYPTO_DONE */
+                        ogs_assert(true ==
+                            ogs_sbi_server_send_error(stream,
+                                OGS_SBI_HTTP_STATUS_FORBIDDEN, &message,
+                                "Cannot de-conceal SUCI",
+                                message.h.resource.component[0]));
+                        break;
+                    }
                 }
             }
 
@@ -376,6 +410,62 @@ void udm_state_operational(ogs_fsm_t *s, udm_event_t *e)
         ogs_sbi_response_free(response);
         break;
 
+    case UDM_EVENT_CRYPTO_DONE:
+        crypto_job = e->crypto_job;
+        ogs_assert(crypto_job);
+
+        udm_crypto_complete(crypto_job);
+
+        switch (crypto_job->type) {
+        case UDM_CRYPTO_SUCI:
+            if (!crypto_job->suci.supi) {
+                ogs_error("[%s] Cannot de-conceal SUCI",
+                        crypto_job->suci.suci);
+                ogs_assert(true ==
+                    ogs_sbi_server_send_error(crypto_job->stream,
+                        OGS_SBI_HTTP_STATUS_FORBIDDEN, NULL,
+                        "Cannot de-conceal SUCI", crypto_job->suci.suci));
+                break;
+            }
+
+            if (!udm_ue_find_by_suci(crypto_job->suci.suci)) {
+                udm_ue = udm_ue_add_with_supi(
+                        crypto_job->suci.suci, crypto_job->suci.supi);
+                ogs_assert(udm_ue);
+            }
+
+            /* Handle the request again now that the UE context exists */
+            memset(&sbi_e, 0, sizeof(sbi_e));
+            sbi_e.h.id = OGS_EVENT_SBI_SERVER;
+            sbi_e.h.sbi.request = crypto_job->request;
+            sbi_e.h.sbi.data = crypto_job->stream;
+            ogs_fsm_dispatch(s, &sbi_e);
+            break;
+
+        case UDM_CRYPTO_AV:
+            udm_ue = udm_ue_cycle(crypto_job->udm_ue);
+            if (!udm_ue) {
+                ogs_error("UE(udm_ue) Context has already been removed");
+                ogs_assert(true ==
+                    ogs_sbi_server_send_error(crypto_job->stream,
+                        OGS_SBI_HTTP_STATUS_NOT_FOUND, NULL,
+                        "UE context removed", NULL));
+                break;
+            }
+
+            ogs_assert(true ==
+                udm_nudm_ueau_send_auth_info_result(
+                    udm_ue, crypto_job->stream, &crypto_job->av));
+            break;
+
+        default:
+            ogs_error("Unknown crypto job [%d]", crypto_job->type);
+            ogs_assert_if_reached();
+        }
+
+        udm_crypto_job_free(crypto_job);
+        break;
+
     case OGS_EVENT_SBI_TIMER:
         ogs_assert(e);
 
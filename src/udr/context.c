@@ -23,8 +23,12 @@ static udr_context_t self;
 
 int __udr_log_domain;
 
+static OGS_POOL(av_pool_pool, udr_av_pool_t);
+
 static int context_initialized = 0;
 
+static void av_pool_remove(udr_av_pool_t *av_pool);
+
 void udr_context_init(void)
 {
     ogs_assert(context_initialized == 0);
@@ -35,13 +39,29 @@ void udr_context_init(void)
     ogs_log_install_domain(&__ogs_dbi_domain, "dbi", ogs_core()->log.level);
     ogs_log_install_domain(&__udr_log_domain, "udr", ogs_core()->log.level);
 
+    ogs_pool_init(&av_pool_pool, ogs_app()->max.ue);
+
+    ogs_list_init(&self.av_pool_list);
+    self.av_pool_hash = ogs_hash_make();
+    ogs_assert(self.av_pool_hash);
+
     context_initialized = 1;
 }
 
 void udr_context_final(void)
 {
+    udr_av_pool_t *av_pool = NULL, *next_av_pool = NULL;
+
     ogs_assert(context_initialized == 1);
 
+    ogs_list_for_each_safe(&self.av_pool_list, next_av_pool, av_pool)
+        av_pool_remove(av_pool);
+
+    ogs_assert(self.av_pool_hash);
+    ogs_hash_destroy(self.av_pool_hash);
+
+    ogs_pool_final(&av_pool_pool);
+
     context_initialized = 0;
 }
 
@@ -52,11 +72,27 @@ udr_context_t *udr_self(void)
 
 static int udr_context_prepare(void)
 {
+    self.av_pool.lifetime = ogs_time_from_sec(300);
+    self.db.queue = ogs_app()->max.ue;
+
     return OGS_OK;
 }
 
 static int udr_context_validation(void)
 {
+    if (self.av_pool.size < 0) {
+        ogs_error("Invalid av_pool.size [%d]", self.av_pool.size);
+        return OGS_ERROR;
+    }
+    if (self.db.worker < 0) {
+        ogs_error("Invalid db.worker [%d]", self.db.worker);
+        return OGS_ERROR;
+    }
+    if (self.db.queue <= 0) {
+        ogs_error("Invalid db.queue [%d]", self.db.queue);
+        return OGS_ERROR;
+    }
+
     return OGS_OK;
 }
 
@@ -88,6 +124,40 @@ int udr_context_parse_config(void)
                     /* handle config in sbi library */
                 } else if (!strcmp(udr_key, "discovery")) {
                     /* handle config in sbi library */
+                } else if (!strcmp(udr_key, "metrics")) {
+                    /* handle config in metrics library */
+                } else if (!strcmp(udr_key, "av_pool")) {
+                    ogs_yaml_iter_t av_pool_iter;
+                    ogs_yaml_iter_recurse(&udr_iter, &av_pool_iter);
+                    while (ogs_yaml_iter_next(&av_pool_iter)) {
+                        const char *av_pool_key =
+                            ogs_yaml_iter_key(&av_pool_iter);
+                        ogs_assert(av_pool_key);
+                        if (!strcmp(av_pool_key, "size")) {
+                            const char *v = ogs_yaml_iter_value(&av_pool_iter);
+                            if (v) self.av_pool.size = atoi(v);
+                        } else if (!strcmp(av_pool_key, "lifetime")) {
+                            const char *v = ogs_yaml_iter_value(&av_pool_iter);
+                            if (v) self.av_pool.lifetime =
+                                ogs_time_from_sec(atoi(v));
+                        } else
+                            ogs_warn("unknown key `%s`", av_pool_key);
+                    }
+                } else if (!strcmp(udr_key, "db")) {
+                    ogs_yaml_iter_t db_iter;
+                    ogs_yaml_iter_recurse(&udr_iter, &db_iter);
+                    while (ogs_yaml_iter_next(&db_iter)) {
+                        const char *db_key = ogs_yaml_iter_key(&db_iter);
+                        ogs_assert(db_key);
+                        if (!strcmp(db_key, "worker")) {
+                            const char *v = ogs_yaml_iter_value(&db_iter);
+                            if (v) self.db.worker = atoi(v);
+                        } else if (!strcmp(db_key, "queue")) {
+                            const char *v = ogs_yaml_iter_value(&db_iter);
+                            if (v) self.db.queue = atoi(v);
+                        } else
+                            ogs_warn("unknown key `%s`", db_key);
+                    }
                 } else
                     ogs_warn("unknown key `%s`", udr_key);
             }
@@ -99,3 +169,257 @@ int udr_context_parse_config(void)
 
     return OGS_OK;
 }
+
+static udr_av_pool_t *av_pool_add(char *supi)
+{
+    udr_av_pool_t *av_pool = NULL;
+
+    ogs_assert(supi);
+
+    /* Make room by dropping the least recently active subscriber */
+    ogs_pool_alloc(&av_pool_pool, &av_pool);
+    if (!av_pool) {
+        av_pool = ogs_list_first(&self.av_pool_list);
+        ogs_assert(av_pool);
+        av_pool_remove(av_pool);
+
+        ogs_pool_alloc(&av_pool_pool, &av_pool);
+    }
+    ogs_assert(av_pool);
+    memset(av_pool, 0, sizeof *av_pool);
+
+    av_pool->supi = ogs_strdup(supi);
+    ogs_assert(av_pool->supi);
+
+    ogs_hash_set(self.av_pool_hash,
+            av_pool->supi, strlen(av_pool->supi), av_pool);
+    ogs_list_add(&self.av_pool_list, av_pool);
+
+    return av_pool;
+}
+
+static void av_pool_remove(udr_av_pool_t *av_pool)
+{
+    ogs_assert(av_pool);
+
+    ogs_list_remove(&self.av_pool_list, av_pool);
+    ogs_hash_set(self.av_pool_hash,
+            av_pool->supi, strlen(av_pool->supi), NULL);
+
+    ogs_free(av_pool->supi);
+
+    ogs_pool_free(&av_pool_pool, av_pool);
+}
+
+static udr_av_pool_t *av_pool_find(char *supi)
+{
+    udr_av_pool_t *av_pool = NULL;
+
+    ogs_assert(supi);
+
+    av_pool = ogs_hash_get(self.av_pool_hash, supi, strlen(supi));
+    if (!av_pool)
+        return NULL;
+
+    if (ogs_get_monotonic_time() >= av_pool->expires) {
+        av_pool_remove(av_pool);
+        return NULL;
+    }
+
+    ogs_list_remove(&self.av_pool_list, av_pool);
+    ogs_list_add(&self.av_pool_list, av_pool);
+
+    return av_pool;
+}
+
+/*
+ * A pooled subscriber is served from memory until its reserved window of
+ * SQNs is used up. Windows are reserved with ogs_dbi_reserve_sqn(),
+ * on a DB worker when one is configured.
+ */
+bool udr_av_pool_lookup(char *supi, ogs_dbi_auth_info_t *auth_info)
+{
+    udr_av_pool_t *av_pool = NULL;
+
+    ogs_assert(supi);
+    ogs_assert(auth_info);
+
+    if (self.av_pool.size == 0)
+        return false;
+
+    av_pool = av_pool_find(supi);
+    if (!av_pool)
+        return false;
+
+    memcpy(auth_info, &av_pool->auth_info, sizeof(*auth_info));
+
+    return true;
+}
+
+/*
+ * 'generation' is udr_self()->av_pool_generation when the SQNs were
+ * reserved. If a subscriber was dropped in the meantime, the window may
+ * have been read before the change and is not kept.
+ */
+void udr_av_pool_add(char *supi,
+        ogs_dbi_auth_info_t *auth_info, uint64_t generation)
+{
+    udr_av_pool_t *av_pool = NULL;
+
+    ogs_assert(supi);
+    ogs_assert(auth_info);
+    ogs_assert(self.av_pool.size);
+
+    if (generation != self.av_pool_generation) {
+        ogs_debug("[%s] Subscriber changed while reading", supi);
+        return;
+    }
+
+    /* Two misses in flight for the same subscriber: the later one wins */
+    av_pool = ogs_hash_get(self.av_pool_hash, supi, strlen(supi));
+    if (av_pool)
+        av_pool_remove(av_pool);
+
+    av_pool = av_pool_add(supi);
+    ogs_assert(av_pool);
+
+    memcpy(&av_pool->auth_info, auth_info, sizeof(*auth_info));
+    av_pool->limit = (auth_info->sqn +
+            32 * (uint64_t)self.av_pool.size) & OGS_MAX_SQN;
+    av_pool->expires = ogs_get_monotonic_time() + self.av_pool.lifetime;
+}
+
+/*
+ * Returns false if the subscriber is not pooled and the SQN has to be
+ * incremented in MongoDB. A used-up window is dropped: the stored SQN
+ * already points past it, and the next lookup reserves a new one.
+ */
+bool udr_av_pool_increment_sqn(char *supi)
+{
+    udr_av_pool_t *av_pool = NULL;
+
+    ogs_assert(supi);
+
+    av_pool = av_pool_find(supi);
+    if (!av_pool)
+        return false;
+
+    av_pool->auth_info.sqn = (av_pool->auth_info.sqn + 32) & OGS_MAX_SQN;
+    if (av_pool->auth_info.sqn == av_pool->limit)
+        av_pool_remove(av_pool);
+
+    return true;
+}
+
+void udr_av_pool_remove(char *supi)
+{
+    udr_av_pool_t *av_pool = NULL;
+
+    ogs_assert(supi);
+
+    self.av_pool_generation++;
+
+    av_pool = ogs_hash_get(self.av_pool_hash, supi, strlen(supi));
+    if (av_pool)
+        av_pool_remove(av_pool);
+}
+
+void udr_av_pool_remove_all(void)
+{
+    udr_av_pool_t *av_pool = NULL, *next_av_pool = NULL;
+
+    self.av_pool_generation++;
+
+    ogs_list_for_each_safe(&self.av_pool_list, next_av_pool, av_pool)
+        av_pool_remove(av_pool);
+}
+
+/*
+ * Drops a pooled subscriber whose authentication subscription was
+ * edited. The UDR's own SQN updates come back as 'security.sqn' only
+ * and keep the subscriber. An event that does not name the subscriber,
+ * such as a delete, drops every subscriber.
+ */
+int udr_handle_change_event(const bson_t *document)
+{
+    bson_iter_t iter, child1_iter, child2_iter;
+
+    char *utf8 = NULL;
+    uint32_t length = 0;
+
+    bool security_flag = false;
+
+    char *imsi_bcd = NULL;
+    char *supi = NULL;
+
+    ogs_assert(document);
+
+    if (bson_iter_init_find(&iter, document, "fullDocument") &&
+            BSON_ITER_HOLDS_DOCUMENT(&iter)) {
+        bson_iter_recurse(&iter, &child1_iter);
+        while (bson_iter_next(&child1_iter)) {
+            const char *key = bson_iter_key(&child1_iter);
+            if (!strcmp(key, "imsi") &&
+                    BSON_ITER_HOLDS_UTF8(&child1_iter)) {
+                utf8 = (char *)bson_iter_utf8(&child1_iter, &length);
+                imsi_bcd = ogs_strndup(utf8,
+                    ogs_min(length, OGS_MAX_IMSI_BCD_LEN) + 1);
+                ogs_assert(imsi_bcd);
+            }
+        }
+    }
+
+    if (!imsi_bcd) {
+        ogs_warn("No 'imsi' field in this document, drop all subscribers");
+        udr_av_pool_remove_all();
+        return OGS_OK;
+    }
+
+    if (bson_iter_init_find(&iter, document, "updateDescription")) {
+        bson_iter_recurse(&iter, &child1_iter);
+        while (bson_iter_next(&child1_iter)) {
+            const char *key = bson_iter_key(&child1_iter);
+            if ((!strcmp(key, "updatedFields") ||
+                 !strcmp(key, "removedFields")) &&
+                    (BSON_ITER_HOLDS_DOCUMENT(&child1_iter) ||
+                     BSON_ITER_HOLDS_ARRAY(&child1_iter))) {
+                /* removedFields lists the names as values */
+                bool removed = !strcmp(key, "removedFields");
+
+                bson_iter_recurse(&child1_iter, &child2_iter);
+                while (bson_iter_next(&child2_iter)) {
+                    const char *child2_key = NULL;
+
+                    if (!removed)
+                        child2_key = bson_iter_key(&child2_iter);
+                    else if (BSON_ITER_HOLDS_UTF8(&child2_iter))
+                        child2_key = bson_iter_utf8(&child2_iter, NULL);
+                    else
+                        continue;
+
+                    if (!strncmp(child2_key, "security", strlen("security")) &&
+                            strcmp(child2_key, "security.sqn")) {
+                        security_flag = true;
+                    }
+                }
+            }
+        }
+    } else {
+        /* insert or replace */
+        security_flag = true;
+    }
+
+    if (security_flag) {
+        supi = ogs_msprintf("%s-%s", OGS_ID_SUPI_TYPE_IMSI, imsi_bcd);
+        ogs_assert(supi);
+
+        ogs_debug("[%s] Authentication subscription changed", supi);
+        udr_av_pool_remove(supi);
+
+        ogs_free(supi);
+    }
+
+    ogs_free(imsi_bcd);
+
+    return OGS_OK;
+}
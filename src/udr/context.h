@@ -36,14 +36,49 @@ extern int __udr_log_domain;
 #define OGS_LOG_DOMAIN __udr_log_domain
 
 typedef struct udr_context_s {
+    struct {
+        int size;               /* SQNs reserved per subscriber */
+        ogs_time_t lifetime;    /* Read the subscriber again after */
+    } av_pool;
+
+    ogs_list_t av_pool_list;    /* LRU order, most recent last */
+    ogs_hash_t *av_pool_hash;   /* hash table (SUPI) */
+    uint64_t av_pool_generation; /* Changes when a subscriber is dropped */
+
+    struct {
+        int worker;             /* 0: run on the event loop */
+        int queue;              /* Maximum number of pending jobs */
+    } db;
 } udr_context_t;
 
+/*
+ * Authentication subscription of a recently active SUPI, answered from
+ * memory. The database holds the SQN past the reserved window.
+ */
+typedef struct udr_av_pool_s {
+    ogs_lnode_t lnode;
+
+    char *supi;
+    ogs_dbi_auth_info_t auth_info;
+    uint64_t limit;
+    ogs_time_t expires;
+} udr_av_pool_t;
+
 void udr_context_init(void);
 void udr_context_final(void);
 udr_context_t *udr_self(void);
 
 int udr_context_parse_config(void);
 
+bool udr_av_pool_lookup(char *supi, ogs_dbi_auth_info_t *auth_info);
+void udr_av_pool_add(char *supi,
+        ogs_dbi_auth_info_t *auth_info, uint64_t generation);
+bool udr_av_pool_increment_sqn(char *supi);
+void udr_av_pool_remove(char *supi);
+void udr_av_pool_remove_all(void);
+
+int udr_handle_change_event(const bson_t *document);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "db-worker.h"
+#include "metrics.h"
+
+/*
+ * MongoDB queries run on a bounded pool of worker threads so that a slow
+ * query does not hold up other SBI traffic. Each worker borrows its own
+ * client from the lib/dbi pool. Results come back to the UDR thread
+ * as UDR_EVENT_DB_DONE.
+ */
+static ogs_worker_pool_t *pool;
+
+static void job_run(ogs_worker_job_t *h);
+static int job_done(ogs_worker_job_t *h);
+static void job_free(ogs_worker_job_t *h);
+
+int udr_db_open(void)
+{
+    if (udr_self()->db.worker == 0)
+        return OGS_OK;
+
+    pool = ogs_worker_pool_create(udr_self()->db.worker, udr_self()->db.queue,
+            job_run, job_done, job_free);
+    if (!pool) {
+        ogs_error("ogs_worker_pool_create() failed");
+        return OGS_ERROR;
+    }
+
+    ogs_info("db with %d worker(s) [queue:%d]",
+            udr_self()->db.worker, udr_self()->db.queue);
+
+    return OGS_OK;
+}
+
+void udr_db_close(void)
+{
+    if (pool) {
+        ogs_worker_pool_destroy(pool);
+        pool = NULL;
+    }
+}
+
+bool udr_db_is_enabled(void)
+{
+    return pool != NULL;
+}
+
+udr_db_job_t *udr_db_job_new(udr_db_type_e type, ogs_sbi_stream_t *stream,
+        ogs_sbi_request_t *request, char *supi)
+{
+    udr_db_job_t *job = NULL;
+
+    ogs_assert(type < MAX_NUM_OF_UDR_DB);
+    ogs_assert(stream);
+    ogs_assert(request);
+    ogs_assert(supi);
+
+    job = ogs_calloc(1, sizeof(*job));
+    if (!job) {
+        ogs_error("ogs_calloc() failed");
+        return NULL;
+    }
+
+    job->type = type;
+    job->stream = stream;
+    job->request = request;
+
+    job->supi = ogs_strdup(supi);
+    if (!job->supi) {
+        ogs_error("ogs_strdup() failed");
+        ogs_free(job);
+        return NULL;
+    }
+
+    return job;
+}
+
+void udr_db_job_free(udr_db_job_t *job)
+{
+    ogs_assert(job);
+
+    ogs_subscription_data_free(&job->subscription_data);
+
+    if (job->supi)
+        ogs_free(job->supi);
+
+    ogs_free(job);
+}
+
+bool udr_db_submit(udr_db_job_t *job)
+{
+    ogs_assert(job);
+    ogs_assert(pool);
+
+    if (ogs_worker_pool_submit(pool, &job->h) != OGS_OK) {
+        ogs_warn("DB queue full [%d]", udr_self()->db.queue);
+        udr_metrics_inst_global_inc(UDR_METR_GLOB_CTR_DB_REJECTED);
+        return false;
+    }
+
+    udr_metrics_inst_global_inc(UDR_METR_GLOB_GAUGE_DB_QUEUE_DEPTH);
+
+    return true;
+}
+
+void udr_db_complete(udr_db_job_t *job)
+{
+    ogs_assert(job);
+    ogs_assert(pool);
+
+    ogs_worker_pool_complete(pool, &job->h);
+
+    udr_metrics_inst_global_dec(UDR_METR_GLOB_GAUGE_DB_QUEUE_DEPTH);
+    udr_metrics_inst_by_db_add(job->type,
+            UDR_METR_HIST_DB_WAIT_TIME, job->h.started - job->h.submitted);
+    udr_metrics_inst_by_db_add(job->type,
+            UDR_METR_HIST_DB_EXEC_TIME, job->h.finished - job->h.started);
+}
+
+void udr_db_run(udr_db_job_t *job)
+{
+    ogs_assert(job);
+    ogs_assert(job->supi);
+
+    switch (job->type) {
+    case UDR_DB_AUTH_INFO:
+        if (job->count)
+            job->rv = ogs_dbi_reserve_sqn(
+                    job->supi, job->count, &job->auth_info);
+        else
+            job->rv = ogs_dbi_auth_info(job->supi, &job->auth_info);
+        break;
+    case UDR_DB_UPDATE_SQN:
+        job->rv = ogs_dbi_update_sqn(job->supi, job->sqn);
+        break;
+    case UDR_DB_INCREMENT_SQN:
+        job->rv = ogs_dbi_increment_sqn(job->supi);
+        break;
+    case UDR_DB_SUBSCRIPTION_DATA:
+        job->rv = ogs_dbi_subscription_data(
+                job->supi, &job->subscription_data);
+        break;
+    default:
+        ogs_fatal("Unknown DB job [%d]", job->type);
+        ogs_assert_if_reached();
+    }
+}
+
+static void job_run(ogs_worker_job_t *h)
+{
+    udr_db_run((udr_db_job_t *)h);
+}
+
+static int job_done(ogs_worker_job_t *h)
+{
+    int rv;
+    udr_event_t *e = NULL;
+
+    e = udr_event_new(UDR_EVENT_DB_DONE);
+    ogs_assert(e);
+    e->db_job = (udr_db_job_t *)h;
+
+    rv = ogs_queue_push(ogs_app()->queue, e);
+    if (rv != OGS_OK) {
+        /* The UDR is terminating. udr_db_close() frees the job */
+        ogs_error("ogs_queue_push() failed:%d", (int)rv);
+        ogs_event_free(e);
+        return OGS_ERROR;
+    }
+
+    ogs_pollset_notify(ogs_app()->pollset);
+
+    return OGS_OK;
+}
+
+static void job_free(ogs_worker_job_t *h)
+{
+    udr_db_job_free((udr_db_job_t *)h);
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef UDR_DB_WORKER_H
+#define UDR_DB_WORKER_H
+
+#include "context.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    UDR_DB_AUTH_INFO = 0,
+    UDR_DB_UPDATE_SQN,
+    UDR_DB_INCREMENT_SQN,
+    UDR_DB_SUBSCRIPTION_DATA,
+
+    MAX_NUM_OF_UDR_DB,
+
+} udr_db_type_e;
+
+/*
+ * A job is owned by the UDR thread except while a worker runs it.
+ * The worker only touches the fields copied into the job,
+ * never the AV pool or the stream.
+ */
+typedef struct udr_db_job_s {
+    ogs_worker_job_t h;
+
+    udr_db_type_e type;
+
+    ogs_sbi_stream_t *stream;
+    ogs_sbi_request_t *request;
+
+    /* Input */
+    char *supi;
+    int count;                  /* UDR_DB_AUTH_INFO: SQNs to reserve */
+    uint64_t generation;        /* UDR_DB_AUTH_INFO: AV pool generation */
+    uint64_t sqn;               /* UDR_DB_UPDATE_SQN: SQN to store */
+
+    /* Output */
+    int rv;
+    ogs_dbi_auth_info_t auth_info;
+    ogs_subscription_data_t subscription_data;
+} udr_db_job_t;
+
+int udr_db_open(void);
+void udr_db_close(void);
+bool udr_db_is_enabled(void);
+
+udr_db_job_t *udr_db_job_new(udr_db_type_e type, ogs_sbi_stream_t *stream,
+        ogs_sbi_request_t *request, char *supi);
+void udr_db_job_free(udr_db_job_t *job);
+
+bool udr_db_submit(udr_db_job_t *job);
+void udr_db_complete(udr_db_job_t *job);
+
+void udr_db_run(udr_db_job_t *job);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDR_DB_WORKER_H */
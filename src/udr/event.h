@@ -26,8 +26,21 @@
 extern "C" {
 #endif
 
+typedef struct udr_db_job_s udr_db_job_t;
+
+typedef enum {
+    UDR_EVENT_BASE = OGS_MAX_NUM_OF_PROTO_EVENT,
+
+    UDR_EVENT_DB_DONE,
+
+    MAX_NUM_OF_UDR_EVENT,
+
+} udr_event_e;
+
 typedef struct udr_event_s {
     ogs_event_t h;
+
+    udr_db_job_t *db_job;
 } udr_event_t;
 
 OGS_STATIC_ASSERT(OGS_EVENT_SIZE >= sizeof(udr_event_t));
@@ -18,6 +18,8 @@
  */
 
 #include "sbi-path.h"
+#include "db-worker.h"
+#include "metrics.h"
 
 static ogs_thread_t *thread;
 static void udr_main(void *data);
@@ -27,12 +29,17 @@ int udr_initialize(void)
 {
     int rv;
 
+    udr_metrics_init();
+
     ogs_sbi_context_init(OpenAPI_nf_type_UDR);
     udr_context_init();
 
     rv = ogs_sbi_context_parse_config("udr", "nrf", "scp");
     if (rv != OGS_OK) return rv;
 
+    rv = ogs_metrics_context_parse_config("udr");
+    if (rv != OGS_OK) return rv;
+
     rv = udr_context_parse_config();
     if (rv != OGS_OK) return rv;
 
@@ -40,9 +47,14 @@ int udr_initialize(void)
             ogs_app()->logger.domain, ogs_app()->logger.level);
     if (rv != OGS_OK) return rv;
 
+    ogs_metrics_context_open(ogs_metrics_self());
+
     rv = ogs_dbi_init(ogs_app()->db_uri);
     if (rv != OGS_OK) return rv;
 
+    rv = udr_db_open();
+    if (rv != OGS_OK) return rv;
+
     rv = udr_sbi_open();
     if (rv != OGS_OK) return rv;
 
@@ -84,12 +96,18 @@ void udr_terminate(void)
     ogs_thread_destroy(thread);
     ogs_timer_delete(t_termination_holding);
 
+    udr_db_close();
+
     udr_sbi_close();
 
+    ogs_metrics_context_close(ogs_metrics_self());
+
     ogs_dbi_final();
 
     udr_context_final();
     ogs_sbi_context_final();
+
+    udr_metrics_final();
 }
 
 static void udr_main(void *data)
@@ -0,0 +1,145 @@
+#include "ogs-app.h"
+#include "context.h"
+
+#include "metrics.h"
+
+typedef struct udr_metrics_spec_def_s {
+    unsigned int type;
+    const char *name;
+    const char *description;
+    int initial_val;
+    unsigned int num_labels;
+    const char **labels;
+    ogs_metrics_histogram_params_t histogram_params;
+} udr_metrics_spec_def_t;
+
+static int udr_metrics_init_inst(ogs_metrics_inst_t **inst,
+        ogs_metrics_spec_t **specs, unsigned int len,
+        unsigned int num_labels, const char **labels)
+{
+    unsigned int i;
+    for (i = 0; i < len; i++)
+        inst[i] = ogs_metrics_inst_new(specs[i], num_labels, labels);
+    return OGS_OK;
+}
+
+static int udr_metrics_init_spec(ogs_metrics_context_t *ctx,
+        ogs_metrics_spec_t **dst, udr_metrics_spec_def_t *src, unsigned int len)
+{
+    unsigned int i;
+    for (i = 0; i < len; i++) {
+        dst[i] = ogs_metrics_spec_new(ctx, src[i].type,
+                src[i].name, src[i].description,
+                src[i].initial_val, src[i].num_labels, src[i].labels,
+                &src[i].histogram_params);
+    }
+
+    return OGS_OK;
+}
+
+/* GLOBAL */
+ogs_metrics_spec_t *udr_metrics_spec_global[_UDR_METR_GLOB_MAX];
+ogs_metrics_inst_t *udr_metrics_inst_global[_UDR_METR_GLOB_MAX];
+udr_metrics_spec_def_t udr_metrics_spec_def_global[_UDR_METR_GLOB_MAX] = {
+/* Global Counters: */
+[UDR_METR_GLOB_CTR_DB_REJECTED] = {
+    .type = OGS_METRICS_METRIC_TYPE_COUNTER,
+    .name = "udr_db_rejected",
+    .description = "DB jobs rejected because the queue was full",
+},
+/* Global Gauges: */
+[UDR_METR_GLOB_GAUGE_DB_QUEUE_DEPTH] = {
+    .type = OGS_METRICS_METRIC_TYPE_GAUGE,
+    .name = "udr_db_queue_depth",
+    .description = "DB jobs submitted and not yet completed",
+},
+};
+
+/* BY DB OPERATION */
+const char *labels_db[] = {
+    "op"
+};
+
+static const char *db_name[MAX_NUM_OF_UDR_DB] = {
+    [UDR_DB_AUTH_INFO] = "auth_info",
+    [UDR_DB_UPDATE_SQN] = "update_sqn",
+    [UDR_DB_INCREMENT_SQN] = "increment_sqn",
+    [UDR_DB_SUBSCRIPTION_DATA] = "subscription_data",
+};
+
+ogs_metrics_spec_t *udr_metrics_spec_by_db[_UDR_METR_BY_DB_MAX];
+udr_metrics_spec_def_t udr_metrics_spec_def_by_db
+    [_UDR_METR_BY_DB_MAX] = {
+/* Histograms: */
+[UDR_METR_HIST_DB_WAIT_TIME] = {
+    .type = OGS_METRICS_METRIC_TYPE_HISTOGRAM,
+    .name = "udr_db_wait_time_usec",
+    .description = "Time a DB job spent queued before a worker ran it",
+    .num_labels = OGS_ARRAY_SIZE(labels_db),
+    .labels = labels_db,
+    .histogram_params = {
+        .type = OGS_METRICS_HISTOGRAM_BUCKET_TYPE_EXPONENTIAL,
+        .count = 12,
+        .exp.start = 100,
+        .exp.factor = 2,
+    },
+},
+[UDR_METR_HIST_DB_EXEC_TIME] = {
+    .type = OGS_METRICS_METRIC_TYPE_HISTOGRAM,
+    .name = "udr_db_exec_time_usec",
+    .description = "Time a worker spent running a DB job",
+    .num_labels = OGS_ARRAY_SIZE(labels_db),
+    .labels = labels_db,
+    .histogram_params = {
+        .type = OGS_METRICS_HISTOGRAM_BUCKET_TYPE_EXPONENTIAL,
+        .count = 12,
+        .exp.start = 100,
+        .exp.factor = 2,
+    },
+},
+};
+
+static ogs_metrics_inst_t *udr_metrics_inst_by_db
+    [_UDR_METR_BY_DB_MAX][MAX_NUM_OF_UDR_DB];
+
+void udr_metrics_inst_by_db_add(
+    udr_db_type_e type, udr_metric_type_by_db_t t, int val)
+{
+    ogs_metrics_inst_t **metrics = NULL;
+
+    ogs_assert(t < _UDR_METR_BY_DB_MAX);
+    ogs_assert(type < MAX_NUM_OF_UDR_DB);
+
+    metrics = &udr_metrics_inst_by_db[t][type];
+    if (!*metrics) {
+        *metrics = ogs_metrics_inst_new(udr_metrics_spec_by_db[t],
+                udr_metrics_spec_def_by_db[t].num_labels,
+                (const char *[]){ db_name[type] });
+        ogs_assert(*metrics);
+    }
+
+    ogs_metrics_inst_add(*metrics, val);
+}
+
+void udr_metrics_init(void)
+{
+    ogs_metrics_context_t *ctx = ogs_metrics_self();
+    ogs_metrics_context_init();
+
+    udr_metrics_init_spec(ctx, udr_metrics_spec_global,
+            udr_metrics_spec_def_global, _UDR_METR_GLOB_MAX);
+    udr_metrics_init_spec(ctx, udr_metrics_spec_by_db,
+            udr_metrics_spec_def_by_db, _UDR_METR_BY_DB_MAX);
+
+    udr_metrics_init_inst(udr_metrics_inst_global, udr_metrics_spec_global,
+            _UDR_METR_GLOB_MAX, 0, NULL);
+}
+
+void udr_metrics_final(void)
+{
+    /* Instances are free'd by ogs_metrics_context_final() */
+    memset(udr_metrics_inst_global, 0, sizeof(udr_metrics_inst_global));
+    memset(udr_metrics_inst_by_db, 0, sizeof(udr_metrics_inst_by_db));
+
+    ogs_metrics_context_final();
+}
@@ -0,0 +1,45 @@
+#ifndef UDR_METRICS_H
+#define UDR_METRICS_H
+
+#include "ogs-metrics.h"
+
+#include "db-worker.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* GLOBAL */
+typedef enum udr_metric_type_global_s {
+    UDR_METR_GLOB_CTR_DB_REJECTED = 0,
+    UDR_METR_GLOB_GAUGE_DB_QUEUE_DEPTH,
+    _UDR_METR_GLOB_MAX,
+} udr_metric_type_global_t;
+extern ogs_metrics_inst_t *udr_metrics_inst_global[_UDR_METR_GLOB_MAX];
+
+static inline void udr_metrics_inst_global_set(
+        udr_metric_type_global_t t, int val)
+{ ogs_metrics_inst_set(udr_metrics_inst_global[t], val); }
+static inline void udr_metrics_inst_global_inc(udr_metric_type_global_t t)
+{ ogs_metrics_inst_inc(udr_metrics_inst_global[t]); }
+static inline void udr_metrics_inst_global_dec(udr_metric_type_global_t t)
+{ ogs_metrics_inst_dec(udr_metrics_inst_global[t]); }
+
+/* BY DB OPERATION */
+typedef enum udr_metric_type_by_db_s {
+    UDR_METR_HIST_DB_WAIT_TIME = 0,
+    UDR_METR_HIST_DB_EXEC_TIME,
+    _UDR_METR_BY_DB_MAX,
+} udr_metric_type_by_db_t;
+
+void udr_metrics_inst_by_db_add(
+    udr_db_type_e type, udr_metric_type_by_db_t t, int val);
+
+void udr_metrics_init(void);
+void udr_metrics_final(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDR_METRICS_H */
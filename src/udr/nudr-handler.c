@@ -20,11 +20,48 @@
 #include "sbi-path.h"
 #include "nudr-handler.h"
 
-bool udr_nudr_dr_handle_subscription_authentication(
-        ogs_sbi_stream_t *stream, ogs_sbi_message_t *recvmsg)
+typedef bool (*db_handler_f)(ogs_sbi_stream_t *stream,
+        ogs_sbi_request_t *request, ogs_sbi_message_t *recvmsg,
+        udr_db_job_t *db_job);
+
+/*
+ * Queue the query for a DB worker, or run it right away when there is
+ * none. Either way the handler is called again with the finished job.
+ */
+static bool db_dispatch(udr_db_job_t *db_job,
+        ogs_sbi_message_t *recvmsg, db_handler_f handler)
 {
-    int rv;
+    bool rc;
+
+    ogs_assert(db_job);
+    ogs_assert(recvmsg);
+    ogs_assert(handler);
+
+    if (udr_db_is_enabled()) {
+        if (udr_db_submit(db_job) == false) {
+            ogs_assert(true ==
+                ogs_sbi_server_send_error(db_job->stream,
+                    OGS_SBI_HTTP_STATUS_SERVICE_UNAVAILABLE,
+                    recvmsg, "DB queue full", db_job->supi));
+            udr_db_job_free(db_job);
+            return false;
+        }
 
+        /* The request is handled again on UDR_EVENT_DB_DONE */
+        return true;
+    }
+
+    udr_db_run(db_job);
+    rc = handler(db_job->stream, db_job->request, recvmsg, db_job);
+    udr_db_job_free(db_job);
+
+    return rc;
+}
+
+bool udr_nudr_dr_handle_subscription_authentication(
+        ogs_sbi_stream_t *stream, ogs_sbi_request_t *request,
+        ogs_sbi_message_t *recvmsg, udr_db_job_t *db_job)
+{
     ogs_sbi_message_t sendmsg;
     ogs_sbi_response_t *response = NULL;
     ogs_dbi_auth_info_t auth_info;
@@ -63,13 +100,51 @@ bool udr_nudr_dr_handle_subscription_authentication(
         return false;
     }
 
-    rv = ogs_dbi_auth_info(supi, &auth_info);
-    if (rv != OGS_OK) {
-        ogs_warn("[%s] Cannot find SUPI in DB", supi);
-        ogs_assert(true ==
-            ogs_sbi_server_send_error(stream, OGS_SBI_HTTP_STATUS_NOT_FOUND,
-                recvmsg, "Cannot find SUPI Type", supi));
-        return false;
+    if (db_job && db_job->type != UDR_DB_AUTH_INFO) {
+        /* SQN update of a PATCH or an authentication event is done */
+        if (db_job->rv != OGS_OK) {
+            ogs_fatal("[%s] Cannot update SQN", supi);
+            ogs_assert(true ==
+                ogs_sbi_server_send_error(stream,
+                    OGS_SBI_HTTP_STATUS_INTERNAL_SERVER_ERROR,
+                    recvmsg, "Cannot update SQN", supi));
+            return false;
+        }
+
+        memset(&sendmsg, 0, sizeof(sendmsg));
+
+        response = ogs_sbi_build_response(
+                &sendmsg, OGS_SBI_HTTP_STATUS_NO_CONTENT);
+        ogs_assert(response);
+        ogs_assert(true == ogs_sbi_server_send_response(stream, response));
+
+        return true;
+    }
+
+    if (db_job) {
+        if (db_job->rv != OGS_OK) {
+            ogs_warn("[%s] Cannot find SUPI in DB", supi);
+            ogs_assert(true ==
+                ogs_sbi_server_send_error(stream,
+                    OGS_SBI_HTTP_STATUS_NOT_FOUND,
+                    recvmsg, "Cannot find SUPI Type", supi));
+            return false;
+        }
+
+        memcpy(&auth_info, &db_job->auth_info, sizeof(auth_info));
+        if (db_job->count)
+            udr_av_pool_add(supi, &auth_info, db_job->generation);
+
+    } else if (udr_av_pool_lookup(supi, &auth_info) == false) {
+        db_job = udr_db_job_new(UDR_DB_AUTH_INFO, stream, request, supi);
+        ogs_assert(db_job);
+
+        /* With the AV pool, reserve a window of SQNs at the same time */
+        db_job->count = udr_self()->av_pool.size;
+        db_job->generation = udr_self()->av_pool_generation;
+
+        return db_dispatch(db_job, recvmsg,
+                udr_nudr_dr_handle_subscription_authentication);
     }
 
     SWITCH(recvmsg->h.resource.component[3])
@@ -154,34 +229,17 @@ bool udr_nudr_dr_handle_subscription_authentication(
                     sqn_ms, sizeof(sqn_ms));
             sqn = ogs_buffer_to_uint64(sqn_ms, OGS_SQN_LEN);
 
-            rv = ogs_dbi_update_sqn(supi, sqn);
-            if (rv != OGS_OK) {
-                ogs_fatal("[%s] Cannot update SQN", supi);
-                ogs_assert(true ==
-                    ogs_sbi_server_send_error(stream,
-                        OGS_SBI_HTTP_STATUS_INTERNAL_SERVER_ERROR,
-                        recvmsg, "Cannot update SQN", supi));
-                return false;
-            }
-
-            rv = ogs_dbi_increment_sqn(supi);
-            if (rv != OGS_OK) {
-                ogs_fatal("[%s] Cannot increment SQN", supi);
-                ogs_assert(true ==
-                    ogs_sbi_server_send_error(stream,
-                        OGS_SBI_HTTP_STATUS_INTERNAL_SERVER_ERROR,
-                        recvmsg, "Cannot increment SQN", supi));
-                return false;
-            }
+            /* Re-synchronisation overrides the reserved window */
+            udr_av_pool_remove(supi);
 
-            memset(&sendmsg, 0, sizeof(sendmsg));
+            /* Store SQN and advance it past the next vector in one update */
+            db_job = udr_db_job_new(UDR_DB_UPDATE_SQN, stream, request, supi);
+            ogs_assert(db_job);
 
-            response = ogs_sbi_build_response(
-                    &sendmsg, OGS_SBI_HTTP_STATUS_NO_CONTENT);
-            ogs_assert(response);
-            ogs_assert(true == ogs_sbi_server_send_response(stream, response));
+            db_job->sqn = (sqn + 32) & OGS_MAX_SQN;
 
-            return true;
+            return db_dispatch(db_job, recvmsg,
+                    udr_nudr_dr_handle_subscription_authentication);
 
         DEFAULT
             ogs_error("Invalid HTTP method [%s]", recvmsg->h.method);
@@ -209,17 +267,17 @@ bool udr_nudr_dr_handle_subscription_authentication(
                 return false;
             }
 
-            memset(&sendmsg, 0, sizeof(sendmsg));
-            rv = ogs_dbi_increment_sqn(supi);
-            if (rv != OGS_OK) {
-                ogs_fatal("[%s] Cannot increment SQN", supi);
-                ogs_assert(true ==
-                    ogs_sbi_server_send_error(stream,
-                        OGS_SBI_HTTP_STATUS_INTERNAL_SERVER_ERROR,
-                        recvmsg, "Cannot increment SQN", supi));
-                return false;
+            if (udr_av_pool_increment_sqn(supi) == false) {
+                db_job = udr_db_job_new(
+                        UDR_DB_INCREMENT_SQN, stream, request, supi);
+                ogs_assert(db_job);
+
+                return db_dispatch(db_job, recvmsg,
+                        udr_nudr_dr_handle_subscription_authentication);
             }
 
+            memset(&sendmsg, 0, sizeof(sendmsg));
+
             response = ogs_sbi_build_response(
                     &sendmsg, OGS_SBI_HTTP_STATUS_NO_CONTENT);
             ogs_assert(response);
@@ -350,7 +408,8 @@ bool udr_nudr_dr_handle_subscription_context(
 }
 
 bool udr_nudr_dr_handle_subscription_provisioned(
-        ogs_sbi_stream_t *stream, ogs_sbi_message_t *recvmsg)
+        ogs_sbi_stream_t *stream, ogs_sbi_request_t *request,
+        ogs_sbi_message_t *recvmsg, udr_db_job_t *db_job)
 {
     int rv, status = 0;
     char *strerror = NULL;
@@ -381,7 +440,21 @@ bool udr_nudr_dr_handle_subscription_provisioned(
         goto cleanup;
     }
 
-    rv = ogs_dbi_subscription_data(supi, &subscription_data);
+    if (!db_job) {
+        db_job = udr_db_job_new(
+                UDR_DB_SUBSCRIPTION_DATA, stream, request, supi);
+        ogs_assert(db_job);
+
+        return db_dispatch(db_job, recvmsg,
+                udr_nudr_dr_handle_subscription_provisioned);
+    }
+
+    /* Take over the subscription data read by the job */
+    rv = db_job->rv;
+    memcpy(&subscription_data, &db_job->subscription_data,
+            sizeof(subscription_data));
+    memset(&db_job->subscription_data, 0, sizeof(subscription_data));
+
     if (rv != OGS_OK) {
         strerror = ogs_msprintf("[%s] Cannot find SUPI in DB", supi);
         status = OGS_SBI_HTTP_STATUS_NOT_FOUND;
@@ -985,7 +1058,8 @@ cleanup:
 }
 
 bool udr_nudr_dr_handle_policy_data(
-        ogs_sbi_stream_t *stream, ogs_sbi_message_t *recvmsg)
+        ogs_sbi_stream_t *stream, ogs_sbi_request_t *request,
+        ogs_sbi_message_t *recvmsg, udr_db_job_t *db_job)
 {
     int rv, i, status = 0;
     char *strerror = NULL;
@@ -1022,7 +1096,21 @@ bool udr_nudr_dr_handle_policy_data(
         CASE(OGS_SBI_HTTP_METHOD_GET)
             OpenAPI_lnode_t *node = NULL, *node2 = NULL;
 
-            rv = ogs_dbi_subscription_data(supi, &subscription_data);
+            if (!db_job) {
+                db_job = udr_db_job_new(
+                        UDR_DB_SUBSCRIPTION_DATA, stream, request, supi);
+                ogs_assert(db_job);
+
+                return db_dispatch(db_job, recvmsg,
+                        udr_nudr_dr_handle_policy_data);
+            }
+
+            /* Take over the subscription data read by the job */
+            rv = db_job->rv;
+            memcpy(&subscription_data, &db_job->subscription_data,
+                    sizeof(subscription_data));
+            memset(&db_job->subscription_data, 0, sizeof(subscription_data));
+
             if (rv != OGS_OK) {
                 strerror = ogs_msprintf("[%s] Cannot find SUPI in DB", supi);
                 status = OGS_SBI_HTTP_STATUS_NOT_FOUND;
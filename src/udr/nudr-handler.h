@@ -20,21 +20,24 @@
 #ifndef UDR_NUDR_HANDLER_H
 #define UDR_NUDR_HANDLER_H
 
-#include "context.h"
+#include "db-worker.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 bool udr_nudr_dr_handle_subscription_authentication(
-        ogs_sbi_stream_t *stream, ogs_sbi_message_t *message);
+        ogs_sbi_stream_t *stream, ogs_sbi_request_t *request,
+        ogs_sbi_message_t *message, udr_db_job_t *db_job);
 bool udr_nudr_dr_handle_subscription_context(
         ogs_sbi_stream_t *stream, ogs_sbi_message_t *message);
 bool udr_nudr_dr_handle_subscription_provisioned(
-        ogs_sbi_stream_t *stream, ogs_sbi_message_t *message);
+        ogs_sbi_stream_t *stream, ogs_sbi_request_t *request,
+        ogs_sbi_message_t *message, udr_db_job_t *db_job);
 
 bool udr_nudr_dr_handle_policy_data(
-        ogs_sbi_stream_t *stream, ogs_sbi_message_t *message);
+        ogs_sbi_stream_t *stream, ogs_sbi_request_t *request,
+        ogs_sbi_message_t *message, udr_db_job_t *db_job);
 
 #ifdef __cplusplus
 }
@@ -19,6 +19,11 @@
 
 #include "sbi-path.h"
 #include "nudr-handler.h"
+#include "db-worker.h"
+
+#define DB_POLLING_TIME ogs_time_from_msec(100)
+
+static ogs_timer_t *t_db_polling = NULL;
 
 void udr_state_initial(ogs_fsm_t *s, udr_event_t *e)
 {
@@ -26,6 +31,16 @@ void udr_state_initial(ogs_fsm_t *s, udr_event_t *e)
 
     ogs_assert(s);
 
+    /* Edits of pooled subscribers are learned from the change stream */
+    if (ogs_app()->use_mongodb_change_stream && udr_self()->av_pool.size) {
+        ogs_dbi_collection_watch_init();
+
+        t_db_polling = ogs_timer_add(ogs_app()->timer_mgr,
+                ogs_timer_dbi_poll_change_stream, 0);
+        ogs_assert(t_db_polling);
+        ogs_timer_start(t_db_polling, DB_POLLING_TIME);
+    }
+
     OGS_FSM_TRAN(s, &udr_state_operational);
 }
 
@@ -33,6 +48,9 @@ void udr_state_final(ogs_fsm_t *s, udr_event_t *e)
 {
     udr_sm_debug(e);
 
+    if (t_db_polling)
+        ogs_timer_delete(t_db_polling);
+
     ogs_assert(s);
 }
 
@@ -48,6 +66,9 @@ void udr_state_operational(ogs_fsm_t *s, udr_event_t *e)
     ogs_sbi_response_t *response = NULL;
     ogs_sbi_message_t message;
 
+    udr_db_job_t *db_job = NULL;
+    udr_event_t sbi_e;
+
     udr_sm_debug(e);
 
     ogs_assert(s);
@@ -57,6 +78,33 @@ void udr_state_operational(ogs_fsm_t *s, udr_event_t *e)
         break;
 
     case OGS_FSM_EXIT_SIG:
+        if (t_db_polling) {
+            ogs_timer_stop(t_db_polling);
+        }
+        break;
+
+    case OGS_EVENT_DBI_POLL_TIMER:
+        ogs_assert(e);
+
+        switch(e->h.timer_id) {
+        case OGS_TIMER_DBI_POLL_CHANGE_STREAM:
+            ogs_dbi_poll_change_stream();
+            ogs_timer_start(t_db_polling, DB_POLLING_TIME);
+            break;
+
+        default:
+            ogs_error("Unknown timer[%s:%d]",
+                    ogs_timer_get_name(e->h.timer_id), e->h.timer_id);
+        }
+        break;
+
+    case OGS_EVENT_DBI_MESSAGE:
+        ogs_assert(e);
+
+        ogs_assert(e->h.dbi.document);
+        udr_handle_change_event(e->h.dbi.document);
+
+        bson_destroy(e->h.dbi.document);
         break;
 
     case OGS_EVENT_SBI_SERVER:
@@ -123,7 +171,7 @@ void udr_state_operational(ogs_fsm_t *s, udr_event_t *e)
                 SWITCH(message.h.resource.component[2])
                 CASE(OGS_SBI_RESOURCE_NAME_AUTHENTICATION_DATA)
                     udr_nudr_dr_handle_subscription_authentication(
-                            stream, &message);
+                            stream, request, &message, e->db_job);
                     break;
 
                 CASE(OGS_SBI_RESOURCE_NAME_CONTEXT_DATA)
@@ -136,7 +184,7 @@ void udr_state_operational(ogs_fsm_t *s, udr_event_t *e)
                         SWITCH(message.h.method)
                         CASE(OGS_SBI_HTTP_METHOD_GET)
                             udr_nudr_dr_handle_subscription_provisioned(
-                                    stream, &message);
+                                    stream, request, &message, e->db_job);
                             break;
                         DEFAULT
                             ogs_error("Invalid HTTP method [%s]",
@@ -161,7 +209,8 @@ void udr_state_operational(ogs_fsm_t *s, udr_event_t *e)
                 break;
 
             CASE(OGS_SBI_RESOURCE_NAME_POLICY_DATA)
-                udr_nudr_dr_handle_policy_data(stream, &message);
+                udr_nudr_dr_handle_policy_data(
+                        stream, request, &message, e->db_job);
                 break;
 
             DEFAULT
@@ -187,6 +236,23 @@ void udr_state_operational(ogs_fsm_t *s, udr_event_t *e)
         ogs_sbi_message_free(&message);
         break;
 
+    case UDR_EVENT_DB_DONE:
+        db_job = e->db_job;
+        ogs_assert(db_job);
+
+        udr_db_complete(db_job);
+
+        /* Handle the request again with the result of the query */
+        memset(&sbi_e, 0, sizeof(sbi_e));
+        sbi_e.h.id = OGS_EVENT_SBI_SERVER;
+        sbi_e.h.sbi.request = db_job->request;
+        sbi_e.h.sbi.data = db_job->stream;
+        sbi_e.db_job = db_job;
+        ogs_fsm_dispatch(s, &sbi_e);
+
+        udr_db_job_free(db_job);
+        break;
+
     case OGS_EVENT_SBI_CLIENT:
         ogs_assert(e);
 
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "test-amf.h"
+
+abts_suite *test_amf_context(abts_suite *suite);
+abts_suite *test_amf_paging(abts_suite *suite);
+abts_suite *test_amf_snapshot(abts_suite *suite);
+abts_suite *test_amf_admission(abts_suite *suite);
+
+const struct testlist {
+    abts_suite *(*func)(abts_suite *suite);
+} alltests[] = {
+    {test_amf_context},
+    {test_amf_paging},
+    {test_amf_snapshot},
+    {test_amf_admission},
+    {NULL},
+};
+
+static void terminate(void)
+{
+    test_amf_final();
+    ogs_app_terminate();
+}
+
+int main(int argc, const char *const argv[])
+{
+    int rv, i;
+    const char *argv_out[argc+7]; /* "-e", "-c" and "-m" may be added */
+
+    abts_suite *suite = NULL;
+
+    rv = abts_main(argc, argv, argv_out);
+    if (rv != OGS_OK) return rv;
+
+    rv = ogs_app_initialize(NULL, DEFAULT_CONFIG_FILENAME, argv_out);
+    if (rv != OGS_OK) return rv;
+
+    rv = test_amf_init();
+    if (rv != OGS_OK) return rv;
+
+    atexit(terminate);
+
+    for (i = 0; alltests[i].func; i++)
+        suite = alltests[i].func(suite);
+
+    return abts_report(suite);
+}
@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "test-amf.h"
+#include "amf/admission.h"
+
+static int saved_quantum;
+static int saved_rate;
+static int saved_burst;
+static int saved_overload;
+
+static void admission_setup(int quantum, int rate, int burst, int overload)
+{
+    saved_quantum = amf_self()->admission.quantum;
+    saved_rate = amf_self()->admission.rate;
+    saved_burst = amf_self()->admission.burst;
+    saved_overload = amf_self()->admission.overload;
+
+    amf_self()->admission.quantum = quantum;
+    amf_self()->admission.rate = rate;
+    amf_self()->admission.burst = burst;
+    amf_self()->admission.overload = overload;
+}
+
+static void admission_teardown(void)
+{
+    amf_self()->admission.quantum = saved_quantum;
+    amf_self()->admission.rate = saved_rate;
+    amf_self()->admission.burst = saved_burst;
+    amf_self()->admission.overload = saved_overload;
+}
+
+/* APER header of an initiatingMessage, followed by a tag */
+static amf_event_t *ngap_event(uint8_t procedure_code, uint8_t tag)
+{
+    amf_event_t *e = NULL;
+    uint8_t data[3] = { 0x00, procedure_code, tag };
+
+    e = amf_event_new(AMF_EVENT_NGAP_MESSAGE);
+    ogs_assert(e);
+    e->pkbuf = ogs_pkbuf_alloc(NULL, sizeof(data));
+    ogs_assert(e->pkbuf);
+    ogs_pkbuf_put_data(e->pkbuf, data, sizeof(data));
+
+    return e;
+}
+
+static void backlog_push(int num)
+{
+    static uint8_t tag = 0;
+    int i;
+
+    for (i = 0; i < num; i++)
+        ogs_assert(amf_admission_defer(ngap_event(
+                    NGAP_ProcedureCode_id_InitialUEMessage, tag++)) == true);
+}
+
+static int dispatched;
+static uint8_t dispatched_tag[16];
+
+static void dispatch_state(ogs_fsm_t *s, amf_event_t *e)
+{
+    if (!e)
+        return;
+
+    ogs_assert(e->pkbuf);
+    if (dispatched < (int)sizeof(dispatched_tag))
+        dispatched_tag[dispatched] = e->pkbuf->data[2];
+    dispatched++;
+
+    ogs_pkbuf_free(e->pkbuf);
+}
+
+static void admission_test1(abts_case *tc, void *data)
+{
+    amf_gnb_t *gnb = NULL;
+    ogs_time_t t0 = ogs_time_from_sec(1000);
+
+    admission_setup(64, 10, 5, 0);
+
+    gnb = test_amf_gnb_add(1);
+    gnb->admission.tokens = 0;
+    gnb->admission.refill = t0;
+
+    ABTS_TRUE(tc, amf_admission_take_token(gnb, t0) == false);
+
+    /* 250ms at 10/s: two tokens, the 50ms left over is kept */
+    ABTS_TRUE(tc, amf_admission_take_token(gnb, t0 + 250000) == true);
+    ABTS_INT_EQUAL(tc, 1, gnb->admission.tokens);
+    ABTS_TRUE(tc, gnb->admission.refill == t0 + 200000);
+    ABTS_TRUE(tc, amf_admission_take_token(gnb, t0 + 250000) == true);
+    ABTS_TRUE(tc, amf_admission_take_token(gnb, t0 + 250000) == false);
+    ABTS_INT_EQUAL(tc, 0, gnb->admission.tokens);
+
+    /* 50ms more completes the next token */
+    ABTS_TRUE(tc, amf_admission_take_token(gnb, t0 + 299999) == false);
+    ABTS_TRUE(tc, amf_admission_take_token(gnb, t0 + 300000) == true);
+    ABTS_TRUE(tc, gnb->admission.refill == t0 + 300000);
+
+    /* A long idle period fills the bucket up to the burst only */
+    ABTS_TRUE(tc, amf_admission_take_token(gnb, t0 + 10000000) == true);
+    ABTS_INT_EQUAL(tc, 4, gnb->admission.tokens);
+    ABTS_TRUE(tc, gnb->admission.refill == t0 + 10000000);
+    ABTS_TRUE(tc, amf_admission_take_token(gnb, t0 + 10000000) == true);
+    ABTS_TRUE(tc, amf_admission_take_token(gnb, t0 + 10000000) == true);
+    ABTS_TRUE(tc, amf_admission_take_token(gnb, t0 + 10000000) == true);
+    ABTS_TRUE(tc, amf_admission_take_token(gnb, t0 + 10000000) == true);
+    ABTS_TRUE(tc, amf_admission_take_token(gnb, t0 + 10000000) == false);
+
+    /* Without a rate every Registration is admitted */
+    amf_self()->admission.rate = 0;
+    ABTS_TRUE(tc, amf_admission_take_token(gnb, t0 + 10000000) == true);
+    ABTS_INT_EQUAL(tc, 0, gnb->admission.tokens);
+
+    amf_gnb_remove(gnb);
+
+    admission_teardown();
+}
+
+static void admission_test2(abts_case *tc, void *data)
+{
+    ogs_fsm_t sm;
+    amf_event_t *e = NULL;
+    int i;
+
+    admission_setup(3, 0, 0, 0);
+
+    ogs_fsm_init(&sm, dispatch_state, 0, 0);
+    dispatched = 0;
+
+    /* Only InitialUEMessage waits in the backlog */
+    e = ngap_event(NGAP_ProcedureCode_id_NGSetup, 0);
+    ABTS_TRUE(tc, amf_admission_defer(e) == false);
+    ogs_pkbuf_free(e->pkbuf);
+    ogs_event_free(e);
+
+    backlog_push(7);
+    ABTS_INT_EQUAL(tc, 7, amf_admission_backlog());
+
+    /* At most 'quantum' per main loop iteration, in arrival order */
+    ABTS_INT_EQUAL(tc, 3, amf_admission_dispatch(&sm));
+    ABTS_INT_EQUAL(tc, 3, dispatched);
+    ABTS_INT_EQUAL(tc, 4, amf_admission_backlog());
+    ABTS_INT_EQUAL(tc, 3, amf_admission_dispatch(&sm));
+    ABTS_INT_EQUAL(tc, 1, amf_admission_backlog());
+    ABTS_INT_EQUAL(tc, 1, amf_admission_dispatch(&sm));
+    ABTS_INT_EQUAL(tc, 0, amf_admission_dispatch(&sm));
+    ABTS_INT_EQUAL(tc, 7, dispatched);
+    ABTS_INT_EQUAL(tc, 0, amf_admission_backlog());
+
+    for (i = 1; i < 7; i++)
+        ABTS_INT_EQUAL(tc, (uint8_t)(dispatched_tag[0] + i),
+                dispatched_tag[i]);
+
+    ogs_fsm_fini(&sm, 0);
+
+    admission_teardown();
+}
+
+#define SENT(__gNB) ogs_list_count(&(__gNB)->sctp.write_queue)
+
+static void admission_test3(abts_case *tc, void *data)
+{
+    ogs_fsm_t sm;
+    amf_gnb_t *gnb1 = NULL, *gnb2 = NULL;
+
+    admission_setup(1, 0, 0, 4);
+
+    ogs_fsm_init(&sm, dispatch_state, 0, 0);
+
+    /* Only gNBs done with NG Setup are told */
+    gnb1 = test_amf_gnb_add(1);
+    gnb1->state.ng_setup_success = true;
+    gnb2 = test_amf_gnb_add(2);
+
+    backlog_push(3);
+    amf_admission_run();
+    ABTS_TRUE(tc, amf_admission_overloaded() == false);
+    ABTS_INT_EQUAL(tc, 0, SENT(gnb1));
+
+    /* Overload Start once the backlog reaches 'overload' */
+    backlog_push(1);
+    amf_admission_run();
+    ABTS_TRUE(tc, amf_admission_overloaded() == true);
+    ABTS_INT_EQUAL(tc, 1, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 0, SENT(gnb2));
+
+    backlog_push(1);
+    amf_admission_run();
+    ABTS_INT_EQUAL(tc, 1, SENT(gnb1));
+
+    /* Overload Stop only when drained to half */
+    amf_admission_dispatch(&sm);
+    amf_admission_dispatch(&sm);
+    ABTS_INT_EQUAL(tc, 3, amf_admission_backlog());
+    amf_admission_run();
+    ABTS_TRUE(tc, amf_admission_overloaded() == true);
+    ABTS_INT_EQUAL(tc, 1, SENT(gnb1));
+
+    amf_admission_dispatch(&sm);
+    amf_admission_run();
+    ABTS_TRUE(tc, amf_admission_overloaded() == false);
+    ABTS_INT_EQUAL(tc, 2, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 0, SENT(gnb2));
+
+    amf_admission_dispatch(&sm);
+    amf_admission_dispatch(&sm);
+    ABTS_INT_EQUAL(tc, 0, amf_admission_backlog());
+    amf_admission_run();
+    ABTS_INT_EQUAL(tc, 2, SENT(gnb1));
+
+    /* Without 'overload' the backlog never starts an overload */
+    amf_self()->admission.overload = 0;
+    backlog_push(8);
+    amf_admission_run();
+    ABTS_TRUE(tc, amf_admission_overloaded() == false);
+    ABTS_INT_EQUAL(tc, 2, SENT(gnb1));
+    while (amf_admission_dispatch(&sm));
+
+    ogs_fsm_fini(&sm, 0);
+
+    amf_gnb_remove(gnb1);
+    amf_gnb_remove(gnb2);
+
+    admission_teardown();
+}
+
+abts_suite *test_amf_admission(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, admission_test1, NULL);
+    abts_run_test(suite, admission_test2, NULL);
+    abts_run_test(suite, admission_test3, NULL);
+
+    return suite;
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "test-amf.h"
+
+static void ran_ue_hash_test1(abts_case *tc, void *data)
+{
+    amf_gnb_t *gnb1 = NULL, *gnb2 = NULL;
+    ran_ue_t *ran_ue1 = NULL, *ran_ue2 = NULL, *ran_ue3 = NULL;
+
+    gnb1 = test_amf_gnb_add(1);
+    gnb2 = test_amf_gnb_add(2);
+
+    /* RAN-UE-NGAP-ID is only unique within a gNB */
+    ran_ue1 = ran_ue_add(gnb1, 10);
+    ABTS_PTR_NOTNULL(tc, ran_ue1);
+    ran_ue2 = ran_ue_add(gnb2, 10);
+    ABTS_PTR_NOTNULL(tc, ran_ue2);
+
+    ABTS_PTR_EQUAL(tc, ran_ue1, ran_ue_find_by_ran_ue_ngap_id(gnb1, 10));
+    ABTS_PTR_EQUAL(tc, ran_ue2, ran_ue_find_by_ran_ue_ngap_id(gnb2, 10));
+    ABTS_PTR_EQUAL(tc, NULL, ran_ue_find_by_ran_ue_ngap_id(gnb1, 11));
+
+    /* A handover target has no ID until the gNB answers */
+    ran_ue3 = ran_ue_add(gnb1, INVALID_UE_NGAP_ID);
+    ABTS_PTR_NOTNULL(tc, ran_ue3);
+    ABTS_PTR_EQUAL(tc, NULL,
+            ran_ue_find_by_ran_ue_ngap_id(gnb1, INVALID_UE_NGAP_ID));
+
+    ran_ue_set_ran_ue_ngap_id(ran_ue3, 11);
+    ABTS_PTR_EQUAL(tc, ran_ue3, ran_ue_find_by_ran_ue_ngap_id(gnb1, 11));
+
+    ran_ue_set_ran_ue_ngap_id(ran_ue1, 12);
+    ABTS_PTR_EQUAL(tc, NULL, ran_ue_find_by_ran_ue_ngap_id(gnb1, 10));
+    ABTS_PTR_EQUAL(tc, ran_ue1, ran_ue_find_by_ran_ue_ngap_id(gnb1, 12));
+
+    /* Moving to another gNB moves the hash entry */
+    ran_ue_switch_to_gnb(ran_ue3, gnb2);
+    ABTS_PTR_EQUAL(tc, gnb2, ran_ue3->gnb);
+    ABTS_PTR_EQUAL(tc, NULL, ran_ue_find_by_ran_ue_ngap_id(gnb1, 11));
+    ABTS_PTR_EQUAL(tc, ran_ue3, ran_ue_find_by_ran_ue_ngap_id(gnb2, 11));
+    ABTS_INT_EQUAL(tc, 1, ogs_list_count(&gnb1->ran_ue_list));
+    ABTS_INT_EQUAL(tc, 2, ogs_list_count(&gnb2->ran_ue_list));
+
+    ran_ue_remove(ran_ue1);
+    ran_ue_remove(ran_ue2);
+    ran_ue_remove(ran_ue3);
+
+    ABTS_PTR_EQUAL(tc, NULL, ran_ue_find_by_ran_ue_ngap_id(gnb1, 12));
+    ABTS_PTR_EQUAL(tc, NULL, ran_ue_find_by_ran_ue_ngap_id(gnb2, 10));
+    ABTS_PTR_EQUAL(tc, NULL, ran_ue_find_by_ran_ue_ngap_id(gnb2, 11));
+
+    amf_gnb_remove(gnb1);
+    amf_gnb_remove(gnb2);
+}
+
+static void ran_ue_hash_test2(abts_case *tc, void *data)
+{
+    amf_gnb_t *gnb = NULL;
+    ran_ue_t *stale = NULL, *reused = NULL;
+    ogs_hash_index_t *hi = NULL;
+
+    gnb = test_amf_gnb_add(1);
+
+    /* The gNB reuses an ID before the AMF has released the old ran_ue */
+    stale = ran_ue_add(gnb, 20);
+    ABTS_PTR_NOTNULL(tc, stale);
+    reused = ran_ue_add(gnb, 20);
+    ABTS_PTR_NOTNULL(tc, reused);
+    ABTS_PTR_EQUAL(tc, reused, ran_ue_find_by_ran_ue_ngap_id(gnb, 20));
+
+    /* Removing the stale one leaves the newest entry alone */
+    ran_ue_remove(stale);
+    ABTS_PTR_EQUAL(tc, reused, ran_ue_find_by_ran_ue_ngap_id(gnb, 20));
+
+    /* The entry must not be keyed on the freed context */
+    hi = ogs_hash_first(gnb->ran_ue_hash);
+    ABTS_PTR_NOTNULL(tc, hi);
+    ABTS_PTR_EQUAL(tc, reused, ogs_hash_this_val(hi));
+    ABTS_PTR_EQUAL(tc, &reused->ran_ue_ngap_id, ogs_hash_this_key(hi));
+    ABTS_PTR_EQUAL(tc, NULL, ogs_hash_next(hi));
+
+    ran_ue_remove(reused);
+    ABTS_PTR_EQUAL(tc, NULL, ran_ue_find_by_ran_ue_ngap_id(gnb, 20));
+
+    amf_gnb_remove(gnb);
+}
+
+static void subscribed_slice_test1(abts_case *tc, void *data)
+{
+    amf_ue_t *amf_ue = NULL;
+    ogs_slice_data_t *slice = NULL, *array = NULL;
+    int i;
+#if OGS_USE_TALLOC == 1
+    size_t size;
+#endif
+
+    amf_ue = amf_ue_add(NULL);
+    ABTS_PTR_NOTNULL(tc, amf_ue);
+
+    /* The pooled context carries no slices until the UDM sends some */
+    ABTS_PTR_EQUAL(tc, NULL, amf_ue->slice);
+    ABTS_INT_EQUAL(tc, 0, amf_ue->num_of_slice);
+    amf_clear_subscribed_info(amf_ue);
+    ABTS_PTR_EQUAL(tc, NULL, amf_ue->slice);
+
+#if OGS_USE_TALLOC == 1
+    size = talloc_total_size(__ogs_talloc_core);
+#endif
+    slice = amf_ue_slice_add(amf_ue);
+    ABTS_PTR_NOTNULL(tc, slice);
+    array = amf_ue->slice;
+    ABTS_PTR_EQUAL(tc, &array[0], slice);
+    ABTS_INT_EQUAL(tc, 1, amf_ue->num_of_slice);
+#if OGS_USE_TALLOC == 1
+    ABTS_INT_EQUAL(tc, OGS_MAX_NUM_OF_SLICE * sizeof(ogs_slice_data_t),
+            talloc_total_size(__ogs_talloc_core) - size);
+#endif
+
+    slice->session[0].name = ogs_strdup("internet");
+    slice->num_of_session = 1;
+
+    for (i = 1; i < OGS_MAX_NUM_OF_SLICE; i++) {
+        slice = amf_ue_slice_add(amf_ue);
+        ABTS_PTR_EQUAL(tc, &array[i], slice);
+    }
+    ABTS_PTR_EQUAL(tc, NULL, amf_ue_slice_add(amf_ue));
+    ABTS_INT_EQUAL(tc, OGS_MAX_NUM_OF_SLICE, amf_ue->num_of_slice);
+
+    /* A new subscription reuses the array from a clean first entry */
+    amf_clear_subscribed_info(amf_ue);
+    ABTS_INT_EQUAL(tc, 0, amf_ue->num_of_slice);
+    ABTS_PTR_EQUAL(tc, array, amf_ue->slice);
+
+    slice = amf_ue_slice_add(amf_ue);
+    ABTS_PTR_EQUAL(tc, &array[0], slice);
+    ABTS_INT_EQUAL(tc, 0, slice->num_of_session);
+    ABTS_PTR_EQUAL(tc, NULL, slice->session[0].name);
+
+    slice->session[0].name = ogs_strdup("ims");
+    slice->num_of_session = 1;
+
+    /* Removing the UE frees the array and the DNNs in it */
+#if OGS_USE_TALLOC == 1
+    size = talloc_total_size(__ogs_talloc_core);
+#endif
+    amf_ue_remove(amf_ue);
+#if OGS_USE_TALLOC == 1
+    ABTS_TRUE(tc, size - talloc_total_size(__ogs_talloc_core) >=
+            OGS_MAX_NUM_OF_SLICE * sizeof(ogs_slice_data_t) + sizeof("ims"));
+#endif
+
+    /* The next UE from the pool starts without slices again */
+    amf_ue = amf_ue_add(NULL);
+    ABTS_PTR_NOTNULL(tc, amf_ue);
+    ABTS_PTR_EQUAL(tc, NULL, amf_ue->slice);
+    amf_ue_remove(amf_ue);
+}
+
+abts_suite *test_amf_context(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, ran_ue_hash_test1, NULL);
+    abts_run_test(suite, ran_ue_hash_test2, NULL);
+    abts_run_test(suite, subscribed_slice_test1, NULL);
+
+    return suite;
+}
@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "test-amf.h"
+#include "amf/paging.h"
+
+static ogs_5gs_tai2_list_t saved_list2;
+static int saved_num_of_escalation;
+static int saved_escalation[AMF_MAX_NUM_OF_PAGING_ESCALATION];
+static int saved_rate;
+static ogs_time_t saved_interval;
+
+/* The served TAI list of sample.yaml (999-70, TAC 1) extended by TAC 2 */
+static void paging_setup(int num_of_escalation, const int *escalation,
+        int rate)
+{
+    ogs_5gs_tai2_list_t *list2 = &amf_self()->served_tai[0].list2;
+    int i;
+
+    memcpy(&saved_list2, list2, sizeof(saved_list2));
+    saved_num_of_escalation = amf_self()->paging.num_of_escalation;
+    memcpy(saved_escalation, amf_self()->paging.escalation,
+            sizeof(saved_escalation));
+    saved_rate = amf_self()->paging.rate;
+    saved_interval = amf_self()->paging.interval;
+
+    ogs_assert(list2->num == 1);
+    memcpy(&list2->tai[1].plmn_id, &list2->tai[0].plmn_id, OGS_PLMN_ID_LEN);
+    list2->tai[1].tac.v = 2;
+    list2->num = 2;
+
+    amf_self()->paging.num_of_escalation = num_of_escalation;
+    for (i = 0; i < num_of_escalation; i++)
+        amf_self()->paging.escalation[i] = escalation[i];
+    amf_self()->paging.rate = rate;
+    /* The scheduler tick never comes, amf_paging_run() is called instead */
+    amf_self()->paging.interval = ogs_time_from_sec(3600);
+}
+
+static void paging_teardown(void)
+{
+    memcpy(&amf_self()->served_tai[0].list2, &saved_list2,
+            sizeof(saved_list2));
+    amf_self()->paging.num_of_escalation = saved_num_of_escalation;
+    memcpy(amf_self()->paging.escalation, saved_escalation,
+            sizeof(saved_escalation));
+    amf_self()->paging.rate = saved_rate;
+    amf_self()->paging.interval = saved_interval;
+}
+
+static amf_gnb_t *gnb_add(uint32_t gnb_id, int num_of_tac, const int *tac)
+{
+    ogs_plmn_id_t *plmn_id = &amf_self()->served_tai[0].list2.tai[0].plmn_id;
+    amf_gnb_t *gnb = NULL;
+    int i;
+
+    gnb = test_amf_gnb_add(gnb_id);
+
+    gnb->num_of_supported_ta_list = num_of_tac;
+    for (i = 0; i < num_of_tac; i++) {
+        gnb->supported_ta_list[i].tac.v = tac[i];
+        gnb->supported_ta_list[i].num_of_bplmn_list = 1;
+        memcpy(&gnb->supported_ta_list[i].bplmn_list[0].plmn_id,
+                plmn_id, OGS_PLMN_ID_LEN);
+    }
+    amf_gnb_update_tai_index(gnb);
+
+    return gnb;
+}
+
+static void ue_setup(amf_ue_t *amf_ue, int tac)
+{
+    memset(amf_ue, 0, sizeof(*amf_ue));
+    memcpy(&amf_ue->nr_tai.plmn_id,
+            &amf_self()->served_tai[0].list2.tai[0].plmn_id,
+            OGS_PLMN_ID_LEN);
+    amf_ue->nr_tai.tac.v = tac;
+}
+
+static ogs_pkbuf_t *paging_pkbuf(void)
+{
+    ogs_pkbuf_t *pkbuf = ogs_pkbuf_alloc(NULL, 16);
+    ogs_assert(pkbuf);
+    memset(ogs_pkbuf_put(pkbuf, 16), 0, 16);
+
+    return pkbuf;
+}
+
+static int paging_send(amf_ue_t *amf_ue)
+{
+    ogs_pkbuf_t *pkbuf = paging_pkbuf();
+    int rv = amf_paging_send(amf_ue, pkbuf);
+    ogs_pkbuf_free(pkbuf);
+
+    return rv;
+}
+
+#define SENT(__gNB) ogs_list_count(&(__gNB)->sctp.write_queue)
+#define QUEUED(__gNB) ogs_list_count(&(__gNB)->paging.list)
+
+static void paging_test1(abts_case *tc, void *data)
+{
+    const int escalation[] = { AMF_PAGING_AREA_TAI_LIST };
+    const int tac12[] = { 1, 2 }, tac2[] = { 2 };
+    amf_gnb_t *gnb1 = NULL, *gnb2 = NULL;
+    amf_ue_t amf_ue;
+
+    paging_setup(1, escalation, 0);
+
+    /* gNB1 serves both TAIs of the list, but is paged only once */
+    gnb1 = gnb_add(1, 2, tac12);
+    gnb2 = gnb_add(2, 1, tac2);
+    ue_setup(&amf_ue, 1);
+
+    ABTS_INT_EQUAL(tc, OGS_OK, paging_send(&amf_ue));
+    ABTS_INT_EQUAL(tc, 1, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 1, SENT(gnb2));
+
+    /* The next Paging is a new one */
+    ABTS_INT_EQUAL(tc, OGS_OK, paging_send(&amf_ue));
+    ABTS_INT_EQUAL(tc, 2, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 2, SENT(gnb2));
+
+    amf_gnb_remove(gnb1);
+    amf_gnb_remove(gnb2);
+
+    paging_teardown();
+}
+
+static void paging_test2(abts_case *tc, void *data)
+{
+    const int escalation[] = { AMF_PAGING_AREA_LAST_GNB,
+        AMF_PAGING_AREA_TAI, AMF_PAGING_AREA_TAI_LIST };
+    const int tac1[] = { 1 }, tac2[] = { 2 };
+    amf_gnb_t *gnb1 = NULL, *gnb2 = NULL, *gnb3 = NULL;
+    amf_ue_t amf_ue;
+
+    paging_setup(3, escalation, 0);
+
+    gnb1 = gnb_add(1, 1, tac1);
+    gnb2 = gnb_add(2, 1, tac1);
+    gnb3 = gnb_add(3, 1, tac2);
+    ue_setup(&amf_ue, 1);
+    amf_ue.last_gnb.presence = true;
+    amf_ue.last_gnb.gnb_id = 3;
+
+    /* First attempt: the last serving gNB only */
+    ABTS_INT_EQUAL(tc, OGS_OK, paging_send(&amf_ue));
+    ABTS_INT_EQUAL(tc, 0, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 0, SENT(gnb2));
+    ABTS_INT_EQUAL(tc, 1, SENT(gnb3));
+
+    /* T3513 retry: the TAI of the UE */
+    amf_ue.t3513.retry_count = 1;
+    ABTS_INT_EQUAL(tc, OGS_OK, paging_send(&amf_ue));
+    ABTS_INT_EQUAL(tc, 1, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 1, SENT(gnb2));
+    ABTS_INT_EQUAL(tc, 1, SENT(gnb3));
+
+    /* Then the whole TAI list, which is repeated from now on */
+    amf_ue.t3513.retry_count = 2;
+    ABTS_INT_EQUAL(tc, OGS_OK, paging_send(&amf_ue));
+    ABTS_INT_EQUAL(tc, 2, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 2, SENT(gnb2));
+    ABTS_INT_EQUAL(tc, 2, SENT(gnb3));
+
+    amf_ue.t3513.retry_count = 5;
+    ABTS_INT_EQUAL(tc, OGS_OK, paging_send(&amf_ue));
+    ABTS_INT_EQUAL(tc, 3, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 3, SENT(gnb2));
+    ABTS_INT_EQUAL(tc, 3, SENT(gnb3));
+
+    /* Without a known last gNB the first attempt falls back to the TAI */
+    amf_ue.t3513.retry_count = 0;
+    amf_ue.last_gnb.presence = false;
+    ABTS_INT_EQUAL(tc, OGS_OK, paging_send(&amf_ue));
+    ABTS_INT_EQUAL(tc, 4, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 4, SENT(gnb2));
+    ABTS_INT_EQUAL(tc, 3, SENT(gnb3));
+
+    /* The same when the last gNB has gone away */
+    amf_ue.last_gnb.presence = true;
+    amf_gnb_remove(gnb3);
+    ABTS_INT_EQUAL(tc, OGS_OK, paging_send(&amf_ue));
+    ABTS_INT_EQUAL(tc, 5, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 5, SENT(gnb2));
+
+    amf_gnb_remove(gnb1);
+    amf_gnb_remove(gnb2);
+
+    paging_teardown();
+}
+
+static void paging_test3(abts_case *tc, void *data)
+{
+    const int escalation[] = { AMF_PAGING_AREA_TAI };
+    const int tac1[] = { 1 };
+    amf_gnb_t *gnb1 = NULL, *gnb2 = NULL;
+    amf_ue_t amf_ue;
+    int i;
+
+    paging_setup(1, escalation, 2);
+
+    gnb1 = gnb_add(1, 1, tac1);
+    gnb2 = gnb_add(2, 1, tac1);
+    ue_setup(&amf_ue, 1);
+
+    /* At most 2 per interval, the rest waits for the next tick */
+    for (i = 0; i < 5; i++)
+        ABTS_INT_EQUAL(tc, OGS_OK, paging_send(&amf_ue));
+    ABTS_INT_EQUAL(tc, 2, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 3, QUEUED(gnb1));
+    ABTS_INT_EQUAL(tc, 2, SENT(gnb2));
+    ABTS_INT_EQUAL(tc, 3, QUEUED(gnb2));
+
+    amf_paging_run();
+    ABTS_INT_EQUAL(tc, 4, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 1, QUEUED(gnb1));
+    ABTS_INT_EQUAL(tc, 4, SENT(gnb2));
+    ABTS_INT_EQUAL(tc, 1, QUEUED(gnb2));
+
+    /* Nothing jumps the queue, even with room left in the interval */
+    ABTS_INT_EQUAL(tc, OGS_OK, paging_send(&amf_ue));
+    ABTS_INT_EQUAL(tc, 4, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 2, QUEUED(gnb1));
+
+    /* A removed gNB takes its queue with it */
+    amf_gnb_remove(gnb2);
+
+    amf_paging_run();
+    ABTS_INT_EQUAL(tc, 6, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 0, QUEUED(gnb1));
+
+    amf_paging_run();
+    ABTS_INT_EQUAL(tc, 6, SENT(gnb1));
+
+    amf_gnb_remove(gnb1);
+
+    paging_teardown();
+}
+
+static void paging_test4(abts_case *tc, void *data)
+{
+    const int escalation[] = { AMF_PAGING_AREA_TAI };
+    const int tac1[] = { 1 };
+    amf_gnb_t *gnb1 = NULL, *gnb2 = NULL;
+    amf_ue_t amf_ue1, amf_ue2;
+
+    paging_setup(1, escalation, 1);
+
+    gnb1 = gnb_add(1, 1, tac1);
+    gnb2 = gnb_add(2, 1, tac1);
+    ue_setup(&amf_ue1, 1);
+    ue_setup(&amf_ue2, 1);
+
+    ABTS_INT_EQUAL(tc, OGS_OK, paging_send(&amf_ue1));
+    ABTS_INT_EQUAL(tc, OGS_OK, paging_send(&amf_ue2));
+    ABTS_INT_EQUAL(tc, OGS_OK, paging_send(&amf_ue1));
+    ABTS_INT_EQUAL(tc, 1, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 2, QUEUED(gnb1));
+    ABTS_INT_EQUAL(tc, 1, SENT(gnb2));
+    ABTS_INT_EQUAL(tc, 2, QUEUED(gnb2));
+
+    /* The UE answered: its pages are dropped from every gNB */
+    amf_paging_remove_ue(&amf_ue1);
+    ABTS_INT_EQUAL(tc, 1, QUEUED(gnb1));
+    ABTS_INT_EQUAL(tc, 1, QUEUED(gnb2));
+
+    amf_paging_run();
+    ABTS_INT_EQUAL(tc, 2, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 0, QUEUED(gnb1));
+    ABTS_INT_EQUAL(tc, 2, SENT(gnb2));
+    ABTS_INT_EQUAL(tc, 0, QUEUED(gnb2));
+
+    /* Nothing left for the other UE either */
+    amf_paging_remove_ue(&amf_ue2);
+    amf_paging_run();
+    ABTS_INT_EQUAL(tc, 2, SENT(gnb1));
+    ABTS_INT_EQUAL(tc, 2, SENT(gnb2));
+
+    amf_gnb_remove(gnb1);
+    amf_gnb_remove(gnb2);
+
+    paging_teardown();
+}
+
+abts_suite *test_amf_paging(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, paging_test1, NULL);
+    abts_run_test(suite, paging_test2, NULL);
+    abts_run_test(suite, paging_test3, NULL);
+    abts_run_test(suite, paging_test4, NULL);
+
+    return suite;
+}
@@ -0,0 +1,342 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "test-amf.h"
+#include "amf/amf-sm.h"
+#include "amf/snapshot.h"
+
+#include <fcntl.h>
+
+/* Offsets in the file header and the first record */
+#define SNAPSHOT_HEADER_END     16
+#define SNAPSHOT_FIRST_RECORD   24
+
+static char *path;
+
+static amf_ue_t *snapshot_ue_add(const char *supi, const char *suci)
+{
+    amf_ue_t *amf_ue = NULL;
+    ogs_slice_data_t *slice = NULL;
+    amf_event_t e;
+    int i;
+
+    amf_ue = amf_ue_add(NULL);
+    ogs_assert(amf_ue);
+
+    amf_ue_set_supi(amf_ue, (char *)supi);
+    amf_ue->suci = ogs_strdup(suci);
+    ogs_assert(amf_ue->suci);
+    ogs_hash_set(amf_self()->suci_hash,
+            amf_ue->suci, strlen(amf_ue->suci), amf_ue);
+
+    amf_ue_new_guti(amf_ue);
+    amf_ue_confirm_guti(amf_ue);
+
+    amf_ue->nas.ue.ksi = 1;
+    amf_ue->nas.amf.ksi = 1;
+    amf_ue->selected_int_algorithm = OGS_NAS_SECURITY_ALGORITHMS_128_NIA2;
+    amf_ue->selected_enc_algorithm = OGS_NAS_SECURITY_ALGORITHMS_128_NEA2;
+    for (i = 0; i < OGS_SHA256_DIGEST_SIZE; i++)
+        amf_ue->kamf[i] = i;
+    amf_ue->dl_count = 10;
+    amf_ue->ul_count.i32 = 20;
+    amf_ue->security_context_available = 1;
+
+    slice = amf_ue_slice_add(amf_ue);
+    ogs_assert(slice);
+    slice->s_nssai.sst = 1;
+    slice->s_nssai.sd.v = OGS_S_NSSAI_NO_SD_VALUE;
+    slice->default_indicator = true;
+    slice->session[0].name = ogs_strdup("internet");
+    ogs_assert(slice->session[0].name);
+    slice->session[0].default_dnn_indicator = true;
+    slice->num_of_session = 1;
+
+    memset(&e, 0, sizeof(e));
+    e.amf_ue = amf_ue;
+    ogs_fsm_tran(&amf_ue->sm, gmm_state_registered, &e);
+
+    return amf_ue;
+}
+
+/* Drop the UE contexts without writing removal records */
+static void snapshot_restart(void)
+{
+    amf_snapshot_close();
+    amf_ue_remove_all();
+    ogs_assert(amf_snapshot_open() == OGS_OK);
+}
+
+static void snapshot_setup(size_t size)
+{
+    if (!path) {
+        path = ogs_msprintf("/tmp/amf-snapshot-test.%d", (int)getpid());
+        ogs_assert(path);
+    }
+    unlink(path);
+
+    amf_self()->snapshot.path = path;
+    amf_self()->snapshot.size = size;
+    ogs_assert(amf_snapshot_open() == OGS_OK);
+}
+
+static void snapshot_teardown(void)
+{
+    amf_snapshot_close();
+    amf_ue_remove_all();
+
+    amf_self()->snapshot.path = NULL;
+    unlink(path);
+}
+
+static void snapshot_pread(void *buf, size_t len, off_t offset)
+{
+    int fd = open(path, O_RDONLY);
+    ogs_assert(fd >= 0);
+    ogs_assert(pread(fd, buf, len, offset) == (ssize_t)len);
+    close(fd);
+}
+
+static void snapshot_pwrite(const void *buf, size_t len, off_t offset)
+{
+    int fd = open(path, O_WRONLY);
+    ogs_assert(fd >= 0);
+    ogs_assert(pwrite(fd, buf, len, offset) == (ssize_t)len);
+    close(fd);
+}
+
+static void snapshot_test1(abts_case *tc, void *data)
+{
+    amf_ue_t *amf_ue = NULL;
+    ogs_nas_5gs_guti_t guti;
+    int i;
+
+    snapshot_setup(1024*1024);
+
+    amf_ue = snapshot_ue_add("imsi-001010000000001", "suci-0-001-01-0-0-0-1");
+    memcpy(&guti, &amf_ue->current.guti, sizeof(guti));
+    amf_snapshot_store(amf_ue);
+    ABTS_TRUE(tc, amf_ue->snapshot.stored);
+
+    /* The UE comes back with its GUTI, key and subscription */
+    snapshot_restart();
+    ABTS_INT_EQUAL(tc, 1, ogs_list_count(&amf_self()->amf_ue_list));
+
+    amf_ue = amf_ue_find_by_supi((char *)"imsi-001010000000001");
+    ABTS_PTR_NOTNULL(tc, amf_ue);
+    ABTS_PTR_EQUAL(tc, amf_ue,
+            amf_ue_find_by_suci((char *)"suci-0-001-01-0-0-0-1"));
+    ABTS_PTR_EQUAL(tc, amf_ue, amf_ue_find_by_guti(&guti));
+    ABTS_TRUE(tc, OGS_FSM_CHECK(&amf_ue->sm, gmm_state_registered));
+    ABTS_TRUE(tc, SECURITY_CONTEXT_IS_VALID(amf_ue));
+    ABTS_INT_EQUAL(tc, OGS_NAS_SECURITY_ALGORITHMS_128_NIA2,
+            amf_ue->selected_int_algorithm);
+    for (i = 0; i < OGS_SHA256_DIGEST_SIZE; i++)
+        if (amf_ue->kamf[i] != i) break;
+    ABTS_INT_EQUAL(tc, OGS_SHA256_DIGEST_SIZE, i);
+    ABTS_INT_EQUAL(tc, 20, amf_ue->ul_count.i32);
+    ABTS_INT_EQUAL(tc, 1, amf_ue->num_of_slice);
+    ABTS_INT_EQUAL(tc, 1, amf_ue->slice[0].s_nssai.sst);
+    ABTS_INT_EQUAL(tc, 1, amf_ue->slice[0].num_of_session);
+    ABTS_STR_EQUAL(tc, "internet", amf_ue->slice[0].session[0].name);
+
+    /* DL NAS COUNT resumes above anything the old process could send */
+    ABTS_TRUE(tc, amf_ue->dl_count > 10);
+    ABTS_TRUE(tc, amf_ue->dl_count < 10 + 256);
+
+    /* The record is refreshed before the DL NAS COUNT passes the mark */
+    ABTS_TRUE(tc, amf_ue->snapshot.stored);
+    for (i = 0; i < 1000; i++) {
+        amf_ue->dl_count = (amf_ue->dl_count + 1) & 0xffffff;
+        amf_snapshot_update(amf_ue);
+        ABTS_TRUE(tc, amf_ue->dl_count < amf_ue->snapshot.dl_count);
+    }
+    i = amf_ue->dl_count;
+
+    snapshot_restart();
+    amf_ue = amf_ue_find_by_supi((char *)"imsi-001010000000001");
+    ABTS_PTR_NOTNULL(tc, amf_ue);
+    ABTS_TRUE(tc, amf_ue->dl_count > i);
+    ABTS_TRUE(tc, amf_ue->dl_count < i + 256);
+
+    /* A new security context starts again from zero */
+    amf_ue->dl_count = 0;
+    amf_snapshot_update(amf_ue);
+    ABTS_INT_EQUAL(tc, 0, amf_ue->dl_count);
+
+    snapshot_restart();
+    amf_ue = amf_ue_find_by_supi((char *)"imsi-001010000000001");
+    ABTS_PTR_NOTNULL(tc, amf_ue);
+    ABTS_TRUE(tc, amf_ue->dl_count > 0);
+    ABTS_TRUE(tc, amf_ue->dl_count < 256);
+
+    snapshot_teardown();
+}
+
+static void snapshot_test2(abts_case *tc, void *data)
+{
+    amf_ue_t *amf_ue1 = NULL, *amf_ue2 = NULL;
+
+    snapshot_setup(1024*1024);
+
+    amf_ue1 = snapshot_ue_add("imsi-001010000000001", "suci-0-001-01-0-0-0-1");
+    amf_ue2 = snapshot_ue_add("imsi-001010000000002", "suci-0-001-01-0-0-0-2");
+    amf_snapshot_store(amf_ue1);
+    amf_snapshot_store(amf_ue2);
+
+    /* Removing the context appends a removal record */
+    amf_ue_remove(amf_ue1);
+
+    snapshot_restart();
+    ABTS_INT_EQUAL(tc, 1, ogs_list_count(&amf_self()->amf_ue_list));
+    ABTS_PTR_EQUAL(tc, NULL,
+            amf_ue_find_by_supi((char *)"imsi-001010000000001"));
+    ABTS_PTR_NOTNULL(tc,
+            amf_ue_find_by_supi((char *)"imsi-001010000000002"));
+
+    /* A UE without a valid security context at the mark is dropped */
+    amf_ue2 = amf_ue_find_by_supi((char *)"imsi-001010000000002");
+    ABTS_PTR_NOTNULL(tc, amf_ue2);
+    amf_ue2->mac_failed = 1;
+    amf_ue2->dl_count = amf_ue2->snapshot.dl_count;
+    amf_snapshot_update(amf_ue2);
+    ABTS_TRUE(tc, !amf_ue2->snapshot.stored);
+
+    snapshot_restart();
+    ABTS_INT_EQUAL(tc, 0, ogs_list_count(&amf_self()->amf_ue_list));
+
+    snapshot_teardown();
+}
+
+static void snapshot_test3(abts_case *tc, void *data)
+{
+    amf_ue_t *amf_ue = NULL;
+    uint64_t end = 0, first = 0, length;
+    size_t size = 16*1024;
+    int i, n;
+
+    snapshot_setup(size);
+
+    amf_ue = snapshot_ue_add("imsi-001010000000001", "suci-0-001-01-0-0-0-1");
+    amf_snapshot_store(amf_ue);
+    snapshot_pread(&first, sizeof(first), SNAPSHOT_HEADER_END);
+    ABTS_TRUE(tc, first > SNAPSHOT_FIRST_RECORD);
+    length = first - SNAPSHOT_FIRST_RECORD;
+
+    /* Filling up the file rewrites it with one record per UE */
+    n = 10 * size / length;
+    for (i = 0; i < n; i++) {
+        amf_ue->dl_count++;
+        amf_snapshot_store(amf_ue);
+        ABTS_TRUE(tc, amf_ue->snapshot.stored);
+    }
+    snapshot_pread(&end, sizeof(end), SNAPSHOT_HEADER_END);
+    ABTS_TRUE(tc, end < size);
+    ABTS_TRUE(tc, end >= first);
+    ABTS_INT_EQUAL(tc, 0, (end - SNAPSHOT_FIRST_RECORD) % length);
+
+    snapshot_restart();
+    ABTS_INT_EQUAL(tc, 1, ogs_list_count(&amf_self()->amf_ue_list));
+    amf_ue = amf_ue_find_by_supi((char *)"imsi-001010000000001");
+    ABTS_PTR_NOTNULL(tc, amf_ue);
+    ABTS_TRUE(tc, amf_ue->dl_count > 10 + n);
+
+    /* Nothing is left behind from the rewrite */
+    {
+        char *tmp = ogs_msprintf("%s.tmp", path);
+        ogs_assert(tmp);
+        ABTS_INT_EQUAL(tc, -1, access(tmp, F_OK));
+        ogs_free(tmp);
+    }
+
+    snapshot_teardown();
+}
+
+static void snapshot_test4(abts_case *tc, void *data)
+{
+    amf_ue_t *amf_ue1 = NULL, *amf_ue2 = NULL;
+    uint32_t magic = 0, length = 0, second = 0;
+    int fd;
+
+    /* Shorter than the file header */
+    snapshot_setup(1024*1024);
+    amf_snapshot_close();
+    fd = open(path, O_WRONLY|O_TRUNC);
+    ogs_assert(fd >= 0);
+    ogs_assert(write(fd, "AMFS", 4) == 4);
+    close(fd);
+    ABTS_INT_EQUAL(tc, OGS_OK, amf_snapshot_open());
+    ABTS_INT_EQUAL(tc, 0, ogs_list_count(&amf_self()->amf_ue_list));
+    snapshot_teardown();
+
+    /* Bad magic */
+    snapshot_setup(1024*1024);
+    amf_ue1 = snapshot_ue_add("imsi-001010000000001", "suci-0-001-01-0-0-0-1");
+    amf_snapshot_store(amf_ue1);
+    amf_snapshot_close();
+    snapshot_pread(&magic, sizeof(magic), 0);
+    magic ^= 0xff;
+    snapshot_pwrite(&magic, sizeof(magic), 0);
+    snapshot_restart();
+    ABTS_INT_EQUAL(tc, 0, ogs_list_count(&amf_self()->amf_ue_list));
+    snapshot_teardown();
+
+    /* Truncated below the end of the last record */
+    snapshot_setup(1024*1024);
+    amf_ue1 = snapshot_ue_add("imsi-001010000000001", "suci-0-001-01-0-0-0-1");
+    amf_snapshot_store(amf_ue1);
+    amf_snapshot_close();
+    snapshot_pread(&length, sizeof(length), SNAPSHOT_FIRST_RECORD);
+    ogs_assert(truncate(path, SNAPSHOT_FIRST_RECORD + length / 2) == 0);
+    snapshot_restart();
+    ABTS_INT_EQUAL(tc, 0, ogs_list_count(&amf_self()->amf_ue_list));
+    snapshot_teardown();
+
+    /* A corrupted record ends the replay, the ones before it are kept */
+    snapshot_setup(1024*1024);
+    amf_ue1 = snapshot_ue_add("imsi-001010000000001", "suci-0-001-01-0-0-0-1");
+    amf_ue2 = snapshot_ue_add("imsi-001010000000002", "suci-0-001-01-0-0-0-2");
+    amf_snapshot_store(amf_ue1);
+    amf_snapshot_store(amf_ue2);
+    amf_snapshot_close();
+    snapshot_pread(&length, sizeof(length), SNAPSHOT_FIRST_RECORD);
+    snapshot_pread(&second, sizeof(second), SNAPSHOT_FIRST_RECORD + length);
+    second += 4;
+    snapshot_pwrite(&second, sizeof(second), SNAPSHOT_FIRST_RECORD + length);
+    snapshot_restart();
+    ABTS_INT_EQUAL(tc, 1, ogs_list_count(&amf_self()->amf_ue_list));
+    ABTS_PTR_NOTNULL(tc,
+            amf_ue_find_by_supi((char *)"imsi-001010000000001"));
+    snapshot_teardown();
+
+    ogs_free(path);
+    path = NULL;
+}
+
+abts_suite *test_amf_snapshot(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, snapshot_test1, NULL);
+    abts_run_test(suite, snapshot_test2, NULL);
+    abts_run_test(suite, snapshot_test3, NULL);
+    abts_run_test(suite, snapshot_test4, NULL);
+
+    return suite;
+}
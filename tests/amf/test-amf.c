@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "test-amf.h"
+#include "amf/metrics.h"
+
+int test_amf_init(void)
+{
+    int rv;
+
+    ogs_sctp_init(ogs_app()->usrsctp.udp_port);
+
+    amf_metrics_init();
+
+    ogs_sbi_context_init(OpenAPI_nf_type_AMF);
+    amf_context_init();
+
+    rv = ogs_sbi_context_parse_config("amf", "nrf", "scp");
+    if (rv != OGS_OK) return rv;
+
+    rv = amf_context_parse_config();
+    if (rv != OGS_OK) return rv;
+
+    return OGS_OK;
+}
+
+void test_amf_final(void)
+{
+    amf_context_final();
+    ogs_sbi_context_final();
+
+    amf_metrics_final();
+
+    ogs_sctp_final();
+}
+
+/*
+ * A gNB on an unconnected TCP socket: everything the AMF sends to it
+ * stays in gnb->sctp.write_queue until ogs_sctp_flush_all().
+ */
+amf_gnb_t *test_amf_gnb_add(uint32_t gnb_id)
+{
+    ogs_sock_t *sock = NULL;
+    ogs_sockaddr_t *addr = NULL;
+    amf_gnb_t *gnb = NULL;
+
+    sock = ogs_sock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    ogs_assert(sock);
+
+    addr = ogs_calloc(1, sizeof(*addr));
+    ogs_assert(addr);
+    addr->ogs_sa_family = AF_INET;
+    addr->sin.sin_addr.s_addr = htobe32(0x7f000100 + gnb_id);
+    addr->ogs_sin_port = htobe16(OGS_NGAP_SCTP_PORT);
+
+    gnb = amf_gnb_add(sock, addr);
+    ogs_assert(gnb);
+    ogs_assert(gnb->sctp.type == SOCK_STREAM);
+
+    amf_gnb_set_gnb_id(gnb, gnb_id);
+    gnb->max_num_of_ostreams = OGS_DEFAULT_SCTP_MAX_NUM_OF_OSTREAMS;
+
+    return gnb;
+}
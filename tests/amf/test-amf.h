@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_AMF_H
+#define TEST_AMF_H
+
+#include "amf/context.h"
+#include "core/abts.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int test_amf_init(void);
+void test_amf_final(void);
+
+amf_gnb_t *test_amf_gnb_add(uint32_t gnb_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TEST_AMF_H */
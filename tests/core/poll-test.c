@@ -341,6 +341,60 @@ static void test5_func(abts_case *tc, void *data)
     ogs_pollset_destroy(pollset);
 }
 
+static int test5b_called = 0;
+static void test5b_handler(void *data)
+{
+    int *called = data;
+    (*called)++;
+}
+
+static void test5b_main(void *data)
+{
+    ogs_pollset_t *pollset = data;
+    ogs_pollset_notify(pollset);
+}
+
+static void test5b_func(abts_case *tc, void *data)
+{
+    int rv;
+    ogs_thread_t *thread = NULL;
+    ogs_pollset_t *pollset = ogs_pollset_create(512);
+    ABTS_PTR_NOTNULL(tc, pollset);
+
+    ogs_notify_set_handler(pollset, test5b_handler, &test5b_called);
+
+    /* Woken up from another thread */
+    thread = ogs_thread_create(test5b_main, pollset);
+    ABTS_PTR_NOTNULL(tc, thread);
+    rv = ogs_pollset_poll(pollset, OGS_INFINITE_TIME);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    ogs_thread_destroy(thread);
+    ABTS_INT_EQUAL(tc, 1, test5b_called);
+
+    /* Not called without a wakeup */
+    rv = ogs_pollset_poll(pollset, ogs_time_from_msec(100));
+    ABTS_INT_EQUAL(tc, OGS_TIMEUP, rv);
+    ABTS_INT_EQUAL(tc, 1, test5b_called);
+
+    /* Several notifications before the poll are one wakeup */
+    rv = ogs_pollset_notify(pollset);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    rv = ogs_pollset_notify(pollset);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    rv = ogs_pollset_poll(pollset, ogs_time_from_msec(100));
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    ABTS_INT_EQUAL(tc, 2, test5b_called);
+
+    ogs_notify_set_handler(pollset, NULL, NULL);
+    rv = ogs_pollset_notify(pollset);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    rv = ogs_pollset_poll(pollset, ogs_time_from_msec(100));
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    ABTS_INT_EQUAL(tc, 2, test5b_called);
+
+    ogs_pollset_destroy(pollset);
+}
+
 static int test6_okay = 1;
 static void test6_handler(short when, ogs_socket_t fd, void *data)
 {
@@ -669,6 +723,7 @@ abts_suite *test_poll(abts_suite *suite)
     abts_run_test(suite, test3_func, NULL);
     abts_run_test(suite, test4_func, NULL);
     abts_run_test(suite, test5_func, NULL);
+    abts_run_test(suite, test5b_func, NULL);
     abts_run_test(suite, test6_func, NULL);
     abts_run_test(suite, test7_func, NULL);
     abts_run_test(suite, test8_func, NULL);
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-core.h"
+#include "core/abts.h"
+
+#define NUM_OF_WORKER       4
+#define NUM_OF_JOB          64
+
+typedef struct test_job_s {
+    ogs_worker_job_t h;
+
+    int input;
+    int output;
+} test_job_t;
+
+static ogs_queue_t *done_queue;
+static volatile int blocked;
+static int num_of_free;
+
+static void test_run(ogs_worker_job_t *h)
+{
+    test_job_t *job = (test_job_t *)h;
+
+    while (blocked)
+        ogs_msleep(1);
+
+    job->output = job->input * 2;
+}
+
+static int test_done(ogs_worker_job_t *h)
+{
+    return ogs_queue_push(done_queue, h);
+}
+
+static void test_free(ogs_worker_job_t *h)
+{
+    num_of_free++;
+    ogs_free(h);
+}
+
+static test_job_t *test_job_new(int input)
+{
+    test_job_t *job = ogs_calloc(1, sizeof(*job));
+    ogs_assert(job);
+
+    job->input = input;
+
+    return job;
+}
+
+static void worker_test1(abts_case *tc, void *data)
+{
+    ogs_worker_pool_t *pool = NULL;
+    test_job_t *job = NULL;
+    int sum = 0;
+    int i, rv;
+
+    done_queue = ogs_queue_create(NUM_OF_JOB);
+    ABTS_PTR_NOTNULL(tc, done_queue);
+
+    pool = ogs_worker_pool_create(NUM_OF_WORKER, NUM_OF_JOB,
+            test_run, test_done, test_free);
+    ABTS_PTR_NOTNULL(tc, pool);
+
+    for (i = 0; i < NUM_OF_JOB; i++) {
+        rv = ogs_worker_pool_submit(pool, &test_job_new(i)->h);
+        ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    }
+
+    /* Every job comes back once */
+    for (i = 0; i < NUM_OF_JOB; i++) {
+        rv = ogs_queue_pop(done_queue, (void **)&job);
+        ABTS_INT_EQUAL(tc, OGS_OK, rv);
+
+        ABTS_INT_EQUAL(tc, job->input * 2, job->output);
+        ABTS_TRUE(tc, job->h.submitted <= job->h.started);
+        ABTS_TRUE(tc, job->h.started <= job->h.finished);
+        sum += job->input;
+
+        ogs_worker_pool_complete(pool, &job->h);
+        ogs_free(job);
+    }
+    ABTS_INT_EQUAL(tc, NUM_OF_JOB * (NUM_OF_JOB - 1) / 2, sum);
+
+    num_of_free = 0;
+    ogs_worker_pool_destroy(pool);
+    ABTS_INT_EQUAL(tc, 0, num_of_free);
+
+    ogs_queue_destroy(done_queue);
+}
+
+static void worker_test2(abts_case *tc, void *data)
+{
+    ogs_worker_pool_t *pool = NULL;
+    test_job_t *job = NULL;
+    int submitted = 0, rejected = 0;
+    int i, rv;
+
+    done_queue = ogs_queue_create(8);
+    ABTS_PTR_NOTNULL(tc, done_queue);
+
+    /* One busy worker and room for two more jobs */
+    pool = ogs_worker_pool_create(1, 2, test_run, test_done, test_free);
+    ABTS_PTR_NOTNULL(tc, pool);
+
+    blocked = 1;
+
+    for (i = 0; i < 4; i++) {
+        job = test_job_new(i);
+        rv = ogs_worker_pool_submit(pool, &job->h);
+        if (rv == OGS_OK) {
+            submitted++;
+        } else {
+            /* A rejected job stays with the caller */
+            rejected++;
+            ogs_free(job);
+        }
+    }
+    ABTS_TRUE(tc, submitted >= 2);
+    ABTS_TRUE(tc, submitted <= 3);
+    ABTS_INT_EQUAL(tc, 4, submitted + rejected);
+
+    blocked = 0;
+
+    /* Completed one job and left the others with the pool */
+    rv = ogs_queue_pop(done_queue, (void **)&job);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    ogs_worker_pool_complete(pool, &job->h);
+    ogs_free(job);
+
+    num_of_free = 0;
+    ogs_worker_pool_destroy(pool);
+    ABTS_INT_EQUAL(tc, submitted - 1, num_of_free);
+
+    ogs_queue_destroy(done_queue);
+}
+
+abts_suite *test_worker(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, worker_test1, NULL);
+    abts_run_test(suite, worker_test2, NULL);
+
+    return suite;
+}
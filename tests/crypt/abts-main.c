@@ -25,6 +25,8 @@ abts_suite *test_aes(abts_suite *suite);
 abts_suite *test_sha(abts_suite *suite);
 abts_suite *test_base64(abts_suite *suite);
 abts_suite *test_ecies(abts_suite *suite);
+abts_suite *test_snow_3g(abts_suite *suite);
+abts_suite *test_zuc(abts_suite *suite);
 
 const struct testlist {
     abts_suite *(*func)(abts_suite *suite);
@@ -33,6 +35,8 @@ const struct testlist {
     {test_sha},
     {test_base64},
     {test_ecies},
+    {test_snow_3g},
+    {test_zuc},
     {NULL},
 };
 
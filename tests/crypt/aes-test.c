@@ -397,6 +397,117 @@ static void cmac_test(abts_case *tc, void *data)
     }
 }
 
+static const ogs_aes_backend_e aes_backend_list[] = {
+    OGS_AES_BACKEND_TABLE, OGS_AES_BACKEND_AESNI, OGS_AES_BACKEND_VAES,
+};
+
+static const char *aes_backend_name[] = { "table", "aes-ni", "vaes" };
+
+#define AES_TEST_LEN 1024
+
+static void aes_test_backend(abts_case *tc, void *data)
+{
+    uint32_t rk[OGS_AES_RKLENGTH(OGS_AES_MAX_KEY_BITS)];
+    uint8_t key[32], in[AES_TEST_LEN];
+    uint8_t expected[AES_TEST_LEN], out[AES_TEST_LEN];
+    uint8_t ivec[16], ivec_expected[16];
+    ogs_aes_backend_e saved;
+    int i, len, nrounds, keybits;
+
+    saved = ogs_aes_backend();
+
+    for (i = 0; i < sizeof(key); i++)
+        key[i] = i * 7 + 1;
+    for (i = 0; i < sizeof(in); i++)
+        in[i] = i * 13 + 5;
+
+    for (i = 1; i < OGS_ARRAY_SIZE(aes_backend_list); i++) {
+        if (ogs_aes_set_backend(aes_backend_list[i]) != OGS_OK)
+            continue;
+
+        /* Block cipher with every key size */
+        for (keybits = 128; keybits <= 256; keybits += 64) {
+            ABTS_INT_EQUAL(tc, OGS_OK,
+                    ogs_aes_set_backend(OGS_AES_BACKEND_TABLE));
+            nrounds = ogs_aes_setup_enc(rk, key, keybits);
+            ogs_aes_encrypt(rk, nrounds, in, expected);
+            nrounds = ogs_aes_setup_dec(rk, key, keybits);
+            ogs_aes_decrypt(rk, nrounds, in, expected + 16);
+
+            ABTS_INT_EQUAL(tc, OGS_OK,
+                    ogs_aes_set_backend(aes_backend_list[i]));
+            nrounds = ogs_aes_setup_enc(rk, key, keybits);
+            ogs_aes_encrypt(rk, nrounds, in, out);
+            nrounds = ogs_aes_setup_dec(rk, key, keybits);
+            ogs_aes_decrypt(rk, nrounds, in, out + 16);
+            ABTS_INT_EQUAL(tc, 0, memcmp(out, expected, 32));
+        }
+
+        /* CTR across the 64-bit counter boundary */
+        for (len = 1; len <= AES_TEST_LEN; len += 37) {
+            memset(ivec_expected, 0xff, 16);
+            ivec_expected[0] = 0x12;
+            ivec_expected[15] = 0xfd;
+            memcpy(ivec, ivec_expected, 16);
+
+            ABTS_INT_EQUAL(tc, OGS_OK,
+                    ogs_aes_set_backend(OGS_AES_BACKEND_TABLE));
+            ogs_aes_ctr128_encrypt(key, ivec_expected, in, len, expected);
+
+            ABTS_INT_EQUAL(tc, OGS_OK,
+                    ogs_aes_set_backend(aes_backend_list[i]));
+            ogs_aes_ctr128_encrypt(key, ivec, in, len, out);
+
+            ABTS_INT_EQUAL(tc, 0, memcmp(out, expected, len));
+            ABTS_INT_EQUAL(tc, 0, memcmp(ivec, ivec_expected, 16));
+        }
+    }
+
+    ABTS_INT_EQUAL(tc, OGS_OK, ogs_aes_set_backend(saved));
+}
+
+/* Run with '-e info' to see the numbers */
+static void aes_bench(abts_case *tc, void *data)
+{
+#define AES_BENCH_COUNT 20000
+    uint32_t rk[OGS_AES_RKLENGTH(128)];
+    uint8_t key[16], block[16], ivec[16], buf[AES_TEST_LEN];
+    ogs_aes_backend_e saved;
+    ogs_time_t start, block_time, ctr_time;
+    int i, j, nrounds;
+
+    saved = ogs_aes_backend();
+
+    memset(key, 0x2b, sizeof(key));
+    memset(block, 0, sizeof(block));
+    memset(ivec, 0, sizeof(ivec));
+    memset(buf, 0, sizeof(buf));
+
+    for (i = 0; i < OGS_ARRAY_SIZE(aes_backend_list); i++) {
+        if (ogs_aes_set_backend(aes_backend_list[i]) != OGS_OK)
+            continue;
+
+        nrounds = ogs_aes_setup_enc(rk, key, 128);
+
+        start = ogs_get_monotonic_time();
+        for (j = 0; j < AES_BENCH_COUNT; j++)
+            ogs_aes_encrypt(rk, nrounds, block, block);
+        block_time = ogs_get_monotonic_time() - start;
+
+        start = ogs_get_monotonic_time();
+        for (j = 0; j < AES_BENCH_COUNT / 64; j++)
+            ogs_aes_ctr128_encrypt(key, ivec, buf, sizeof(buf), buf);
+        ctr_time = ogs_get_monotonic_time() - start;
+
+        ogs_info("[%s] block %lld ns, ctr %lld MB/s", aes_backend_name[i],
+                (long long)(block_time * 1000 / AES_BENCH_COUNT),
+                ctr_time ? (long long)((AES_BENCH_COUNT / 64) *
+                    sizeof(buf) / ctr_time) : 0);
+    }
+
+    ABTS_INT_EQUAL(tc, OGS_OK, ogs_aes_set_backend(saved));
+}
+
 abts_suite *test_aes(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
@@ -405,6 +516,8 @@ abts_suite *test_aes(abts_suite *suite)
     abts_run_test(suite, aes_test2, NULL);
     abts_run_test(suite, aes_test3, NULL);
     abts_run_test(suite, cmac_test, NULL);
+    abts_run_test(suite, aes_test_backend, NULL);
+    abts_run_test(suite, aes_bench, NULL);
 
     return suite;
 }
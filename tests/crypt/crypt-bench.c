@@ -0,0 +1,807 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Throughput benchmark for lib/crypt.
+ *
+ * Every case runs for a fixed time per (backend, message size, threads)
+ * combination and the results are written as JSON, one object per run,
+ * so that two builds can be compared with a script.
+ *
+ * Usage: crypt-bench [-s 16,64,1500] [-t 1,4] [-d msec] [-f filter] [-o file]
+ */
+
+#include "ogs-crypt.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+#else
+#define BENCH_HAVE_TSC 0
+#endif
+
+#define BENCH_MAX_SIZES 16
+#define BENCH_MAX_THREADS 16
+#define BENCH_DEFAULT_DURATION 200  /* msec */
+#define BENCH_BATCH 8               /* operations between clock reads */
+
+typedef enum {
+    BENCH_BACKEND_NONE = 0,
+    BENCH_BACKEND_AES,
+    BENCH_BACKEND_SNOW_3G,
+    BENCH_BACKEND_ZUC,
+    BENCH_BACKEND_SHA256,
+    BENCH_BACKEND_ECDH,
+} bench_backend_e;
+
+typedef struct bench_state_s {
+    uint32_t size;
+    uint8_t *in;
+    uint8_t *out;
+
+    uint8_t key[16];
+    uint8_t ivec[16];
+    uint8_t opc[16];
+    uint8_t rand[16];
+    uint8_t sqn[OGS_SQN_LEN];
+    uint8_t amf[OGS_AMF_LEN];
+    uint8_t kamf[OGS_SHA256_DIGEST_SIZE];
+    ogs_kdf_key_t kdf_key;
+
+    uint32_t rk[OGS_AES_RKLENGTH(128)];
+    int nrounds;
+
+    uint8_t message[128];
+    uint8_t digest[OGS_SHA256_DIGEST_SIZE];
+    uint8_t scratch[5][OGS_SHA256_DIGEST_SIZE];
+} bench_state_t;
+
+typedef struct bench_case_s {
+    const char *name;
+    bench_backend_e backend;
+    bool sized;     /* run for every message size */
+    bool shared;    /* uses global state, single thread only */
+    void (*func)(bench_state_t *state);
+} bench_case_t;
+
+/* TS33.501 C.4.3, C.4.4 */
+static const char *x25519_private_key =
+    "c53c22208b61860b06c62e5406a7b330c2b577aa5558981510d128247d38bd1d";
+static const char *x25519_public_key =
+    "b2e92f836055a255837debf850b528997ce0201cb82adfe4be1f587d07d8457d";
+static const char *p256_private_key =
+    "F1AB1074477EBCC7F554EA1C5FC368B1616730155E0041AC447D6301975FECDA";
+static const char *p256_public_key =
+    "039AAB8376597021E855679A9778EA0B67396E68C66DF32C0F41E9ACCA2DA9B9D1";
+
+static uint8_t x25519_k[OGS_ECCKEY_LEN], x25519_e[OGS_ECCKEY_LEN];
+static uint8_t p256_k[OGS_ECCKEY_LEN], p256_e[OGS_ECCKEY_LEN+1];
+
+static char serving_network_name[] = "5G:mnc001.mcc001.3gppnetwork.org";
+static char supi[] = "imsi-001010000000001";
+
+static void bench_aes_ecb(bench_state_t *s)
+{
+    uint32_t i;
+
+    for (i = 0; i < s->size; i += OGS_AES_BLOCK_SIZE)
+        ogs_aes_encrypt(s->rk, s->nrounds, s->in + i, s->out + i);
+}
+
+static void bench_aes_cbc(bench_state_t *s)
+{
+    uint32_t outlen = s->size + OGS_AES_BLOCK_SIZE;
+
+    ogs_assert(ogs_aes_cbc_encrypt(s->key, 128, s->ivec,
+                s->in, s->size, s->out, &outlen) == OGS_OK);
+}
+
+static void bench_aes_ctr(bench_state_t *s)
+{
+    ogs_aes_ctr128_encrypt(s->key, s->ivec, s->in, s->size, s->out);
+}
+
+static void bench_aes_cmac(bench_state_t *s)
+{
+    ogs_aes_cmac_calculate(s->digest, s->key, s->in, s->size);
+}
+
+static void bench_snow_3g_f8(bench_state_t *s)
+{
+    snow_3g_f8(s->key, 0x398a59b4, 0x15, 1, s->in, s->size << 3);
+}
+
+static void bench_snow_3g_f9(bench_state_t *s)
+{
+    snow_3g_f9(s->key, 0x398a59b4, 0x15 << 27, 1,
+            s->in, (u64)s->size << 3, s->digest);
+}
+
+static void bench_zuc_eea3(bench_state_t *s)
+{
+    zuc_eea3(s->key, 0x398a59b4, 0x15, 1, s->size << 3, s->in, s->out);
+}
+
+static void bench_zuc_eia3(bench_state_t *s)
+{
+    zuc_eia3(s->key, 0x398a59b4, 0x15, 1,
+            s->size << 3, s->in, (u32 *)s->digest);
+}
+
+static void bench_kasumi_f8(bench_state_t *s)
+{
+    kasumi_f8(s->key, 0x398a59b4, 0x15, 1, s->in, s->size << 3);
+}
+
+static void bench_kasumi_f9(bench_state_t *s)
+{
+    kasumi_f9(s->key, 0x398a59b4, 0x05d2c1b7, 1, s->in, s->size << 3);
+}
+
+static void bench_sha1(bench_state_t *s)
+{
+    ogs_sha1(s->in, s->size, s->digest);
+}
+
+static void bench_sha256(bench_state_t *s)
+{
+    ogs_sha256(s->in, s->size, s->digest);
+}
+
+static void bench_hmac_sha1(bench_state_t *s)
+{
+    ogs_hmac_sha1(s->key, sizeof(s->key),
+            s->in, s->size, s->digest, OGS_SHA1_DIGEST_SIZE);
+}
+
+static void bench_hmac_sha256(bench_state_t *s)
+{
+    ogs_hmac_sha256(s->kamf, sizeof(s->kamf),
+            s->in, s->size, s->digest, OGS_SHA256_DIGEST_SIZE);
+}
+
+static void bench_milenage_opc(bench_state_t *s)
+{
+    milenage_opc(s->key, s->rand, s->opc);
+}
+
+static void bench_milenage_f1(bench_state_t *s)
+{
+    milenage_f1(s->opc, s->key, s->rand, s->sqn, s->amf,
+            s->scratch[0], s->scratch[1]);
+}
+
+static void bench_milenage_f2345(bench_state_t *s)
+{
+    milenage_f2345(s->opc, s->key, s->rand, s->scratch[0],
+            s->scratch[1], s->scratch[2], s->scratch[3], s->scratch[4]);
+}
+
+static void bench_milenage_generate(bench_state_t *s)
+{
+    size_t res_len;
+
+    milenage_generate(s->opc, s->amf, s->key, s->sqn, s->rand,
+            s->scratch[0], s->scratch[1], s->scratch[2], s->scratch[3],
+            s->scratch[4], &res_len);
+}
+
+static void bench_kdf_key_init(bench_state_t *s)
+{
+    ogs_kdf_key_init(&s->kdf_key, s->kamf, sizeof(s->kamf));
+}
+
+static void bench_kdf_kausf(bench_state_t *s)
+{
+    ogs_kdf_kausf(s->key, s->ivec, serving_network_name,
+            s->rand, s->digest);
+}
+
+static void bench_kdf_xres_star(bench_state_t *s)
+{
+    ogs_kdf_xres_star(s->key, s->ivec, serving_network_name, s->rand,
+            s->opc, 8, s->digest);
+}
+
+static void bench_kdf_hxres_star(bench_state_t *s)
+{
+    ogs_kdf_hxres_star(s->rand, s->opc, s->digest);
+}
+
+static void bench_kdf_kseaf(bench_state_t *s)
+{
+    ogs_kdf_kseaf(serving_network_name, s->kamf, s->digest);
+}
+
+static void bench_kdf_kamf(bench_state_t *s)
+{
+    uint8_t abba[2] = { 0, 0 };
+
+    ogs_kdf_kamf(supi, abba, sizeof(abba), s->kamf, s->digest);
+}
+
+static void bench_kdf_nas_5gs(bench_state_t *s)
+{
+    ogs_kdf_nas_5gs(OGS_KDF_NAS_INT_ALG, 2, s->kamf, s->digest);
+}
+
+static void bench_kdf_nas_5gs_from_key(bench_state_t *s)
+{
+    ogs_kdf_nas_5gs_from_key(OGS_KDF_NAS_INT_ALG, 2, &s->kdf_key, s->digest);
+}
+
+static void bench_kdf_kgnb_and_kn3iwf(bench_state_t *s)
+{
+    ogs_kdf_kgnb_and_kn3iwf(s->kamf, 0, 1, s->digest);
+}
+
+static void bench_kdf_kgnb_and_kn3iwf_from_key(bench_state_t *s)
+{
+    ogs_kdf_kgnb_and_kn3iwf_from_key(&s->kdf_key, 0, 1, s->digest);
+}
+
+static void bench_kdf_nh_gnb(bench_state_t *s)
+{
+    ogs_kdf_nh_gnb(s->kamf, s->scratch[0], s->digest);
+}
+
+static void bench_kdf_nh_gnb_from_key(bench_state_t *s)
+{
+    ogs_kdf_nh_gnb_from_key(&s->kdf_key, s->scratch[0], s->digest);
+}
+
+static void bench_kdf_ansi_x963(bench_state_t *s)
+{
+    ogs_kdf_ansi_x963(s->kamf, OGS_ECCKEY_LEN, x25519_e, OGS_ECCKEY_LEN,
+            s->scratch[0], s->scratch[1], s->scratch[2]);
+}
+
+static void bench_auc_kasme(bench_state_t *s)
+{
+    uint8_t plmn_id[3] = { 0x00, 0xf1, 0x10 };
+
+    ogs_auc_kasme(s->key, s->ivec, plmn_id, s->sqn, s->scratch[0], s->digest);
+}
+
+static void bench_kdf_kenb(bench_state_t *s)
+{
+    ogs_kdf_kenb(s->kamf, 0, s->digest);
+}
+
+static void bench_kdf_kenb_from_key(bench_state_t *s)
+{
+    ogs_kdf_kenb_from_key(&s->kdf_key, 0, s->digest);
+}
+
+static void bench_kdf_nh_enb(bench_state_t *s)
+{
+    ogs_kdf_nh_enb(s->kamf, s->scratch[0], s->digest);
+}
+
+static void bench_kdf_nh_enb_from_key(bench_state_t *s)
+{
+    ogs_kdf_nh_enb_from_key(&s->kdf_key, s->scratch[0], s->digest);
+}
+
+static void bench_kdf_nas_eps(bench_state_t *s)
+{
+    ogs_kdf_nas_eps(OGS_KDF_NAS_INT_ALG, 2, s->kamf, s->digest);
+}
+
+static void bench_kdf_nas_eps_from_key(bench_state_t *s)
+{
+    ogs_kdf_nas_eps_from_key(OGS_KDF_NAS_INT_ALG, 2, &s->kdf_key, s->digest);
+}
+
+static void bench_kdf_hash_mme(bench_state_t *s)
+{
+    ogs_kdf_hash_mme(s->message, sizeof(s->message), s->digest);
+}
+
+static void bench_auc_sqn(bench_state_t *s)
+{
+    ogs_auc_sqn(s->opc, s->key, s->rand, s->sqn,
+            s->scratch[0], s->scratch[1]);
+}
+
+static void bench_ecdh_x25519(bench_state_t *s)
+{
+    ogs_assert(ogs_ecdh_x25519(s->digest, x25519_k, x25519_e) == OGS_OK);
+}
+
+static void bench_ecdh_p256(bench_state_t *s)
+{
+    ogs_assert(ogs_ecdh_p256(s->digest, p256_k, p256_e) == OGS_OK);
+}
+
+/*
+ * SUCI de-concealment without the string handling:
+ * key agreement, ANSI-X9.63 KDF, MAC-tag and AES-128-CTR on a 5-byte MSIN
+ */
+static void bench_ecies_profile_a(bench_state_t *s)
+{
+    ogs_assert(ogs_ecdh_x25519(s->scratch[0], x25519_k, x25519_e) == OGS_OK);
+    ogs_kdf_ansi_x963(s->scratch[0], OGS_ECCKEY_LEN, x25519_e, OGS_ECCKEY_LEN,
+            s->scratch[1], s->scratch[2], s->scratch[3]);
+    ogs_hmac_sha256(s->scratch[3], OGS_SHA256_DIGEST_SIZE, s->message, 5,
+            s->digest, OGS_MACTAG_LEN);
+    ogs_aes_ctr128_encrypt(s->scratch[1], s->scratch[2],
+            s->message, 5, s->message);
+}
+
+static void bench_ecies_profile_b(bench_state_t *s)
+{
+    ogs_assert(ogs_ecdh_p256(s->scratch[0], p256_k, p256_e) == OGS_OK);
+    ogs_kdf_ansi_x963(s->scratch[0], OGS_ECCKEY_LEN, p256_e, OGS_ECCKEY_LEN+1,
+            s->scratch[1], s->scratch[2], s->scratch[3]);
+    ogs_hmac_sha256(s->scratch[3], OGS_SHA256_DIGEST_SIZE, s->message, 5,
+            s->digest, OGS_MACTAG_LEN);
+    ogs_aes_ctr128_encrypt(s->scratch[1], s->scratch[2],
+            s->message, 5, s->message);
+}
+
+static const bench_case_t bench_case_list[] = {
+    { "aes-128-ecb", BENCH_BACKEND_AES, true, false, bench_aes_ecb },
+    { "aes-128-cbc", BENCH_BACKEND_AES, true, false, bench_aes_cbc },
+    { "aes-128-ctr", BENCH_BACKEND_AES, true, false, bench_aes_ctr },
+    { "aes-cmac", BENCH_BACKEND_AES, true, false, bench_aes_cmac },
+    { "snow-3g-f8", BENCH_BACKEND_SNOW_3G, true, false, bench_snow_3g_f8 },
+    { "snow-3g-f9", BENCH_BACKEND_SNOW_3G, true, false, bench_snow_3g_f9 },
+    { "zuc-eea3", BENCH_BACKEND_ZUC, true, false, bench_zuc_eea3 },
+    { "zuc-eia3", BENCH_BACKEND_ZUC, true, false, bench_zuc_eia3 },
+    { "kasumi-f8", BENCH_BACKEND_NONE, true, true, bench_kasumi_f8 },
+    { "kasumi-f9", BENCH_BACKEND_NONE, true, true, bench_kasumi_f9 },
+    { "sha1", BENCH_BACKEND_NONE, true, false, bench_sha1 },
+    { "sha256", BENCH_BACKEND_SHA256, true, false, bench_sha256 },
+    { "hmac-sha1", BENCH_BACKEND_NONE, true, false, bench_hmac_sha1 },
+    { "hmac-sha256", BENCH_BACKEND_SHA256, true, false, bench_hmac_sha256 },
+    { "milenage-opc", BENCH_BACKEND_AES, false, false, bench_milenage_opc },
+    { "milenage-f1", BENCH_BACKEND_AES, false, false, bench_milenage_f1 },
+    { "milenage-f2345", BENCH_BACKEND_AES, false, false,
+        bench_milenage_f2345 },
+    { "milenage-generate", BENCH_BACKEND_AES, false, false,
+        bench_milenage_generate },
+    { "kdf-key-init", BENCH_BACKEND_SHA256, false, false,
+        bench_kdf_key_init },
+    { "kdf-kausf", BENCH_BACKEND_SHA256, false, false, bench_kdf_kausf },
+    { "kdf-xres-star", BENCH_BACKEND_SHA256, false, false,
+        bench_kdf_xres_star },
+    { "kdf-hxres-star", BENCH_BACKEND_SHA256, false, false,
+        bench_kdf_hxres_star },
+    { "kdf-kseaf", BENCH_BACKEND_SHA256, false, false, bench_kdf_kseaf },
+    { "kdf-kamf", BENCH_BACKEND_SHA256, false, false, bench_kdf_kamf },
+    { "kdf-nas-5gs", BENCH_BACKEND_SHA256, false, false,
+        bench_kdf_nas_5gs },
+    { "kdf-nas-5gs-from-key", BENCH_BACKEND_SHA256, false, false,
+        bench_kdf_nas_5gs_from_key },
+    { "kdf-kgnb-and-kn3iwf", BENCH_BACKEND_SHA256, false, false,
+        bench_kdf_kgnb_and_kn3iwf },
+    { "kdf-kgnb-and-kn3iwf-from-key", BENCH_BACKEND_SHA256, false, false,
+        bench_kdf_kgnb_and_kn3iwf_from_key },
+    { "kdf-nh-gnb", BENCH_BACKEND_SHA256, false, false, bench_kdf_nh_gnb },
+    { "kdf-nh-gnb-from-key", BENCH_BACKEND_SHA256, false, false,
+        bench_kdf_nh_gnb_from_key },
+    { "kdf-ansi-x963", BENCH_BACKEND_SHA256, false, false,
+        bench_kdf_ansi_x963 },
+    { "auc-kasme", BENCH_BACKEND_SHA256, false, false, bench_auc_kasme },
+    { "kdf-kenb", BENCH_BACKEND_SHA256, false, false, bench_kdf_kenb },
+    { "kdf-kenb-from-key", BENCH_BACKEND_SHA256, false, false,
+        bench_kdf_kenb_from_key },
+    { "kdf-nh-enb", BENCH_BACKEND_SHA256, false, false, bench_kdf_nh_enb },
+    { "kdf-nh-enb-from-key", BENCH_BACKEND_SHA256, false, false,
+        bench_kdf_nh_enb_from_key },
+    { "kdf-nas-eps", BENCH_BACKEND_SHA256, false, false,
+        bench_kdf_nas_eps },
+    { "kdf-nas-eps-from-key", BENCH_BACKEND_SHA256, false, false,
+        bench_kdf_nas_eps_from_key },
+    { "kdf-hash-mme", BENCH_BACKEND_SHA256, false, false,
+        bench_kdf_hash_mme },
+    { "auc-sqn", BENCH_BACKEND_AES, false, false, bench_auc_sqn },
+    { "ecdh-x25519", BENCH_BACKEND_ECDH, false, false, bench_ecdh_x25519 },
+    { "ecdh-p256", BENCH_BACKEND_ECDH, false, false, bench_ecdh_p256 },
+    { "ecies-profile-a", BENCH_BACKEND_ECDH, false, false,
+        bench_ecies_profile_a },
+    { "ecies-profile-b", BENCH_BACKEND_ECDH, false, false,
+        bench_ecies_profile_b },
+};
+
+static int bench_backend(bench_backend_e family)
+{
+    switch (family) {
+    case BENCH_BACKEND_AES:
+        return ogs_aes_backend();
+    case BENCH_BACKEND_SNOW_3G:
+        return snow_3g_backend();
+    case BENCH_BACKEND_ZUC:
+        return zuc_backend();
+    case BENCH_BACKEND_SHA256:
+        return ogs_sha256_backend();
+    case BENCH_BACKEND_ECDH:
+        return ogs_ecdh_backend();
+    default:
+        return 0;
+    }
+}
+
+/*
+ * Selects the i-th backend of the family. Returns OGS_ERROR if it is not
+ * available on this CPU or build, and OGS_DONE past the end of the list.
+ */
+static int bench_set_backend(bench_backend_e family, int i, const char **name)
+{
+    static const char *aes_name[] = { "table", "aesni", "vaes" };
+    static const char *snow_3g_name[] = { "portable", "pclmul" };
+    static const char *zuc_name[] = { "portable", "pclmul" };
+    static const char *sha256_name[] = { "portable", "shani" };
+    static const char *ecdh_name[] = { "builtin", "openssl" };
+
+    switch (family) {
+    case BENCH_BACKEND_AES:
+        if (i >= OGS_ARRAY_SIZE(aes_name)) return OGS_DONE;
+        *name = aes_name[i];
+        return ogs_aes_set_backend((ogs_aes_backend_e)i);
+    case BENCH_BACKEND_SNOW_3G:
+        if (i >= OGS_ARRAY_SIZE(snow_3g_name)) return OGS_DONE;
+        *name = snow_3g_name[i];
+        return snow_3g_set_backend((snow_3g_backend_e)i);
+    case BENCH_BACKEND_ZUC:
+        if (i >= OGS_ARRAY_SIZE(zuc_name)) return OGS_DONE;
+        *name = zuc_name[i];
+        return zuc_set_backend((zuc_backend_e)i);
+    case BENCH_BACKEND_SHA256:
+        if (i >= OGS_ARRAY_SIZE(sha256_name)) return OGS_DONE;
+        *name = sha256_name[i];
+        return ogs_sha256_set_backend((ogs_sha256_backend_e)i);
+    case BENCH_BACKEND_ECDH:
+        if (i >= OGS_ARRAY_SIZE(ecdh_name)) return OGS_DONE;
+        *name = ecdh_name[i];
+        return ogs_ecdh_set_backend((ogs_ecdh_backend_e)i);
+    default:
+        if (i > 0) return OGS_DONE;
+        *name = "default";
+        return OGS_OK;
+    }
+}
+
+typedef struct bench_worker_s {
+    const bench_case_t *bc;
+    bench_state_t state;
+
+    uint64_t ops;
+    uint64_t cycles;
+    ogs_time_t elapsed;
+} bench_worker_t;
+
+static struct {
+    ogs_thread_mutex_t mutex;
+    ogs_thread_cond_t cond;
+    bool go;
+    ogs_time_t deadline;
+} bench_sync;
+
+static uint64_t bench_cycles(void)
+{
+#if BENCH_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static void bench_state_init(bench_state_t *s, uint32_t size)
+{
+    int i;
+
+    memset(s, 0, sizeof(*s));
+
+    s->size = size;
+    /* Room for the CBC padding and whole AES blocks */
+    s->in = ogs_calloc(1, size + OGS_AES_BLOCK_SIZE);
+    ogs_assert(s->in);
+    s->out = ogs_calloc(1, size + OGS_AES_BLOCK_SIZE);
+    ogs_assert(s->out);
+
+    for (i = 0; i < size; i++)
+        s->in[i] = (uint8_t)(i * 7 + 1);
+    for (i = 0; i < sizeof(s->key); i++) {
+        s->key[i] = (uint8_t)(0x2b + i);
+        s->ivec[i] = (uint8_t)(0xf0 + i);
+        s->rand[i] = (uint8_t)(0x23 + i * 3);
+    }
+    for (i = 0; i < sizeof(s->kamf); i++)
+        s->kamf[i] = (uint8_t)(0x5a ^ i);
+
+    milenage_opc(s->key, s->rand, s->opc);
+    s->sqn[OGS_SQN_LEN-1] = 0x20;
+    s->amf[0] = 0x80;
+    ogs_kdf_key_init(&s->kdf_key, s->kamf, sizeof(s->kamf));
+    s->nrounds = ogs_aes_setup_enc(s->rk, s->key, 128);
+}
+
+static void bench_state_final(bench_state_t *s)
+{
+    ogs_free(s->in);
+    ogs_free(s->out);
+}
+
+static void bench_worker_main(void *data)
+{
+    bench_worker_t *worker = data;
+    bench_state_t *s = NULL;
+    ogs_time_t start, now, deadline;
+    uint64_t cycles;
+    int i;
+
+    ogs_assert(worker);
+    s = &worker->state;
+
+    /* Warm up caches and lazily initialised tables */
+    for (i = 0; i < BENCH_BATCH; i++)
+        worker->bc->func(s);
+
+    ogs_thread_mutex_lock(&bench_sync.mutex);
+    while (!bench_sync.go)
+        ogs_thread_cond_wait(&bench_sync.cond, &bench_sync.mutex);
+    deadline = bench_sync.deadline;
+    ogs_thread_mutex_unlock(&bench_sync.mutex);
+
+    start = ogs_get_monotonic_time();
+    cycles = bench_cycles();
+    do {
+        for (i = 0; i < BENCH_BATCH; i++)
+            worker->bc->func(s);
+        worker->ops += BENCH_BATCH;
+        now = ogs_get_monotonic_time();
+    } while (now < deadline);
+
+    worker->cycles = bench_cycles() - cycles;
+    worker->elapsed = now - start;
+}
+
+static void bench_run(FILE *out, bool *first, const bench_case_t *bc,
+        const char *backend, uint32_t size, int threads,
+        ogs_time_t duration)
+{
+    bench_worker_t worker[BENCH_MAX_THREADS];
+    ogs_thread_t *thread[BENCH_MAX_THREADS];
+    double ops_per_sec = 0, seconds = 0;
+    uint64_t ops = 0, cycles = 0;
+    int i;
+
+    memset(worker, 0, sizeof(worker));
+
+    bench_sync.go = false;
+    for (i = 0; i < threads; i++) {
+        worker[i].bc = bc;
+        bench_state_init(&worker[i].state, size);
+        thread[i] = ogs_thread_create(bench_worker_main, &worker[i]);
+        ogs_assert(thread[i]);
+    }
+
+    ogs_thread_mutex_lock(&bench_sync.mutex);
+    bench_sync.deadline = ogs_get_monotonic_time() + duration;
+    bench_sync.go = true;
+    ogs_thread_cond_broadcast(&bench_sync.cond);
+    ogs_thread_mutex_unlock(&bench_sync.mutex);
+
+    ogs_usleep(duration);
+
+    for (i = 0; i < threads; i++) {
+        ogs_thread_destroy(thread[i]);
+
+        ops += worker[i].ops;
+        cycles += worker[i].cycles;
+        if (worker[i].elapsed) {
+            ops_per_sec += (double)worker[i].ops * OGS_USEC_PER_SEC /
+                worker[i].elapsed;
+            if (worker[i].elapsed > seconds * OGS_USEC_PER_SEC)
+                seconds = (double)worker[i].elapsed / OGS_USEC_PER_SEC;
+        }
+
+        bench_state_final(&worker[i].state);
+    }
+
+    fprintf(out, "%s\n    {\"name\": \"%s\", \"backend\": \"%s\", "
+            "\"size\": %u, \"threads\": %d, \"ops\": %llu, "
+            "\"seconds\": %.6f, \"ops_per_sec\": %.1f",
+            *first ? "" : ",", bc->name, backend, size, threads,
+            (unsigned long long)ops, seconds, ops_per_sec);
+    if (bc->sized)
+        fprintf(out, ", \"bytes_per_sec\": %.0f", ops_per_sec * size);
+    if (BENCH_HAVE_TSC && ops) {
+        fprintf(out, ", \"cycles_per_op\": %.1f", (double)cycles / ops);
+        if (bc->sized)
+            fprintf(out, ", \"cycles_per_byte\": %.3f",
+                    (double)cycles / ops / size);
+    }
+    fprintf(out, "}");
+    fflush(out);
+
+    *first = false;
+}
+
+static int bench_parse_list(char *str, int *list, int max)
+{
+    char *token, *saveptr = NULL;
+    int num = 0;
+
+    for (token = ogs_strtok_r(str, ",", &saveptr); token;
+            token = ogs_strtok_r(NULL, ",", &saveptr)) {
+        if (num == max || atoi(token) <= 0)
+            return -1;
+        list[num++] = atoi(token);
+    }
+
+    return num;
+}
+
+static void bench_usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "Options:\n"
+        "   -s sizes    : message sizes in bytes (default 16,64,256,1500,8192)\n"
+        "   -t threads  : thread counts (default 1 and the number of CPUs)\n"
+        "   -d msec     : time per run (default %d)\n"
+        "   -f filter   : only cases whose name contains filter\n"
+        "   -o file     : write JSON to file instead of stdout\n"
+        "   -h          : show this help\n",
+        name, BENCH_DEFAULT_DURATION);
+}
+
+static void terminate(void)
+{
+    ogs_pkbuf_default_destroy();
+    ogs_core_terminate();
+}
+
+int main(int argc, const char *const argv[])
+{
+    int opt, i, j, k, b, rv;
+    ogs_getopt_t options;
+    ogs_pkbuf_config_t config;
+
+    int size[BENCH_MAX_SIZES] = { 16, 64, 256, 1500, 8192 };
+    int num_of_size = 5;
+    int threads[BENCH_MAX_THREADS] = { 1 };
+    int num_of_threads = 1;
+    ogs_time_t duration = ogs_time_from_msec(BENCH_DEFAULT_DURATION);
+    const char *filter = NULL, *output = NULL, *backend = NULL;
+    FILE *out = stdout;
+    bool first = true;
+    long cpus = 1;
+
+#if defined(_SC_NPROCESSORS_ONLN)
+    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (cpus > 1)
+        threads[num_of_threads++] = ogs_min(cpus, BENCH_MAX_THREADS);
+
+    ogs_getopt_init(&options, (char**)argv);
+    while ((opt = ogs_getopt(&options, "s:t:d:f:o:h")) != -1) {
+        switch (opt) {
+        case 's':
+            num_of_size = bench_parse_list(
+                    options.optarg, size, BENCH_MAX_SIZES);
+            if (num_of_size <= 0) {
+                fprintf(stderr, "Invalid sizes\n");
+                return EXIT_FAILURE;
+            }
+            break;
+        case 't':
+            num_of_threads = bench_parse_list(
+                    options.optarg, threads, BENCH_MAX_THREADS);
+            if (num_of_threads <= 0) {
+                fprintf(stderr, "Invalid thread counts\n");
+                return EXIT_FAILURE;
+            }
+            for (i = 0; i < num_of_threads; i++) {
+                if (threads[i] > BENCH_MAX_THREADS) {
+                    fprintf(stderr, "At most %d threads\n",
+                            BENCH_MAX_THREADS);
+                    return EXIT_FAILURE;
+                }
+            }
+            break;
+        case 'd':
+            if (atoi(options.optarg) <= 0) {
+                fprintf(stderr, "Invalid duration\n");
+                return EXIT_FAILURE;
+            }
+            duration = ogs_time_from_msec(atoi(options.optarg));
+            break;
+        case 'f':
+            filter = options.optarg;
+            break;
+        case 'o':
+            output = options.optarg;
+            break;
+        case 'h':
+            bench_usage(argv[0]);
+            return EXIT_SUCCESS;
+        case '?':
+        default:
+            bench_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    ogs_core_initialize();
+    ogs_pkbuf_default_init(&config);
+    ogs_pkbuf_default_create(&config);
+    atexit(terminate);
+
+    ogs_thread_mutex_init(&bench_sync.mutex);
+    ogs_thread_cond_init(&bench_sync.cond);
+
+    ogs_hex_from_string(x25519_private_key, x25519_k, sizeof(x25519_k));
+    ogs_hex_from_string(x25519_public_key, x25519_e, sizeof(x25519_e));
+    ogs_hex_from_string(p256_private_key, p256_k, sizeof(p256_k));
+    ogs_hex_from_string(p256_public_key, p256_e, sizeof(p256_e));
+
+    if (output) {
+        out = fopen(output, "w");
+        if (!out) {
+            fprintf(stderr, "Cannot open %s\n", output);
+            return EXIT_FAILURE;
+        }
+    }
+
+    fprintf(out, "{\n  \"benchmark\": \"crypt\",\n"
+            "  \"duration_ms\": %lld,\n  \"tsc\": %s,\n  \"results\": [",
+            (long long)ogs_time_to_msec(duration),
+            BENCH_HAVE_TSC ? "true" : "false");
+
+    for (i = 0; i < OGS_ARRAY_SIZE(bench_case_list); i++) {
+        const bench_case_t *bc = &bench_case_list[i];
+        int saved;
+
+        if (filter && !strstr(bc->name, filter))
+            continue;
+
+        saved = bench_backend(bc->backend);
+
+        for (b = 0; (rv = bench_set_backend(bc->backend, b, &backend)) !=
+                OGS_DONE; b++) {
+            if (rv != OGS_OK)
+                continue;
+
+            for (j = 0; j < (bc->sized ? num_of_size : 1); j++) {
+                for (k = 0; k < num_of_threads; k++) {
+                    if (bc->shared && threads[k] > 1)
+                        continue;
+                    bench_run(out, &first, bc, backend,
+                            bc->sized ? size[j] : 0, threads[k], duration);
+                }
+            }
+        }
+
+        ogs_assert(bench_set_backend(bc->backend, saved, &backend) == OGS_OK);
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+
+    if (output)
+        fclose(out);
+
+    ogs_thread_cond_destroy(&bench_sync.cond);
+    ogs_thread_mutex_destroy(&bench_sync.mutex);
+
+    return EXIT_SUCCESS;
+}
@@ -20,6 +20,11 @@
 #include "ogs-crypt.h"
 #include "core/abts.h"
 
+static const ogs_ecdh_backend_e ecdh_backend_list[] = {
+    OGS_ECDH_BACKEND_BUILTIN,
+    OGS_ECDH_BACKEND_OPENSSL,
+};
+
 static void ecies_profile_a(abts_case *tc, void *data)
 {
     const char *_e[] = {
@@ -64,6 +69,9 @@ static void ecies_profile_a(abts_case *tc, void *data)
     uint8_t ek[OGS_ECCKEY_LEN];
     uint8_t tmp[OGS_ECCKEY_LEN];
 
+    ogs_ecdh_backend_e saved;
+    int j;
+
     num = 6;
     for (i = 0; i < num; i++) {
         curve25519_donna(ek,
@@ -73,6 +81,26 @@ static void ecies_profile_a(abts_case *tc, void *data)
         ABTS_TRUE(tc, memcmp(ek,
             ogs_hex_from_string(_ek[i], tmp, sizeof(tmp)), OGS_ECCKEY_LEN) == 0);
     }
+
+    saved = ogs_ecdh_backend();
+
+    for (j = 0; j < OGS_ARRAY_SIZE(ecdh_backend_list); j++) {
+        if (ogs_ecdh_set_backend(ecdh_backend_list[j]) != OGS_OK)
+            continue;
+
+        for (i = 0; i < num; i++) {
+            memset(ek, 0, sizeof(ek));
+            ABTS_INT_EQUAL(tc, OGS_OK, ogs_ecdh_x25519(ek,
+                ogs_hex_from_string(_e[i], e, sizeof(e)),
+                ogs_hex_from_string(_k[i], k, sizeof(k))));
+
+            ABTS_TRUE(tc, memcmp(ek,
+                ogs_hex_from_string(_ek[i], tmp, sizeof(tmp)),
+                OGS_ECCKEY_LEN) == 0);
+        }
+    }
+
+    ABTS_INT_EQUAL(tc, OGS_OK, ogs_ecdh_set_backend(saved));
 }
 
 static void ecies_profile_b(abts_case *tc, void *data)
@@ -118,6 +146,9 @@ static void ecies_profile_b(abts_case *tc, void *data)
 
     int i, r, num;
 
+    ogs_ecdh_backend_e saved;
+    int j;
+
     num = 6;
     for (i = 0; i < num; i++) {
         r = ecdh_shared_secret(
@@ -129,6 +160,32 @@ static void ecies_profile_b(abts_case *tc, void *data)
         ABTS_TRUE(tc, memcmp(ek,
             ogs_hex_from_string(_ek[i], tmp, sizeof(tmp)), OGS_ECCKEY_LEN) == 0);
     }
+
+    saved = ogs_ecdh_backend();
+
+    for (j = 0; j < OGS_ARRAY_SIZE(ecdh_backend_list); j++) {
+        if (ogs_ecdh_set_backend(ecdh_backend_list[j]) != OGS_OK)
+            continue;
+
+        for (i = 0; i < num; i++) {
+            memset(ek, 0, sizeof(ek));
+            ABTS_INT_EQUAL(tc, OGS_OK, ogs_ecdh_p256(ek,
+                ogs_hex_from_string(_e[i], e, sizeof(e)),
+                ogs_hex_from_string(_k[i], k, sizeof(k))));
+
+            ABTS_TRUE(tc, memcmp(ek,
+                ogs_hex_from_string(_ek[i], tmp, sizeof(tmp)),
+                OGS_ECCKEY_LEN) == 0);
+        }
+
+        /* Not a point on the curve */
+        memset(k, 0, sizeof(k));
+        k[0] = 0x02;
+        k[OGS_ECCKEY_LEN] = 0x01;
+        ABTS_INT_EQUAL(tc, OGS_ERROR, ogs_ecdh_p256(ek, e, k));
+    }
+
+    ABTS_INT_EQUAL(tc, OGS_OK, ogs_ecdh_set_backend(saved));
 }
 
 static void ansi_x963_kdf(abts_case *tc, void *data)
@@ -371,6 +428,48 @@ static void hmac_sha_256(abts_case *tc, void *data)
     }
 }
 
+/* RFC7748 6.1 : small-order points give the all-zero shared secret */
+static void ecies_low_order(abts_case *tc, void *data)
+{
+    const char *_k =
+        "c53c22208b61860b06c62e5406a7b330c2b577aa5558981510d128247d38bd1d";
+    const char *_low_order[] = {
+        /* 0 */
+        "0000000000000000000000000000000000000000000000000000000000000000",
+        /* 1 */
+        "0100000000000000000000000000000000000000000000000000000000000000",
+        /* order 8 */
+        "e0eb7a7c3b41b8ae1656e3faf19fc46ada098deb9c32b1fd866205165f49b800",
+        "5f9c95bca3508c24b1d0b1559c83ef5b04445cc4581c8e86d8224eddd09f1157",
+        /* p - 1 */
+        "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+        /* p */
+        "edffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+    };
+
+    uint8_t k[OGS_ECCKEY_LEN];
+    uint8_t e[OGS_ECCKEY_LEN];
+    uint8_t z[OGS_ECCKEY_LEN];
+    ogs_ecdh_backend_e saved;
+    int i, j;
+
+    ogs_hex_from_string(_k, k, sizeof(k));
+
+    saved = ogs_ecdh_backend();
+
+    for (j = 0; j < OGS_ARRAY_SIZE(ecdh_backend_list); j++) {
+        if (ogs_ecdh_set_backend(ecdh_backend_list[j]) != OGS_OK)
+            continue;
+
+        for (i = 0; i < OGS_ARRAY_SIZE(_low_order); i++) {
+            ogs_hex_from_string(_low_order[i], e, sizeof(e));
+            ABTS_INT_EQUAL(tc, OGS_ERROR, ogs_ecdh_x25519(z, k, e));
+        }
+    }
+
+    ABTS_INT_EQUAL(tc, OGS_OK, ogs_ecdh_set_backend(saved));
+}
+
 abts_suite *test_ecies(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
@@ -380,6 +479,7 @@ abts_suite *test_ecies(abts_suite *suite)
     abts_run_test(suite, ansi_x963_kdf, NULL);
     abts_run_test(suite, aes_128ctr, NULL);
     abts_run_test(suite, hmac_sha_256, NULL);
+    abts_run_test(suite, ecies_low_order, NULL);
 
     return suite;
 }
@@ -169,6 +169,105 @@ static void sha2_test1(abts_case *tc, void *data)
     free(message3);
 }
 
+static const ogs_sha256_backend_e sha256_backend_list[] = {
+    OGS_SHA256_BACKEND_PORTABLE, OGS_SHA256_BACKEND_SHANI,
+};
+
+static const char *sha256_backend_name[] = { "portable", "sha-ni" };
+
+#define SHA2_TEST_LEN 1024
+
+static void sha2_test_backend(abts_case *tc, void *data)
+{
+    uint8_t msg[SHA2_TEST_LEN];
+    uint8_t expected[OGS_SHA256_DIGEST_SIZE], digest[OGS_SHA256_DIGEST_SIZE];
+    ogs_sha256_ctx ctx;
+    ogs_sha256_backend_e saved;
+    int i, len;
+
+    saved = ogs_sha256_backend();
+
+    for (i = 0; i < sizeof(msg); i++)
+        msg[i] = i * 29 + 3;
+
+    for (i = 1; i < OGS_ARRAY_SIZE(sha256_backend_list); i++) {
+        if (ogs_sha256_set_backend(sha256_backend_list[i]) != OGS_OK)
+            continue;
+
+        for (len = 0; len <= SHA2_TEST_LEN; len += 13) {
+            ABTS_INT_EQUAL(tc, OGS_OK,
+                    ogs_sha256_set_backend(OGS_SHA256_BACKEND_PORTABLE));
+            ogs_sha256(msg, len, expected);
+
+            ABTS_INT_EQUAL(tc, OGS_OK,
+                    ogs_sha256_set_backend(sha256_backend_list[i]));
+            ogs_sha256(msg, len, digest);
+            ABTS_INT_EQUAL(tc, 0,
+                    memcmp(digest, expected, OGS_SHA256_DIGEST_SIZE));
+
+            /* Same message fed in odd-sized pieces */
+            ogs_sha256_init(&ctx);
+            ogs_sha256_update(&ctx, msg, len / 3);
+            ogs_sha256_update(&ctx, msg + len / 3, len - len / 3);
+            ogs_sha256_final(&ctx, digest);
+            ABTS_INT_EQUAL(tc, 0,
+                    memcmp(digest, expected, OGS_SHA256_DIGEST_SIZE));
+
+            ABTS_INT_EQUAL(tc, OGS_OK,
+                    ogs_sha256_set_backend(OGS_SHA256_BACKEND_PORTABLE));
+            ogs_sha224(msg, len, expected);
+
+            ABTS_INT_EQUAL(tc, OGS_OK,
+                    ogs_sha256_set_backend(sha256_backend_list[i]));
+            ogs_sha224(msg, len, digest);
+            ABTS_INT_EQUAL(tc, 0,
+                    memcmp(digest, expected, OGS_SHA224_DIGEST_SIZE));
+        }
+
+        /* FIPS vectors through the accelerated path */
+        sha2_test1(tc, data);
+    }
+
+    ABTS_INT_EQUAL(tc, OGS_OK, ogs_sha256_set_backend(saved));
+}
+
+/* Run with '-e info' to see the numbers */
+static void sha2_bench(abts_case *tc, void *data)
+{
+#define SHA2_BENCH_COUNT 20000
+    uint8_t key[OGS_SHA256_DIGEST_SIZE], msg[SHA2_TEST_LEN];
+    uint8_t digest[OGS_SHA256_DIGEST_SIZE];
+    ogs_sha256_backend_e saved;
+    ogs_time_t start, kdf_time, bulk_time;
+    int i, j;
+
+    saved = ogs_sha256_backend();
+
+    memset(key, 0x5a, sizeof(key));
+    memset(msg, 0xa5, sizeof(msg));
+
+    for (i = 0; i < OGS_ARRAY_SIZE(sha256_backend_list); i++) {
+        if (ogs_sha256_set_backend(sha256_backend_list[i]) != OGS_OK)
+            continue;
+
+        start = ogs_get_monotonic_time();
+        for (j = 0; j < SHA2_BENCH_COUNT; j++)
+            ogs_kdf_kgnb_and_kn3iwf(key, j, 1, digest);
+        kdf_time = ogs_get_monotonic_time() - start;
+
+        start = ogs_get_monotonic_time();
+        for (j = 0; j < SHA2_BENCH_COUNT / 16; j++)
+            ogs_sha256(msg, sizeof(msg), digest);
+        bulk_time = ogs_get_monotonic_time() - start;
+
+        ogs_info("[%s] kdf %lld ns, sha256 %lld MB/s", sha256_backend_name[i],
+                (long long)(kdf_time * 1000 / SHA2_BENCH_COUNT),
+                bulk_time ? (long long)((SHA2_BENCH_COUNT / 16) *
+                    sizeof(msg) / bulk_time) : 0);
+    }
+
+    ABTS_INT_EQUAL(tc, OGS_OK, ogs_sha256_set_backend(saved));
+}
 
 abts_suite *test_sha(abts_suite *suite)
 {
@@ -176,6 +275,8 @@ abts_suite *test_sha(abts_suite *suite)
 
     abts_run_test(suite, sha1_test1, NULL);
     abts_run_test(suite, sha2_test1, NULL);
+    abts_run_test(suite, sha2_test_backend, NULL);
+    abts_run_test(suite, sha2_bench, NULL);
 
     return suite;
 }
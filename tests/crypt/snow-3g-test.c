@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-core.h"
+#include "ogs-crypt.h"
+#include "core/abts.h"
+
+static const snow_3g_backend_e snow_3g_backend_list[] = {
+    SNOW_3G_BACKEND_PORTABLE, SNOW_3G_BACKEND_PCLMUL,
+};
+
+static const char *snow_3g_backend_name[] = { "portable", "pclmul" };
+
+/* UEA2 test set 3 and UIA2 test set 1 */
+static void snow_3g_test1(abts_case *tc, void *data)
+{
+    const char *_key = "2bd6459f 82c5b300 952c4910 4881ff48";
+    const char *_plain =
+        "7ec61272 743bf161 4726446a 6c38ced1"
+        "66f6ca76 eb543004 4286346c ef130f92"
+        "922b0345 0d3a9975 e5bd2ea0 eb55ad8e"
+        "1b199e3e c4316020 e9a1b285 e7627953"
+        "59b7bdfd 39bef4b2 484583d5 afe082ae"
+        "e638bf5f d5a60619 3901a08f 4ab41aab"
+        "9b134880";
+    const char *_cipher =
+        "8ceba629 43dced3a 0990b06e a1b0a2c4"
+        "fb3cedc7 1b369f42 ba64c1eb 6665e72a"
+        "a1c9bb0d eaa20fe8 6058b8ba ee2c2e7f"
+        "0becce48 b52932a5 3c9d5f93 1a3a7c53"
+        "2259af43 25e2a65e 3084ad5f 6a513b7b"
+        "ddc1b65f 0aa0d97a 053db55a 88c4c4f9"
+        "605e4143";
+    const char *_message = "33323462 63393861 37347900 00000000";
+    const char *_mac = "731f1165";
+    uint8_t key[16], buf[100], expected[100], mac[4];
+    snow_3g_backend_e saved;
+    int i;
+
+    saved = snow_3g_backend();
+
+    ogs_hex_from_string(_key, key, sizeof(key));
+
+    ogs_hex_from_string(_plain, buf, sizeof(buf));
+    snow_3g_f8(key, 0x72a4f20f, 0x0c, 1, buf, 800);
+    ABTS_INT_EQUAL(tc, 0, memcmp(buf,
+            ogs_hex_from_string(_cipher, expected, sizeof(expected)), 100));
+
+    ogs_hex_from_string(_mac, expected, 4);
+    ogs_hex_from_string(_message, buf, 11);
+    for (i = 0; i < OGS_ARRAY_SIZE(snow_3g_backend_list); i++) {
+        if (snow_3g_set_backend(snow_3g_backend_list[i]) != OGS_OK)
+            continue;
+
+        snow_3g_f9(key, 0x38a6f056, 0x1f << 27, 0, buf, 88, mac);
+        ABTS_INT_EQUAL(tc, 0, memcmp(mac, expected, 4));
+    }
+
+    ABTS_INT_EQUAL(tc, OGS_OK, snow_3g_set_backend(saved));
+}
+
+#define SNOW_3G_TEST_LEN 256
+
+static void snow_3g_test_backend(abts_case *tc, void *data)
+{
+    uint8_t key[16], in[SNOW_3G_TEST_LEN], buf[SNOW_3G_TEST_LEN];
+    uint8_t cipher[SNOW_3G_TEST_LEN], expected[4], mac[4];
+    snow_3g_backend_e saved;
+    snow_3g_ctx_t ctx1, ctx2;
+    uint32_t k[4], iv[4], z1[8], z2[8];
+    int i, length;
+
+    saved = snow_3g_backend();
+
+    for (i = 0; i < sizeof(key); i++)
+        key[i] = i * 7 + 1;
+    for (i = 0; i < sizeof(in); i++)
+        in[i] = i * 13 + 5;
+
+    memcpy(cipher, in, sizeof(cipher));
+    snow_3g_f8(key, 0x12345678, 0x15, 1, cipher, sizeof(cipher) * 8);
+
+    for (length = 1; length <= SNOW_3G_TEST_LEN * 8; length += 29) {
+        /* f8 on a prefix is a prefix of the ciphertext */
+        memcpy(buf, in, sizeof(buf));
+        snow_3g_f8(key, 0x12345678, 0x15, 1, buf, length);
+        ABTS_INT_EQUAL(tc, 0, memcmp(buf, cipher, length / 8));
+        ABTS_INT_EQUAL(tc, 0, memcmp(buf + (length + 7) / 8,
+                    in + (length + 7) / 8, sizeof(buf) - (length + 7) / 8));
+
+        /* f9 with every backend */
+        ABTS_INT_EQUAL(tc, OGS_OK,
+                snow_3g_set_backend(SNOW_3G_BACKEND_PORTABLE));
+        snow_3g_f9(key, 0x12345678, 0xa5a5a5a5, 1, in, length, expected);
+
+        for (i = 1; i < OGS_ARRAY_SIZE(snow_3g_backend_list); i++) {
+            if (snow_3g_set_backend(snow_3g_backend_list[i]) != OGS_OK)
+                continue;
+
+            snow_3g_f9(key, 0x12345678, 0xa5a5a5a5, 1, in, length, mac);
+            ABTS_INT_EQUAL(tc, 0, memcmp(mac, expected, 4));
+        }
+    }
+
+    /* Two interleaved contexts do not disturb each other */
+    for (i = 0; i < 4; i++) {
+        k[i] = 0x01020304 * (i + 1);
+        iv[i] = 0x10203040 * (i + 1);
+    }
+    snow_3g_initialize(&ctx1, k, iv);
+    snow_3g_generate_key_stream(&ctx1, 8, z1);
+
+    snow_3g_initialize(&ctx1, k, iv);
+    snow_3g_initialize(&ctx2, iv, k);
+    for (i = 0; i < 8; i++) {
+        snow_3g_generate_key_stream(&ctx1, 1, &z2[i]);
+        snow_3g_generate_key_stream(&ctx2, 1, &k[0]);
+    }
+    ABTS_INT_EQUAL(tc, 0, memcmp(z1, z2, sizeof(z1)));
+
+    ABTS_INT_EQUAL(tc, OGS_OK, snow_3g_set_backend(saved));
+}
+
+/* Run with '-e info' to see the numbers */
+static void snow_3g_bench(abts_case *tc, void *data)
+{
+#define SNOW_3G_BENCH_COUNT 20000
+#define SNOW_3G_BENCH_LEN 128
+    uint8_t key[16], buf[SNOW_3G_BENCH_LEN], mac[4];
+    snow_3g_backend_e saved;
+    ogs_time_t start, f8_time, f9_time;
+    int i, j;
+
+    saved = snow_3g_backend();
+
+    memset(key, 0x2b, sizeof(key));
+    memset(buf, 0, sizeof(buf));
+
+    for (i = 0; i < OGS_ARRAY_SIZE(snow_3g_backend_list); i++) {
+        if (snow_3g_set_backend(snow_3g_backend_list[i]) != OGS_OK)
+            continue;
+
+        start = ogs_get_monotonic_time();
+        for (j = 0; j < SNOW_3G_BENCH_COUNT; j++)
+            snow_3g_f8(key, j, 1, 0, buf, sizeof(buf) * 8);
+        f8_time = ogs_get_monotonic_time() - start;
+
+        start = ogs_get_monotonic_time();
+        for (j = 0; j < SNOW_3G_BENCH_COUNT; j++)
+            snow_3g_f9(key, j, 1 << 27, 0, buf, sizeof(buf) * 8, mac);
+        f9_time = ogs_get_monotonic_time() - start;
+
+        ogs_info("[%s] %d-byte message: f8 %lld ns, f9 %lld ns",
+                snow_3g_backend_name[i], SNOW_3G_BENCH_LEN,
+                (long long)(f8_time * 1000 / SNOW_3G_BENCH_COUNT),
+                (long long)(f9_time * 1000 / SNOW_3G_BENCH_COUNT));
+    }
+
+    ABTS_INT_EQUAL(tc, OGS_OK, snow_3g_set_backend(saved));
+}
+
+abts_suite *test_snow_3g(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, snow_3g_test1, NULL);
+    abts_run_test(suite, snow_3g_test_backend, NULL);
+    abts_run_test(suite, snow_3g_bench, NULL);
+
+    return suite;
+}
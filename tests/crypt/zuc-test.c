@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2019 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-core.h"
+#include "ogs-crypt.h"
+#include "core/abts.h"
+
+static const zuc_backend_e zuc_backend_list[] = {
+    ZUC_BACKEND_PORTABLE, ZUC_BACKEND_PCLMUL,
+};
+
+static const char *zuc_backend_name[] = { "portable", "pclmul" };
+
+/* EEA3 test set 1 and EIA3 test set 3 */
+static void zuc_test1(abts_case *tc, void *data)
+{
+    const char *_ck = "173d14ba 5003731d 7a600494 70f00a29";
+    const char *_plain =
+        "6cf65340 735552ab 0c9752fa 6f9025fe 0bd675d9 005875b2 00000000";
+    const char *_cipher =
+        "a6c85fc6 6afb8533 aafc2518 dfe78494 0ee1e4b0 30238cc8 10000000";
+    const char *_ik = "c9e6cec4 607c72db 000aefa8 8385ab0a";
+    const char *_message =
+        "983b41d4 7d780c9e 1ad11d7e b70391b1 de0b35da 2dc62f83 e7b78d63"
+        "06ca0ea0 7e941b7b e91348f9 fcb170e2 217fecd9 7f9f68ad b16e5d7d"
+        "21e569d2 80ed775c ebde3f40 93c53881 00000000";
+    uint8_t key[16], plain[28], buf[28], expected[28], message[80];
+    uint32_t mac;
+    zuc_backend_e saved;
+    int i;
+
+    saved = zuc_backend();
+
+    ogs_hex_from_string(_ck, key, sizeof(key));
+    ogs_hex_from_string(_plain, plain, sizeof(plain));
+    ogs_hex_from_string(_cipher, expected, sizeof(expected));
+
+    zuc_eea3(key, 0x66035492, 0xf, 0, 200, plain, buf);
+    ABTS_INT_EQUAL(tc, 0, memcmp(buf, expected, 25));
+
+    /* In place */
+    zuc_eea3(key, 0x66035492, 0xf, 0, 200, plain, plain);
+    ABTS_INT_EQUAL(tc, 0, memcmp(plain, expected, 25));
+
+    ogs_hex_from_string(_ik, key, sizeof(key));
+    ogs_hex_from_string(_message, message, sizeof(message));
+    for (i = 0; i < OGS_ARRAY_SIZE(zuc_backend_list); i++) {
+        if (zuc_set_backend(zuc_backend_list[i]) != OGS_OK)
+            continue;
+
+        zuc_eia3(key, 0xa94059da, 0xa, 1, 584, message, &mac);
+        ABTS_INT_EQUAL(tc, 0x24a842b3, mac);
+    }
+
+    ABTS_INT_EQUAL(tc, OGS_OK, zuc_set_backend(saved));
+}
+
+#define ZUC_TEST_LEN 256
+
+static void zuc_test_backend(abts_case *tc, void *data)
+{
+    uint8_t k[16], iv[16], in[ZUC_TEST_LEN];
+    zuc_backend_e saved;
+    zuc_ctx_t ctx1, ctx2;
+    uint32_t z1[8], z2[8], z, expected, mac;
+    int i, length;
+
+    saved = zuc_backend();
+
+    for (i = 0; i < sizeof(in); i++)
+        in[i] = i * 13 + 5;
+
+    /* EIA3 with every backend, including the empty message */
+    for (length = 0; length <= ZUC_TEST_LEN * 8; length += 29) {
+        ABTS_INT_EQUAL(tc, OGS_OK, zuc_set_backend(ZUC_BACKEND_PORTABLE));
+        zuc_eia3(in, 0x12345678, 0x15, 1, length, in, &expected);
+
+        for (i = 1; i < OGS_ARRAY_SIZE(zuc_backend_list); i++) {
+            if (zuc_set_backend(zuc_backend_list[i]) != OGS_OK)
+                continue;
+
+            zuc_eia3(in, 0x12345678, 0x15, 1, length, in, &mac);
+            ABTS_INT_EQUAL(tc, expected, mac);
+        }
+    }
+
+    ABTS_INT_EQUAL(tc, OGS_OK, zuc_set_backend(saved));
+
+    /* Two interleaved contexts do not disturb each other */
+    for (i = 0; i < 16; i++) {
+        k[i] = i * 7 + 1;
+        iv[i] = i * 13 + 5;
+    }
+    zuc_initialize(&ctx1, k, iv);
+    zuc_generate_key_stream(&ctx1, z1, 8);
+
+    zuc_initialize(&ctx1, k, iv);
+    zuc_initialize(&ctx2, iv, k);
+    for (i = 0; i < 8; i++) {
+        zuc_generate_key_stream(&ctx1, &z2[i], 1);
+        zuc_generate_key_stream(&ctx2, &z, 1);
+    }
+    ABTS_INT_EQUAL(tc, 0, memcmp(z1, z2, sizeof(z1)));
+}
+
+/* Run with '-e info' to see the numbers */
+static void zuc_bench(abts_case *tc, void *data)
+{
+#define ZUC_BENCH_COUNT 20000
+#define ZUC_BENCH_LEN 128
+    uint8_t key[16], buf[ZUC_BENCH_LEN];
+    zuc_backend_e saved;
+    ogs_time_t start, eea3_time, eia3_time;
+    uint32_t mac;
+    int i, j;
+
+    saved = zuc_backend();
+
+    memset(key, 0x2b, sizeof(key));
+    for (j = 0; j < sizeof(buf); j++)
+        buf[j] = j * 37 + 11;
+
+    for (i = 0; i < OGS_ARRAY_SIZE(zuc_backend_list); i++) {
+        if (zuc_set_backend(zuc_backend_list[i]) != OGS_OK)
+            continue;
+
+        start = ogs_get_monotonic_time();
+        for (j = 0; j < ZUC_BENCH_COUNT; j++)
+            zuc_eea3(key, j, 1, 0, sizeof(buf) * 8, buf, buf);
+        eea3_time = ogs_get_monotonic_time() - start;
+
+        start = ogs_get_monotonic_time();
+        for (j = 0; j < ZUC_BENCH_COUNT; j++)
+            zuc_eia3(key, j, 1, 0, sizeof(buf) * 8, buf, &mac);
+        eia3_time = ogs_get_monotonic_time() - start;
+
+        ogs_info("[%s] %d-byte message: eea3 %lld ns, eia3 %lld ns",
+                zuc_backend_name[i], ZUC_BENCH_LEN,
+                (long long)(eea3_time * 1000 / ZUC_BENCH_COUNT),
+                (long long)(eia3_time * 1000 / ZUC_BENCH_COUNT));
+    }
+
+    ABTS_INT_EQUAL(tc, OGS_OK, zuc_set_backend(saved));
+}
+
+abts_suite *test_zuc(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, zuc_test1, NULL);
+    abts_run_test(suite, zuc_test_backend, NULL);
+    abts_run_test(suite, zuc_bench, NULL);
+
+    return suite;
+}
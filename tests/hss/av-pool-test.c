@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "hss/hss-av-pool.h"
+#include "core/abts.h"
+
+#define POOL_SIZE 8
+
+static char imsi1[] = "001010000000001";
+static char imsi2[] = "001010000000002";
+
+static void pool_fill(char *imsi_bcd, uint64_t generation, uint64_t sqn)
+{
+    hss_av_t av[POOL_SIZE];
+    int i;
+
+    memset(av, 0, sizeof(av));
+    for (i = 0; i < POOL_SIZE; i++)
+        ogs_uint64_to_buffer(sqn + 32 * i, OGS_SQN_LEN, av[i].sqn);
+
+    hss_av_pool_add(imsi_bcd, generation, false, av, POOL_SIZE);
+}
+
+static void test_setup(void)
+{
+    static bool opened = false;
+
+    if (opened == false) {
+        hss_self()->av_pool.size = POOL_SIZE;
+        hss_self()->av_pool.subscriber = 16;
+        hss_self()->av_pool.lifetime = ogs_time_from_sec(300);
+        ogs_assert(hss_av_pool_open() == OGS_OK);
+        opened = true;
+    }
+
+    hss_av_pool_invalidate_all();
+}
+
+static void av_pool_test1(abts_case *tc, void *data)
+{
+    hss_av_t av[2];
+    uint64_t generation;
+
+    test_setup();
+
+    pool_fill(imsi1, hss_av_pool_generation(imsi1), 64);
+    pool_fill(imsi2, hss_av_pool_generation(imsi2), 64);
+    ABTS_INT_EQUAL(tc, POOL_SIZE, hss_av_pool_count(imsi1));
+
+    /* Handed out in SQN order, leaving enough not to refill */
+    ABTS_INT_EQUAL(tc, 2, hss_av_pool_take(imsi1, av, 2));
+    ABTS_INT_EQUAL(tc, 64, ogs_buffer_to_uint64(av[0].sqn, OGS_SQN_LEN));
+    ABTS_INT_EQUAL(tc, 96, ogs_buffer_to_uint64(av[1].sqn, OGS_SQN_LEN));
+    ABTS_INT_EQUAL(tc, POOL_SIZE - 2, hss_av_pool_count(imsi1));
+
+    /* A higher SQN used elsewhere drops the stale vectors */
+    hss_av_pool_advance(imsi2, 64 + 32 * POOL_SIZE);
+    ABTS_INT_EQUAL(tc, 0, hss_av_pool_count(imsi2));
+
+    /* A refill that started before the subscriber changed is not kept */
+    generation = hss_av_pool_generation(imsi2);
+    hss_av_pool_invalidate(imsi2);
+    pool_fill(imsi2, generation, 64 + 32 * POOL_SIZE);
+    ABTS_INT_EQUAL(tc, 0, hss_av_pool_count(imsi2));
+    ABTS_INT_EQUAL(tc, POOL_SIZE - 2, hss_av_pool_count(imsi1));
+
+    pool_fill(imsi2, hss_av_pool_generation(imsi2), 64 + 32 * POOL_SIZE);
+    ABTS_INT_EQUAL(tc, POOL_SIZE, hss_av_pool_count(imsi2));
+}
+
+static void av_pool_test2(abts_case *tc, void *data)
+{
+    bson_t *document = NULL;
+
+    test_setup();
+
+    pool_fill(imsi1, hss_av_pool_generation(imsi1), 64);
+    pool_fill(imsi2, hss_av_pool_generation(imsi2), 64);
+
+    /* The HSS's own SQN update keeps the subscriber */
+    document = BCON_NEW(
+            "operationType", BCON_UTF8("update"),
+            "fullDocument", "{",
+                "imsi", BCON_UTF8(imsi1),
+            "}",
+            "updateDescription", "{",
+                "updatedFields", "{",
+                    "security.sqn", BCON_INT64(96),
+                "}",
+                "removedFields", "[", "]",
+            "}");
+    ABTS_PTR_NOTNULL(tc, document);
+    ABTS_INT_EQUAL(tc, OGS_OK, hss_handle_change_event(document));
+    bson_destroy(document);
+
+    ABTS_INT_EQUAL(tc, POOL_SIZE, hss_av_pool_count(imsi1));
+    ABTS_INT_EQUAL(tc, POOL_SIZE, hss_av_pool_count(imsi2));
+
+    /* A new K drops only the edited subscriber */
+    document = BCON_NEW(
+            "operationType", BCON_UTF8("update"),
+            "fullDocument", "{",
+                "imsi", BCON_UTF8(imsi1),
+            "}",
+            "updateDescription", "{",
+                "updatedFields", "{",
+                    "security.k",
+                        BCON_UTF8("465B5CE8B199B49FAA5F0A2EE238A6BC"),
+                "}",
+                "removedFields", "[", "]",
+            "}");
+    ABTS_PTR_NOTNULL(tc, document);
+    ABTS_INT_EQUAL(tc, OGS_OK, hss_handle_change_event(document));
+    bson_destroy(document);
+
+    ABTS_INT_EQUAL(tc, 0, hss_av_pool_count(imsi1));
+    ABTS_INT_EQUAL(tc, POOL_SIZE, hss_av_pool_count(imsi2));
+
+    /* A replaced subscriber is dropped */
+    document = BCON_NEW(
+            "operationType", BCON_UTF8("replace"),
+            "fullDocument", "{",
+                "imsi", BCON_UTF8(imsi2),
+            "}");
+    ABTS_PTR_NOTNULL(tc, document);
+    ABTS_INT_EQUAL(tc, OGS_OK, hss_handle_change_event(document));
+    bson_destroy(document);
+
+    ABTS_INT_EQUAL(tc, 0, hss_av_pool_count(imsi2));
+}
+
+static void av_pool_test3(abts_case *tc, void *data)
+{
+    bson_t *document = NULL;
+    uint64_t generation;
+
+    test_setup();
+
+    pool_fill(imsi1, hss_av_pool_generation(imsi1), 64);
+    pool_fill(imsi2, hss_av_pool_generation(imsi2), 64);
+    generation = hss_av_pool_generation(imsi1);
+
+    /* A delete does not carry the IMSI: every subscriber is dropped */
+    document = BCON_NEW(
+            "operationType", BCON_UTF8("delete"),
+            "documentKey", "{",
+                "_id", BCON_UTF8("5f1e5f4b8e1b2c3d4e5f6a7b"),
+            "}");
+    ABTS_PTR_NOTNULL(tc, document);
+    ABTS_INT_EQUAL(tc, OGS_OK, hss_handle_change_event(document));
+    bson_destroy(document);
+
+    ABTS_INT_EQUAL(tc, 0, hss_av_pool_count(imsi1));
+    ABTS_INT_EQUAL(tc, 0, hss_av_pool_count(imsi2));
+
+    /* Nor does a refill read before the delete bring the vectors back */
+    pool_fill(imsi1, generation, 64 + 32 * POOL_SIZE);
+    ABTS_INT_EQUAL(tc, 0, hss_av_pool_count(imsi1));
+}
+
+abts_suite *test_av_pool(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, av_pool_test1, NULL);
+    abts_run_test(suite, av_pool_test2, NULL);
+    abts_run_test(suite, av_pool_test3, NULL);
+
+    return suite;
+}
@@ -206,11 +206,127 @@ static void test1_func(abts_case *tc, void *data)
     test_ue_remove(test_ue);
 }
 
+#define NUM_OF_SQN_THREAD   8
+#define NUM_OF_SQN_RESERVE  16
+
+typedef struct sqn_window_s {
+    uint64_t sqn;
+    int count;
+} sqn_window_t;
+
+typedef struct sqn_thread_s {
+    char *supi;
+    int rv;
+    sqn_window_t window[NUM_OF_SQN_RESERVE];
+} sqn_thread_t;
+
+static void sqn_thread_main(void *data)
+{
+    sqn_thread_t *thread = data;
+    ogs_dbi_auth_info_t auth_info;
+    int i;
+
+    for (i = 0; i < NUM_OF_SQN_RESERVE; i++) {
+        thread->window[i].count = 1 + (i % 4);
+        thread->rv = ogs_dbi_reserve_sqn(
+                thread->supi, thread->window[i].count, &auth_info);
+        if (thread->rv != OGS_OK)
+            break;
+        thread->window[i].sqn = auth_info.sqn;
+    }
+}
+
+static int sqn_window_compare(const void *a, const void *b)
+{
+    const sqn_window_t *w1 = a, *w2 = b;
+
+    if (w1->sqn < w2->sqn) return -1;
+    if (w1->sqn > w2->sqn) return 1;
+    return 0;
+}
+
+static void test2_func(abts_case *tc, void *data)
+{
+    ogs_nas_5gs_mobile_identity_suci_t mobile_identity_suci;
+    test_ue_t *test_ue = NULL;
+
+    bson_t *doc = NULL;
+
+    static sqn_thread_t sqn_thread[NUM_OF_SQN_THREAD];
+    static sqn_window_t window[NUM_OF_SQN_THREAD * NUM_OF_SQN_RESERVE];
+    ogs_thread_t *thread[NUM_OF_SQN_THREAD];
+    ogs_dbi_auth_info_t auth_info;
+    uint64_t sqn, total = 0;
+    int i, j, n = 0;
+
+    /* Setup Test UE Context */
+    memset(&mobile_identity_suci, 0, sizeof(mobile_identity_suci));
+
+    mobile_identity_suci.h.supi_format = OGS_NAS_5GS_SUPI_FORMAT_IMSI;
+    mobile_identity_suci.h.type = OGS_NAS_5GS_MOBILE_IDENTITY_SUCI;
+    mobile_identity_suci.routing_indicator1 = 0;
+    mobile_identity_suci.routing_indicator2 = 0xf;
+    mobile_identity_suci.routing_indicator3 = 0xf;
+    mobile_identity_suci.routing_indicator4 = 0xf;
+    mobile_identity_suci.protection_scheme_id = OGS_PROTECTION_SCHEME_NULL;
+    mobile_identity_suci.home_network_pki_value = 0;
+
+    test_ue = test_ue_add_by_suci(&mobile_identity_suci, "0000203191");
+    ogs_assert(test_ue);
+
+    test_ue->k_string = "465b5ce8b199b49faa5f0a2ee238a6bc";
+    test_ue->opc_string = "e8ed289deba952e4283b54e88e6183ca";
+
+    /********** Insert Subscriber in Database */
+    doc = test_db_new_simple(test_ue);
+    ABTS_PTR_NOTNULL(tc, doc);
+    ABTS_INT_EQUAL(tc, OGS_OK, test_db_insert_ue(test_ue, doc));
+
+    ABTS_INT_EQUAL(tc, OGS_OK, ogs_dbi_auth_info(test_ue->supi, &auth_info));
+    sqn = auth_info.sqn;
+
+    /* Reserve SQN windows from several threads at once */
+    for (i = 0; i < NUM_OF_SQN_THREAD; i++) {
+        memset(&sqn_thread[i], 0, sizeof(sqn_thread[i]));
+        sqn_thread[i].supi = test_ue->supi;
+        thread[i] = ogs_thread_create(sqn_thread_main, &sqn_thread[i]);
+        ABTS_PTR_NOTNULL(tc, thread[i]);
+    }
+    for (i = 0; i < NUM_OF_SQN_THREAD; i++)
+        ogs_thread_destroy(thread[i]);
+
+    for (i = 0; i < NUM_OF_SQN_THREAD; i++) {
+        ABTS_INT_EQUAL(tc, OGS_OK, sqn_thread[i].rv);
+        for (j = 0; j < NUM_OF_SQN_RESERVE; j++) {
+            window[n++] = sqn_thread[i].window[j];
+            total += 32 * (uint64_t)sqn_thread[i].window[j].count;
+        }
+    }
+
+    /* The windows neither overlap nor leave a gap */
+    qsort(window, n, sizeof(window[0]), sqn_window_compare);
+    for (i = 0; i < n; i++) {
+        ABTS_TRUE(tc, window[i].sqn == sqn);
+        sqn += 32 * (uint64_t)window[i].count;
+    }
+
+    ABTS_INT_EQUAL(tc, OGS_OK, ogs_dbi_auth_info(test_ue->supi, &auth_info));
+    ABTS_TRUE(tc, auth_info.sqn == sqn);
+    ABTS_TRUE(tc, auth_info.sqn == window[0].sqn + total);
+
+    /********** Remove Subscriber in Database */
+    ABTS_INT_EQUAL(tc, OGS_OK, test_db_remove_ue(test_ue));
+
+    /* Clear Test UE Context */
+    test_ue_remove(test_ue);
+}
+
 abts_suite *test_auth(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
 
     abts_run_test(suite, test1_func, NULL);
+    abts_run_test(suite, test2_func, NULL);
 
     return suite;
 }
@@ -21,11 +21,15 @@
 #include "core/abts.h"
 
 abts_suite *test_sctp(abts_suite *suite);
+abts_suite *test_sctp_worker(abts_suite *suite);
+abts_suite *test_sctp_flush(abts_suite *suite);
 
 const struct testlist {
     abts_suite *(*func)(abts_suite *suite);
 } alltests[] = {
     {test_sctp},
+    {test_sctp_worker},
+    {test_sctp_flush},
     {NULL},
 };
 
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <signal.h>
+
+#include "ogs-sctp.h"
+#include "ogs-app.h"
+#include "core/abts.h"
+
+/*
+ * These tests run the tail of the NF loop: ogs_pollset_poll(),
+ * then ogs_sctp_flush_all(). A UNIX socket pair stands in for
+ * the association, as it takes the same sendmmsg() batches.
+ */
+#define MESSAGE_SIZE 1024
+#define NUM_OF_MESSAGE 1000
+
+static void test_association_add(ogs_sctp_sock_t *sctp, ogs_socket_t *peer)
+{
+    ogs_socket_t fd[2];
+
+    ogs_assert(ogs_socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fd) == 0);
+    ogs_assert(ogs_nonblocking(fd[0]) == OGS_OK);
+
+    memset(sctp, 0, sizeof(*sctp));
+    sctp->type = SOCK_STREAM;
+    sctp->sock = ogs_sock_create();
+    ogs_assert(sctp->sock);
+    sctp->sock->fd = fd[0];
+    sctp->addr = ogs_calloc(1, sizeof(ogs_sockaddr_t));
+    ogs_assert(sctp->addr);
+
+    *peer = fd[1];
+}
+
+static void test_write(ogs_sctp_sock_t *sctp, uint32_t seq)
+{
+    ogs_pkbuf_t *pkbuf = NULL;
+
+    pkbuf = ogs_pkbuf_alloc(NULL, MESSAGE_SIZE);
+    ogs_assert(pkbuf);
+    ogs_pkbuf_put(pkbuf, MESSAGE_SIZE);
+    memset(pkbuf->data, 0, MESSAGE_SIZE);
+    memcpy(pkbuf->data, &seq, sizeof(seq));
+
+    ogs_sctp_write_to_buffer(sctp, pkbuf);
+}
+
+/* Reads what has arrived and checks it is in order */
+static int test_read(abts_case *tc, ogs_socket_t peer, uint32_t *seq)
+{
+    char buf[MESSAGE_SIZE];
+    uint32_t got;
+    ssize_t size;
+    int num = 0;
+
+    while ((size = recv(peer, buf, sizeof(buf), MSG_DONTWAIT)) > 0) {
+        memcpy(&got, buf, sizeof(got));
+        if (size != MESSAGE_SIZE || got != *seq) {
+            ABTS_FAIL(tc, "Unexpected message");
+            break;
+        }
+        (*seq)++;
+        num++;
+    }
+
+    return num;
+}
+
+static void flush_test1(abts_case *tc, void *data)
+{
+    ogs_sctp_sock_t sctp;
+    ogs_socket_t peer;
+    uint32_t seq = 0;
+
+    test_association_add(&sctp, &peer);
+
+    /* Nothing leaves before the end of the loop iteration */
+    test_write(&sctp, 0);
+    test_write(&sctp, 1);
+    test_write(&sctp, 2);
+    ABTS_TRUE(tc, sctp.pending);
+    ABTS_INT_EQUAL(tc, 0, test_read(tc, peer, &seq));
+
+    ogs_pollset_poll(ogs_app()->pollset, 0);
+    ogs_sctp_flush_all();
+
+    ABTS_TRUE(tc, !sctp.pending);
+    ABTS_PTR_EQUAL(tc, NULL, sctp.poll.write);
+    ABTS_INT_EQUAL(tc, 0, ogs_list_count(&sctp.write_queue));
+    ABTS_INT_EQUAL(tc, 3, test_read(tc, peer, &seq));
+
+    ogs_sctp_flush_and_destroy(&sctp);
+    ogs_closesocket(peer);
+}
+
+static void flush_test2(abts_case *tc, void *data)
+{
+    ogs_sctp_sock_t sctp;
+    ogs_socket_t peer;
+    uint32_t seq = 0;
+    int i, received = 0;
+
+    test_association_add(&sctp, &peer);
+
+    for (i = 0; i < NUM_OF_MESSAGE; i++)
+        test_write(&sctp, i);
+    ogs_sctp_flush_all();
+
+    /* The peer is not reading: the rest waits for POLLOUT */
+    ABTS_PTR_NOTNULL(tc, sctp.poll.write);
+    ABTS_TRUE(tc, ogs_list_count(&sctp.write_queue) > 0);
+
+    for (i = 0; i < NUM_OF_MESSAGE && received < NUM_OF_MESSAGE; i++) {
+        received += test_read(tc, peer, &seq);
+
+        ogs_pollset_poll(ogs_app()->pollset, ogs_time_from_msec(100));
+        ogs_sctp_flush_all();
+    }
+    received += test_read(tc, peer, &seq);
+
+    ABTS_INT_EQUAL(tc, NUM_OF_MESSAGE, received);
+    ABTS_PTR_EQUAL(tc, NULL, sctp.poll.write);
+    ABTS_INT_EQUAL(tc, 0, ogs_list_count(&sctp.write_queue));
+
+    ogs_sctp_flush_and_destroy(&sctp);
+    ogs_closesocket(peer);
+}
+
+static void flush_test3(abts_case *tc, void *data)
+{
+    ogs_sctp_sock_t sctp;
+    ogs_socket_t peer;
+    ogs_log_level_e level;
+
+    /* The failed send is expected */
+    level = ogs_log_get_domain_level(__ogs_sctp_domain);
+    ogs_log_set_domain_level(__ogs_sctp_domain, OGS_LOG_FATAL);
+    ogs_signal(SIGPIPE, SIG_IGN);
+
+    test_association_add(&sctp, &peer);
+    ogs_closesocket(peer);
+
+    /* A broken association fails everything queued on it */
+    test_write(&sctp, 0);
+    test_write(&sctp, 1);
+    test_write(&sctp, 2);
+    ogs_sctp_flush_all();
+
+    ABTS_TRUE(tc, !sctp.pending);
+    ABTS_PTR_EQUAL(tc, NULL, sctp.poll.write);
+    ABTS_INT_EQUAL(tc, 0, ogs_list_count(&sctp.write_queue));
+
+    ogs_sctp_flush_and_destroy(&sctp);
+
+    ogs_signal(SIGPIPE, SIG_DFL);
+    ogs_log_set_domain_level(__ogs_sctp_domain, level);
+}
+
+abts_suite *test_sctp_flush(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+#if !HAVE_USRSCTP
+    if (!ogs_app()->pollset)
+        ogs_app()->pollset = ogs_pollset_create(ogs_app()->pool.socket);
+
+    abts_run_test(suite, flush_test1, NULL);
+    abts_run_test(suite, flush_test2, NULL);
+    abts_run_test(suite, flush_test3, NULL);
+#endif
+
+    return suite;
+}
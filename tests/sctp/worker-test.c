@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-sctp.h"
+#include "core/abts.h"
+
+/*
+ * The I/O threads only poll the socket and call the handlers, so a UNIX
+ * socket pair stands in for an SCTP association here.
+ */
+typedef struct test_event_s {
+    ogs_pkbuf_t *pkbuf;
+    void *message;
+    bool in_thread;
+} test_event_t;
+
+static ogs_queue_t *received;
+static int num_of_freed;
+
+static void *test_decode(ogs_pkbuf_t *pkbuf)
+{
+    ogs_assert(pkbuf);
+
+    /* A message starting with 'X' does not decode */
+    if (pkbuf->len == 0 || pkbuf->data[0] == 'X')
+        return NULL;
+
+    return ogs_strndup((char *)pkbuf->data, pkbuf->len);
+}
+
+static void test_message_free(void *message)
+{
+    ogs_assert(message);
+
+    num_of_freed++;
+    ogs_free(message);
+}
+
+static void test_recv_upcall(short when, ogs_socket_t fd, void *data)
+{
+    test_event_t *e = NULL;
+    ssize_t size;
+
+    e = ogs_calloc(1, sizeof(*e));
+    ogs_assert(e);
+    e->pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+    ogs_assert(e->pkbuf);
+
+    size = recv(fd, e->pkbuf->data, OGS_MAX_SDU_LEN, 0);
+    if (size <= 0) {
+        ogs_pkbuf_free(e->pkbuf);
+        ogs_free(e);
+        return;
+    }
+    ogs_pkbuf_put(e->pkbuf, size);
+
+    e->in_thread = ogs_sctp_worker_in_thread();
+    e->message = ogs_sctp_worker_decode(e->pkbuf);
+
+    ogs_assert(ogs_queue_push(received, e) == OGS_OK);
+}
+
+static test_event_t *test_event_pop(void)
+{
+    test_event_t *e = NULL;
+
+    if (ogs_queue_timedpop(received, (void **)&e,
+                ogs_time_from_sec(3)) != OGS_OK)
+        return NULL;
+
+    return e;
+}
+
+static void test_event_free(test_event_t *e)
+{
+    if (e->message)
+        ogs_sctp_worker_message_free(e->message);
+    ogs_pkbuf_free(e->pkbuf);
+    ogs_free(e);
+}
+
+/* Wait until the I/O thread has closed the other end */
+static bool test_peer_closed(ogs_socket_t fd)
+{
+    char buf[16];
+    int i;
+
+    for (i = 0; i < 300; i++) {
+        if (recv(fd, buf, sizeof(buf), MSG_DONTWAIT) == 0)
+            return true;
+        ogs_msleep(10);
+    }
+
+    return false;
+}
+
+static void test_association_add(ogs_sctp_sock_t *sctp, ogs_socket_t *peer)
+{
+    ogs_socket_t fd[2];
+
+    ogs_assert(ogs_socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fd) == 0);
+
+    memset(sctp, 0, sizeof(*sctp));
+    sctp->type = SOCK_STREAM;
+    sctp->sock = ogs_sock_create();
+    ogs_assert(sctp->sock);
+    sctp->sock->fd = fd[0];
+    sctp->addr = ogs_calloc(1, sizeof(ogs_sockaddr_t));
+    ogs_assert(sctp->addr);
+
+    ogs_sctp_worker_add(sctp);
+
+    *peer = fd[1];
+}
+
+#define DATASTR1 "This is a test"
+#define DATASTR2 "This is another test"
+
+static void worker_test1(abts_case *tc, void *data)
+{
+    ogs_sctp_sock_t sctp[2];
+    ogs_socket_t peer[2];
+    test_event_t *e[2];
+    int rv, i;
+
+    received = ogs_queue_create(16);
+    ABTS_PTR_NOTNULL(tc, received);
+    num_of_freed = 0;
+
+    rv = ogs_sctp_worker_open(2,
+            test_recv_upcall, test_decode, test_message_free);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    if (!ogs_sctp_worker_is_enabled()) {
+        /* Not with usrsctp */
+        ogs_queue_destroy(received);
+        return;
+    }
+    ABTS_TRUE(tc, !ogs_sctp_worker_in_thread());
+
+    for (i = 0; i < 2; i++) {
+        test_association_add(&sctp[i], &peer[i]);
+        ABTS_PTR_NOTNULL(tc, sctp[i].conn);
+    }
+
+    /* Each association is read and decoded in an I/O thread */
+    ABTS_INT_EQUAL(tc, strlen(DATASTR1),
+            send(peer[0], DATASTR1, strlen(DATASTR1), 0));
+    ABTS_INT_EQUAL(tc, strlen(DATASTR2),
+            send(peer[1], DATASTR2, strlen(DATASTR2), 0));
+
+    for (i = 0; i < 2; i++) {
+        e[i] = test_event_pop();
+        ABTS_PTR_NOTNULL(tc, e[i]);
+        if (!e[i]) return;
+
+        ABTS_TRUE(tc, e[i]->in_thread);
+        ABTS_PTR_NOTNULL(tc, e[i]->message);
+        ABTS_INT_EQUAL(tc, 0, memcmp(e[i]->message,
+                    e[i]->pkbuf->data, e[i]->pkbuf->len));
+    }
+    ABTS_TRUE(tc, e[0]->pkbuf->len != e[1]->pkbuf->len);
+
+    /* Outside an I/O thread nothing is decoded */
+    ABTS_PTR_EQUAL(tc, NULL, ogs_sctp_worker_decode(e[0]->pkbuf));
+
+    test_event_free(e[0]);
+    test_event_free(e[1]);
+    ABTS_INT_EQUAL(tc, 2, num_of_freed);
+
+    /* A message that does not decode is left to the NF thread */
+    ABTS_INT_EQUAL(tc, 1, send(peer[0], "X", 1, 0));
+    e[0] = test_event_pop();
+    ABTS_PTR_NOTNULL(tc, e[0]);
+    if (!e[0]) return;
+    ABTS_TRUE(tc, e[0]->in_thread);
+    ABTS_PTR_EQUAL(tc, NULL, e[0]->message);
+    test_event_free(e[0]);
+    ABTS_INT_EQUAL(tc, 2, num_of_freed);
+
+    /* Destroying the association hands the socket back to its thread */
+    ogs_sctp_flush_and_destroy(&sctp[0]);
+    ABTS_PTR_EQUAL(tc, NULL, sctp[0].conn);
+    ABTS_TRUE(tc, test_peer_closed(peer[0]));
+
+    ABTS_INT_EQUAL(tc, strlen(DATASTR2),
+            send(peer[1], DATASTR2, strlen(DATASTR2), 0));
+    e[1] = test_event_pop();
+    ABTS_PTR_NOTNULL(tc, e[1]);
+    if (!e[1]) return;
+    ABTS_STR_EQUAL(tc, DATASTR2, e[1]->message);
+    test_event_free(e[1]);
+
+    /* Closing the threads closes what is left */
+    ogs_sctp_worker_close();
+    ABTS_TRUE(tc, !ogs_sctp_worker_is_enabled());
+    ABTS_TRUE(tc, test_peer_closed(peer[1]));
+    ogs_free(sctp[1].addr);
+
+    ogs_closesocket(peer[0]);
+    ogs_closesocket(peer[1]);
+
+    ABTS_INT_EQUAL(tc, 0, ogs_queue_size(received));
+    ogs_queue_destroy(received);
+}
+
+abts_suite *test_sctp_worker(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, worker_test1, NULL);
+
+    return suite;
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "udr/context.h"
+#include "core/abts.h"
+
+static char supi1[] = "imsi-001010000000001";
+static char supi2[] = "imsi-001010000000002";
+
+static void pool_add(char *supi, uint64_t sqn)
+{
+    ogs_dbi_auth_info_t auth_info;
+
+    memset(&auth_info, 0, sizeof(auth_info));
+    auth_info.sqn = sqn;
+
+    udr_av_pool_add(supi, &auth_info, udr_self()->av_pool_generation);
+}
+
+static bool pool_has(char *supi)
+{
+    ogs_dbi_auth_info_t auth_info;
+
+    return udr_av_pool_lookup(supi, &auth_info);
+}
+
+static void test_setup(void)
+{
+    udr_av_pool_remove_all();
+
+    udr_self()->av_pool.size = 4;
+    udr_self()->av_pool.lifetime = ogs_time_from_sec(300);
+}
+
+static void av_pool_test1(abts_case *tc, void *data)
+{
+    ogs_dbi_auth_info_t auth_info;
+    int i;
+
+    test_setup();
+
+    pool_add(supi1, 64);
+
+    ABTS_TRUE(tc, udr_av_pool_lookup(supi1, &auth_info));
+    ABTS_TRUE(tc, auth_info.sqn == 64);
+
+    /* A window of 4 SQNs is served from memory, then read again */
+    for (i = 0; i < 3; i++) {
+        ABTS_TRUE(tc, udr_av_pool_increment_sqn(supi1));
+        ABTS_TRUE(tc, pool_has(supi1));
+    }
+    ABTS_TRUE(tc, udr_av_pool_increment_sqn(supi1));
+    ABTS_TRUE(tc, !pool_has(supi1));
+    ABTS_TRUE(tc, !udr_av_pool_increment_sqn(supi1));
+}
+
+static void av_pool_test2(abts_case *tc, void *data)
+{
+    ogs_dbi_auth_info_t auth_info;
+    uint64_t generation;
+
+    test_setup();
+
+    pool_add(supi1, 64);
+    pool_add(supi2, 64);
+
+    /* Re-synchronisation drops the subscriber */
+    udr_av_pool_remove(supi1);
+    ABTS_TRUE(tc, !pool_has(supi1));
+    ABTS_TRUE(tc, pool_has(supi2));
+
+    /* A window read before the drop is not kept */
+    generation = udr_self()->av_pool_generation;
+    udr_av_pool_remove(supi1);
+
+    memset(&auth_info, 0, sizeof(auth_info));
+    udr_av_pool_add(supi1, &auth_info, generation);
+    ABTS_TRUE(tc, !pool_has(supi1));
+
+    udr_av_pool_add(supi1, &auth_info, udr_self()->av_pool_generation);
+    ABTS_TRUE(tc, pool_has(supi1));
+}
+
+static void av_pool_test3(abts_case *tc, void *data)
+{
+    bson_t *document = NULL;
+
+    test_setup();
+
+    pool_add(supi1, 64);
+    pool_add(supi2, 64);
+
+    /* The UDR's own SQN update keeps the subscriber */
+    document = BCON_NEW(
+            "operationType", BCON_UTF8("update"),
+            "fullDocument", "{",
+                "imsi", BCON_UTF8("001010000000001"),
+            "}",
+            "updateDescription", "{",
+                "updatedFields", "{",
+                    "security.sqn", BCON_INT64(96),
+                "}",
+                "removedFields", "[", "]",
+            "}");
+    ABTS_PTR_NOTNULL(tc, document);
+    ABTS_INT_EQUAL(tc, OGS_OK, udr_handle_change_event(document));
+    bson_destroy(document);
+
+    ABTS_TRUE(tc, pool_has(supi1));
+    ABTS_TRUE(tc, pool_has(supi2));
+
+    /* A new K drops only the edited subscriber */
+    document = BCON_NEW(
+            "operationType", BCON_UTF8("update"),
+            "fullDocument", "{",
+                "imsi", BCON_UTF8("001010000000001"),
+            "}",
+            "updateDescription", "{",
+                "updatedFields", "{",
+                    "security.k",
+                        BCON_UTF8("465B5CE8B199B49FAA5F0A2EE238A6BC"),
+                "}",
+                "removedFields", "[", "]",
+            "}");
+    ABTS_PTR_NOTNULL(tc, document);
+    ABTS_INT_EQUAL(tc, OGS_OK, udr_handle_change_event(document));
+    bson_destroy(document);
+
+    ABTS_TRUE(tc, !pool_has(supi1));
+    ABTS_TRUE(tc, pool_has(supi2));
+
+    /* A removed OPc drops it */
+    document = BCON_NEW(
+            "operationType", BCON_UTF8("update"),
+            "fullDocument", "{",
+                "imsi", BCON_UTF8("001010000000002"),
+            "}",
+            "updateDescription", "{",
+                "updatedFields", "{", "}",
+                "removedFields", "[",
+                    BCON_UTF8("security.opc"),
+                "]",
+            "}");
+    ABTS_PTR_NOTNULL(tc, document);
+    ABTS_INT_EQUAL(tc, OGS_OK, udr_handle_change_event(document));
+    bson_destroy(document);
+
+    ABTS_TRUE(tc, !pool_has(supi2));
+}
+
+static void av_pool_test4(abts_case *tc, void *data)
+{
+    bson_t *document = NULL;
+
+    test_setup();
+
+    pool_add(supi1, 64);
+    pool_add(supi2, 64);
+
+    /* A replaced subscriber is dropped */
+    document = BCON_NEW(
+            "operationType", BCON_UTF8("replace"),
+            "fullDocument", "{",
+                "imsi", BCON_UTF8("001010000000001"),
+            "}");
+    ABTS_PTR_NOTNULL(tc, document);
+    ABTS_INT_EQUAL(tc, OGS_OK, udr_handle_change_event(document));
+    bson_destroy(document);
+
+    ABTS_TRUE(tc, !pool_has(supi1));
+    ABTS_TRUE(tc, pool_has(supi2));
+
+    /* A delete does not carry the IMSI: every subscriber is dropped */
+    pool_add(supi1, 64);
+
+    document = BCON_NEW(
+            "operationType", BCON_UTF8("delete"),
+            "documentKey", "{",
+                "_id", BCON_UTF8("5f1e5f4b8e1b2c3d4e5f6a7b"),
+            "}");
+    ABTS_PTR_NOTNULL(tc, document);
+    ABTS_INT_EQUAL(tc, OGS_OK, udr_handle_change_event(document));
+    bson_destroy(document);
+
+    ABTS_TRUE(tc, !pool_has(supi1));
+    ABTS_TRUE(tc, !pool_has(supi2));
+}
+
+abts_suite *test_av_pool(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, av_pool_test1, NULL);
+    abts_run_test(suite, av_pool_test2, NULL);
+    abts_run_test(suite, av_pool_test3, NULL);
+    abts_run_test(suite, av_pool_test4, NULL);
+
+    return suite;
+}
@@ -33,6 +33,7 @@ abts_suite *test_s1ap_message(abts_suite *suite);
 abts_suite *test_nas_message(abts_suite *suite);
 abts_suite *test_gtp_message(abts_suite *suite);
 abts_suite *test_ngap_message(abts_suite *suite);
+abts_suite *test_asn_arena(abts_suite *suite);
 abts_suite *test_sbi_message(abts_suite *suite);
 abts_suite *test_security(abts_suite *suite);
 abts_suite *test_crash(abts_suite *suite);
@@ -44,6 +45,7 @@ const struct testlist {
     {test_nas_message},
     {test_gtp_message},
     {test_ngap_message},
+    {test_asn_arena},
     {test_sbi_message},
     {test_security},
     {test_crash},
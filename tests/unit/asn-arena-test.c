@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2023 by Sukchan Lee <acetcom@gmail.com>
+ *
+ * This file is part of Open5GS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ogs-ngap.h"
+#include "core/abts.h"
+
+/* NGReset */
+static ogs_pkbuf_t *ng_reset_pkbuf(void)
+{
+    const char *payload = "0014001300000200 0f400200c0005800 06400160010001";
+    char hexbuf[OGS_HUGE_LEN];
+    ogs_pkbuf_t *pkbuf = NULL;
+
+    pkbuf = ogs_pkbuf_alloc(NULL, OGS_MAX_SDU_LEN);
+    ogs_assert(pkbuf);
+    ogs_pkbuf_put_data(pkbuf,
+            ogs_hex_from_string(payload, hexbuf, sizeof(hexbuf)), 23);
+
+    return pkbuf;
+}
+
+static void asn_arena_test1(abts_case *tc, void *data)
+{
+    ogs_ngap_message_t message;
+    ogs_asn_arena_t *arena = NULL;
+    ogs_pkbuf_t *pkbuf = NULL;
+    void *ptr = NULL;
+    int rv;
+
+    pkbuf = ng_reset_pkbuf();
+    rv = ogs_ngap_decode(&message, pkbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    ogs_pkbuf_free(pkbuf);
+
+    /* The decoded tree lives in the arena of the message */
+    arena = ogs_asn_arena_find_by_root(&message);
+    ABTS_PTR_NOTNULL(tc, arena);
+    ABTS_INT_EQUAL(tc, NGAP_NGAP_PDU_PR_initiatingMessage, message.present);
+    ABTS_PTR_EQUAL(tc, arena,
+            ogs_asn_arena_find(message.choice.initiatingMessage));
+
+    /* FREEMEM leaves arena memory alone */
+    FREEMEM(message.choice.initiatingMessage);
+    ABTS_INT_EQUAL(tc, NGAP_ProcedureCode_id_NGReset,
+            message.choice.initiatingMessage->procedureCode);
+
+    /* Memory allocated outside the decoder still comes from the heap */
+    ptr = CALLOC(1, 64);
+    ABTS_PTR_NOTNULL(tc, ptr);
+    ABTS_PTR_EQUAL(tc, NULL, ogs_asn_arena_find(ptr));
+    ptr = REALLOC(ptr, 128);
+    ABTS_PTR_NOTNULL(tc, ptr);
+    ABTS_PTR_EQUAL(tc, NULL, ogs_asn_arena_find(ptr));
+    FREEMEM(ptr);
+
+    /* Freeing releases the arena and clears the root */
+    ogs_ngap_free(&message);
+    ABTS_PTR_EQUAL(tc, NULL, ogs_asn_arena_find_by_root(&message));
+    ABTS_INT_EQUAL(tc, NGAP_NGAP_PDU_PR_NOTHING, message.present);
+    ABTS_PTR_EQUAL(tc, NULL, message.choice.initiatingMessage);
+
+    /* A second free has nothing to do */
+    ogs_ngap_free(&message);
+
+    /* A failed decode leaves no arena behind */
+    pkbuf = ng_reset_pkbuf();
+    ogs_pkbuf_trim(pkbuf, 8);
+    rv = ogs_ngap_decode(&message, pkbuf);
+    ABTS_INT_EQUAL(tc, OGS_ERROR, rv);
+    ABTS_PTR_EQUAL(tc, NULL, ogs_asn_arena_find_by_root(&message));
+    ogs_pkbuf_free(pkbuf);
+}
+
+typedef struct asn_arena_thread_s {
+    ogs_ngap_message_t *message;
+    ogs_asn_arena_t *arena;
+    ogs_asn_arena_t *attached;
+    ogs_asn_arena_t *freed;
+} asn_arena_thread_t;
+
+static void asn_arena_thread_main(void *data)
+{
+    asn_arena_thread_t *thread = data;
+
+    ogs_asn_attach(thread->arena);
+    thread->attached = ogs_asn_arena_find_by_root(thread->message);
+
+    ogs_ngap_free(thread->message);
+    thread->freed = ogs_asn_arena_find_by_root(thread->message);
+}
+
+static void asn_arena_test2(abts_case *tc, void *data)
+{
+    ogs_ngap_message_t message;
+    asn_arena_thread_t arena_thread;
+    ogs_thread_t *thread = NULL;
+    ogs_pkbuf_t *pkbuf = NULL;
+    int rv;
+
+    pkbuf = ng_reset_pkbuf();
+    rv = ogs_ngap_decode(&message, pkbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    ogs_pkbuf_free(pkbuf);
+
+    /* Decoded here, freed by another thread */
+    memset(&arena_thread, 0, sizeof(arena_thread));
+    arena_thread.message = &message;
+    arena_thread.arena = ogs_asn_detach(&message);
+    ABTS_PTR_NOTNULL(tc, arena_thread.arena);
+    ABTS_PTR_EQUAL(tc, NULL, ogs_asn_arena_find_by_root(&message));
+    ABTS_PTR_EQUAL(tc, NULL,
+            ogs_asn_arena_find(message.choice.initiatingMessage));
+
+    thread = ogs_thread_create(asn_arena_thread_main, &arena_thread);
+    ABTS_PTR_NOTNULL(tc, thread);
+    ogs_thread_destroy(thread);
+
+    ABTS_PTR_EQUAL(tc, arena_thread.arena, arena_thread.attached);
+    ABTS_PTR_EQUAL(tc, NULL, arena_thread.freed);
+    ABTS_INT_EQUAL(tc, NGAP_NGAP_PDU_PR_NOTHING, message.present);
+}
+
+static void asn_arena_test3(abts_case *tc, void *data)
+{
+    ogs_ngap_message_t message;
+    ogs_asn_arena_t *arena = NULL;
+    ogs_pkbuf_t *pkbuf = NULL;
+    NGAP_NGReset_t *NGReset = NULL;
+    NGAP_NGResetIEs_t *ie[2];
+    void **array = NULL;
+    int rv, i;
+
+    pkbuf = ng_reset_pkbuf();
+    rv = ogs_ngap_decode(&message, pkbuf);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    ogs_pkbuf_free(pkbuf);
+
+    arena = ogs_asn_arena_find_by_root(&message);
+    ABTS_PTR_NOTNULL(tc, arena);
+
+    NGReset = &message.choice.initiatingMessage->value.choice.NGReset;
+    ABTS_INT_EQUAL(tc, 2, NGReset->protocolIEs.list.count);
+    ie[0] = NGReset->protocolIEs.list.array[0];
+    ie[1] = NGReset->protocolIEs.list.array[1];
+
+    array = (void **)NGReset->protocolIEs.list.array;
+    ABTS_PTR_EQUAL(tc, arena, ogs_asn_arena_find(array));
+
+    /* Shrinking keeps the block */
+    ABTS_PTR_EQUAL(tc, array, REALLOC(array, sizeof(void *)));
+
+    /* Growing the decoded list after the decoder is done stays in the arena */
+    for (i = 0; i < 8; i++)
+        ABTS_INT_EQUAL(tc, 0,
+                ASN_SEQUENCE_ADD(&NGReset->protocolIEs, ie[i % 2]));
+    ABTS_INT_EQUAL(tc, 10, NGReset->protocolIEs.list.count);
+    ABTS_PTR_EQUAL(tc, arena,
+            ogs_asn_arena_find(NGReset->protocolIEs.list.array));
+
+    for (i = 0; i < 10; i++)
+        ABTS_PTR_EQUAL(tc, ie[i % 2], NGReset->protocolIEs.list.array[i]);
+
+    ogs_ngap_free(&message);
+    ABTS_PTR_EQUAL(tc, NULL, ogs_asn_arena_find_by_root(&message));
+}
+
+abts_suite *test_asn_arena(abts_suite *suite)
+{
+    suite = ADD_SUITE(suite)
+
+    abts_run_test(suite, asn_arena_test1, NULL);
+    abts_run_test(suite, asn_arena_test2, NULL);
+    abts_run_test(suite, asn_arena_test3, NULL);
+
+    return suite;
+}
@@ -18,6 +18,7 @@
  */
 
 #include "ogs-nas-eps.h"
+#include "ogs-nas-5gs.h"
 #include "core/abts.h"
 
 static void ogs_nas_eps_message_test1(abts_case *tc, void *data)
@@ -129,6 +130,7 @@ static void ogs_nas_eps_message_test2(abts_case *tc, void *data)
     attach_accept->eps_network_feature_support.
         ims_voice_over_ps_session_in_s1_mode = 1;
 
+    ABTS_INT_EQUAL(tc, sizeof(buffer), ogs_nas_emm_length(&message));
     pkbuf = ogs_nas_eps_plain_encode(&message);
     ABTS_INT_EQUAL(tc, sizeof(buffer), pkbuf->len);
     ogs_log_hexdump(OGS_LOG_DEBUG, pkbuf->data, pkbuf->len);
@@ -177,6 +179,7 @@ static void ogs_nas_eps_message_test4(abts_case *tc, void *data)
     message.emm.h.message_type = OGS_NAS_EPS_ATTACH_REJECT;
     attach_reject->emm_cause = OGS_NAS_EMM_CAUSE_NETWORK_FAILURE; 
 
+    ABTS_INT_EQUAL(tc, sizeof(buffer), ogs_nas_emm_length(&message));
     pkbuf = ogs_nas_eps_plain_encode(&message);
     ABTS_INT_EQUAL(tc, sizeof(buffer), pkbuf->len);
     ABTS_TRUE(tc, memcmp(ogs_hex_from_string(payload, buffer, sizeof(buffer)),
@@ -270,6 +273,7 @@ static void ogs_nas_eps_message_test7(abts_case *tc, void *data)
     identity_response->mobile_identity.imsi.digit14 = 1;
     identity_response->mobile_identity.imsi.digit15 = 5;
 
+    ABTS_INT_EQUAL(tc, sizeof(buffer), ogs_nas_emm_length(&message));
     pkbuf = ogs_nas_eps_plain_encode(&message);
     ABTS_INT_EQUAL(tc, sizeof(buffer), pkbuf->len);
     ABTS_TRUE(tc, memcmp(ogs_hex_from_string(payload, buffer, sizeof(buffer)),
@@ -319,6 +323,7 @@ static void ogs_nas_eps_message_test8(abts_case *tc, void *data)
     ksi_and_sequence_number->sequence_number = 8;
     service_request->message_authentication_code = 0x640c;
 
+    ABTS_INT_EQUAL(tc, sizeof(buffer), ogs_nas_emm_length(&message));
     pkbuf = ogs_nas_eps_plain_encode(&message);
     ABTS_INT_EQUAL(tc, sizeof(buffer), pkbuf->len);
     ABTS_TRUE(tc, memcmp(ogs_hex_from_string(payload, buffer, sizeof(buffer)),
@@ -479,6 +484,160 @@ static void ogs_nas_eps_message_test9(abts_case *tc, void *data)
     ogs_log_install_domain(&__ogs_nas_domain, "nas", OGS_LOG_ERROR);
 }
 
+static ogs_pkbuf_t *nas_pkbuf_from_string(const char *payload)
+{
+    ogs_pkbuf_t *pkbuf = NULL;
+    char hexbuf[OGS_HUGE_LEN];
+    int len = strlen(payload) / 2;
+
+    pkbuf = ogs_pkbuf_alloc(NULL, len);
+    ogs_assert(pkbuf);
+    ogs_pkbuf_put(pkbuf, len);
+    memcpy(pkbuf->data,
+            ogs_hex_from_string(payload, hexbuf, sizeof(hexbuf)), len);
+
+    return pkbuf;
+}
+
+/*
+ * The encoders size their buffer from the length pass.
+ * Every message above must come out of it at its encoded size.
+ */
+static void ogs_nas_eps_message_test10(abts_case *tc, void *data)
+{
+    const char *emm_payload[] = {
+        /* Attach Request */
+        "0741020bf600f110000201030003e605"
+        "f07000001000050215d011d15200f110"
+        "30395c0a003103e5e0349011035758a6"
+        "5d0100e0c1",
+        /* Attach Accept */
+        "07420223060014f799303900325201c1"
+        "01090908696e7465726e657405010ae1"
+        "000a271b80802110020200108106c0a8"
+        "a8018306c0a8a801000d04c0a8a80150"
+        "0bf614f7992345e1000004561300f120"
+        "fffd2305f400e102d4640123",
+        /* Attach Complete */
+        "074300035200c2",
+        /* Attach Reject */
+        "074411",
+        /* Identity Request */
+        "075501",
+        /* Identity Response */
+        "0756080910101032548651",
+        /* Service Request */
+        "c7a8640c",
+        NULL,
+    };
+    const char *esm_payload[] = {
+        /* Activate Default EPS Bearer Context Request */
+        "5201c101090908696e7465726e657405"
+        "010ae1000a271b808021100202001081"
+        "06c0a8a8018306c0a8a801000d04c0a8"
+        "a801",
+        /* Activate Default EPS Bearer Context Accept */
+        "5200c2",
+        NULL,
+    };
+
+    ogs_nas_eps_message_t message;
+    ogs_pkbuf_t *pkbuf = NULL, *encoded = NULL;
+    int i, rv;
+
+    for (i = 0; emm_payload[i]; i++) {
+        pkbuf = nas_pkbuf_from_string(emm_payload[i]);
+
+        rv = ogs_nas_emm_decode(&message, pkbuf);
+        ABTS_INT_EQUAL(tc, OGS_OK, rv);
+        ABTS_INT_EQUAL(tc, pkbuf->len, ogs_nas_emm_length(&message));
+
+        encoded = ogs_nas_emm_encode(&message);
+        ABTS_PTR_NOTNULL(tc, encoded);
+        ABTS_INT_EQUAL(tc, pkbuf->len, encoded->len);
+        ABTS_TRUE(tc, memcmp(pkbuf->data, encoded->data, pkbuf->len) == 0);
+
+        ogs_pkbuf_free(encoded);
+        ogs_pkbuf_free(pkbuf);
+    }
+
+    for (i = 0; esm_payload[i]; i++) {
+        pkbuf = nas_pkbuf_from_string(esm_payload[i]);
+
+        rv = ogs_nas_esm_decode(&message, pkbuf);
+        ABTS_INT_EQUAL(tc, OGS_OK, rv);
+        ABTS_INT_EQUAL(tc, pkbuf->len, ogs_nas_esm_length(&message));
+
+        encoded = ogs_nas_esm_encode(&message);
+        ABTS_PTR_NOTNULL(tc, encoded);
+        ABTS_INT_EQUAL(tc, pkbuf->len, encoded->len);
+        ABTS_TRUE(tc, memcmp(pkbuf->data, encoded->data, pkbuf->len) == 0);
+
+        ogs_pkbuf_free(encoded);
+        ogs_pkbuf_free(pkbuf);
+    }
+}
+
+static void ogs_nas_5gs_message_test1(abts_case *tc, void *data)
+{
+    const char *gmm_payload[] = {
+        /* Registration Request */
+        "7e004179000d0100f110f0ff00000000"
+        "0000102e04f0f0f0f0",
+        /* Registration Reject */
+        "7e004407160121",
+        /* Authentication Request */
+        "7e0056000200002100112233445566778899aabbccddeeff"
+        "2010ffeeddccbbaa99887766554433221100",
+        /* Identity Request */
+        "7e005b01",
+        NULL,
+    };
+    const char *gsm_payload[] = {
+        /* PDU Session Establishment Request */
+        "2e0101c1ffff91a1",
+        /* PDU Session Release Command */
+        "2e0101d324",
+        NULL,
+    };
+
+    ogs_nas_5gs_message_t message;
+    ogs_pkbuf_t *pkbuf = NULL, *encoded = NULL;
+    int i, rv;
+
+    for (i = 0; gmm_payload[i]; i++) {
+        pkbuf = nas_pkbuf_from_string(gmm_payload[i]);
+
+        rv = ogs_nas_5gmm_decode(&message, pkbuf);
+        ABTS_INT_EQUAL(tc, OGS_OK, rv);
+        ABTS_INT_EQUAL(tc, pkbuf->len, ogs_nas_5gmm_length(&message));
+
+        encoded = ogs_nas_5gmm_encode(&message);
+        ABTS_PTR_NOTNULL(tc, encoded);
+        ABTS_INT_EQUAL(tc, pkbuf->len, encoded->len);
+        ABTS_TRUE(tc, memcmp(pkbuf->data, encoded->data, pkbuf->len) == 0);
+
+        ogs_pkbuf_free(encoded);
+        ogs_pkbuf_free(pkbuf);
+    }
+
+    for (i = 0; gsm_payload[i]; i++) {
+        pkbuf = nas_pkbuf_from_string(gsm_payload[i]);
+
+        rv = ogs_nas_5gsm_decode(&message, pkbuf);
+        ABTS_INT_EQUAL(tc, OGS_OK, rv);
+        ABTS_INT_EQUAL(tc, pkbuf->len, ogs_nas_5gsm_length(&message));
+
+        encoded = ogs_nas_5gsm_encode(&message);
+        ABTS_PTR_NOTNULL(tc, encoded);
+        ABTS_INT_EQUAL(tc, pkbuf->len, encoded->len);
+        ABTS_TRUE(tc, memcmp(pkbuf->data, encoded->data, pkbuf->len) == 0);
+
+        ogs_pkbuf_free(encoded);
+        ogs_pkbuf_free(pkbuf);
+    }
+}
+
 abts_suite *test_nas_message(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
@@ -496,6 +655,8 @@ abts_suite *test_nas_message(abts_suite *suite)
     abts_run_test(suite, ogs_nas_eps_message_test7, NULL);
     abts_run_test(suite, ogs_nas_eps_message_test8, NULL);
     abts_run_test(suite, ogs_nas_eps_message_test9, NULL);
+    abts_run_test(suite, ogs_nas_eps_message_test10, NULL);
+    abts_run_test(suite, ogs_nas_5gs_message_test1, NULL);
 
     return suite;
 }
@@ -820,6 +820,192 @@ static void sbi_message_test8(abts_case *tc, void *data)
         ogs_sbi_service_type_from_name(OGS_SBI_SERVICE_NAME_NNSSAAF_NSSAA));
 }
 
+static void sbi_message_test9(abts_case *tc, void *data)
+{
+    ogs_sbi_load_control_t lc;
+    char buf[OGS_SBI_MAX_LOAD_CONTROL_LEN];
+    const char *nf_inst = "0cb58eca-4e84-41ed-aa10-9f892634b770";
+    ogs_time_t timestamp = ogs_time_from_sec(1564908577) + 845000;
+
+    ABTS_TRUE(tc, ogs_sbi_parse_load_control(&lc,
+        "Timestamp: \"Sun, 04 Aug 2019 08:49:37.845 GMT\"; "
+        "Load-Metric: 50%; NF-Inst: 0cb58eca-4e84-41ed-aa10-9f892634b770",
+        false));
+    ABTS_INT_EQUAL(tc, 50, lc.load);
+    ABTS_INT_EQUAL(tc, -1, lc.reduction);
+    ABTS_INT_EQUAL(tc, -1, lc.validity);
+    ABTS_STR_EQUAL(tc, nf_inst, lc.nf_inst);
+
+    ABTS_TRUE(tc, ogs_sbi_parse_load_control(&lc,
+        "Timestamp: \"Sun, 04 Aug 2019 08:49:37 GMT\";"
+        "Period-of-Validity: 10s;\tOverload-Reduction-Metric: 0%; "
+        "NF-Set: set1.udmset.5gc.mnc012.mcc345",
+        true));
+    ABTS_INT_EQUAL(tc, 0, lc.reduction);
+    ABTS_INT_EQUAL(tc, 10, lc.validity);
+    ABTS_STR_EQUAL(tc, "", lc.nf_inst);
+
+    /* Garbage the former strstr()/atoi() parsing accepted */
+    ABTS_TRUE(tc, !ogs_sbi_parse_load_control(&lc,
+        "xLoad-Metric: 50%", false));
+    ABTS_TRUE(tc, !ogs_sbi_parse_load_control(&lc,
+        "Timestamp: \"Sun, 04 Aug 2019 08:49:37 GMT\"; Load-Metric: 50abc",
+        false));
+    ABTS_TRUE(tc, !ogs_sbi_parse_load_control(&lc,
+        "Timestamp: \"Sun, 04 Aug 2019 08:49:37 GMT\"; Load-Metric: 101%",
+        false));
+    ABTS_TRUE(tc, !ogs_sbi_parse_load_control(&lc,
+        "Timestamp: \"Sun, 04 Aug 2019 08:49:37 GMT\"; Load-Metric: -5%",
+        false));
+    ABTS_TRUE(tc, !ogs_sbi_parse_load_control(&lc,
+        "Timestamp: \"Sun, 04 Aug 2019 08:49:37 GMT\"; Load-Metric: 50%; "
+        "Load-Metric: 10%", false));
+    ABTS_TRUE(tc, !ogs_sbi_parse_load_control(&lc,
+        "Timestamp: \"Sun, 04 Aug 2019 08:49:37 GMT\"; Load-Metric: 50%;",
+        false));
+    ABTS_TRUE(tc, !ogs_sbi_parse_load_control(&lc,
+        "Timestamp: \"Sun, 04 Aug 2019; Load-Metric: 50%", false));
+    ABTS_TRUE(tc, !ogs_sbi_parse_load_control(&lc,
+        "Load-Metric: 50%", false));
+    ABTS_TRUE(tc, !ogs_sbi_parse_load_control(&lc,
+        "Timestamp: \"Sun, 04 Aug 2019 08:49:37 GMT\"; Load-Metric: 50%; "
+        "NF-Inst: not-a-uuid", false));
+    ABTS_TRUE(tc, !ogs_sbi_parse_load_control(&lc,
+        "Timestamp: \"Sun, 04 Aug 2019 08:49:37 GMT\"; "
+        "Overload-Reduction-Metric: 20%", true));
+    ABTS_TRUE(tc, !ogs_sbi_parse_load_control(&lc,
+        "Timestamp: \"Sun, 04 Aug 2019 08:49:37 GMT\"; "
+        "Period-of-Validity: 10; Overload-Reduction-Metric: 20%", true));
+
+    memset(&lc, 0, sizeof(lc));
+    lc.load = 75;
+    ogs_cpystrn(lc.nf_inst, nf_inst, sizeof(lc.nf_inst));
+    ABTS_TRUE(tc, ogs_sbi_build_load_control(
+                buf, sizeof(buf), &lc, timestamp, false));
+    ABTS_STR_EQUAL(tc,
+        "Timestamp: \"Sun, 04 Aug 2019 08:49:37.845 GMT\"; "
+        "Load-Metric: 75%; NF-Inst: 0cb58eca-4e84-41ed-aa10-9f892634b770",
+        buf);
+    ABTS_TRUE(tc, ogs_sbi_parse_load_control(&lc, buf, false));
+    ABTS_INT_EQUAL(tc, 75, lc.load);
+    ABTS_STR_EQUAL(tc, nf_inst, lc.nf_inst);
+
+    memset(&lc, 0, sizeof(lc));
+    lc.reduction = 40;
+    lc.validity = 5;
+    ABTS_TRUE(tc, ogs_sbi_build_load_control(
+                buf, sizeof(buf), &lc, timestamp, true));
+    ABTS_STR_EQUAL(tc,
+        "Timestamp: \"Sun, 04 Aug 2019 08:49:37.845 GMT\"; "
+        "Period-of-Validity: 5s; Overload-Reduction-Metric: 40%",
+        buf);
+    ABTS_TRUE(tc, ogs_sbi_parse_load_control(&lc, buf, true));
+    ABTS_INT_EQUAL(tc, 40, lc.reduction);
+    ABTS_INT_EQUAL(tc, 5, lc.validity);
+
+    ABTS_TRUE(tc, !ogs_sbi_build_load_control(buf, 32, &lc, timestamp, true));
+}
+
+static void sbi_message_test10(abts_case *tc, void *data)
+{
+    ogs_sbi_client_t client;
+    int i, dropped, last;
+
+    memset(&client, 0, sizeof(client));
+    ABTS_TRUE(tc, !ogs_sbi_client_is_overloaded(&client));
+    ABTS_TRUE(tc, !ogs_sbi_client_throttle(&client));
+
+    /* 20% is every fifth request, evenly spread */
+    client.overload.reduction = 20;
+    client.overload.expire = ogs_get_monotonic_time() + ogs_time_from_sec(60);
+    for (i = 1, dropped = 0; i <= 100; i++) {
+        if (ogs_sbi_client_throttle(&client) == true) {
+            ABTS_INT_EQUAL(tc, 0, i % 5);
+            dropped++;
+        }
+    }
+    ABTS_INT_EQUAL(tc, 20, dropped);
+    ABTS_INT_EQUAL(tc, 0, client.overload.credit);
+
+    /* The remainder carries over, and no two drops are adjacent */
+    client.overload.reduction = 30;
+    for (i = 1, dropped = 0, last = -2; i <= 1000; i++) {
+        if (ogs_sbi_client_throttle(&client) == true) {
+            ABTS_TRUE(tc, i - last > 1);
+            last = i;
+            dropped++;
+        }
+    }
+    ABTS_INT_EQUAL(tc, 300, dropped);
+
+    client.overload.reduction = 100;
+    for (i = 0, dropped = 0; i < 10; i++)
+        if (ogs_sbi_client_throttle(&client) == true)
+            dropped++;
+    ABTS_INT_EQUAL(tc, 10, dropped);
+
+    /* Period-of-Validity over: no throttling, credit reset */
+    client.overload.reduction = 50;
+    client.overload.credit = 70;
+    client.overload.expire = ogs_get_monotonic_time() - 1;
+    ABTS_TRUE(tc, !ogs_sbi_client_throttle(&client));
+    ABTS_INT_EQUAL(tc, 0, client.overload.reduction);
+    ABTS_INT_EQUAL(tc, 0, client.overload.credit);
+}
+
+static void sbi_message_test11(abts_case *tc, void *data)
+{
+    ogs_sbi_header_t header;
+    ogs_sbi_message_t message;
+    int i, rv;
+
+    /* Every service name, including the callbacks, is in the table */
+    memset(&header, 0, sizeof(header));
+    for (i = OGS_SBI_SERVICE_TYPE_NULL+1;
+            i < OGS_SBI_MAX_NUM_OF_SERVICE_TYPE; i++) {
+        header.service.name = (char *)ogs_sbi_service_type_to_name(i);
+        ogs_sbi_route_resolve(&message.route, &header);
+        ABTS_INT_EQUAL(tc, i, message.route.service);
+    }
+    header.service.name = (char *)OGS_SBI_SERVICE_NAME_NSMF_CALLBACK;
+    ogs_sbi_route_resolve(&message.route, &header);
+    ABTS_INT_EQUAL(tc,
+            OGS_SBI_SERVICE_TYPE_NSMF_CALLBACK, message.route.service);
+
+    /* Parsing alone does not resolve */
+    memset(&header, 0, sizeof(header));
+    header.method = ogs_strdup(OGS_SBI_HTTP_METHOD_POST);
+    header.uri = (char *)"/namf-comm/v1/ue-contexts/"
+        "imsi-001010000000001/n1-n2-messages";
+    rv = ogs_sbi_parse_header(&message, &header);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    ABTS_INT_EQUAL(tc, OGS_SBI_SERVICE_TYPE_NULL, message.route.service);
+
+    ogs_sbi_route_resolve(&message.route, &message.h);
+    ABTS_INT_EQUAL(tc, OGS_SBI_SERVICE_TYPE_NAMF_COMM, message.route.service);
+    ABTS_INT_EQUAL(tc, 1, message.route.version);
+    ABTS_INT_EQUAL(tc, OGS_SBI_METHOD_POST, message.route.method);
+    ABTS_INT_EQUAL(tc,
+            OGS_SBI_RESOURCE_UE_CONTEXTS, message.route.component[0]);
+    ABTS_INT_EQUAL(tc, OGS_SBI_RESOURCE_NULL, message.route.component[1]);
+    ABTS_INT_EQUAL(tc,
+            OGS_SBI_RESOURCE_N1_N2_MESSAGES, message.route.component[2]);
+    ogs_sbi_header_free(&header);
+
+    /* Unknown names resolve to 0 */
+    memset(&header, 0, sizeof(header));
+    header.method = ogs_strdup("TRACE");
+    header.uri = (char *)"/nxxx-yyy/v10/pcfBindingsX";
+    rv = ogs_sbi_parse_header(&message, &header);
+    ABTS_INT_EQUAL(tc, OGS_OK, rv);
+    ogs_sbi_route_resolve(&message.route, &message.h);
+    ABTS_INT_EQUAL(tc, OGS_SBI_SERVICE_TYPE_NULL, message.route.service);
+    ABTS_INT_EQUAL(tc, 0, message.route.version);
+    ABTS_INT_EQUAL(tc, OGS_SBI_METHOD_NULL, message.route.method);
+    ABTS_INT_EQUAL(tc, OGS_SBI_RESOURCE_NULL, message.route.component[0]);
+    ogs_sbi_header_free(&header);
+}
+
 abts_suite *test_sbi_message(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
@@ -832,6 +1018,9 @@ abts_suite *test_sbi_message(abts_suite *suite)
     abts_run_test(suite, sbi_message_test6, NULL);
     abts_run_test(suite, sbi_message_test7, NULL);
     abts_run_test(suite, sbi_message_test8, NULL);
+    abts_run_test(suite, sbi_message_test9, NULL);
+    abts_run_test(suite, sbi_message_test10, NULL);
+    abts_run_test(suite, sbi_message_test11, NULL);
 
     return suite;
 }
@@ -398,6 +398,158 @@ static void security_test9(abts_case *tc, void *data)
     ogs_pkbuf_free(pkbuf);
 }
 
+static void security_test10(abts_case *tc, void *data)
+{
+    const char *_k = "465b5ce8 b199b49f aa5f0a2e e238a6bc";
+    const char *_opc = "cd63cb71 954a9f4e 48a5994e 37a02baf";
+    const char *_amf = "b9b9";
+
+    uint8_t k[16];
+    uint8_t opc[16];
+    uint8_t amf[2];
+    uint8_t sqn[MILENAGE_BATCH_MAX][6];
+    uint8_t rand[MILENAGE_BATCH_MAX][16];
+    milenage_batch_t batch[MILENAGE_BATCH_MAX];
+
+    uint8_t autn[16];
+    uint8_t ik[16];
+    uint8_t ck[16];
+    uint8_t ak[6];
+    uint8_t res[8];
+    size_t res_len;
+
+    int i;
+
+    ogs_hex_from_string(_k, k, sizeof(k));
+    ogs_hex_from_string(_opc, opc, sizeof(opc));
+    ogs_hex_from_string(_amf, amf, sizeof(amf));
+
+    memset(batch, 0, sizeof(batch));
+    for (i = 0; i < MILENAGE_BATCH_MAX; i++) {
+        ogs_random(rand[i], sizeof(rand[i]));
+        ogs_random(sqn[i], sizeof(sqn[i]));
+
+        batch[i].opc = opc;
+        batch[i].k = k;
+        batch[i].amf = amf;
+        batch[i].sqn = sqn[i];
+        batch[i].rand = rand[i];
+    }
+
+    milenage_generate_batch(batch, MILENAGE_BATCH_MAX);
+
+    for (i = 0; i < MILENAGE_BATCH_MAX; i++) {
+        milenage_generate(opc, amf, k, sqn[i], rand[i],
+                autn, ik, ck, ak, res, &res_len);
+
+        ABTS_TRUE(tc, memcmp(batch[i].autn, autn, 16) == 0);
+        ABTS_TRUE(tc, memcmp(batch[i].ik, ik, 16) == 0);
+        ABTS_TRUE(tc, memcmp(batch[i].ck, ck, 16) == 0);
+        ABTS_TRUE(tc, memcmp(batch[i].ak, ak, 6) == 0);
+        ABTS_TRUE(tc, batch[i].res_len == res_len);
+        ABTS_TRUE(tc, memcmp(batch[i].res, res, res_len) == 0);
+    }
+}
+
+static void security_test11(abts_case *tc, void *data)
+{
+    uint8_t kasme[32];
+    uint8_t sync_input[32];
+    uint8_t s[3+32];
+    uint8_t expected[32], out[32], knas[16];
+    ogs_kdf_key_t kdf_key;
+    uint32_t ul_count = 0x00012345;
+
+    ogs_random(kasme, sizeof(kasme));
+    ogs_random(sync_input, sizeof(sync_input));
+
+    ogs_kdf_key_init(&kdf_key, kasme, sizeof(kasme));
+
+    /* TS33.401 Annex A.3 : S = 0x11 || UL COUNT || 0x0004 */
+    s[0] = 0x11;
+    s[1] = 0x00; s[2] = 0x01; s[3] = 0x23; s[4] = 0x45;
+    s[5] = 0x00; s[6] = 0x04;
+    ogs_hmac_sha256(kasme, sizeof(kasme), s, 7, expected, 32);
+
+    ogs_kdf_kenb(kasme, ul_count, out);
+    ABTS_TRUE(tc, memcmp(out, expected, 32) == 0);
+    ogs_kdf_kenb_from_key(&kdf_key, ul_count, out);
+    ABTS_TRUE(tc, memcmp(out, expected, 32) == 0);
+
+    /* TS33.401 Annex A.7 : S = 0x15 || 0x01 || 0x0001 || 0x02 || 0x0001 */
+    s[0] = 0x15;
+    s[1] = OGS_KDF_NAS_ENC_ALG; s[2] = 0x00; s[3] = 0x01;
+    s[4] = 0x02; s[5] = 0x00; s[6] = 0x01;
+    ogs_hmac_sha256(kasme, sizeof(kasme), s, 7, expected, 32);
+
+    ogs_kdf_nas_eps_from_key(OGS_KDF_NAS_ENC_ALG, 0x02, &kdf_key, knas);
+    ABTS_TRUE(tc, memcmp(knas, expected+16, 16) == 0);
+
+    /* TS33.401 Annex A.4 : S = 0x12 || SYNC-input || 0x0020 */
+    s[0] = 0x12;
+    memcpy(s+1, sync_input, 32);
+    s[33] = 0x00; s[34] = 0x20;
+    ogs_hmac_sha256(kasme, sizeof(kasme), s, 35, expected, 32);
+
+    /* NH chaining derives in place */
+    memcpy(out, sync_input, 32);
+    ogs_kdf_nh_enb_from_key(&kdf_key, out, out);
+    ABTS_TRUE(tc, memcmp(out, expected, 32) == 0);
+
+    ogs_kdf_nh_gnb(kasme, sync_input, expected);
+    memcpy(out, sync_input, 32);
+    ogs_kdf_nh_gnb_from_key(&kdf_key, out, out);
+    ABTS_TRUE(tc, memcmp(out, expected, 32) == 0);
+}
+
+static void security_test12(abts_case *tc, void *data)
+{
+#define SECURITY_TEST12_LEN 300
+    int lens[] = { 1, 15, 16, 17, 64, SECURITY_TEST12_LEN };
+    uint8_t knas_int[16], knas_enc[16];
+    uint8_t plain[SECURITY_TEST12_LEN];
+    uint8_t mac[4], expected[4];
+    ogs_nas_security_key_t key;
+    ogs_pkbuf_t *pkbuf = NULL, *expected_pkbuf = NULL;
+    uint8_t algorithm;
+    int i;
+
+    ogs_random(knas_int, sizeof(knas_int));
+    ogs_random(knas_enc, sizeof(knas_enc));
+    ogs_random(plain, sizeof(plain));
+
+    /* NIA1..3 and NEA1..3 share the identities 1..3 */
+    for (algorithm = 1; algorithm <= 3; algorithm++) {
+        ogs_nas_security_key_init(&key,
+                algorithm, knas_int, algorithm, knas_enc);
+
+        for (i = 0; i < OGS_ARRAY_SIZE(lens); i++) {
+            pkbuf = ogs_pkbuf_alloc(NULL, OGS_NAS_HEADROOM+lens[i]);
+            ogs_assert(pkbuf);
+            ogs_pkbuf_reserve(pkbuf, OGS_NAS_HEADROOM);
+            ogs_pkbuf_put_data(pkbuf, plain, lens[i]);
+            expected_pkbuf = ogs_pkbuf_copy(pkbuf);
+            ogs_assert(expected_pkbuf);
+
+            ogs_nas_mac_calculate(algorithm, knas_int, 0x123456, 0x1, 1,
+                    expected_pkbuf, expected);
+            ogs_nas_mac_calculate_from_key(&key, 0x123456, 0x1, 1,
+                    pkbuf, mac);
+            ABTS_TRUE(tc, memcmp(mac, expected, sizeof(mac)) == 0);
+
+            ogs_nas_encrypt(algorithm, knas_enc, 0x123456, 0x1, 0,
+                    expected_pkbuf);
+            ogs_nas_encrypt_from_key(&key, 0x123456, 0x1, 0, pkbuf);
+            ABTS_INT_EQUAL(tc, expected_pkbuf->len, pkbuf->len);
+            ABTS_TRUE(tc, memcmp(pkbuf->data, expected_pkbuf->data,
+                        lens[i]) == 0);
+
+            ogs_pkbuf_free(expected_pkbuf);
+            ogs_pkbuf_free(pkbuf);
+        }
+    }
+}
+
 abts_suite *test_security(abts_suite *suite)
 {
     suite = ADD_SUITE(suite)
@@ -411,6 +563,9 @@ abts_suite *test_security(abts_suite *suite)
     abts_run_test(suite, security_test7, NULL);
     abts_run_test(suite, security_test8, NULL);
     abts_run_test(suite, security_test9, NULL);
+    abts_run_test(suite, security_test10, NULL);
+    abts_run_test(suite, security_test11, NULL);
+    abts_run_test(suite, security_test12, NULL);
 
     return suite;
 }